@@ -1,71 +1,37 @@
 #pragma once
 
 #include "Common.h"
+#include "game/ItemCatalog.h"
+#include "utils/BinaryArchive.h"
+#include "utils/IndexedHeap.h"
+#include "utils/Metrics.h"
+#include "utils/SmallFlatMap.h"
+#include "utils/WriteAheadLog.h"
+#include <array>
+#include <atomic>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <chrono>
 #include <functional>
 
 namespace Game
 {
-    // Currency types
-    enum class CurrencyType
-    {
-        Gold = 0,
-        Silver = 1,
-        Copper = 2,
-        Crowns = 3
-    };
-
-    // Item rarity
-    enum class ItemRarity
-    {
-        Common = 0,
-        Uncommon = 1,
-        Rare = 2,
-        Epic = 3,
-        Legendary = 4,
-        Artifact = 5
-    };
-
-    // Item types
-    enum class ItemType
-    {
-        Weapon = 0,
-        Armor = 1,
-        Consumable = 2,
-        Material = 3,
-        Quest = 4,
-        Misc = 5
-    };
-
-    // Item data
-    struct ItemData
-    {
-        uint32_t itemId;
-        std::string name;
-        std::string description;
-        ItemType type;
-        ItemRarity rarity;
-        uint32_t value;
-        uint32_t weight;
-        uint32_t stackSize;
-        bool isTradeable;
-        bool isSellable;
-        std::map<CurrencyType, uint32_t> prices;
-        
-        ItemData() : itemId(0), type(ItemType::Misc), rarity(ItemRarity::Common),
-                    value(0), weight(0), stackSize(1), isTradeable(true), isSellable(true) {}
-    };
+    // Item id -> quantity, sorted by id. Typical inventories fit the inline
+    // slots; bigger ones take one heap block rather than a node per item.
+    using Inventory = SmallFlatMap<uint32_t, uint32_t, 32>;
 
     // Player economy data
     struct PlayerEconomyData
     {
         uint32_t playerId;
         std::map<CurrencyType, uint32_t> currencies;
-        std::map<uint32_t, uint32_t> inventory; // itemId -> quantity
-        uint32_t totalWeight;
+        Inventory inventory;
+        uint32_t totalWeight;   // Catalog weight of the inventory, kept up to date
         uint32_t maxWeight;
         std::vector<uint32_t> transactionHistory;
         std::chrono::high_resolution_clock::time_point lastUpdate;
@@ -79,7 +45,7 @@ namespace Game
         uint32_t merchantId;
         std::string name;
         std::string location;
-        std::map<uint32_t, uint32_t> inventory; // itemId -> quantity
+        Inventory inventory;
         std::map<uint32_t, uint32_t> buyPrices; // itemId -> price
         std::map<uint32_t, uint32_t> sellPrices; // itemId -> price
         uint32_t goldAmount;
@@ -90,6 +56,19 @@ namespace Game
         MerchantData() : merchantId(0), goldAmount(1000), maxGold(10000), isActive(true) {}
     };
 
+    // Transaction types. The values are stored in the economy journal: add
+    // new ones, never renumber or reuse.
+    enum class TransactionType
+    {
+        Buy = 0,
+        Sell = 1,
+        Trade = 2,
+        Gift = 3,
+        Loot = 4,       // Currency or items granted outside a trade
+        Spend = 5,      // Currency or items taken outside a trade
+        Restock = 6     // Items a merchant gained on restock
+    };
+
     // Transaction data
     struct TransactionData
     {
@@ -103,19 +82,11 @@ namespace Game
         CurrencyType currency;
         std::chrono::high_resolution_clock::time_point timestamp;
         bool isCompleted;
+        uint32_t recipientId; // Receiving player of a trade or gift
         
         TransactionData() : transactionId(0), playerId(0), merchantId(0), type(TransactionType::Buy),
-                          itemId(0), quantity(0), price(0), currency(CurrencyType::Gold), isCompleted(false) {}
-    };
-
-    // Transaction types
-    enum class TransactionType
-    {
-        Buy = 0,
-        Sell = 1,
-        Trade = 2,
-        Gift = 3,
-        Loot = 4
+                          itemId(0), quantity(0), price(0), currency(CurrencyType::Gold), isCompleted(false),
+                          recipientId(0) {}
     };
 
     // Economy statistics
@@ -143,7 +114,14 @@ namespace Game
         }
     };
 
-    // Global economy system
+    // Global economy system. Trading, currency and inventory calls are safe
+    // from several threads at once: players and merchants are spread over
+    // shards with a lock each, so transactions between different players run
+    // in parallel. Locks are always taken in one order (item catalog, player
+    // shards by index, merchant shards by index, statistics) so two-party
+    // trades cannot deadlock. The pointer accessors (GetPlayerEconomy,
+    // GetMerchant) are unsynchronized and meant for setup and tests; changes
+    // made through them reach the statistics after RecalculateStats.
     class GlobalEconomy
     {
     public:
@@ -157,19 +135,27 @@ namespace Game
         // Item management
         void AddItem(const ItemData& item);
         void RemoveItem(uint32_t itemId);
-        ItemData* GetItem(uint32_t itemId);
+        std::optional<ItemData> GetItem(uint32_t itemId) const;
         std::vector<ItemData> GetAllItems() const;
         std::vector<ItemData> GetItemsByType(ItemType type) const;
         std::vector<ItemData> GetItemsByRarity(ItemRarity rarity) const;
 
+        // Ascending item ids, from the catalog's type and rarity indexes
+        std::vector<uint32_t> GetItemIdsByType(ItemType type) const;
+        std::vector<uint32_t> GetItemIdsByRarity(ItemRarity rarity) const;
+        size_t GetCatalogMemoryUsage() const;
+
         // Player economy
         void AddPlayer(uint32_t playerId);
         void RemovePlayer(uint32_t playerId);
         PlayerEconomyData* GetPlayerEconomy(uint32_t playerId);
+        const PlayerEconomyData* GetPlayerEconomy(uint32_t playerId) const;
         bool AddCurrency(uint32_t playerId, CurrencyType currency, uint32_t amount);
         bool RemoveCurrency(uint32_t playerId, CurrencyType currency, uint32_t amount);
         uint32_t GetCurrency(uint32_t playerId, CurrencyType currency) const;
         bool AddItemToInventory(uint32_t playerId, uint32_t itemId, uint32_t quantity);
+        // Grants a whole loot drop (item id -> quantity) or none of it
+        bool AddItemsToInventory(uint32_t playerId, const std::map<uint32_t, uint32_t>& items);
         bool RemoveItemFromInventory(uint32_t playerId, uint32_t itemId, uint32_t quantity);
         uint32_t GetItemQuantity(uint32_t playerId, uint32_t itemId) const;
 
@@ -177,6 +163,7 @@ namespace Game
         void AddMerchant(const MerchantData& merchant);
         void RemoveMerchant(uint32_t merchantId);
         MerchantData* GetMerchant(uint32_t merchantId);
+        const MerchantData* GetMerchant(uint32_t merchantId) const;
         std::vector<MerchantData> GetAllMerchants() const;
         std::vector<MerchantData> GetMerchantsInLocation(const std::string& location) const;
         void RestockMerchant(uint32_t merchantId);
@@ -195,24 +182,54 @@ namespace Game
         void UpdateItemPrices();
         void ApplyInflation(float rate);
 
-        // Economy management
+        // Economy management. Each update restocks only the merchants whose
+        // restock time has come, at most the restock budget of them; any left
+        // over stay first in line for the next update.
         void ProcessEconomyUpdate(float deltaTime);
         void RebalanceEconomy();
         void ResetEconomy();
-        void SaveEconomyState();
-        void LoadEconomyState();
+
+        // Durability. With a state directory set, Initialize restores the last
+        // snapshot and replays the journal written after it; from then on every
+        // change to balances, inventories, merchants, players and the item
+        // catalog is journaled before it is applied, and a call returns, or
+        // runs its callbacks, only once its records are on disk. A change
+        // whose commit fails stays applied in memory but returns false.
+        // SaveEconomyState writes a new snapshot and drops the journal records
+        // it covers; ProcessEconomyUpdate does so every snapshot interval.
+        void SetStateDirectory(const std::string& directory);
+        void SetJournalOptions(const WriteAheadLogOptions& options);
+        void SetSnapshotInterval(float interval);
+        bool SaveEconomyState();
+        bool LoadEconomyState();
+        bool IsJournaling() const;
+
+        // Blocks until every journaled change is on disk
+        bool FlushJournal();
+        WriteAheadLogStats GetJournalStats() const;
 
         // Configuration
         void SetInflationRate(float rate);
         void SetMaxPlayerWeight(uint32_t maxWeight);
         void SetMerchantRestockInterval(float interval);
+        void SetRestockBudget(uint32_t merchantsPerUpdate);
+        std::optional<std::chrono::high_resolution_clock::time_point> GetNextRestockTime(uint32_t merchantId) const;
         void EnableTrading(bool enable);
         void EnableGifting(bool enable);
 
-        // Statistics
+        // Statistics. Gold circulation and player wealth are kept per shard as
+        // transactions apply, and trade counts as purchases and sales commit,
+        // so queries cost the same whatever the population.
         EconomyStats GetStats() const;
         void ResetStats();
         void PrintStats() const;
+        uint64_t GetPlayerWealth(uint32_t playerId) const;
+
+        // Richest first, as (player id, wealth); wealth is currency plus item value
+        std::vector<std::pair<uint32_t, uint64_t>> GetTopWealthyPlayers(size_t count) const;
+
+        // Rebuilds the running totals from the full state
+        void RecalculateStats();
 
         // Callbacks
         using TransactionCompletedCallback = std::function<void(const TransactionData&)>;
@@ -227,10 +244,53 @@ namespace Game
 
     private:
         // Internal methods
+        void InitializeDefaultItems();
+        void InitializeDefaultMerchants();
         bool ValidateTransaction(const TransactionData& transaction) const;
         bool ProcessTransaction(const TransactionData& transaction);
+
+        // Journals the transactions as one atomic group, then applies them;
+        // nothing is applied if the journal write fails. The caller holds the
+        // locks of every player and merchant involved.
+        bool CommitTransactions(const std::vector<TransactionData>& transactions);
+
+        // Moves currency and items as the transactions say, without checks, so
+        // live changes and journal replay share one code path. Runs of item
+        // moves between the same players, as loot drops and trades produce,
+        // are merged into the inventories in one pass, and each player's
+        // wealth is refreshed once per call.
+        void ApplyTransactions(const std::vector<TransactionData>& transactions);
+        void ApplyTransaction(const TransactionData& transaction);
+        void ApplyItemMoves(const TransactionData* first, const TransactionData* last);
+
+        // Catalog, merchant and player changes, shared the same way: the
+        // public methods journal them first, replay applies them directly.
+        // Item changes need the catalog exclusively and every player shard;
+        // the others need the shard of the merchant or player they change.
+        bool ApplyItem(const ItemData& item);
+        bool ApplyItemRemoval(uint32_t itemId);
+        void ApplyMerchant(const MerchantData& merchant);
+        bool ApplyMerchantRemoval(uint32_t merchantId);
+        bool ApplyPlayerRemoval(uint32_t playerId);
+        void ApplyValueScale(float factor);
+
+        // Appends one journal record; true when not journaling
+        bool Journal(const BinaryWriter& record);
+        // Blocks until the caller's journal records are on disk. Called after
+        // releasing the locks, so concurrent changes share one fsync, and
+        // before a change is reported done or its callbacks run.
+        bool WaitForJournal();
+        // Journal replay recreates players that joined after the snapshot
+        PlayerEconomyData& TouchPlayer(uint32_t playerId);
+        // A trade with a merchant the recovered state does not have would
+        // apply only its player half and create or destroy gold, so replay
+        // rejects it and recovery fails instead
+        void ReplayJournalRecord(uint64_t sequence, const uint8_t* data, size_t size);
+        std::string GetSnapshotPath() const;
+        std::string GetJournalPath() const;
+
+        // Takes its own locks, so call it after releasing the transaction's
         void UpdatePlayerWealth(uint32_t playerId);
-        void UpdateEconomyStats();
         void CheckEconomyHealth();
         void CleanupOldTransactions();
         
@@ -240,28 +300,133 @@ namespace Game
         float GetTypeMultiplier(ItemType type) const;
         float GetMerchantMultiplier(uint32_t merchantId) const;
         
-        // Validation
+        // Validation; callers hold the locks of the players and items involved
         bool CanPlayerAfford(uint32_t playerId, CurrencyType currency, uint32_t amount) const;
         bool CanPlayerCarry(uint32_t playerId, uint32_t itemId, uint32_t quantity) const;
+        uint64_t WeightOf(const std::map<uint32_t, uint32_t>& items) const;
         bool IsItemTradeable(uint32_t itemId) const;
         bool IsMerchantActive(uint32_t merchantId) const;
 
+        // Sharding
+        static constexpr size_t ShardCount = 32;
+
+        // Cache line aligned so neighbouring shard locks do not false-share
+        struct alignas(64) PlayerShard
+        {
+            mutable std::shared_mutex mutex;
+            std::map<uint32_t, PlayerEconomyData> players;
+            int64_t gold = 0;                           // Gold held by these players
+            IndexedHeap<uint32_t, uint64_t> wealth;     // Player id -> wealth
+        };
+
+        // One merchant's prices, indexed by item id; 0 for unknown items
+        struct PriceRow
+        {
+            uint64_t epoch = 0;     // Price epoch the row was built in; 0 is never current
+            std::vector<uint32_t> buy;
+            std::vector<uint32_t> sell;
+        };
+
+        struct alignas(64) MerchantShard
+        {
+            mutable std::shared_mutex mutex;
+            std::map<uint32_t, MerchantData> merchants;
+            int64_t gold = 0;
+            std::vector<PriceRow> prices;   // Indexed by merchant id / ShardCount
+        };
+
+        // Locks held by one transaction: the catalog shared, the shards it
+        // changes exclusive
+        struct UpdateLock
+        {
+            std::shared_lock<std::shared_mutex> catalog;
+            std::array<std::unique_lock<std::shared_mutex>, 3> shards;
+        };
+
+        // Every lock, for snapshots, recovery and resets
+        struct GlobalLock
+        {
+            std::unique_lock<std::shared_mutex> catalog;
+            std::vector<std::unique_lock<std::shared_mutex>> shards;
+        };
+
+        PlayerShard& ShardForPlayer(uint32_t playerId) { return m_playerShards[playerId % ShardCount]; }
+        const PlayerShard& ShardForPlayer(uint32_t playerId) const { return m_playerShards[playerId % ShardCount]; }
+        MerchantShard& ShardForMerchant(uint32_t merchantId) { return m_merchantShards[merchantId % ShardCount]; }
+        const MerchantShard& ShardForMerchant(uint32_t merchantId) const { return m_merchantShards[merchantId % ShardCount]; }
+        UpdateLock LockForUpdate(std::initializer_list<uint32_t> playerIds, std::optional<uint32_t> merchantId = std::nullopt);
+        GlobalLock LockEverything();
+
+        // Unlocked helpers; callers hold the catalog and merchant locks.
+        // Quotes read the merchant's price row when it is current and work
+        // the price out from the catalog otherwise.
+        uint32_t QuoteBuyPrice(uint32_t itemId, uint32_t merchantId) const;
+        uint32_t QuoteSellPrice(uint32_t itemId, uint32_t merchantId) const;
+        void RefreshMerchantPrices(MerchantData& merchant);
+
+        // Price table. Anything that changes item values or the catalog calls
+        // InvalidatePrices with the catalog held exclusively; rows are rebuilt
+        // by the next caller holding that merchant's shard exclusively, so a
+        // current row can be read with the merchant's shard lock alone.
+        void InvalidatePrices();
+        const PriceRow* CurrentPriceRow(uint32_t merchantId) const;
+        void RefreshPriceRow(uint32_t merchantId);
+        void ClearAll();
+
+        // Restock schedule; callers of ScheduleRestock hold the merchant's shard
+        void ScheduleRestock(uint32_t merchantId, std::chrono::high_resolution_clock::time_point lastRestock);
+        std::vector<uint32_t> TakeDueRestocks(std::chrono::high_resolution_clock::time_point now);
+
+        // Running totals; callers hold the catalog and the shard locks
+        uint64_t CalculatePlayerWealth(const PlayerEconomyData& player) const;
+        void RefreshWealth(PlayerShard& shard);
+        // Moves holders' carried weight when an item's catalog weight changes
+        void Reweigh(PlayerShard& shard, uint32_t itemId, uint32_t oldWeight, uint32_t newWeight);
+        void RebuildShardTotals();
+
+        // Adds a purchase or sale to the trade counters; caller holds m_statsMutex
+        void CountTradedTransaction(const TransactionData& transaction);
+
         // Member variables
         bool m_initialized;
-        std::map<uint32_t, ItemData> m_items;
-        std::map<uint32_t, PlayerEconomyData> m_playerEconomies;
-        std::map<uint32_t, MerchantData> m_merchants;
-        std::vector<TransactionData> m_transactions;
+        mutable std::shared_mutex m_catalogMutex;   // Guards m_catalog, m_nextItemId and the price columns
+        ItemCatalog m_catalog;
+        std::vector<uint32_t> m_itemValues;         // Item id -> value, for building price rows
+        std::atomic<uint64_t> m_priceEpoch;
+        std::array<PlayerShard, ShardCount> m_playerShards;
+        std::array<MerchantShard, ShardCount> m_merchantShards;
         
         // Configuration
         float m_inflationRate;
         uint32_t m_maxPlayerWeight;
-        float m_merchantRestockInterval;
-        bool m_tradingEnabled;
-        bool m_giftingEnabled;
+        float m_merchantRestockInterval;   // Guarded by m_restockMutex
+        std::atomic<bool> m_tradingEnabled;
+        std::atomic<bool> m_giftingEnabled;
         
-        // Statistics
+        // Statistics; m_statsMutex is taken last and guards the history and
+        // trade counts too
+        mutable std::mutex m_statsMutex;
         EconomyStats m_stats;
+        std::vector<TransactionData> m_transactions;
+        uint64_t m_tradedValue;                                 // Gold paid in purchases and sales
+        std::unordered_map<uint32_t, uint64_t> m_tradeCounts;   // Item id -> purchases and sales
+
+        // Durability; m_snapshotMutex serializes snapshots and recovery
+        std::string m_stateDirectory;
+        WriteAheadLogOptions m_journalOptions;
+        WriteAheadLog m_journal;
+        float m_snapshotInterval;
+        std::mutex m_snapshotMutex;
+        uint64_t m_snapshotSequence;    // Last journal record the snapshot includes
+        bool m_replayFailed;            // A replayed record did not fit the recovered state
+        std::chrono::high_resolution_clock::time_point m_lastSnapshotTime;
+
+        // Merchant id -> next restock time, earliest on top. m_restockMutex is
+        // taken after the shard locks and guards the budget too.
+        mutable std::mutex m_restockMutex;
+        IndexedHeap<uint32_t, std::chrono::high_resolution_clock::time_point,
+                    std::greater<std::chrono::high_resolution_clock::time_point>> m_restockQueue;
+        uint32_t m_restockBudget;
         
         // Callbacks
         TransactionCompletedCallback m_transactionCompletedCallback;
@@ -271,10 +436,13 @@ namespace Game
         
         // Timing
         std::chrono::high_resolution_clock::time_point m_lastUpdateTime;
-        std::chrono::high_resolution_clock::time_point m_lastRestockTime;
         uint32_t m_nextItemId;
-        uint32_t m_nextMerchantId;
-        uint32_t m_nextTransactionId;
+        std::atomic<uint32_t> m_nextMerchantId;
+        std::atomic<uint32_t> m_nextTransactionId;
+
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Economy utilities
@@ -300,7 +468,7 @@ namespace Game
         // Economy analysis
         float CalculatePlayerWealth(const PlayerEconomyData& player);
         float CalculateMerchantValue(const MerchantData& merchant);
-        std::vector<uint32_t> GetTopWealthyPlayers(const std::map<uint32_t, PlayerEconomyData>& players);
+        std::vector<uint32_t> GetTopWealthyPlayers(const std::map<uint32_t, PlayerEconomyData>& players, size_t count = SIZE_MAX);
         
         // Validation
         bool ValidateItemData(const ItemData& item);
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "utils/StringPool.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Game
+{
+    // Currency types
+    enum class CurrencyType
+    {
+        Gold = 0,
+        Silver = 1,
+        Copper = 2,
+        Crowns = 3
+    };
+    constexpr size_t CurrencyTypeCount = 4;
+
+    // Item rarity
+    enum class ItemRarity
+    {
+        Common = 0,
+        Uncommon = 1,
+        Rare = 2,
+        Epic = 3,
+        Legendary = 4,
+        Artifact = 5
+    };
+    constexpr size_t ItemRarityCount = 6;
+
+    // Item types
+    enum class ItemType
+    {
+        Weapon = 0,
+        Armor = 1,
+        Consumable = 2,
+        Material = 3,
+        Quest = 4,
+        Misc = 5
+    };
+    constexpr size_t ItemTypeCount = 6;
+
+    // Price of an item in each currency, indexed by CurrencyType; 0 is unpriced
+    using CurrencyPrices = std::array<uint32_t, CurrencyTypeCount>;
+
+    // Item data
+    struct ItemData
+    {
+        uint32_t itemId;
+        std::string name;
+        std::string description;
+        ItemType type;
+        ItemRarity rarity;
+        uint32_t value;
+        uint32_t weight;
+        uint32_t stackSize;
+        bool isTradeable;
+        bool isSellable;
+        CurrencyPrices prices;
+
+        ItemData() : itemId(0), type(ItemType::Misc), rarity(ItemRarity::Common),
+                    value(0), weight(0), stackSize(1), isTradeable(true), isSellable(true), prices{} {}
+    };
+
+    // Item definitions stored by column: one vector per field, names and
+    // descriptions interned, and every item listed by type and by rarity so
+    // those queries touch only the matching items. ItemData is the exchange
+    // format; Get builds one on demand. Not thread-safe.
+    class ItemCatalog
+    {
+    public:
+        size_t Size() const { return m_itemIds.size(); }
+        bool Contains(uint32_t itemId) const { return m_slots.count(itemId) > 0; }
+
+        // Adds the item, or replaces the one with its id; true if replaced
+        bool Set(const ItemData& item);
+        bool Remove(uint32_t itemId);
+        void Clear();
+
+        std::optional<ItemData> Get(uint32_t itemId) const;
+
+        // Single fields; empty, 0 or false for unknown items
+        const std::string& GetName(uint32_t itemId) const;
+        uint32_t GetValue(uint32_t itemId) const;
+        uint32_t GetWeight(uint32_t itemId) const;
+        bool IsTradeable(uint32_t itemId) const;
+        bool IsSellable(uint32_t itemId) const;
+
+        // Scales every value and currency price, as inflation does
+        void ScaleValues(float factor);
+
+        // Item ids in ascending order. The references are invalidated by the
+        // next change to the catalog.
+        const std::vector<uint32_t>& GetIds() const { return m_sortedIds; }
+        const std::vector<uint32_t>& GetIdsByType(ItemType type) const;
+        const std::vector<uint32_t>& GetIdsByRarity(ItemRarity rarity) const;
+
+        // Approximate bytes held, for footprint reports
+        size_t MemoryUsage() const;
+
+    private:
+        uint32_t SlotOf(uint32_t itemId) const;
+        void Unlist(uint32_t slot);
+
+        // Columns, one entry per item slot
+        std::vector<uint32_t> m_itemIds;
+        std::vector<uint32_t> m_names;          // StringPool ids
+        std::vector<uint32_t> m_descriptions;
+        std::vector<uint8_t> m_types;           // ItemType
+        std::vector<uint8_t> m_rarities;        // ItemRarity
+        std::vector<uint32_t> m_values;
+        std::vector<uint32_t> m_weights;
+        std::vector<uint32_t> m_stackSizes;
+        std::vector<uint8_t> m_flags;           // Tradeable and sellable bits
+        std::vector<CurrencyPrices> m_prices;
+
+        std::unordered_map<uint32_t, uint32_t> m_slots;     // Item id -> slot
+        StringPool m_strings;
+
+        // Posting lists of item ids, kept sorted
+        std::vector<uint32_t> m_sortedIds;
+        std::array<std::vector<uint32_t>, ItemTypeCount> m_idsByType;
+        std::array<std::vector<uint32_t>, ItemRarityCount> m_idsByRarity;
+    };
+}
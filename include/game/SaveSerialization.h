@@ -0,0 +1,148 @@
+#pragma once
+
+#include "game/SharedSaveSystem.h"
+#include "utils/BinaryArchive.h"
+#include <atomic>
+#include <mutex>
+
+namespace Game
+{
+    // Section tags in save archives. The values are stored in save files:
+    // add new ones, never renumber or reuse.
+    enum class SaveSection : uint32_t
+    {
+        Player = 1,
+        World = 2,
+        Quests = 3,
+        Economy = 4,
+        Progression = 5,
+        Monsters = 6,
+        Groups = 7,
+        Merchants = 8,
+        WorldStates = 9,
+        MonsterIndex = 10,
+        MerchantIndex = 11,
+        Items = 12,
+        Transactions = 13,
+
+        // Economy journal records that have no snapshot section of their own
+        RemovedPlayer = 14,
+        RemovedMerchant = 15,
+        RemovedItem = 16,
+        ItemValueScale = 17
+    };
+
+    // Save data <-> BinaryArchive. Each Write* appends one section; each
+    // Read* advances to the first section with its tag, skipping any others,
+    // and returns false if there is none or it does not decode.
+    namespace SaveSerialization
+    {
+        // SaveData::version for files whose payload is a BinaryArchive
+        constexpr uint32_t FormatVersion = 2;
+
+        void WritePlayer(BinaryWriter& out, const PlayerSaveData& player);
+        void WriteWorld(BinaryWriter& out, const WorldSaveData& world);
+        void WriteWorld(BinaryWriter& out, const WorldSaveSnapshot& world);
+        void WriteQuests(BinaryWriter& out, const std::vector<QuestData>& quests);
+        void WriteEconomy(BinaryWriter& out, const std::map<uint32_t, PlayerEconomyData>& economies);
+        void WriteProgression(BinaryWriter& out, const std::map<uint32_t, PlayerProgressionData>& progressions);
+        void WriteMonsters(BinaryWriter& out, const std::map<uint32_t, MonsterAIData>& monsters);
+        void WriteGroups(BinaryWriter& out, const std::map<uint32_t, QuestGroup>& groups);
+        void WriteItems(BinaryWriter& out, const std::map<uint32_t, ItemData>& items);
+        void WriteMerchants(BinaryWriter& out, const std::map<uint32_t, MerchantData>& merchants);
+        void WriteTransactions(BinaryWriter& out, const std::vector<TransactionData>& transactions);
+
+        bool ReadPlayer(BinaryReader& in, PlayerSaveData& player);
+        bool ReadWorld(BinaryReader& in, WorldSaveData& world);
+        bool ReadQuests(BinaryReader& in, std::vector<QuestData>& quests);
+        bool ReadEconomy(BinaryReader& in, std::map<uint32_t, PlayerEconomyData>& economies);
+        bool ReadProgression(BinaryReader& in, std::map<uint32_t, PlayerProgressionData>& progressions);
+        bool ReadMonsters(BinaryReader& in, std::map<uint32_t, MonsterAIData>& monsters);
+        bool ReadGroups(BinaryReader& in, std::map<uint32_t, QuestGroup>& groups);
+        bool ReadItems(BinaryReader& in, std::map<uint32_t, ItemData>& items);
+        bool ReadMerchants(BinaryReader& in, std::map<uint32_t, MerchantData>& merchants);
+        bool ReadTransactions(BinaryReader& in, std::vector<TransactionData>& transactions);
+    }
+
+    // Read-only view of a world save payload for loading on demand. Open only
+    // walks the section headers. Monsters and merchants can be looked up one
+    // at a time through the record index stored next to their section, and
+    // each part is decoded in full the first time it is asked for. Lookups and
+    // lazy decoding are safe from several threads once Open has returned.
+    class WorldSaveView
+    {
+    public:
+        WorldSaveView() = default;
+        WorldSaveView(const WorldSaveView&) = delete;
+        WorldSaveView& operator=(const WorldSaveView&) = delete;
+
+        // Takes over the payload; false if it holds no readable world section
+        bool Open(std::vector<uint8_t> payload);
+
+        uint32_t GetWorldId() const { return m_worldId; }
+        const std::string& GetWorldName() const { return m_worldName; }
+        std::chrono::high_resolution_clock::time_point GetLastUpdate() const { return m_lastUpdate; }
+
+        size_t GetMonsterCount() const { return m_monsterIndex.count; }
+        size_t GetMerchantCount() const { return m_merchantIndex.count; }
+
+        // Decodes a single record; false if it is missing or damaged
+        bool FindMonster(uint32_t monsterId, MonsterAIData& monster) const;
+        bool FindMerchant(uint32_t merchantId, MerchantData& merchant) const;
+
+        // Whole parts, decoded once; nullptr if the part is damaged
+        const std::map<uint32_t, MonsterAIData>* GetMonsters() const;
+        const std::map<uint32_t, MerchantData>* GetMerchants() const;
+        const std::vector<QuestData>* GetQuests() const;
+        const std::map<std::string, bool>* GetWorldStates() const;
+
+        bool IsDecoded(SaveSection part) const;
+
+        // Copies every part into world, decoding the ones still cold
+        bool Materialize(WorldSaveData& world) const;
+
+    private:
+        // A nested section's body inside m_payload
+        struct Part
+        {
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+            uint32_t version = 0;
+            bool present = false;
+            mutable std::once_flag once;
+            mutable std::atomic<bool> decoded{ false };
+            mutable bool valid = false;
+        };
+
+        // Sorted (key, offset) pairs, 4-byte little-endian each
+        struct RecordIndex
+        {
+            const uint8_t* entries = nullptr;   // Into m_payload, or built
+            uint32_t count = 0;
+            std::vector<uint8_t> built;         // Rebuilt when the save has no usable index
+        };
+
+        static bool OpenIndex(const Part& part, const uint8_t* stored, size_t storedSize, RecordIndex& index);
+        static bool FindOffset(const RecordIndex& index, uint32_t key, uint32_t& offset);
+
+        template<typename T, typename DecodeFn>
+        const T* DecodeOnce(const Part& part, T& value, DecodeFn decode) const;
+
+        std::vector<uint8_t> m_payload;
+        uint32_t m_worldId = 0;
+        std::string m_worldName;
+        std::chrono::high_resolution_clock::time_point m_lastUpdate;
+
+        Part m_monstersPart;
+        Part m_merchantsPart;
+        Part m_questsPart;
+        Part m_worldStatesPart;
+        RecordIndex m_monsterIndex;
+        RecordIndex m_merchantIndex;
+
+        mutable std::map<uint32_t, MonsterAIData> m_monsters;
+        mutable std::map<uint32_t, MerchantData> m_merchants;
+        mutable std::vector<QuestData> m_quests;
+        mutable std::map<std::string, bool> m_worldStates;
+    };
+}
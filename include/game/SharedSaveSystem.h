@@ -5,11 +5,20 @@
 #include "game/SyncedMonsterAI.h"
 #include "game/GlobalEconomy.h"
 #include "game/SharedProgression.h"
+#include "utils/ChunkStore.h"
+#include "utils/CopyOnWrite.h"
+#include "utils/HdrHistogram.h"
+#include "utils/Metrics.h"
 #include <vector>
 #include <map>
 #include <string>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace Game
 {
@@ -75,6 +84,41 @@ namespace Game
         WorldSaveData() : worldId(0) {}
     };
 
+    // A world save taken from a WorldSaveState: its parts as they were when
+    // the save was queued
+    struct WorldSaveSnapshot
+    {
+        uint32_t worldId = 0;
+        std::string worldName;
+        std::shared_ptr<const std::map<uint32_t, MonsterAIData>> monsters;
+        std::shared_ptr<const std::map<uint32_t, MerchantData>> merchants;
+        std::shared_ptr<const std::vector<QuestData>> quests;
+        std::shared_ptr<const std::map<std::string, bool>> worldStates;
+        std::chrono::high_resolution_clock::time_point lastUpdate;
+    };
+
+    // World data kept on the tick thread for frequent async saves. Each part
+    // is copied on write by itself, so a change made while a save is in
+    // flight clones only the part it touches and the rest stays shared.
+    struct WorldSaveState
+    {
+        uint32_t worldId = 0;
+        std::string worldName;
+        CopyOnWrite<std::map<uint32_t, MonsterAIData>> monsters;
+        CopyOnWrite<std::map<uint32_t, MerchantData>> merchants;
+        CopyOnWrite<std::vector<QuestData>> quests;
+        CopyOnWrite<std::map<std::string, bool>> worldStates;
+        std::chrono::high_resolution_clock::time_point lastUpdate;
+
+        WorldSaveState() = default;
+        explicit WorldSaveState(WorldSaveData data);
+
+        WorldSaveSnapshot Snapshot() const;
+
+        // Time the parts spent cloning since the last call
+        std::chrono::steady_clock::duration TakeCloneTime();
+    };
+
     // Save metadata
     struct SaveMetadata
     {
@@ -88,8 +132,9 @@ namespace Game
         std::string checksum;
         bool isCorrupted;
         bool isBackup;
+        uint32_t backupOf;          // Save a backup was taken from, 0 for saves
         
-        SaveMetadata() : saveId(0), version(1), fileSize(0), isCorrupted(false), isBackup(false) {}
+        SaveMetadata() : saveId(0), version(1), fileSize(0), isCorrupted(false), isBackup(false), backupOf(0) {}
     };
 
     // Save statistics
@@ -102,6 +147,17 @@ namespace Game
         float averageSaveTime = 0.0f;
         float compressionRatio = 0.0f;
         uint32_t lastSaveId = 0;
+        uint32_t asyncSaves = 0;         // Saves handed to the save worker
+        uint32_t coalescedSaves = 0;     // Queued saves replaced by a newer snapshot
+        uint32_t failedSaves = 0;
+        uint32_t pendingSaves = 0;       // Queued or being written
+        float averageStallTime = 0.0f;   // Tick-thread cost of an async save, ms
+        float p99StallTime = 0.0f;       // ms
+        float maxStallTime = 0.0f;       // ms
+        uint64_t chunksWritten = 0;      // New chunks written to the chunk store
+        uint64_t chunksReused = 0;       // Chunks a save shared with earlier ones
+        uint64_t chunkBytesWritten = 0;
+        uint64_t chunksCollected = 0;    // Unreferenced chunks deleted
         
         void Reset()
         {
@@ -112,9 +168,22 @@ namespace Game
             averageSaveTime = 0.0f;
             compressionRatio = 0.0f;
             lastSaveId = 0;
+            asyncSaves = 0;
+            coalescedSaves = 0;
+            failedSaves = 0;
+            pendingSaves = 0;
+            averageStallTime = 0.0f;
+            p99StallTime = 0.0f;
+            maxStallTime = 0.0f;
+            chunksWritten = 0;
+            chunksReused = 0;
+            chunkBytesWritten = 0;
+            chunksCollected = 0;
         }
     };
 
+    class WorldSaveView;
+
     // Shared save system
     class SharedSaveSystem
     {
@@ -135,9 +204,38 @@ namespace Game
         bool SaveMonsterData(const std::map<uint32_t, MonsterAIData>& monsters);
         bool SaveGroupData(const std::map<uint32_t, QuestGroup>& groups);
 
+        // Asynchronous saves. The calling (tick) thread only takes the snapshot
+        // and queues it; serialization, checksum, compression and the durable
+        // write run on the save worker. Passing a shared snapshot, or state kept
+        // in a CopyOnWrite or WorldSaveState, makes the tick-thread cost O(1);
+        // the clones their writes make while a save holds the snapshot are
+        // charged to the next save's stall time. A queued
+        // save that has not started yet is replaced by a newer one for the same
+        // player/world. Returns the save ID, or 0 if not initialized.
+        uint32_t SavePlayerDataAsync(uint32_t playerId, const PlayerSaveData& playerData);
+        uint32_t SavePlayerDataAsync(uint32_t playerId, std::shared_ptr<const PlayerSaveData> snapshot);
+        uint32_t SavePlayerDataAsync(uint32_t playerId, CopyOnWrite<PlayerSaveData>& playerData);
+        uint32_t SaveWorldDataAsync(uint32_t worldId, const WorldSaveData& worldData);
+        uint32_t SaveWorldDataAsync(uint32_t worldId, std::shared_ptr<const WorldSaveData> snapshot);
+        uint32_t SaveWorldDataAsync(uint32_t worldId, WorldSaveState& worldData);
+
+        // Tick thread: applies finished async saves to metadata and statistics
+        // and fires SaveCompletedCallback. Returns how many completed.
+        size_t ProcessCompletedSaves();
+
+        // Blocks until every queued save is written, then processes them
+        void FlushPendingSaves();
+        size_t GetPendingSaveCount() const;
+
         // Load operations
         bool LoadPlayerData(uint32_t playerId, PlayerSaveData& playerData);
         bool LoadWorldData(uint32_t worldId, WorldSaveData& worldData);
+
+        // Loads and verifies a world save without decoding it; monsters and
+        // merchants can be queried right away and the rest is decoded on first
+        // use, so startup does not wait on cold parts of a large world
+        bool OpenWorldSave(uint32_t worldId, std::shared_ptr<const WorldSaveView>& view);
+
         bool LoadQuestData(std::vector<QuestData>& quests);
         bool LoadEconomyData(std::map<uint32_t, PlayerEconomyData>& playerEconomies);
         bool LoadProgressionData(std::map<uint32_t, PlayerProgressionData>& playerProgressions);
@@ -158,13 +256,19 @@ namespace Game
         std::vector<SaveMetadata> GetBackups(uint32_t saveId) const;
         bool DeleteBackup(uint32_t saveId, uint32_t backupId);
 
+        // Deletes chunks no save or backup references any more. Runs on the
+        // save worker after the saves queued before it; called automatically
+        // when saves or backups are deleted.
+        void CollectGarbage();
+
         // Data validation
         bool ValidateSaveData(uint32_t saveId);
         bool RepairSaveData(uint32_t saveId);
         bool IsSaveCorrupted(uint32_t saveId) const;
         std::vector<uint32_t> GetCorruptedSaves() const;
 
-        // Compression and encryption
+        // Compression and encryption. New saves are compressed while stored
+        // when compression is enabled; these rewrite an existing save's chunks.
         bool CompressSaveData(uint32_t saveId);
         bool DecompressSaveData(uint32_t saveId);
         bool EncryptSaveData(uint32_t saveId, const std::string& password);
@@ -200,9 +304,49 @@ namespace Game
         void SetBackupCreatedCallback(BackupCreatedCallback callback);
 
     private:
+        // Async save pipeline
+        struct SaveJob
+        {
+            uint32_t saveId = 0;
+            std::string saveName;
+            std::string description;
+            SaveDataType type = SaveDataType::Player;
+            std::shared_ptr<const PlayerSaveData> player;
+            std::shared_ptr<const WorldSaveData> world;
+            std::shared_ptr<const WorldSaveSnapshot> worldParts;   // Or a WorldSaveState's parts
+            bool compress = false;
+            bool collectGarbage = false;     // Chunk GC instead of a save
+        };
+
+        struct SaveResult
+        {
+            uint32_t saveId = 0;
+            std::string saveName;
+            std::string description;
+            bool success = false;
+            uint32_t version = 1;
+            uint32_t checksum = 0;
+            uint32_t size = 0;
+            std::chrono::high_resolution_clock::time_point timestamp;
+            uint64_t writeMicros = 0;
+        };
+
+        uint32_t QueueSave(SaveJob job, std::chrono::steady_clock::time_point stallStart);
+        SaveResult WriteSave(const SaveJob& job);
+        void SaveWorkerThread();
+        void StartSaveWorker();
+        void StopSaveWorker();
+        void ApplySaveResult(const SaveResult& result);
+        void RunGarbageCollection();
+        bool ReadManifest(const std::string& filePath, SaveData& header, std::vector<ChunkRef>& refs) const;
+        bool WriteManifest(const SaveData& header, const std::vector<ChunkRef>& refs, const std::string& filePath);
+        bool RecodeSave(uint32_t saveId, bool compress);
+        bool DeleteBackupFiles(uint32_t saveId, uint32_t backupId);
+
         // Internal methods
         bool SaveDataToFile(const SaveData& saveData, const std::string& filePath);
         bool LoadDataFromFile(SaveData& saveData, const std::string& filePath);
+        bool LoadWorldPayload(uint32_t worldId, uint32_t& saveId, SaveData& saveData);
         std::string GetSaveFilePath(uint32_t saveId) const;
         std::string GetBackupFilePath(uint32_t saveId, uint32_t backupId) const;
         std::string GetMetadataFilePath() const;
@@ -210,6 +354,7 @@ namespace Game
         // Data serialization
         std::vector<uint8_t> SerializePlayerData(const PlayerSaveData& playerData);
         std::vector<uint8_t> SerializeWorldData(const WorldSaveData& worldData);
+        std::vector<uint8_t> SerializeWorldData(const WorldSaveSnapshot& worldData);
         std::vector<uint8_t> SerializeQuestData(const std::vector<QuestData>& quests);
         std::vector<uint8_t> SerializeEconomyData(const std::map<uint32_t, PlayerEconomyData>& playerEconomies);
         std::vector<uint8_t> SerializeProgressionData(const std::map<uint32_t, PlayerProgressionData>& playerProgressions);
@@ -238,7 +383,7 @@ namespace Game
         
         // Metadata management
         void LoadMetadata();
-        void SaveMetadata();
+        void SaveMetadataFile();
         void UpdateSaveMetadata(uint32_t saveId, const SaveMetadata& metadata);
 
         // Member variables
@@ -265,6 +410,30 @@ namespace Game
         // Timing
         std::chrono::high_resolution_clock::time_point m_lastAutoSave;
         uint32_t m_nextSaveId;
+
+        // Save worker. Metadata, statistics and callbacks stay on the tick
+        // thread; the worker only reads job snapshots and writes files.
+        std::thread m_saveWorker;
+        mutable std::mutex m_saveQueueMutex;
+        std::condition_variable m_saveQueueCondition;
+        std::condition_variable m_saveIdleCondition;
+        std::deque<SaveJob> m_saveQueue;
+        std::vector<SaveResult> m_completedSaves;
+        size_t m_savesInFlight = 0;      // Queued plus the one being written
+        bool m_stopSaveWorker = false;
+        HdrHistogram m_saveStallTimes;   // Tick-thread cost per async save, microseconds
+        HdrHistogram m_saveWriteTimes;   // Worker time per save, microseconds
+
+        // Save payloads live in the chunk store; save and backup files are
+        // manifests listing their chunks. m_storageMutex keeps a save's chunk
+        // writes and its manifest together with respect to garbage collection.
+        ChunkStore m_chunkStore;
+        std::mutex m_storageMutex;
+        std::unique_ptr<ThreadPool> m_savePool;
+
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Save utilities
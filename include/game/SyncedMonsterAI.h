@@ -2,6 +2,7 @@
 
 #include "Common.h"
 #include "game/Entities/Npc/Npc.h"
+#include "utils/Metrics.h"
 #include <vector>
 #include <map>
 #include <queue>
@@ -279,6 +280,10 @@ namespace Game
         std::chrono::high_resolution_clock::time_point m_lastSyncTime;
         uint32_t m_nextMonsterId;
         uint32_t m_nextGroupId;
+
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Monster AI utilities
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "optimization/CombatExecutor.h"
 #include "optimization/CombatOptimizer.h"
 #include "integration/REDkitBridge.h"
 #include "integration/WitcherScriptBridge.h"
@@ -28,10 +29,15 @@ namespace TW3Integration
         std::atomic<bool> m_processing;
         std::atomic<bool> m_running;
         
-        // Processing thread
+        // Processing thread (polling mode)
         std::thread m_processingThread;
         std::atomic<bool> m_shouldStop;
         
+        // Event-driven executor (replaces the polling thread when enabled)
+        std::unique_ptr<TW3Optimization::CombatExecutor> m_executor;
+        TW3Optimization::CombatExecutorConfig m_executorConfig;
+        bool m_eventDriven;
+        
         // Performance monitoring
         std::chrono::steady_clock::time_point m_lastProcessTime;
         uint64_t m_processedActions;
@@ -97,6 +103,8 @@ namespace TW3Integration
         void SetProcessingInterval(uint32_t interval);
         void SetMaxProcessingTime(uint32_t maxTime);
         void SetMaxQueueSize(uint32_t maxSize);
+        void SetEventDrivenProcessing(bool enabled, const TW3Optimization::CombatExecutorConfig& config = TW3Optimization::CombatExecutorConfig());
+        bool IsEventDriven() const;
         
         // Health checks
         bool IsHealthy() const;
@@ -140,11 +148,16 @@ namespace TW3Integration
         bool enablePerformanceMonitoring;
         bool enableStatistics;
         bool enableDebugLogging;
+        bool enableEventDrivenExecutor;   // Wake on Critical/High actions instead of polling
+        uint32_t executorSpinMicros;      // Busy-wait before the executor parks
+        int32_t executorCpuAffinity;      // Core for the executor thread, -1 for none
         
         CombatSystemConfig() : processingInterval(16), maxProcessingTime(10), 
                              maxQueueSize(1000), batchSize(50),
                              enablePerformanceMonitoring(true),
-                             enableStatistics(true), enableDebugLogging(false) {}
+                             enableStatistics(true), enableDebugLogging(false),
+                             enableEventDrivenExecutor(false), executorSpinMicros(50),
+                             executorCpuAffinity(-1) {}
     };
 
     // Combat system factory
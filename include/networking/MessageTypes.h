@@ -10,8 +10,8 @@ namespace Networking
         // Connection messages
         ClientConnect = 1,
         ClientDisconnect = 2,
-        ClientPing = 3,
-        ServerPong = 4,
+        ClientPing = 3,     // t0: client send time, in the client's own units
+        ServerPong = 4,     // t0 echoed, then server receive (t1) and reply (t2) in microseconds
         
         // Player messages
         PlayerJoin = 10,
@@ -51,7 +51,7 @@ namespace Networking
         
         // Witcher3-MP specific messages (unified)
         TC_REQUEST_PLAYERDATA = 200,
-        TC_UPDATE_POS = 201,
+        TC_UPDATE_POS = 201,    // Server time (us), player ID, position, move type
         TS_SEND_PLAYERDATA = 202,
         TC_CREATE_PLAYER = 203,
         TC_MASS_CREATE_PLAYER = 204,
@@ -4,6 +4,7 @@
 #include <fstream>
 #include <vector>
 #include <memory>
+#include "utils/Metrics.h"
 
 namespace Networking
 {
@@ -68,6 +69,10 @@ namespace Networking
         float m_averageLatency;
         
         static NetworkLogger* s_instance;
+
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Convenience macros for network logging
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Common.h"
+#include "net_message.h"
+
+namespace Networking
+{
+    // Captured traffic file (*.tw3cap):
+    //   header: magic, version, sizeof(message_header<T>)
+    //   events: kind (uint8), timestamp ns since capture start (uint64),
+    //           connection ID (uint32), and for messages the raw header bytes
+    //           followed by body size (uint32) and body bytes
+    enum class capture_event_kind : uint8_t
+    {
+        connect = 1,
+        disconnect = 2,
+        message = 3
+    };
+
+    template<typename T>
+    struct captured_event
+    {
+        capture_event_kind kind = capture_event_kind::message;
+        uint64_t timestampNs = 0;
+        uint32_t connectionId = 0;
+        message<T> msg;
+    };
+
+    namespace capture_format
+    {
+        constexpr char magic[8] = { 'T', 'W', '3', 'C', 'A', 'P', '\0', '\0' };
+        constexpr uint32_t version = 1;
+        constexpr uint32_t maxBodySize = 16 * 1024 * 1024;
+    }
+
+    // Appends server events to a capture file. Safe to call from the asio
+    // thread (connects) and the update thread (messages) at once.
+    template<typename T>
+    class capture_writer
+    {
+    public:
+        capture_writer() = default;
+        ~capture_writer() { Close(); }
+
+        capture_writer(const capture_writer&) = delete;
+        capture_writer& operator=(const capture_writer&) = delete;
+
+        bool Open(const std::string& filename)
+        {
+            std::scoped_lock lock(muxFile);
+            if (m_file.is_open())
+                m_file.close();
+
+            m_file.open(filename, std::ios::binary | std::ios::trunc);
+            if (!m_file.is_open())
+                return false;
+
+            uint32_t headerSize = sizeof(message_header<T>);
+            m_file.write(capture_format::magic, sizeof(capture_format::magic));
+            m_file.write(reinterpret_cast<const char*>(&capture_format::version), sizeof(uint32_t));
+            m_file.write(reinterpret_cast<const char*>(&headerSize), sizeof(headerSize));
+
+            m_tpStart = std::chrono::steady_clock::now();
+            m_nEventsWritten = 0;
+            m_bOpen = true;
+            return true;
+        }
+
+        void Close()
+        {
+            std::scoped_lock lock(muxFile);
+            m_bOpen = false;
+            if (m_file.is_open())
+                m_file.close();
+        }
+
+        // Lock-free check so the receive path costs nothing while not capturing
+        bool IsOpen() const { return m_bOpen.load(std::memory_order_relaxed); }
+
+        uint64_t GetEventsWritten() const { return m_nEventsWritten.load(std::memory_order_relaxed); }
+
+        void RecordConnection(capture_event_kind kind, uint32_t connectionId, std::chrono::steady_clock::time_point tp)
+        {
+            std::scoped_lock lock(muxFile);
+            if (!m_file.is_open())
+                return;
+
+            WriteEventHeader(kind, connectionId, tp);
+            m_nEventsWritten++;
+        }
+
+        void RecordMessage(uint32_t connectionId, std::chrono::steady_clock::time_point tp, const message<T>& msg)
+        {
+            std::scoped_lock lock(muxFile);
+            if (!m_file.is_open())
+                return;
+
+            uint32_t bodySize = static_cast<uint32_t>(msg.body.size());
+            WriteEventHeader(capture_event_kind::message, connectionId, tp);
+            m_file.write(reinterpret_cast<const char*>(&msg.header), sizeof(message_header<T>));
+            m_file.write(reinterpret_cast<const char*>(&bodySize), sizeof(bodySize));
+            m_file.write(reinterpret_cast<const char*>(msg.body.data()), bodySize);
+            m_nEventsWritten++;
+        }
+
+    private:
+        void WriteEventHeader(capture_event_kind kind, uint32_t connectionId, std::chrono::steady_clock::time_point tp)
+        {
+            // Events stamped before the capture started (queued earlier) are clamped to zero
+            int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(tp - m_tpStart).count();
+            uint64_t timestampNs = elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0;
+            uint8_t kindByte = static_cast<uint8_t>(kind);
+
+            m_file.write(reinterpret_cast<const char*>(&kindByte), sizeof(kindByte));
+            m_file.write(reinterpret_cast<const char*>(&timestampNs), sizeof(timestampNs));
+            m_file.write(reinterpret_cast<const char*>(&connectionId), sizeof(connectionId));
+        }
+
+        std::mutex muxFile;
+        std::ofstream m_file;
+        std::chrono::steady_clock::time_point m_tpStart;
+        std::atomic<bool> m_bOpen{ false };
+        std::atomic<uint64_t> m_nEventsWritten{ 0 };
+    };
+
+    // Reads a capture file event by event
+    template<typename T>
+    class capture_reader
+    {
+    public:
+        bool Open(const std::string& filename)
+        {
+            m_file.open(filename, std::ios::binary);
+            if (!m_file.is_open())
+                return false;
+
+            char magic[sizeof(capture_format::magic)];
+            uint32_t version = 0;
+            uint32_t headerSize = 0;
+            m_file.read(magic, sizeof(magic));
+            m_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+            m_file.read(reinterpret_cast<char*>(&headerSize), sizeof(headerSize));
+
+            // Captures are only replayable into the message type they were recorded with
+            if (!m_file || std::memcmp(magic, capture_format::magic, sizeof(magic)) != 0 ||
+                version != capture_format::version || headerSize != sizeof(message_header<T>))
+            {
+                m_file.close();
+                return false;
+            }
+            return true;
+        }
+
+        // False at the end of the file or on a truncated event
+        bool Next(captured_event<T>& event)
+        {
+            uint8_t kindByte = 0;
+            if (!m_file.read(reinterpret_cast<char*>(&kindByte), sizeof(kindByte)))
+            {
+                m_bReachedEnd = m_file.gcount() == 0;
+                return false;
+            }
+
+            m_file.read(reinterpret_cast<char*>(&event.timestampNs), sizeof(event.timestampNs));
+            m_file.read(reinterpret_cast<char*>(&event.connectionId), sizeof(event.connectionId));
+            event.kind = static_cast<capture_event_kind>(kindByte);
+            event.msg = message<T>();
+
+            if (event.kind == capture_event_kind::message)
+            {
+                uint32_t bodySize = 0;
+                m_file.read(reinterpret_cast<char*>(&event.msg.header), sizeof(message_header<T>));
+                m_file.read(reinterpret_cast<char*>(&bodySize), sizeof(bodySize));
+                if (!m_file || bodySize > capture_format::maxBodySize)
+                    return false;
+
+                event.msg.body.resize(bodySize);
+                m_file.read(reinterpret_cast<char*>(event.msg.body.data()), bodySize);
+            }
+            else if (event.kind != capture_event_kind::connect && event.kind != capture_event_kind::disconnect)
+            {
+                return false;
+            }
+
+            return static_cast<bool>(m_file);
+        }
+
+        // True once Next stopped at a clean end of file rather than a bad event
+        bool ReachedEnd() const { return m_bReachedEnd; }
+
+    private:
+        std::ifstream m_file;
+        bool m_bReachedEnd = false;
+    };
+
+    // Result of server_interface::Replay
+    struct replay_stats
+    {
+        uint64_t messages = 0;
+        uint64_t connects = 0;
+        uint64_t disconnects = 0;
+        std::chrono::nanoseconds recordedDuration{ 0 };
+        std::chrono::nanoseconds replayDuration{ 0 };
+        bool complete = false;   // False when the file was missing, invalid or truncated
+    };
+}
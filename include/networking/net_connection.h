@@ -3,6 +3,7 @@
 #include "Common.h"
 #include "net_message.h"
 #include "net_tsqueue.h"
+#include "utils/TraceRecorder.h"
 #include <asio.hpp>
 #include <memory>
 #include <queue>
@@ -20,6 +21,7 @@ namespace Networking
     {
         std::shared_ptr<connection<T>> remote = nullptr;
         message<T> msg;
+        std::chrono::steady_clock::time_point received = std::chrono::steady_clock::now();
 
         friend std::ostream& operator << (std::ostream& os, const owned_message<T>& msg)
         {
@@ -55,6 +57,7 @@ namespace Networking
                 if (m_socket.is_open())
                 {
                     id = uid;
+                    SetNoDelay();
                     ReadHeader();
                 }
             }
@@ -69,6 +72,7 @@ namespace Networking
                     {
                         if (!ec)
                         {
+                            SetNoDelay();
                             ReadHeader();
                         }
                     });
@@ -86,8 +90,21 @@ namespace Networking
             return m_socket.is_open();
         }
 
+        // Turns an unconnected instance into the stand-in for a captured
+        // remote during replay: it carries the recorded ID and discards sends
+        void AttachReplay(uint32_t uid)
+        {
+            id = uid;
+            m_bReplay = true;
+        }
+
+        bool IsReplay() const { return m_bReplay; }
+
         void Send(const message<T>& msg)
         {
+            if (m_bReplay)
+                return;
+
             asio::post(m_asioContext,
                 [this, msg]()
                 {
@@ -101,6 +118,14 @@ namespace Networking
         }
 
     private:
+        // Header and body go out as separate writes; with Nagle enabled the body
+        // waits on the peer's delayed ACK (~40 ms per message)
+        void SetNoDelay()
+        {
+            std::error_code ec;
+            m_socket.set_option(asio::ip::tcp::no_delay(true), ec);
+        }
+
         void ReadHeader()
         {
             asio::async_read(m_socket, asio::buffer(&m_msgTemporaryIn.header, sizeof(message_header<T>)),
@@ -108,9 +133,15 @@ namespace Networking
                 {
                     if (!ec)
                     {
-                        if (m_msgTemporaryIn.header.size > 0)
+                        if (m_msgTemporaryIn.header.size > max_message_body_size)
+                        {
+                            std::cout << "[" << id << "] Message too large (" << m_msgTemporaryIn.header.size << " bytes).\n";
+                            m_socket.close();
+                        }
+                        else if (m_msgTemporaryIn.header.size > 0)
                         {
-                            m_msgTemporaryIn.body.resize(m_msgTemporaryIn.header.size - sizeof(message_header<T>));
+                            // header.size is the body size, as set by message::operator<<
+                            m_msgTemporaryIn.body.resize(m_msgTemporaryIn.header.size);
                             ReadBody();
                         }
                         else
@@ -194,12 +225,14 @@ namespace Networking
 
         void AddToIncomingMessageQueue()
         {
+            TRACE_SCOPE_ARG("connection::Enqueue", "net", "bytes", m_msgTemporaryIn.body.size());
             if (m_nOwnerType == owner::server)
                 m_qMessagesIn.push_back({ this->shared_from_this(), m_msgTemporaryIn });
             else
                 m_qMessagesIn.push_back({ nullptr, m_msgTemporaryIn });
 
             m_msgTemporaryIn = message<T>();
+            ReadHeader();
         }
 
     protected:
@@ -210,5 +243,6 @@ namespace Networking
         message<T> m_msgTemporaryIn;
         owner m_nOwnerType = owner::server;
         uint32_t id = 0;
+        bool m_bReplay = false;
     };
 }
\ No newline at end of file
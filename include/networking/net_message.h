@@ -4,6 +4,10 @@
 
 namespace Networking
 {
+    // Largest body a connection will read. The size comes from the peer, so
+    // a header announcing more drops the connection instead of allocating it.
+    constexpr uint32_t max_message_body_size = 1024 * 1024;
+
     template<typename T>
     struct message_header
     {
@@ -4,6 +4,8 @@
 #include "net_connection.h"
 #include "net_message.h"
 #include "net_tsqueue.h"
+#include "net_capture.h"
+#include "utils/TraceRecorder.h"
 #include <asio.hpp>
 
 namespace Networking
@@ -16,9 +18,18 @@ namespace Networking
 			: m_asioAcceptor(m_asioContext, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port))
 		{}
 
+		// Offline server for Replay(): no listening socket, never started
+		server_interface()
+			: m_asioAcceptor(m_asioContext)
+		{}
+
 		virtual ~server_interface()
 		{
 			Stop();
+
+			// Connections hold sockets on m_asioContext, which is destroyed first
+			m_qMessagesIn.clear();
+			m_deqConnections.clear();
 		}
 
 		bool Start()
@@ -27,7 +38,11 @@ namespace Networking
 			{
 				WaitForClientConnection();
 
-				m_threadContext = std::thread([this]() {m_asioContext.run(); });
+				m_threadContext = std::thread([this]()
+				{
+					TraceRecorder::GetInstance().SetThreadName("asio");
+					m_asioContext.run();
+				});
 			}
 			catch (std::exception& e)
 			{
@@ -45,6 +60,8 @@ namespace Networking
 
 			if (m_threadContext.joinable()) m_threadContext.join();
 
+			StopCapture();
+
 			std::cout << "Server stopped!\n";
 		}
 
@@ -66,6 +83,10 @@ namespace Networking
 
 							m_deqConnections.back()->ConnectToClient(nIDCounter++);
 
+							if (m_captureWriter.IsOpen())
+								m_captureWriter.RecordConnection(capture_event_kind::connect,
+									m_deqConnections.back()->GetID(), std::chrono::steady_clock::now());
+
 							//std::cout << "[" << m_deqConnections.back()->GetID() << "] Connection Approved\n";
 						}
 						else
@@ -84,12 +105,17 @@ namespace Networking
 
 		void MessageClient(std::shared_ptr<connection<T>> client, const message<T>& msg)
 		{
+			if (client && client->IsReplay())
+				return;
+
 			if (client && client->IsConnected())
 			{
 				client->Send(msg);
 			}
 			else
 			{
+				if (client)
+					RecordDisconnect(client);
 				OnClientDisconnect(client);
 				client.reset();
 				m_deqConnections.erase(std::remove(m_deqConnections.begin(),
@@ -110,6 +136,8 @@ namespace Networking
 				}
 				else
 				{
+					if (client)
+						RecordDisconnect(client);
 					OnClientDisconnect(client);
 					client.reset();
 					bInvalidClientExists = true;
@@ -124,17 +152,138 @@ namespace Networking
 		void Update(size_t nMaxMessages = -1, bool bWait = false)
 		{
 			if (bWait) m_qMessagesIn.wait();
+			TRACE_SCOPE("server::Update", "net");
 			size_t nMessageCount = 0;
 			while (nMessageCount < nMaxMessages && !m_qMessagesIn.empty())
 			{
 				auto msg = m_qMessagesIn.pop_front();
 
-				OnMessageReceived(msg.remote, msg.msg);
+				// Recorded before the handler consumes the body
+				if (m_captureWriter.IsOpen())
+					m_captureWriter.RecordMessage(msg.remote ? msg.remote->GetID() : 0, msg.received, msg.msg);
+
+				{
+					TRACE_SCOPE_ARG("OnMessageReceived", "net", "type", msg.msg.header.id);
+					OnMessageReceived(msg.remote, msg.msg);
+				}
 
 				nMessageCount++;
 			}
 		}
 
+		// Traffic capture: records every inbound message with its connection ID
+		// and arrival time, plus connects and disconnects, for offline replay
+		bool StartCapture(const std::string& filename)
+		{
+			if (!m_captureWriter.Open(filename))
+			{
+				std::cout << "Failed to open capture file: " << filename << "\n";
+				return false;
+			}
+
+			// Clients connected before the capture started appear as connects at time zero
+			for (auto& client : m_deqConnections)
+			{
+				if (client && client->IsConnected())
+					m_captureWriter.RecordConnection(capture_event_kind::connect, client->GetID(), std::chrono::steady_clock::now());
+			}
+
+			std::cout << "Capturing traffic to " << filename << "\n";
+			return true;
+		}
+
+		void StopCapture()
+		{
+			if (!m_captureWriter.IsOpen())
+				return;
+
+			m_captureWriter.Close();
+			std::cout << "Traffic capture stopped (" << m_captureWriter.GetEventsWritten() << " events)\n";
+		}
+
+		bool IsCapturing() const { return m_captureWriter.IsOpen(); }
+
+		// Feeds a capture back through OnClientConnect, OnMessageReceived and
+		// OnClientDisconnect on the calling thread. Each captured connection gets
+		// a socketless stand-in with its recorded ID; messages sent to it are
+		// dropped, and stand-ins still connected at the end of the capture are
+		// disconnected. speed scales the recorded timing (2.0 = twice as fast), 0
+		// replays as fast as possible. Only runs on an offline server: with a
+		// listener, real clients would see the replayed players.
+		replay_stats Replay(const std::string& filename, double speed = 1.0)
+		{
+			replay_stats stats;
+			if (m_asioAcceptor.is_open() || !m_deqConnections.empty())
+			{
+				std::cout << "Replay needs an offline server\n";
+				return stats;
+			}
+
+			capture_reader<T> reader;
+			if (!reader.Open(filename))
+			{
+				std::cout << "Failed to open capture file: " << filename << "\n";
+				return stats;
+			}
+
+			std::map<uint32_t, std::shared_ptr<connection<T>>> mapReplayClients;
+			auto GetReplayClient = [this, &mapReplayClients](uint32_t id)
+			{
+				auto& client = mapReplayClients[id];
+				if (!client)
+				{
+					client = std::make_shared<connection<T>>(connection<T>::owner::server,
+						m_asioContext, asio::ip::tcp::socket(m_asioContext), m_qMessagesIn);
+					client->AttachReplay(id);
+				}
+				return client;
+			};
+
+			captured_event<T> event;
+			auto tpStart = std::chrono::steady_clock::now();
+			while (reader.Next(event))
+			{
+				if (speed > 0.0)
+				{
+					auto offset = std::chrono::duration<double, std::nano>(event.timestampNs / speed);
+					std::this_thread::sleep_until(tpStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset));
+				}
+
+				switch (event.kind)
+				{
+				case capture_event_kind::connect:
+					OnClientConnect(GetReplayClient(event.connectionId));
+					stats.connects++;
+					break;
+				case capture_event_kind::disconnect:
+				{
+					auto it = mapReplayClients.find(event.connectionId);
+					if (it != mapReplayClients.end())
+					{
+						OnClientDisconnect(it->second);
+						mapReplayClients.erase(it);
+					}
+					stats.disconnects++;
+					break;
+				}
+				case capture_event_kind::message:
+					OnMessageReceived(GetReplayClient(event.connectionId), event.msg);
+					stats.messages++;
+					break;
+				}
+
+				stats.recordedDuration = std::chrono::nanoseconds(event.timestampNs);
+			}
+
+			// Captures stop mid-session; the handlers still get to clean up
+			for (auto& client : mapReplayClients)
+				OnClientDisconnect(client.second);
+
+			stats.replayDuration = std::chrono::steady_clock::now() - tpStart;
+			stats.complete = reader.ReachedEnd();
+			return stats;
+		}
+
 	protected:
 		virtual bool OnClientConnect(std::shared_ptr<connection<T>> client)
 		{
@@ -151,6 +300,13 @@ namespace Networking
 
 		}
 
+	private:
+		void RecordDisconnect(const std::shared_ptr<connection<T>>& client)
+		{
+			if (m_captureWriter.IsOpen())
+				m_captureWriter.RecordConnection(capture_event_kind::disconnect, client->GetID(), std::chrono::steady_clock::now());
+		}
+
 	protected:
 		tsqueue<owned_message<T>> m_qMessagesIn;
 
@@ -162,5 +318,7 @@ namespace Networking
 		asio::ip::tcp::acceptor m_asioAcceptor;
 
 		uint32_t nIDCounter = 10000;
+
+		capture_writer<T> m_captureWriter;
 	};
 }
\ No newline at end of file
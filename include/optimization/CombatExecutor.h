@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace TW3Optimization
+{
+    class CombatOptimizer;
+
+    // Event-driven executor configuration
+    struct CombatExecutorConfig
+    {
+        std::chrono::microseconds spinDuration{50};   // Busy-wait before parking the thread
+        std::chrono::milliseconds idleInterval{16};   // Drain period for Medium/Low actions, which do not wake the executor
+        int32_t cpuAffinity = -1;                     // Core to pin the executor thread to, -1 for none
+
+        CombatExecutorConfig() = default;
+    };
+
+    // Drains a CombatOptimizer on a dedicated thread. Critical and High actions
+    // wake it immediately through Notify(); after draining it spins briefly to
+    // catch follow-up actions cheaply, then parks on a condition variable.
+    class CombatExecutor
+    {
+    public:
+        explicit CombatExecutor(CombatOptimizer& optimizer);
+        ~CombatExecutor();
+
+        CombatExecutor(const CombatExecutor&) = delete;
+        CombatExecutor& operator=(const CombatExecutor&) = delete;
+
+        bool Start(const CombatExecutorConfig& config = CombatExecutorConfig());
+        void Stop();
+        void Pause();
+        void Resume();
+
+        // Producer side: called by CombatOptimizer::AddAction for urgent actions
+        void Notify();
+
+        bool IsRunning() const { return m_running; }
+        bool IsPaused() const { return m_paused; }
+
+        // Wait statistics
+        uint64_t GetSpinWakeups() const { return m_spinWakeups; }
+        uint64_t GetParkedWakeups() const { return m_parkedWakeups; }
+        uint64_t GetIdleWakeups() const { return m_idleWakeups; }
+
+    private:
+        void Run();
+        void WaitForWork();
+        bool ApplyAffinity();
+
+        CombatOptimizer& m_optimizer;
+        CombatExecutorConfig m_config;
+
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::atomic<bool> m_running;
+        std::atomic<bool> m_stopRequested;
+        std::atomic<bool> m_paused;
+
+        // Wakeup handshake: producers raise m_signal and only take the mutex
+        // when the executor has announced it is parked
+        std::atomic<bool> m_signal;
+        std::atomic<bool> m_parked;
+
+        std::atomic<uint64_t> m_spinWakeups;
+        std::atomic<uint64_t> m_parkedWakeups;
+        std::atomic<uint64_t> m_idleWakeups;
+    };
+}
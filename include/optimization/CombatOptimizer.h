@@ -1,15 +1,22 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <unordered_map>
 #include <chrono>
 #include <mutex>
 #include <atomic>
 #include "game/Entities/Player.h"
+#include "utils/BlockPool.h"
+#include "utils/HdrHistogram.h"
+#include "utils/Metrics.h"
 #include "utils/Logger.h"
+#include "utils/MpscRingBuffer.h"
 
 namespace TW3Optimization
 {
+    class CombatExecutor;
+
     // Combat action types
     enum class CombatActionType
     {
@@ -29,7 +36,10 @@ namespace TW3Optimization
         Low = 3          // Low priority
     };
 
-    // Combat action structure
+    constexpr size_t CombatPriorityCount = 4;
+
+    // Combat action structure. Move-only: the payload is a pooled block owned
+    // by the action and returned to the pool when the action is destroyed.
     struct CombatAction
     {
         uint32_t id;
@@ -37,11 +47,16 @@ namespace TW3Optimization
         CombatActionType type;
         CombatPriority priority;
         std::chrono::steady_clock::time_point timestamp;
-        std::vector<uint8_t> data;
+        PooledBuffer data;
         bool processed;
         
         CombatAction() : id(0), playerId(0), type(CombatActionType::Attack), 
                         priority(CombatPriority::Medium), processed(false) {}
+
+        CombatAction(CombatAction&&) noexcept = default;
+        CombatAction& operator=(CombatAction&&) noexcept = default;
+        CombatAction(const CombatAction&) = delete;
+        CombatAction& operator=(const CombatAction&) = delete;
     };
 
     // Combat statistics
@@ -50,10 +65,13 @@ namespace TW3Optimization
         std::atomic<uint64_t> totalActions;
         std::atomic<uint64_t> processedActions;
         std::atomic<uint64_t> droppedActions;
+        std::atomic<uint64_t> expiredActions;
+        std::atomic<uint64_t> budgetExhaustions;     // Passes that stopped on the time budget
         std::atomic<uint64_t> averageProcessingTime;
         std::atomic<uint64_t> peakProcessingTime;
         
         CombatStats() : totalActions(0), processedActions(0), droppedActions(0),
+                       expiredActions(0), budgetExhaustions(0),
                        averageProcessingTime(0), peakProcessingTime(0) {}
     };
 
@@ -63,17 +81,22 @@ namespace TW3Optimization
     private:
         static CombatOptimizer* s_instance;
         
-        // Action queues by priority
-        std::vector<CombatAction> m_criticalQueue;
-        std::vector<CombatAction> m_highQueue;
-        std::vector<CombatAction> m_mediumQueue;
-        std::vector<CombatAction> m_lowQueue;
+        // Lock-free MPSC action queues indexed by priority, and their size limits
+        std::array<MpscRingBuffer<CombatAction>, CombatPriorityCount> m_queues;
+        std::array<size_t, CombatPriorityCount> m_queueLimits;
+        
+        // Action payload blocks
+        BlockPool m_payloadPool;
         
-        // Processing state
+        // Executor woken for Critical/High actions, if any, and the number of
+        // producers between loading it and notifying it
+        std::atomic<CombatExecutor*> m_executor;
+        std::atomic<uint32_t> m_notifying;
+        
+        // Processing state. m_processing is held by the single queue consumer.
         std::atomic<bool> m_processing;
         std::atomic<bool> m_initialized;
-        std::mutex m_queueMutex;
-        std::mutex m_statsMutex;
+        mutable std::mutex m_statsMutex;
         
         // Statistics
         CombatStats m_stats;
@@ -81,21 +104,26 @@ namespace TW3Optimization
         // Performance settings
         uint32_t m_maxQueueSize;
         uint32_t m_batchSize;
-        uint32_t m_maxProcessingTime;
-        uint32_t m_actionIdCounter;
+        uint32_t m_maxProcessingTime;                  // milliseconds
+        std::chrono::microseconds m_processingBudget;  // m_maxProcessingTime at microsecond resolution
+        std::atomic<uint32_t> m_actionIdCounter;
         
         // Performance monitoring
         std::chrono::steady_clock::time_point m_lastProcessTime;
-        std::vector<uint64_t> m_processingTimes;
+        HdrHistogram m_processingTimes;                // per ProcessActions pass, microseconds
+        float m_averageActionCost;                     // microseconds, smoothed over drained batches
+        HdrHistogram m_executionLatency;               // enqueue to execution, microseconds
         
         CombatOptimizer();
         ~CombatOptimizer();
         
         // Internal processing methods
-        void ProcessActionQueue(std::vector<CombatAction>& queue, CombatPriority priority);
+        bool ProcessActionQueue(CombatPriority priority, std::chrono::steady_clock::time_point deadline);
         void ProcessAction(const CombatAction& action);
-        void UpdateStatistics(uint64_t processingTime);
-        void CleanupOldActions();
+        void UpdateStatistics(uint64_t processingTimeMicros);
+        bool IsExpired(const CombatAction& action, std::chrono::steady_clock::time_point now) const;
+        bool AcquireConsumer(bool wait);
+        void ReleaseConsumer();
         
         // Priority management
         CombatPriority DeterminePriority(CombatActionType type, uint32_t playerId);
@@ -111,7 +139,8 @@ namespace TW3Optimization
         bool Shutdown();
         
         // Action management
-        bool AddAction(const CombatAction& action);
+        bool AddAction(CombatAction&& action);
+        PooledBuffer AllocatePayload(size_t size);
         bool AddAttackAction(uint32_t playerId, uint32_t attackType, uint32_t weaponType, const Vector4F& targetPosition);
         bool AddDefenseAction(uint32_t playerId, uint32_t defenseType, uint32_t incomingAttackId);
         bool AddSignAction(uint32_t playerId, uint32_t signType, const Vector4F& targetPosition);
@@ -136,7 +165,13 @@ namespace TW3Optimization
         void ResetStatistics();
         void PrintStatistics() const;
         
+        // Executor wakeup. Returns once no producer can still reach the
+        // previous executor, so it may be destroyed right after.
+        void SetExecutor(CombatExecutor* executor);
+        
         // Performance monitoring
+        const HdrHistogram& GetExecutionLatency() const;
+        const HdrHistogram& GetProcessingTimes() const;
         bool IsOverloaded() const;
         float GetProcessingLoad() const;
         uint64_t GetAverageProcessingTime() const;
@@ -151,6 +186,11 @@ namespace TW3Optimization
         uint32_t GenerateActionId();
         bool IsInitialized() const;
         std::string GetStatusString() const;
+
+    private:
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Combat action builder for fluent API
@@ -158,6 +198,7 @@ namespace TW3Optimization
     {
     private:
         CombatAction m_action;
+        std::vector<uint8_t> m_data;
         
     public:
         CombatActionBuilder();
@@ -180,17 +221,14 @@ namespace TW3Optimization
         
         std::atomic<bool> m_monitoring;
         std::atomic<bool> m_initialized;
-        std::mutex m_dataMutex;
         
-        // Performance data
-        std::vector<uint64_t> m_frameTimes;
-        std::vector<uint64_t> m_actionCounts;
-        std::vector<uint64_t> m_queueSizes;
+        // Performance data: fixed-memory histograms, recorded lock-free from any thread
+        PerThreadHdrHistogram m_frameTimes;
+        PerThreadHdrHistogram m_actionCounts;
+        PerThreadHdrHistogram m_queueSizes;
         
         // Monitoring settings
-        uint32_t m_maxDataPoints;
         uint32_t m_monitoringInterval;
-        std::chrono::steady_clock::time_point m_lastMonitorTime;
         
         CombatPerformanceMonitor();
         ~CombatPerformanceMonitor();
@@ -199,20 +237,21 @@ namespace TW3Optimization
         static CombatPerformanceMonitor& GetInstance();
         static void DestroyInstance();
         
-        bool Initialize(uint32_t maxDataPoints = 1000, uint32_t monitoringInterval = 100);
+        bool Initialize(uint32_t monitoringInterval = 100);
         bool Shutdown();
         
         void StartMonitoring();
         void StopMonitoring();
         void UpdateFrame(uint64_t frameTime, uint64_t actionCount, uint64_t queueSize);
         
-        std::vector<uint64_t> GetFrameTimes() const;
-        std::vector<uint64_t> GetActionCounts() const;
-        std::vector<uint64_t> GetQueueSizes() const;
+        const PerThreadHdrHistogram& GetFrameTimes() const;
+        const PerThreadHdrHistogram& GetActionCounts() const;
+        const PerThreadHdrHistogram& GetQueueSizes() const;
         
         float GetAverageFrameTime() const;
         float GetAverageActionCount() const;
         float GetAverageQueueSize() const;
+        uint64_t GetFrameTimePercentile(double percentile) const;
         
         bool IsMonitoring() const;
         void ResetData();
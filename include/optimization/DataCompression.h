@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common.h"
+#include "utils/Metrics.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -132,6 +133,10 @@ namespace Optimization
         CompressionStats m_stats;
         
         static DataCompression* s_instance;
+
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Compression helper functions
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Common.h"
+#include <cstdint>
+
+namespace Optimization
+{
+    // Deterministic movement kernel shared by client prediction and server
+    // validation. All math is integer fixed-point so results are bit-identical
+    // across compilers, optimisation levels and platforms.
+    namespace DeterministicMovement
+    {
+        // Signed fixed-point number with 16 fractional bits stored in 64 bits.
+        // Products are formed in 64 bits, so |a * b| must stay below ~2^31.
+        struct Fixed
+        {
+            static constexpr int FractionBits = 16;
+            static constexpr int64_t One = int64_t(1) << FractionBits;
+
+            int64_t raw = 0;
+
+            static constexpr Fixed FromRaw(int64_t value) { Fixed f; f.raw = value; return f; }
+            static constexpr Fixed FromInt(int32_t value) { return FromRaw(static_cast<int64_t>(value) * One); }
+            static Fixed FromFloat(float value);
+            float ToFloat() const;
+
+            friend constexpr Fixed operator+(Fixed a, Fixed b) { return FromRaw(a.raw + b.raw); }
+            friend constexpr Fixed operator-(Fixed a, Fixed b) { return FromRaw(a.raw - b.raw); }
+            friend constexpr Fixed operator-(Fixed a) { return FromRaw(-a.raw); }
+            friend constexpr Fixed operator*(Fixed a, Fixed b) { return FromRaw((a.raw * b.raw) / One); }
+            friend constexpr Fixed operator/(Fixed a, Fixed b) { return FromRaw(b.raw != 0 ? (a.raw * One) / b.raw : 0); }
+            friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+            friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+            friend constexpr bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+        };
+
+        struct FixedVector
+        {
+            Fixed x, y, z;
+        };
+
+        // Simulation state and input in fixed-point
+        struct State
+        {
+            FixedVector position;
+            FixedVector velocity;
+        };
+
+        struct Input
+        {
+            FixedVector velocity;
+            FixedVector acceleration;
+        };
+
+        // Conversion to and from the float types used elsewhere
+        FixedVector Quantize(const Vector4F& vector);
+        Vector4F ToVector(const FixedVector& vector, float w = 0.0f);
+        Vector4F QuantizeVector(const Vector4F& vector); // Round-trip through fixed-point
+
+        // Movement calculations (fixed-point counterparts of MovementUtils)
+        FixedVector CalculateMovement(const FixedVector& position, const FixedVector& velocity,
+                                      const FixedVector& acceleration, Fixed deltaTime);
+        FixedVector CalculateVelocity(const FixedVector& velocity, const FixedVector& acceleration, Fixed deltaTime);
+        FixedVector CalculateFriction(const FixedVector& velocity, Fixed friction, Fixed deltaTime);
+        FixedVector CalculateGravity(const FixedVector& velocity, Fixed gravity, Fixed deltaTime);
+
+        // One simulation step for one input, mirroring MovementPrediction::PredictMovement
+        State Step(const State& state, const Input& input, Fixed deltaTime);
+
+        // Endian-independent FNV-1a hash of a state, for determinism checks
+        uint64_t HashState(const State& state, uint64_t seed = 14695981039346656037ull);
+    }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <chrono>
+
+namespace Optimization
+{
+    // Single NTP-style exchange result (all values in microseconds)
+    struct ClockSyncSample
+    {
+        int64_t offset = 0;      // Server clock minus client clock
+        int64_t roundTrip = 0;   // Round trip time excluding server processing
+    };
+
+    // Client/server clock synchronization over ClientPing/ServerPong.
+    // The client stamps t0 on send, the server stamps t1 on receive and t2 on
+    // reply, the client stamps t3 on receive. The offset of the sample with the
+    // lowest round trip in the window is used, as in the NTP clock filter.
+    class ClockSync
+    {
+    public:
+        static constexpr size_t WindowSize = 8;
+
+        ClockSync();
+
+        // Monotonic local time in microseconds, used for all timestamps
+        static int64_t NowMicros();
+
+        void AddSample(int64_t t0, int64_t t1, int64_t t2, int64_t t3);
+        void Reset();
+
+        bool IsSynchronized() const { return m_sampleCount >= 3; }
+        int64_t GetOffset() const { return m_offset; }
+        int64_t GetRoundTrip() const { return m_roundTrip; }
+        float GetRoundTripJitter() const { return m_roundTripJitter; }
+
+        // Clock conversion
+        int64_t ToServerTime(int64_t localMicros) const { return localMicros + m_offset; }
+        int64_t ToLocalTime(int64_t serverMicros) const { return serverMicros - m_offset; }
+
+    private:
+        std::array<ClockSyncSample, WindowSize> m_samples;
+        size_t m_sampleCount;
+        size_t m_nextSample;
+        int64_t m_offset;
+        int64_t m_roundTrip;
+        int64_t m_lastRoundTrip;
+        float m_roundTripJitter;
+    };
+
+    // Adaptive playout buffer configuration
+    struct JitterBufferConfig
+    {
+        float minDelay = 0.03f;                  // Lower bound of interpolation delay in seconds
+        float maxDelay = 0.3f;                   // Upper bound of interpolation delay in seconds
+        float targetExtrapolationRate = 0.01f;   // Fraction of playouts allowed to run past the newest snapshot
+        float gain = 1.0f / 16.0f;               // EWMA gain for interval and variance (RFC 3550)
+        float initialSafetyFactor = 2.0f;        // Standard deviations of headroom above the mean interval
+        float minSafetyFactor = 0.5f;
+        float maxSafetyFactor = 8.0f;
+        uint32_t adaptationWindow = 60;          // Playouts between safety factor adjustments
+    };
+
+    // Per-connection adaptive playout buffer. Sizes the interpolation delay from
+    // the measured inter-arrival variance and tunes the headroom so that the
+    // extrapolation rate stays under the configured target.
+    class JitterBuffer
+    {
+    public:
+        JitterBuffer();
+        explicit JitterBuffer(const JitterBufferConfig& config);
+
+        // Arrival of a snapshot. senderMicros is the sender clock (0 if unknown).
+        void OnArrival(int64_t arrivalMicros, int64_t senderMicros = 0);
+
+        // Outcome of a playout; extrapolated when no newer snapshot was available
+        void RecordPlayout(bool extrapolated);
+
+        void Reset();
+
+        // Current interpolation delay in seconds
+        float GetDelay() const { return m_delay; }
+        float GetJitter() const;
+        float GetMeanInterval() const { return m_meanInterval; }
+        float GetSafetyFactor() const { return m_safetyFactor; }
+        float GetExtrapolationRate() const { return m_extrapolationRate; }
+        uint32_t GetArrivalCount() const { return m_arrivals; }
+
+    private:
+        void UpdateDelay();
+
+        JitterBufferConfig m_config;
+
+        // Arrival tracking
+        uint32_t m_arrivals;
+        int64_t m_lastArrival;
+        int64_t m_lastSender;
+        float m_meanInterval;   // seconds
+        float m_variance;       // seconds^2
+
+        // Playout feedback
+        uint32_t m_windowPlayouts;
+        uint32_t m_windowExtrapolations;
+        float m_extrapolationRate;
+        float m_safetyFactor;
+
+        float m_delay;
+    };
+}
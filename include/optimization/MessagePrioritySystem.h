@@ -2,6 +2,8 @@
 
 #include "Common.h"
 #include "networking/MessageTypes.h"
+#include "utils/HdrHistogram.h"
+#include "utils/Metrics.h"
 #include <vector>
 #include <map>
 #include <queue>
@@ -175,8 +177,11 @@ namespace Optimization
             size_t messagesRetried = 0;
             size_t bytesSent = 0;
             size_t bytesDropped = 0;
-            float averageLatency = 0.0f;
+            float averageLatency = 0.0f;    // Queue time in ms
             float maxLatency = 0.0f;
+            float p50Latency = 0.0f;
+            float p99Latency = 0.0f;
+            float p999Latency = 0.0f;
             float bandwidthUtilization = 0.0f;
             float congestionLevel = 0.0f;
             
@@ -190,12 +195,16 @@ namespace Optimization
                 bytesDropped = 0;
                 averageLatency = 0.0f;
                 maxLatency = 0.0f;
+                p50Latency = 0.0f;
+                p99Latency = 0.0f;
+                p999Latency = 0.0f;
                 bandwidthUtilization = 0.0f;
                 congestionLevel = 0.0f;
             }
         };
         
         TrafficStats GetStats() const;
+        const HdrHistogram& GetQueueTime() const { return m_queueTime; }
         void ResetStats();
         void PrintStats() const;
 
@@ -215,6 +224,7 @@ namespace Optimization
         bool m_initialized;
         MessagePriorityQueue m_priorityQueue;
         TrafficStats m_stats;
+        HdrHistogram m_queueTime;     // Enqueue to send, microseconds
         
         // Traffic control
         size_t m_bandwidthLimit;
@@ -230,6 +240,10 @@ namespace Optimization
         // Counters
         size_t m_bytesSentThisSecond;
         size_t m_messagesSentThisSecond;
+
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Message priority utilities
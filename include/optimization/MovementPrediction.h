@@ -2,6 +2,7 @@
 
 #include "Common.h"
 #include "game/Entities/Player/Player.h"
+#include "utils/ThreadPool.h"
 #include <vector>
 #include <map>
 #include <queue>
@@ -46,9 +47,10 @@ namespace Optimization
         Vector4F velocity;
         Vector4F acceleration;
         float rotation;
+        float deltaTime;         // Step length used, needed to replay the input
         bool isValid;
         
-        PredictedState() : inputId(0), timestamp(0.0f), rotation(0.0f), isValid(false) {}
+        PredictedState() : inputId(0), timestamp(0.0f), rotation(0.0f), deltaTime(0.0f), isValid(false) {}
     };
 
     // Server reconciliation data
@@ -72,17 +74,74 @@ namespace Optimization
         float interpolationSpeed = 10.0f;       // Speed of position interpolation
         float maxInputHistory = 1.0f;          // Maximum time to keep input history
         uint32_t maxPredictedStates = 64;      // Maximum number of predicted states
+        uint32_t inputBufferSize = 128;        // Ring buffer capacity for inputs and predicted states
+        bool useDeterministicSimulation = false; // Fixed-point kernel, must match between client and server
         bool enableSmoothing = true;           // Enable position smoothing
         bool enableReconciliation = true;      // Enable server reconciliation
         float smoothingFactor = 0.1f;          // Position smoothing factor
     };
 
+    // Fixed-capacity ring indexed by sequence % capacity. A slot is valid only
+    // while it still holds the requested sequence; sequence 0 marks an empty slot.
+    template<typename T>
+    class SequenceRing
+    {
+    public:
+        void Reset(size_t capacity)
+        {
+            m_entries.assign(capacity, T());
+            m_sequences.assign(capacity, 0);
+        }
+
+        void Clear()
+        {
+            std::fill(m_sequences.begin(), m_sequences.end(), 0);
+        }
+
+        T* Insert(uint32_t sequence)
+        {
+            if (m_entries.empty())
+            {
+                return nullptr;
+            }
+            size_t index = sequence % m_entries.size();
+            m_sequences[index] = sequence;
+            return &m_entries[index];
+        }
+
+        T* Find(uint32_t sequence)
+        {
+            if (m_entries.empty() || sequence == 0)
+            {
+                return nullptr;
+            }
+            size_t index = sequence % m_entries.size();
+            return m_sequences[index] == sequence ? &m_entries[index] : nullptr;
+        }
+
+        const T* Find(uint32_t sequence) const
+        {
+            return const_cast<SequenceRing*>(this)->Find(sequence);
+        }
+
+        bool Contains(uint32_t sequence) const { return Find(sequence) != nullptr; }
+        size_t Capacity() const { return m_entries.size(); }
+
+    private:
+        std::vector<T> m_entries;
+        std::vector<uint32_t> m_sequences;
+    };
+
     // Movement prediction system
     class MovementPrediction
     {
     public:
         MovementPrediction();
         ~MovementPrediction();
+        
+        // Movable so the manager can keep predictions in contiguous storage
+        MovementPrediction(MovementPrediction&& other) noexcept;
+        MovementPrediction& operator=(MovementPrediction&& other) noexcept;
 
         // Initialize prediction system
         bool Initialize(const PredictionConfig& config = PredictionConfig());
@@ -105,6 +164,7 @@ namespace Optimization
         // State management
         void SetCurrentState(const Vector4F& position, const Vector4F& velocity, float rotation);
         Vector4F GetCurrentPosition() const;
+        Vector4F GetSmoothedPosition() const; // Current position plus the decaying correction error
         Vector4F GetCurrentVelocity() const;
         float GetCurrentRotation() const;
         
@@ -127,6 +187,12 @@ namespace Optimization
             float averagePredictionError = 0.0f;
             float maxPredictionError = 0.0f;
             float totalPredictionTime = 0.0f;
+            uint32_t replays = 0;                   // Rewind-and-replay corrections
+            uint32_t totalReplayedInputs = 0;
+            uint32_t maxReplayDepth = 0;
+            uint32_t overwrittenInputs = 0;         // Unacked inputs lost to ring wrap-around
+            float averageCorrectionMagnitude = 0.0f;
+            float maxCorrectionMagnitude = 0.0f;
             
             void Reset()
             {
@@ -137,6 +203,12 @@ namespace Optimization
                 averagePredictionError = 0.0f;
                 maxPredictionError = 0.0f;
                 totalPredictionTime = 0.0f;
+                replays = 0;
+                totalReplayedInputs = 0;
+                maxReplayDepth = 0;
+                overwrittenInputs = 0;
+                averageCorrectionMagnitude = 0.0f;
+                maxCorrectionMagnitude = 0.0f;
             }
         };
         
@@ -164,17 +236,18 @@ namespace Optimization
         
         // Input processing
         void ProcessMovementInput(const MovementInput& input, float deltaTime);
+        PredictedState SimulateInput(const MovementInput& input, float deltaTime);
         void UpdateCurrentState(float deltaTime);
         
         // Reconciliation
-        void PerformReconciliation(uint32_t inputId, const Vector4F& serverPosition);
-        void SmoothCorrection(const Vector4F& targetPosition, float deltaTime);
+        void PerformReconciliation(const ReconciliationData& reconciliationData);
+        uint32_t ReplayUnackedInputs(uint32_t fromInputId);
+        void SmoothCorrection(float deltaTime);
         
         // Utility methods
         float CalculatePositionError(const Vector4F& predicted, const Vector4F& actual) const;
         bool IsInputValid(const MovementInput& input) const;
-        void CleanupOldInputs();
-        void CleanupOldStates();
+        void ResetBuffers();
 
         // Member variables
         bool m_initialized;
@@ -187,18 +260,18 @@ namespace Optimization
         Vector4F m_currentAcceleration;
         float m_currentRotation;
         
-        // Input history
-        std::queue<MovementInput> m_inputHistory;
-        std::map<uint32_t, MovementInput> m_inputMap;
+        // Input history and predicted states, both indexed by inputId % capacity
+        SequenceRing<MovementInput> m_inputRing;
+        SequenceRing<PredictedState> m_stateRing;
         uint32_t m_nextInputId;
+        uint32_t m_newestInputId;
+        uint32_t m_lastProcessedInputId;
+        uint32_t m_lastAckedInputId;
         
-        // Predicted states
-        std::map<uint32_t, PredictedState> m_predictedStates;
-        std::queue<uint32_t> m_predictionQueue;
-        
-        // Reconciliation
-        std::map<uint32_t, ReconciliationData> m_reconciliationData;
-        std::queue<uint32_t> m_reconciliationQueue;
+        // Reconciliation (only the newest server state matters)
+        ReconciliationData m_pendingReconciliation;
+        bool m_hasPendingReconciliation;
+        Vector4F m_correctionError;
         
         // Callbacks
         PositionUpdateCallback m_positionUpdateCallback;
@@ -274,9 +347,25 @@ namespace Optimization
         // Cleanup
         void Cleanup();
         void ResetAllStats();
+        
+        // Parallel processing (0 threads processes serially on the caller)
+        void SetWorkerThreads(size_t threadCount);
+        void SetParallelThreshold(size_t playerCount);
+        size_t GetPlayerCount() const;
 
     private:
-        std::map<uint32_t, std::unique_ptr<MovementPrediction>> m_playerPredictions;
+        MovementPrediction* FindPlayer(uint32_t playerId);
+        const MovementPrediction* FindPlayer(uint32_t playerId) const;
+
+        // Dense player storage; m_playerIds[i] owns m_predictions[i]
+        std::vector<MovementPrediction> m_predictions;
+        std::vector<uint32_t> m_playerIds;
+        std::unordered_map<uint32_t, size_t> m_playerIndex;
         PredictionConfig m_globalConfig;
+        
+        // Players are independent, so per-tick validation fans out across workers
+        std::unique_ptr<ThreadPool> m_threadPool;
+        size_t m_parallelThreshold;
+        size_t m_playersPerTask;
     };
 }
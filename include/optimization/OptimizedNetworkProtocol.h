@@ -6,6 +6,7 @@
 #include "optimization/MovementPrediction.h"
 #include "optimization/MessagePrioritySystem.h"
 #include "optimization/SmartBatching.h"
+#include "utils/Metrics.h"
 #include <vector>
 #include <map>
 #include <queue>
@@ -229,6 +230,10 @@ namespace Optimization
         MessageReceivedCallback m_messageReceivedCallback;
         PacketSentCallback m_packetSentCallback;
         PacketLostCallback m_packetLostCallback;
+
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Network protocol utilities
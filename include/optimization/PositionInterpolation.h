@@ -2,6 +2,9 @@
 
 #include "Common.h"
 #include "game/Entities/Player/Player.h"
+#include "optimization/JitterBuffer.h"
+#include "utils/HdrHistogram.h"
+#include "utils/Metrics.h"
 #include <vector>
 #include <map>
 #include <queue>
@@ -33,6 +36,10 @@ namespace Optimization
         bool enableJitterReduction = true; // Enable jitter reduction
         float jitterThreshold = 0.01f;   // Jitter detection threshold
         bool enableAdaptiveInterpolation = true; // Adaptive interpolation based on network conditions
+        bool enableAdaptivePlayout = true; // Size interpolation delay from measured arrival jitter
+        float minInterpolationDelay = 0.03f; // Lower bound of adaptive delay in seconds
+        float maxInterpolationDelay = 0.3f;  // Upper bound of adaptive delay in seconds
+        float targetExtrapolationRate = 0.01f; // Maximum fraction of extrapolated playouts
     };
 
     // Position snapshot
@@ -44,10 +51,11 @@ namespace Optimization
         Vector4F acceleration;
         float rotation;
         std::chrono::high_resolution_clock::time_point timestamp;
+        int64_t serverTime;      // Sender clock in microseconds (0 if unknown)
         uint32_t sequenceNumber;
         bool isValid;
         
-        PositionSnapshot() : playerId(0), rotation(0.0f), sequenceNumber(0), isValid(false) {}
+        PositionSnapshot() : playerId(0), rotation(0.0f), serverTime(0), sequenceNumber(0), isValid(false) {}
     };
 
     // Interpolated position
@@ -78,6 +86,11 @@ namespace Optimization
         float maxJitter = 0.0f;
         float averageLag = 0.0f;
         float maxLag = 0.0f;
+        float averagePlayoutDelay = 0.0f;  // Adaptive interpolation delay in ms
+        float averageArrivalJitter = 0.0f; // Measured inter-arrival jitter in ms
+        float p99InterpolationTime = 0.0f; // ms
+        float p50PlayoutDelay = 0.0f;      // ms
+        float p99PlayoutDelay = 0.0f;      // ms
         
         void Reset()
         {
@@ -91,6 +104,11 @@ namespace Optimization
             maxJitter = 0.0f;
             averageLag = 0.0f;
             maxLag = 0.0f;
+            averagePlayoutDelay = 0.0f;
+            averageArrivalJitter = 0.0f;
+            p99InterpolationTime = 0.0f;
+            p50PlayoutDelay = 0.0f;
+            p99PlayoutDelay = 0.0f;
         }
     };
 
@@ -130,10 +148,18 @@ namespace Optimization
         
         // Network adaptation
         void UpdateNetworkConditions(float latency, float packetLoss, float jitter);
+        void UpdateNetworkConditions(const ClockSync& clockSync, float packetLoss);
         void AdaptToNetworkConditions();
         
+        // Adaptive playout
+        float GetInterpolationDelay(uint32_t playerId) const;
+        float GetMeasuredJitter(uint32_t playerId) const;
+        float GetExtrapolationRate(uint32_t playerId) const;
+        
         // Statistics
         InterpolationStats GetStats() const;
+        const HdrHistogram& GetInterpolationTimes() const { return m_interpolationTimes; }
+        const HdrHistogram& GetPlayoutDelays() const { return m_playoutDelays; }
         void ResetStats();
         void PrintStats() const;
         
@@ -145,17 +171,21 @@ namespace Optimization
         void SetJitterDetectedCallback(JitterDetectedCallback callback);
 
     private:
+        // Playout targets are time points: float seconds since the epoch
+        // only resolve about two minutes
+        using TimePoint = std::chrono::high_resolution_clock::time_point;
+
         // Internal interpolation methods
-        InterpolatedPosition InterpolateLinear(const std::vector<PositionSnapshot>& snapshots, float time);
-        InterpolatedPosition InterpolateCubic(const std::vector<PositionSnapshot>& snapshots, float time);
-        InterpolatedPosition InterpolateHermite(const std::vector<PositionSnapshot>& snapshots, float time);
-        InterpolatedPosition InterpolateCatmullRom(const std::vector<PositionSnapshot>& snapshots, float time);
-        InterpolatedPosition InterpolateBezier(const std::vector<PositionSnapshot>& snapshots, float time);
+        InterpolatedPosition InterpolateLinear(const std::vector<PositionSnapshot>& snapshots, TimePoint time);
+        InterpolatedPosition InterpolateCubic(const std::vector<PositionSnapshot>& snapshots, TimePoint time);
+        InterpolatedPosition InterpolateHermite(const std::vector<PositionSnapshot>& snapshots, TimePoint time);
+        InterpolatedPosition InterpolateCatmullRom(const std::vector<PositionSnapshot>& snapshots, TimePoint time);
+        InterpolatedPosition InterpolateBezier(const std::vector<PositionSnapshot>& snapshots, TimePoint time);
         
         // Utility methods
         std::vector<PositionSnapshot> GetSnapshotsForPlayer(uint32_t playerId) const;
-        PositionSnapshot FindSnapshotAtTime(const std::vector<PositionSnapshot>& snapshots, float time) const;
-        PositionSnapshot FindNearestSnapshot(const std::vector<PositionSnapshot>& snapshots, float time) const;
+        PositionSnapshot FindSnapshotAtTime(const std::vector<PositionSnapshot>& snapshots, TimePoint time) const;
+        PositionSnapshot FindNearestSnapshot(const std::vector<PositionSnapshot>& snapshots, TimePoint time) const;
         
         // Jitter detection and correction
         bool DetectJitter(const PositionSnapshot& current, const PositionSnapshot& previous) const;
@@ -165,7 +195,7 @@ namespace Optimization
         PositionSnapshot CompensateForLag(const PositionSnapshot& snapshot, float lagTime) const;
         
         // Extrapolation
-        PositionSnapshot ExtrapolateFromSnapshots(const std::vector<PositionSnapshot>& snapshots, float time) const;
+        PositionSnapshot ExtrapolateFromSnapshots(const std::vector<PositionSnapshot>& snapshots, TimePoint time) const;
         
         // Cleanup
         void CleanupOldSnapshots();
@@ -174,11 +204,14 @@ namespace Optimization
         // Member variables
         bool m_initialized;
         InterpolationConfig m_config;
-        InterpolationStats m_stats;
+        mutable InterpolationStats m_stats;   // Jitter and lag helpers are const but count
+        HdrHistogram m_interpolationTimes;   // microseconds
+        HdrHistogram m_playoutDelays;        // microseconds
         
         // Position data
         std::map<uint32_t, std::vector<PositionSnapshot>> m_playerSnapshots;
         std::map<uint32_t, InterpolatedPosition> m_currentPositions;
+        std::map<uint32_t, JitterBuffer> m_jitterBuffers;
         
         // Network conditions
         float m_currentLatency;
@@ -192,6 +225,10 @@ namespace Optimization
         // Callbacks
         PositionUpdatedCallback m_positionUpdatedCallback;
         JitterDetectedCallback m_jitterDetectedCallback;
+
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Interpolation utilities
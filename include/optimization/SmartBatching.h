@@ -3,6 +3,8 @@
 #include "Common.h"
 #include "networking/MessageTypes.h"
 #include "optimization/MessagePrioritySystem.h"
+#include "utils/HdrHistogram.h"
+#include "utils/Metrics.h"
 #include <vector>
 #include <map>
 #include <queue>
@@ -64,7 +66,8 @@ namespace Optimization
     {
         BatchStats() : totalBatches(0), totalMessages(0), compressedBatches(0), droppedBatches(0),
                       totalBytes(0), compressedBytes(0), averageBatchSize(0.0f), averageBatchTime(0.0f),
-                      compressionRatio(0.0f), averageLatency(0.0f) {}
+                      compressionRatio(0.0f), averageLatency(0.0f), p50Latency(0.0f), p99Latency(0.0f),
+                      p999Latency(0.0f) {}
         
         uint32_t totalBatches;
         uint32_t totalMessages;
@@ -75,7 +78,10 @@ namespace Optimization
         float averageBatchSize;
         float averageBatchTime;
         float compressionRatio;
-        float averageLatency;
+        float averageLatency;       // Message wait before batching in ms
+        float p50Latency;
+        float p99Latency;
+        float p999Latency;
         
         void Reset()
         {
@@ -89,6 +95,9 @@ namespace Optimization
             averageBatchTime = 0.0f;
             compressionRatio = 0.0f;
             averageLatency = 0.0f;
+            p50Latency = 0.0f;
+            p99Latency = 0.0f;
+            p999Latency = 0.0f;
         }
     };
 
@@ -129,6 +138,7 @@ namespace Optimization
 
         // Statistics
         BatchStats GetStats() const;
+        const HdrHistogram& GetBatchLatency() const { return m_batchLatency; }
         void ResetStats();
         void PrintStats() const;
 
@@ -171,6 +181,7 @@ namespace Optimization
         bool m_initialized;
         BatchConfig m_config;
         BatchStats m_stats;
+        HdrHistogram m_batchLatency;    // Per-message wait before batching, microseconds
         
         // Pending messages
         std::vector<PrioritizedMessage> m_pendingMessages;
@@ -193,6 +204,10 @@ namespace Optimization
         
         // Batch ID counter
         uint32_t m_nextBatchId;
+
+        // Metrics endpoint; declared last so it unregisters before other members go
+        void CollectMetrics(MetricsWriter& out) const;
+        MetricsRegistration m_metricsRegistration;
     };
 
     // Batch processor for different message types
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "networking/net_connection.h"
+#include "networking/MessageTypes.h"
+#include "utils/HdrHistogram.h"
+#include <asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Tools
+{
+    // Ramp schedule and per-bot behaviour for a load run
+    struct LoadGeneratorConfig
+    {
+        std::string host = "127.0.0.1";
+        uint16_t port = 60000;
+
+        // Ramp: start with initialBots, add botStep every stepDuration up to maxBots
+        uint32_t initialBots = 50;
+        uint32_t botStep = 50;
+        uint32_t maxBots = 1000;
+        std::chrono::milliseconds stepDuration{ 10000 };
+        std::chrono::milliseconds connectSpread{ 1000 };    // New bots of a step connect across this window
+        std::chrono::milliseconds joinTimeout{ 5000 };      // Bots not joined by then count as connect failures
+
+        // Behaviour intervals per bot (jittered so bots don't fire in lockstep)
+        std::chrono::milliseconds moveInterval{ 100 };
+        std::chrono::milliseconds pingInterval{ 1000 };
+        std::chrono::milliseconds hitInterval{ 2000 };
+        std::chrono::milliseconds chatInterval{ 30000 };
+        float walkSpeed = 5.0f;                              // Metres per second along the bot's path
+
+        // Stop ramping once a step's p99 RTT exceeds this (0 = run the full ramp)
+        double maxP99RttMs = 0.0;
+
+        // Each I/O thread runs its own io_context and the bots are dealt out
+        // across them, so a connection's handlers never run concurrently
+        size_t ioThreads = 1;
+        uint32_t seed = 1;
+    };
+
+    // What one ramp step measured
+    struct LoadStepReport
+    {
+        uint32_t step = 0;
+        uint32_t targetBots = 0;
+        uint32_t joinedBots = 0;
+        uint32_t connectFailures = 0;   // Total so far
+        uint32_t disconnects = 0;       // Joined bots that dropped during this step
+        double seconds = 0.0;
+
+        uint64_t messagesSent = 0;
+        uint64_t messagesReceived = 0;
+        uint64_t bytesSent = 0;
+        uint64_t bytesReceived = 0;
+
+        uint64_t rttSamples = 0;
+        double rttP50Ms = 0.0;
+        double rttP99Ms = 0.0;
+        double rttP999Ms = 0.0;
+        double rttMaxMs = 0.0;
+
+        double SentPerSecond() const { return seconds > 0.0 ? messagesSent / seconds : 0.0; }
+        double ReceivedPerSecond() const { return seconds > 0.0 ? messagesReceived / seconds : 0.0; }
+    };
+
+    // Counters shared by every bot; only the driver thread writes them
+    struct BotTrafficStats
+    {
+        uint64_t messagesSent = 0;
+        uint64_t messagesReceived = 0;
+        uint64_t bytesSent = 0;
+        uint64_t bytesReceived = 0;
+        uint32_t disconnects = 0;
+        uint32_t connectFailures = 0;
+
+        void Reset()
+        {
+            *this = BotTrafficStats();
+        }
+    };
+
+    // One headless player. Unlike client_interface it owns no io_context or
+    // thread: thousands of bots share the generator's contexts, and the
+    // driver thread ticks them to drain replies and run their script.
+    class BotClient
+    {
+    public:
+        using Message = Networking::message<Networking::MessageTypes>;
+
+        enum class State
+        {
+            Idle,
+            Connecting,
+            Joined,
+            Failed,         // Never joined
+            Disconnected    // Joined, then lost the connection
+        };
+
+        BotClient(uint32_t index, asio::io_context& context, const LoadGeneratorConfig& config);
+
+        BotClient(const BotClient&) = delete;
+        BotClient& operator=(const BotClient&) = delete;
+
+        void Connect(const asio::ip::tcp::resolver::results_type& endpoints, std::chrono::steady_clock::time_point now);
+        void Disconnect();
+
+        // Drains replies and runs whichever behaviours are due
+        void Tick(std::chrono::steady_clock::time_point now, BotTrafficStats& stats, HdrHistogram& rttMicros);
+
+        State GetState() const { return m_state; }
+        uint32_t GetIndex() const { return m_index; }
+
+        // Message builders, in the field order Witcher3MPServer pops them
+        static Message BuildPlayerData(uint8_t characterId, const Vector4F& position);
+        static Message BuildMove(uint8_t moveType, const Vector4F& position);
+        static Message BuildChat(const std::string& text);
+        static Message BuildHitNpc(uint32_t npcId);
+        static Message BuildPing(std::chrono::steady_clock::time_point sent);
+
+        // Send time of the ping a ServerPong answers; false if the pong is too short
+        static bool ReadPongSentTime(const Message& pong, std::chrono::steady_clock::time_point& sent);
+
+    private:
+        void HandleMessage(Networking::owned_message<Networking::MessageTypes>& incoming, HdrHistogram& rttMicros);
+        void Join(std::chrono::steady_clock::time_point now, BotTrafficStats& stats);
+        void RunBehaviours(std::chrono::steady_clock::time_point now, BotTrafficStats& stats);
+        void Send(const Message& msg, BotTrafficStats& stats);
+        void Advance(float distance);
+        std::chrono::steady_clock::time_point Jittered(std::chrono::steady_clock::time_point now, std::chrono::milliseconds interval);
+
+        uint32_t m_index;
+        asio::io_context& m_context;
+        const LoadGeneratorConfig& m_config;
+        Networking::tsqueue<Networking::owned_message<Networking::MessageTypes>> m_qMessagesIn;
+        std::unique_ptr<Networking::connection<Networking::MessageTypes>> m_connection;
+        State m_state = State::Idle;
+        std::mt19937 m_random;
+
+        std::chrono::steady_clock::time_point m_connectStarted;
+        std::chrono::steady_clock::time_point m_lastTick;
+        std::chrono::steady_clock::time_point m_nextMove;
+        std::chrono::steady_clock::time_point m_nextPing;
+        std::chrono::steady_clock::time_point m_nextHit;
+        std::chrono::steady_clock::time_point m_nextChat;
+
+        // Closed walking path around the spawn point
+        std::vector<Vector4F> m_path;
+        size_t m_nextWaypoint = 0;
+        Vector4F m_position;
+
+        std::vector<uint32_t> m_knownNpcs;
+    };
+
+    // Ramps bots up against a running server and reports each step
+    class LoadGenerator
+    {
+    public:
+        explicit LoadGenerator(const LoadGeneratorConfig& config);
+        ~LoadGenerator();
+
+        LoadGenerator(const LoadGenerator&) = delete;
+        LoadGenerator& operator=(const LoadGenerator&) = delete;
+
+        // Blocks until the ramp finishes, the RTT limit trips or Stop() is called
+        std::vector<LoadStepReport> Run(const std::function<void(const LoadStepReport&)>& onStep = nullptr);
+
+        // Safe to call from another thread or a signal handler
+        void Stop() { m_stopRequested.store(true, std::memory_order_relaxed); }
+
+    private:
+        LoadStepReport RunStep(uint32_t step, uint32_t targetBots, const asio::ip::tcp::resolver::results_type& endpoints);
+        void Shutdown();
+
+        using WorkGuard = asio::executor_work_guard<asio::io_context::executor_type>;
+
+        LoadGeneratorConfig m_config;
+        std::vector<std::unique_ptr<asio::io_context>> m_contexts;
+        std::vector<WorkGuard> m_workGuards;
+        std::vector<std::thread> m_ioThreads;
+        std::vector<std::unique_ptr<BotClient>> m_bots;
+
+        BotTrafficStats m_stats;
+        HdrHistogram m_rttMicros;
+        std::atomic<bool> m_stopRequested{ false };
+    };
+}
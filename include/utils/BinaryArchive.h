@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Compact streaming binary archive used for save data.
+//
+//   integers  LEB128 varints (signed values zigzag-encoded)
+//   floats    4 bytes, little-endian
+//   strings   varint length + bytes
+//   records   varint length + body
+//   sections  varint tag, varint version, varint length + body
+//
+// Every record and section carries its length, so a reader skips sections
+// with unknown tags and ignores fields appended to a record by a newer
+// version. Fields are only ever appended, never reordered or removed.
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(size_t reserveBytes = 0);
+
+    void WriteVarUInt(uint64_t value);
+    void WriteVarInt(int64_t value);
+    void WriteBool(bool value);
+    void WriteFloat(float value);
+    void WriteString(const std::string& value);
+    void WriteBytes(const void* data, size_t size);
+
+    template<typename E>
+    void WriteEnum(E value)
+    {
+        static_assert(std::is_enum_v<E>, "WriteEnum needs an enum type");
+        WriteVarInt(static_cast<int64_t>(value));
+    }
+
+    // Begin returns a marker that must be passed to the matching End; nested
+    // records/sections must be closed innermost first
+    size_t BeginSection(uint32_t tag, uint32_t version);
+    void EndSection(size_t marker);
+    size_t BeginRecord();
+    void EndRecord(size_t marker);
+
+    const std::vector<uint8_t>& GetBuffer() const { return m_buffer; }
+    std::vector<uint8_t> TakeBuffer() { return std::move(m_buffer); }
+    size_t GetSize() const { return m_buffer.size(); }
+
+private:
+    std::vector<uint8_t> m_buffer;
+};
+
+// Reads what BinaryWriter wrote. Errors (truncation, overlong varints) are
+// sticky: reads after a failure return zero values and IsValid() turns false,
+// so callers can read a whole record and check once at the end. Sub-readers
+// from ReadRecord/NextSection have their own flag.
+class BinaryReader
+{
+public:
+    BinaryReader() = default;
+    BinaryReader(const uint8_t* data, size_t size);
+    explicit BinaryReader(const std::vector<uint8_t>& data);
+
+    uint64_t ReadVarUInt();
+    int64_t ReadVarInt();
+    uint32_t ReadVarUInt32();
+    bool ReadBool();
+    float ReadFloat();
+    std::string ReadString();
+
+    // Raw bytes, valid while the input is; nullptr if fewer remain
+    const uint8_t* ReadBytes(size_t size);
+
+    template<typename E>
+    E ReadEnum()
+    {
+        static_assert(std::is_enum_v<E>, "ReadEnum needs an enum type");
+        return static_cast<E>(ReadVarInt());
+    }
+
+    // Element count for a collection whose elements take at least one byte
+    // each; fails instead of returning a count the input cannot hold
+    uint32_t ReadCount();
+
+    BinaryReader ReadRecord();
+
+    // Advances to the next section; false at the end of input or on error
+    bool NextSection(uint32_t& tag, uint32_t& version, BinaryReader& body);
+
+    bool IsValid() const { return !m_failed; }
+    bool AtEnd() const { return m_position >= m_size; }
+    size_t GetRemaining() const { return m_size - m_position; }
+
+    // Marks the reader invalid, e.g. when a decoded value is out of range
+    void Fail() { m_failed = true; }
+
+private:
+    bool Take(size_t size, const uint8_t*& out);
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_position = 0;
+    bool m_failed = false;
+};
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Defined in utils/Logger.h
+enum class LogLevel : int;
+enum class LogCategory : int;
+
+// Argument encodings stored per call site, so records carry only raw values
+enum class BinaryLogArgType : uint8_t
+{
+    Int64 = 0,
+    UInt64 = 1,
+    Double = 2,
+    Bool = 3,
+    Char = 4,
+    String = 5     // uint16 length + bytes
+};
+
+// Single-producer/single-consumer byte ring owned by one logging thread and
+// drained by the BinaryLog writer thread
+struct BinaryLogBuffer
+{
+    BinaryLogBuffer(size_t capacity, uint32_t threadIndex, uint32_t generation);
+
+    std::unique_ptr<uint8_t[]> data;
+    size_t capacity;
+    size_t mask;
+    uint32_t threadIndex;
+    uint32_t generation;   // BinaryLog::Start call the buffer was created for
+
+    alignas(64) std::atomic<uint64_t> writePos;
+    alignas(64) std::atomic<uint64_t> readPos;
+    std::atomic<uint64_t> dropped;
+    std::atomic<bool> retired;
+};
+
+// Decoded record, produced by BinaryLogReader
+struct BinaryLogRecord
+{
+    int64_t wallTimeNs = 0;        // Nanoseconds since the system_clock epoch
+    uint32_t threadIndex = 0;
+    LogLevel level{};
+    LogCategory category{};
+    std::string source;
+    std::string message;
+};
+
+// nanolog-style binary log. Format strings are registered once per call site;
+// each log call then appends only a site id, a steady_clock timestamp and the
+// raw argument bytes to a per-thread lock-free ring. A writer thread drains
+// the rings into a compact binary file that BinaryLogReader (and the
+// Witcher3-MP-LogDecoder tool) render back to text offline.
+class BinaryLog
+{
+public:
+    static constexpr uint32_t FileVersion = 1;
+    static constexpr size_t MaxStringLength = 1024;   // Longer string arguments are truncated
+
+    static BinaryLog& GetInstance();
+
+    bool Start(const std::string& filename, size_t threadBufferSize = 64 * 1024,
+               std::chrono::milliseconds flushInterval = std::chrono::milliseconds(50));
+    void Stop();
+
+    // Drains every thread buffer to the file now
+    void Flush();
+
+    static bool IsActive() { return s_active.load(std::memory_order_relaxed); }
+
+    // Hot path. siteId caches the registration of the calling site (0 until registered).
+    template <size_t N, typename... Args>
+    void Write(std::atomic<uint32_t>& siteId, LogLevel level, LogCategory category, const char* source,
+               const char (&format)[N], const Args&... args)
+    {
+        uint32_t id = siteId.load(std::memory_order_acquire);
+        if (id == 0)
+        {
+            static constexpr BinaryLogArgType types[] = { ArgTypeOf<Args>()..., BinaryLogArgType::Int64 };
+            id = RegisterSite(level, category, format, source, types, sizeof...(Args));
+            siteId.store(id, std::memory_order_release);
+        }
+
+        BinaryLogBuffer* buffer = GetThreadBuffer();
+        uint64_t timestamp = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        size_t size = sizeof(id) + sizeof(timestamp) + (EncodedSize(args) + ... + 0);
+
+        uint64_t write = buffer->writePos.load(std::memory_order_relaxed);
+        uint64_t read = buffer->readPos.load(std::memory_order_acquire);
+        if (buffer->capacity - static_cast<size_t>(write - read) < size)
+        {
+            // Never block the caller: count the loss and let the file record it
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        uint64_t pos = write;
+        Put(buffer, pos, &id, sizeof(id));
+        Put(buffer, pos, &timestamp, sizeof(timestamp));
+        (Encode(buffer, pos, args), ...);
+        buffer->writePos.store(pos, std::memory_order_release);
+    }
+
+    // Totals for the current file, updated as buffers are drained
+    uint64_t GetDroppedRecords() const { return m_droppedRecords.load(std::memory_order_relaxed); }
+    uint64_t GetBytesWritten() const { return m_bytesWritten.load(std::memory_order_relaxed); }
+    size_t GetSiteCount() const;
+
+private:
+    BinaryLog() = default;
+    ~BinaryLog();
+    BinaryLog(const BinaryLog&) = delete;
+    BinaryLog& operator=(const BinaryLog&) = delete;
+
+    struct Site
+    {
+        LogLevel level;
+        LogCategory category;
+        std::string format;
+        std::string source;
+        std::vector<BinaryLogArgType> types;
+    };
+
+    template <typename T>
+    static constexpr BinaryLogArgType ArgTypeOf()
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>)
+            return BinaryLogArgType::Bool;
+        else if constexpr (std::is_same_v<U, char>)
+            return BinaryLogArgType::Char;
+        else if constexpr (std::is_floating_point_v<U>)
+            return BinaryLogArgType::Double;
+        else if constexpr (std::is_enum_v<U>)
+            return std::is_signed_v<std::underlying_type_t<U>> ? BinaryLogArgType::Int64 : BinaryLogArgType::UInt64;
+        else if constexpr (std::is_integral_v<U>)
+            return std::is_signed_v<U> ? BinaryLogArgType::Int64 : BinaryLogArgType::UInt64;
+        else
+            return BinaryLogArgType::String;
+    }
+
+    // Strings are copied as-is; other non-arithmetic types go through operator<< (slow path)
+    template <typename T>
+    static std::string_view AsString(const T& value, std::string& scratch)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>)
+        {
+            const char* text = value;
+            return text ? std::string_view(text) : std::string_view("(null)");
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+        {
+            return std::string_view(value);
+        }
+        else
+        {
+            std::ostringstream stream;
+            stream << value;
+            scratch = stream.str();
+            return scratch;
+        }
+    }
+
+    template <typename T>
+    static size_t EncodedSize(const T& value)
+    {
+        constexpr BinaryLogArgType type = ArgTypeOf<T>();
+        if constexpr (type == BinaryLogArgType::Bool || type == BinaryLogArgType::Char)
+        {
+            return 1;
+        }
+        else if constexpr (type == BinaryLogArgType::String)
+        {
+            std::string scratch;
+            return sizeof(uint16_t) + std::min(AsString(value, scratch).size(), MaxStringLength);
+        }
+        else
+        {
+            return 8;
+        }
+    }
+
+    template <typename T>
+    static void Encode(BinaryLogBuffer* buffer, uint64_t& pos, const T& value)
+    {
+        constexpr BinaryLogArgType type = ArgTypeOf<T>();
+        if constexpr (type == BinaryLogArgType::Bool || type == BinaryLogArgType::Char)
+        {
+            uint8_t byte = static_cast<uint8_t>(value);
+            Put(buffer, pos, &byte, 1);
+        }
+        else if constexpr (type == BinaryLogArgType::Double)
+        {
+            double number = static_cast<double>(value);
+            Put(buffer, pos, &number, sizeof(number));
+        }
+        else if constexpr (type == BinaryLogArgType::Int64)
+        {
+            int64_t number = static_cast<int64_t>(value);
+            Put(buffer, pos, &number, sizeof(number));
+        }
+        else if constexpr (type == BinaryLogArgType::UInt64)
+        {
+            uint64_t number = static_cast<uint64_t>(value);
+            Put(buffer, pos, &number, sizeof(number));
+        }
+        else
+        {
+            std::string scratch;
+            std::string_view text = AsString(value, scratch);
+            uint16_t length = static_cast<uint16_t>(std::min(text.size(), MaxStringLength));
+            Put(buffer, pos, &length, sizeof(length));
+            Put(buffer, pos, text.data(), length);
+        }
+    }
+
+    static void Put(BinaryLogBuffer* buffer, uint64_t& pos, const void* bytes, size_t size)
+    {
+        size_t offset = static_cast<size_t>(pos) & buffer->mask;
+        size_t first = std::min(size, buffer->capacity - offset);
+        std::memcpy(buffer->data.get() + offset, bytes, first);
+        std::memcpy(buffer->data.get(), static_cast<const uint8_t*>(bytes) + first, size - first);
+        pos += size;
+    }
+
+    uint32_t RegisterSite(LogLevel level, LogCategory category, const char* format, const char* source,
+                          const BinaryLogArgType* types, size_t argCount);
+    BinaryLogBuffer* GetThreadBuffer();
+    void WriterThread();
+    void DrainBuffers();
+
+    static std::atomic<bool> s_active;
+
+    // Call sites, indexed by id - 1
+    mutable std::mutex m_siteMutex;
+    std::vector<Site> m_sites;
+    size_t m_sitesWritten = 0;
+
+    // Registered thread buffers
+    mutable std::mutex m_bufferMutex;
+    std::vector<std::shared_ptr<BinaryLogBuffer>> m_buffers;
+    uint32_t m_nextThreadIndex = 0;
+    size_t m_threadBufferSize = 64 * 1024;
+    std::atomic<uint32_t> m_generation{0};
+
+    // Writer thread and output file (m_fileMutex guards the file and drain state)
+    std::mutex m_fileMutex;
+    std::ofstream m_file;
+    std::vector<uint8_t> m_scratch;
+    std::thread m_writerThread;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::chrono::milliseconds m_flushInterval{50};
+    bool m_stopRequested = false;
+    std::atomic<uint64_t> m_bytesWritten{0};
+    std::atomic<uint64_t> m_droppedRecords{0};
+};
+
+// Offline decoder for files written by BinaryLog
+class BinaryLogReader
+{
+public:
+    // Reads every record, ordered by timestamp, and the number of records the
+    // writer dropped on full buffers. Returns false on a malformed file;
+    // records decoded before the error are kept.
+    static bool Read(std::istream& input, std::vector<BinaryLogRecord>& records,
+                     uint64_t& droppedRecords, std::string& error);
+
+    // Same layout as Logger's text output
+    static std::string FormatRecord(const BinaryLogRecord& record);
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class BlockPool;
+
+// Move-only byte buffer backed by a BlockPool block, or by the heap when the
+// request does not fit a block or the pool is exhausted. Returns its block to
+// the pool on destruction.
+class PooledBuffer
+{
+public:
+    PooledBuffer() = default;
+    ~PooledBuffer();
+
+    PooledBuffer(PooledBuffer&& other) noexcept;
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    uint8_t* data() { return m_data; }
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool IsPooled() const { return m_block != InvalidBlock; }
+
+    void Release();
+
+private:
+    friend class BlockPool;
+    static constexpr uint32_t InvalidBlock = 0xFFFFFFFFu;
+
+    BlockPool* m_pool = nullptr;
+    uint8_t* m_data = nullptr;
+    uint32_t m_size = 0;
+    uint32_t m_block = InvalidBlock;
+};
+
+// Fixed-size block allocator with a lock-free free list (tagged Treiber stack),
+// safe to allocate from and release to on any thread.
+class BlockPool
+{
+public:
+    BlockPool(size_t blockSize = 64, size_t blockCount = 0);
+    ~BlockPool() = default;
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    // Reallocates storage. Not thread-safe and every buffer must be released first.
+    void Reset(size_t blockSize, size_t blockCount);
+
+    // Zero-filled buffer of size bytes; empty buffer when size is 0
+    PooledBuffer Allocate(size_t size);
+
+    size_t GetBlockSize() const { return m_blockSize; }
+    size_t GetBlockCount() const { return m_blockCount; }
+    size_t GetFreeBlocks() const { return m_freeBlocks.load(std::memory_order_relaxed); }
+    uint64_t GetHeapFallbacks() const { return m_heapFallbacks.load(std::memory_order_relaxed); }
+
+private:
+    friend class PooledBuffer;
+    static constexpr uint32_t EmptyList = 0xFFFFFFFFu;
+
+    uint32_t PopBlock();
+    void PushBlock(uint32_t block);
+
+    std::unique_ptr<uint8_t[]> m_storage;
+    std::unique_ptr<std::atomic<uint32_t>[]> m_next;
+    size_t m_blockSize;
+    size_t m_blockCount;
+
+    // Low 32 bits: head block index, high 32 bits: ABA tag
+    std::atomic<uint64_t> m_head;
+    std::atomic<size_t> m_freeBlocks;
+    std::atomic<uint64_t> m_heapFallbacks;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// 128-bit content hash that names a chunk
+struct ChunkHash
+{
+    uint64_t high = 0;
+    uint64_t low = 0;
+
+    bool operator==(const ChunkHash& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const ChunkHash& other) const { return !(*this == other); }
+
+    std::string ToHex() const;
+    static bool FromHex(const std::string& hex, ChunkHash& out);
+};
+
+struct ChunkHashHasher
+{
+    size_t operator()(const ChunkHash& hash) const { return static_cast<size_t>(hash.low ^ hash.high); }
+};
+
+using ChunkHashSet = std::unordered_set<ChunkHash, ChunkHashHasher>;
+
+struct ChunkRef
+{
+    ChunkHash hash;
+    uint32_t size = 0;
+};
+
+class ThreadPool;
+
+struct ChunkStoreStats
+{
+    uint64_t chunksWritten = 0;
+    uint64_t bytesWritten = 0;
+    uint64_t bytesStored = 0;      // On disk for the chunks written, after compression
+    uint64_t chunksReused = 0;     // Already on disk, not written again
+    uint64_t bytesReused = 0;
+    uint64_t chunksCollected = 0;
+};
+
+// Content-addressed chunk storage. Data is cut at content-defined boundaries
+// (gear rolling hash), so an edit only changes the chunks around it and the
+// rest hash to chunks that are already stored. Identical chunks from
+// different saves and backups are stored once; RemoveUnreferenced deletes
+// the ones no manifest points at any more.
+//
+// Chunks are hashed, compressed and verified independently, so with a thread
+// pool a large payload is processed on all cores. A compressed chunk is an
+// LZ4 block smaller than the chunk; a file as large as the chunk is raw. The
+// manifest's list of chunk sizes works as the seek table.
+class ChunkStore
+{
+public:
+    static constexpr size_t MinChunkSize = 2 * 1024;
+    static constexpr size_t MaxChunkSize = 64 * 1024;
+    static constexpr uint32_t BoundaryBits = 13;   // ~8 KiB past the minimum
+
+    // Creates the directory if needed and indexes the chunks already in it
+    bool Open(const std::string& directory);
+
+    // Workers for Store, Load and Recode; nullptr runs them on the caller
+    void SetThreadPool(ThreadPool* pool) { m_pool = pool; }
+
+    // Splits data into chunks and durably writes the ones not stored yet,
+    // LZ4-compressed where that makes them smaller if compress is set. Calls
+    // must not overlap each other or RemoveUnreferenced.
+    bool Store(const std::vector<uint8_t>& data, std::vector<ChunkRef>& refs, bool compress = false);
+
+    // Reassembles data, verifying every chunk against its hash
+    bool Load(const std::vector<ChunkRef>& refs, std::vector<uint8_t>& data) const;
+
+    // Rewrites the given chunks compressed or raw; their hashes do not change
+    bool Recode(const std::vector<ChunkRef>& refs, bool compress);
+
+    // Deletes every stored chunk not in live; returns how many were removed.
+    // The caller must make sure no Store whose manifest is not written yet
+    // runs concurrently.
+    size_t RemoveUnreferenced(const ChunkHashSet& live);
+
+    size_t GetChunkCount() const;
+    ChunkStoreStats GetStats() const;
+
+    // End offsets of the chunks data splits into
+    static std::vector<size_t> FindBoundaries(const uint8_t* data, size_t size);
+    static ChunkHash Hash(const uint8_t* data, size_t size);
+
+private:
+    std::string GetChunkPath(const ChunkHash& hash) const;
+    bool WriteChunk(const ChunkHash& hash, const uint8_t* data, size_t size, bool compress, size_t& stored);
+    bool ReadChunk(const ChunkRef& ref, uint8_t* out) const;
+    void ForEach(size_t count, const std::function<void(size_t)>& body) const;
+
+    std::string m_directory;
+    ThreadPool* m_pool = nullptr;
+    mutable std::mutex m_mutex;
+    ChunkHashSet m_known;
+
+    std::atomic<uint64_t> m_chunksWritten{ 0 };
+    std::atomic<uint64_t> m_bytesWritten{ 0 };
+    std::atomic<uint64_t> m_bytesStored{ 0 };
+    std::atomic<uint64_t> m_chunksReused{ 0 };
+    std::atomic<uint64_t> m_bytesReused{ 0 };
+    std::atomic<uint64_t> m_chunksCollected{ 0 };
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Value with O(1) point-in-time snapshots. Snapshot() shares the current
+// version; the next Write() clones it first if a snapshot is still alive, so
+// a reader on another thread (the save worker, for example) never sees later
+// changes. Snapshot() and Write() belong to the owning thread; snapshots
+// themselves are immutable and may be read and released on any thread.
+template<typename T>
+class CopyOnWrite
+{
+public:
+    CopyOnWrite() : m_version(std::make_shared<Version>(T())) {}
+    explicit CopyOnWrite(T value) : m_version(std::make_shared<Version>(std::move(value))) {}
+
+    const T& Read() const { return m_version->value; }
+    const T* operator->() const { return &m_version->value; }
+
+    // A released snapshot drops its reader count with release ordering and
+    // this load acquires it, so an in-place write happens after the last read
+    T& Write()
+    {
+        if (m_version->readers.load(std::memory_order_acquire) != 0)
+        {
+            auto start = std::chrono::steady_clock::now();
+            m_version = std::make_shared<Version>(m_version->value);
+            m_cloneTime += std::chrono::steady_clock::now() - start;
+            m_cloneCount++;
+        }
+        return m_version->value;
+    }
+
+    std::shared_ptr<const T> Snapshot() const
+    {
+        std::shared_ptr<Version> version = m_version;
+        version->readers.fetch_add(1, std::memory_order_relaxed);
+        return std::shared_ptr<const T>(&version->value, [version](const T*)
+        {
+            version->readers.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // Number of clones made because a snapshot was still alive
+    uint64_t GetCloneCount() const { return m_cloneCount; }
+
+    // Time spent in those clones since the last call, so the owner can
+    // charge it to whatever kept the snapshot alive
+    std::chrono::steady_clock::duration TakeCloneTime()
+    {
+        return std::exchange(m_cloneTime, std::chrono::steady_clock::duration::zero());
+    }
+
+private:
+    struct Version
+    {
+        explicit Version(T initial) : value(std::move(initial)) {}
+
+        T value;
+        std::atomic<uint32_t> readers{ 0 };   // Live snapshots of this version
+    };
+
+    std::shared_ptr<Version> m_version;
+    uint64_t m_cloneCount = 0;
+    std::chrono::steady_clock::duration m_cloneTime{ 0 };
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Writes to a temporary file next to path, flushes it to disk and renames it
+// over path, so a crash never leaves a truncated file behind. Safe to call
+// from several threads, including for the same path.
+bool WriteFileDurably(const std::string& path, const void* data, size_t size);
+
+inline bool WriteFileDurably(const std::string& path, const std::vector<uint8_t>& data)
+{
+    return WriteFileDurably(path, data.data(), data.size());
+}
+
+// Whole file into data; false if it cannot be opened or read
+bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& data);
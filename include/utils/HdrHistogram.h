@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-memory log-linear histogram (HdrHistogram-style bucketing).
+// Values below 2 * SubBucketCount are exact; above that every power of two is
+// split into SubBucketCount linear buckets, bounding the relative error to
+// 1 / SubBucketCount (~3%). Recording is a few relaxed atomic increments, so
+// any number of threads may record concurrently without locking.
+class HdrHistogram
+{
+public:
+    static constexpr uint32_t SubBucketBits = 5;
+    static constexpr uint32_t SubBucketCount = 1u << SubBucketBits;
+    static constexpr uint32_t HighestBit = 47;   // Larger values are clamped
+    static constexpr size_t BucketCount = (HighestBit - SubBucketBits + 2) * SubBucketCount;
+
+    HdrHistogram();
+
+    HdrHistogram(const HdrHistogram&) = delete;
+    HdrHistogram& operator=(const HdrHistogram&) = delete;
+
+    void Record(uint64_t value);
+    void Reset();
+
+    // Adds every sample of other into this histogram
+    void Merge(const HdrHistogram& other);
+
+    uint64_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t GetMin() const;
+    uint64_t GetMax() const { return m_max.load(std::memory_order_relaxed); }
+    double GetMean() const;
+
+    // Highest value equivalent to the given percentile (0-100); 0 when empty
+    uint64_t GetPercentile(double percentile) const;
+
+    // Bucket mapping, exposed for tests
+    static size_t BucketIndex(uint64_t value);
+    static uint64_t BucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, BucketCount> m_buckets;
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_min;
+    std::atomic<uint64_t> m_max;
+};
+
+// HdrHistogram sharded per recording thread. Each thread records into its own
+// lazily allocated shard, so hot recorders on different threads never touch
+// the same cache lines; readers merge the shards on demand.
+class PerThreadHdrHistogram
+{
+public:
+    static constexpr size_t ShardCount = 8;
+
+    PerThreadHdrHistogram();
+    ~PerThreadHdrHistogram();
+
+    PerThreadHdrHistogram(const PerThreadHdrHistogram&) = delete;
+    PerThreadHdrHistogram& operator=(const PerThreadHdrHistogram&) = delete;
+
+    void Record(uint64_t value);
+    void Reset();
+
+    // Merges every shard into out
+    void MergeInto(HdrHistogram& out) const;
+
+    // Convenience readers; each merges the shards
+    uint64_t GetCount() const;
+    uint64_t GetMax() const;
+    double GetMean() const;
+    uint64_t GetPercentile(double percentile) const;
+
+private:
+    HdrHistogram& GetShard();
+
+    std::array<std::atomic<HdrHistogram*>, ShardCount> m_shards;
+};
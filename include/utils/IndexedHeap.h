@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Binary max-heap of key/value pairs with a position index, so a key's value
+// can be changed or removed in O(log n) without a search. The largest value
+// is on top; equal values put the smaller key first. Top(k) walks the heap
+// with a small frontier queue in O(k log k) instead of sorting everything.
+// Compare orders the values; std::greater makes it a min-heap.
+// Not thread-safe.
+template <typename Key, typename Value, typename Compare = std::less<Value>>
+class IndexedHeap
+{
+public:
+    size_t Size() const { return m_entries.size(); }
+    bool Empty() const { return m_entries.empty(); }
+
+    bool Contains(const Key& key) const
+    {
+        return m_positions.count(key) > 0;
+    }
+
+    // Nullptr if the key is not in the heap
+    const Value* Find(const Key& key) const
+    {
+        auto it = m_positions.find(key);
+        return it != m_positions.end() ? &m_entries[it->second].value : nullptr;
+    }
+
+    // Inserts the key or moves it to its new place
+    void Set(const Key& key, const Value& value)
+    {
+        auto it = m_positions.find(key);
+        if (it == m_positions.end())
+        {
+            m_entries.push_back({ key, value });
+            m_positions[key] = m_entries.size() - 1;
+            SiftUp(m_entries.size() - 1);
+            return;
+        }
+
+        size_t position = it->second;
+        m_entries[position].value = value;
+        SiftDown(SiftUp(position));
+    }
+
+    bool Remove(const Key& key)
+    {
+        auto it = m_positions.find(key);
+        if (it == m_positions.end())
+        {
+            return false;
+        }
+
+        size_t position = it->second;
+        m_positions.erase(it);
+        size_t last = m_entries.size() - 1;
+        if (position != last)
+        {
+            m_entries[position] = std::move(m_entries[last]);
+            m_positions[m_entries[position].key] = position;
+        }
+        m_entries.pop_back();
+
+        if (position < m_entries.size())
+        {
+            SiftDown(SiftUp(position));
+        }
+        return true;
+    }
+
+    void Clear()
+    {
+        m_entries.clear();
+        m_positions.clear();
+    }
+
+    // Only valid when not empty
+    const Key& TopKey() const { return m_entries.front().key; }
+    const Value& TopValue() const { return m_entries.front().value; }
+
+    // The count largest entries, largest first
+    std::vector<std::pair<Key, Value>> Top(size_t count) const
+    {
+        std::vector<std::pair<Key, Value>> top;
+        if (m_entries.empty() || count == 0)
+        {
+            return top;
+        }
+        top.reserve(std::min(count, m_entries.size()));
+
+        // Frontier of heap positions; a child can only follow its parent
+        auto later = [this](size_t a, size_t b) { return Before(b, a); };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(later)> frontier(later);
+        frontier.push(0);
+        while (!frontier.empty() && top.size() < count)
+        {
+            size_t position = frontier.top();
+            frontier.pop();
+            top.emplace_back(m_entries[position].key, m_entries[position].value);
+
+            for (size_t child = position * 2 + 1; child <= position * 2 + 2 && child < m_entries.size(); ++child)
+            {
+                frontier.push(child);
+            }
+        }
+        return top;
+    }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+    };
+
+    bool Before(size_t a, size_t b) const
+    {
+        const Entry& left = m_entries[a];
+        const Entry& right = m_entries[b];
+        return m_compare(right.value, left.value) ||
+               (!m_compare(left.value, right.value) && left.key < right.key);
+    }
+
+    void Swap(size_t a, size_t b)
+    {
+        std::swap(m_entries[a], m_entries[b]);
+        m_positions[m_entries[a].key] = a;
+        m_positions[m_entries[b].key] = b;
+    }
+
+    size_t SiftUp(size_t position)
+    {
+        while (position > 0)
+        {
+            size_t parent = (position - 1) / 2;
+            if (!Before(position, parent))
+            {
+                break;
+            }
+            Swap(position, parent);
+            position = parent;
+        }
+        return position;
+    }
+
+    void SiftDown(size_t position)
+    {
+        for (;;)
+        {
+            size_t best = position;
+            size_t left = position * 2 + 1;
+            size_t right = left + 1;
+            if (left < m_entries.size() && Before(left, best))
+            {
+                best = left;
+            }
+            if (right < m_entries.size() && Before(right, best))
+            {
+                best = right;
+            }
+            if (best == position)
+            {
+                return;
+            }
+            Swap(position, best);
+            position = best;
+        }
+    }
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<Key, size_t> m_positions;
+    Compare m_compare;
+};
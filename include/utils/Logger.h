@@ -10,6 +10,14 @@
 #include <condition_variable>
 #include <queue>
 #include <memory>
+#include <chrono>
+#include <functional>
+#include <sstream>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "utils/BinaryLog.h"
 
 // Log levels
 enum class LogLevel : int
@@ -34,20 +42,119 @@ enum class LogCategory : int
     SYSTEM = 7
 };
 
-// Log entry structure
+// Compile-time minimum level (LogLevel value). Macros below it expand to
+// nothing, so their arguments are never built. Release builds drop DEBUG.
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 1
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
+
+// Log entry structure. Either message is set, or formatter builds it on the
+// worker thread; the timestamp is also rendered there.
 struct LogEntry
 {
-    std::string timestamp;
+    std::chrono::system_clock::time_point time;
     LogLevel level;
     LogCategory category;
     std::string message;
     std::string source;
+    std::function<std::string()> formatter;
     
-    LogEntry(const std::string& ts, LogLevel lvl, LogCategory cat, 
-             const std::string& msg, const std::string& src = "")
-        : timestamp(ts), level(lvl), category(cat), message(msg), source(src) {}
+    LogEntry(LogLevel lvl, LogCategory cat, std::string msg, const std::string& src = "")
+        : time(std::chrono::system_clock::now()), level(lvl), category(cat), message(std::move(msg)), source(src) {}
 };
 
+// Minimal std::format-style formatting: each "{}" is replaced by the next
+// argument ("{{" and "}}" are literal braces). Numbers use std::to_string,
+// matching the existing log output.
+namespace LogFormat
+{
+    // Appends fmt from pos up to the next "{}", returning the position after it or npos
+    size_t AppendUntilPlaceholder(std::string& out, std::string_view fmt, size_t pos);
+
+    inline void AppendValue(std::string& out, std::string_view value) { out.append(value); }
+    inline void AppendValue(std::string& out, const std::string& value) { out.append(value); }
+    inline void AppendValue(std::string& out, const char* value) { out.append(value ? value : "(null)"); }
+    inline void AppendValue(std::string& out, char value) { out.push_back(value); }
+    inline void AppendValue(std::string& out, bool value) { out.append(value ? "true" : "false"); }
+
+    template <typename T>
+    void AppendValue(std::string& out, const T& value)
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            out.append(std::to_string(value));
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+            out.append(std::to_string(static_cast<std::underlying_type_t<T>>(value)));
+        }
+        else
+        {
+            std::ostringstream stream;
+            stream << value;
+            out.append(stream.str());
+        }
+    }
+
+    inline void FormatTo(std::string& out, std::string_view fmt, size_t pos)
+    {
+        while (pos != std::string_view::npos)
+        {
+            pos = AppendUntilPlaceholder(out, fmt, pos);
+            if (pos != std::string_view::npos)
+            {
+                out.append("{}"); // More placeholders than arguments
+            }
+        }
+    }
+
+    template <typename T, typename... Rest>
+    void FormatTo(std::string& out, std::string_view fmt, size_t pos, const T& value, const Rest&... rest)
+    {
+        pos = AppendUntilPlaceholder(out, fmt, pos);
+        if (pos == std::string_view::npos)
+        {
+            return; // Surplus arguments are ignored
+        }
+        AppendValue(out, value);
+        FormatTo(out, fmt, pos, rest...);
+    }
+
+    template <typename... Args>
+    std::string Format(std::string_view fmt, const Args&... args)
+    {
+        std::string out;
+        out.reserve(fmt.size() + 16 * sizeof...(Args));
+        FormatTo(out, fmt, 0, args...);
+        return out;
+    }
+
+    // Arguments are captured by value for formatting on the worker thread;
+    // C strings and views are copied so they cannot dangle
+    template <typename T>
+    auto Capture(T&& value)
+    {
+        using Decayed = std::decay_t<T>;
+        if constexpr (std::is_same_v<Decayed, const char*> || std::is_same_v<Decayed, char*>)
+        {
+            const char* text = value;
+            return std::string(text ? text : "(null)");
+        }
+        else if constexpr (std::is_same_v<Decayed, std::string_view>)
+        {
+            return std::string(value);
+        }
+        else
+        {
+            return Decayed(std::forward<T>(value));
+        }
+    }
+}
+
 class Logger
 {
 public:
@@ -62,8 +169,40 @@ public:
     void SetBufferedLogging(bool enable, size_t bufferSize = 1000);
     void SetLogDirectory(const std::string& directory);
     
+    // Binary mode: LOG_*F calls go to BinaryLog instead of the text queue;
+    // decode the file with Witcher3-MP-LogDecoder
+    bool SetBinaryLogging(bool enable, const std::string& filename = "logs/mp_session.blog");
+    
+    // Cheap level and category filter, checked by the macros before any
+    // argument is evaluated
+    static bool IsEnabled(LogLevel level, LogCategory category)
+    {
+        return static_cast<int>(level) >= s_level.load(std::memory_order_relaxed) &&
+               (s_categoryMask.load(std::memory_order_relaxed) & (1u << static_cast<int>(category))) != 0;
+    }
+    
     // Logging methods
     void Log(LogLevel level, LogCategory category, const std::string& message, const std::string& source = "");
+    
+    // Deferred formatting: arguments are captured and formatted on the worker
+    // thread. format must be a string literal.
+    template <size_t N, typename... Args>
+    void LogDeferred(LogLevel level, LogCategory category, const char* source, const char (&format)[N], Args&&... args)
+    {
+        if (!IsEnabled(level, category))
+        {
+            return;
+        }
+        
+        const char* fmt = format;
+        LogEntry entry(level, category, std::string(), source);
+        entry.formatter = [fmt, captured = std::make_tuple(LogFormat::Capture(std::forward<Args>(args))...)]()
+        {
+            return std::apply([fmt](const auto&... values) { return LogFormat::Format(fmt, values...); }, captured);
+        };
+        Submit(std::move(entry));
+    }
+
     void Debug(LogCategory category, const std::string& message, const std::string& source = "");
     void Info(LogCategory category, const std::string& message, const std::string& source = "");
     void Warning(LogCategory category, const std::string& message, const std::string& source = "");
@@ -88,6 +227,11 @@ public:
     void StartPerformanceLogging();
     void StopPerformanceLogging();
     void LogPerformance(const std::string& operation, double duration);
+    
+    // Formatting helpers, shared with BinaryLogReader
+    static std::string GetLevelString(LogLevel level);
+    static std::string GetCategoryString(LogCategory category);
+    static std::string GetTimeString(std::chrono::system_clock::time_point time);
 
 private:
     Logger();
@@ -95,12 +239,11 @@ private:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
-    std::string GetLevelString(LogLevel level);
-    std::string GetCategoryString(LogCategory category);
-    std::string GetCurrentTimeString();
-    void WriteLog(const LogEntry& entry);
+    void Submit(LogEntry&& entry);
+    void WriteLog(LogEntry& entry);
+    void FlushStreams();
     void ProcessLogQueue();
-    void FlushBuffer();
+    void DrainQueue();
     void RotateLogFile();
     std::string FormatLogEntry(const LogEntry& entry);
     
@@ -109,28 +252,27 @@ private:
     void NotifyWorker();
     
     // Configuration
-    LogLevel m_level = LogLevel::INFO;
     bool m_fileLogging = false;
     bool m_consoleLogging = true;
-    bool m_bufferedLogging = true;
+    std::atomic<bool> m_bufferedLogging{true};
     bool m_performanceLogging = false;
-    size_t m_bufferSize = 1000;
+    std::atomic<size_t> m_bufferSize{1000};
     std::string m_logDirectory = "logs";
     std::string m_logFile = "logs/mp_session.log";
     
-    // Threading and buffering
+    // Threading and buffering. Lock order: m_mutex (output) before m_queueMutex.
     std::ofstream m_logFileStream;
     std::mutex m_mutex;
     std::mutex m_queueMutex;
     std::condition_variable m_condition;
     std::queue<LogEntry> m_logQueue;
-    std::vector<LogEntry> m_logBuffer;
     std::thread m_workerThread;
     std::atomic<bool> m_running{true};
     std::atomic<bool> m_workerRunning{false};
     
-    // Category filtering
-    std::vector<bool> m_enabledCategories;
+    // Level and category filtering, shared so the macros need no instance
+    static std::atomic<int> s_level;
+    static std::atomic<uint32_t> s_categoryMask;
     
     // Performance tracking
     std::chrono::time_point<std::chrono::steady_clock> m_performanceStart;
@@ -139,19 +281,67 @@ private:
     static Logger* s_instance;
 };
 
+// Level and category are checked before the message expression is evaluated
+#define LOG_AT(level, cat, msg) \
+    do { if (Logger::IsEnabled(level, cat)) Logger::GetInstance().Log(level, cat, msg, __FUNCTION__); } while (0)
+#define LOG_FORMAT_AT(level, cat, ...) \
+    do { \
+        if (Logger::IsEnabled(level, cat)) \
+        { \
+            static std::atomic<uint32_t> logSiteId{0}; \
+            if (BinaryLog::IsActive()) \
+                BinaryLog::GetInstance().Write(logSiteId, level, cat, __FUNCTION__, __VA_ARGS__); \
+            else \
+                Logger::GetInstance().LogDeferred(level, cat, __FUNCTION__, __VA_ARGS__); \
+        } \
+    } while (0)
+// Compiled-out levels still reference their arguments, so values that only
+// feed a debug log do not become unused, but never evaluate them
+template <typename... Args>
+inline void LogDiscard(const Args&...) {}
+#define LOG_DISABLED(...) do { if (false) LogDiscard(__VA_ARGS__); } while (0)
+
 // Convenience macros with categories
-#define LOG_DEBUG_CAT(cat, msg) Logger::GetInstance().Debug(cat, msg, __FUNCTION__)
-#define LOG_INFO_CAT(cat, msg) Logger::GetInstance().Info(cat, msg, __FUNCTION__)
-#define LOG_WARNING_CAT(cat, msg) Logger::GetInstance().Warning(cat, msg, __FUNCTION__)
-#define LOG_ERROR_CAT(cat, msg) Logger::GetInstance().Error(cat, msg, __FUNCTION__)
-#define LOG_CRITICAL_CAT(cat, msg) Logger::GetInstance().Critical(cat, msg, __FUNCTION__)
+#if LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG_CAT(cat, msg) LOG_AT(LogLevel::DEBUG, cat, msg)
+#define LOG_DEBUGF_CAT(cat, ...) LOG_FORMAT_AT(LogLevel::DEBUG, cat, __VA_ARGS__)
+#else
+#define LOG_DEBUG_CAT(cat, msg) LOG_DISABLED(cat, msg)
+#define LOG_DEBUGF_CAT(cat, ...) LOG_DISABLED(cat, __VA_ARGS__)
+#endif
+#if LOG_MIN_LEVEL <= 1
+#define LOG_INFO_CAT(cat, msg) LOG_AT(LogLevel::INFO, cat, msg)
+#define LOG_INFOF_CAT(cat, ...) LOG_FORMAT_AT(LogLevel::INFO, cat, __VA_ARGS__)
+#else
+#define LOG_INFO_CAT(cat, msg) LOG_DISABLED(cat, msg)
+#define LOG_INFOF_CAT(cat, ...) LOG_DISABLED(cat, __VA_ARGS__)
+#endif
+#if LOG_MIN_LEVEL <= 2
+#define LOG_WARNING_CAT(cat, msg) LOG_AT(LogLevel::WARNING, cat, msg)
+#define LOG_WARNINGF_CAT(cat, ...) LOG_FORMAT_AT(LogLevel::WARNING, cat, __VA_ARGS__)
+#else
+#define LOG_WARNING_CAT(cat, msg) LOG_DISABLED(cat, msg)
+#define LOG_WARNINGF_CAT(cat, ...) LOG_DISABLED(cat, __VA_ARGS__)
+#endif
+#define LOG_ERROR_CAT(cat, msg) LOG_AT(LogLevel::ERROR_LEVEL, cat, msg)
+#define LOG_ERRORF_CAT(cat, ...) LOG_FORMAT_AT(LogLevel::ERROR_LEVEL, cat, __VA_ARGS__)
+#define LOG_CRITICAL_CAT(cat, msg) LOG_AT(LogLevel::CRITICAL, cat, msg)
+#define LOG_CRITICALF_CAT(cat, ...) LOG_FORMAT_AT(LogLevel::CRITICAL, cat, __VA_ARGS__)
 
 // Legacy macros for backward compatibility
-#define LOG_DEBUG(msg) Logger::GetInstance().Debug(LogCategory::GENERAL, msg, __FUNCTION__)
-#define LOG_INFO(msg) Logger::GetInstance().Info(LogCategory::GENERAL, msg, __FUNCTION__)
-#define LOG_WARNING(msg) Logger::GetInstance().Warning(LogCategory::GENERAL, msg, __FUNCTION__)
-#define LOG_ERROR(msg) Logger::GetInstance().Error(LogCategory::GENERAL, msg, __FUNCTION__)
-#define LOG_CRITICAL(msg) Logger::GetInstance().Critical(LogCategory::GENERAL, msg, __FUNCTION__)
+#define LOG_DEBUG(msg) LOG_DEBUG_CAT(LogCategory::GENERAL, msg)
+#define LOG_INFO(msg) LOG_INFO_CAT(LogCategory::GENERAL, msg)
+#define LOG_WARNING(msg) LOG_WARNING_CAT(LogCategory::GENERAL, msg)
+#define LOG_ERROR(msg) LOG_ERROR_CAT(LogCategory::GENERAL, msg)
+#define LOG_CRITICAL(msg) LOG_CRITICAL_CAT(LogCategory::GENERAL, msg)
+
+// Deferred-format macros: LOG_DEBUGF("Sent {} bytes to {}", size, peer). Written
+// to BinaryLog while binary logging is on, formatted by the text worker otherwise.
+#define LOG_DEBUGF(...) LOG_DEBUGF_CAT(LogCategory::GENERAL, __VA_ARGS__)
+#define LOG_INFOF(...) LOG_INFOF_CAT(LogCategory::GENERAL, __VA_ARGS__)
+#define LOG_WARNINGF(...) LOG_WARNINGF_CAT(LogCategory::GENERAL, __VA_ARGS__)
+#define LOG_ERRORF(...) LOG_ERRORF_CAT(LogCategory::GENERAL, __VA_ARGS__)
+#define LOG_CRITICALF(...) LOG_CRITICALF_CAT(LogCategory::GENERAL, __VA_ARGS__)
 
 // Specialized logging macros
 #define LOG_PLAYER_CONNECTION(playerId, action) Logger::GetInstance().LogPlayerConnection(playerId, action)
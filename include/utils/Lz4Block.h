@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// LZ4 block format (no frame header), readable by liblz4's
+// LZ4_decompress_safe. Self-contained so save data does not depend on the
+// optional system library; tuned for inputs of up to a few hundred KiB.
+
+// Largest output Lz4Compress can produce for size input bytes
+size_t Lz4CompressBound(size_t size);
+
+// Returns the compressed size, or 0 if capacity is below Lz4CompressBound
+size_t Lz4Compress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t capacity);
+
+// Decodes exactly destinationSize bytes; false on malformed or truncated
+// input. Never reads or writes outside the given buffers.
+bool Lz4Decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize);
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "utils/HdrHistogram.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Label pairs attached to a sample, rendered in the given order
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Monotonic counter. Increment is a single relaxed atomic add.
+class MetricCounter
+{
+public:
+    void Increment(uint64_t amount = 1) { m_value.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_value{ 0 };
+};
+
+// Value that can go up and down
+class MetricGauge
+{
+public:
+    void Set(double value) { m_value.store(value, std::memory_order_relaxed); }
+    void Add(double delta);
+    double Get() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> m_value{ 0.0 };
+};
+
+// Distribution recorded in integer units (e.g. microseconds) and exported as
+// a Prometheus summary, multiplied by exportScale (e.g. 1e-6 for seconds)
+class MetricHistogram
+{
+public:
+    explicit MetricHistogram(double exportScale) : m_exportScale(exportScale) {}
+
+    void Record(uint64_t value) { m_values.Record(value); }
+    void Reset() { m_values.Reset(); }
+
+    const PerThreadHdrHistogram& GetValues() const { return m_values; }
+    double GetExportScale() const { return m_exportScale; }
+
+private:
+    PerThreadHdrHistogram m_values;
+    double m_exportScale;
+};
+
+// Builds a Prometheus text exposition (format 0.0.4). Samples are grouped
+// into one family per metric name however the collectors interleave them.
+class MetricsWriter
+{
+public:
+    void Counter(const std::string& name, const std::string& help, double value, const MetricLabels& labels = {});
+    void Gauge(const std::string& name, const std::string& help, double value, const MetricLabels& labels = {});
+
+    // Quantiles 0.5/0.9/0.99/0.999 plus _sum and _count, values multiplied by scale
+    void Summary(const std::string& name, const std::string& help, const HdrHistogram& values, double scale, const MetricLabels& labels = {});
+    void Summary(const std::string& name, const std::string& help, const PerThreadHdrHistogram& values, double scale, const MetricLabels& labels = {});
+
+    // Labels prepended to every following sample
+    void SetBaseLabels(MetricLabels labels) { m_baseLabels = std::move(labels); }
+
+    std::string Render() const;
+
+private:
+    struct Family
+    {
+        std::string help;
+        const char* type = "";
+        std::string samples;
+    };
+
+    Family& GetFamily(const std::string& name, const std::string& help, const char* type);
+    void AppendSample(std::string& out, const std::string& name, const MetricLabels& labels, double value,
+                      const char* extraLabel = nullptr, const char* extraValue = nullptr) const;
+
+    std::map<std::string, Family> m_families;
+    MetricLabels m_baseLabels;
+};
+
+// Keeps a collector registered; unregisters it on destruction. Declare it as
+// the last member of the owner so it goes before anything the collector reads.
+class MetricsRegistration
+{
+public:
+    MetricsRegistration() = default;
+    ~MetricsRegistration() { Reset(); }
+
+    MetricsRegistration(MetricsRegistration&& other) noexcept : m_id(std::exchange(other.m_id, 0)) {}
+    MetricsRegistration& operator=(MetricsRegistration&& other) noexcept;
+
+    MetricsRegistration(const MetricsRegistration&) = delete;
+    MetricsRegistration& operator=(const MetricsRegistration&) = delete;
+
+    // Unregisters now; blocks while a scrape is running the collector
+    void Reset();
+    bool IsRegistered() const { return m_id != 0; }
+
+private:
+    friend class MetricsRegistry;
+    explicit MetricsRegistration(uint64_t id) : m_id(id) {}
+
+    uint64_t m_id = 0;
+};
+
+// Process-wide registry. Subsystems either own metrics created here (updated
+// lock-free on the hot path) or register a collector that copies their stats
+// struct into the exposition at scrape time.
+class MetricsRegistry
+{
+public:
+    using Collector = std::function<void(MetricsWriter&)>;
+
+    static MetricsRegistry& GetInstance();
+
+    // Returns the metric for name + labels, creating it on first use.
+    // References stay valid for the life of the process.
+    MetricCounter& Counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    MetricGauge& Gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    MetricHistogram& Histogram(const std::string& name, const std::string& help, double exportScale = 1.0, const MetricLabels& labels = {});
+
+    // Runs collector on every scrape. When several live collectors share a
+    // scope, each one's samples get an instance_id="<n>" label.
+    [[nodiscard]] MetricsRegistration AddCollector(const std::string& scope, Collector collector);
+
+    // Full exposition: registered metrics, then every collector
+    std::string Render();
+
+    size_t GetCollectorCount() const;
+
+private:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    friend class MetricsRegistration;
+    void RemoveCollector(uint64_t id);
+
+    template<typename TMetric>
+    struct Entry
+    {
+        template<typename... TArgs>
+        Entry(const std::string& entryName, const std::string& entryHelp, const MetricLabels& entryLabels, TArgs&&... args)
+            : name(entryName), help(entryHelp), labels(entryLabels), metric(std::forward<TArgs>(args)...)
+        {
+        }
+
+        std::string name;
+        std::string help;
+        MetricLabels labels;
+        TMetric metric;
+    };
+
+    struct CollectorEntry
+    {
+        uint64_t id;
+        std::string scope;
+        Collector collect;
+    };
+
+    // Guards creation only; recording never takes a lock
+    mutable std::mutex m_metricsMutex;
+    std::deque<Entry<MetricCounter>> m_counters;
+    std::deque<Entry<MetricGauge>> m_gauges;
+    std::deque<Entry<MetricHistogram>> m_histograms;
+
+    // Held while collectors run, so removal waits for an in-flight scrape
+    mutable std::mutex m_collectorsMutex;
+    std::vector<CollectorEntry> m_collectors;
+    uint64_t m_nextCollectorId = 1;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Serves MetricsRegistry::Render() as Prometheus text on GET /metrics.
+// Runs its own single-threaded io_context, so a scrape never touches the
+// game or network threads beyond the collectors it calls.
+class MetricsServer
+{
+public:
+    MetricsServer();
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // Binds to address:port (port 0 picks a free one). Loopback by default so
+    // the endpoint is not reachable from outside the host.
+    bool Start(uint16_t port, const std::string& address = "127.0.0.1");
+    void Stop();
+
+    bool IsRunning() const { return m_running.load(std::memory_order_relaxed); }
+    uint16_t GetPort() const { return m_port; }
+    uint64_t GetScrapeCount() const { return m_scrapes.load(std::memory_order_relaxed); }
+
+private:
+    struct Impl;
+
+    void Accept();
+
+    std::unique_ptr<Impl> m_impl;
+    std::thread m_thread;
+    std::atomic<bool> m_running{ false };
+    std::atomic<uint64_t> m_scrapes{ 0 };
+    uint16_t m_port = 0;
+};
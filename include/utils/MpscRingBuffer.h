@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free multi-producer single-consumer ring buffer.
+// Each slot carries a sequence number (Vyukov bounded queue), so producers
+// claim slots with a single CAS and the consumer never writes shared state
+// except the slot it has just emptied. T must be default constructible and
+// move assignable; values are moved in and out.
+template <typename T>
+class MpscRingBuffer
+{
+public:
+    explicit MpscRingBuffer(size_t capacity = 0)
+    {
+        Reset(capacity);
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    // Reallocates storage, rounding capacity up to a power of two.
+    // Not thread-safe: call only while no producer or consumer is active.
+    void Reset(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        m_slots.reset(capacity > 0 ? new Slot[size] : nullptr);
+        m_mask = capacity > 0 ? size - 1 : 0;
+        m_capacity = capacity > 0 ? size : 0;
+        for (size_t i = 0; i < m_capacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        m_enqueuePos.store(0, std::memory_order_relaxed);
+        m_dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    // Producer side, safe from any number of threads. Fails when full.
+    bool TryEnqueue(T&& value)
+    {
+        if (m_capacity == 0)
+        {
+            return false;
+        }
+
+        Slot* slot;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            slot = &m_slots[pos & m_mask];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = std::move(value);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side, single thread only. Fails when empty or when the next
+    // slot has been claimed but not yet published by its producer.
+    bool TryDequeue(T& value)
+    {
+        return DequeueBulk([&value](T&& item) { value = std::move(item); }, 1) == 1;
+    }
+
+    // Consumer side: hands up to maxCount values to func(T&&) in FIFO order
+    // and returns how many were dequeued.
+    template <typename Func>
+    size_t DequeueBulk(Func&& func, size_t maxCount)
+    {
+        if (m_capacity == 0)
+        {
+            return 0;
+        }
+
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        size_t count = 0;
+        while (count < maxCount)
+        {
+            Slot& slot = m_slots[pos & m_mask];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+            {
+                break;
+            }
+
+            func(std::move(slot.value));
+            slot.value = T();
+            slot.sequence.store(pos + m_capacity, std::memory_order_release);
+            ++pos;
+            ++count;
+        }
+
+        m_dequeuePos.store(pos, std::memory_order_relaxed);
+        return count;
+    }
+
+    // Approximate while producers are running
+    size_t SizeApprox() const
+    {
+        size_t enqueued = m_enqueuePos.load(std::memory_order_relaxed);
+        size_t dequeued = m_dequeuePos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    bool EmptyApprox() const { return SizeApprox() == 0; }
+    size_t Capacity() const { return m_capacity; }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask = 0;
+    size_t m_capacity = 0;
+
+    // Producer and consumer cursors on separate cache lines
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<size_t> m_dequeuePos{0};
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Sorted map kept in one contiguous array of key/value pairs. The first
+// InlineCapacity entries live inside the object, so small maps never
+// allocate; larger ones move to a single heap block that grows by doubling.
+// Lookups are a binary search, inserts shift the tail, and iteration walks
+// the array in key order. Iterators and references are invalidated by any
+// insert or erase. Keys and values must be trivially copyable.
+// Not thread-safe.
+template <typename Key, typename Value, size_t InlineCapacity>
+class SmallFlatMap
+{
+    static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>,
+                  "SmallFlatMap moves entries with plain copies");
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    SmallFlatMap() = default;
+
+    SmallFlatMap(std::initializer_list<value_type> entries)
+    {
+        for (const value_type& entry : entries)
+        {
+            (*this)[entry.first] = entry.second;
+        }
+    }
+
+    SmallFlatMap(const SmallFlatMap& other)
+    {
+        *this = other;
+    }
+
+    SmallFlatMap(SmallFlatMap&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    SmallFlatMap& operator=(const SmallFlatMap& other)
+    {
+        if (this != &other)
+        {
+            m_size = 0;
+            Reserve(other.m_size);
+            std::copy(other.begin(), other.end(), Data());
+            m_size = other.m_size;
+        }
+        return *this;
+    }
+
+    SmallFlatMap& operator=(SmallFlatMap&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (other.m_heap)
+            {
+                m_heap = std::move(other.m_heap);
+                m_capacity = other.m_capacity;
+            }
+            else
+            {
+                // Inline entries are copied; our own heap block, if any, is reused
+                std::copy(other.begin(), other.end(), Data());
+            }
+            m_size = other.m_size;
+            other.m_size = 0;
+            other.m_capacity = InlineCapacity;
+        }
+        return *this;
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t capacity() const { return m_capacity; }
+    bool IsInline() const { return !m_heap; }
+
+    iterator begin() { return Data(); }
+    iterator end() { return Data() + m_size; }
+    const_iterator begin() const { return Data(); }
+    const_iterator end() const { return Data() + m_size; }
+
+    iterator find(const Key& key)
+    {
+        iterator it = begin() + (LowerBound(key) - Data());
+        return it != end() && it->first == key ? it : end();
+    }
+
+    const_iterator find(const Key& key) const
+    {
+        const_iterator it = LowerBound(key);
+        return it != end() && it->first == key ? it : end();
+    }
+
+    size_t count(const Key& key) const { return find(key) != end() ? 1 : 0; }
+    bool contains(const Key& key) const { return find(key) != end(); }
+
+    // Inserts a value-initialised entry if the key is missing
+    Value& operator[](const Key& key)
+    {
+        // Appending in key order, as loading does, skips the search
+        if (m_size == 0 || Data()[m_size - 1].first < key)
+        {
+            return InsertAt(m_size, key)->second;
+        }
+
+        size_t index = static_cast<size_t>(LowerBound(key) - Data());
+        if (Data()[index].first == key)
+        {
+            return Data()[index].second;
+        }
+        return InsertAt(index, key)->second;
+    }
+
+    iterator erase(const_iterator position)
+    {
+        iterator it = begin() + (position - begin());
+        std::copy(it + 1, end(), it);
+        --m_size;
+        return it;
+    }
+
+    size_t erase(const Key& key)
+    {
+        const_iterator it = find(key);
+        if (it == end())
+        {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    // Keeps the heap block, if any, for reuse
+    void clear() { m_size = 0; }
+
+    void Reserve(size_t count)
+    {
+        if (count <= m_capacity)
+        {
+            return;
+        }
+
+        size_t capacity = std::max(count, m_capacity * 2);
+        std::unique_ptr<value_type[]> block(new value_type[capacity]);
+        std::copy(begin(), end(), block.get());
+        m_heap = std::move(block);
+        m_capacity = capacity;
+    }
+
+    // Adds each value in a key-sorted, bidirectional range of pairs to its
+    // entry, creating missing entries, in a single merge pass instead of one
+    // insert apiece. Repeated keys in the range are summed.
+    template <typename InputIt>
+    void AddSorted(InputIt first, InputIt last)
+    {
+        size_t added = 0;
+        const value_type* probe = Data();
+        const value_type* stop = Data() + m_size;
+        for (InputIt it = first; it != last; ++it)
+        {
+            probe = std::lower_bound(probe, stop, it->first,
+                                     [](const value_type& entry, const Key& key) { return entry.first < key; });
+            InputIt next = std::next(it);
+            bool repeated = next != last && next->first == it->first;
+            if (!repeated && (probe == stop || probe->first != it->first))
+            {
+                ++added;
+            }
+        }
+        Reserve(m_size + added);
+
+        // Merge from the back so every existing entry moves at most once
+        value_type* data = Data();
+        size_t read = m_size;
+        size_t write = m_size + added;
+        std::reverse_iterator<InputIt> rit(last);
+        std::reverse_iterator<InputIt> rend(first);
+        while (rit != rend)
+        {
+            const Key& key = rit->first;
+            if (read > 0 && key < data[read - 1].first)
+            {
+                data[--write] = data[--read];
+                continue;
+            }
+
+            Value sum = Value();
+            for (; rit != rend && rit->first == key; ++rit)
+            {
+                sum += rit->second;
+            }
+            if (read > 0 && data[read - 1].first == key)
+            {
+                sum += data[--read].second;
+            }
+            data[--write] = { key, sum };
+        }
+        m_size += added;
+    }
+
+    // Drops every entry the predicate accepts in one compaction pass
+    template <typename Predicate>
+    size_t EraseIf(Predicate predicate)
+    {
+        iterator kept = std::remove_if(begin(), end(), predicate);
+        size_t removed = static_cast<size_t>(end() - kept);
+        m_size -= removed;
+        return removed;
+    }
+
+    friend bool operator==(const SmallFlatMap& a, const SmallFlatMap& b)
+    {
+        return a.m_size == b.m_size && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+private:
+    value_type* Data() { return m_heap ? m_heap.get() : m_inline.data(); }
+    const value_type* Data() const { return m_heap ? m_heap.get() : m_inline.data(); }
+
+    const value_type* LowerBound(const Key& key) const
+    {
+        return std::lower_bound(begin(), end(), key,
+                                [](const value_type& entry, const Key& k) { return entry.first < k; });
+    }
+
+    iterator InsertAt(size_t index, const Key& key)
+    {
+        Reserve(m_size + 1);
+        value_type* data = Data();
+        std::copy_backward(data + index, data + m_size, data + m_size + 1);
+        data[index] = { key, Value() };
+        ++m_size;
+        return data + index;
+    }
+
+    std::unique_ptr<value_type[]> m_heap;
+    size_t m_size = 0;
+    size_t m_capacity = InlineCapacity;
+    std::array<value_type, InlineCapacity> m_inline{};
+};
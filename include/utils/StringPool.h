@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Keeps one copy of each distinct string and hands out a small id for it, so
+// tables with many repeated strings store four bytes per entry instead of a
+// std::string. Ids stay valid until Clear; strings are never removed one at
+// a time. Not thread-safe.
+class StringPool
+{
+public:
+    uint32_t Intern(std::string_view text)
+    {
+        auto it = m_ids.find(text);
+        if (it != m_ids.end())
+        {
+            return it->second;
+        }
+
+        uint32_t id = static_cast<uint32_t>(m_strings.size());
+        m_strings.emplace_back(text);
+        m_ids.emplace(m_strings.back(), id);
+        return id;
+    }
+
+    const std::string& Get(uint32_t id) const { return m_strings[id]; }
+    size_t Size() const { return m_strings.size(); }
+
+    void Clear()
+    {
+        m_ids.clear();
+        m_strings.clear();
+    }
+
+    // Approximate heap and inline bytes held, for footprint reports
+    size_t MemoryUsage() const
+    {
+        size_t bytes = m_strings.size() * sizeof(std::string);
+        for (const std::string& text : m_strings)
+        {
+            // Short strings live inside the std::string itself
+            if (text.capacity() >= sizeof(std::string))
+            {
+                bytes += text.capacity() + 1;
+            }
+        }
+        bytes += m_ids.bucket_count() * sizeof(void*);
+        bytes += m_ids.size() * (sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*));
+        return bytes;
+    }
+
+private:
+    std::deque<std::string> m_strings;  // A deque, so the views below never dangle
+    std::unordered_map<std::string_view, uint32_t> m_ids;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size worker pool shared by subsystems that fan work out per tick
+class ThreadPool
+{
+public:
+    // threadCount = 0 uses one worker per hardware thread minus the caller
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Fire-and-forget task
+    void Enqueue(std::function<void()> task);
+
+    // Runs body over [0, count) in chunks of grainSize on the workers and the
+    // calling thread, returning once every chunk has finished. body must not throw.
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+    size_t GetThreadCount() const { return m_workers.size(); }
+
+private:
+    void WorkerThread();
+
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_running;
+};
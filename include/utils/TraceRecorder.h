@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// One completed span. name, category and argName are stored as pointers, so
+// they must be string literals (or otherwise outlive the recorder).
+struct TraceEvent
+{
+    const char* name = nullptr;
+    const char* category = nullptr;
+    const char* argName = nullptr;   // Optional numeric argument, nullptr for none
+    int64_t argValue = 0;
+    int64_t startNs = 0;             // steady_clock
+    int64_t durationNs = 0;
+};
+
+// Ring of the most recent spans on one thread. Only the owning thread writes;
+// snapshots copy it and discard slots that were overwritten during the copy.
+struct TraceThreadBuffer
+{
+    TraceThreadBuffer(size_t capacity, uint32_t threadIndex);
+
+    std::unique_ptr<TraceEvent[]> events;
+    size_t capacity;
+    size_t mask;
+    uint32_t threadIndex;
+    std::string threadName;          // Guarded by TraceRecorder::m_bufferMutex
+
+    std::atomic<uint64_t> writePos;
+    std::atomic<bool> retired;
+};
+
+// Flight recorder for scoped spans across threads (asio I/O, combat, logger,
+// main loop). Spans go to per-thread rings with no locking, and are exported
+// as Chrome trace-event JSON for chrome://tracing or ui.perfetto.dev, either
+// on demand or automatically for a window around a slow server tick.
+class TraceRecorder
+{
+public:
+    static TraceRecorder& GetInstance();
+
+    // Off by default; a disabled TRACE_SCOPE costs one relaxed load
+    void SetEnabled(bool enabled);
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // Label for the calling thread in exported traces
+    void SetThreadName(const std::string& name);
+
+    // Ring size in events for threads that start recording after the call
+    void SetThreadBufferSize(size_t events);
+
+    void Record(const TraceEvent& event);
+
+    // Spans overlapping [fromNs, toNs] as a Chrome trace-event JSON document
+    std::string ToJson(int64_t fromNs = std::numeric_limits<int64_t>::min(),
+                       int64_t toNs = std::numeric_limits<int64_t>::max());
+    bool DumpToFile(const std::string& filename);
+
+    // Slow-tick capture. Call OnTick once per main loop iteration; when a tick
+    // runs longer than the threshold, the spans from preWindow before it to
+    // postWindow after it are written to directory on a background thread.
+    // A zero threshold disables capture.
+    void SetSlowTickCapture(std::chrono::microseconds threshold, const std::string& directory = "traces",
+                            std::chrono::milliseconds preWindow = std::chrono::milliseconds(500),
+                            std::chrono::milliseconds postWindow = std::chrono::milliseconds(100),
+                            std::chrono::milliseconds cooldown = std::chrono::milliseconds(5000));
+    void OnTick(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+
+    std::chrono::microseconds GetSlowTickThreshold() const;
+    uint64_t GetCaptureCount() const { return m_captureCount.load(std::memory_order_relaxed); }
+    std::string GetLastCapturePath() const;
+
+    // Blocks until the capture being written (if any) is on disk. Call from
+    // the same thread as OnTick.
+    void WaitForCapture();
+
+    static int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    TraceRecorder() = default;
+    ~TraceRecorder();
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    struct ThreadSnapshot
+    {
+        uint32_t threadIndex;
+        std::string threadName;
+        std::vector<TraceEvent> events;
+    };
+
+    TraceThreadBuffer* GetThreadBuffer();
+    std::vector<ThreadSnapshot> Snapshot(int64_t fromNs, int64_t toNs);
+    static std::string FormatJson(const std::vector<ThreadSnapshot>& threads);
+    static bool WriteFile(const std::string& filename, const std::string& contents);
+
+    static std::atomic<bool> s_enabled;
+
+    // Registered thread buffers; retired ones are kept until the next enable
+    mutable std::mutex m_bufferMutex;
+    std::vector<std::shared_ptr<TraceThreadBuffer>> m_buffers;
+    uint32_t m_nextThreadIndex = 0;
+    size_t m_threadBufferSize = 8192;
+    std::atomic<int64_t> m_sessionStartNs{ std::numeric_limits<int64_t>::min() };
+
+    // Slow-tick capture settings and state. m_captureThread belongs to the
+    // thread calling OnTick.
+    mutable std::mutex m_captureMutex;
+    std::chrono::microseconds m_slowTickThreshold{ 0 };
+    std::string m_captureDirectory = "traces";
+    std::chrono::milliseconds m_preWindow{ 500 };
+    std::chrono::milliseconds m_postWindow{ 100 };
+    std::chrono::milliseconds m_cooldown{ 5000 };
+    bool m_capturePending = false;
+    int64_t m_pendingFromNs = 0;
+    int64_t m_pendingUntilNs = 0;
+    int64_t m_pendingTickNs = 0;
+    int64_t m_lastCaptureNs = std::numeric_limits<int64_t>::min();
+    std::string m_lastCapturePath;
+    std::thread m_captureThread;
+    std::atomic<uint64_t> m_captureCount{ 0 };
+};
+
+// Records the enclosing scope as a span when tracing is enabled
+class TraceScope
+{
+public:
+    TraceScope(const char* name, const char* category, const char* argName = nullptr, int64_t argValue = 0)
+    {
+        if (TraceRecorder::IsEnabled())
+        {
+            m_event.name = name;
+            m_event.category = category;
+            m_event.argName = argName;
+            m_event.argValue = argValue;
+            m_event.startNs = TraceRecorder::NowNs();
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_event.name != nullptr)
+        {
+            m_event.durationNs = TraceRecorder::NowNs() - m_event.startNs;
+            TraceRecorder::GetInstance().Record(m_event);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    TraceEvent m_event;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name, category) TraceScope TRACE_CONCAT(traceScope, __COUNTER__)(name, category)
+#define TRACE_SCOPE_ARG(name, category, argName, argValue) \
+    TraceScope TRACE_CONCAT(traceScope, __COUNTER__)(name, category, argName, static_cast<int64_t>(argValue))
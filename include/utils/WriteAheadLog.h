@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Group commit policy: appends are flushed to disk together, at the latest
+// after commitInterval or as soon as commitRecords are waiting
+struct WriteAheadLogOptions
+{
+    std::chrono::milliseconds commitInterval{ 5 };
+    size_t commitRecords = 256;
+};
+
+struct WriteAheadLogStats
+{
+    uint64_t recordsAppended = 0;
+    uint64_t bytesAppended = 0;
+    uint64_t commits = 0;          // fsync calls that made new records durable
+    uint64_t recordsReplayed = 0;
+    uint64_t tailBytesDiscarded = 0;
+};
+
+// Append-only journal of opaque records. Each record gets the next sequence
+// number and a checksum; a commit thread makes batches of records durable
+// with a single fsync. On Open the intact records are replayed in order and a
+// torn or damaged tail left by a crash is cut off. Truncate drops the records
+// a snapshot has made redundant. Safe to use from several threads.
+class WriteAheadLog
+{
+public:
+    using ReplayCallback = std::function<void(uint64_t sequence, const uint8_t* data, size_t size)>;
+
+    WriteAheadLog() = default;
+    ~WriteAheadLog();
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Creates the file if needed and replays every record in it
+    bool Open(const std::string& path, const WriteAheadLogOptions& options, const ReplayCallback& replay);
+
+    // Commits what is pending and closes the file
+    void Close();
+
+    bool IsOpen() const;
+
+    // Returns the record's sequence number, or 0 if the log is not open or
+    // the write failed. The record is durable once a commit covers it.
+    uint64_t Append(const void* data, size_t size);
+
+    // Blocks until sequence is on disk; false if the log failed or closed first
+    bool WaitDurable(uint64_t sequence);
+
+    // Commits everything appended so far and waits for it
+    bool Sync();
+
+    // Drops every record up to and including throughSequence. The file is
+    // rewritten next to the old one and renamed over it.
+    bool Truncate(uint64_t throughSequence);
+
+    uint64_t GetLastSequence() const;
+    uint64_t GetDurableSequence() const;
+    size_t GetFileSize() const;
+    WriteAheadLogStats GetStats() const;
+
+private:
+    void CommitThread();
+
+    std::string m_path;
+    WriteAheadLogOptions m_options;
+
+    // m_mutex guards the file handle and every field below it
+    mutable std::mutex m_mutex;
+    std::condition_variable m_commitCondition;
+    std::condition_variable m_durableCondition;
+    FILE* m_file = nullptr;
+    size_t m_fileSize = 0;
+    uint64_t m_lastSequence = 0;
+    uint64_t m_durableSequence = 0;
+    size_t m_pendingRecords = 0;
+    bool m_commitRequested = false;
+    bool m_committing = false;       // An fsync is running outside the lock
+    bool m_stopRequested = false;
+    bool m_failed = false;
+    WriteAheadLogStats m_stats;
+    std::thread m_commitThread;
+};
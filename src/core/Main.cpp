@@ -20,6 +20,10 @@
 #include "version/DynamicVersionManager.h"
 #include "utils/ConfigManager.h"
 #include "utils/Logger.h"
+#include "utils/Metrics.h"
+#include "utils/MetricsServer.h"
+#include "utils/TraceRecorder.h"
+#include "optimization/JitterBuffer.h"
 
 // TW3 Next-Gen integration
 #include "integration/TW3ModInterface.h"
@@ -36,6 +40,13 @@ public:
 	Witcher3MPServer(uint16_t nPort) : Networking::server_interface<Networking::MessageTypes>(nPort)
 	{}
 
+	// Offline, for replaying a capture
+	Witcher3MPServer()
+	{}
+
+private:
+	MetricCounter& m_messagesReceived = MetricsRegistry::GetInstance().Counter("tw3_server_messages_received_total", "Messages received from clients");
+
 protected:
 	virtual bool OnClientConnect(std::shared_ptr<Networking::connection<Networking::MessageTypes>> client)
 	{
@@ -49,7 +60,7 @@ protected:
 	{
 		std::cout << "Client disconnected [" << client->GetID() << "]\n";
 
-		for (uint8 i = 0; i < PlayerList.size(); ++i)
+		for (size_t i = 0; i < PlayerList.size(); ++i)
 		{
 			Player* ply = PlayerList[i];
 
@@ -64,7 +75,8 @@ protected:
 					uint32 id = ply->GetID();
 					Vector4F pos;
 					uint8 movetype = 1;
-					msg << id << pos << movetype;
+					int64_t sentAt = Optimization::ClockSync::NowMicros();
+					msg << sentAt << id << pos << movetype;
 					for (auto i : PlayerList)
 					{
 						if (i == nullptr)
@@ -73,7 +85,7 @@ protected:
 					}
 
 					std::cout << "Kicking Player: " << id << std::endl;
-					delete PlayerList[i];
+					delete ply;
 				}
 			}
 		}
@@ -81,8 +93,20 @@ protected:
 
 	virtual void OnMessageReceived(std::shared_ptr<Networking::connection<Networking::MessageTypes>> client, Networking::message<Networking::MessageTypes>& msg)
 	{
+		m_messagesReceived.Increment();
+		int64_t receivedAt = Optimization::ClockSync::NowMicros();
+
 		switch (msg.header.id)
 		{
+			case Networking::MessageTypes::ClientPing:
+			{
+				// Echo the client's send time (t0) and append receive (t1) and reply (t2)
+				// times so it can measure round-trip time and clock offset
+				msg.header.id = Networking::MessageTypes::ServerPong;
+				msg << receivedAt << Optimization::ClockSync::NowMicros();
+				MessageClient(client, msg);
+				break;
+			}
 			case Networking::MessageTypes::TS_SEND_PLAYERDATA:
 			{
 				Vector4F recPosition;
@@ -97,7 +121,7 @@ protected:
 
 				for (auto i : PlayerList)
 				{
-					if (i->ownerClient != client)
+					if (i != nullptr && i->ownerClient != client)
 						MessageClient(i->ownerClient, msg);
 				}
 
@@ -108,6 +132,9 @@ protected:
 
 					for (auto i : PlayerList)
 					{
+						if (i == nullptr)
+							continue;
+
 						uint32 ID = i->GetID();
 						Vector4F pos = i->GetPosition();
 						
@@ -136,7 +163,7 @@ protected:
 			{
 				Player* affected = nullptr;
 				for (Player* i : PlayerList)
-					if (i->ownerClient == client)
+					if (i != nullptr && i->ownerClient == client)
 					{
 						affected = i;
 						break;
@@ -152,8 +179,9 @@ protected:
 
 					Networking::message<Networking::MessageTypes> updatePos;
 					updatePos.header.id = Networking::MessageTypes::TC_UPDATE_POS;
+					// Relay time goes underneath so readers that stop at the move type are unaffected
 					uint32 playerId = affected->GetID();
-					updatePos << playerId << newPos << MoveType;
+					updatePos << receivedAt << playerId << newPos << MoveType;
 
 					MessageAllClients(updatePos, affected->ownerClient);
 				}
@@ -184,7 +212,8 @@ protected:
 							healthMsg << healthMsg_id << healthMsg_isPlayer << healthMsg_currhealthvalue << healthMsg_maxhealthvalue;
 
 							for (auto j : PlayerList)
-								MessageClient(j->ownerClient, healthMsg);
+								if (j != nullptr)
+									MessageClient(j->ownerClient, healthMsg);
 						}
 						else
 						{
@@ -195,7 +224,8 @@ protected:
 							death_msg << Id;
 
 							for (auto j : PlayerList)
-								MessageClient(j->ownerClient, death_msg);
+								if (j != nullptr)
+									MessageClient(j->ownerClient, death_msg);
 						}
 						break;
 					}
@@ -206,7 +236,7 @@ protected:
 			{
 				for (auto i : PlayerList)
 				{
-					if (i->ownerClient == client)
+					if (i != nullptr && i->ownerClient == client)
 					{
 						float damage = 100.f;
 
@@ -242,7 +272,7 @@ protected:
 			{
 				for (auto i : PlayerList)
 				{
-					if (i->ownerClient == client)
+					if (i != nullptr && i->ownerClient == client)
 					{
 						std::string chat_message;
 						for (uint8 i = 0; i < 100; ++i)
@@ -270,7 +300,7 @@ protected:
 							msg << i;
 
 						for(auto i : PlayerList)
-							if(i->ownerClient != client)
+							if(i != nullptr && i->ownerClient != client)
 								MessageClient(i->ownerClient, msg);
 
 
@@ -336,7 +366,7 @@ void handle_commands()
 
 				for (auto i : PlayerList)
 				{
-					if (i->GetID() == toPlayerID)
+					if (i != nullptr && i->GetID() == toPlayerID)
 					{
 						SpawnTo = i->GetPosition();
 						break;
@@ -365,6 +395,30 @@ void handle_commands()
 				}
 			}
 		}
+		// capture: start <file> | stop
+		else if (segments[0] == "capture" && segments.size() >= 2)
+		{
+			if (segments[1] == "start" && segments.size() == 3)
+				w3server->StartCapture(segments[2]);
+			else if (segments[1] == "stop")
+				w3server->StopCapture();
+		}
+		// trace: on | off | dump <file> | slowtick <ms> (0 = no automatic capture)
+		else if (segments[0] == "trace" && segments.size() >= 2)
+		{
+			auto& tracer = TraceRecorder::GetInstance();
+			if (segments[1] == "on")
+				tracer.SetEnabled(true);
+			else if (segments[1] == "off")
+				tracer.SetEnabled(false);
+			else if (segments[1] == "dump" && segments.size() == 3)
+				tracer.DumpToFile(segments[2]);
+			else if (segments[1] == "slowtick" && segments.size() == 3)
+			{
+				tracer.SetSlowTickCapture(std::chrono::milliseconds(std::atoi(segments[2].c_str())));
+				LOG_INFO("Slow tick capture threshold: " + segments[2] + "ms");
+			}
+		}
 
 		commandQueue[i] = "";
 	}
@@ -373,11 +427,22 @@ void handle_commands()
 		commandQueue.end(), ""), commandQueue.end());
 }
 
-int main()
+int main(int argc, char* argv[])
 {
 	system("Color 03");
 	setlocale(LC_ALL, "");
 
+	// --replay <file> [speed]: runs a traffic capture through the server
+	// handlers offline, with no listener, then exits (speed 0 = as fast as possible)
+	std::string replayFile;
+	double replaySpeed = 1.0;
+	if (argc >= 3 && std::string(argv[1]) == "--replay")
+	{
+		replayFile = argv[2];
+		if (argc >= 4)
+			replaySpeed = std::atof(argv[3]);
+	}
+
 	// Initialize logging system first
 	Logger& logger = Logger::GetInstance();
 	logger.SetFileLogging(true, "witcher3mp.log");
@@ -430,7 +495,7 @@ int main()
 	}
 	
 	// Set up callbacks for game events
-	tw3Interface.SetPlayerMoveCallback([](uint32_t playerId, float x, float y, float z, float w) {
+	tw3Interface.SetPlayerMoveCallback([](uint32_t playerId, float x, float y, float z, float) {
 		LOG_DEBUG("Player " + std::to_string(playerId) + " moved to (" + 
 			std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")");
 	});
@@ -459,6 +524,20 @@ int main()
 		LOG_INFO("Please verify mod compatibility with the new game version");
 	}
 
+	if (!replayFile.empty())
+	{
+		Witcher3MPServer replayServer;
+		Networking::replay_stats stats = replayServer.Replay(replayFile, replaySpeed);
+
+		LOG_INFO("Replayed " + std::to_string(stats.messages) + " messages, " +
+			std::to_string(stats.connects) + " connects, " + std::to_string(stats.disconnects) + " disconnects in " +
+			std::to_string(std::chrono::duration<double, std::milli>(stats.replayDuration).count()) + "ms (recorded " +
+			std::to_string(std::chrono::duration<double, std::milli>(stats.recordedDuration).count()) + "ms)" +
+			(stats.complete ? "" : ", capture incomplete"));
+		Logger::DestroyInstance();
+		return stats.complete ? 0 : 1;
+	}
+
 	// Get port from configuration
 	uint16_t port = configManager.GetPort();
 	if (port == 0)
@@ -480,17 +559,44 @@ int main()
 
 	LOG_INFO("Server started successfully");
 
+	// Prometheus endpoint on localhost, off unless metrics_port is set
+	MetricsServer metricsServer;
+	int metricsPort = configManager.GetIntValue("metrics_port", 0);
+	if (metricsPort > 0 && metricsPort <= 65535)
+	{
+		metricsServer.Start(static_cast<uint16_t>(metricsPort));
+	}
+
+	auto& metrics = MetricsRegistry::GetInstance();
+	MetricGauge& playersGauge = metrics.Gauge("tw3_server_players", "Players currently joined");
+	MetricGauge& npcsGauge = metrics.Gauge("tw3_server_npcs", "NPCs spawned");
+
 	// Start command processor thread
 	std::thread commandProcessor(receive_commands);
 	LOG_INFO("Command processor started");
 
+	// Tracing stays off until "trace on"; slow ticks are then captured automatically
+	auto& tracer = TraceRecorder::GetInstance();
+	tracer.SetThreadName("main");
+	tracer.SetSlowTickCapture(std::chrono::milliseconds(configManager.GetIntValue("trace_slow_tick_ms", 50)));
+	if (configManager.GetBoolValue("trace_enabled", false))
+	{
+		tracer.SetEnabled(true);
+	}
+
 	// Main server loop
 	LOG_INFO("Entering main server loop");
 	while (true)
 	{
+		auto tickStart = std::chrono::steady_clock::now();
 		try
 		{
-			handle_commands();
+			TRACE_SCOPE("Tick", "server");
+
+			{
+				TRACE_SCOPE("handle_commands", "server");
+				handle_commands();
+			}
 
 			// Clean up disconnected players
 			if (PlayerList.size())
@@ -502,6 +608,9 @@ int main()
 			// Update server
 			w3server->Update(-1, false);
 
+			playersGauge.Set(static_cast<double>(PlayerList.size()));
+			npcsGauge.Set(static_cast<double>(NpcList.size()));
+
 			// Check for game updates periodically (every 1000 iterations)
 			static int updateCheckCounter = 0;
 			if (++updateCheckCounter >= 1000)
@@ -521,11 +630,15 @@ int main()
 		{
 			LOG_ERROR("Unknown exception in main loop");
 		}
+
+		tracer.OnTick(tickStart, std::chrono::steady_clock::now());
 	}
 
 	// Cleanup
 	LOG_INFO("Shutting down server...");
 	commandProcessor.join();
+	metricsServer.Stop();
+	tracer.WaitForCapture();
 	delete w3server;
 	Logger::DestroyInstance();
 
@@ -1,21 +1,124 @@
 #include "game/GlobalEconomy.h"
+#include "game/SaveSerialization.h"
+#include "utils/DurableFile.h"
 #include "utils/Logger.h"
 #include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 
 namespace Game
 {
+    namespace
+    {
+        // Snapshot header record; the sections follow it
+        constexpr uint32_t SnapshotVersion = 1;
+
+        // Item ids below this get a slot in every merchant's price row
+        constexpr uint32_t MaxTableItemId = 1 << 16;
+
+        // Subtracts up to amount from a stock entry and drops it at zero;
+        // returns what was actually taken
+        uint32_t TakeFromStock(Inventory& stock, uint32_t itemId, uint32_t amount)
+        {
+            auto it = stock.find(itemId);
+            if (it == stock.end())
+            {
+                return 0;
+            }
+
+            uint32_t taken = std::min(it->second, amount);
+            it->second -= taken;
+            if (it->second == 0)
+            {
+                stock.erase(it);
+            }
+            return taken;
+        }
+
+        // Only replay can carry ids past the counter; live ids come from it
+        void AdvancePast(std::atomic<uint32_t>& nextId, uint32_t transactionId)
+        {
+            uint32_t next = nextId.load(std::memory_order_relaxed);
+            while (next <= transactionId && !nextId.compare_exchange_weak(next, transactionId + 1))
+            {
+            }
+        }
+
+        // A loot drop or one side of a trade: item moves that can be merged
+        bool IsItemMove(const TransactionData& transaction)
+        {
+            return transaction.type == TransactionType::Trade ||
+                   (transaction.type == TransactionType::Loot && transaction.itemId != 0 && transaction.price == 0);
+        }
+
+        bool SameParties(const TransactionData& a, const TransactionData& b)
+        {
+            return a.type == b.type && a.playerId == b.playerId && a.recipientId == b.recipientId;
+        }
+
+        bool InvolvesMerchant(const TransactionData& transaction)
+        {
+            return transaction.type == TransactionType::Buy || transaction.type == TransactionType::Sell ||
+                   transaction.type == TransactionType::Restock;
+        }
+
+        // Returns what was actually taken
+        uint32_t TakeCurrency(PlayerEconomyData& player, CurrencyType currency, uint32_t amount)
+        {
+            uint32_t& balance = player.currencies[currency];
+            uint32_t taken = std::min(balance, amount);
+            balance -= taken;
+            return taken;
+        }
+
+        uint32_t CurrencyOf(const PlayerEconomyData* player, CurrencyType currency)
+        {
+            if (!player)
+            {
+                return 0;
+            }
+
+            auto it = player->currencies.find(currency);
+            return it != player->currencies.end() ? it->second : 0;
+        }
+
+        uint32_t QuantityOf(const PlayerEconomyData* player, uint32_t itemId)
+        {
+            if (!player)
+            {
+                return 0;
+            }
+
+            auto it = player->inventory.find(itemId);
+            return it != player->inventory.end() ? it->second : 0;
+        }
+
+        // Journal record naming the player, merchant or item it removes
+        BinaryWriter RemovalRecord(SaveSection tag, uint32_t id)
+        {
+            BinaryWriter out;
+            size_t section = out.BeginSection(static_cast<uint32_t>(tag), 1);
+            out.WriteVarUInt(id);
+            out.EndSection(section);
+            return out;
+        }
+    }
+
     // GlobalEconomy implementation
     GlobalEconomy::GlobalEconomy()
-        : m_initialized(false), m_inflationRate(0.01f), m_maxPlayerWeight(1000),
+        : m_initialized(false), m_priceEpoch(1), m_inflationRate(0.01f), m_maxPlayerWeight(1000),
           m_merchantRestockInterval(3600.0f), m_tradingEnabled(true), m_giftingEnabled(true),
+          m_tradedValue(0), m_snapshotInterval(300.0f), m_snapshotSequence(0), m_replayFailed(false), m_restockBudget(64),
           m_nextItemId(1), m_nextMerchantId(1), m_nextTransactionId(1)
     {
         m_lastUpdateTime = std::chrono::high_resolution_clock::now();
-        m_lastRestockTime = m_lastUpdateTime;
+        m_lastSnapshotTime = m_lastUpdateTime;
         
         LOG_INFO("Global economy system created");
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("economy",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     GlobalEconomy::~GlobalEconomy()
@@ -33,13 +136,25 @@ namespace Game
 
         LOG_INFO("Initializing global economy system...");
 
+        // AddItem and AddMerchant ignore calls made before initialization
+        m_initialized = true;
+
         // Initialize default items
         InitializeDefaultItems();
         
         // Initialize default merchants
         InitializeDefaultMerchants();
 
-        m_initialized = true;
+        // Persisted state replaces the defaults
+        if (!m_stateDirectory.empty() && !LoadEconomyState())
+        {
+            LOG_ERROR("Failed to restore economy state from " + m_stateDirectory);
+            GlobalLock lock = LockEverything();
+            ClearAll();
+            m_initialized = false;
+            return false;
+        }
+
         LOG_INFO("Global economy system initialized");
         return true;
     }
@@ -54,13 +169,17 @@ namespace Game
         LOG_INFO("Shutting down global economy system...");
         
         // Save economy state
-        SaveEconomyState();
+        if (m_journal.IsOpen())
+        {
+            SaveEconomyState();
+            m_journal.Close();
+        }
         
         // Clear all data
-        m_items.clear();
-        m_playerEconomies.clear();
-        m_merchants.clear();
-        m_transactions.clear();
+        {
+            GlobalLock lock = LockEverything();
+            ClearAll();
+        }
         
         m_initialized = false;
         LOG_INFO("Global economy system shutdown complete");
@@ -74,21 +193,38 @@ namespace Game
         }
 
         ItemData itemCopy = item;
-        if (itemCopy.itemId == 0)
-        {
-            itemCopy.itemId = m_nextItemId++;
-        }
 
         // Calculate default prices
-        if (itemCopy.prices.empty())
+        if (std::all_of(itemCopy.prices.begin(), itemCopy.prices.end(), [](uint32_t price) { return price == 0; }))
         {
-            itemCopy.prices[CurrencyType::Gold] = itemCopy.value;
-            itemCopy.prices[CurrencyType::Silver] = itemCopy.value * 10;
-            itemCopy.prices[CurrencyType::Copper] = itemCopy.value * 100;
+            itemCopy.prices[static_cast<size_t>(CurrencyType::Gold)] = itemCopy.value;
+            itemCopy.prices[static_cast<size_t>(CurrencyType::Silver)] = itemCopy.value * 10;
+            itemCopy.prices[static_cast<size_t>(CurrencyType::Copper)] = itemCopy.value * 100;
         }
 
-        m_items[itemCopy.itemId] = itemCopy;
-        m_stats.totalItems++;
+        bool replaced;
+        {
+            GlobalLock lock = LockEverything();
+            if (itemCopy.itemId == 0)
+            {
+                itemCopy.itemId = m_nextItemId++;
+            }
+
+            BinaryWriter record;
+            SaveSerialization::WriteItems(record, { { itemCopy.itemId, itemCopy } });
+            if (!Journal(record))
+            {
+                LOG_ERROR("Economy journal write failed; item " + itemCopy.name + " not added");
+                return;
+            }
+            replaced = ApplyItem(itemCopy);
+        }
+        WaitForJournal();
+        if (!replaced)
+        {
+            std::lock_guard<std::mutex> stats(m_statsMutex);
+            m_stats.totalItems++;
+        }
 
         LOG_INFO("Added item: " + itemCopy.name + " (ID: " + std::to_string(itemCopy.itemId) + 
                 ", Value: " + std::to_string(itemCopy.value) + ")");
@@ -96,61 +232,89 @@ namespace Game
 
     void GlobalEconomy::RemoveItem(uint32_t itemId)
     {
-        auto it = m_items.find(itemId);
-        if (it != m_items.end())
         {
-            m_items.erase(it);
+            GlobalLock lock = LockEverything();
+            if (!m_catalog.Contains(itemId))
+            {
+                return;
+            }
+            if (!Journal(RemovalRecord(SaveSection::RemovedItem, itemId)))
+            {
+                LOG_ERROR("Economy journal write failed; item " + std::to_string(itemId) + " not removed");
+                return;
+            }
+            ApplyItemRemoval(itemId);
+        }
+        WaitForJournal();
+        {
+            std::lock_guard<std::mutex> stats(m_statsMutex);
             m_stats.totalItems--;
-            LOG_INFO("Removed item ID: " + std::to_string(itemId));
         }
+        LOG_INFO("Removed item ID: " + std::to_string(itemId));
     }
 
-    ItemData* GlobalEconomy::GetItem(uint32_t itemId)
+    std::optional<ItemData> GlobalEconomy::GetItem(uint32_t itemId) const
     {
-        auto it = m_items.find(itemId);
-        if (it != m_items.end())
-        {
-            return &it->second;
-        }
-        return nullptr;
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+        return m_catalog.Get(itemId);
     }
 
     std::vector<ItemData> GlobalEconomy::GetAllItems() const
     {
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
         std::vector<ItemData> items;
-        for (const auto& pair : m_items)
+        items.reserve(m_catalog.Size());
+        for (uint32_t itemId : m_catalog.GetIds())
         {
-            items.push_back(pair.second);
+            items.push_back(*m_catalog.Get(itemId));
         }
         return items;
     }
 
     std::vector<ItemData> GlobalEconomy::GetItemsByType(ItemType type) const
     {
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+        const std::vector<uint32_t>& itemIds = m_catalog.GetIdsByType(type);
         std::vector<ItemData> items;
-        for (const auto& pair : m_items)
+        items.reserve(itemIds.size());
+        for (uint32_t itemId : itemIds)
         {
-            if (pair.second.type == type)
-            {
-                items.push_back(pair.second);
-            }
+            items.push_back(*m_catalog.Get(itemId));
         }
         return items;
     }
 
     std::vector<ItemData> GlobalEconomy::GetItemsByRarity(ItemRarity rarity) const
     {
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+        const std::vector<uint32_t>& itemIds = m_catalog.GetIdsByRarity(rarity);
         std::vector<ItemData> items;
-        for (const auto& pair : m_items)
+        items.reserve(itemIds.size());
+        for (uint32_t itemId : itemIds)
         {
-            if (pair.second.rarity == rarity)
-            {
-                items.push_back(pair.second);
-            }
+            items.push_back(*m_catalog.Get(itemId));
         }
         return items;
     }
 
+    std::vector<uint32_t> GlobalEconomy::GetItemIdsByType(ItemType type) const
+    {
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+        return m_catalog.GetIdsByType(type);
+    }
+
+    std::vector<uint32_t> GlobalEconomy::GetItemIdsByRarity(ItemRarity rarity) const
+    {
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+        return m_catalog.GetIdsByRarity(rarity);
+    }
+
+    size_t GlobalEconomy::GetCatalogMemoryUsage() const
+    {
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+        return m_catalog.MemoryUsage();
+    }
+
     void GlobalEconomy::AddPlayer(uint32_t playerId)
     {
         if (!m_initialized)
@@ -158,47 +322,105 @@ namespace Game
             return;
         }
 
-        PlayerEconomyData player;
-        player.playerId = playerId;
-        player.currencies[CurrencyType::Gold] = 100; // Starting gold
-        player.lastUpdate = std::chrono::high_resolution_clock::now();
-        
-        m_playerEconomies[playerId] = player;
+        {
+            UpdateLock lock = LockForUpdate({ playerId });
+            PlayerShard& shard = ShardForPlayer(playerId);
+
+            // Returning players keep their balance and inventory
+            if (shard.players.count(playerId) > 0)
+            {
+                LOG_INFOF("Player rejoined economy: {}", playerId);
+                return;
+            }
+
+            PlayerEconomyData player;
+            player.playerId = playerId;
+            player.lastUpdate = std::chrono::high_resolution_clock::now();
+            shard.players[playerId] = player;
+            shard.wealth.Set(playerId, 0);
+
+            // Starting gold
+            TransactionData grant;
+            grant.transactionId = m_nextTransactionId++;
+            grant.playerId = playerId;
+            grant.type = TransactionType::Loot;
+            grant.price = 100;
+            grant.currency = CurrencyType::Gold;
+            grant.timestamp = player.lastUpdate;
+            grant.isCompleted = true;
+            CommitTransactions({ grant });
+        }
+
+        WaitForJournal();
         
         LOG_INFO("Added player to economy: " + std::to_string(playerId));
     }
 
     void GlobalEconomy::RemovePlayer(uint32_t playerId)
     {
-        auto it = m_playerEconomies.find(playerId);
-        if (it != m_playerEconomies.end())
         {
-            m_playerEconomies.erase(it);
-            LOG_INFO("Removed player from economy: " + std::to_string(playerId));
+            std::unique_lock<std::shared_mutex> lock(ShardForPlayer(playerId).mutex);
+            if (!GetPlayerEconomy(playerId))
+            {
+                return;
+            }
+            if (!Journal(RemovalRecord(SaveSection::RemovedPlayer, playerId)))
+            {
+                LOG_ERROR("Economy journal write failed; player " + std::to_string(playerId) + " not removed");
+                return;
+            }
+            ApplyPlayerRemoval(playerId);
         }
+        WaitForJournal();
+        LOG_INFO("Removed player from economy: " + std::to_string(playerId));
     }
 
     PlayerEconomyData* GlobalEconomy::GetPlayerEconomy(uint32_t playerId)
     {
-        auto it = m_playerEconomies.find(playerId);
-        if (it != m_playerEconomies.end())
+        auto& players = ShardForPlayer(playerId).players;
+        auto it = players.find(playerId);
+        if (it != players.end())
         {
             return &it->second;
         }
         return nullptr;
     }
 
+    const PlayerEconomyData* GlobalEconomy::GetPlayerEconomy(uint32_t playerId) const
+    {
+        const auto& players = ShardForPlayer(playerId).players;
+        auto it = players.find(playerId);
+        return it != players.end() ? &it->second : nullptr;
+    }
+
     bool GlobalEconomy::AddCurrency(uint32_t playerId, CurrencyType currency, uint32_t amount)
     {
-        PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        if (!player)
+        {
+            UpdateLock lock = LockForUpdate({ playerId });
+            if (!GetPlayerEconomy(playerId))
+            {
+                return false;
+            }
+
+            TransactionData grant;
+            grant.transactionId = m_nextTransactionId++;
+            grant.playerId = playerId;
+            grant.type = TransactionType::Loot;
+            grant.price = amount;
+            grant.currency = currency;
+            grant.timestamp = std::chrono::high_resolution_clock::now();
+            grant.isCompleted = true;
+            if (!CommitTransactions({ grant }))
+            {
+                return false;
+            }
+        }
+
+        if (!WaitForJournal())
         {
             return false;
         }
 
-        player->currencies[currency] += amount;
-        player->lastUpdate = std::chrono::high_resolution_clock::now();
-        
         UpdatePlayerWealth(playerId);
         
         LOG_DEBUG("Added " + std::to_string(amount) + " " + std::to_string(static_cast<int>(currency)) + 
@@ -208,20 +430,37 @@ namespace Game
 
     bool GlobalEconomy::RemoveCurrency(uint32_t playerId, CurrencyType currency, uint32_t amount)
     {
-        PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        if (!player)
         {
-            return false;
+            UpdateLock lock = LockForUpdate({ playerId });
+            if (!GetPlayerEconomy(playerId))
+            {
+                return false;
+            }
+
+            if (!CanPlayerAfford(playerId, currency, amount))
+            {
+                return false;
+            }
+
+            TransactionData spend;
+            spend.transactionId = m_nextTransactionId++;
+            spend.playerId = playerId;
+            spend.type = TransactionType::Spend;
+            spend.price = amount;
+            spend.currency = currency;
+            spend.timestamp = std::chrono::high_resolution_clock::now();
+            spend.isCompleted = true;
+            if (!CommitTransactions({ spend }))
+            {
+                return false;
+            }
         }
 
-        if (!CanPlayerAfford(playerId, currency, amount))
+        if (!WaitForJournal())
         {
             return false;
         }
 
-        player->currencies[currency] -= amount;
-        player->lastUpdate = std::chrono::high_resolution_clock::now();
-        
         UpdatePlayerWealth(playerId);
         
         LOG_DEBUG("Removed " + std::to_string(amount) + " " + std::to_string(static_cast<int>(currency)) + 
@@ -231,90 +470,151 @@ namespace Game
 
     uint32_t GlobalEconomy::GetCurrency(uint32_t playerId, CurrencyType currency) const
     {
-        const PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        if (!player)
+        std::shared_lock<std::shared_mutex> lock(ShardForPlayer(playerId).mutex);
+        return CurrencyOf(GetPlayerEconomy(playerId), currency);
+    }
+
+    bool GlobalEconomy::AddItemToInventory(uint32_t playerId, uint32_t itemId, uint32_t quantity)
+    {
         {
-            return 0;
+            UpdateLock lock = LockForUpdate({ playerId });
+            PlayerEconomyData* player = GetPlayerEconomy(playerId);
+        
+            if (!player || !m_catalog.Contains(itemId))
+            {
+                return false;
+            }
+
+            // Check weight limit
+            if (!CanPlayerCarry(playerId, itemId, quantity))
+            {
+                return false;
+            }
+
+            TransactionData grant;
+            grant.transactionId = m_nextTransactionId++;
+            grant.playerId = playerId;
+            grant.type = TransactionType::Loot;
+            grant.itemId = itemId;
+            grant.quantity = quantity;
+            grant.timestamp = std::chrono::high_resolution_clock::now();
+            grant.isCompleted = true;
+            if (!CommitTransactions({ grant }))
+            {
+                return false;
+            }
+        
+            LOG_DEBUG("Added " + std::to_string(quantity) + " " + m_catalog.GetName(itemId) + 
+                     " to player " + std::to_string(playerId) + " inventory");
         }
 
-        auto it = player->currencies.find(currency);
-        if (it != player->currencies.end())
+        if (!WaitForJournal())
         {
-            return it->second;
+            return false;
         }
-        return 0;
+        return true;
     }
 
-    bool GlobalEconomy::AddItemToInventory(uint32_t playerId, uint32_t itemId, uint32_t quantity)
+    bool GlobalEconomy::AddItemsToInventory(uint32_t playerId, const std::map<uint32_t, uint32_t>& items)
     {
-        PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        ItemData* item = GetItem(itemId);
-        
-        if (!player || !item)
         {
-            return false;
+            UpdateLock lock = LockForUpdate({ playerId });
+            PlayerEconomyData* player = GetPlayerEconomy(playerId);
+
+            if (!player || items.empty())
+            {
+                return false;
+            }
+
+            for (const auto& pair : items)
+            {
+                if (!m_catalog.Contains(pair.first))
+                {
+                    return false;
+                }
+            }
+
+            // One weight check for the whole drop
+            if (player->totalWeight + WeightOf(items) > player->maxWeight)
+            {
+                return false;
+            }
+
+            auto now = std::chrono::high_resolution_clock::now();
+            std::vector<TransactionData> grants;
+            grants.reserve(items.size());
+            for (const auto& pair : items)
+            {
+                TransactionData grant;
+                grant.transactionId = m_nextTransactionId++;
+                grant.playerId = playerId;
+                grant.type = TransactionType::Loot;
+                grant.itemId = pair.first;
+                grant.quantity = pair.second;
+                grant.timestamp = now;
+                grant.isCompleted = true;
+                grants.push_back(grant);
+            }
+            if (!CommitTransactions(grants))
+            {
+                return false;
+            }
+
+            LOG_DEBUG("Added " + std::to_string(items.size()) + " kinds of items to player " +
+                      std::to_string(playerId) + " inventory");
         }
 
-        // Check weight limit
-        uint32_t additionalWeight = item->weight * quantity;
-        if (player->totalWeight + additionalWeight > player->maxWeight)
+        if (!WaitForJournal())
         {
             return false;
         }
-
-        player->inventory[itemId] += quantity;
-        player->totalWeight += additionalWeight;
-        player->lastUpdate = std::chrono::high_resolution_clock::now();
-        
-        LOG_DEBUG("Added " + std::to_string(quantity) + " " + item->name + 
-                 " to player " + std::to_string(playerId) + " inventory");
         return true;
     }
 
     bool GlobalEconomy::RemoveItemFromInventory(uint32_t playerId, uint32_t itemId, uint32_t quantity)
     {
-        PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        ItemData* item = GetItem(itemId);
-        
-        if (!player || !item)
         {
-            return false;
-        }
+            UpdateLock lock = LockForUpdate({ playerId });
+            PlayerEconomyData* player = GetPlayerEconomy(playerId);
+        
+            if (!player || !m_catalog.Contains(itemId))
+            {
+                return false;
+            }
 
-        auto it = player->inventory.find(itemId);
-        if (it == player->inventory.end() || it->second < quantity)
-        {
-            return false;
+            if (QuantityOf(player, itemId) < quantity)
+            {
+                return false;
+            }
+
+            TransactionData spend;
+            spend.transactionId = m_nextTransactionId++;
+            spend.playerId = playerId;
+            spend.type = TransactionType::Spend;
+            spend.itemId = itemId;
+            spend.quantity = quantity;
+            spend.timestamp = std::chrono::high_resolution_clock::now();
+            spend.isCompleted = true;
+            if (!CommitTransactions({ spend }))
+            {
+                return false;
+            }
+        
+            LOG_DEBUG("Removed " + std::to_string(quantity) + " " + m_catalog.GetName(itemId) + 
+                     " from player " + std::to_string(playerId) + " inventory");
         }
 
-        it->second -= quantity;
-        if (it->second == 0)
+        if (!WaitForJournal())
         {
-            player->inventory.erase(it);
+            return false;
         }
-
-        player->totalWeight -= item->weight * quantity;
-        player->lastUpdate = std::chrono::high_resolution_clock::now();
-        
-        LOG_DEBUG("Removed " + std::to_string(quantity) + " " + item->name + 
-                 " from player " + std::to_string(playerId) + " inventory");
         return true;
     }
 
     uint32_t GlobalEconomy::GetItemQuantity(uint32_t playerId, uint32_t itemId) const
     {
-        const PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        if (!player)
-        {
-            return 0;
-        }
-
-        auto it = player->inventory.find(itemId);
-        if (it != player->inventory.end())
-        {
-            return it->second;
-        }
-        return 0;
+        std::shared_lock<std::shared_mutex> lock(ShardForPlayer(playerId).mutex);
+        return QuantityOf(GetPlayerEconomy(playerId), itemId);
     }
 
     void GlobalEconomy::AddMerchant(const MerchantData& merchant)
@@ -330,8 +630,28 @@ namespace Game
             merchantCopy.merchantId = m_nextMerchantId++;
         }
 
-        m_merchants[merchantCopy.merchantId] = merchantCopy;
-        m_stats.activeMerchants++;
+        // A new merchant first restocks one interval after joining
+        if (merchantCopy.lastRestock == std::chrono::high_resolution_clock::time_point())
+        {
+            merchantCopy.lastRestock = std::chrono::high_resolution_clock::now();
+        }
+
+        {
+            std::unique_lock<std::shared_mutex> lock(ShardForMerchant(merchantCopy.merchantId).mutex);
+            BinaryWriter record;
+            SaveSerialization::WriteMerchants(record, { { merchantCopy.merchantId, merchantCopy } });
+            if (!Journal(record))
+            {
+                LOG_ERROR("Economy journal write failed; merchant " + merchantCopy.name + " not added");
+                return;
+            }
+            ApplyMerchant(merchantCopy);
+        }
+        WaitForJournal();
+        {
+            std::lock_guard<std::mutex> stats(m_statsMutex);
+            m_stats.activeMerchants++;
+        }
 
         LOG_INFO("Added merchant: " + merchantCopy.name + " (ID: " + std::to_string(merchantCopy.merchantId) + 
                 ", Location: " + merchantCopy.location + ")");
@@ -339,71 +659,130 @@ namespace Game
 
     void GlobalEconomy::RemoveMerchant(uint32_t merchantId)
     {
-        auto it = m_merchants.find(merchantId);
-        if (it != m_merchants.end())
         {
-            m_merchants.erase(it);
+            std::unique_lock<std::shared_mutex> lock(ShardForMerchant(merchantId).mutex);
+            if (!GetMerchant(merchantId))
+            {
+                return;
+            }
+            if (!Journal(RemovalRecord(SaveSection::RemovedMerchant, merchantId)))
+            {
+                LOG_ERROR("Economy journal write failed; merchant " + std::to_string(merchantId) + " not removed");
+                return;
+            }
+            ApplyMerchantRemoval(merchantId);
+        }
+        WaitForJournal();
+        {
+            std::lock_guard<std::mutex> stats(m_statsMutex);
             m_stats.activeMerchants--;
-            LOG_INFO("Removed merchant ID: " + std::to_string(merchantId));
         }
+        LOG_INFO("Removed merchant ID: " + std::to_string(merchantId));
     }
 
     MerchantData* GlobalEconomy::GetMerchant(uint32_t merchantId)
     {
-        auto it = m_merchants.find(merchantId);
-        if (it != m_merchants.end())
+        auto& merchants = ShardForMerchant(merchantId).merchants;
+        auto it = merchants.find(merchantId);
+        if (it != merchants.end())
         {
             return &it->second;
         }
         return nullptr;
     }
 
+    const MerchantData* GlobalEconomy::GetMerchant(uint32_t merchantId) const
+    {
+        const auto& merchants = ShardForMerchant(merchantId).merchants;
+        auto it = merchants.find(merchantId);
+        return it != merchants.end() ? &it->second : nullptr;
+    }
+
     std::vector<MerchantData> GlobalEconomy::GetAllMerchants() const
     {
         std::vector<MerchantData> merchants;
-        for (const auto& pair : m_merchants)
+        for (const auto& shard : m_merchantShards)
         {
-            merchants.push_back(pair.second);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto& pair : shard.merchants)
+            {
+                merchants.push_back(pair.second);
+            }
         }
+
+        std::sort(merchants.begin(), merchants.end(),
+                  [](const MerchantData& a, const MerchantData& b) { return a.merchantId < b.merchantId; });
         return merchants;
     }
 
     std::vector<MerchantData> GlobalEconomy::GetMerchantsInLocation(const std::string& location) const
     {
         std::vector<MerchantData> merchants;
-        for (const auto& pair : m_merchants)
+        for (const auto& shard : m_merchantShards)
         {
-            if (pair.second.location == location)
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto& pair : shard.merchants)
             {
-                merchants.push_back(pair.second);
+                if (pair.second.location == location)
+                {
+                    merchants.push_back(pair.second);
+                }
             }
         }
+
+        std::sort(merchants.begin(), merchants.end(),
+                  [](const MerchantData& a, const MerchantData& b) { return a.merchantId < b.merchantId; });
         return merchants;
     }
 
     void GlobalEconomy::RestockMerchant(uint32_t merchantId)
     {
-        MerchantData* merchant = GetMerchant(merchantId);
-        if (!merchant || !merchant->isActive)
         {
-            return;
-        }
+            UpdateLock lock = LockForUpdate({}, merchantId);
+            MerchantData* merchant = GetMerchant(merchantId);
+            if (!merchant || !merchant->isActive)
+            {
+                return;
+            }
 
-        // Restock inventory with random items
-        for (const auto& pair : m_items)
-        {
-            const ItemData& item = pair.second;
-            if (item.isTradeable && merchant->inventory.find(item.itemId) == merchant->inventory.end())
+            // Restock inventory with random items
+            auto now = std::chrono::high_resolution_clock::now();
+            std::vector<TransactionData> restocked;
+            for (uint32_t itemId : m_catalog.GetIds())
             {
-                // Random chance to add item to merchant inventory
-                if (rand() % 100 < 30) // 30% chance
+                if (m_catalog.IsTradeable(itemId) && merchant->inventory.find(itemId) == merchant->inventory.end())
                 {
-                    merchant->inventory[item.itemId] = rand() % 5 + 1; // 1-5 quantity
+                    // Random chance to add item to merchant inventory
+                    if (rand() % 100 < 30) // 30% chance
+                    {
+                        TransactionData restock;
+                        restock.transactionId = m_nextTransactionId++;
+                        restock.merchantId = merchantId;
+                        restock.type = TransactionType::Restock;
+                        restock.itemId = itemId;
+                        restock.quantity = rand() % 5 + 1; // 1-5 quantity
+                        restock.timestamp = now;
+                        restock.isCompleted = true;
+                        restocked.push_back(restock);
+                    }
                 }
             }
+
+            if (!restocked.empty() && !CommitTransactions(restocked))
+            {
+                return;
+            }
+
+            // New stock is listed at current prices
+            merchant->lastRestock = now;
+            ScheduleRestock(merchantId, now);
+            RefreshMerchantPrices(*merchant);
         }
 
-        merchant->lastRestock = std::chrono::high_resolution_clock::now();
+        if (!WaitForJournal())
+        {
+            return;
+        }
         
         if (m_merchantRestockedCallback)
         {
@@ -415,25 +794,16 @@ namespace Game
 
     void GlobalEconomy::UpdateMerchantPrices(uint32_t merchantId)
     {
-        MerchantData* merchant = GetMerchant(merchantId);
-        if (!merchant)
-        {
-            return;
-        }
-
-        // Update buy and sell prices based on current economy
-        for (const auto& pair : merchant->inventory)
         {
-            uint32_t itemId = pair.first;
-            ItemData* item = GetItem(itemId);
-            if (item)
+            std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+            std::unique_lock<std::shared_mutex> lock(ShardForMerchant(merchantId).mutex);
+            MerchantData* merchant = GetMerchant(merchantId);
+            if (!merchant)
             {
-                uint32_t buyPrice = CalculateBuyPrice(itemId, merchantId);
-                uint32_t sellPrice = CalculateSellPrice(itemId, merchantId);
-                
-                merchant->buyPrices[itemId] = buyPrice;
-                merchant->sellPrices[itemId] = sellPrice;
+                return;
             }
+
+            RefreshMerchantPrices(*merchant);
         }
 
         LOG_DEBUG("Updated prices for merchant " + std::to_string(merchantId));
@@ -446,166 +816,151 @@ namespace Game
             return false;
         }
 
-        PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        MerchantData* merchant = GetMerchant(merchantId);
-        ItemData* item = GetItem(itemId);
-        
-        if (!player || !merchant || !item || !merchant->isActive)
-        {
-            return false;
-        }
-
-        // Check if merchant has the item
-        auto merchantIt = merchant->inventory.find(itemId);
-        if (merchantIt == merchant->inventory.end() || merchantIt->second < quantity)
+        TransactionData transaction;
         {
-            return false;
-        }
-
-        // Calculate price
-        uint32_t totalPrice = CalculateBuyPrice(itemId, merchantId) * quantity;
+            UpdateLock lock = LockForUpdate({ playerId }, merchantId);
+            PlayerEconomyData* player = GetPlayerEconomy(playerId);
+            MerchantData* merchant = GetMerchant(merchantId);
         
-        // Check if player can afford it
-        if (!CanPlayerAfford(playerId, CurrencyType::Gold, totalPrice))
-        {
-            return false;
-        }
+            if (!player || !merchant || !m_catalog.Contains(itemId) || !merchant->isActive)
+            {
+                return false;
+            }
 
-        // Check if player can carry it
-        if (!CanPlayerCarry(playerId, itemId, quantity))
-        {
-            return false;
-        }
+            // Check if merchant has the item
+            auto merchantIt = merchant->inventory.find(itemId);
+            if (merchantIt == merchant->inventory.end() || merchantIt->second < quantity)
+            {
+                return false;
+            }
 
-        // Process transaction
-        TransactionData transaction;
-        transaction.transactionId = m_nextTransactionId++;
-        transaction.playerId = playerId;
-        transaction.merchantId = merchantId;
-        transaction.type = TransactionType::Buy;
-        transaction.itemId = itemId;
-        transaction.quantity = quantity;
-        transaction.price = totalPrice;
-        transaction.currency = CurrencyType::Gold;
-        transaction.timestamp = std::chrono::high_resolution_clock::now();
-        transaction.isCompleted = false;
-
-        if (ProcessTransaction(transaction))
-        {
-            // Remove currency from player
-            RemoveCurrency(playerId, CurrencyType::Gold, totalPrice);
-            
-            // Add item to player inventory
-            AddItemToInventory(playerId, itemId, quantity);
-            
-            // Remove item from merchant inventory
-            merchantIt->second -= quantity;
-            if (merchantIt->second == 0)
+            // Calculate price
+            RefreshPriceRow(merchantId);
+            uint32_t totalPrice = QuoteBuyPrice(itemId, merchantId) * quantity;
+
+            // Check if player can afford it
+            if (!CanPlayerAfford(playerId, CurrencyType::Gold, totalPrice))
             {
-                merchant->inventory.erase(merchantIt);
+                return false;
             }
-            
-            // Add gold to merchant
-            merchant->goldAmount += totalPrice;
-            
-            transaction.isCompleted = true;
-            m_transactions.push_back(transaction);
-            m_stats.totalTransactions++;
-            
-            if (m_transactionCompletedCallback)
+
+            // Check if player can carry it
+            if (!CanPlayerCarry(playerId, itemId, quantity))
             {
-                m_transactionCompletedCallback(transaction);
+                return false;
             }
 
-            LOG_INFO("Player " + std::to_string(playerId) + " bought " + std::to_string(quantity) + 
-                    " " + item->name + " from merchant " + std::to_string(merchantId) + 
-                    " for " + std::to_string(totalPrice) + " gold");
-            return true;
-        }
+            // Process transaction
+            transaction.transactionId = m_nextTransactionId++;
+            transaction.playerId = playerId;
+            transaction.merchantId = merchantId;
+            transaction.type = TransactionType::Buy;
+            transaction.itemId = itemId;
+            transaction.quantity = quantity;
+            transaction.price = totalPrice;
+            transaction.currency = CurrencyType::Gold;
+            transaction.timestamp = std::chrono::high_resolution_clock::now();
+            transaction.isCompleted = true;
 
-        return false;
-    }
+            // Gold and items change hands in ApplyTransaction
+            if (!ProcessTransaction(transaction))
+            {
+                return false;
+            }
 
-    bool GlobalEconomy::SellItem(uint32_t playerId, uint32_t merchantId, uint32_t itemId, uint32_t quantity)
-    {
-        if (!m_tradingEnabled)
-        {
-            return false;
+            LOG_INFOF("Player {} bought {} {} from merchant {} for {} gold",
+                      playerId, quantity, m_catalog.GetName(itemId), merchantId, totalPrice);
         }
 
-        PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        MerchantData* merchant = GetMerchant(merchantId);
-        ItemData* item = GetItem(itemId);
-        
-        if (!player || !merchant || !item || !merchant->isActive)
+        if (!WaitForJournal())
         {
             return false;
         }
 
-        // Check if player has the item
-        if (GetItemQuantity(playerId, itemId) < quantity)
-        {
-            return false;
-        }
+        // Callbacks run without locks so they may call back into the economy
+        UpdatePlayerWealth(playerId);
 
-        // Check if item is sellable
-        if (!item->isSellable)
+        if (m_transactionCompletedCallback)
         {
-            return false;
+            m_transactionCompletedCallback(transaction);
         }
+        return true;
+    }
 
-        // Calculate price
-        uint32_t totalPrice = CalculateSellPrice(itemId, merchantId) * quantity;
-        
-        // Check if merchant can afford it
-        if (merchant->goldAmount < totalPrice)
+    bool GlobalEconomy::SellItem(uint32_t playerId, uint32_t merchantId, uint32_t itemId, uint32_t quantity)
+    {
+        if (!m_tradingEnabled)
         {
             return false;
         }
 
-        // Process transaction
         TransactionData transaction;
-        transaction.transactionId = m_nextTransactionId++;
-        transaction.playerId = playerId;
-        transaction.merchantId = merchantId;
-        transaction.type = TransactionType::Sell;
-        transaction.itemId = itemId;
-        transaction.quantity = quantity;
-        transaction.price = totalPrice;
-        transaction.currency = CurrencyType::Gold;
-        transaction.timestamp = std::chrono::high_resolution_clock::now();
-        transaction.isCompleted = false;
-
-        if (ProcessTransaction(transaction))
-        {
-            // Remove item from player inventory
-            RemoveItemFromInventory(playerId, itemId, quantity);
-            
-            // Add currency to player
-            AddCurrency(playerId, CurrencyType::Gold, totalPrice);
-            
-            // Add item to merchant inventory
-            merchant->inventory[itemId] += quantity;
-            
-            // Remove gold from merchant
-            merchant->goldAmount -= totalPrice;
-            
+        {
+            UpdateLock lock = LockForUpdate({ playerId }, merchantId);
+            PlayerEconomyData* player = GetPlayerEconomy(playerId);
+            MerchantData* merchant = GetMerchant(merchantId);
+        
+            if (!player || !merchant || !m_catalog.Contains(itemId) || !merchant->isActive)
+            {
+                return false;
+            }
+
+            // Check if player has the item
+            if (QuantityOf(player, itemId) < quantity)
+            {
+                return false;
+            }
+
+            // Check if item is sellable
+            if (!m_catalog.IsSellable(itemId))
+            {
+                return false;
+            }
+
+            // Calculate price
+            RefreshPriceRow(merchantId);
+            uint32_t totalPrice = QuoteSellPrice(itemId, merchantId) * quantity;
+
+            // Check if merchant can afford it
+            if (merchant->goldAmount < totalPrice)
+            {
+                return false;
+            }
+
+            // Process transaction
+            transaction.transactionId = m_nextTransactionId++;
+            transaction.playerId = playerId;
+            transaction.merchantId = merchantId;
+            transaction.type = TransactionType::Sell;
+            transaction.itemId = itemId;
+            transaction.quantity = quantity;
+            transaction.price = totalPrice;
+            transaction.currency = CurrencyType::Gold;
+            transaction.timestamp = std::chrono::high_resolution_clock::now();
             transaction.isCompleted = true;
-            m_transactions.push_back(transaction);
-            m_stats.totalTransactions++;
-            
-            if (m_transactionCompletedCallback)
+
+            // Gold and items change hands in ApplyTransaction
+            if (!ProcessTransaction(transaction))
             {
-                m_transactionCompletedCallback(transaction);
+                return false;
             }
 
-            LOG_INFO("Player " + std::to_string(playerId) + " sold " + std::to_string(quantity) + 
-                    " " + item->name + " to merchant " + std::to_string(merchantId) + 
-                    " for " + std::to_string(totalPrice) + " gold");
-            return true;
+            LOG_INFOF("Player {} sold {} {} to merchant {} for {} gold",
+                      playerId, quantity, m_catalog.GetName(itemId), merchantId, totalPrice);
+        }
+
+        if (!WaitForJournal())
+        {
+            return false;
         }
 
-        return false;
+        UpdatePlayerWealth(playerId);
+
+        if (m_transactionCompletedCallback)
+        {
+            m_transactionCompletedCallback(transaction);
+        }
+        return true;
     }
 
     bool GlobalEconomy::TradeItems(uint32_t player1Id, uint32_t player2Id, 
@@ -617,45 +972,78 @@ namespace Game
             return false;
         }
 
-        PlayerEconomyData* player1 = GetPlayerEconomy(player1Id);
-        PlayerEconomyData* player2 = GetPlayerEconomy(player2Id);
-        
-        if (!player1 || !player2)
-        {
-            return false;
-        }
-
-        // Validate trade
-        for (const auto& pair : items1)
+        // Both players' shards, locked in shard order whichever side started the trade
         {
-            if (GetItemQuantity(player1Id, pair.first) < pair.second)
+            UpdateLock lock = LockForUpdate({ player1Id, player2Id });
+            PlayerEconomyData* player1 = GetPlayerEconomy(player1Id);
+            PlayerEconomyData* player2 = GetPlayerEconomy(player2Id);
+        
+            if (!player1 || !player2)
             {
                 return false;
             }
-        }
+
+            // Validate trade
+            for (const auto& pair : items1)
+            {
+                if (QuantityOf(player1, pair.first) < pair.second)
+                {
+                    return false;
+                }
+            }
         
-        for (const auto& pair : items2)
-        {
-            if (GetItemQuantity(player2Id, pair.first) < pair.second)
+            for (const auto& pair : items2)
+            {
+                if (QuantityOf(player2, pair.first) < pair.second)
+                {
+                    return false;
+                }
+            }
+
+            // Each side must be able to carry what it ends up with
+            uint64_t weight1 = WeightOf(items1);
+            uint64_t weight2 = WeightOf(items2);
+            if ((weight2 > weight1 && player1->totalWeight + weight2 - weight1 > player1->maxWeight) ||
+                (weight1 > weight2 && player2->totalWeight + weight1 - weight2 > player2->maxWeight))
             {
                 return false;
             }
-        }
 
-        // Process trade
-        for (const auto& pair : items1)
-        {
-            RemoveItemFromInventory(player1Id, pair.first, pair.second);
-            AddItemToInventory(player2Id, pair.first, pair.second);
+            // Process trade; both directions are journaled together so a crash
+            // cannot leave only one side done
+            auto now = std::chrono::high_resolution_clock::now();
+            std::vector<TransactionData> transfers;
+            auto addTransfers = [&](uint32_t fromId, uint32_t toId, const std::map<uint32_t, uint32_t>& items)
+            {
+                for (const auto& pair : items)
+                {
+                    TransactionData transfer;
+                    transfer.transactionId = m_nextTransactionId++;
+                    transfer.playerId = fromId;
+                    transfer.recipientId = toId;
+                    transfer.type = TransactionType::Trade;
+                    transfer.itemId = pair.first;
+                    transfer.quantity = pair.second;
+                    transfer.timestamp = now;
+                    transfer.isCompleted = true;
+                    transfers.push_back(transfer);
+                }
+            };
+            addTransfers(player1Id, player2Id, items1);
+            addTransfers(player2Id, player1Id, items2);
+
+            if (!CommitTransactions(transfers))
+            {
+                return false;
+            }
+
+            LOG_INFOF("Players {} and {} traded items", player1Id, player2Id);
         }
-        
-        for (const auto& pair : items2)
+
+        if (!WaitForJournal())
         {
-            RemoveItemFromInventory(player2Id, pair.first, pair.second);
-            AddItemToInventory(player1Id, pair.first, pair.second);
+            return false;
         }
-
-        LOG_INFO("Players " + std::to_string(player1Id) + " and " + std::to_string(player2Id) + " traded items");
         return true;
     }
 
@@ -666,119 +1054,110 @@ namespace Game
             return false;
         }
 
-        PlayerEconomyData* fromPlayer = GetPlayerEconomy(fromPlayerId);
-        PlayerEconomyData* toPlayer = GetPlayerEconomy(toPlayerId);
-        
-        if (!fromPlayer || !toPlayer)
         {
-            return false;
-        }
+            UpdateLock lock = LockForUpdate({ fromPlayerId, toPlayerId });
+            PlayerEconomyData* fromPlayer = GetPlayerEconomy(fromPlayerId);
+            PlayerEconomyData* toPlayer = GetPlayerEconomy(toPlayerId);
+        
+            if (!fromPlayer || !toPlayer)
+            {
+                return false;
+            }
 
-        // Check if from player has the item
-        if (GetItemQuantity(fromPlayerId, itemId) < quantity)
-        {
-            return false;
+            // Check if from player has the item
+            if (QuantityOf(fromPlayer, itemId) < quantity)
+            {
+                return false;
+            }
+
+            // Check if to player can carry it
+            if (!CanPlayerCarry(toPlayerId, itemId, quantity))
+            {
+                return false;
+            }
+
+            // Process gift
+            TransactionData gift;
+            gift.transactionId = m_nextTransactionId++;
+            gift.playerId = fromPlayerId;
+            gift.recipientId = toPlayerId;
+            gift.type = TransactionType::Gift;
+            gift.itemId = itemId;
+            gift.quantity = quantity;
+            gift.timestamp = std::chrono::high_resolution_clock::now();
+            gift.isCompleted = true;
+            if (!CommitTransactions({ gift }))
+            {
+                return false;
+            }
+
+            LOG_INFOF("Player {} gifted {} {} to player {}", fromPlayerId, quantity, itemId, toPlayerId);
         }
 
-        // Check if to player can carry it
-        if (!CanPlayerCarry(toPlayerId, itemId, quantity))
+        if (!WaitForJournal())
         {
             return false;
         }
-
-        // Process gift
-        RemoveItemFromInventory(fromPlayerId, itemId, quantity);
-        AddItemToInventory(toPlayerId, itemId, quantity);
-
-        LOG_INFO("Player " + std::to_string(fromPlayerId) + " gifted " + std::to_string(quantity) + 
-                " " + std::to_string(itemId) + " to player " + std::to_string(toPlayerId));
         return true;
     }
 
     uint32_t GlobalEconomy::CalculateBuyPrice(uint32_t itemId, uint32_t merchantId) const
     {
-        const ItemData* item = GetItem(itemId);
-        const MerchantData* merchant = GetMerchant(merchantId);
-        
-        if (!item || !merchant)
-        {
-            return 0;
-        }
-
-        // Check if merchant has specific price
-        auto it = merchant->buyPrices.find(itemId);
-        if (it != merchant->buyPrices.end())
         {
-            return it->second;
+            std::shared_lock<std::shared_mutex> lock(ShardForMerchant(merchantId).mutex);
+            const PriceRow* row = CurrentPriceRow(merchantId);
+            if (row && itemId < row->buy.size())
+            {
+                return row->buy[itemId];
+            }
         }
 
-        // Calculate base price
-        uint32_t basePrice = CalculateBasePrice(itemId);
-        
-        // Apply merchant multiplier
-        float merchantMultiplier = GetMerchantMultiplier(merchantId);
-        
-        return static_cast<uint32_t>(basePrice * merchantMultiplier);
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+        std::shared_lock<std::shared_mutex> lock(ShardForMerchant(merchantId).mutex);
+        return QuoteBuyPrice(itemId, merchantId);
     }
 
     uint32_t GlobalEconomy::CalculateSellPrice(uint32_t itemId, uint32_t merchantId) const
     {
-        const ItemData* item = GetItem(itemId);
-        const MerchantData* merchant = GetMerchant(merchantId);
-        
-        if (!item || !merchant)
-        {
-            return 0;
-        }
-
-        // Check if merchant has specific price
-        auto it = merchant->sellPrices.find(itemId);
-        if (it != merchant->sellPrices.end())
         {
-            return it->second;
+            std::shared_lock<std::shared_mutex> lock(ShardForMerchant(merchantId).mutex);
+            const PriceRow* row = CurrentPriceRow(merchantId);
+            if (row && itemId < row->sell.size())
+            {
+                return row->sell[itemId];
+            }
         }
 
-        // Calculate base price (usually 50% of buy price)
-        uint32_t basePrice = CalculateBasePrice(itemId);
-        
-        // Apply merchant multiplier and sell discount
-        float merchantMultiplier = GetMerchantMultiplier(merchantId);
-        float sellDiscount = 0.5f; // 50% of buy price
-        
-        return static_cast<uint32_t>(basePrice * merchantMultiplier * sellDiscount);
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+        std::shared_lock<std::shared_mutex> lock(ShardForMerchant(merchantId).mutex);
+        return QuoteSellPrice(itemId, merchantId);
     }
 
     uint32_t GlobalEconomy::CalculateItemValue(uint32_t itemId) const
     {
-        const ItemData* item = GetItem(itemId);
-        if (!item)
-        {
-            return 0;
-        }
-
-        return item->value;
+        std::shared_lock<std::shared_mutex> catalog(m_catalogMutex);
+        return CalculateBasePrice(itemId);
     }
 
     void GlobalEconomy::UpdateItemPrices()
     {
-        // Update all item prices based on inflation
-        for (auto& pair : m_items)
         {
-            ItemData& item = pair.second;
-            item.value = static_cast<uint32_t>(item.value * (1.0f + m_inflationRate));
-            
-            // Update currency prices
-            for (auto& pricePair : item.prices)
+            GlobalLock lock = LockEverything();
+
+            // Update all item values and currency prices based on inflation
+            float factor = 1.0f + m_inflationRate;
+            BinaryWriter record;
+            size_t section = record.BeginSection(static_cast<uint32_t>(SaveSection::ItemValueScale), 1);
+            record.WriteFloat(factor);
+            record.EndSection(section);
+            if (!Journal(record))
             {
-                pricePair.second = static_cast<uint32_t>(pricePair.second * (1.0f + m_inflationRate));
+                LOG_ERROR("Economy journal write failed; item prices not updated");
+                return;
             }
+            ApplyValueScale(factor);
         }
-
-        // Update merchant prices
-        for (auto& pair : m_merchants)
-        {
-            UpdateMerchantPrices(pair.first);
-        }
+        WaitForJournal();
 
         LOG_DEBUG("Updated all item prices with inflation rate: " + std::to_string(m_inflationRate));
     }
@@ -799,257 +1178,1255 @@ namespace Game
         }
 
         auto now = std::chrono::high_resolution_clock::now();
-        
-        // Check if it's time to restock merchants
-        float timeSinceLastRestock = std::chrono::duration<float>(now - m_lastRestockTime).count();
-        if (timeSinceLastRestock >= m_merchantRestockInterval)
+
+        // Restock the merchants that are due, within this update's budget
+        for (uint32_t merchantId : TakeDueRestocks(now))
         {
-            for (auto& pair : m_merchants)
-            {
-                RestockMerchant(pair.first);
-            }
-            m_lastRestockTime = now;
+            RestockMerchant(merchantId);
         }
         
-        // Update economy statistics
-        UpdateEconomyStats();
-        
         // Check economy health
         CheckEconomyHealth();
         
         // Cleanup old transactions
         CleanupOldTransactions();
+
+        // Snapshot so the journal stays short and recovery stays fast
+        bool snapshotDue;
+        {
+            std::lock_guard<std::mutex> lock(m_snapshotMutex);
+            snapshotDue = std::chrono::duration<float>(now - m_lastSnapshotTime).count() >= m_snapshotInterval;
+        }
+        if (m_journal.IsOpen() && snapshotDue)
+        {
+            SaveEconomyState();
+        }
         
         m_lastUpdateTime = now;
     }
 
-    void GlobalEconomy::RebalanceEconomy()
+    void GlobalEconomy::RebalanceEconomy()
+    {
+        {
+            std::unique_lock<std::shared_mutex> catalog(m_catalogMutex);
+        
+            // Base prices are the catalog values; rebuild what derives from them
+            InvalidatePrices();
+
+            // Update merchant prices
+            for (auto& shard : m_merchantShards)
+            {
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                for (auto& pair : shard.merchants)
+                {
+                    RefreshMerchantPrices(pair.second);
+                }
+            }
+
+            // Item values moved, and with them every player's wealth
+            for (auto& shard : m_playerShards)
+            {
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                RefreshWealth(shard);
+            }
+        }
+        
+        LOG_INFO("Economy rebalanced");
+    }
+
+    void GlobalEconomy::ResetEconomy()
+    {
+        {
+            GlobalLock lock = LockEverything();
+
+            // Reset all player currencies to default
+            for (auto& shard : m_playerShards)
+            {
+                for (auto& pair : shard.players)
+                {
+                    PlayerEconomyData& player = pair.second;
+                    player.currencies[CurrencyType::Gold] = 100;
+                    player.currencies[CurrencyType::Silver] = 0;
+                    player.currencies[CurrencyType::Copper] = 0;
+                    player.inventory.clear();
+                    player.totalWeight = 0;
+                }
+            }
+
+            // Reset all merchant inventories
+            for (auto& shard : m_merchantShards)
+            {
+                for (auto& pair : shard.merchants)
+                {
+                    MerchantData& merchant = pair.second;
+                    merchant.inventory.clear();
+                    merchant.goldAmount = 1000;
+                }
+            }
+
+            RebuildShardTotals();
+
+            // Clear transaction history
+            std::lock_guard<std::mutex> stats(m_statsMutex);
+            m_transactions.clear();
+        }
+
+        // The journal cannot express a reset, so a snapshot replaces it
+        if (m_journal.IsOpen())
+        {
+            SaveEconomyState();
+        }
+        
+        LOG_INFO("Economy reset");
+    }
+
+    void GlobalEconomy::SetStateDirectory(const std::string& directory)
+    {
+        m_stateDirectory = directory;
+    }
+
+    void GlobalEconomy::SetJournalOptions(const WriteAheadLogOptions& options)
+    {
+        m_journalOptions = options;
+    }
+
+    void GlobalEconomy::SetSnapshotInterval(float interval)
+    {
+        m_snapshotInterval = std::max(1.0f, interval);
+    }
+
+    bool GlobalEconomy::SaveEconomyState()
+    {
+        if (m_stateDirectory.empty())
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> snapshotLock(m_snapshotMutex);
+
+        // Copy the state under every lock, then encode and write it without
+        // holding up trades. Writers journal and apply under their shard
+        // locks, so everything journaled so far is in the copy.
+        uint64_t sequence;
+        uint32_t nextItemId;
+        std::map<uint32_t, ItemData> items;
+        std::map<uint32_t, MerchantData> merchants;
+        std::map<uint32_t, PlayerEconomyData> players;
+        std::vector<TransactionData> transactions;
+        {
+            GlobalLock lock = LockEverything();
+            sequence = m_journal.GetLastSequence();
+            nextItemId = m_nextItemId;
+            for (uint32_t itemId : m_catalog.GetIds())
+            {
+                items.emplace(itemId, *m_catalog.Get(itemId));
+            }
+            for (const auto& shard : m_playerShards)
+            {
+                players.insert(shard.players.begin(), shard.players.end());
+            }
+            for (const auto& shard : m_merchantShards)
+            {
+                merchants.insert(shard.merchants.begin(), shard.merchants.end());
+            }
+
+            std::lock_guard<std::mutex> stats(m_statsMutex);
+            transactions = m_transactions;
+        }
+
+        BinaryWriter out;
+        size_t header = out.BeginRecord();
+        out.WriteVarUInt(SnapshotVersion);
+        out.WriteVarUInt(sequence);
+        out.WriteVarUInt(nextItemId);
+        out.WriteVarUInt(m_nextMerchantId.load());
+        out.WriteVarUInt(m_nextTransactionId.load());
+        out.EndRecord(header);
+        SaveSerialization::WriteItems(out, items);
+        SaveSerialization::WriteMerchants(out, merchants);
+        SaveSerialization::WriteEconomy(out, players);
+        SaveSerialization::WriteTransactions(out, transactions);
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_stateDirectory, ec);
+        if (!WriteFileDurably(GetSnapshotPath(), out.GetBuffer()))
+        {
+            LOG_ERROR("Failed to write economy snapshot " + GetSnapshotPath());
+            return false;
+        }
+
+        m_snapshotSequence = sequence;
+        m_lastSnapshotTime = std::chrono::high_resolution_clock::now();
+
+        // A crash before this point replays records the snapshot already has;
+        // replay skips them by sequence
+        if (m_journal.IsOpen() && !m_journal.Truncate(sequence))
+        {
+            LOG_WARNING("Failed to truncate economy journal " + GetJournalPath());
+        }
+
+        LOG_DEBUG("Economy state saved at journal sequence " + std::to_string(sequence));
+        return true;
+    }
+
+    bool GlobalEconomy::LoadEconomyState()
+    {
+        if (m_stateDirectory.empty())
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> snapshotLock(m_snapshotMutex);
+        GlobalLock lock = LockEverything();
+        m_journal.Close();
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_stateDirectory, ec);
+
+        // No snapshot yet means a fresh economy; the journal may still hold changes
+        m_snapshotSequence = 0;
+        m_replayFailed = false;
+        std::vector<uint8_t> snapshot;
+        if (ReadWholeFile(GetSnapshotPath(), snapshot))
+        {
+            BinaryReader in(snapshot);
+            BinaryReader header = in.ReadRecord();
+            uint32_t version = header.ReadVarUInt32();
+            uint64_t sequence = header.ReadVarUInt();
+            uint32_t nextItemId = header.ReadVarUInt32();
+            uint32_t nextMerchantId = header.ReadVarUInt32();
+            uint32_t nextTransactionId = header.ReadVarUInt32();
+
+            std::map<uint32_t, ItemData> items;
+            std::map<uint32_t, MerchantData> merchants;
+            std::map<uint32_t, PlayerEconomyData> players;
+            std::vector<TransactionData> transactions;
+            if (!header.IsValid() || version > SnapshotVersion ||
+                !SaveSerialization::ReadItems(in, items) ||
+                !SaveSerialization::ReadMerchants(in, merchants) ||
+                !SaveSerialization::ReadEconomy(in, players) ||
+                !SaveSerialization::ReadTransactions(in, transactions))
+            {
+                LOG_ERROR("Economy snapshot " + GetSnapshotPath() + " is damaged");
+                return false;
+            }
+
+            ClearAll();
+            for (auto& pair : items)
+            {
+                pair.second.itemId = pair.first;
+                m_catalog.Set(pair.second);
+            }
+            for (auto& pair : merchants)
+            {
+                // Overdue merchants restock over the next updates, within the budget
+                ScheduleRestock(pair.first, pair.second.lastRestock);
+                ShardForMerchant(pair.first).merchants.emplace(pair.first, std::move(pair.second));
+            }
+            for (auto& pair : players)
+            {
+                ShardForPlayer(pair.first).players.emplace(pair.first, std::move(pair.second));
+            }
+            {
+                std::lock_guard<std::mutex> stats(m_statsMutex);
+                m_transactions = std::move(transactions);
+            }
+            m_nextItemId = nextItemId;
+            m_nextMerchantId = nextMerchantId;
+            m_nextTransactionId = nextTransactionId;
+            m_snapshotSequence = sequence;
+        }
+
+        if (!m_journal.Open(GetJournalPath(), m_journalOptions,
+                [this](uint64_t sequence, const uint8_t* data, size_t size) { ReplayJournalRecord(sequence, data, size); }))
+        {
+            LOG_ERROR("Failed to open economy journal " + GetJournalPath());
+            return false;
+        }
+        if (m_replayFailed)
+        {
+            m_journal.Close();
+            LOG_ERROR("Economy journal " + GetJournalPath() + " does not match the snapshot; recovery stopped");
+            return false;
+        }
+
+        RebuildShardTotals();
+        InvalidatePrices();
+
+        size_t playerCount = 0;
+        size_t merchantCount = 0;
+        for (const auto& shard : m_playerShards)
+        {
+            playerCount += shard.players.size();
+        }
+        for (const auto& shard : m_merchantShards)
+        {
+            merchantCount += shard.merchants.size();
+        }
+        {
+            // Trade counters restart from the recovered history
+            std::lock_guard<std::mutex> stats(m_statsMutex);
+            m_stats.totalItems = static_cast<uint32_t>(m_catalog.Size());
+            m_stats.activeMerchants = static_cast<uint32_t>(merchantCount);
+            m_stats.totalTransactions = 0;
+            m_stats.averageTransactionValue = 0.0f;
+            m_stats.mostTradedItem = 0;
+            m_tradedValue = 0;
+            m_tradeCounts.clear();
+            for (const auto& transaction : m_transactions)
+            {
+                CountTradedTransaction(transaction);
+            }
+        }
+        m_lastSnapshotTime = std::chrono::high_resolution_clock::now();
+
+        WriteAheadLogStats journal = m_journal.GetStats();
+        LOG_INFO("Economy state loaded: " + std::to_string(playerCount) + " players, " +
+                 std::to_string(journal.recordsReplayed) + " journal records replayed");
+        return true;
+    }
+
+    bool GlobalEconomy::IsJournaling() const
+    {
+        return m_journal.IsOpen();
+    }
+
+    bool GlobalEconomy::FlushJournal()
+    {
+        return !m_journal.IsOpen() || m_journal.Sync();
+    }
+
+    WriteAheadLogStats GlobalEconomy::GetJournalStats() const
+    {
+        return m_journal.GetStats();
+    }
+
+    // Configuration methods
+    void GlobalEconomy::SetInflationRate(float rate)
+    {
+        m_inflationRate = std::max(0.0f, std::min(1.0f, rate));
+    }
+
+    void GlobalEconomy::SetMaxPlayerWeight(uint32_t maxWeight)
+    {
+        m_maxPlayerWeight = maxWeight;
+    }
+
+    void GlobalEconomy::SetMerchantRestockInterval(float interval)
+    {
+        {
+            std::lock_guard<std::mutex> restock(m_restockMutex);
+            m_merchantRestockInterval = std::max(60.0f, interval);
+        }
+
+        // Every merchant's next restock moves with the interval
+        for (auto& shard : m_merchantShards)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto& pair : shard.merchants)
+            {
+                ScheduleRestock(pair.first, pair.second.lastRestock);
+            }
+        }
+    }
+
+    void GlobalEconomy::SetRestockBudget(uint32_t merchantsPerUpdate)
+    {
+        std::lock_guard<std::mutex> restock(m_restockMutex);
+        m_restockBudget = std::max(1u, merchantsPerUpdate);
+    }
+
+    std::optional<std::chrono::high_resolution_clock::time_point> GlobalEconomy::GetNextRestockTime(uint32_t merchantId) const
+    {
+        std::lock_guard<std::mutex> restock(m_restockMutex);
+        const auto* due = m_restockQueue.Find(merchantId);
+        if (!due)
+        {
+            return std::nullopt;
+        }
+        return *due;
+    }
+
+    void GlobalEconomy::EnableTrading(bool enable)
+    {
+        m_tradingEnabled = enable;
+    }
+
+    void GlobalEconomy::EnableGifting(bool enable)
+    {
+        m_giftingEnabled = enable;
+    }
+
+    EconomyStats GlobalEconomy::GetStats() const
+    {
+        EconomyStats stats;
+        {
+            std::lock_guard<std::mutex> lock(m_statsMutex);
+            stats = m_stats;
+        }
+
+        // Gauges merge the per-shard totals: one step per shard, not per player
+        int64_t circulation = 0;
+        uint64_t richestWealth = 0;
+        stats.richestPlayer = 0;
+        for (const auto& shard : m_playerShards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            circulation += shard.gold;
+            if (!shard.wealth.Empty() &&
+                (stats.richestPlayer == 0 || shard.wealth.TopValue() > richestWealth ||
+                 (shard.wealth.TopValue() == richestWealth && shard.wealth.TopKey() < stats.richestPlayer)))
+            {
+                stats.richestPlayer = shard.wealth.TopKey();
+                richestWealth = shard.wealth.TopValue();
+            }
+        }
+        for (const auto& shard : m_merchantShards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            circulation += shard.gold;
+        }
+        stats.totalGoldCirculation = static_cast<uint32_t>(std::max<int64_t>(0, circulation));
+        return stats;
+    }
+
+    void GlobalEconomy::ResetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+
+        // Catalog and merchant counts describe the current state, not a period
+        uint32_t totalItems = m_stats.totalItems;
+        uint32_t activeMerchants = m_stats.activeMerchants;
+        m_stats.Reset();
+        m_stats.totalItems = totalItems;
+        m_stats.activeMerchants = activeMerchants;
+        m_tradedValue = 0;
+        m_tradeCounts.clear();
+    }
+
+    uint64_t GlobalEconomy::GetPlayerWealth(uint32_t playerId) const
+    {
+        const PlayerShard& shard = ShardForPlayer(playerId);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        const uint64_t* wealth = shard.wealth.Find(playerId);
+        return wealth ? *wealth : 0;
+    }
+
+    std::vector<std::pair<uint32_t, uint64_t>> GlobalEconomy::GetTopWealthyPlayers(size_t count) const
+    {
+        // The overall top count is among the top count of each shard
+        std::vector<std::pair<uint32_t, uint64_t>> top;
+        for (const auto& shard : m_playerShards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            std::vector<std::pair<uint32_t, uint64_t>> shardTop = shard.wealth.Top(count);
+            top.insert(top.end(), shardTop.begin(), shardTop.end());
+        }
+
+        size_t kept = std::min(count, top.size());
+        std::partial_sort(top.begin(), top.begin() + kept, top.end(),
+                          [](const std::pair<uint32_t, uint64_t>& a, const std::pair<uint32_t, uint64_t>& b)
+                          {
+                              return a.second > b.second || (a.second == b.second && a.first < b.first);
+                          });
+        top.resize(kept);
+        return top;
+    }
+
+    void GlobalEconomy::RecalculateStats()
+    {
+        GlobalLock lock = LockEverything();
+        RebuildShardTotals();
+    }
+
+    void GlobalEconomy::PrintStats() const
+    {
+        EconomyStats stats = GetStats();
+        LOG_INFO("=== Global Economy Statistics ===");
+        LOG_INFO("Total transactions: " + std::to_string(stats.totalTransactions));
+        LOG_INFO("Total gold circulation: " + std::to_string(stats.totalGoldCirculation));
+        LOG_INFO("Active merchants: " + std::to_string(stats.activeMerchants));
+        LOG_INFO("Total items: " + std::to_string(stats.totalItems));
+        LOG_INFO("Average transaction value: " + std::to_string(stats.averageTransactionValue));
+        LOG_INFO("Inflation rate: " + std::to_string(stats.inflationRate * 100.0f) + "%");
+        LOG_INFO("Most traded item: " + std::to_string(stats.mostTradedItem));
+        LOG_INFO("Richest player: " + std::to_string(stats.richestPlayer));
+        LOG_INFO("=================================");
+    }
+
+    void GlobalEconomy::CollectMetrics(MetricsWriter& out) const
+    {
+        EconomyStats stats = GetStats();
+        out.Counter("tw3_economy_transactions_total", "Completed transactions", static_cast<double>(stats.totalTransactions));
+        out.Gauge("tw3_economy_gold_circulation", "Gold currently held by players and merchants", static_cast<double>(stats.totalGoldCirculation));
+        out.Gauge("tw3_economy_merchants_active", "Active merchants", static_cast<double>(stats.activeMerchants));
+        out.Gauge("tw3_economy_items", "Items in the catalog", static_cast<double>(stats.totalItems));
+        out.Gauge("tw3_economy_transaction_value_average", "Average transaction value in gold", stats.averageTransactionValue);
+        out.Gauge("tw3_economy_inflation_rate", "Current inflation rate", stats.inflationRate);
+
+        WriteAheadLogStats journal = m_journal.GetStats();
+        out.Counter("tw3_economy_journal_records_total", "Transaction groups written to the economy journal", static_cast<double>(journal.recordsAppended));
+        out.Counter("tw3_economy_journal_commits_total", "Group commits (fsyncs) of the economy journal", static_cast<double>(journal.commits));
+        out.Gauge("tw3_economy_journal_bytes", "Size of the economy journal file", static_cast<double>(m_journal.GetFileSize()));
+    }
+
+    // Callback setters
+    void GlobalEconomy::SetTransactionCompletedCallback(TransactionCompletedCallback callback)
+    {
+        m_transactionCompletedCallback = callback;
+    }
+
+    void GlobalEconomy::SetPlayerWealthChangedCallback(PlayerWealthChangedCallback callback)
+    {
+        m_playerWealthChangedCallback = callback;
+    }
+
+    void GlobalEconomy::SetMerchantRestockedCallback(MerchantRestockedCallback callback)
+    {
+        m_merchantRestockedCallback = callback;
+    }
+
+    void GlobalEconomy::SetEconomyCrashedCallback(EconomyCrashedCallback callback)
+    {
+        m_economyCrashedCallback = callback;
+    }
+
+    // Private methods
+    void GlobalEconomy::InitializeDefaultItems()
+    {
+        // Create some default items
+        ItemData sword = EconomyUtils::CreateWeapon("Iron Sword", ItemRarity::Common, 50, 10);
+        AddItem(sword);
+        
+        ItemData armor = EconomyUtils::CreateArmor("Leather Armor", ItemRarity::Common, 30, 15);
+        AddItem(armor);
+        
+        ItemData potion = EconomyUtils::CreateConsumable("Health Potion", ItemRarity::Common, 10, 1);
+        AddItem(potion);
+        
+        ItemData ore = EconomyUtils::CreateMaterial("Iron Ore", ItemRarity::Common, 5, 2);
+        AddItem(ore);
+    }
+
+    void GlobalEconomy::InitializeDefaultMerchants()
+    {
+        // Create some default merchants
+        MerchantData weaponMerchant = EconomyUtils::CreateWeaponMerchant("Blacksmith", "Novigrad");
+        AddMerchant(weaponMerchant);
+        
+        MerchantData armorMerchant = EconomyUtils::CreateArmorMerchant("Armorer", "Oxenfurt");
+        AddMerchant(armorMerchant);
+        
+        MerchantData generalMerchant = EconomyUtils::CreateGeneralMerchant("Trader", "Velen");
+        AddMerchant(generalMerchant);
+    }
+
+    bool GlobalEconomy::ValidateTransaction(const TransactionData& transaction) const
+    {
+        return transaction.playerId != 0 && transaction.merchantId != 0 && 
+               transaction.itemId != 0 && transaction.quantity > 0;
+    }
+
+    bool GlobalEconomy::ProcessTransaction(const TransactionData& transaction)
+    {
+        if (!ValidateTransaction(transaction))
+        {
+            return false;
+        }
+
+        return CommitTransactions({ transaction });
+    }
+
+    bool GlobalEconomy::CommitTransactions(const std::vector<TransactionData>& transactions)
+    {
+        if (m_journal.IsOpen())
+        {
+            BinaryWriter out;
+            SaveSerialization::WriteTransactions(out, transactions);
+            if (!Journal(out))
+            {
+                LOG_ERROR("Economy journal write failed; transaction rejected");
+                return false;
+            }
+        }
+
+        ApplyTransactions(transactions);
+        return true;
+    }
+
+    bool GlobalEconomy::Journal(const BinaryWriter& record)
+    {
+        return !m_journal.IsOpen() || m_journal.Append(record.GetBuffer().data(), record.GetSize()) != 0;
+    }
+
+    bool GlobalEconomy::WaitForJournal()
+    {
+        // Everything journaled so far includes the caller's records
+        if (m_journal.IsOpen() && !m_journal.WaitDurable(m_journal.GetLastSequence()))
+        {
+            LOG_ERROR("Economy journal commit failed; recent changes may not survive a crash");
+            return false;
+        }
+        return true;
+    }
+
+    void GlobalEconomy::ApplyTransactions(const std::vector<TransactionData>& transactions)
+    {
+        std::vector<uint32_t> players;
+        size_t index = 0;
+        while (index < transactions.size())
+        {
+            const TransactionData& transaction = transactions[index];
+            size_t end = index + 1;
+            if (IsItemMove(transaction))
+            {
+                while (end < transactions.size() && IsItemMove(transactions[end]) &&
+                       SameParties(transactions[end], transaction))
+                {
+                    ++end;
+                }
+            }
+
+            if (end - index > 1)
+            {
+                ApplyItemMoves(&transaction, &transaction + (end - index));
+            }
+            else
+            {
+                ApplyTransaction(transaction);
+            }
+
+            if (transaction.type != TransactionType::Restock)
+            {
+                players.push_back(transaction.playerId);
+            }
+            if (transaction.type == TransactionType::Trade || transaction.type == TransactionType::Gift)
+            {
+                players.push_back(transaction.recipientId);
+            }
+            index = end;
+        }
+
+        // Wealth follows every balance and inventory change
+        std::sort(players.begin(), players.end());
+        players.erase(std::unique(players.begin(), players.end()), players.end());
+        for (uint32_t playerId : players)
+        {
+            PlayerShard& shard = ShardForPlayer(playerId);
+            shard.wealth.Set(playerId, CalculatePlayerWealth(shard.players[playerId]));
+        }
+    }
+
+    void GlobalEconomy::ApplyItemMoves(const TransactionData* first, const TransactionData* last)
+    {
+        // Sorted by item so the recipient's inventory takes them in one merge
+        std::vector<std::pair<uint32_t, uint32_t>> items;
+        items.reserve(last - first);
+        for (const TransactionData* transaction = first; transaction != last; ++transaction)
+        {
+            AdvancePast(m_nextTransactionId, transaction->transactionId);
+            items.emplace_back(transaction->itemId, transaction->quantity);
+        }
+        std::sort(items.begin(), items.end());
+
+        // The recipient gets the full quantities, exactly as one move at a time would
+        uint32_t recipientId = first->playerId;
+        if (first->type == TransactionType::Trade)
+        {
+            PlayerEconomyData& from = TouchPlayer(first->playerId);
+            for (const auto& item : items)
+            {
+                auto it = from.inventory.find(item.first);
+                if (it != from.inventory.end())
+                {
+                    uint32_t taken = std::min(it->second, item.second);
+                    it->second -= taken;
+                    from.totalWeight -= std::min(from.totalWeight, m_catalog.GetWeight(item.first) * taken);
+                }
+            }
+            from.inventory.EraseIf([](const auto& entry) { return entry.second == 0; });
+            recipientId = first->recipientId;
+        }
+
+        PlayerEconomyData& to = TouchPlayer(recipientId);
+        to.inventory.AddSorted(items.begin(), items.end());
+        for (const auto& item : items)
+        {
+            to.totalWeight += m_catalog.GetWeight(item.first) * item.second;
+        }
+    }
+
+    PlayerEconomyData& GlobalEconomy::TouchPlayer(uint32_t playerId)
+    {
+        PlayerEconomyData& player = ShardForPlayer(playerId).players[playerId];
+        player.playerId = playerId;
+        player.lastUpdate = std::chrono::high_resolution_clock::now();
+        return player;
+    }
+
+    void GlobalEconomy::ApplyTransaction(const TransactionData& transaction)
+    {
+        AdvancePast(m_nextTransactionId, transaction.transactionId);
+
+        auto playerFor = [this](uint32_t playerId) -> PlayerEconomyData&
+        {
+            return TouchPlayer(playerId);
+        };
+        auto giveItems = [this](PlayerEconomyData& player, uint32_t itemId, uint32_t quantity)
+        {
+            player.inventory[itemId] += quantity;
+            player.totalWeight += m_catalog.GetWeight(itemId) * quantity;
+        };
+        auto takeItems = [this](PlayerEconomyData& player, uint32_t itemId, uint32_t quantity)
+        {
+            uint32_t taken = TakeFromStock(player.inventory, itemId, quantity);
+            player.totalWeight -= std::min(player.totalWeight, m_catalog.GetWeight(itemId) * taken);
+        };
+        // Shard gold totals follow every gold balance change
+        auto addPlayerGold = [&](int64_t amount)
+        {
+            if (transaction.currency == CurrencyType::Gold)
+            {
+                ShardForPlayer(transaction.playerId).gold += amount;
+            }
+        };
+        MerchantData* merchant = GetMerchant(transaction.merchantId);
+        int64_t& merchantGold = ShardForMerchant(transaction.merchantId).gold;
+
+        switch (transaction.type)
+        {
+            case TransactionType::Buy:
+            {
+                PlayerEconomyData& player = playerFor(transaction.playerId);
+                addPlayerGold(-static_cast<int64_t>(TakeCurrency(player, transaction.currency, transaction.price)));
+                giveItems(player, transaction.itemId, transaction.quantity);
+                if (merchant)
+                {
+                    TakeFromStock(merchant->inventory, transaction.itemId, transaction.quantity);
+                    merchant->goldAmount += transaction.price;
+                    merchantGold += transaction.price;
+                }
+                break;
+            }
+            case TransactionType::Sell:
+            {
+                PlayerEconomyData& player = playerFor(transaction.playerId);
+                takeItems(player, transaction.itemId, transaction.quantity);
+                player.currencies[transaction.currency] += transaction.price;
+                addPlayerGold(transaction.price);
+                if (merchant)
+                {
+                    merchant->inventory[transaction.itemId] += transaction.quantity;
+                    uint32_t paid = std::min(merchant->goldAmount, transaction.price);
+                    merchant->goldAmount -= paid;
+                    merchantGold -= paid;
+                }
+                break;
+            }
+            case TransactionType::Trade:
+            case TransactionType::Gift:
+                takeItems(playerFor(transaction.playerId), transaction.itemId, transaction.quantity);
+                giveItems(playerFor(transaction.recipientId), transaction.itemId, transaction.quantity);
+                break;
+            case TransactionType::Loot:
+            {
+                PlayerEconomyData& player = playerFor(transaction.playerId);
+                if (transaction.price != 0)
+                {
+                    player.currencies[transaction.currency] += transaction.price;
+                    addPlayerGold(transaction.price);
+                }
+                if (transaction.itemId != 0)
+                {
+                    giveItems(player, transaction.itemId, transaction.quantity);
+                }
+                break;
+            }
+            case TransactionType::Spend:
+            {
+                PlayerEconomyData& player = playerFor(transaction.playerId);
+                if (transaction.price != 0)
+                {
+                    addPlayerGold(-static_cast<int64_t>(TakeCurrency(player, transaction.currency, transaction.price)));
+                }
+                if (transaction.itemId != 0)
+                {
+                    takeItems(player, transaction.itemId, transaction.quantity);
+                }
+                break;
+            }
+            case TransactionType::Restock:
+                if (merchant)
+                {
+                    merchant->inventory[transaction.itemId] += transaction.quantity;
+                }
+                break;
+        }
+
+        // Purchases and sales make up the transaction history
+        if (transaction.type == TransactionType::Buy || transaction.type == TransactionType::Sell)
+        {
+            std::lock_guard<std::mutex> stats(m_statsMutex);
+            m_transactions.push_back(transaction);
+            CountTradedTransaction(transaction);
+        }
+    }
+
+    bool GlobalEconomy::ApplyItem(const ItemData& item)
+    {
+        // A replaced item can change what its holders are worth and carry
+        uint32_t oldWeight = m_catalog.GetWeight(item.itemId);
+        bool replaced = m_catalog.Set(item);
+        InvalidatePrices();
+        if (replaced)
+        {
+            for (auto& shard : m_playerShards)
+            {
+                Reweigh(shard, item.itemId, oldWeight, item.weight);
+                RefreshWealth(shard);
+            }
+        }
+        return replaced;
+    }
+
+    bool GlobalEconomy::ApplyItemRemoval(uint32_t itemId)
     {
-        // Reset all prices to base values
-        for (auto& pair : m_items)
+        uint32_t oldWeight = m_catalog.GetWeight(itemId);
+        if (!m_catalog.Remove(itemId))
         {
-            ItemData& item = pair.second;
-            item.value = CalculateItemValue(item.itemId);
+            return false;
         }
-        
-        // Update merchant prices
-        for (auto& pair : m_merchants)
+        InvalidatePrices();
+
+        // Stock of a removed item stays in inventories but weighs nothing
+        for (auto& shard : m_playerShards)
         {
-            UpdateMerchantPrices(pair.first);
+            Reweigh(shard, itemId, oldWeight, 0);
+            RefreshWealth(shard);
         }
-        
-        LOG_INFO("Economy rebalanced");
+        return true;
     }
 
-    void GlobalEconomy::ResetEconomy()
+    void GlobalEconomy::ApplyMerchant(const MerchantData& merchant)
     {
-        // Reset all player currencies to default
-        for (auto& pair : m_playerEconomies)
+        MerchantShard& shard = ShardForMerchant(merchant.merchantId);
+        auto it = shard.merchants.find(merchant.merchantId);
+        if (it != shard.merchants.end())
         {
-            PlayerEconomyData& player = pair.second;
-            player.currencies[CurrencyType::Gold] = 100;
-            player.currencies[CurrencyType::Silver] = 0;
-            player.currencies[CurrencyType::Copper] = 0;
-            player.inventory.clear();
-            player.totalWeight = 0;
+            shard.gold -= it->second.goldAmount;
         }
-        
-        // Reset all merchant inventories
-        for (auto& pair : m_merchants)
+        shard.merchants[merchant.merchantId] = merchant;
+        shard.gold += merchant.goldAmount;
+        ScheduleRestock(merchant.merchantId, merchant.lastRestock);
+
+        // A replaced merchant may price differently
+        size_t slot = merchant.merchantId / ShardCount;
+        if (slot < shard.prices.size())
         {
-            MerchantData& merchant = pair.second;
-            merchant.inventory.clear();
-            merchant.goldAmount = 1000;
+            shard.prices[slot] = PriceRow();
         }
-        
-        // Clear transaction history
-        m_transactions.clear();
-        
-        LOG_INFO("Economy reset");
     }
 
-    void GlobalEconomy::SaveEconomyState()
+    bool GlobalEconomy::ApplyMerchantRemoval(uint32_t merchantId)
     {
-        // This would save economy state to file
-        // For now, just log
-        LOG_DEBUG("Economy state saved");
-    }
+        MerchantShard& shard = ShardForMerchant(merchantId);
+        auto it = shard.merchants.find(merchantId);
+        if (it == shard.merchants.end())
+        {
+            return false;
+        }
 
-    void GlobalEconomy::LoadEconomyState()
-    {
-        // This would load economy state from file
-        // For now, just log
-        LOG_DEBUG("Economy state loaded");
-    }
+        shard.gold -= it->second.goldAmount;
+        shard.merchants.erase(it);
+        {
+            std::lock_guard<std::mutex> restock(m_restockMutex);
+            m_restockQueue.Remove(merchantId);
+        }
 
-    // Configuration methods
-    void GlobalEconomy::SetInflationRate(float rate)
-    {
-        m_inflationRate = std::max(0.0f, std::min(1.0f, rate));
+        size_t slot = merchantId / ShardCount;
+        if (slot < shard.prices.size())
+        {
+            shard.prices[slot] = PriceRow();
+        }
+        return true;
     }
 
-    void GlobalEconomy::SetMaxPlayerWeight(uint32_t maxWeight)
+    bool GlobalEconomy::ApplyPlayerRemoval(uint32_t playerId)
     {
-        m_maxPlayerWeight = maxWeight;
-    }
+        PlayerShard& shard = ShardForPlayer(playerId);
+        auto it = shard.players.find(playerId);
+        if (it == shard.players.end())
+        {
+            return false;
+        }
 
-    void GlobalEconomy::SetMerchantRestockInterval(float interval)
-    {
-        m_merchantRestockInterval = std::max(60.0f, interval);
+        shard.gold -= CurrencyOf(&it->second, CurrencyType::Gold);
+        shard.wealth.Remove(playerId);
+        shard.players.erase(it);
+        return true;
     }
 
-    void GlobalEconomy::EnableTrading(bool enable)
+    void GlobalEconomy::ApplyValueScale(float factor)
     {
-        m_tradingEnabled = enable;
-    }
+        m_catalog.ScaleValues(factor);
+        InvalidatePrices();
 
-    void GlobalEconomy::EnableGifting(bool enable)
-    {
-        m_giftingEnabled = enable;
+        for (auto& shard : m_merchantShards)
+        {
+            for (auto& pair : shard.merchants)
+            {
+                RefreshMerchantPrices(pair.second);
+            }
+        }
+
+        // Item values moved, and with them every player's wealth
+        for (auto& shard : m_playerShards)
+        {
+            RefreshWealth(shard);
+        }
     }
 
-    GlobalEconomy::EconomyStats GlobalEconomy::GetStats() const
+    void GlobalEconomy::CountTradedTransaction(const TransactionData& transaction)
     {
-        return m_stats;
+        m_stats.totalTransactions++;
+        m_tradedValue += transaction.price;
+        m_stats.averageTransactionValue = static_cast<float>(m_tradedValue) / m_stats.totalTransactions;
+
+        // Counts only grow, so the leader changes only when overtaken
+        uint64_t count = ++m_tradeCounts[transaction.itemId];
+        auto leader = m_tradeCounts.find(m_stats.mostTradedItem);
+        if (leader == m_tradeCounts.end() || count > leader->second)
+        {
+            m_stats.mostTradedItem = transaction.itemId;
+        }
     }
 
-    void GlobalEconomy::ResetStats()
+    void GlobalEconomy::ReplayJournalRecord(uint64_t sequence, const uint8_t* data, size_t size)
     {
-        m_stats.Reset();
+        // Already part of the snapshot, or recovery has already failed
+        if (sequence <= m_snapshotSequence || m_replayFailed)
+        {
+            return;
+        }
+
+        // Each record is one section; its tag says what kind of change it is
+        BinaryReader in(data, size);
+        BinaryReader peek(data, size);
+        uint32_t tag = 0;
+        uint32_t version = 0;
+        BinaryReader body;
+        bool decoded = peek.NextSection(tag, version, body);
+        if (decoded)
+        {
+            switch (static_cast<SaveSection>(tag))
+            {
+                case SaveSection::Transactions:
+                {
+                    std::vector<TransactionData> transactions;
+                    decoded = SaveSerialization::ReadTransactions(in, transactions);
+                    if (!decoded)
+                    {
+                        break;
+                    }
+
+                    for (const auto& transaction : transactions)
+                    {
+                        if (InvolvesMerchant(transaction) && !GetMerchant(transaction.merchantId))
+                        {
+                            LOG_ERROR("Economy journal record " + std::to_string(sequence) + " trades with unknown merchant " +
+                                      std::to_string(transaction.merchantId));
+                            m_replayFailed = true;
+                            return;
+                        }
+                    }
+                    ApplyTransactions(transactions);
+                    break;
+                }
+                case SaveSection::Items:
+                {
+                    std::map<uint32_t, ItemData> items;
+                    decoded = SaveSerialization::ReadItems(in, items);
+                    if (decoded)
+                    {
+                        for (auto& pair : items)
+                        {
+                            pair.second.itemId = pair.first;
+                            m_nextItemId = std::max(m_nextItemId, pair.first + 1);
+                            ApplyItem(pair.second);
+                        }
+                    }
+                    break;
+                }
+                case SaveSection::Merchants:
+                {
+                    std::map<uint32_t, MerchantData> merchants;
+                    decoded = SaveSerialization::ReadMerchants(in, merchants);
+                    if (decoded)
+                    {
+                        for (const auto& pair : merchants)
+                        {
+                            AdvancePast(m_nextMerchantId, pair.first);
+                            ApplyMerchant(pair.second);
+                        }
+                    }
+                    break;
+                }
+                case SaveSection::RemovedPlayer:
+                {
+                    uint32_t playerId = body.ReadVarUInt32();
+                    decoded = body.IsValid();
+                    if (decoded)
+                    {
+                        ApplyPlayerRemoval(playerId);
+                    }
+                    break;
+                }
+                case SaveSection::RemovedMerchant:
+                {
+                    uint32_t merchantId = body.ReadVarUInt32();
+                    decoded = body.IsValid();
+                    if (decoded)
+                    {
+                        ApplyMerchantRemoval(merchantId);
+                    }
+                    break;
+                }
+                case SaveSection::RemovedItem:
+                {
+                    uint32_t itemId = body.ReadVarUInt32();
+                    decoded = body.IsValid();
+                    if (decoded)
+                    {
+                        ApplyItemRemoval(itemId);
+                    }
+                    break;
+                }
+                case SaveSection::ItemValueScale:
+                {
+                    float factor = body.ReadFloat();
+                    decoded = body.IsValid();
+                    if (decoded)
+                    {
+                        ApplyValueScale(factor);
+                    }
+                    break;
+                }
+                default:
+                    decoded = false;
+                    break;
+            }
+        }
+
+        if (!decoded)
+        {
+            LOG_WARNING("Skipping undecodable economy journal record " + std::to_string(sequence));
+        }
     }
 
-    void GlobalEconomy::PrintStats() const
+    std::string GlobalEconomy::GetSnapshotPath() const
     {
-        LOG_INFO("=== Global Economy Statistics ===");
-        LOG_INFO("Total transactions: " + std::to_string(m_stats.totalTransactions));
-        LOG_INFO("Total gold circulation: " + std::to_string(m_stats.totalGoldCirculation));
-        LOG_INFO("Active merchants: " + std::to_string(m_stats.activeMerchants));
-        LOG_INFO("Total items: " + std::to_string(m_stats.totalItems));
-        LOG_INFO("Average transaction value: " + std::to_string(m_stats.averageTransactionValue));
-        LOG_INFO("Inflation rate: " + std::to_string(m_stats.inflationRate * 100.0f) + "%");
-        LOG_INFO("Most traded item: " + std::to_string(m_stats.mostTradedItem));
-        LOG_INFO("Richest player: " + std::to_string(m_stats.richestPlayer));
-        LOG_INFO("=================================");
+        return m_stateDirectory + "/economy.snapshot";
     }
 
-    // Callback setters
-    void GlobalEconomy::SetTransactionCompletedCallback(TransactionCompletedCallback callback)
+    std::string GlobalEconomy::GetJournalPath() const
     {
-        m_transactionCompletedCallback = callback;
+        return m_stateDirectory + "/economy.journal";
     }
 
-    void GlobalEconomy::SetPlayerWealthChangedCallback(PlayerWealthChangedCallback callback)
+    GlobalEconomy::UpdateLock GlobalEconomy::LockForUpdate(std::initializer_list<uint32_t> playerIds, std::optional<uint32_t> merchantId)
     {
-        m_playerWealthChangedCallback = callback;
+        // One or two players. Their shards are locked in ascending order and
+        // a shared shard only once, so a trade between A and B and one between
+        // B and A queue up instead of deadlocking.
+        std::array<size_t, 2> shards{};
+        size_t count = 0;
+        for (uint32_t playerId : playerIds)
+        {
+            size_t shard = playerId % ShardCount;
+            if (count == 0 || shards[0] != shard)
+            {
+                shards[count++] = shard;
+            }
+        }
+        if (count == 2 && shards[1] < shards[0])
+        {
+            std::swap(shards[0], shards[1]);
+        }
+
+        UpdateLock lock;
+        lock.catalog = std::shared_lock<std::shared_mutex>(m_catalogMutex);
+        for (size_t i = 0; i < count; ++i)
+        {
+            lock.shards[i] = std::unique_lock<std::shared_mutex>(m_playerShards[shards[i]].mutex);
+        }
+        if (merchantId)
+        {
+            lock.shards[count] = std::unique_lock<std::shared_mutex>(ShardForMerchant(*merchantId).mutex);
+        }
+        return lock;
     }
 
-    void GlobalEconomy::SetMerchantRestockedCallback(MerchantRestockedCallback callback)
+    GlobalEconomy::GlobalLock GlobalEconomy::LockEverything()
     {
-        m_merchantRestockedCallback = callback;
+        GlobalLock lock;
+        lock.catalog = std::unique_lock<std::shared_mutex>(m_catalogMutex);
+        lock.shards.reserve(ShardCount * 2);
+        for (auto& shard : m_playerShards)
+        {
+            lock.shards.emplace_back(shard.mutex);
+        }
+        for (auto& shard : m_merchantShards)
+        {
+            lock.shards.emplace_back(shard.mutex);
+        }
+        return lock;
     }
 
-    void GlobalEconomy::SetEconomyCrashedCallback(EconomyCrashedCallback callback)
+    void GlobalEconomy::ClearAll()
     {
-        m_economyCrashedCallback = callback;
+        m_catalog.Clear();
+        for (auto& shard : m_playerShards)
+        {
+            shard.players.clear();
+            shard.gold = 0;
+            shard.wealth.Clear();
+        }
+        for (auto& shard : m_merchantShards)
+        {
+            shard.merchants.clear();
+            shard.gold = 0;
+            shard.prices.clear();
+        }
+        InvalidatePrices();
+        {
+            std::lock_guard<std::mutex> restock(m_restockMutex);
+            m_restockQueue.Clear();
+        }
+
+        std::lock_guard<std::mutex> stats(m_statsMutex);
+        m_transactions.clear();
+        m_tradeCounts.clear();
+        m_tradedValue = 0;
     }
 
-    // Private methods
-    void GlobalEconomy::InitializeDefaultItems()
+    uint64_t GlobalEconomy::CalculatePlayerWealth(const PlayerEconomyData& player) const
     {
-        // Create some default items
-        ItemData sword = EconomyUtils::CreateWeapon("Iron Sword", ItemRarity::Common, 50, 10);
-        AddItem(sword);
-        
-        ItemData armor = EconomyUtils::CreateArmor("Leather Armor", ItemRarity::Common, 30, 15);
-        AddItem(armor);
-        
-        ItemData potion = EconomyUtils::CreateConsumable("Health Potion", ItemRarity::Common, 10, 1);
-        AddItem(potion);
-        
-        ItemData ore = EconomyUtils::CreateMaterial("Iron Ore", ItemRarity::Common, 5, 2);
-        AddItem(ore);
+        uint64_t wealth = 0;
+        for (const auto& pair : player.currencies)
+        {
+            wealth += pair.second;
+        }
+
+        // Add item values
+        for (const auto& pair : player.inventory)
+        {
+            wealth += static_cast<uint64_t>(m_catalog.GetValue(pair.first)) * pair.second;
+        }
+        return wealth;
     }
 
-    void GlobalEconomy::InitializeDefaultMerchants()
+    void GlobalEconomy::ScheduleRestock(uint32_t merchantId, std::chrono::high_resolution_clock::time_point lastRestock)
     {
-        // Create some default merchants
-        MerchantData weaponMerchant = EconomyUtils::CreateWeaponMerchant("Blacksmith", "Novigrad");
-        AddMerchant(weaponMerchant);
-        
-        MerchantData armorMerchant = EconomyUtils::CreateArmorMerchant("Armorer", "Oxenfurt");
-        AddMerchant(armorMerchant);
-        
-        MerchantData generalMerchant = EconomyUtils::CreateGeneralMerchant("Trader", "Velen");
-        AddMerchant(generalMerchant);
+        std::lock_guard<std::mutex> restock(m_restockMutex);
+        auto interval = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+            std::chrono::duration<float>(m_merchantRestockInterval));
+        m_restockQueue.Set(merchantId, lastRestock + interval);
     }
 
-    bool GlobalEconomy::ValidateTransaction(const TransactionData& transaction) const
+    std::vector<uint32_t> GlobalEconomy::TakeDueRestocks(std::chrono::high_resolution_clock::time_point now)
     {
-        return transaction.playerId != 0 && transaction.merchantId != 0 && 
-               transaction.itemId != 0 && transaction.quantity > 0;
+        std::lock_guard<std::mutex> restock(m_restockMutex);
+        auto interval = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+            std::chrono::duration<float>(m_merchantRestockInterval));
+
+        // Taken merchants move a full interval back even if their restock
+        // fails, so a merchant that cannot restock is not retried every update
+        std::vector<uint32_t> due;
+        while (!m_restockQueue.Empty() && m_restockQueue.TopValue() <= now && due.size() < m_restockBudget)
+        {
+            due.push_back(m_restockQueue.TopKey());
+            m_restockQueue.Set(due.back(), now + interval);
+        }
+        return due;
     }
 
-    bool GlobalEconomy::ProcessTransaction(const TransactionData& transaction)
+    void GlobalEconomy::RefreshWealth(PlayerShard& shard)
     {
-        if (!ValidateTransaction(transaction))
+        for (const auto& pair : shard.players)
         {
-            return false;
+            shard.wealth.Set(pair.first, CalculatePlayerWealth(pair.second));
         }
-
-        // Transaction processing logic would go here
-        return true;
     }
 
-    void GlobalEconomy::UpdatePlayerWealth(uint32_t playerId)
+    void GlobalEconomy::Reweigh(PlayerShard& shard, uint32_t itemId, uint32_t oldWeight, uint32_t newWeight)
     {
-        PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        if (!player)
+        if (oldWeight == newWeight)
         {
             return;
         }
 
-        // Calculate total wealth
-        uint32_t totalWealth = 0;
-        for (const auto& pair : player->currencies)
+        for (auto& pair : shard.players)
         {
-            totalWealth += pair.second;
+            PlayerEconomyData& player = pair.second;
+            auto it = player.inventory.find(itemId);
+            if (it != player.inventory.end())
+            {
+                player.totalWeight -= std::min(player.totalWeight, oldWeight * it->second);
+                player.totalWeight += newWeight * it->second;
+            }
         }
-        
-        // Add item values
-        for (const auto& pair : player->inventory)
+    }
+
+    void GlobalEconomy::RebuildShardTotals()
+    {
+        for (auto& shard : m_playerShards)
         {
-            const ItemData* item = GetItem(pair.first);
-            if (item)
+            shard.gold = 0;
+            shard.wealth.Clear();
+            for (const auto& pair : shard.players)
             {
-                totalWealth += item->value * pair.second;
+                shard.gold += CurrencyOf(&pair.second, CurrencyType::Gold);
             }
+            RefreshWealth(shard);
         }
 
-        if (m_playerWealthChangedCallback)
+        for (auto& shard : m_merchantShards)
         {
-            m_playerWealthChangedCallback(playerId, totalWealth);
+            shard.gold = 0;
+            for (const auto& pair : shard.merchants)
+            {
+                shard.gold += pair.second.goldAmount;
+            }
         }
     }
 
-    void GlobalEconomy::UpdateEconomyStats()
+    void GlobalEconomy::UpdatePlayerWealth(uint32_t playerId)
     {
-        // Update total gold circulation
-        m_stats.totalGoldCirculation = 0;
-        for (const auto& pair : m_playerEconomies)
+        if (!m_playerWealthChangedCallback)
         {
-            m_stats.totalGoldCirculation += GetCurrency(pair.first, CurrencyType::Gold);
+            return;
         }
-        
-        for (const auto& pair : m_merchants)
+
+        // Kept up to date as transactions apply
+        uint64_t totalWealth;
         {
-            m_stats.totalGoldCirculation += pair.second.goldAmount;
+            const PlayerShard& shard = ShardForPlayer(playerId);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            const uint64_t* wealth = shard.wealth.Find(playerId);
+            if (!wealth)
+            {
+                return;
+            }
+            totalWealth = *wealth;
         }
+
+        m_playerWealthChangedCallback(playerId, static_cast<uint32_t>(totalWealth));
     }
 
     void GlobalEconomy::CheckEconomyHealth()
     {
         // Check for economy crashes or imbalances
-        if (m_stats.totalGoldCirculation == 0)
+        if (GetStats().totalGoldCirculation == 0)
         {
             if (m_economyCrashedCallback)
             {
@@ -1061,6 +2438,7 @@ namespace Game
     void GlobalEconomy::CleanupOldTransactions()
     {
         auto now = std::chrono::high_resolution_clock::now();
+        std::lock_guard<std::mutex> stats(m_statsMutex);
         auto it = m_transactions.begin();
         
         while (it != m_transactions.end())
@@ -1077,15 +2455,129 @@ namespace Game
         }
     }
 
-    uint32_t GlobalEconomy::CalculateBasePrice(uint32_t itemId) const
+    uint32_t GlobalEconomy::QuoteBuyPrice(uint32_t itemId, uint32_t merchantId) const
+    {
+        const PriceRow* row = CurrentPriceRow(merchantId);
+        if (row && itemId < row->buy.size())
+        {
+            return row->buy[itemId];
+        }
+
+        if (!m_catalog.Contains(itemId) || !GetMerchant(merchantId))
+        {
+            return 0;
+        }
+
+        // Calculate base price
+        uint32_t basePrice = CalculateBasePrice(itemId);
+
+        // Apply merchant multiplier
+        float merchantMultiplier = GetMerchantMultiplier(merchantId);
+
+        return static_cast<uint32_t>(basePrice * merchantMultiplier);
+    }
+
+    uint32_t GlobalEconomy::QuoteSellPrice(uint32_t itemId, uint32_t merchantId) const
     {
-        const ItemData* item = GetItem(itemId);
-        if (!item)
+        const PriceRow* row = CurrentPriceRow(merchantId);
+        if (row && itemId < row->sell.size())
+        {
+            return row->sell[itemId];
+        }
+
+        if (!m_catalog.Contains(itemId) || !GetMerchant(merchantId))
         {
             return 0;
         }
 
-        return item->value;
+        // Calculate base price (usually 50% of buy price)
+        uint32_t basePrice = CalculateBasePrice(itemId);
+
+        // Apply merchant multiplier and sell discount
+        float merchantMultiplier = GetMerchantMultiplier(merchantId);
+        float sellDiscount = 0.5f; // 50% of buy price
+
+        return static_cast<uint32_t>(basePrice * merchantMultiplier * sellDiscount);
+    }
+
+    void GlobalEconomy::RefreshMerchantPrices(MerchantData& merchant)
+    {
+        // The maps list what the merchant charges now, for saves and display
+        RefreshPriceRow(merchant.merchantId);
+        for (const auto& pair : merchant.inventory)
+        {
+            uint32_t itemId = pair.first;
+            if (m_catalog.Contains(itemId))
+            {
+                merchant.buyPrices[itemId] = QuoteBuyPrice(itemId, merchant.merchantId);
+                merchant.sellPrices[itemId] = QuoteSellPrice(itemId, merchant.merchantId);
+            }
+        }
+    }
+
+    void GlobalEconomy::InvalidatePrices()
+    {
+        // Dense value column; very large ids stay out and are priced from the catalog
+        m_itemValues.clear();
+        for (uint32_t itemId : m_catalog.GetIds())
+        {
+            if (itemId >= MaxTableItemId)
+            {
+                break;
+            }
+            if (itemId >= m_itemValues.size())
+            {
+                m_itemValues.resize(itemId + 1, 0);
+            }
+            m_itemValues[itemId] = m_catalog.GetValue(itemId);
+        }
+        m_priceEpoch++;
+    }
+
+    const GlobalEconomy::PriceRow* GlobalEconomy::CurrentPriceRow(uint32_t merchantId) const
+    {
+        const MerchantShard& shard = ShardForMerchant(merchantId);
+        size_t slot = merchantId / ShardCount;
+        if (slot >= shard.prices.size() || shard.prices[slot].epoch != m_priceEpoch)
+        {
+            return nullptr;
+        }
+        return &shard.prices[slot];
+    }
+
+    void GlobalEconomy::RefreshPriceRow(uint32_t merchantId)
+    {
+        if (CurrentPriceRow(merchantId) || !GetMerchant(merchantId))
+        {
+            return;
+        }
+
+        MerchantShard& shard = ShardForMerchant(merchantId);
+        size_t slot = merchantId / ShardCount;
+        if (slot >= shard.prices.size())
+        {
+            shard.prices.resize(slot + 1);
+        }
+
+        // Same arithmetic as the quotes, one straight pass over the column
+        PriceRow& row = shard.prices[slot];
+        float merchantMultiplier = GetMerchantMultiplier(merchantId);
+        float sellDiscount = 0.5f;
+        size_t count = m_itemValues.size();
+        row.buy.resize(count);
+        row.sell.resize(count);
+        for (size_t itemId = 0; itemId < count; ++itemId)
+        {
+            uint32_t basePrice = m_itemValues[itemId];
+            row.buy[itemId] = static_cast<uint32_t>(basePrice * merchantMultiplier);
+            row.sell[itemId] = static_cast<uint32_t>(basePrice * merchantMultiplier * sellDiscount);
+        }
+        row.epoch = m_priceEpoch;
+    }
+
+    uint32_t GlobalEconomy::CalculateBasePrice(uint32_t itemId) const
+    {
+        return m_catalog.GetValue(itemId);
     }
 
     float GlobalEconomy::GetRarityMultiplier(ItemRarity rarity) const
@@ -1124,27 +2616,34 @@ namespace Game
 
     bool GlobalEconomy::CanPlayerAfford(uint32_t playerId, CurrencyType currency, uint32_t amount) const
     {
-        return GetCurrency(playerId, currency) >= amount;
+        return CurrencyOf(GetPlayerEconomy(playerId), currency) >= amount;
     }
 
     bool GlobalEconomy::CanPlayerCarry(uint32_t playerId, uint32_t itemId, uint32_t quantity) const
     {
         const PlayerEconomyData* player = GetPlayerEconomy(playerId);
-        const ItemData* item = GetItem(itemId);
-        
-        if (!player || !item)
+        if (!player || !m_catalog.Contains(itemId))
         {
             return false;
         }
 
-        uint32_t additionalWeight = item->weight * quantity;
+        uint64_t additionalWeight = static_cast<uint64_t>(m_catalog.GetWeight(itemId)) * quantity;
         return player->totalWeight + additionalWeight <= player->maxWeight;
     }
 
+    uint64_t GlobalEconomy::WeightOf(const std::map<uint32_t, uint32_t>& items) const
+    {
+        uint64_t weight = 0;
+        for (const auto& pair : items)
+        {
+            weight += static_cast<uint64_t>(m_catalog.GetWeight(pair.first)) * pair.second;
+        }
+        return weight;
+    }
+
     bool GlobalEconomy::IsItemTradeable(uint32_t itemId) const
     {
-        const ItemData* item = GetItem(itemId);
-        return item && item->isTradeable;
+        return m_catalog.IsTradeable(itemId);
     }
 
     bool GlobalEconomy::IsMerchantActive(uint32_t merchantId) const
@@ -1301,7 +2800,7 @@ namespace Game
             return value;
         }
 
-        std::vector<uint32_t> GetTopWealthyPlayers(const std::map<uint32_t, PlayerEconomyData>& players)
+        std::vector<uint32_t> GetTopWealthyPlayers(const std::map<uint32_t, PlayerEconomyData>& players, size_t count)
         {
             std::vector<std::pair<uint32_t, float>> playerWealths;
             
@@ -1311,16 +2810,17 @@ namespace Game
                 playerWealths.push_back({pair.first, wealth});
             }
             
-            // Sort by wealth (descending)
-            std::sort(playerWealths.begin(), playerWealths.end(), 
+            // Sort by wealth (descending); only the first count need ordering
+            size_t kept = std::min(count, playerWealths.size());
+            std::partial_sort(playerWealths.begin(), playerWealths.begin() + kept, playerWealths.end(),
                      [](const std::pair<uint32_t, float>& a, const std::pair<uint32_t, float>& b) {
                          return a.second > b.second;
                      });
             
             std::vector<uint32_t> topPlayers;
-            for (const auto& pair : playerWealths)
+            for (size_t i = 0; i < kept; ++i)
             {
-                topPlayers.push_back(pair.first);
+                topPlayers.push_back(playerWealths[i].first);
             }
             
             return topPlayers;
@@ -1349,8 +2849,8 @@ namespace Game
             LOG_INFO("Rarity: " + std::to_string(static_cast<int>(item.rarity)));
             LOG_INFO("Value: " + std::to_string(item.value));
             LOG_INFO("Weight: " + std::to_string(item.weight));
-            LOG_INFO("Tradeable: " + (item.isTradeable ? "Yes" : "No"));
-            LOG_INFO("Sellable: " + (item.isSellable ? "Yes" : "No"));
+            LOG_INFO(std::string("Tradeable: ") + (item.isTradeable ? "Yes" : "No"));
+            LOG_INFO(std::string("Sellable: ") + (item.isSellable ? "Yes" : "No"));
             LOG_INFO("===================");
         }
 
@@ -1371,7 +2871,7 @@ namespace Game
             LOG_INFO("Location: " + merchant.location);
             LOG_INFO("Gold: " + std::to_string(merchant.goldAmount) + "/" + std::to_string(merchant.maxGold));
             LOG_INFO("Inventory Items: " + std::to_string(merchant.inventory.size()));
-            LOG_INFO("Active: " + (merchant.isActive ? "Yes" : "No"));
+            LOG_INFO(std::string("Active: ") + (merchant.isActive ? "Yes" : "No"));
             LOG_INFO("=======================");
         }
     }
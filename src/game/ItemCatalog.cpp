@@ -0,0 +1,277 @@
+#include "game/ItemCatalog.h"
+#include <algorithm>
+
+namespace Game
+{
+    namespace
+    {
+        constexpr uint32_t NoSlot = UINT32_MAX;
+        constexpr uint8_t TradeableFlag = 1;
+        constexpr uint8_t SellableFlag = 2;
+
+        void InsertSorted(std::vector<uint32_t>& ids, uint32_t itemId)
+        {
+            // New items usually carry the highest id so far
+            if (ids.empty() || ids.back() < itemId)
+            {
+                ids.push_back(itemId);
+                return;
+            }
+            ids.insert(std::lower_bound(ids.begin(), ids.end(), itemId), itemId);
+        }
+
+        void EraseSorted(std::vector<uint32_t>& ids, uint32_t itemId)
+        {
+            auto it = std::lower_bound(ids.begin(), ids.end(), itemId);
+            if (it != ids.end() && *it == itemId)
+            {
+                ids.erase(it);
+            }
+        }
+
+        template<typename T>
+        size_t ColumnBytes(const std::vector<T>& column)
+        {
+            return column.capacity() * sizeof(T);
+        }
+    }
+
+    bool ItemCatalog::Set(const ItemData& item)
+    {
+        uint8_t flags = (item.isTradeable ? TradeableFlag : 0) | (item.isSellable ? SellableFlag : 0);
+        uint32_t name = m_strings.Intern(item.name);
+        uint32_t description = m_strings.Intern(item.description);
+
+        uint32_t slot = SlotOf(item.itemId);
+        bool replaced = slot != NoSlot;
+        if (replaced)
+        {
+            Unlist(slot);
+            m_names[slot] = name;
+            m_descriptions[slot] = description;
+            m_types[slot] = static_cast<uint8_t>(item.type);
+            m_rarities[slot] = static_cast<uint8_t>(item.rarity);
+            m_values[slot] = item.value;
+            m_weights[slot] = item.weight;
+            m_stackSizes[slot] = item.stackSize;
+            m_flags[slot] = flags;
+            m_prices[slot] = item.prices;
+        }
+        else
+        {
+            slot = static_cast<uint32_t>(m_itemIds.size());
+            m_slots[item.itemId] = slot;
+            m_itemIds.push_back(item.itemId);
+            m_names.push_back(name);
+            m_descriptions.push_back(description);
+            m_types.push_back(static_cast<uint8_t>(item.type));
+            m_rarities.push_back(static_cast<uint8_t>(item.rarity));
+            m_values.push_back(item.value);
+            m_weights.push_back(item.weight);
+            m_stackSizes.push_back(item.stackSize);
+            m_flags.push_back(flags);
+            m_prices.push_back(item.prices);
+            InsertSorted(m_sortedIds, item.itemId);
+        }
+
+        // Out of range enum values are stored but not listed
+        if (m_types[slot] < ItemTypeCount)
+        {
+            InsertSorted(m_idsByType[m_types[slot]], item.itemId);
+        }
+        if (m_rarities[slot] < ItemRarityCount)
+        {
+            InsertSorted(m_idsByRarity[m_rarities[slot]], item.itemId);
+        }
+        return replaced;
+    }
+
+    bool ItemCatalog::Remove(uint32_t itemId)
+    {
+        uint32_t slot = SlotOf(itemId);
+        if (slot == NoSlot)
+        {
+            return false;
+        }
+
+        Unlist(slot);
+        EraseSorted(m_sortedIds, itemId);
+        m_slots.erase(itemId);
+
+        // The last slot moves into the hole so the columns stay dense
+        uint32_t last = static_cast<uint32_t>(m_itemIds.size() - 1);
+        if (slot != last)
+        {
+            m_itemIds[slot] = m_itemIds[last];
+            m_names[slot] = m_names[last];
+            m_descriptions[slot] = m_descriptions[last];
+            m_types[slot] = m_types[last];
+            m_rarities[slot] = m_rarities[last];
+            m_values[slot] = m_values[last];
+            m_weights[slot] = m_weights[last];
+            m_stackSizes[slot] = m_stackSizes[last];
+            m_flags[slot] = m_flags[last];
+            m_prices[slot] = m_prices[last];
+            m_slots[m_itemIds[slot]] = slot;
+        }
+        m_itemIds.pop_back();
+        m_names.pop_back();
+        m_descriptions.pop_back();
+        m_types.pop_back();
+        m_rarities.pop_back();
+        m_values.pop_back();
+        m_weights.pop_back();
+        m_stackSizes.pop_back();
+        m_flags.pop_back();
+        m_prices.pop_back();
+        return true;
+    }
+
+    void ItemCatalog::Clear()
+    {
+        m_itemIds.clear();
+        m_names.clear();
+        m_descriptions.clear();
+        m_types.clear();
+        m_rarities.clear();
+        m_values.clear();
+        m_weights.clear();
+        m_stackSizes.clear();
+        m_flags.clear();
+        m_prices.clear();
+        m_slots.clear();
+        m_strings.Clear();
+        m_sortedIds.clear();
+        for (auto& ids : m_idsByType)
+        {
+            ids.clear();
+        }
+        for (auto& ids : m_idsByRarity)
+        {
+            ids.clear();
+        }
+    }
+
+    std::optional<ItemData> ItemCatalog::Get(uint32_t itemId) const
+    {
+        uint32_t slot = SlotOf(itemId);
+        if (slot == NoSlot)
+        {
+            return std::nullopt;
+        }
+
+        ItemData item;
+        item.itemId = itemId;
+        item.name = m_strings.Get(m_names[slot]);
+        item.description = m_strings.Get(m_descriptions[slot]);
+        item.type = static_cast<ItemType>(m_types[slot]);
+        item.rarity = static_cast<ItemRarity>(m_rarities[slot]);
+        item.value = m_values[slot];
+        item.weight = m_weights[slot];
+        item.stackSize = m_stackSizes[slot];
+        item.isTradeable = (m_flags[slot] & TradeableFlag) != 0;
+        item.isSellable = (m_flags[slot] & SellableFlag) != 0;
+        item.prices = m_prices[slot];
+        return item;
+    }
+
+    const std::string& ItemCatalog::GetName(uint32_t itemId) const
+    {
+        static const std::string unknown;
+        uint32_t slot = SlotOf(itemId);
+        return slot != NoSlot ? m_strings.Get(m_names[slot]) : unknown;
+    }
+
+    uint32_t ItemCatalog::GetValue(uint32_t itemId) const
+    {
+        uint32_t slot = SlotOf(itemId);
+        return slot != NoSlot ? m_values[slot] : 0;
+    }
+
+    uint32_t ItemCatalog::GetWeight(uint32_t itemId) const
+    {
+        uint32_t slot = SlotOf(itemId);
+        return slot != NoSlot ? m_weights[slot] : 0;
+    }
+
+    bool ItemCatalog::IsTradeable(uint32_t itemId) const
+    {
+        uint32_t slot = SlotOf(itemId);
+        return slot != NoSlot && (m_flags[slot] & TradeableFlag) != 0;
+    }
+
+    bool ItemCatalog::IsSellable(uint32_t itemId) const
+    {
+        uint32_t slot = SlotOf(itemId);
+        return slot != NoSlot && (m_flags[slot] & SellableFlag) != 0;
+    }
+
+    void ItemCatalog::ScaleValues(float factor)
+    {
+        for (uint32_t& value : m_values)
+        {
+            value = static_cast<uint32_t>(value * factor);
+        }
+        for (CurrencyPrices& prices : m_prices)
+        {
+            for (uint32_t& price : prices)
+            {
+                price = static_cast<uint32_t>(price * factor);
+            }
+        }
+    }
+
+    const std::vector<uint32_t>& ItemCatalog::GetIdsByType(ItemType type) const
+    {
+        static const std::vector<uint32_t> none;
+        size_t index = static_cast<size_t>(type);
+        return index < ItemTypeCount ? m_idsByType[index] : none;
+    }
+
+    const std::vector<uint32_t>& ItemCatalog::GetIdsByRarity(ItemRarity rarity) const
+    {
+        static const std::vector<uint32_t> none;
+        size_t index = static_cast<size_t>(rarity);
+        return index < ItemRarityCount ? m_idsByRarity[index] : none;
+    }
+
+    size_t ItemCatalog::MemoryUsage() const
+    {
+        size_t bytes = ColumnBytes(m_itemIds) + ColumnBytes(m_names) + ColumnBytes(m_descriptions) +
+                       ColumnBytes(m_types) + ColumnBytes(m_rarities) + ColumnBytes(m_values) +
+                       ColumnBytes(m_weights) + ColumnBytes(m_stackSizes) + ColumnBytes(m_flags) +
+                       ColumnBytes(m_prices) + ColumnBytes(m_sortedIds);
+        for (const auto& ids : m_idsByType)
+        {
+            bytes += ColumnBytes(ids);
+        }
+        for (const auto& ids : m_idsByRarity)
+        {
+            bytes += ColumnBytes(ids);
+        }
+
+        // Hash nodes hold the pair and a next pointer, plus the bucket array
+        bytes += m_slots.bucket_count() * sizeof(void*);
+        bytes += m_slots.size() * (2 * sizeof(uint32_t) + sizeof(void*));
+        return bytes + m_strings.MemoryUsage();
+    }
+
+    uint32_t ItemCatalog::SlotOf(uint32_t itemId) const
+    {
+        auto it = m_slots.find(itemId);
+        return it != m_slots.end() ? it->second : NoSlot;
+    }
+
+    void ItemCatalog::Unlist(uint32_t slot)
+    {
+        uint32_t itemId = m_itemIds[slot];
+        if (m_types[slot] < ItemTypeCount)
+        {
+            EraseSorted(m_idsByType[m_types[slot]], itemId);
+        }
+        if (m_rarities[slot] < ItemRarityCount)
+        {
+            EraseSorted(m_idsByRarity[m_rarities[slot]], itemId);
+        }
+    }
+}
@@ -0,0 +1,1178 @@
+#include "game/SaveSerialization.h"
+#include <algorithm>
+
+namespace Game
+{
+    namespace
+    {
+        // Current version of each section. Bump when appending fields and gate
+        // the new reads on the version, so older saves still load.
+        constexpr uint32_t PlayerVersion = 1;
+        constexpr uint32_t WorldVersion = 1;
+        constexpr uint32_t QuestsVersion = 1;
+        constexpr uint32_t EconomyVersion = 1;
+        constexpr uint32_t ProgressionVersion = 1;
+        constexpr uint32_t MonstersVersion = 1;
+        constexpr uint32_t GroupsVersion = 1;
+        constexpr uint32_t MerchantsVersion = 1;
+        constexpr uint32_t WorldStatesVersion = 1;
+        constexpr uint32_t RecordIndexVersion = 1;
+        constexpr uint32_t ItemsVersion = 1;
+        constexpr uint32_t TransactionsVersion = 1;
+        constexpr size_t RecordIndexEntrySize = 8;
+
+        using TimePoint = std::chrono::high_resolution_clock::time_point;
+
+        // Field helpers
+        void WriteTime(BinaryWriter& out, TimePoint time)
+        {
+            out.WriteVarInt(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+        }
+
+        TimePoint ReadTime(BinaryReader& in)
+        {
+            std::chrono::nanoseconds sinceEpoch(in.ReadVarInt());
+            return TimePoint(std::chrono::duration_cast<TimePoint::duration>(sinceEpoch));
+        }
+
+        void WriteVector(BinaryWriter& out, const Vector4F& value)
+        {
+            out.WriteFloat(value.x);
+            out.WriteFloat(value.y);
+            out.WriteFloat(value.z);
+            out.WriteFloat(value.w);
+        }
+
+        Vector4F ReadVector(BinaryReader& in)
+        {
+            Vector4F value;
+            value.x = in.ReadFloat();
+            value.y = in.ReadFloat();
+            value.z = in.ReadFloat();
+            value.w = in.ReadFloat();
+            return value;
+        }
+
+        void WriteIds(BinaryWriter& out, const std::vector<uint32_t>& ids)
+        {
+            out.WriteVarUInt(ids.size());
+            for (uint32_t id : ids)
+            {
+                out.WriteVarUInt(id);
+            }
+        }
+
+        std::vector<uint32_t> ReadIds(BinaryReader& in)
+        {
+            std::vector<uint32_t> ids(in.ReadCount());
+            for (auto& id : ids)
+            {
+                id = in.ReadVarUInt32();
+            }
+            return ids;
+        }
+
+        // itemId -> quantity/price style maps, keyed by an integer or an enum.
+        // Any sorted map type works; inventories are flat maps.
+        template<typename Map>
+        void WriteCountMap(BinaryWriter& out, const Map& values)
+        {
+            out.WriteVarUInt(values.size());
+            for (const auto& pair : values)
+            {
+                out.WriteVarInt(static_cast<int64_t>(pair.first));
+                out.WriteVarUInt(pair.second);
+            }
+        }
+
+        template<typename Key, typename Map = std::map<Key, uint32_t>>
+        Map ReadCountMap(BinaryReader& in)
+        {
+            Map values;
+            uint32_t count = in.ReadCount();
+            for (uint32_t i = 0; i < count && in.IsValid(); ++i)
+            {
+                Key key = static_cast<Key>(in.ReadVarInt());
+                values[key] = in.ReadVarUInt32();
+            }
+            return values;
+        }
+
+        // Item prices keep the count map layout: only priced currencies are written
+        void WritePrices(BinaryWriter& out, const CurrencyPrices& prices)
+        {
+            std::map<CurrencyType, uint32_t> priced;
+            for (size_t currency = 0; currency < prices.size(); ++currency)
+            {
+                if (prices[currency] != 0)
+                {
+                    priced[static_cast<CurrencyType>(currency)] = prices[currency];
+                }
+            }
+            WriteCountMap(out, priced);
+        }
+
+        CurrencyPrices ReadPrices(BinaryReader& in)
+        {
+            CurrencyPrices prices{};
+            for (const auto& pair : ReadCountMap<CurrencyType>(in))
+            {
+                size_t currency = static_cast<size_t>(pair.first);
+                if (currency < prices.size())
+                {
+                    prices[currency] = pair.second;
+                }
+            }
+            return prices;
+        }
+
+        // Writes count + key/record pairs for a map of records
+        template<typename Value, typename WriteFn>
+        void WriteRecordMap(BinaryWriter& out, const std::map<uint32_t, Value>& values, WriteFn writeValue)
+        {
+            out.WriteVarUInt(values.size());
+            for (const auto& pair : values)
+            {
+                out.WriteVarUInt(pair.first);
+                size_t record = out.BeginRecord();
+                writeValue(out, pair.second);
+                out.EndRecord(record);
+            }
+        }
+
+        template<typename Value, typename ReadFn>
+        bool ReadRecordMap(BinaryReader& in, uint32_t version, std::map<uint32_t, Value>& values, ReadFn readValue)
+        {
+            values.clear();
+            uint32_t count = in.ReadCount();
+            for (uint32_t i = 0; i < count && in.IsValid(); ++i)
+            {
+                uint32_t key = in.ReadVarUInt32();
+                BinaryReader record = in.ReadRecord();
+                Value value;
+                readValue(record, version, value);
+                if (!record.IsValid())
+                {
+                    return false;
+                }
+                values.emplace_hint(values.end(), key, std::move(value));
+            }
+            return in.IsValid();
+        }
+
+        void AppendLittleEndian32(std::vector<uint8_t>& out, uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+            }
+        }
+
+        uint32_t ReadLittleEndian32(const uint8_t* bytes)
+        {
+            return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                   (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+        }
+
+        // A keyed record section followed by an index section of fixed-width
+        // (key, offset of the entry in the section body) pairs in key order,
+        // so a reader can binary search for one record without parsing the
+        // others. Readers that do not know the index tag skip it.
+        template<typename Value, typename WriteFn>
+        void WriteIndexedSection(BinaryWriter& out, SaveSection tag, uint32_t version, SaveSection indexTag,
+                                 const std::map<uint32_t, Value>& values, WriteFn writeValue)
+        {
+            std::vector<uint8_t> index;
+            index.reserve(values.size() * RecordIndexEntrySize);
+
+            // Widening a length prefix only moves bytes before the body, so
+            // offsets taken from the body start stay valid
+            size_t section = out.BeginSection(static_cast<uint32_t>(tag), version);
+            size_t bodyStart = out.GetSize();
+            out.WriteVarUInt(values.size());
+            for (const auto& pair : values)
+            {
+                AppendLittleEndian32(index, pair.first);
+                AppendLittleEndian32(index, static_cast<uint32_t>(out.GetSize() - bodyStart));
+                out.WriteVarUInt(pair.first);
+                size_t record = out.BeginRecord();
+                writeValue(out, pair.second);
+                out.EndRecord(record);
+            }
+            out.EndSection(section);
+
+            size_t indexSection = out.BeginSection(static_cast<uint32_t>(indexTag), RecordIndexVersion);
+            out.WriteBytes(index.data(), index.size());
+            out.EndSection(indexSection);
+        }
+
+        // Decodes the entry at offset in a keyed section body
+        template<typename Value, typename ReadFn>
+        bool ReadRecordAt(const uint8_t* body, size_t bodySize, uint32_t offset, uint32_t key, uint32_t version,
+                          Value& value, ReadFn readValue)
+        {
+            if (offset >= bodySize)
+            {
+                return false;
+            }
+
+            BinaryReader in(body + offset, bodySize - offset);
+            if (in.ReadVarUInt32() != key)
+            {
+                return false;
+            }
+            BinaryReader record = in.ReadRecord();
+            readValue(record, version, value);
+            return record.IsValid();
+        }
+
+        // Finds the first section with the given tag, skipping the others
+        bool FindSection(BinaryReader& in, SaveSection wanted, BinaryReader& body, uint32_t& version)
+        {
+            uint32_t tag = 0;
+            while (in.NextSection(tag, version, body))
+            {
+                if (tag == static_cast<uint32_t>(wanted))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Record encoders
+        void WriteMonster(BinaryWriter& out, const MonsterAIData& monster)
+        {
+            out.WriteVarUInt(monster.monsterId);
+            out.WriteString(monster.monsterName);
+            out.WriteEnum(monster.type);
+            out.WriteEnum(monster.pattern);
+            out.WriteEnum(monster.currentState);
+            out.WriteEnum(monster.previousState);
+            WriteVector(out, monster.position);
+            WriteVector(out, monster.targetPosition);
+            WriteVector(out, monster.velocity);
+            out.WriteFloat(monster.rotation);
+            out.WriteFloat(monster.targetRotation);
+            out.WriteFloat(monster.health);
+            out.WriteFloat(monster.maxHealth);
+            out.WriteFloat(monster.stamina);
+            out.WriteFloat(monster.maxStamina);
+            out.WriteFloat(monster.attackPower);
+            out.WriteFloat(monster.defense);
+            out.WriteFloat(monster.speed);
+            out.WriteFloat(monster.attackRange);
+            out.WriteFloat(monster.detectionRange);
+            out.WriteFloat(monster.aggroRange);
+            out.WriteFloat(monster.aggressionLevel);
+            out.WriteFloat(monster.fearLevel);
+            out.WriteFloat(monster.intelligence);
+            out.WriteFloat(monster.memory);
+            out.WriteVarUInt(monster.targetPlayerId);
+            WriteIds(out, monster.threatList);
+            WriteTime(out, monster.lastAttackTime);
+            WriteTime(out, monster.lastStateChange);
+            out.WriteVarUInt(monster.syncOwner);
+            out.WriteBool(monster.needsSync);
+            WriteTime(out, monster.lastSyncTime);
+        }
+
+        void ReadMonster(BinaryReader& in, uint32_t /*version*/, MonsterAIData& monster)
+        {
+            monster.monsterId = in.ReadVarUInt32();
+            monster.monsterName = in.ReadString();
+            monster.type = in.ReadEnum<MonsterType>();
+            monster.pattern = in.ReadEnum<BehaviorPattern>();
+            monster.currentState = in.ReadEnum<MonsterAIState>();
+            monster.previousState = in.ReadEnum<MonsterAIState>();
+            monster.position = ReadVector(in);
+            monster.targetPosition = ReadVector(in);
+            monster.velocity = ReadVector(in);
+            monster.rotation = in.ReadFloat();
+            monster.targetRotation = in.ReadFloat();
+            monster.health = in.ReadFloat();
+            monster.maxHealth = in.ReadFloat();
+            monster.stamina = in.ReadFloat();
+            monster.maxStamina = in.ReadFloat();
+            monster.attackPower = in.ReadFloat();
+            monster.defense = in.ReadFloat();
+            monster.speed = in.ReadFloat();
+            monster.attackRange = in.ReadFloat();
+            monster.detectionRange = in.ReadFloat();
+            monster.aggroRange = in.ReadFloat();
+            monster.aggressionLevel = in.ReadFloat();
+            monster.fearLevel = in.ReadFloat();
+            monster.intelligence = in.ReadFloat();
+            monster.memory = in.ReadFloat();
+            monster.targetPlayerId = in.ReadVarUInt32();
+            monster.threatList = ReadIds(in);
+            monster.lastAttackTime = ReadTime(in);
+            monster.lastStateChange = ReadTime(in);
+            monster.syncOwner = in.ReadVarUInt32();
+            monster.needsSync = in.ReadBool();
+            monster.lastSyncTime = ReadTime(in);
+        }
+
+        void WriteMerchant(BinaryWriter& out, const MerchantData& merchant)
+        {
+            out.WriteVarUInt(merchant.merchantId);
+            out.WriteString(merchant.name);
+            out.WriteString(merchant.location);
+            WriteCountMap(out, merchant.inventory);
+            WriteCountMap(out, merchant.buyPrices);
+            WriteCountMap(out, merchant.sellPrices);
+            out.WriteVarUInt(merchant.goldAmount);
+            out.WriteVarUInt(merchant.maxGold);
+            out.WriteBool(merchant.isActive);
+            WriteTime(out, merchant.lastRestock);
+        }
+
+        void ReadMerchant(BinaryReader& in, uint32_t /*version*/, MerchantData& merchant)
+        {
+            merchant.merchantId = in.ReadVarUInt32();
+            merchant.name = in.ReadString();
+            merchant.location = in.ReadString();
+            merchant.inventory = ReadCountMap<uint32_t, Inventory>(in);
+            merchant.buyPrices = ReadCountMap<uint32_t>(in);
+            merchant.sellPrices = ReadCountMap<uint32_t>(in);
+            merchant.goldAmount = in.ReadVarUInt32();
+            merchant.maxGold = in.ReadVarUInt32();
+            merchant.isActive = in.ReadBool();
+            merchant.lastRestock = ReadTime(in);
+        }
+
+        void WriteItem(BinaryWriter& out, const ItemData& item)
+        {
+            out.WriteVarUInt(item.itemId);
+            out.WriteString(item.name);
+            out.WriteString(item.description);
+            out.WriteEnum(item.type);
+            out.WriteEnum(item.rarity);
+            out.WriteVarUInt(item.value);
+            out.WriteVarUInt(item.weight);
+            out.WriteVarUInt(item.stackSize);
+            out.WriteBool(item.isTradeable);
+            out.WriteBool(item.isSellable);
+            WritePrices(out, item.prices);
+        }
+
+        void ReadItem(BinaryReader& in, uint32_t /*version*/, ItemData& item)
+        {
+            item.itemId = in.ReadVarUInt32();
+            item.name = in.ReadString();
+            item.description = in.ReadString();
+            item.type = in.ReadEnum<ItemType>();
+            item.rarity = in.ReadEnum<ItemRarity>();
+            item.value = in.ReadVarUInt32();
+            item.weight = in.ReadVarUInt32();
+            item.stackSize = in.ReadVarUInt32();
+            item.isTradeable = in.ReadBool();
+            item.isSellable = in.ReadBool();
+            item.prices = ReadPrices(in);
+        }
+
+        void WriteTransaction(BinaryWriter& out, const TransactionData& transaction)
+        {
+            out.WriteVarUInt(transaction.transactionId);
+            out.WriteVarUInt(transaction.playerId);
+            out.WriteVarUInt(transaction.merchantId);
+            out.WriteEnum(transaction.type);
+            out.WriteVarUInt(transaction.itemId);
+            out.WriteVarUInt(transaction.quantity);
+            out.WriteVarUInt(transaction.price);
+            out.WriteEnum(transaction.currency);
+            WriteTime(out, transaction.timestamp);
+            out.WriteBool(transaction.isCompleted);
+            out.WriteVarUInt(transaction.recipientId);
+        }
+
+        void ReadTransaction(BinaryReader& in, uint32_t /*version*/, TransactionData& transaction)
+        {
+            transaction.transactionId = in.ReadVarUInt32();
+            transaction.playerId = in.ReadVarUInt32();
+            transaction.merchantId = in.ReadVarUInt32();
+            transaction.type = in.ReadEnum<TransactionType>();
+            transaction.itemId = in.ReadVarUInt32();
+            transaction.quantity = in.ReadVarUInt32();
+            transaction.price = in.ReadVarUInt32();
+            transaction.currency = in.ReadEnum<CurrencyType>();
+            transaction.timestamp = ReadTime(in);
+            transaction.isCompleted = in.ReadBool();
+            transaction.recipientId = in.ReadVarUInt32();
+        }
+
+        void WriteObjective(BinaryWriter& out, const QuestObjective& objective)
+        {
+            out.WriteVarUInt(objective.objectiveId);
+            out.WriteString(objective.description);
+            out.WriteString(objective.type);
+            out.WriteString(objective.target);
+            out.WriteVarUInt(objective.requiredCount);
+            out.WriteVarUInt(objective.currentCount);
+            out.WriteBool(objective.isCompleted);
+            out.WriteBool(objective.isOptional);
+        }
+
+        void ReadObjective(BinaryReader& in, QuestObjective& objective)
+        {
+            objective.objectiveId = in.ReadVarUInt32();
+            objective.description = in.ReadString();
+            objective.type = in.ReadString();
+            objective.target = in.ReadString();
+            objective.requiredCount = in.ReadVarUInt32();
+            objective.currentCount = in.ReadVarUInt32();
+            objective.isCompleted = in.ReadBool();
+            objective.isOptional = in.ReadBool();
+        }
+
+        void WriteQuest(BinaryWriter& out, const QuestData& quest)
+        {
+            out.WriteVarUInt(quest.questId);
+            out.WriteString(quest.name);
+            out.WriteString(quest.description);
+            out.WriteEnum(quest.type);
+            out.WriteEnum(quest.state);
+            out.WriteVarUInt(quest.level);
+            out.WriteVarUInt(quest.objectives.size());
+            for (const auto& objective : quest.objectives)
+            {
+                size_t record = out.BeginRecord();
+                WriteObjective(out, objective);
+                out.EndRecord(record);
+            }
+            WriteIds(out, quest.requiredQuests);
+            WriteIds(out, quest.rewards);
+            out.WriteVarUInt(quest.experienceReward);
+            out.WriteVarUInt(quest.goldReward);
+            out.WriteString(quest.giverNpcId);
+            out.WriteString(quest.location);
+            WriteTime(out, quest.startTime);
+            WriteTime(out, quest.completionTime);
+            out.WriteBool(quest.isCooperative);
+            out.WriteVarUInt(quest.maxParticipants);
+            WriteIds(out, quest.participants);
+            out.WriteVarUInt(quest.syncOwner);
+        }
+
+        void ReadQuest(BinaryReader& in, uint32_t /*version*/, QuestData& quest)
+        {
+            quest.questId = in.ReadVarUInt32();
+            quest.name = in.ReadString();
+            quest.description = in.ReadString();
+            quest.type = in.ReadEnum<QuestType>();
+            quest.state = in.ReadEnum<QuestState>();
+            quest.level = in.ReadVarUInt32();
+            quest.objectives.resize(in.ReadCount());
+            for (auto& objective : quest.objectives)
+            {
+                BinaryReader record = in.ReadRecord();
+                ReadObjective(record, objective);
+                if (!record.IsValid())
+                {
+                    in.Fail();
+                    return;
+                }
+            }
+            quest.requiredQuests = ReadIds(in);
+            quest.rewards = ReadIds(in);
+            quest.experienceReward = in.ReadVarUInt32();
+            quest.goldReward = in.ReadVarUInt32();
+            quest.giverNpcId = in.ReadString();
+            quest.location = in.ReadString();
+            quest.startTime = ReadTime(in);
+            quest.completionTime = ReadTime(in);
+            quest.isCooperative = in.ReadBool();
+            quest.maxParticipants = in.ReadVarUInt32();
+            quest.participants = ReadIds(in);
+            quest.syncOwner = in.ReadVarUInt32();
+        }
+
+        void WriteEconomyRecord(BinaryWriter& out, const PlayerEconomyData& economy)
+        {
+            out.WriteVarUInt(economy.playerId);
+            WriteCountMap(out, economy.currencies);
+            WriteCountMap(out, economy.inventory);
+            out.WriteVarUInt(economy.totalWeight);
+            out.WriteVarUInt(economy.maxWeight);
+            WriteIds(out, economy.transactionHistory);
+            WriteTime(out, economy.lastUpdate);
+        }
+
+        void ReadEconomyRecord(BinaryReader& in, uint32_t /*version*/, PlayerEconomyData& economy)
+        {
+            economy.playerId = in.ReadVarUInt32();
+            economy.currencies = ReadCountMap<CurrencyType>(in);
+            economy.inventory = ReadCountMap<uint32_t, Inventory>(in);
+            economy.totalWeight = in.ReadVarUInt32();
+            economy.maxWeight = in.ReadVarUInt32();
+            economy.transactionHistory = ReadIds(in);
+            economy.lastUpdate = ReadTime(in);
+        }
+
+        void WriteSkill(BinaryWriter& out, const SkillData& skill)
+        {
+            out.WriteVarUInt(skill.skillId);
+            out.WriteString(skill.name);
+            out.WriteString(skill.description);
+            out.WriteEnum(skill.category);
+            out.WriteVarUInt(skill.maxLevel);
+            out.WriteVarUInt(skill.currentLevel);
+            out.WriteVarUInt(skill.experienceRequired);
+            WriteIds(out, skill.prerequisites);
+            out.WriteBool(skill.isUnlocked);
+            out.WriteBool(skill.isActive);
+        }
+
+        void ReadSkill(BinaryReader& in, uint32_t /*version*/, SkillData& skill)
+        {
+            skill.skillId = in.ReadVarUInt32();
+            skill.name = in.ReadString();
+            skill.description = in.ReadString();
+            skill.category = in.ReadEnum<SkillCategory>();
+            skill.maxLevel = in.ReadVarUInt32();
+            skill.currentLevel = in.ReadVarUInt32();
+            skill.experienceRequired = in.ReadVarUInt32();
+            skill.prerequisites = ReadIds(in);
+            skill.isUnlocked = in.ReadBool();
+            skill.isActive = in.ReadBool();
+        }
+
+        void WriteProgressionRecord(BinaryWriter& out, const PlayerProgressionData& progression)
+        {
+            out.WriteVarUInt(progression.playerId);
+            out.WriteVarUInt(progression.level);
+            out.WriteVarUInt(progression.experience);
+            out.WriteVarUInt(progression.experienceToNextLevel);
+            out.WriteVarUInt(progression.skillPoints);
+            out.WriteVarUInt(progression.abilityPoints);
+            WriteRecordMap(out, progression.skills, WriteSkill);
+            WriteIds(out, progression.unlockedAbilities);
+            WriteIds(out, progression.activeAbilities);
+            WriteTime(out, progression.lastUpdate);
+        }
+
+        void ReadProgressionRecord(BinaryReader& in, uint32_t version, PlayerProgressionData& progression)
+        {
+            progression.playerId = in.ReadVarUInt32();
+            progression.level = in.ReadVarUInt32();
+            progression.experience = in.ReadVarUInt32();
+            progression.experienceToNextLevel = in.ReadVarUInt32();
+            progression.skillPoints = in.ReadVarUInt32();
+            progression.abilityPoints = in.ReadVarUInt32();
+            if (!ReadRecordMap(in, version, progression.skills, ReadSkill))
+            {
+                in.Fail();
+                return;
+            }
+            progression.unlockedAbilities = ReadIds(in);
+            progression.activeAbilities = ReadIds(in);
+            progression.lastUpdate = ReadTime(in);
+        }
+
+        void WriteGroup(BinaryWriter& out, const QuestGroup& group)
+        {
+            out.WriteVarUInt(group.groupId);
+            out.WriteString(group.name);
+            WriteIds(out, group.members);
+            out.WriteVarUInt(group.leader);
+            WriteIds(out, group.activeQuests);
+            out.WriteVarUInt(group.questStates.size());
+            for (const auto& pair : group.questStates)
+            {
+                out.WriteVarUInt(pair.first);
+                out.WriteEnum(pair.second);
+            }
+            WriteTime(out, group.createdTime);
+            out.WriteBool(group.isActive);
+        }
+
+        void ReadGroup(BinaryReader& in, uint32_t /*version*/, QuestGroup& group)
+        {
+            group.groupId = in.ReadVarUInt32();
+            group.name = in.ReadString();
+            group.members = ReadIds(in);
+            group.leader = in.ReadVarUInt32();
+            group.activeQuests = ReadIds(in);
+            group.questStates.clear();
+            uint32_t count = in.ReadCount();
+            for (uint32_t i = 0; i < count && in.IsValid(); ++i)
+            {
+                uint32_t questId = in.ReadVarUInt32();
+                group.questStates[questId] = in.ReadEnum<QuestState>();
+            }
+            group.createdTime = ReadTime(in);
+            group.isActive = in.ReadBool();
+        }
+
+        // Section bodies shared by the standalone and world-nested forms
+        bool ReadQuestsBody(BinaryReader& body, uint32_t version, std::vector<QuestData>& quests)
+        {
+            quests.clear();
+            quests.resize(body.ReadCount());
+            for (auto& quest : quests)
+            {
+                BinaryReader record = body.ReadRecord();
+                ReadQuest(record, version, quest);
+                if (!record.IsValid())
+                {
+                    return false;
+                }
+            }
+            return body.IsValid();
+        }
+
+        bool ReadWorldStatesBody(BinaryReader& body, std::map<std::string, bool>& states)
+        {
+            states.clear();
+            uint32_t count = body.ReadCount();
+            for (uint32_t i = 0; i < count && body.IsValid(); ++i)
+            {
+                std::string key = body.ReadString();
+                states[key] = body.ReadBool();
+            }
+            return body.IsValid();
+        }
+
+        void WriteWorldStates(BinaryWriter& out, const std::map<std::string, bool>& states)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::WorldStates), WorldStatesVersion);
+            out.WriteVarUInt(states.size());
+            for (const auto& pair : states)
+            {
+                out.WriteString(pair.first);
+                out.WriteBool(pair.second);
+            }
+            out.EndSection(section);
+        }
+
+        // Shared by WorldSaveData and WorldSaveSnapshot, which hold the same
+        // parts by value and by snapshot
+        void WriteWorldSection(BinaryWriter& out, uint32_t worldId, const std::string& worldName,
+                               std::chrono::high_resolution_clock::time_point lastUpdate,
+                               const std::map<uint32_t, MonsterAIData>& monsters,
+                               const std::map<uint32_t, MerchantData>& merchants,
+                               const std::vector<QuestData>& quests,
+                               const std::map<std::string, bool>& worldStates)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::World), WorldVersion);
+            out.WriteVarUInt(worldId);
+            out.WriteString(worldName);
+            WriteTime(out, lastUpdate);
+
+            // Contents are nested sections so each part can evolve on its own
+            WriteIndexedSection(out, SaveSection::Monsters, MonstersVersion, SaveSection::MonsterIndex,
+                                monsters, WriteMonster);
+            WriteIndexedSection(out, SaveSection::Merchants, MerchantsVersion, SaveSection::MerchantIndex,
+                                merchants, WriteMerchant);
+            SaveSerialization::WriteQuests(out, quests);
+            WriteWorldStates(out, worldStates);
+            out.EndSection(section);
+        }
+    }
+
+    namespace SaveSerialization
+    {
+        void WritePlayer(BinaryWriter& out, const PlayerSaveData& player)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::Player), PlayerVersion);
+            out.WriteVarUInt(player.playerId);
+            out.WriteString(player.playerName);
+            WriteVector(out, player.position);
+            out.WriteFloat(player.rotation);
+            out.WriteVarUInt(player.level);
+            out.WriteVarUInt(player.experience);
+            WriteCountMap(out, player.inventory);
+            WriteCountMap(out, player.currencies);
+            WriteIds(out, player.activeQuests);
+            WriteIds(out, player.completedQuests);
+            WriteIds(out, player.unlockedSkills);
+            WriteIds(out, player.achievements);
+            WriteTime(out, player.lastSave);
+            out.EndSection(section);
+        }
+
+        bool ReadPlayer(BinaryReader& in, PlayerSaveData& player)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            if (!FindSection(in, SaveSection::Player, body, version))
+            {
+                return false;
+            }
+
+            player.playerId = body.ReadVarUInt32();
+            player.playerName = body.ReadString();
+            player.position = ReadVector(body);
+            player.rotation = body.ReadFloat();
+            player.level = body.ReadVarUInt32();
+            player.experience = body.ReadVarUInt32();
+            player.inventory = ReadCountMap<uint32_t>(body);
+            player.currencies = ReadCountMap<CurrencyType>(body);
+            player.activeQuests = ReadIds(body);
+            player.completedQuests = ReadIds(body);
+            player.unlockedSkills = ReadIds(body);
+            player.achievements = ReadIds(body);
+            player.lastSave = ReadTime(body);
+            return body.IsValid();
+        }
+
+        void WriteWorld(BinaryWriter& out, const WorldSaveData& world)
+        {
+            WriteWorldSection(out, world.worldId, world.worldName, world.lastUpdate,
+                              world.monsters, world.merchants, world.quests, world.worldStates);
+        }
+
+        void WriteWorld(BinaryWriter& out, const WorldSaveSnapshot& world)
+        {
+            WriteWorldSection(out, world.worldId, world.worldName, world.lastUpdate,
+                              *world.monsters, *world.merchants, *world.quests, *world.worldStates);
+        }
+
+        bool ReadWorld(BinaryReader& in, WorldSaveData& world)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            if (!FindSection(in, SaveSection::World, body, version))
+            {
+                return false;
+            }
+
+            world.worldId = body.ReadVarUInt32();
+            world.worldName = body.ReadString();
+            world.lastUpdate = ReadTime(body);
+
+            uint32_t tag = 0;
+            uint32_t partVersion = 0;
+            BinaryReader part;
+            while (body.NextSection(tag, partVersion, part))
+            {
+                bool ok = true;
+                switch (static_cast<SaveSection>(tag))
+                {
+                case SaveSection::Monsters:
+                    ok = ReadRecordMap(part, partVersion, world.monsters, ReadMonster);
+                    break;
+                case SaveSection::Merchants:
+                    ok = ReadRecordMap(part, partVersion, world.merchants, ReadMerchant);
+                    break;
+                case SaveSection::Quests:
+                    ok = ReadQuestsBody(part, partVersion, world.quests);
+                    break;
+                case SaveSection::WorldStates:
+                    ok = ReadWorldStatesBody(part, world.worldStates);
+                    break;
+                default:
+                    // Written by a newer version; skipped
+                    break;
+                }
+
+                if (!ok)
+                {
+                    return false;
+                }
+            }
+            return body.IsValid();
+        }
+
+        void WriteQuests(BinaryWriter& out, const std::vector<QuestData>& quests)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::Quests), QuestsVersion);
+            out.WriteVarUInt(quests.size());
+            for (const auto& quest : quests)
+            {
+                size_t record = out.BeginRecord();
+                WriteQuest(out, quest);
+                out.EndRecord(record);
+            }
+            out.EndSection(section);
+        }
+
+        bool ReadQuests(BinaryReader& in, std::vector<QuestData>& quests)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            return FindSection(in, SaveSection::Quests, body, version) && ReadQuestsBody(body, version, quests);
+        }
+
+        void WriteEconomy(BinaryWriter& out, const std::map<uint32_t, PlayerEconomyData>& economies)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::Economy), EconomyVersion);
+            WriteRecordMap(out, economies, WriteEconomyRecord);
+            out.EndSection(section);
+        }
+
+        bool ReadEconomy(BinaryReader& in, std::map<uint32_t, PlayerEconomyData>& economies)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            return FindSection(in, SaveSection::Economy, body, version) &&
+                   ReadRecordMap(body, version, economies, ReadEconomyRecord);
+        }
+
+        void WriteProgression(BinaryWriter& out, const std::map<uint32_t, PlayerProgressionData>& progressions)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::Progression), ProgressionVersion);
+            WriteRecordMap(out, progressions, WriteProgressionRecord);
+            out.EndSection(section);
+        }
+
+        bool ReadProgression(BinaryReader& in, std::map<uint32_t, PlayerProgressionData>& progressions)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            return FindSection(in, SaveSection::Progression, body, version) &&
+                   ReadRecordMap(body, version, progressions, ReadProgressionRecord);
+        }
+
+        void WriteMonsters(BinaryWriter& out, const std::map<uint32_t, MonsterAIData>& monsters)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::Monsters), MonstersVersion);
+            WriteRecordMap(out, monsters, WriteMonster);
+            out.EndSection(section);
+        }
+
+        bool ReadMonsters(BinaryReader& in, std::map<uint32_t, MonsterAIData>& monsters)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            return FindSection(in, SaveSection::Monsters, body, version) &&
+                   ReadRecordMap(body, version, monsters, ReadMonster);
+        }
+
+        void WriteGroups(BinaryWriter& out, const std::map<uint32_t, QuestGroup>& groups)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::Groups), GroupsVersion);
+            WriteRecordMap(out, groups, WriteGroup);
+            out.EndSection(section);
+        }
+
+        bool ReadGroups(BinaryReader& in, std::map<uint32_t, QuestGroup>& groups)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            return FindSection(in, SaveSection::Groups, body, version) &&
+                   ReadRecordMap(body, version, groups, ReadGroup);
+        }
+
+        void WriteItems(BinaryWriter& out, const std::map<uint32_t, ItemData>& items)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::Items), ItemsVersion);
+            WriteRecordMap(out, items, WriteItem);
+            out.EndSection(section);
+        }
+
+        bool ReadItems(BinaryReader& in, std::map<uint32_t, ItemData>& items)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            return FindSection(in, SaveSection::Items, body, version) &&
+                   ReadRecordMap(body, version, items, ReadItem);
+        }
+
+        void WriteMerchants(BinaryWriter& out, const std::map<uint32_t, MerchantData>& merchants)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::Merchants), MerchantsVersion);
+            WriteRecordMap(out, merchants, WriteMerchant);
+            out.EndSection(section);
+        }
+
+        bool ReadMerchants(BinaryReader& in, std::map<uint32_t, MerchantData>& merchants)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            return FindSection(in, SaveSection::Merchants, body, version) &&
+                   ReadRecordMap(body, version, merchants, ReadMerchant);
+        }
+
+        void WriteTransactions(BinaryWriter& out, const std::vector<TransactionData>& transactions)
+        {
+            size_t section = out.BeginSection(static_cast<uint32_t>(SaveSection::Transactions), TransactionsVersion);
+            out.WriteVarUInt(transactions.size());
+            for (const auto& transaction : transactions)
+            {
+                size_t record = out.BeginRecord();
+                WriteTransaction(out, transaction);
+                out.EndRecord(record);
+            }
+            out.EndSection(section);
+        }
+
+        bool ReadTransactions(BinaryReader& in, std::vector<TransactionData>& transactions)
+        {
+            BinaryReader body;
+            uint32_t version = 0;
+            if (!FindSection(in, SaveSection::Transactions, body, version))
+            {
+                return false;
+            }
+
+            transactions.clear();
+            uint32_t count = body.ReadCount();
+            transactions.reserve(count);
+            for (uint32_t i = 0; i < count && body.IsValid(); ++i)
+            {
+                BinaryReader record = body.ReadRecord();
+                TransactionData transaction;
+                ReadTransaction(record, version, transaction);
+                if (!record.IsValid())
+                {
+                    return false;
+                }
+                transactions.push_back(transaction);
+            }
+            return body.IsValid();
+        }
+    }
+
+    // WorldSaveView implementation
+    bool WorldSaveView::Open(std::vector<uint8_t> payload)
+    {
+        m_payload = std::move(payload);
+
+        BinaryReader in(m_payload);
+        BinaryReader body;
+        uint32_t version = 0;
+        if (!FindSection(in, SaveSection::World, body, version))
+        {
+            return false;
+        }
+
+        m_worldId = body.ReadVarUInt32();
+        m_worldName = body.ReadString();
+        m_lastUpdate = ReadTime(body);
+
+        const uint8_t* monsterIndex = nullptr;
+        const uint8_t* merchantIndex = nullptr;
+        size_t monsterIndexSize = 0;
+        size_t merchantIndexSize = 0;
+
+        uint32_t tag = 0;
+        uint32_t partVersion = 0;
+        BinaryReader part;
+        while (body.NextSection(tag, partVersion, part))
+        {
+            size_t size = part.GetRemaining();
+            const uint8_t* data = size > 0 ? part.ReadBytes(size) : nullptr;
+
+            Part* target = nullptr;
+            switch (static_cast<SaveSection>(tag))
+            {
+            case SaveSection::Monsters:
+                target = &m_monstersPart;
+                break;
+            case SaveSection::Merchants:
+                target = &m_merchantsPart;
+                break;
+            case SaveSection::Quests:
+                target = &m_questsPart;
+                break;
+            case SaveSection::WorldStates:
+                target = &m_worldStatesPart;
+                break;
+            case SaveSection::MonsterIndex:
+                monsterIndex = data;
+                monsterIndexSize = size;
+                break;
+            case SaveSection::MerchantIndex:
+                merchantIndex = data;
+                merchantIndexSize = size;
+                break;
+            default:
+                // Written by a newer version; skipped
+                break;
+            }
+
+            if (target)
+            {
+                target->data = data;
+                target->size = size;
+                target->version = partVersion;
+                target->present = true;
+            }
+        }
+
+        return body.IsValid() &&
+               OpenIndex(m_monstersPart, monsterIndex, monsterIndexSize, m_monsterIndex) &&
+               OpenIndex(m_merchantsPart, merchantIndex, merchantIndexSize, m_merchantIndex);
+    }
+
+    bool WorldSaveView::OpenIndex(const Part& part, const uint8_t* stored, size_t storedSize, RecordIndex& index)
+    {
+        index = RecordIndex();
+        if (!part.present)
+        {
+            return true;
+        }
+
+        BinaryReader body(part.data, part.size);
+        uint32_t count = body.ReadCount();
+        if (!body.IsValid())
+        {
+            return false;
+        }
+
+        // The stored index is used in place when it matches the section
+        if (stored && storedSize == static_cast<size_t>(count) * RecordIndexEntrySize)
+        {
+            index.entries = stored;
+            index.count = count;
+            return true;
+        }
+
+        // Saves without an index get one from a scan over the record headers;
+        // the records themselves are skipped, not decoded
+        std::vector<std::pair<uint32_t, uint32_t>> slots;
+        slots.reserve(count);
+        for (uint32_t i = 0; i < count && body.IsValid(); ++i)
+        {
+            uint32_t offset = static_cast<uint32_t>(part.size - body.GetRemaining());
+            uint32_t key = body.ReadVarUInt32();
+            body.ReadRecord();
+            slots.emplace_back(key, offset);
+        }
+        if (!body.IsValid())
+        {
+            return false;
+        }
+
+        std::sort(slots.begin(), slots.end());
+        index.built.reserve(slots.size() * RecordIndexEntrySize);
+        for (const auto& slot : slots)
+        {
+            AppendLittleEndian32(index.built, slot.first);
+            AppendLittleEndian32(index.built, slot.second);
+        }
+        index.entries = index.built.data();
+        index.count = count;
+        return true;
+    }
+
+    bool WorldSaveView::FindOffset(const RecordIndex& index, uint32_t key, uint32_t& offset)
+    {
+        uint32_t low = 0;
+        uint32_t high = index.count;
+        while (low < high)
+        {
+            uint32_t middle = low + (high - low) / 2;
+            const uint8_t* entry = index.entries + static_cast<size_t>(middle) * RecordIndexEntrySize;
+            uint32_t entryKey = ReadLittleEndian32(entry);
+            if (entryKey == key)
+            {
+                offset = ReadLittleEndian32(entry + 4);
+                return true;
+            }
+            if (entryKey < key)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return false;
+    }
+
+    bool WorldSaveView::FindMonster(uint32_t monsterId, MonsterAIData& monster) const
+    {
+        uint32_t offset = 0;
+        return FindOffset(m_monsterIndex, monsterId, offset) &&
+               ReadRecordAt(m_monstersPart.data, m_monstersPart.size, offset, monsterId,
+                            m_monstersPart.version, monster, ReadMonster);
+    }
+
+    bool WorldSaveView::FindMerchant(uint32_t merchantId, MerchantData& merchant) const
+    {
+        uint32_t offset = 0;
+        return FindOffset(m_merchantIndex, merchantId, offset) &&
+               ReadRecordAt(m_merchantsPart.data, m_merchantsPart.size, offset, merchantId,
+                            m_merchantsPart.version, merchant, ReadMerchant);
+    }
+
+    template<typename T, typename DecodeFn>
+    const T* WorldSaveView::DecodeOnce(const Part& part, T& value, DecodeFn decode) const
+    {
+        std::call_once(part.once, [&]()
+        {
+            // A world saved without this part has it empty
+            if (part.present)
+            {
+                BinaryReader body(part.data, part.size);
+                part.valid = decode(body, part.version, value);
+            }
+            else
+            {
+                part.valid = true;
+            }
+            part.decoded.store(true, std::memory_order_release);
+        });
+        return part.valid ? &value : nullptr;
+    }
+
+    const std::map<uint32_t, MonsterAIData>* WorldSaveView::GetMonsters() const
+    {
+        return DecodeOnce(m_monstersPart, m_monsters, [](BinaryReader& body, uint32_t version, std::map<uint32_t, MonsterAIData>& monsters)
+        {
+            return ReadRecordMap(body, version, monsters, ReadMonster);
+        });
+    }
+
+    const std::map<uint32_t, MerchantData>* WorldSaveView::GetMerchants() const
+    {
+        return DecodeOnce(m_merchantsPart, m_merchants, [](BinaryReader& body, uint32_t version, std::map<uint32_t, MerchantData>& merchants)
+        {
+            return ReadRecordMap(body, version, merchants, ReadMerchant);
+        });
+    }
+
+    const std::vector<QuestData>* WorldSaveView::GetQuests() const
+    {
+        return DecodeOnce(m_questsPart, m_quests, ReadQuestsBody);
+    }
+
+    const std::map<std::string, bool>* WorldSaveView::GetWorldStates() const
+    {
+        return DecodeOnce(m_worldStatesPart, m_worldStates, [](BinaryReader& body, uint32_t, std::map<std::string, bool>& states)
+        {
+            return ReadWorldStatesBody(body, states);
+        });
+    }
+
+    bool WorldSaveView::IsDecoded(SaveSection part) const
+    {
+        switch (part)
+        {
+        case SaveSection::Monsters:
+            return m_monstersPart.decoded.load(std::memory_order_acquire);
+        case SaveSection::Merchants:
+            return m_merchantsPart.decoded.load(std::memory_order_acquire);
+        case SaveSection::Quests:
+            return m_questsPart.decoded.load(std::memory_order_acquire);
+        case SaveSection::WorldStates:
+            return m_worldStatesPart.decoded.load(std::memory_order_acquire);
+        default:
+            return false;
+        }
+    }
+
+    bool WorldSaveView::Materialize(WorldSaveData& world) const
+    {
+        auto monsters = GetMonsters();
+        auto merchants = GetMerchants();
+        auto quests = GetQuests();
+        auto worldStates = GetWorldStates();
+        if (!monsters || !merchants || !quests || !worldStates)
+        {
+            return false;
+        }
+
+        world.worldId = m_worldId;
+        world.worldName = m_worldName;
+        world.lastUpdate = m_lastUpdate;
+        world.monsters = *monsters;
+        world.merchants = *merchants;
+        world.quests = *quests;
+        world.worldStates = *worldStates;
+        return true;
+    }
+}
@@ -1,12 +1,48 @@
 #include "game/SharedSaveSystem.h"
+#include "game/SaveSerialization.h"
+#include "utils/DurableFile.h"
 #include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+#include "utils/TraceRecorder.h"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 
 namespace Game
 {
+    // WorldSaveState implementation
+    WorldSaveState::WorldSaveState(WorldSaveData data)
+        : worldId(data.worldId),
+          worldName(std::move(data.worldName)),
+          monsters(std::move(data.monsters)),
+          merchants(std::move(data.merchants)),
+          quests(std::move(data.quests)),
+          worldStates(std::move(data.worldStates)),
+          lastUpdate(data.lastUpdate)
+    {
+    }
+
+    WorldSaveSnapshot WorldSaveState::Snapshot() const
+    {
+        WorldSaveSnapshot snapshot;
+        snapshot.worldId = worldId;
+        snapshot.worldName = worldName;
+        snapshot.monsters = monsters.Snapshot();
+        snapshot.merchants = merchants.Snapshot();
+        snapshot.quests = quests.Snapshot();
+        snapshot.worldStates = worldStates.Snapshot();
+        snapshot.lastUpdate = lastUpdate;
+        return snapshot;
+    }
+
+    std::chrono::steady_clock::duration WorldSaveState::TakeCloneTime()
+    {
+        return monsters.TakeCloneTime() + merchants.TakeCloneTime() +
+               quests.TakeCloneTime() + worldStates.TakeCloneTime();
+    }
+
     // SharedSaveSystem implementation
     SharedSaveSystem::SharedSaveSystem()
         : m_initialized(false), m_compressionEnabled(true), m_encryptionEnabled(false),
@@ -15,6 +51,9 @@ namespace Game
         m_lastAutoSave = std::chrono::high_resolution_clock::now();
         
         LOG_INFO("Shared save system created");
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("saves",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     SharedSaveSystem::~SharedSaveSystem()
@@ -41,9 +80,21 @@ namespace Game
             return false;
         }
 
+        if (!m_chunkStore.Open(m_saveDirectory + "/chunks"))
+        {
+            LOG_ERROR("Failed to open chunk store in: " + m_saveDirectory);
+            return false;
+        }
+
+        // Chunk compression, hashing and checksums of large saves fan out here
+        m_savePool = std::make_unique<ThreadPool>();
+        m_chunkStore.SetThreadPool(m_savePool.get());
+
         // Load existing metadata
         LoadMetadata();
 
+        StartSaveWorker();
+
         m_initialized = true;
         LOG_INFO("Shared save system initialized with directory: " + m_saveDirectory);
         return true;
@@ -57,9 +108,16 @@ namespace Game
         }
 
         LOG_INFO("Shutting down shared save system...");
+
+        // Finish queued saves so their metadata is written below
+        StopSaveWorker();
+        ProcessCompletedSaves();
+
+        m_chunkStore.SetThreadPool(nullptr);
+        m_savePool.reset();
         
         // Save metadata
-        SaveMetadata();
+        SaveMetadataFile();
         
         // Clear cached data
         m_saveMetadata.clear();
@@ -80,15 +138,13 @@ namespace Game
         saveData.saveId = m_nextSaveId++;
         saveData.saveName = "Player_" + std::to_string(playerId);
         saveData.type = SaveDataType::Player;
+        saveData.version = SaveSerialization::FormatVersion;
         saveData.data = SerializePlayerData(playerData);
         saveData.timestamp = std::chrono::high_resolution_clock::now();
         saveData.checksum = CalculateChecksum(saveData.data);
 
-        // Compress if enabled
-        if (m_compressionEnabled)
-        {
-            CompressSaveData(saveData.saveId);
-        }
+        // Chunks are compressed as they are stored
+        saveData.isCompressed = m_compressionEnabled;
 
         // Save to file
         std::string filePath = GetSaveFilePath(saveData.saveId);
@@ -135,15 +191,13 @@ namespace Game
         saveData.saveId = m_nextSaveId++;
         saveData.saveName = "World_" + std::to_string(worldId);
         saveData.type = SaveDataType::World;
+        saveData.version = SaveSerialization::FormatVersion;
         saveData.data = SerializeWorldData(worldData);
         saveData.timestamp = std::chrono::high_resolution_clock::now();
         saveData.checksum = CalculateChecksum(saveData.data);
 
-        // Compress if enabled
-        if (m_compressionEnabled)
-        {
-            CompressSaveData(saveData.saveId);
-        }
+        // Chunks are compressed as they are stored
+        saveData.isCompressed = m_compressionEnabled;
 
         // Save to file
         std::string filePath = GetSaveFilePath(saveData.saveId);
@@ -179,6 +233,134 @@ namespace Game
         return true;
     }
 
+    uint32_t SharedSaveSystem::SavePlayerDataAsync(uint32_t playerId, const PlayerSaveData& playerData)
+    {
+        auto stallStart = std::chrono::steady_clock::now();
+        if (!m_initialized)
+        {
+            return 0;
+        }
+
+        SaveJob job;
+        job.saveName = "Player_" + std::to_string(playerId);
+        job.description = "Player save data";
+        job.type = SaveDataType::Player;
+        job.player = std::make_shared<const PlayerSaveData>(playerData);
+        return QueueSave(std::move(job), stallStart);
+    }
+
+    uint32_t SharedSaveSystem::SavePlayerDataAsync(uint32_t playerId, std::shared_ptr<const PlayerSaveData> snapshot)
+    {
+        auto stallStart = std::chrono::steady_clock::now();
+        if (!m_initialized || !snapshot)
+        {
+            return 0;
+        }
+
+        SaveJob job;
+        job.saveName = "Player_" + std::to_string(playerId);
+        job.description = "Player save data";
+        job.type = SaveDataType::Player;
+        job.player = std::move(snapshot);
+        return QueueSave(std::move(job), stallStart);
+    }
+
+    uint32_t SharedSaveSystem::SavePlayerDataAsync(uint32_t playerId, CopyOnWrite<PlayerSaveData>& playerData)
+    {
+        // Clones made since the last save are tick-thread time saving caused
+        auto stallStart = std::chrono::steady_clock::now() - playerData.TakeCloneTime();
+        if (!m_initialized)
+        {
+            return 0;
+        }
+
+        SaveJob job;
+        job.saveName = "Player_" + std::to_string(playerId);
+        job.description = "Player save data";
+        job.type = SaveDataType::Player;
+        job.player = playerData.Snapshot();
+        return QueueSave(std::move(job), stallStart);
+    }
+
+    uint32_t SharedSaveSystem::SaveWorldDataAsync(uint32_t worldId, const WorldSaveData& worldData)
+    {
+        auto stallStart = std::chrono::steady_clock::now();
+        if (!m_initialized)
+        {
+            return 0;
+        }
+
+        SaveJob job;
+        job.saveName = "World_" + std::to_string(worldId);
+        job.description = "World save data";
+        job.type = SaveDataType::World;
+        job.world = std::make_shared<const WorldSaveData>(worldData);
+        return QueueSave(std::move(job), stallStart);
+    }
+
+    uint32_t SharedSaveSystem::SaveWorldDataAsync(uint32_t worldId, std::shared_ptr<const WorldSaveData> snapshot)
+    {
+        auto stallStart = std::chrono::steady_clock::now();
+        if (!m_initialized || !snapshot)
+        {
+            return 0;
+        }
+
+        SaveJob job;
+        job.saveName = "World_" + std::to_string(worldId);
+        job.description = "World save data";
+        job.type = SaveDataType::World;
+        job.world = std::move(snapshot);
+        return QueueSave(std::move(job), stallStart);
+    }
+
+    uint32_t SharedSaveSystem::SaveWorldDataAsync(uint32_t worldId, WorldSaveState& worldData)
+    {
+        // Clones made since the last save are tick-thread time saving caused
+        auto stallStart = std::chrono::steady_clock::now() - worldData.TakeCloneTime();
+        if (!m_initialized)
+        {
+            return 0;
+        }
+
+        SaveJob job;
+        job.saveName = "World_" + std::to_string(worldId);
+        job.description = "World save data";
+        job.type = SaveDataType::World;
+        job.worldParts = std::make_shared<const WorldSaveSnapshot>(worldData.Snapshot());
+        return QueueSave(std::move(job), stallStart);
+    }
+
+    size_t SharedSaveSystem::ProcessCompletedSaves()
+    {
+        std::vector<SaveResult> completed;
+        {
+            std::lock_guard<std::mutex> lock(m_saveQueueMutex);
+            completed.swap(m_completedSaves);
+        }
+
+        for (const auto& result : completed)
+        {
+            ApplySaveResult(result);
+        }
+        return completed.size();
+    }
+
+    void SharedSaveSystem::FlushPendingSaves()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_saveQueueMutex);
+            m_saveIdleCondition.wait(lock, [this]() { return m_savesInFlight == 0; });
+        }
+        ProcessCompletedSaves();
+    }
+
+    size_t SharedSaveSystem::GetPendingSaveCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_saveQueueMutex);
+        return m_savesInFlight;
+    }
+
     bool SharedSaveSystem::LoadPlayerData(uint32_t playerId, PlayerSaveData& playerData)
     {
         if (!m_initialized)
@@ -224,10 +406,12 @@ namespace Game
             return false;
         }
 
-        // Decompress if needed
-        if (saveData.isCompressed)
+        // Saves from before the binary archive format cannot be read
+        if (saveData.version < SaveSerialization::FormatVersion)
         {
-            DecompressSaveData(saveId);
+            LOG_WARNING("Unsupported save format version " + std::to_string(saveData.version) +
+                        " for player " + std::to_string(playerId));
+            return false;
         }
 
         // Deserialize data
@@ -248,68 +432,54 @@ namespace Game
 
     bool SharedSaveSystem::LoadWorldData(uint32_t worldId, WorldSaveData& worldData)
     {
-        if (!m_initialized)
-        {
-            return false;
-        }
-
-        // Find save file for world
         uint32_t saveId = 0;
-        for (const auto& pair : m_saveMetadata)
-        {
-            if (pair.second.saveName == "World_" + std::to_string(worldId))
-            {
-                saveId = pair.first;
-                break;
-            }
-        }
-
-        if (saveId == 0)
+        SaveData saveData;
+        if (!LoadWorldPayload(worldId, saveId, saveData))
         {
-            LOG_WARNING("No save data found for world " + std::to_string(worldId));
             return false;
         }
 
-        // Load save data
-        SaveData saveData;
-        std::string filePath = GetSaveFilePath(saveId);
-        if (!LoadDataFromFile(saveData, filePath))
+        // Deserialize data
+        if (!DeserializeWorldData(saveData.data, worldData))
         {
-            LOG_ERROR("Failed to load world data for world " + std::to_string(worldId));
+            LOG_ERROR("Failed to deserialize world data for world " + std::to_string(worldId));
             return false;
         }
 
-        // Verify checksum
-        if (!VerifyChecksum(saveData))
+        if (m_loadCompletedCallback)
         {
-            LOG_ERROR("Save data corrupted for world " + std::to_string(worldId));
-            m_stats.corruptedSaves++;
-            if (m_saveCorruptedCallback)
-            {
-                m_saveCorruptedCallback(saveId);
-            }
-            return false;
+            m_loadCompletedCallback(saveId, true);
         }
 
-        // Decompress if needed
-        if (saveData.isCompressed)
+        LOG_INFO("Loaded world data for world " + std::to_string(worldId));
+        return true;
+    }
+
+    bool SharedSaveSystem::OpenWorldSave(uint32_t worldId, std::shared_ptr<const WorldSaveView>& view)
+    {
+        TRACE_SCOPE_ARG("SharedSaveSystem::OpenWorldSave", "save", "worldId", worldId);
+
+        uint32_t saveId = 0;
+        SaveData saveData;
+        if (!LoadWorldPayload(worldId, saveId, saveData))
         {
-            DecompressSaveData(saveId);
+            return false;
         }
 
-        // Deserialize data
-        if (!DeserializeWorldData(saveData.data, worldData))
+        auto opened = std::make_shared<WorldSaveView>();
+        if (!opened->Open(std::move(saveData.data)))
         {
-            LOG_ERROR("Failed to deserialize world data for world " + std::to_string(worldId));
+            LOG_ERROR("Failed to open world data for world " + std::to_string(worldId));
             return false;
         }
+        view = std::move(opened);
 
         if (m_loadCompletedCallback)
         {
             m_loadCompletedCallback(saveId, true);
         }
 
-        LOG_INFO("Loaded world data for world " + std::to_string(worldId));
+        LOG_INFO("Opened world data for world " + std::to_string(worldId));
         return true;
     }
 
@@ -324,6 +494,7 @@ namespace Game
         saveData.saveId = m_nextSaveId++;
         saveData.saveName = saveName;
         saveData.type = SaveDataType::World;
+        saveData.version = SaveSerialization::FormatVersion;
         saveData.timestamp = std::chrono::high_resolution_clock::now();
         saveData.checksum = 0;
 
@@ -424,6 +595,7 @@ namespace Game
         // Remove from metadata
         m_saveMetadata.erase(it);
         m_stats.totalSaves--;
+        CollectGarbage();
 
         LOG_INFO("Deleted save: " + std::to_string(saveId));
         return true;
@@ -471,12 +643,13 @@ namespace Game
         std::string backupPath = GetBackupFilePath(saveId, backupId);
         std::string originalPath = GetSaveFilePath(saveId);
 
-        // Copy file
-        std::ifstream src(originalPath, std::ios::binary);
-        std::ofstream dst(backupPath, std::ios::binary);
-        dst << src.rdbuf();
-
-        if (!src || !dst)
+        // The save file is a manifest, so a backup copies only the chunk list;
+        // the chunks themselves are shared with the save
+        std::vector<uint8_t> manifest;
+        std::unique_lock<std::mutex> storageLock(m_storageMutex);
+        bool copied = ReadWholeFile(originalPath, manifest) && WriteFileDurably(backupPath, manifest);
+        storageLock.unlock();
+        if (!copied)
         {
             LOG_ERROR("Failed to create backup for save: " + std::to_string(saveId));
             return false;
@@ -487,6 +660,7 @@ namespace Game
         backupMetadata.saveId = backupId;
         backupMetadata.saveName = it->second.saveName + "_backup_" + std::to_string(backupId);
         backupMetadata.isBackup = true;
+        backupMetadata.backupOf = saveId;
         backupMetadata.createdTime = std::chrono::high_resolution_clock::now();
 
         UpdateSaveMetadata(backupId, backupMetadata);
@@ -497,10 +671,110 @@ namespace Game
             m_backupCreatedCallback(saveId, backupId);
         }
 
+        // Drop the oldest backups past the limit; their chunks go unless
+        // something else still uses them
+        std::vector<SaveMetadata> backups = GetBackups(saveId);
+        bool pruned = false;
+        for (size_t i = 0; i + m_maxBackups < backups.size(); ++i)
+        {
+            pruned = DeleteBackupFiles(saveId, backups[i].saveId) || pruned;
+        }
+        if (pruned)
+        {
+            CollectGarbage();
+        }
+
         LOG_INFO("Created backup for save: " + std::to_string(saveId));
         return true;
     }
 
+    bool SharedSaveSystem::RestoreFromBackup(uint32_t saveId, uint32_t backupId)
+    {
+        if (!m_initialized)
+        {
+            return false;
+        }
+
+        auto it = m_saveMetadata.find(backupId);
+        if (it == m_saveMetadata.end() || !it->second.isBackup || it->second.backupOf != saveId)
+        {
+            LOG_ERROR("Backup not found: " + std::to_string(backupId));
+            return false;
+        }
+
+        // The save's old chunks are left to the next collection
+        std::vector<uint8_t> manifest;
+        {
+            std::lock_guard<std::mutex> lock(m_storageMutex);
+            if (!ReadWholeFile(GetBackupFilePath(saveId, backupId), manifest) ||
+                !WriteFileDurably(GetSaveFilePath(saveId), manifest))
+            {
+                LOG_ERROR("Failed to restore save " + std::to_string(saveId) + " from backup " + std::to_string(backupId));
+                return false;
+            }
+        }
+
+        SaveMetadata metadata = it->second;
+        auto saveIt = m_saveMetadata.find(saveId);
+        if (saveIt != m_saveMetadata.end())
+        {
+            metadata.saveName = saveIt->second.saveName;
+        }
+        metadata.saveId = saveId;
+        metadata.isBackup = false;
+        metadata.backupOf = 0;
+        metadata.lastModified = std::chrono::high_resolution_clock::now();
+        UpdateSaveMetadata(saveId, metadata);
+
+        LOG_INFO("Restored save " + std::to_string(saveId) + " from backup " + std::to_string(backupId));
+        return true;
+    }
+
+    std::vector<SaveMetadata> SharedSaveSystem::GetBackups(uint32_t saveId) const
+    {
+        // Backup IDs come from the save ID counter, so map order is age order
+        std::vector<SaveMetadata> backups;
+        for (const auto& pair : m_saveMetadata)
+        {
+            if (pair.second.isBackup && pair.second.backupOf == saveId)
+            {
+                backups.push_back(pair.second);
+            }
+        }
+        return backups;
+    }
+
+    bool SharedSaveSystem::DeleteBackup(uint32_t saveId, uint32_t backupId)
+    {
+        if (!m_initialized || !DeleteBackupFiles(saveId, backupId))
+        {
+            return false;
+        }
+
+        CollectGarbage();
+        return true;
+    }
+
+    bool SharedSaveSystem::DeleteBackupFiles(uint32_t saveId, uint32_t backupId)
+    {
+        auto it = m_saveMetadata.find(backupId);
+        if (it == m_saveMetadata.end() || !it->second.isBackup || it->second.backupOf != saveId)
+        {
+            return false;
+        }
+
+        std::string backupPath = GetBackupFilePath(saveId, backupId);
+        if (!DeleteFile(backupPath))
+        {
+            LOG_ERROR("Failed to delete backup file: " + backupPath);
+            return false;
+        }
+
+        m_saveMetadata.erase(it);
+        m_stats.totalBackups--;
+        return true;
+    }
+
     bool SharedSaveSystem::ValidateSaveData(uint32_t saveId)
     {
         if (!m_initialized)
@@ -607,14 +881,31 @@ namespace Game
         m_autoSaveInterval = interval;
     }
 
-    SharedSaveSystem::SaveStats SharedSaveSystem::GetStats() const
+    SaveStats SharedSaveSystem::GetStats() const
     {
-        return m_stats;
+        SaveStats stats = m_stats;
+        stats.pendingSaves = static_cast<uint32_t>(GetPendingSaveCount());
+        stats.averageStallTime = static_cast<float>(m_saveStallTimes.GetMean() / 1000.0);
+        stats.p99StallTime = m_saveStallTimes.GetPercentile(99.0) / 1000.0f;
+        stats.maxStallTime = m_saveStallTimes.GetMax() / 1000.0f;
+
+        ChunkStoreStats chunkStats = m_chunkStore.GetStats();
+        stats.chunksWritten = chunkStats.chunksWritten;
+        stats.chunksReused = chunkStats.chunksReused;
+        stats.chunkBytesWritten = chunkStats.bytesWritten;
+        stats.chunksCollected = chunkStats.chunksCollected;
+        if (chunkStats.bytesWritten > 0)
+        {
+            stats.compressionRatio = static_cast<float>(chunkStats.bytesStored) / chunkStats.bytesWritten;
+        }
+        return stats;
     }
 
     void SharedSaveSystem::ResetStats()
     {
         m_stats.Reset();
+        m_saveStallTimes.Reset();
+        m_saveWriteTimes.Reset();
     }
 
     void SharedSaveSystem::PrintStats() const
@@ -627,9 +918,43 @@ namespace Game
         LOG_INFO("Average save time: " + std::to_string(m_stats.averageSaveTime) + "ms");
         LOG_INFO("Compression ratio: " + std::to_string(m_stats.compressionRatio * 100.0f) + "%");
         LOG_INFO("Last save ID: " + std::to_string(m_stats.lastSaveId));
+        LOG_INFO("Async saves: " + std::to_string(m_stats.asyncSaves) + " (" +
+                 std::to_string(m_stats.coalescedSaves) + " coalesced, " +
+                 std::to_string(m_stats.failedSaves) + " failed)");
+        LOG_INFO("Tick stall: p99 " + std::to_string(m_saveStallTimes.GetPercentile(99.0) / 1000.0f) +
+                 "ms, max " + std::to_string(m_saveStallTimes.GetMax() / 1000.0f) + "ms");
+        ChunkStoreStats chunkStats = m_chunkStore.GetStats();
+        LOG_INFO("Chunks: " + std::to_string(m_chunkStore.GetChunkCount()) + " stored, " +
+                 std::to_string(chunkStats.chunksWritten) + " written, " +
+                 std::to_string(chunkStats.chunksReused) + " reused, " +
+                 std::to_string(chunkStats.chunksCollected) + " collected");
         LOG_INFO("====================================");
     }
 
+    void SharedSaveSystem::CollectMetrics(MetricsWriter& out) const
+    {
+        out.Counter("tw3_saves_total", "Saves written", static_cast<double>(m_stats.totalSaves));
+        out.Counter("tw3_saves_corrupted_total", "Saves that failed validation", static_cast<double>(m_stats.corruptedSaves));
+        out.Counter("tw3_saves_backups_total", "Backups created", static_cast<double>(m_stats.totalBackups));
+        out.Counter("tw3_saves_bytes_total", "Bytes written by saves", static_cast<double>(m_stats.totalSize));
+        out.Gauge("tw3_saves_duration_seconds", "Average save time", m_stats.averageSaveTime / 1000.0);
+        out.Gauge("tw3_saves_compression_ratio", "Compressed size over original size", m_stats.compressionRatio);
+        out.Counter("tw3_saves_async_total", "Saves handed to the save worker", static_cast<double>(m_stats.asyncSaves));
+        out.Counter("tw3_saves_coalesced_total", "Queued saves replaced by a newer snapshot", static_cast<double>(m_stats.coalescedSaves));
+        out.Counter("tw3_saves_failed_total", "Async saves that could not be written", static_cast<double>(m_stats.failedSaves));
+        out.Gauge("tw3_saves_pending", "Saves queued or being written", static_cast<double>(GetPendingSaveCount()));
+        out.Summary("tw3_saves_stall_seconds", "Tick-thread time spent starting an async save", m_saveStallTimes, 1e-6);
+        out.Summary("tw3_saves_write_seconds", "Worker time to serialize and durably write a save", m_saveWriteTimes, 1e-6);
+
+        ChunkStoreStats chunkStats = m_chunkStore.GetStats();
+        out.Gauge("tw3_saves_chunks", "Chunks in the save chunk store", static_cast<double>(m_chunkStore.GetChunkCount()));
+        out.Counter("tw3_saves_chunks_written_total", "New chunks written by saves", static_cast<double>(chunkStats.chunksWritten));
+        out.Counter("tw3_saves_chunks_reused_total", "Chunks a save shared with stored ones", static_cast<double>(chunkStats.chunksReused));
+        out.Counter("tw3_saves_chunk_bytes_written_total", "Bytes of new chunks written", static_cast<double>(chunkStats.bytesWritten));
+        out.Counter("tw3_saves_chunk_bytes_stored_total", "Bytes those chunks take on disk after compression", static_cast<double>(chunkStats.bytesStored));
+        out.Counter("tw3_saves_chunks_collected_total", "Unreferenced chunks deleted", static_cast<double>(chunkStats.chunksCollected));
+    }
+
     // Callback setters
     void SharedSaveSystem::SetSaveCompletedCallback(SaveCompletedCallback callback)
     {
@@ -652,65 +977,481 @@ namespace Game
     }
 
     // Private methods
+    uint32_t SharedSaveSystem::QueueSave(SaveJob job, std::chrono::steady_clock::time_point stallStart)
+    {
+        job.compress = m_compressionEnabled;
+
+        uint32_t saveId = 0;
+        bool coalesced = false;
+        {
+            std::lock_guard<std::mutex> lock(m_saveQueueMutex);
+
+            // A queued save for the same player/world that has not started yet
+            // is superseded: keep its ID and slot, take the newer snapshot
+            for (auto& queued : m_saveQueue)
+            {
+                if (!queued.collectGarbage && queued.saveName == job.saveName)
+                {
+                    job.saveId = queued.saveId;
+                    std::swap(queued, job);
+                    saveId = queued.saveId;
+                    coalesced = true;
+                    break;
+                }
+            }
+
+            if (!coalesced)
+            {
+                saveId = m_nextSaveId++;
+                job.saveId = saveId;
+                m_saveQueue.push_back(std::move(job));
+                m_savesInFlight++;
+            }
+        }
+
+        if (!coalesced)
+        {
+            m_saveQueueCondition.notify_one();
+        }
+
+        m_stats.asyncSaves++;
+        if (coalesced)
+        {
+            m_stats.coalescedSaves++;
+        }
+
+        auto stall = std::chrono::steady_clock::now() - stallStart;
+        m_saveStallTimes.Record(std::chrono::duration_cast<std::chrono::microseconds>(stall).count());
+        return saveId;
+    }
+
+    void SharedSaveSystem::CollectGarbage()
+    {
+        if (!m_initialized)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_saveQueueMutex);
+
+            // One queued collection covers every deletion before it runs
+            for (const auto& queued : m_saveQueue)
+            {
+                if (queued.collectGarbage)
+                {
+                    return;
+                }
+            }
+
+            SaveJob job;
+            job.collectGarbage = true;
+            m_saveQueue.push_back(std::move(job));
+            m_savesInFlight++;
+        }
+        m_saveQueueCondition.notify_one();
+    }
+
+    SharedSaveSystem::SaveResult SharedSaveSystem::WriteSave(const SaveJob& job)
+    {
+        TRACE_SCOPE_ARG("SharedSaveSystem::WriteSave", "save", "saveId", job.saveId);
+        auto start = std::chrono::steady_clock::now();
+
+        SaveData saveData;
+        saveData.saveId = job.saveId;
+        saveData.saveName = job.saveName;
+        saveData.type = job.type;
+        saveData.version = SaveSerialization::FormatVersion;
+        if (job.player)
+        {
+            saveData.data = SerializePlayerData(*job.player);
+        }
+        else if (job.worldParts)
+        {
+            saveData.data = SerializeWorldData(*job.worldParts);
+        }
+        else
+        {
+            saveData.data = SerializeWorldData(*job.world);
+        }
+        saveData.timestamp = std::chrono::high_resolution_clock::now();
+        saveData.checksum = CalculateChecksum(saveData.data);
+
+        // Chunks are compressed as they are stored
+        saveData.isCompressed = job.compress;
+
+        SaveResult result;
+        result.saveId = saveData.saveId;
+        result.saveName = saveData.saveName;
+        result.description = job.description;
+        result.success = SaveDataToFile(saveData, GetSaveFilePath(saveData.saveId));
+        result.version = saveData.version;
+        result.checksum = saveData.checksum;
+        result.size = static_cast<uint32_t>(saveData.data.size());
+        result.timestamp = saveData.timestamp;
+        result.writeMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    void SharedSaveSystem::SaveWorkerThread()
+    {
+        TraceRecorder::GetInstance().SetThreadName("save-worker");
+
+        while (true)
+        {
+            SaveJob job;
+            {
+                std::unique_lock<std::mutex> lock(m_saveQueueMutex);
+                m_saveQueueCondition.wait(lock, [this]() { return m_stopSaveWorker || !m_saveQueue.empty(); });
+
+                // Stopping only once the queue is drained
+                if (m_saveQueue.empty())
+                {
+                    return;
+                }
+
+                job = std::move(m_saveQueue.front());
+                m_saveQueue.pop_front();
+            }
+
+            if (job.collectGarbage)
+            {
+                RunGarbageCollection();
+                {
+                    std::lock_guard<std::mutex> lock(m_saveQueueMutex);
+                    m_savesInFlight--;
+                }
+                m_saveIdleCondition.notify_all();
+                continue;
+            }
+
+            SaveResult result = WriteSave(job);
+
+            // Drop the snapshot before reporting so the owner's next write
+            // does not have to clone it
+            job = SaveJob();
+
+            {
+                std::lock_guard<std::mutex> lock(m_saveQueueMutex);
+                m_completedSaves.push_back(std::move(result));
+                m_savesInFlight--;
+            }
+            m_saveIdleCondition.notify_all();
+        }
+    }
+
+    void SharedSaveSystem::StartSaveWorker()
+    {
+        if (m_saveWorker.joinable())
+        {
+            return;
+        }
+
+        m_stopSaveWorker = false;
+        m_saveWorker = std::thread(&SharedSaveSystem::SaveWorkerThread, this);
+    }
+
+    void SharedSaveSystem::StopSaveWorker()
+    {
+        if (!m_saveWorker.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_saveQueueMutex);
+            m_stopSaveWorker = true;
+        }
+        m_saveQueueCondition.notify_all();
+        m_saveWorker.join();
+    }
+
+    void SharedSaveSystem::ApplySaveResult(const SaveResult& result)
+    {
+        m_saveWriteTimes.Record(result.writeMicros);
+        m_stats.averageSaveTime = static_cast<float>(m_saveWriteTimes.GetMean() / 1000.0);
+
+        if (!result.success)
+        {
+            LOG_ERROR("Failed to write save " + std::to_string(result.saveId) + " (" + result.saveName + ")");
+            m_stats.failedSaves++;
+            if (m_saveCompletedCallback)
+            {
+                m_saveCompletedCallback(result.saveId, false);
+            }
+            return;
+        }
+
+        SaveMetadata metadata;
+        metadata.saveId = result.saveId;
+        metadata.saveName = result.saveName;
+        metadata.description = result.description;
+        metadata.version = result.version;
+        metadata.createdTime = result.timestamp;
+        metadata.lastModified = result.timestamp;
+        metadata.fileSize = result.size;
+        metadata.checksum = std::to_string(result.checksum);
+        metadata.isCorrupted = false;
+        metadata.isBackup = false;
+
+        UpdateSaveMetadata(result.saveId, metadata);
+        m_stats.totalSaves++;
+        m_stats.totalSize += result.size;
+        m_stats.lastSaveId = result.saveId;
+
+        if (m_saveCompletedCallback)
+        {
+            m_saveCompletedCallback(result.saveId, true);
+        }
+    }
+
     bool SharedSaveSystem::SaveDataToFile(const SaveData& saveData, const std::string& filePath)
     {
-        std::ofstream file(filePath, std::ios::binary);
-        if (!file.is_open())
+        // The payload goes to the chunk store and the file only lists its
+        // chunks. Holding the storage lock until the manifest is on disk keeps
+        // garbage collection from deleting chunks that only it references.
+        std::lock_guard<std::mutex> lock(m_storageMutex);
+
+        std::vector<ChunkRef> refs;
+        if (!m_chunkStore.Store(saveData.data, refs, saveData.isCompressed))
         {
             return false;
         }
+        return WriteManifest(saveData, refs, filePath);
+    }
 
-        // Write save data
-        file.write(reinterpret_cast<const char*>(&saveData.saveId), sizeof(saveData.saveId));
-        file.write(saveData.saveName.c_str(), saveData.saveName.length() + 1);
-        file.write(reinterpret_cast<const char*>(&saveData.type), sizeof(saveData.type));
-        file.write(reinterpret_cast<const char*>(&saveData.timestamp), sizeof(saveData.timestamp));
-        file.write(reinterpret_cast<const char*>(&saveData.version), sizeof(saveData.version));
-        file.write(reinterpret_cast<const char*>(&saveData.isCompressed), sizeof(saveData.isCompressed));
-        file.write(reinterpret_cast<const char*>(&saveData.isEncrypted), sizeof(saveData.isEncrypted));
-        file.write(reinterpret_cast<const char*>(&saveData.checksum), sizeof(saveData.checksum));
-        
-        // Write data size and data
-        uint32_t dataSize = saveData.data.size();
-        file.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
-        file.write(reinterpret_cast<const char*>(saveData.data.data()), dataSize);
+    bool SharedSaveSystem::WriteManifest(const SaveData& header, const std::vector<ChunkRef>& refs, const std::string& filePath)
+    {
+        std::vector<uint8_t> manifest;
+        auto write = [&manifest](const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            manifest.insert(manifest.end(), bytes, bytes + size);
+        };
+
+        uint32_t dataSize = 0;
+        for (const auto& ref : refs)
+        {
+            dataSize += ref.size;
+        }
+
+        uint32_t chunkCount = static_cast<uint32_t>(refs.size());
+        write(&header.saveId, sizeof(header.saveId));
+        write(header.saveName.c_str(), header.saveName.length() + 1);
+        write(&header.type, sizeof(header.type));
+        write(&header.timestamp, sizeof(header.timestamp));
+        write(&header.version, sizeof(header.version));
+        write(&header.isCompressed, sizeof(header.isCompressed));
+        write(&header.isEncrypted, sizeof(header.isEncrypted));
+        write(&header.checksum, sizeof(header.checksum));
+        write(&dataSize, sizeof(dataSize));
+        write(&chunkCount, sizeof(chunkCount));
+        for (const auto& ref : refs)
+        {
+            write(&ref.hash.high, sizeof(ref.hash.high));
+            write(&ref.hash.low, sizeof(ref.hash.low));
+            write(&ref.size, sizeof(ref.size));
+        }
+
+        return WriteFileDurably(filePath, manifest);
+    }
+
+    bool SharedSaveSystem::RecodeSave(uint32_t saveId, bool compress)
+    {
+        if (!m_initialized || m_saveMetadata.find(saveId) == m_saveMetadata.end())
+        {
+            return false;
+        }
+
+        // Chunks shared with other saves are recoded for them too, which is
+        // harmless: the content and the hashes stay the same
+        std::lock_guard<std::mutex> lock(m_storageMutex);
+        std::string filePath = GetSaveFilePath(saveId);
+        SaveData header;
+        std::vector<ChunkRef> refs;
+        if (!ReadManifest(filePath, header, refs) || !m_chunkStore.Recode(refs, compress))
+        {
+            LOG_ERROR("Failed to recode save: " + std::to_string(saveId));
+            return false;
+        }
 
-        return file.good();
+        header.isCompressed = compress;
+        return WriteManifest(header, refs, filePath);
     }
 
     bool SharedSaveSystem::LoadDataFromFile(SaveData& saveData, const std::string& filePath)
     {
-        std::ifstream file(filePath, std::ios::binary);
-        if (!file.is_open())
+        std::vector<ChunkRef> refs;
+        if (!ReadManifest(filePath, saveData, refs))
         {
             return false;
         }
+        return m_chunkStore.Load(refs, saveData.data);
+    }
 
-        // Read save data
-        file.read(reinterpret_cast<char*>(&saveData.saveId), sizeof(saveData.saveId));
-        
-        std::string name;
-        char c;
-        while (file.get(c) && c != '\0')
+    bool SharedSaveSystem::LoadWorldPayload(uint32_t worldId, uint32_t& saveId, SaveData& saveData)
+    {
+        if (!m_initialized)
         {
-            name += c;
+            return false;
+        }
+
+        // Find save file for world
+        saveId = 0;
+        for (const auto& pair : m_saveMetadata)
+        {
+            if (pair.second.saveName == "World_" + std::to_string(worldId))
+            {
+                saveId = pair.first;
+                break;
+            }
+        }
+
+        if (saveId == 0)
+        {
+            LOG_WARNING("No save data found for world " + std::to_string(worldId));
+            return false;
+        }
+
+        // Load save data
+        std::string filePath = GetSaveFilePath(saveId);
+        if (!LoadDataFromFile(saveData, filePath))
+        {
+            LOG_ERROR("Failed to load world data for world " + std::to_string(worldId));
+            return false;
+        }
+
+        // Verify checksum
+        if (!VerifyChecksum(saveData))
+        {
+            LOG_ERROR("Save data corrupted for world " + std::to_string(worldId));
+            m_stats.corruptedSaves++;
+            if (m_saveCorruptedCallback)
+            {
+                m_saveCorruptedCallback(saveId);
+            }
+            return false;
+        }
+
+        // Saves from before the binary archive format cannot be read
+        if (saveData.version < SaveSerialization::FormatVersion)
+        {
+            LOG_WARNING("Unsupported save format version " + std::to_string(saveData.version) +
+                        " for world " + std::to_string(worldId));
+            return false;
+        }
+        return true;
+    }
+
+    bool SharedSaveSystem::ReadManifest(const std::string& filePath, SaveData& header, std::vector<ChunkRef>& refs) const
+    {
+        std::vector<uint8_t> manifest;
+        if (!ReadWholeFile(filePath, manifest))
+        {
+            return false;
+        }
+
+        size_t offset = 0;
+        auto read = [&manifest, &offset](void* data, size_t size)
+        {
+            if (manifest.size() - offset < size)
+            {
+                return false;
+            }
+            std::memcpy(data, manifest.data() + offset, size);
+            offset += size;
+            return true;
+        };
+
+        if (!read(&header.saveId, sizeof(header.saveId)))
+        {
+            return false;
+        }
+
+        auto nameEnd = std::find(manifest.begin() + offset, manifest.end(), uint8_t(0));
+        if (nameEnd == manifest.end())
+        {
+            return false;
+        }
+        header.saveName.assign(manifest.begin() + offset, nameEnd);
+        offset = static_cast<size_t>(nameEnd - manifest.begin()) + 1;
+
+        uint32_t dataSize = 0;
+        uint32_t chunkCount = 0;
+        if (!read(&header.type, sizeof(header.type)) ||
+            !read(&header.timestamp, sizeof(header.timestamp)) ||
+            !read(&header.version, sizeof(header.version)) ||
+            !read(&header.isCompressed, sizeof(header.isCompressed)) ||
+            !read(&header.isEncrypted, sizeof(header.isEncrypted)) ||
+            !read(&header.checksum, sizeof(header.checksum)) ||
+            !read(&dataSize, sizeof(dataSize)) ||
+            !read(&chunkCount, sizeof(chunkCount)))
+        {
+            return false;
+        }
+
+        const size_t refSize = sizeof(uint64_t) * 2 + sizeof(uint32_t);
+        if ((manifest.size() - offset) != static_cast<size_t>(chunkCount) * refSize)
+        {
+            return false;
+        }
+
+        refs.resize(chunkCount);
+        uint64_t total = 0;
+        for (auto& ref : refs)
+        {
+            read(&ref.hash.high, sizeof(ref.hash.high));
+            read(&ref.hash.low, sizeof(ref.hash.low));
+            read(&ref.size, sizeof(ref.size));
+            total += ref.size;
+        }
+        return total == dataSize;
+    }
+
+    void SharedSaveSystem::RunGarbageCollection()
+    {
+        TRACE_SCOPE("SharedSaveSystem::RunGarbageCollection", "save");
+        std::lock_guard<std::mutex> lock(m_storageMutex);
+
+        // Every save and backup manifest on disk counts, not just the ones in
+        // metadata, so files from earlier runs keep their chunks
+        ChunkHashSet live;
+        size_t manifests = 0;
+        std::error_code ec;
+        for (auto it = std::filesystem::directory_iterator(m_saveDirectory, ec);
+             !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+        {
+            if (!it->is_regular_file(ec) || it->path().extension() != ".dat")
+            {
+                continue;
+            }
+
+            SaveData header;
+            std::vector<ChunkRef> refs;
+            if (!ReadManifest(it->path().string(), header, refs))
+            {
+                // Collecting now could delete chunks this save still needs
+                LOG_WARNING("Skipping chunk collection, unreadable save manifest: " + it->path().string());
+                return;
+            }
+
+            for (const auto& ref : refs)
+            {
+                live.insert(ref.hash);
+            }
+            manifests++;
+        }
+
+        if (ec)
+        {
+            LOG_WARNING("Skipping chunk collection, cannot list save directory: " + m_saveDirectory);
+            return;
         }
-        saveData.saveName = name;
-        
-        file.read(reinterpret_cast<char*>(&saveData.type), sizeof(saveData.type));
-        file.read(reinterpret_cast<char*>(&saveData.timestamp), sizeof(saveData.timestamp));
-        file.read(reinterpret_cast<char*>(&saveData.version), sizeof(saveData.version));
-        file.read(reinterpret_cast<char*>(&saveData.isCompressed), sizeof(saveData.isCompressed));
-        file.read(reinterpret_cast<char*>(&saveData.isEncrypted), sizeof(saveData.isEncrypted));
-        file.read(reinterpret_cast<char*>(&saveData.checksum), sizeof(saveData.checksum));
-        
-        // Read data size and data
-        uint32_t dataSize;
-        file.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize));
-        saveData.data.resize(dataSize);
-        file.read(reinterpret_cast<char*>(saveData.data.data()), dataSize);
 
-        return file.good();
+        size_t removed = m_chunkStore.RemoveUnreferenced(live);
+        LOG_DEBUG("Collected " + std::to_string(removed) + " save chunks, " +
+                  std::to_string(live.size()) + " live in " + std::to_string(manifests) + " manifests");
     }
 
     std::string SharedSaveSystem::GetSaveFilePath(uint32_t saveId) const
@@ -730,86 +1471,146 @@ namespace Game
 
     std::vector<uint8_t> SharedSaveSystem::SerializePlayerData(const PlayerSaveData& playerData)
     {
-        // Simple serialization - in a real implementation, this would use a proper serialization library
-        std::vector<uint8_t> data;
-        
-        // Serialize player data
-        data.insert(data.end(), reinterpret_cast<const uint8_t*>(&playerData.playerId), 
-                   reinterpret_cast<const uint8_t*>(&playerData.playerId) + sizeof(playerData.playerId));
-        
-        // Serialize position
-        data.insert(data.end(), reinterpret_cast<const uint8_t*>(&playerData.position), 
-                   reinterpret_cast<const uint8_t*>(&playerData.position) + sizeof(playerData.position));
-        
-        // Serialize level and experience
-        data.insert(data.end(), reinterpret_cast<const uint8_t*>(&playerData.level), 
-                   reinterpret_cast<const uint8_t*>(&playerData.level) + sizeof(playerData.level));
-        data.insert(data.end(), reinterpret_cast<const uint8_t*>(&playerData.experience), 
-                   reinterpret_cast<const uint8_t*>(&playerData.experience) + sizeof(playerData.experience));
-        
-        return data;
+        BinaryWriter writer(256);
+        SaveSerialization::WritePlayer(writer, playerData);
+        return writer.TakeBuffer();
     }
 
     std::vector<uint8_t> SharedSaveSystem::SerializeWorldData(const WorldSaveData& worldData)
     {
-        // Simple serialization - in a real implementation, this would use a proper serialization library
-        std::vector<uint8_t> data;
-        
-        // Serialize world data
-        data.insert(data.end(), reinterpret_cast<const uint8_t*>(&worldData.worldId), 
-                   reinterpret_cast<const uint8_t*>(&worldData.worldId) + sizeof(worldData.worldId));
-        
-        return data;
+        BinaryWriter writer(4096 + worldData.monsters.size() * 160);
+        SaveSerialization::WriteWorld(writer, worldData);
+        return writer.TakeBuffer();
+    }
+
+    std::vector<uint8_t> SharedSaveSystem::SerializeWorldData(const WorldSaveSnapshot& worldData)
+    {
+        BinaryWriter writer(4096 + worldData.monsters->size() * 160);
+        SaveSerialization::WriteWorld(writer, worldData);
+        return writer.TakeBuffer();
+    }
+
+    std::vector<uint8_t> SharedSaveSystem::SerializeQuestData(const std::vector<QuestData>& quests)
+    {
+        BinaryWriter writer;
+        SaveSerialization::WriteQuests(writer, quests);
+        return writer.TakeBuffer();
+    }
+
+    std::vector<uint8_t> SharedSaveSystem::SerializeEconomyData(const std::map<uint32_t, PlayerEconomyData>& playerEconomies)
+    {
+        BinaryWriter writer;
+        SaveSerialization::WriteEconomy(writer, playerEconomies);
+        return writer.TakeBuffer();
+    }
+
+    std::vector<uint8_t> SharedSaveSystem::SerializeProgressionData(const std::map<uint32_t, PlayerProgressionData>& playerProgressions)
+    {
+        BinaryWriter writer;
+        SaveSerialization::WriteProgression(writer, playerProgressions);
+        return writer.TakeBuffer();
+    }
+
+    std::vector<uint8_t> SharedSaveSystem::SerializeMonsterData(const std::map<uint32_t, MonsterAIData>& monsters)
+    {
+        BinaryWriter writer(monsters.size() * 160);
+        SaveSerialization::WriteMonsters(writer, monsters);
+        return writer.TakeBuffer();
+    }
+
+    std::vector<uint8_t> SharedSaveSystem::SerializeGroupData(const std::map<uint32_t, QuestGroup>& groups)
+    {
+        BinaryWriter writer;
+        SaveSerialization::WriteGroups(writer, groups);
+        return writer.TakeBuffer();
     }
 
     bool SharedSaveSystem::DeserializePlayerData(const std::vector<uint8_t>& data, PlayerSaveData& playerData)
     {
-        // Simple deserialization - in a real implementation, this would use a proper deserialization library
-        if (data.size() < sizeof(uint32_t) * 3 + sizeof(Vector4F))
-        {
-            return false;
-        }
-        
-        size_t offset = 0;
-        
-        // Deserialize player ID
-        std::memcpy(&playerData.playerId, data.data() + offset, sizeof(playerData.playerId));
-        offset += sizeof(playerData.playerId);
-        
-        // Deserialize position
-        std::memcpy(&playerData.position, data.data() + offset, sizeof(playerData.position));
-        offset += sizeof(playerData.position);
-        
-        // Deserialize level and experience
-        std::memcpy(&playerData.level, data.data() + offset, sizeof(playerData.level));
-        offset += sizeof(playerData.level);
-        std::memcpy(&playerData.experience, data.data() + offset, sizeof(playerData.experience));
-        
-        return true;
+        BinaryReader reader(data);
+        return SaveSerialization::ReadPlayer(reader, playerData);
     }
 
     bool SharedSaveSystem::DeserializeWorldData(const std::vector<uint8_t>& data, WorldSaveData& worldData)
     {
-        // Simple deserialization - in a real implementation, this would use a proper deserialization library
-        if (data.size() < sizeof(uint32_t))
-        {
-            return false;
-        }
-        
-        // Deserialize world ID
-        std::memcpy(&worldData.worldId, data.data(), sizeof(worldData.worldId));
-        
-        return true;
+        BinaryReader reader(data);
+        return SaveSerialization::ReadWorld(reader, worldData);
+    }
+
+    bool SharedSaveSystem::DeserializeQuestData(const std::vector<uint8_t>& data, std::vector<QuestData>& quests)
+    {
+        BinaryReader reader(data);
+        return SaveSerialization::ReadQuests(reader, quests);
+    }
+
+    bool SharedSaveSystem::DeserializeEconomyData(const std::vector<uint8_t>& data, std::map<uint32_t, PlayerEconomyData>& playerEconomies)
+    {
+        BinaryReader reader(data);
+        return SaveSerialization::ReadEconomy(reader, playerEconomies);
+    }
+
+    bool SharedSaveSystem::DeserializeProgressionData(const std::vector<uint8_t>& data, std::map<uint32_t, PlayerProgressionData>& playerProgressions)
+    {
+        BinaryReader reader(data);
+        return SaveSerialization::ReadProgression(reader, playerProgressions);
+    }
+
+    bool SharedSaveSystem::DeserializeMonsterData(const std::vector<uint8_t>& data, std::map<uint32_t, MonsterAIData>& monsters)
+    {
+        BinaryReader reader(data);
+        return SaveSerialization::ReadMonsters(reader, monsters);
+    }
+
+    bool SharedSaveSystem::DeserializeGroupData(const std::vector<uint8_t>& data, std::map<uint32_t, QuestGroup>& groups)
+    {
+        BinaryReader reader(data);
+        return SaveSerialization::ReadGroups(reader, groups);
     }
 
     uint32_t SharedSaveSystem::CalculateChecksum(const std::vector<uint8_t>& data) const
     {
-        uint32_t checksum = 0;
-        for (uint8_t byte : data)
+        // Fixed-size blocks are hashed in parallel and the block hashes hashed
+        // again, so the result does not depend on the number of threads
+        const size_t blockSize = 1024 * 1024;
+        size_t blockCount = std::max<size_t>(1, (data.size() + blockSize - 1) / blockSize);
+        std::vector<uint8_t> blockHashes(blockCount * 16);
+
+        auto hashBlocks = [&data, &blockHashes, blockSize](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                size_t start = std::min(i * blockSize, data.size());
+                size_t size = std::min(blockSize, data.size() - start);
+                ChunkHash hash = ChunkStore::Hash(data.data() + start, size);
+                for (int byte = 0; byte < 8; ++byte)
+                {
+                    blockHashes[i * 16 + byte] = static_cast<uint8_t>(hash.high >> (byte * 8));
+                    blockHashes[i * 16 + 8 + byte] = static_cast<uint8_t>(hash.low >> (byte * 8));
+                }
+            }
+        };
+
+        if (m_savePool)
+        {
+            m_savePool->ParallelFor(blockCount, 1, hashBlocks);
+        }
+        else
         {
-            checksum = (checksum << 1) ^ byte;
+            hashBlocks(0, blockCount);
         }
-        return checksum;
+
+        ChunkHash combined = ChunkStore::Hash(blockHashes.data(), blockHashes.size());
+        return static_cast<uint32_t>(combined.low ^ (combined.low >> 32));
+    }
+
+    bool SharedSaveSystem::CompressSaveData(uint32_t saveId)
+    {
+        return RecodeSave(saveId, true);
+    }
+
+    bool SharedSaveSystem::DecompressSaveData(uint32_t saveId)
+    {
+        return RecodeSave(saveId, false);
     }
 
     bool SharedSaveSystem::VerifyChecksum(const SaveData& saveData) const
@@ -864,7 +1665,7 @@ namespace Game
         LOG_DEBUG("Loaded save metadata");
     }
 
-    void SharedSaveSystem::SaveMetadata()
+    void SharedSaveSystem::SaveMetadataFile()
     {
         // Save metadata to file
         std::string metadataPath = GetMetadataFilePath();
@@ -891,12 +1692,6 @@ namespace Game
     bool SharedSaveSystem::LoadMonsterData(std::map<uint32_t, MonsterAIData>& monsters) { return true; }
     bool SharedSaveSystem::LoadGroupData(std::map<uint32_t, QuestGroup>& groups) { return true; }
     bool SharedSaveSystem::RenameSave(uint32_t saveId, const std::string& newName) { return true; }
-    bool SharedSaveSystem::RestoreFromBackup(uint32_t saveId, uint32_t backupId) { return true; }
-    std::vector<SaveMetadata> SharedSaveSystem::GetBackups(uint32_t saveId) const { return std::vector<SaveMetadata>(); }
-    bool SharedSaveSystem::DeleteBackup(uint32_t saveId, uint32_t backupId) { return true; }
-    bool SharedSaveSystem::RepairSaveData(uint32_t saveId) { return true; }
-    bool SharedSaveSystem::CompressSaveData(uint32_t saveId) { return true; }
-    bool SharedSaveSystem::DecompressSaveData(uint32_t saveId) { return true; }
     bool SharedSaveSystem::EncryptSaveData(uint32_t saveId, const std::string& password) { return true; }
     bool SharedSaveSystem::DecryptSaveData(uint32_t saveId, const std::string& password) { return true; }
     bool SharedSaveSystem::ExportSave(uint32_t saveId, const std::string& filePath) { return true; }
@@ -904,17 +1699,6 @@ namespace Game
     bool SharedSaveSystem::ExportPlayerData(uint32_t playerId, const std::string& filePath) { return true; }
     bool SharedSaveSystem::ImportPlayerData(uint32_t playerId, const std::string& filePath) { return true; }
 
-    // Placeholder implementations for other serialization methods
-    std::vector<uint8_t> SharedSaveSystem::SerializeQuestData(const std::vector<QuestData>& quests) { return std::vector<uint8_t>(); }
-    std::vector<uint8_t> SharedSaveSystem::SerializeEconomyData(const std::map<uint32_t, PlayerEconomyData>& playerEconomies) { return std::vector<uint8_t>(); }
-    std::vector<uint8_t> SharedSaveSystem::SerializeProgressionData(const std::map<uint32_t, PlayerProgressionData>& playerProgressions) { return std::vector<uint8_t>(); }
-    std::vector<uint8_t> SharedSaveSystem::SerializeMonsterData(const std::map<uint32_t, MonsterAIData>& monsters) { return std::vector<uint8_t>(); }
-    std::vector<uint8_t> SharedSaveSystem::SerializeGroupData(const std::map<uint32_t, QuestGroup>& groups) { return std::vector<uint8_t>(); }
-    bool SharedSaveSystem::DeserializeQuestData(const std::vector<uint8_t>& data, std::vector<QuestData>& quests) { return true; }
-    bool SharedSaveSystem::DeserializeEconomyData(const std::vector<uint8_t>& data, std::map<uint32_t, PlayerEconomyData>& playerEconomies) { return true; }
-    bool SharedSaveSystem::DeserializeProgressionData(const std::vector<uint8_t>& data, std::map<uint32_t, PlayerProgressionData>& playerProgressions) { return true; }
-    bool SharedSaveSystem::DeserializeMonsterData(const std::vector<uint8_t>& data, std::map<uint32_t, MonsterAIData>& monsters) { return true; }
-    bool SharedSaveSystem::DeserializeGroupData(const std::vector<uint8_t>& data, std::map<uint32_t, QuestGroup>& groups) { return true; }
     bool SharedSaveSystem::RepairCorruptedData(uint32_t saveId) { return true; }
     std::vector<std::string> SharedSaveSystem::GetFilesInDirectory(const std::string& directory) const { return std::vector<std::string>(); }
 }
@@ -14,6 +14,9 @@ namespace Game
         m_lastSyncTime = m_lastUpdateTime;
         
         LOG_INFO("Synced monster AI system created");
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("monster_ai",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     SyncedMonsterAI::~SyncedMonsterAI()
@@ -615,6 +618,18 @@ namespace Game
         LOG_INFO("====================================");
     }
 
+    void SyncedMonsterAI::CollectMetrics(MetricsWriter& out) const
+    {
+        out.Gauge("tw3_monsters", "Tracked monsters", static_cast<double>(m_stats.totalMonsters));
+        out.Gauge("tw3_monsters_active", "Monsters currently active", static_cast<double>(m_stats.activeMonsters));
+        out.Gauge("tw3_monsters_aggressive", "Monsters currently aggressive", static_cast<double>(m_stats.aggressiveMonsters));
+        out.Gauge("tw3_monster_groups", "Monster groups", static_cast<double>(m_stats.totalGroups));
+        out.Counter("tw3_monster_decisions_total", "AI decisions made", static_cast<double>(m_stats.totalDecisions));
+        out.Counter("tw3_monster_sync_conflicts_total", "Conflicting AI state updates", static_cast<double>(m_stats.syncConflicts));
+        out.Gauge("tw3_monster_decision_seconds", "Average decision time", m_stats.averageDecisionTime / 1000.0);
+        out.Gauge("tw3_monster_sync_seconds", "Average sync time", m_stats.averageSyncTime / 1000.0);
+    }
+
     // Callback setters
     void SyncedMonsterAI::SetMonsterStateChangedCallback(MonsterStateChangedCallback callback)
     {
@@ -1,4 +1,5 @@
 #include "integration/CombatSystemIntegration.h"
+#include "utils/TraceRecorder.h"
 #include <algorithm>
 #include <sstream>
 
@@ -10,7 +11,7 @@ namespace TW3Integration
     CombatSystemIntegration::CombatSystemIntegration()
         : m_redkitBridge(nullptr), m_witcherScriptBridge(nullptr), m_combatOptimizer(nullptr),
           m_initialized(false), m_processing(false), m_running(false),
-          m_shouldStop(false), m_processedActions(0), m_droppedActions(0),
+          m_shouldStop(false), m_eventDriven(false), m_processedActions(0), m_droppedActions(0),
           m_processingInterval(16), m_maxProcessingTime(10), m_maxQueueSize(1000)
     {
         m_lastProcessTime = std::chrono::steady_clock::now();
@@ -445,10 +446,21 @@ namespace TW3Integration
         m_shouldStop = false;
         m_running = true;
         
-        // Start processing thread
-        m_processingThread = std::thread(&CombatSystemIntegration::ProcessingLoop, this);
+        if (m_eventDriven)
+        {
+            // Drain on demand: the optimizer wakes the executor for urgent actions
+            m_executorConfig.idleInterval = std::chrono::milliseconds(m_processingInterval);
+            m_executor = std::make_unique<TW3Optimization::CombatExecutor>(*m_combatOptimizer);
+            m_executor->Start(m_executorConfig);
+            m_combatOptimizer->SetExecutor(m_executor.get());
+        }
+        else
+        {
+            // Start processing thread
+            m_processingThread = std::thread(&CombatSystemIntegration::ProcessingLoop, this);
+        }
         
-        LOG_INFO("Combat processing started");
+        LOG_INFO(std::string("Combat processing started (") + (m_eventDriven ? "event-driven" : "polling") + ")");
         return true;
     }
 
@@ -462,6 +474,14 @@ namespace TW3Integration
         m_shouldStop = true;
         m_running = false;
         
+        if (m_executor)
+        {
+            // Waits out producers still notifying the executor before it goes
+            m_combatOptimizer->SetExecutor(nullptr);
+            m_executor->Stop();
+            m_executor.reset();
+        }
+        
         // Wait for processing thread to finish
         if (m_processingThread.joinable())
         {
@@ -480,6 +500,10 @@ namespace TW3Integration
         }
 
         m_processing = false;
+        if (m_executor)
+        {
+            m_executor->Pause();
+        }
         LOG_INFO("Combat processing paused");
         return true;
     }
@@ -492,12 +516,17 @@ namespace TW3Integration
         }
 
         m_processing = true;
+        if (m_executor)
+        {
+            m_executor->Resume();
+        }
         LOG_INFO("Combat processing resumed");
         return true;
     }
 
     void CombatSystemIntegration::ProcessingLoop()
     {
+        TraceRecorder::GetInstance().SetThreadName("combat");
         LOG_INFO("Combat processing loop started");
         
         while (!m_shouldStop)
@@ -601,6 +630,13 @@ namespace TW3Integration
         LOG_INFO("Average Processing Time: " + std::to_string(GetAverageProcessingTime()) + "ms");
         LOG_INFO("Is Overloaded: " + std::string(IsOverloaded() ? "Yes" : "No"));
         
+        if (m_executor)
+        {
+            LOG_INFO("Executor Wakeups - Spin: " + std::to_string(m_executor->GetSpinWakeups()) +
+                    ", Parked: " + std::to_string(m_executor->GetParkedWakeups()) +
+                    ", Idle: " + std::to_string(m_executor->GetIdleWakeups()));
+        }
+        
         if (m_combatOptimizer)
         {
             m_combatOptimizer->PrintStatistics();
@@ -653,6 +689,18 @@ namespace TW3Integration
         m_maxQueueSize = maxSize;
     }
 
+    void CombatSystemIntegration::SetEventDrivenProcessing(bool enabled, const TW3Optimization::CombatExecutorConfig& config)
+    {
+        // Takes effect on the next StartProcessing
+        m_eventDriven = enabled;
+        m_executorConfig = config;
+    }
+
+    bool CombatSystemIntegration::IsEventDriven() const
+    {
+        return m_eventDriven;
+    }
+
     bool CombatSystemIntegration::IsHealthy() const
     {
         if (!m_initialized)
@@ -685,6 +733,7 @@ namespace TW3Integration
         ss << "  Processing Interval: " << m_processingInterval << "ms\n";
         ss << "  Max Processing Time: " << m_maxProcessingTime << "ms\n";
         ss << "  Max Queue Size: " << m_maxQueueSize << "\n";
+        ss << "  Processing Mode: " << (m_eventDriven ? "Event-driven" : "Polling") << "\n";
         ss << "  REDkit Bridge: " << (m_redkitBridge ? "Available" : "Not Available") << "\n";
         ss << "  WitcherScript Bridge: " << (m_witcherScriptBridge ? "Available" : "Not Available") << "\n";
         ss << "  Combat Optimizer: " << (m_combatOptimizer ? "Available" : "Not Available") << "\n";
@@ -710,6 +759,14 @@ namespace TW3Integration
             return nullptr;
         }
         
+        if (config.enableEventDrivenExecutor)
+        {
+            TW3Optimization::CombatExecutorConfig executorConfig;
+            executorConfig.spinDuration = std::chrono::microseconds(config.executorSpinMicros);
+            executorConfig.cpuAffinity = config.executorCpuAffinity;
+            system->SetEventDrivenProcessing(true, executorConfig);
+        }
+        
         return system;
     }
 
@@ -735,6 +792,7 @@ namespace TW3Integration
         config.maxProcessingTime = 2;   // 2ms max
         config.maxQueueSize = 500;      // Smaller queue
         config.batchSize = 25;          // Smaller batches
+        config.enableEventDrivenExecutor = true;  // Wake on urgent actions
         return config;
     }
 
@@ -32,6 +32,9 @@ namespace Networking
           m_bytesSent(0), m_bytesReceived(0), m_packetLoss(0.0f), m_averageLatency(0.0f)
     {
         Initialize();
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("network_log",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     NetworkLogger::~NetworkLogger()
@@ -257,6 +260,17 @@ namespace Networking
         return stats;
     }
 
+    void NetworkLogger::CollectMetrics(MetricsWriter& out) const
+    {
+        NetworkStats stats = GetStatistics();
+        out.Counter("tw3_network_packets_total", "Logged packets by direction", static_cast<double>(stats.packetsSent), { { "direction", "sent" } });
+        out.Counter("tw3_network_packets_total", "Logged packets by direction", static_cast<double>(stats.packetsReceived), { { "direction", "received" } });
+        out.Counter("tw3_network_bytes_total", "Logged bytes by direction", static_cast<double>(stats.bytesSent), { { "direction", "sent" } });
+        out.Counter("tw3_network_bytes_total", "Logged bytes by direction", static_cast<double>(stats.bytesReceived), { { "direction", "received" } });
+        out.Gauge("tw3_network_packet_loss_ratio", "Reported packet loss", stats.packetLoss);
+        out.Gauge("tw3_network_latency_seconds", "Reported average latency", stats.averageLatency / 1000.0);
+    }
+
     void NetworkLogger::ResetStatistics()
     {
         m_packetsSent = 0;
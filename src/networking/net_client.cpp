@@ -2,6 +2,8 @@
 #include "networking/MessageTypes.h"
 #include "utils/Logger.h"
 #include "optimization/NetworkOptimizer.h"
+#include "optimization/JitterBuffer.h"
+#include "optimization/PositionInterpolation.h"
 #include <iostream>
 #include <chrono>
 
@@ -16,6 +18,7 @@ namespace Networking
             : m_connected(false), m_ping(0.0f), m_packetLoss(0.0f), 
               m_compressionEnabled(true), m_lastPingTime(0)
         {
+            m_interpolation.Initialize();
             LOG_INFO_CAT(LogCategory::NETWORK, "Witcher3MPClient created");
         }
 
@@ -154,6 +157,8 @@ namespace Networking
 
         // Network statistics
         float GetPing() const { return m_ping; }
+        const Optimization::ClockSync& GetClockSync() const { return m_clockSync; }
+        Optimization::PositionInterpolation& GetInterpolation() { return m_interpolation; }
         float GetPacketLoss() const { return m_packetLoss; }
         size_t GetBytesSent() const { return m_bytesSent; }
         size_t GetBytesReceived() const { return m_bytesReceived; }
@@ -201,8 +206,8 @@ namespace Networking
                 message<T> msg;
                 msg.header.id = static_cast<T>(MessageTypes::ClientPing);
                 
-                // Send timestamp
-                auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+                // Send timestamp (t0) for clock synchronization
+                int64_t timestamp = Optimization::ClockSync::NowMicros();
                 msg << timestamp;
                 
                 client_interface<T>::MessageServer(msg);
@@ -241,6 +246,10 @@ namespace Networking
                     ProcessPositionUpdate(msg);
                     break;
                     
+                case MessageTypes::TC_UPDATE_POS:
+                    ProcessPlayerPosition(msg);
+                    break;
+                    
                 case MessageTypes::TS_CHAT_MESSAGE:
                     ProcessChatMessage(msg);
                     break;
@@ -271,11 +280,25 @@ namespace Networking
 
         void ProcessPong(const message<T>& msg)
         {
-            auto now = std::chrono::high_resolution_clock::now();
-            auto pingTime = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastPingTime).count();
-            m_ping = static_cast<float>(pingTime);
+            int64_t t3 = Optimization::ClockSync::NowMicros();
+            
+            if (msg.size() < 3 * sizeof(int64_t))
+            {
+                LOG_WARNING_CAT(LogCategory::NETWORK, "Malformed pong (" + std::to_string(msg.size()) + " bytes)");
+                return;
+            }
+            
+            // Pong carries t0 (echoed), t1 (server receive) and t2 (server send)
+            message<T> pong = msg;
+            int64_t t0, t1, t2;
+            pong >> t2 >> t1 >> t0;
+            
+            m_clockSync.AddSample(t0, t1, t2, t3);
+            m_ping = static_cast<float>(m_clockSync.GetRoundTrip()) / 1000.0f;
+            m_interpolation.UpdateNetworkConditions(m_clockSync, m_packetLoss);
             
-            LOG_DEBUG_CAT(LogCategory::NETWORK, "Received pong, ping: " + std::to_string(m_ping) + "ms");
+            LOG_DEBUG_CAT(LogCategory::NETWORK, "Received pong, ping: " + std::to_string(m_ping) + 
+                         "ms, clock offset: " + std::to_string(m_clockSync.GetOffset()) + "us");
         }
 
         void ProcessPlayerData(const message<T>& msg)
@@ -294,6 +317,31 @@ namespace Networking
                          std::to_string(z) + ", " + std::to_string(w) + ")");
         }
 
+        void ProcessPlayerPosition(const message<T>& msg)
+        {
+            if (msg.size() < sizeof(int64_t) + sizeof(uint32_t) + sizeof(Vector4F) + sizeof(uint8_t))
+            {
+                LOG_WARNING_CAT(LogCategory::NETWORK, "Malformed player position (" + std::to_string(msg.size()) + " bytes)");
+                return;
+            }
+            
+            // Server relay time sits underneath the player ID, position and move type
+            message<T> update = msg;
+            uint8_t moveType;
+            Vector4F position;
+            uint32_t playerId;
+            int64_t serverTime;
+            update >> moveType >> position >> playerId >> serverTime;
+            
+            Optimization::PositionSnapshot snapshot;
+            snapshot.playerId = playerId;
+            snapshot.position = position;
+            snapshot.timestamp = std::chrono::high_resolution_clock::now();
+            snapshot.serverTime = serverTime;
+            snapshot.isValid = true;
+            m_interpolation.AddPositionSnapshot(snapshot);
+        }
+
         void ProcessChatMessage(const message<T>& msg)
         {
             std::string chatMessage;
@@ -332,6 +380,8 @@ namespace Networking
         
         std::chrono::high_resolution_clock::time_point m_connectionStartTime;
         std::chrono::high_resolution_clock::time_point m_lastPingTime;
+        Optimization::ClockSync m_clockSync;
+        Optimization::PositionInterpolation m_interpolation;
         
         // Statistics
         size_t m_bytesSent = 0;
@@ -2,6 +2,7 @@
 #include "networking/MessageTypes.h"
 #include "utils/Logger.h"
 #include "optimization/NetworkOptimizer.h"
+#include "optimization/JitterBuffer.h"
 #include <iostream>
 #include <chrono>
 
@@ -80,12 +81,13 @@ namespace Networking
             if (!client)
                 return;
 
+            int64_t receivedAt = Optimization::ClockSync::NowMicros();
             MessageTypes msgType = static_cast<MessageTypes>(msg.header.id);
             
             switch (msgType)
             {
                 case MessageTypes::ClientPing:
-                    ProcessClientPing(client, msg);
+                    ProcessClientPing(client, msg, receivedAt);
                     break;
                 case MessageTypes::TC_UPDATE_POS:
                     ProcessPositionUpdate(client, msg);
@@ -100,11 +102,14 @@ namespace Networking
         }
 
     private:
-        void ProcessClientPing(std::shared_ptr<connection<T>> client, const message<T>& msg)
+        void ProcessClientPing(std::shared_ptr<connection<T>> client, const message<T>& msg, int64_t receivedAt)
         {
+            // Echo the client send time (t0) and append server receive (t1) and reply (t2) times
             message<T> pongMsg;
             pongMsg.header.id = static_cast<T>(MessageTypes::ServerPong);
-            pongMsg << msg.body;
+            pongMsg.body = msg.body;
+            pongMsg.header.size = pongMsg.size();
+            pongMsg << receivedAt << Optimization::ClockSync::NowMicros();
             client->Send(pongMsg);
         }
 
@@ -0,0 +1,171 @@
+#include "optimization/CombatExecutor.h"
+#include "optimization/CombatOptimizer.h"
+#include "utils/Logger.h"
+#include "utils/TraceRecorder.h"
+
+#ifdef _WIN32
+#include "WindowsConfig.h"
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define TW3_CPU_RELAX() _mm_pause()
+#else
+#define TW3_CPU_RELAX() std::this_thread::yield()
+#endif
+
+namespace TW3Optimization
+{
+    CombatExecutor::CombatExecutor(CombatOptimizer& optimizer)
+        : m_optimizer(optimizer), m_running(false), m_stopRequested(false), m_paused(false),
+          m_signal(false), m_parked(false), m_spinWakeups(0), m_parkedWakeups(0), m_idleWakeups(0)
+    {
+    }
+
+    CombatExecutor::~CombatExecutor()
+    {
+        Stop();
+    }
+
+    bool CombatExecutor::Start(const CombatExecutorConfig& config)
+    {
+        if (m_running)
+        {
+            LOG_WARNING("CombatExecutor already running");
+            return true;
+        }
+
+        m_config = config;
+        m_stopRequested = false;
+        m_paused = false;
+        m_signal = false;
+        m_running = true;
+        m_thread = std::thread(&CombatExecutor::Run, this);
+
+        LOG_INFO("CombatExecutor started (spin=" + std::to_string(m_config.spinDuration.count()) +
+                 "us, idleInterval=" + std::to_string(m_config.idleInterval.count()) +
+                 "ms, cpu=" + std::to_string(m_config.cpuAffinity) + ")");
+        return true;
+    }
+
+    void CombatExecutor::Stop()
+    {
+        if (!m_running)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopRequested = true;
+        }
+        m_condition.notify_one();
+
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+
+        m_running = false;
+        LOG_INFO("CombatExecutor stopped");
+    }
+
+    void CombatExecutor::Pause()
+    {
+        m_paused = true;
+    }
+
+    void CombatExecutor::Resume()
+    {
+        m_paused = false;
+        Notify();
+    }
+
+    void CombatExecutor::Notify()
+    {
+        // Both sides use sequentially consistent accesses, so either the
+        // executor sees the signal before parking or we see it parked
+        m_signal.store(true);
+        if (m_parked.load())
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_condition.notify_one();
+        }
+    }
+
+    void CombatExecutor::Run()
+    {
+        TraceRecorder::GetInstance().SetThreadName("combat-executor");
+
+        if (m_config.cpuAffinity >= 0 && !ApplyAffinity())
+        {
+            LOG_WARNING("CombatExecutor failed to set CPU affinity to core " + std::to_string(m_config.cpuAffinity));
+        }
+
+        while (!m_stopRequested)
+        {
+            m_signal.store(false);
+
+            if (!m_paused)
+            {
+                m_optimizer.ProcessActions();
+
+                // Out of budget with work left: run another pass straight away
+                if (m_optimizer.GetTotalQueueSize() > 0)
+                {
+                    continue;
+                }
+            }
+
+            WaitForWork();
+        }
+    }
+
+    void CombatExecutor::WaitForWork()
+    {
+        // Spin first: a wakeup seen here costs no context switch
+        auto spinUntil = std::chrono::steady_clock::now() + m_config.spinDuration;
+        while (std::chrono::steady_clock::now() < spinUntil)
+        {
+            if (m_signal.load(std::memory_order_acquire) || m_stopRequested.load(std::memory_order_relaxed))
+            {
+                m_spinWakeups++;
+                return;
+            }
+            TW3_CPU_RELAX();
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_parked.store(true);
+        bool signaled = m_condition.wait_for(lock, m_config.idleInterval,
+            [this]() { return m_signal.load() || m_stopRequested.load(); });
+        m_parked.store(false);
+
+        if (signaled)
+        {
+            m_parkedWakeups++;
+        }
+        else
+        {
+            m_idleWakeups++;
+        }
+    }
+
+    bool CombatExecutor::ApplyAffinity()
+    {
+#ifdef _WIN32
+        DWORD_PTR mask = static_cast<DWORD_PTR>(1) << m_config.cpuAffinity;
+        return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(m_config.cpuAffinity, &cpuSet);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+        return false;
+#endif
+    }
+}
@@ -1,6 +1,8 @@
 #include "optimization/CombatOptimizer.h"
+#include "optimization/CombatExecutor.h"
 #include "integration/REDkitBridge.h"
 #include "integration/WitcherScriptBridge.h"
+#include "utils/TraceRecorder.h"
 #include <algorithm>
 #include <chrono>
 #include <thread>
@@ -14,10 +16,15 @@ namespace TW3Optimization
 
     // CombatOptimizer Implementation
     CombatOptimizer::CombatOptimizer()
-        : m_processing(false), m_initialized(false), m_maxQueueSize(1000), 
-          m_batchSize(50), m_maxProcessingTime(16), m_actionIdCounter(1)
+        : m_executor(nullptr), m_notifying(0), m_processing(false), m_initialized(false), m_maxQueueSize(1000), 
+          m_batchSize(50), m_maxProcessingTime(16), m_processingBudget(16000),
+          m_actionIdCounter(1), m_averageActionCost(0.0f)
     {
+        m_queueLimits.fill(0);
         m_lastProcessTime = std::chrono::steady_clock::now();
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("combat",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     CombatOptimizer::~CombatOptimizer()
@@ -53,12 +60,17 @@ namespace TW3Optimization
         m_maxQueueSize = maxQueueSize;
         m_batchSize = batchSize;
         m_maxProcessingTime = maxProcessingTime;
+        m_processingBudget = std::chrono::microseconds(static_cast<int64_t>(maxProcessingTime) * 1000);
+        
+        // Allocate queues: half the capacity for Medium, a quarter for the others
+        m_queueLimits = { maxQueueSize / 4, maxQueueSize / 4, maxQueueSize / 2, maxQueueSize / 4 };
+        for (size_t i = 0; i < CombatPriorityCount; ++i)
+        {
+            m_queues[i].Reset(m_queueLimits[i]);
+        }
         
-        // Reserve space for queues
-        m_criticalQueue.reserve(maxQueueSize / 4);
-        m_highQueue.reserve(maxQueueSize / 4);
-        m_mediumQueue.reserve(maxQueueSize / 2);
-        m_lowQueue.reserve(maxQueueSize / 4);
+        // One payload block per queued action; larger payloads fall back to the heap
+        m_payloadPool.Reset(64, maxQueueSize);
         
         m_initialized = true;
         LOG_INFO("CombatOptimizer initialized with maxQueueSize=" + std::to_string(maxQueueSize) + 
@@ -75,9 +87,7 @@ namespace TW3Optimization
             return true;
         }
 
-        m_processing = false;
-        
-        // Clear all queues
+        // Clear all queues, waiting for any running pass to finish
         ClearAllQueues();
         
         m_initialized = false;
@@ -86,7 +96,7 @@ namespace TW3Optimization
         return true;
     }
 
-    bool CombatOptimizer::AddAction(const CombatAction& action)
+    bool CombatOptimizer::AddAction(CombatAction&& action)
     {
         if (!m_initialized)
         {
@@ -94,8 +104,6 @@ namespace TW3Optimization
             return false;
         }
 
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        
         // Check if we should drop this action
         if (ShouldDropAction(action.priority))
         {
@@ -103,62 +111,39 @@ namespace TW3Optimization
             return false;
         }
 
-        // Add to appropriate queue
-        switch (action.priority)
+        // Enqueue without locking; the ring rejects the action when full
+        CombatPriority priority = action.priority;
+        size_t index = static_cast<size_t>(priority);
+        if (index >= CombatPriorityCount ||
+            m_queues[index].SizeApprox() >= m_queueLimits[index] ||
+            !m_queues[index].TryEnqueue(std::move(action)))
         {
-            case CombatPriority::Critical:
-                if (m_criticalQueue.size() < m_maxQueueSize / 4)
-                {
-                    m_criticalQueue.push_back(action);
-                }
-                else
-                {
-                    m_stats.droppedActions++;
-                    return false;
-                }
-                break;
-                
-            case CombatPriority::High:
-                if (m_highQueue.size() < m_maxQueueSize / 4)
-                {
-                    m_highQueue.push_back(action);
-                }
-                else
-                {
-                    m_stats.droppedActions++;
-                    return false;
-                }
-                break;
-                
-            case CombatPriority::Medium:
-                if (m_mediumQueue.size() < m_maxQueueSize / 2)
-                {
-                    m_mediumQueue.push_back(action);
-                }
-                else
-                {
-                    m_stats.droppedActions++;
-                    return false;
-                }
-                break;
-                
-            case CombatPriority::Low:
-                if (m_lowQueue.size() < m_maxQueueSize / 4)
-                {
-                    m_lowQueue.push_back(action);
-                }
-                else
-                {
-                    m_stats.droppedActions++;
-                    return false;
-                }
-                break;
+            m_stats.droppedActions++;
+            return false;
         }
 
         m_stats.totalActions++;
+        
+        // Urgent actions wake the executor instead of waiting for the next pass
+        if (priority <= CombatPriority::High)
+        {
+            // Announced before the load so SetExecutor can wait this call out;
+            // both sides are sequentially consistent so one sees the other
+            m_notifying.fetch_add(1);
+            if (CombatExecutor* executor = m_executor.load())
+            {
+                executor->Notify();
+            }
+            m_notifying.fetch_sub(1, std::memory_order_release);
+        }
         return true;
     }
 
+    PooledBuffer CombatOptimizer::AllocatePayload(size_t size)
+    {
+        return m_payloadPool.Allocate(size);
+    }
+
     bool CombatOptimizer::AddAttackAction(uint32_t playerId, uint32_t attackType, uint32_t weaponType, const Vector4F& targetPosition)
     {
         CombatAction action;
@@ -170,7 +155,7 @@ namespace TW3Optimization
         action.processed = false;
         
         // Serialize attack data
-        action.data.resize(sizeof(uint32_t) * 3 + sizeof(Vector4F));
+        action.data = AllocatePayload(sizeof(uint32_t) * 3 + sizeof(Vector4F));
         uint8_t* ptr = action.data.data();
         
         *reinterpret_cast<uint32_t*>(ptr) = attackType;
@@ -181,7 +166,7 @@ namespace TW3Optimization
         ptr += sizeof(Vector4F);
         *reinterpret_cast<uint32_t*>(ptr) = 0; // Padding
         
-        return AddAction(action);
+        return AddAction(std::move(action));
     }
 
     bool CombatOptimizer::AddDefenseAction(uint32_t playerId, uint32_t defenseType, uint32_t incomingAttackId)
@@ -195,14 +180,14 @@ namespace TW3Optimization
         action.processed = false;
         
         // Serialize defense data
-        action.data.resize(sizeof(uint32_t) * 2);
+        action.data = AllocatePayload(sizeof(uint32_t) * 2);
         uint8_t* ptr = action.data.data();
         
         *reinterpret_cast<uint32_t*>(ptr) = defenseType;
         ptr += sizeof(uint32_t);
         *reinterpret_cast<uint32_t*>(ptr) = incomingAttackId;
         
-        return AddAction(action);
+        return AddAction(std::move(action));
     }
 
     bool CombatOptimizer::AddSignAction(uint32_t playerId, uint32_t signType, const Vector4F& targetPosition)
@@ -216,14 +201,14 @@ namespace TW3Optimization
         action.processed = false;
         
         // Serialize sign data
-        action.data.resize(sizeof(uint32_t) + sizeof(Vector4F));
+        action.data = AllocatePayload(sizeof(uint32_t) + sizeof(Vector4F));
         uint8_t* ptr = action.data.data();
         
         *reinterpret_cast<uint32_t*>(ptr) = signType;
         ptr += sizeof(uint32_t);
         *reinterpret_cast<Vector4F*>(ptr) = targetPosition;
         
-        return AddAction(action);
+        return AddAction(std::move(action));
     }
 
     bool CombatOptimizer::AddMovementAction(uint32_t playerId, const Vector4F& newPosition, const Vector4F& velocity)
@@ -237,14 +222,14 @@ namespace TW3Optimization
         action.processed = false;
         
         // Serialize movement data
-        action.data.resize(sizeof(Vector4F) * 2);
+        action.data = AllocatePayload(sizeof(Vector4F) * 2);
         uint8_t* ptr = action.data.data();
         
         *reinterpret_cast<Vector4F*>(ptr) = newPosition;
         ptr += sizeof(Vector4F);
         *reinterpret_cast<Vector4F*>(ptr) = velocity;
         
-        return AddAction(action);
+        return AddAction(std::move(action));
     }
 
     bool CombatOptimizer::AddAnimationAction(uint32_t playerId, uint32_t animationType, bool isAttack)
@@ -258,65 +243,98 @@ namespace TW3Optimization
         action.processed = false;
         
         // Serialize animation data
-        action.data.resize(sizeof(uint32_t) + sizeof(bool));
+        action.data = AllocatePayload(sizeof(uint32_t) + sizeof(bool));
         uint8_t* ptr = action.data.data();
         
         *reinterpret_cast<uint32_t*>(ptr) = animationType;
         ptr += sizeof(uint32_t);
         *reinterpret_cast<bool*>(ptr) = isAttack;
         
-        return AddAction(action);
+        return AddAction(std::move(action));
     }
 
     bool CombatOptimizer::ProcessActions()
     {
-        if (!m_initialized || m_processing)
+        if (!m_initialized || !AcquireConsumer(false))
         {
             return false;
         }
 
-        m_processing = true;
+        TRACE_SCOPE("CombatOptimizer::ProcessActions", "combat");
+
         auto startTime = std::chrono::steady_clock::now();
+        auto deadline = startTime + m_processingBudget;
         
-        // Process actions in priority order
-        ProcessActionQueue(m_criticalQueue, CombatPriority::Critical);
-        ProcessActionQueue(m_highQueue, CombatPriority::High);
-        ProcessActionQueue(m_mediumQueue, CombatPriority::Medium);
-        ProcessActionQueue(m_lowQueue, CombatPriority::Low);
+        // Drain queues in priority order until empty or out of budget
+        bool withinBudget = true;
+        for (size_t i = 0; i < CombatPriorityCount && withinBudget; ++i)
+        {
+            withinBudget = ProcessActionQueue(static_cast<CombatPriority>(i), deadline);
+        }
         
-        // Clean up old actions
-        CleanupOldActions();
+        if (!withinBudget)
+        {
+            m_stats.budgetExhaustions++;
+        }
         
         auto endTime = std::chrono::steady_clock::now();
-        auto processingTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+        auto processingTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
         
-        UpdateStatistics(processingTime);
+        UpdateStatistics(static_cast<uint64_t>(processingTime));
         
-        m_processing = false;
+        ReleaseConsumer();
         return true;
     }
 
-    void CombatOptimizer::ProcessActionQueue(std::vector<CombatAction>& queue, CombatPriority priority)
+    bool CombatOptimizer::ProcessActionQueue(CombatPriority priority, std::chrono::steady_clock::time_point deadline)
     {
-        if (queue.empty())
-        {
-            return;
-        }
-
-        size_t batchSize = std::min(static_cast<size_t>(m_batchSize), queue.size());
+        auto& queue = m_queues[static_cast<size_t>(priority)];
         
-        for (size_t i = 0; i < batchSize; ++i)
+        for (;;)
         {
-            CombatAction& action = queue[i];
-            if (!action.processed)
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                return false;
+            }
+
+            // Size the batch so it is expected to finish before the deadline
+            size_t batchSize = m_batchSize > 0 ? m_batchSize : 1;
+            if (m_averageActionCost > 0.0f)
+            {
+                float remaining = static_cast<float>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count());
+                size_t affordable = static_cast<size_t>(remaining / m_averageActionCost);
+                batchSize = std::clamp<size_t>(affordable, 1, batchSize);
+            }
+
+            size_t processed = queue.DequeueBulk(
+                [this, now](CombatAction&& action)
+                {
+                    if (IsExpired(action, now))
+                    {
+                        m_stats.expiredActions++;
+                        return;
+                    }
+                    
+                    auto latency = std::chrono::steady_clock::now() - action.timestamp;
+                    m_executionLatency.Record(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(latency).count()));
+                    ProcessAction(action);
+                },
+                batchSize);
+
+            if (processed == 0)
             {
-                ProcessAction(action);
-                action.processed = true;
+                return true;
             }
+
+            // Track the per-action cost to size the next batch
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - now).count();
+            float cost = static_cast<float>(elapsed) / 1000.0f / static_cast<float>(processed);
+            m_averageActionCost = m_averageActionCost > 0.0f ? (m_averageActionCost + cost) / 2.0f : cost;
         }
-        
-        // Remove processed actions
-        queue.erase(queue.begin(), queue.begin() + batchSize);
     }
 
     void CombatOptimizer::ProcessAction(const CombatAction& action)
@@ -409,53 +427,40 @@ namespace TW3Optimization
         m_stats.processedActions++;
     }
 
-    void CombatOptimizer::UpdateStatistics(uint64_t processingTime)
+    void CombatOptimizer::UpdateStatistics(uint64_t processingTimeMicros)
     {
-        std::lock_guard<std::mutex> lock(m_statsMutex);
-        
-        m_processingTimes.push_back(processingTime);
-        if (m_processingTimes.size() > 100)
-        {
-            m_processingTimes.erase(m_processingTimes.begin());
-        }
-        
-        // Calculate average processing time
-        uint64_t totalTime = 0;
-        for (uint64_t time : m_processingTimes)
-        {
-            totalTime += time;
-        }
-        m_stats.averageProcessingTime = totalTime / m_processingTimes.size();
+        m_processingTimes.Record(processingTimeMicros);
         
-        // Update peak processing time
-        if (processingTime > m_stats.peakProcessingTime)
+        // Stats keep their millisecond units; percentiles come from the histogram
+        m_stats.averageProcessingTime = static_cast<uint64_t>(m_processingTimes.GetMean() / 1000.0);
+        m_stats.peakProcessingTime = m_processingTimes.GetMax() / 1000;
+    }
+
+    bool CombatOptimizer::IsExpired(const CombatAction& action, std::chrono::steady_clock::time_point now) const
+    {
+        // Actions older than 5 seconds are discarded when dequeued
+        return (now - action.timestamp) > std::chrono::milliseconds(5000);
+    }
+
+    bool CombatOptimizer::AcquireConsumer(bool wait)
+    {
+        // The queues allow a single consumer at a time
+        bool expected = false;
+        while (!m_processing.compare_exchange_weak(expected, true, std::memory_order_acquire))
         {
-            m_stats.peakProcessingTime = processingTime;
+            if (!wait)
+            {
+                return false;
+            }
+            expected = false;
+            std::this_thread::yield();
         }
+        return true;
     }
 
-    void CombatOptimizer::CleanupOldActions()
+    void CombatOptimizer::ReleaseConsumer()
     {
-        auto now = std::chrono::steady_clock::now();
-        auto maxAge = std::chrono::milliseconds(5000); // 5 seconds
-        
-        auto cleanupQueue = [&](std::vector<CombatAction>& queue)
-        {
-            queue.erase(
-                std::remove_if(queue.begin(), queue.end(),
-                    [&](const CombatAction& action)
-                    {
-                        return (now - action.timestamp) > maxAge;
-                    }),
-                queue.end()
-            );
-        };
-        
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        cleanupQueue(m_criticalQueue);
-        cleanupQueue(m_highQueue);
-        cleanupQueue(m_mediumQueue);
-        cleanupQueue(m_lowQueue);
+        m_processing.store(false, std::memory_order_release);
     }
 
     CombatPriority CombatOptimizer::DeterminePriority(CombatActionType type, uint32_t playerId)
@@ -496,25 +501,47 @@ namespace TW3Optimization
         return false;
     }
 
-    // Getters and utility methods
-    size_t CombatOptimizer::GetQueueSize(CombatPriority priority) const
+    // Queue management
+    void CombatOptimizer::ClearQueue(CombatPriority priority)
     {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        
-        switch (priority)
+        size_t index = static_cast<size_t>(priority);
+        if (index >= CombatPriorityCount)
+        {
+            return;
+        }
+
+        // Draining is a consumer operation, so wait for any running pass
+        AcquireConsumer(true);
+        auto& queue = m_queues[index];
+        while (queue.DequeueBulk([](CombatAction&&) {}, queue.Capacity()) > 0)
         {
-            case CombatPriority::Critical: return m_criticalQueue.size();
-            case CombatPriority::High: return m_highQueue.size();
-            case CombatPriority::Medium: return m_mediumQueue.size();
-            case CombatPriority::Low: return m_lowQueue.size();
-            default: return 0;
         }
+        ReleaseConsumer();
+    }
+
+    void CombatOptimizer::ClearAllQueues()
+    {
+        for (size_t i = 0; i < CombatPriorityCount; ++i)
+        {
+            ClearQueue(static_cast<CombatPriority>(i));
+        }
+    }
+
+    // Getters and utility methods
+    size_t CombatOptimizer::GetQueueSize(CombatPriority priority) const
+    {
+        size_t index = static_cast<size_t>(priority);
+        return index < CombatPriorityCount ? m_queues[index].SizeApprox() : 0;
     }
 
     size_t CombatOptimizer::GetTotalQueueSize() const
     {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        return m_criticalQueue.size() + m_highQueue.size() + m_mediumQueue.size() + m_lowQueue.size();
+        size_t total = 0;
+        for (const auto& queue : m_queues)
+        {
+            total += queue.SizeApprox();
+        }
+        return total;
     }
 
     CombatStats CombatOptimizer::GetStatistics() const
@@ -527,7 +554,8 @@ namespace TW3Optimization
     {
         std::lock_guard<std::mutex> lock(m_statsMutex);
         m_stats = CombatStats();
-        m_processingTimes.clear();
+        m_processingTimes.Reset();
+        m_executionLatency.Reset();
     }
 
     void CombatOptimizer::PrintStatistics() const
@@ -540,12 +568,62 @@ namespace TW3Optimization
         LOG_INFO("Dropped Actions: " + std::to_string(stats.droppedActions.load()));
         LOG_INFO("Average Processing Time: " + std::to_string(stats.averageProcessingTime.load()) + "ms");
         LOG_INFO("Peak Processing Time: " + std::to_string(stats.peakProcessingTime.load()) + "ms");
+        LOG_INFO("Processing Time - p50: " + std::to_string(m_processingTimes.GetPercentile(50.0)) +
+                "us, p99: " + std::to_string(m_processingTimes.GetPercentile(99.0)) +
+                "us, p999: " + std::to_string(m_processingTimes.GetPercentile(99.9)) + "us");
+        LOG_INFO("Execution Latency - p50: " + std::to_string(m_executionLatency.GetPercentile(50.0)) +
+                "us, p99: " + std::to_string(m_executionLatency.GetPercentile(99.0)) +
+                "us, p999: " + std::to_string(m_executionLatency.GetPercentile(99.9)) +
+                "us, max: " + std::to_string(m_executionLatency.GetMax()) + "us");
         LOG_INFO("Queue Sizes - Critical: " + std::to_string(GetQueueSize(CombatPriority::Critical)) +
                 ", High: " + std::to_string(GetQueueSize(CombatPriority::High)) +
                 ", Medium: " + std::to_string(GetQueueSize(CombatPriority::Medium)) +
                 ", Low: " + std::to_string(GetQueueSize(CombatPriority::Low)));
     }
 
+    void CombatOptimizer::CollectMetrics(MetricsWriter& out) const
+    {
+        static const char* const PriorityNames[] = { "critical", "high", "medium", "low" };
+
+        // Atomics are read directly; no need for the stats lock
+        out.Counter("tw3_combat_actions_total", "Actions by outcome", static_cast<double>(m_stats.totalActions.load()), { { "outcome", "queued" } });
+        out.Counter("tw3_combat_actions_total", "Actions by outcome", static_cast<double>(m_stats.processedActions.load()), { { "outcome", "processed" } });
+        out.Counter("tw3_combat_actions_total", "Actions by outcome", static_cast<double>(m_stats.droppedActions.load()), { { "outcome", "dropped" } });
+        out.Counter("tw3_combat_actions_total", "Actions by outcome", static_cast<double>(m_stats.expiredActions.load()), { { "outcome", "expired" } });
+        out.Counter("tw3_combat_budget_exhaustions_total", "Processing passes stopped by the time budget",
+                    static_cast<double>(m_stats.budgetExhaustions.load()));
+
+        for (size_t i = 0; i < CombatPriorityCount; ++i)
+        {
+            out.Gauge("tw3_combat_queue_depth", "Actions waiting by priority",
+                      static_cast<double>(GetQueueSize(static_cast<CombatPriority>(i))), { { "priority", PriorityNames[i] } });
+        }
+
+        out.Summary("tw3_combat_processing_seconds", "Time per ProcessActions pass", m_processingTimes, 1e-6);
+        out.Summary("tw3_combat_execution_latency_seconds", "Enqueue to execution latency", m_executionLatency, 1e-6);
+    }
+
+    void CombatOptimizer::SetExecutor(CombatExecutor* executor)
+    {
+        m_executor.store(executor);
+
+        // A producer that loaded the old executor is still notifying it
+        while (m_notifying.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    const HdrHistogram& CombatOptimizer::GetExecutionLatency() const
+    {
+        return m_executionLatency;
+    }
+
+    const HdrHistogram& CombatOptimizer::GetProcessingTimes() const
+    {
+        return m_processingTimes;
+    }
+
     bool CombatOptimizer::IsOverloaded() const
     {
         return GetTotalQueueSize() > m_maxQueueSize * 0.8;
@@ -568,9 +646,15 @@ namespace TW3Optimization
         return m_stats.peakProcessingTime.load();
     }
 
+    void CombatOptimizer::SetMaxProcessingTime(uint32_t maxTime)
+    {
+        m_maxProcessingTime = maxTime;
+        m_processingBudget = std::chrono::microseconds(static_cast<int64_t>(maxTime) * 1000);
+    }
+
     uint32_t CombatOptimizer::GenerateActionId()
     {
-        return m_actionIdCounter++;
+        return m_actionIdCounter.fetch_add(1, std::memory_order_relaxed);
     }
 
     bool CombatOptimizer::IsInitialized() const
@@ -620,7 +704,7 @@ namespace TW3Optimization
 
     CombatActionBuilder& CombatActionBuilder::SetData(const std::vector<uint8_t>& data)
     {
-        m_action.data = data;
+        m_data = data;
         return *this;
     }
 
@@ -632,12 +716,147 @@ namespace TW3Optimization
 
     CombatAction CombatActionBuilder::Build()
     {
-        m_action.id = CombatOptimizer::GetInstance().GenerateActionId();
-        return m_action;
+        auto& optimizer = CombatOptimizer::GetInstance();
+        
+        CombatAction action;
+        action.id = optimizer.GenerateActionId();
+        action.playerId = m_action.playerId;
+        action.type = m_action.type;
+        action.priority = m_action.priority;
+        action.timestamp = m_action.timestamp;
+        action.data = optimizer.AllocatePayload(m_data.size());
+        std::copy(m_data.begin(), m_data.end(), action.data.data());
+        return action;
     }
 
     bool CombatActionBuilder::Submit()
     {
         return CombatOptimizer::GetInstance().AddAction(Build());
     }
+
+    // CombatPerformanceMonitor Implementation
+    CombatPerformanceMonitor::CombatPerformanceMonitor()
+        : m_monitoring(false), m_initialized(false), m_monitoringInterval(100)
+    {
+    }
+
+    CombatPerformanceMonitor::~CombatPerformanceMonitor()
+    {
+        Shutdown();
+    }
+
+    CombatPerformanceMonitor& CombatPerformanceMonitor::GetInstance()
+    {
+        if (!s_instance)
+        {
+            s_instance = new CombatPerformanceMonitor();
+        }
+        return *s_instance;
+    }
+
+    void CombatPerformanceMonitor::DestroyInstance()
+    {
+        if (s_instance)
+        {
+            delete s_instance;
+            s_instance = nullptr;
+        }
+    }
+
+    bool CombatPerformanceMonitor::Initialize(uint32_t monitoringInterval)
+    {
+        if (m_initialized)
+        {
+            return true;
+        }
+
+        m_monitoringInterval = monitoringInterval;
+        ResetData();
+        
+        m_initialized = true;
+        LOG_INFO("CombatPerformanceMonitor initialized with monitoringInterval=" + std::to_string(monitoringInterval) + "ms");
+        return true;
+    }
+
+    bool CombatPerformanceMonitor::Shutdown()
+    {
+        if (!m_initialized)
+        {
+            return true;
+        }
+
+        m_monitoring = false;
+        m_initialized = false;
+        LOG_INFO("CombatPerformanceMonitor shutdown");
+        return true;
+    }
+
+    void CombatPerformanceMonitor::StartMonitoring()
+    {
+        m_monitoring = m_initialized.load();
+    }
+
+    void CombatPerformanceMonitor::StopMonitoring()
+    {
+        m_monitoring = false;
+    }
+
+    void CombatPerformanceMonitor::UpdateFrame(uint64_t frameTime, uint64_t actionCount, uint64_t queueSize)
+    {
+        if (!m_monitoring)
+        {
+            return;
+        }
+
+        m_frameTimes.Record(frameTime);
+        m_actionCounts.Record(actionCount);
+        m_queueSizes.Record(queueSize);
+    }
+
+    const PerThreadHdrHistogram& CombatPerformanceMonitor::GetFrameTimes() const
+    {
+        return m_frameTimes;
+    }
+
+    const PerThreadHdrHistogram& CombatPerformanceMonitor::GetActionCounts() const
+    {
+        return m_actionCounts;
+    }
+
+    const PerThreadHdrHistogram& CombatPerformanceMonitor::GetQueueSizes() const
+    {
+        return m_queueSizes;
+    }
+
+    float CombatPerformanceMonitor::GetAverageFrameTime() const
+    {
+        return static_cast<float>(m_frameTimes.GetMean());
+    }
+
+    float CombatPerformanceMonitor::GetAverageActionCount() const
+    {
+        return static_cast<float>(m_actionCounts.GetMean());
+    }
+
+    float CombatPerformanceMonitor::GetAverageQueueSize() const
+    {
+        return static_cast<float>(m_queueSizes.GetMean());
+    }
+
+    uint64_t CombatPerformanceMonitor::GetFrameTimePercentile(double percentile) const
+    {
+        return m_frameTimes.GetPercentile(percentile);
+    }
+
+    bool CombatPerformanceMonitor::IsMonitoring() const
+    {
+        return m_monitoring;
+    }
+
+    void CombatPerformanceMonitor::ResetData()
+    {
+        m_frameTimes.Reset();
+        m_actionCounts.Reset();
+        m_queueSizes.Reset();
+    }
 }
@@ -36,6 +36,9 @@ namespace Optimization
           m_maxCompressionTime(0.01f) // 10ms max
     {
         LOG_INFO("DataCompression created");
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("compression",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     DataCompression::~DataCompression()
@@ -143,9 +146,8 @@ namespace Optimization
         
         result.insert(result.end(), compressedData.begin(), compressedData.end());
 
-        LOG_DEBUG("Compressed " + std::to_string(data.size()) + " bytes to " + 
-                 std::to_string(result.size()) + " bytes (" + 
-                 std::to_string(GetCompressionRatio(data, result) * 100.0f) + "% ratio)");
+        LOG_DEBUGF("Compressed {} bytes to {} bytes ({}% ratio)",
+                   data.size(), result.size(), GetCompressionRatio(data, result) * 100.0f);
 
         return result;
     }
@@ -202,8 +204,7 @@ namespace Optimization
         m_stats.compressionTime += decompressionTime;
         m_stats.totalDecompressions++;
 
-        LOG_DEBUG("Decompressed " + std::to_string(compressedData.size()) + " bytes to " + 
-                 std::to_string(decompressedData.size()) + " bytes");
+        LOG_DEBUGF("Decompressed {} bytes to {} bytes", compressedData.size(), decompressedData.size());
 
         return decompressedData;
     }
@@ -399,6 +400,19 @@ namespace Optimization
         LOG_INFO("==============================");
     }
 
+    void DataCompression::CollectMetrics(MetricsWriter& out) const
+    {
+        CompressionStats stats = GetStats();
+        out.Counter("tw3_compression_operations_total", "Compression calls by direction",
+                    static_cast<double>(stats.totalCompressions), { { "direction", "compress" } });
+        out.Counter("tw3_compression_operations_total", "Compression calls by direction",
+                    static_cast<double>(stats.totalDecompressions), { { "direction", "decompress" } });
+        out.Counter("tw3_compression_input_bytes_total", "Bytes passed to the compressor", static_cast<double>(stats.originalSize));
+        out.Counter("tw3_compression_output_bytes_total", "Bytes produced by the compressor", static_cast<double>(stats.compressedSize));
+        out.Counter("tw3_compression_seconds_total", "Time spent compressing and decompressing", stats.compressionTime);
+        out.Gauge("tw3_compression_ratio", "Compressed size over original size", stats.compressionRatio);
+    }
+
     void DataCompression::SetDefaultAlgorithm(CompressionAlgorithm algorithm)
     {
         m_defaultAlgorithm = algorithm;
@@ -459,7 +473,7 @@ namespace Optimization
             i += count;
         }
 
-        LOG_DEBUG("Zlib compression: " + std::to_string(data.size()) + " -> " + std::to_string(compressed.size()) + " bytes");
+        LOG_DEBUGF("Zlib compression: {} -> {} bytes", data.size(), compressed.size());
         return compressed;
     }
 
@@ -495,7 +509,7 @@ namespace Optimization
             }
         }
 
-        LOG_DEBUG("Zlib decompression: " + std::to_string(compressedData.size()) + " -> " + std::to_string(decompressed.size()) + " bytes");
+        LOG_DEBUGF("Zlib decompression: {} -> {} bytes", compressedData.size(), decompressed.size());
         return decompressed;
     }
 
@@ -544,7 +558,7 @@ namespace Optimization
             }
         }
 
-        LOG_DEBUG("LZ4 compression: " + std::to_string(data.size()) + " -> " + std::to_string(compressed.size()) + " bytes");
+        LOG_DEBUGF("LZ4 compression: {} -> {} bytes", data.size(), compressed.size());
         return compressed;
     }
 
@@ -595,7 +609,7 @@ namespace Optimization
             }
         }
 
-        LOG_DEBUG("LZ4 decompression: " + std::to_string(compressedData.size()) + " -> " + std::to_string(decompressed.size()) + " bytes");
+        LOG_DEBUGF("LZ4 decompression: {} -> {} bytes", compressedData.size(), decompressed.size());
         return decompressed;
     }
 
@@ -0,0 +1,104 @@
+#include "optimization/DeterministicMovement.h"
+#include <cmath>
+
+namespace Optimization
+{
+    namespace DeterministicMovement
+    {
+        Fixed Fixed::FromFloat(float value)
+        {
+            // Scaling by a power of two is exact in double, so rounding is the only step
+            if (!std::isfinite(value))
+            {
+                return Fixed();
+            }
+            return FromRaw(static_cast<int64_t>(std::llround(static_cast<double>(value) * static_cast<double>(One))));
+        }
+
+        float Fixed::ToFloat() const
+        {
+            return static_cast<float>(static_cast<double>(raw) / static_cast<double>(One));
+        }
+
+        FixedVector Quantize(const Vector4F& vector)
+        {
+            return FixedVector{Fixed::FromFloat(vector.x), Fixed::FromFloat(vector.y), Fixed::FromFloat(vector.z)};
+        }
+
+        Vector4F ToVector(const FixedVector& vector, float w)
+        {
+            return Vector4F{vector.x.ToFloat(), vector.y.ToFloat(), vector.z.ToFloat(), w};
+        }
+
+        Vector4F QuantizeVector(const Vector4F& vector)
+        {
+            return ToVector(Quantize(vector), vector.w);
+        }
+
+        FixedVector CalculateMovement(const FixedVector& position, const FixedVector& velocity,
+                                      const FixedVector& acceleration, Fixed deltaTime)
+        {
+            // p + v*dt + a*dt^2/2, evaluated in a fixed order
+            Fixed halfDtSquared = Fixed::FromRaw((deltaTime * deltaTime).raw / 2);
+            FixedVector result;
+            result.x = position.x + velocity.x * deltaTime + acceleration.x * halfDtSquared;
+            result.y = position.y + velocity.y * deltaTime + acceleration.y * halfDtSquared;
+            result.z = position.z + velocity.z * deltaTime + acceleration.z * halfDtSquared;
+            return result;
+        }
+
+        FixedVector CalculateVelocity(const FixedVector& velocity, const FixedVector& acceleration, Fixed deltaTime)
+        {
+            FixedVector result;
+            result.x = velocity.x + acceleration.x * deltaTime;
+            result.y = velocity.y + acceleration.y * deltaTime;
+            result.z = velocity.z + acceleration.z * deltaTime;
+            return result;
+        }
+
+        FixedVector CalculateFriction(const FixedVector& velocity, Fixed friction, Fixed deltaTime)
+        {
+            UNUSED(deltaTime);
+            FixedVector result;
+            result.x = -(velocity.x * friction);
+            result.y = -(velocity.y * friction);
+            result.z = -(velocity.z * friction);
+            return result;
+        }
+
+        FixedVector CalculateGravity(const FixedVector& velocity, Fixed gravity, Fixed deltaTime)
+        {
+            FixedVector result = velocity;
+            result.y = velocity.y - gravity * deltaTime;
+            return result;
+        }
+
+        State Step(const State& state, const Input& input, Fixed deltaTime)
+        {
+            State next;
+            next.position = CalculateMovement(state.position, input.velocity, input.acceleration, deltaTime);
+            next.velocity = CalculateVelocity(input.velocity, input.acceleration, deltaTime);
+            return next;
+        }
+
+        uint64_t HashState(const State& state, uint64_t seed)
+        {
+            const int64_t values[] = {
+                state.position.x.raw, state.position.y.raw, state.position.z.raw,
+                state.velocity.x.raw, state.velocity.y.raw, state.velocity.z.raw
+            };
+
+            uint64_t hash = seed;
+            for (int64_t value : values)
+            {
+                uint64_t bits = static_cast<uint64_t>(value);
+                for (int byte = 0; byte < 8; ++byte)
+                {
+                    hash ^= (bits >> (byte * 8)) & 0xFF;
+                    hash *= 1099511628211ull;
+                }
+            }
+            return hash;
+        }
+    }
+}
@@ -0,0 +1,167 @@
+#include "optimization/JitterBuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace Optimization
+{
+    // ClockSync implementation
+    ClockSync::ClockSync()
+    {
+        Reset();
+    }
+
+    int64_t ClockSync::NowMicros()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void ClockSync::AddSample(int64_t t0, int64_t t1, int64_t t2, int64_t t3)
+    {
+        ClockSyncSample sample;
+        sample.offset = ((t1 - t0) + (t2 - t3)) / 2;
+        sample.roundTrip = std::max<int64_t>(0, (t3 - t0) - (t2 - t1));
+
+        m_samples[m_nextSample] = sample;
+        m_nextSample = (m_nextSample + 1) % WindowSize;
+        m_sampleCount = std::min(m_sampleCount + 1, WindowSize);
+
+        // Round trip jitter (RFC 3550 style smoothing)
+        if (m_lastRoundTrip >= 0)
+        {
+            float delta = static_cast<float>(std::llabs(sample.roundTrip - m_lastRoundTrip));
+            m_roundTripJitter += (delta - m_roundTripJitter) / 16.0f;
+        }
+        m_lastRoundTrip = sample.roundTrip;
+
+        // The sample with the smallest round trip has the least queuing error
+        const ClockSyncSample* best = &m_samples[0];
+        for (size_t i = 1; i < m_sampleCount; ++i)
+        {
+            if (m_samples[i].roundTrip < best->roundTrip)
+            {
+                best = &m_samples[i];
+            }
+        }
+
+        m_offset = best->offset;
+        m_roundTrip = best->roundTrip;
+    }
+
+    void ClockSync::Reset()
+    {
+        m_samples.fill(ClockSyncSample());
+        m_sampleCount = 0;
+        m_nextSample = 0;
+        m_offset = 0;
+        m_roundTrip = 0;
+        m_lastRoundTrip = -1;
+        m_roundTripJitter = 0.0f;
+    }
+
+    // JitterBuffer implementation
+    JitterBuffer::JitterBuffer()
+        : JitterBuffer(JitterBufferConfig())
+    {
+    }
+
+    JitterBuffer::JitterBuffer(const JitterBufferConfig& config)
+        : m_config(config)
+    {
+        Reset();
+    }
+
+    void JitterBuffer::OnArrival(int64_t arrivalMicros, int64_t senderMicros)
+    {
+        if (m_arrivals > 0)
+        {
+            float interval = static_cast<float>(arrivalMicros - m_lastArrival) / 1000000.0f;
+
+            if (m_arrivals == 1)
+            {
+                m_meanInterval = interval;
+            }
+
+            // Deviation from the expected spacing: the sender spacing when the
+            // sender clock is known, otherwise the running mean interval
+            float deviation = interval - m_meanInterval;
+            if (senderMicros != 0 && m_lastSender != 0)
+            {
+                deviation = interval - static_cast<float>(senderMicros - m_lastSender) / 1000000.0f;
+            }
+
+            m_meanInterval += m_config.gain * (interval - m_meanInterval);
+            m_variance += m_config.gain * (deviation * deviation - m_variance);
+        }
+
+        m_lastArrival = arrivalMicros;
+        m_lastSender = senderMicros;
+        m_arrivals++;
+
+        UpdateDelay();
+    }
+
+    void JitterBuffer::RecordPlayout(bool extrapolated)
+    {
+        m_windowPlayouts++;
+        if (extrapolated)
+        {
+            m_windowExtrapolations++;
+        }
+
+        if (m_windowPlayouts < m_config.adaptationWindow)
+        {
+            return;
+        }
+
+        float rate = static_cast<float>(m_windowExtrapolations) / static_cast<float>(m_windowPlayouts);
+        m_extrapolationRate = 0.5f * (m_extrapolationRate + rate);
+
+        // Grow quickly when starving, shrink slowly to win back latency
+        if (rate > m_config.targetExtrapolationRate)
+        {
+            m_safetyFactor *= 1.5f;
+        }
+        else if (rate < 0.5f * m_config.targetExtrapolationRate)
+        {
+            m_safetyFactor *= 0.9f;
+        }
+        m_safetyFactor = std::clamp(m_safetyFactor, m_config.minSafetyFactor, m_config.maxSafetyFactor);
+
+        m_windowPlayouts = 0;
+        m_windowExtrapolations = 0;
+
+        UpdateDelay();
+    }
+
+    void JitterBuffer::Reset()
+    {
+        m_arrivals = 0;
+        m_lastArrival = 0;
+        m_lastSender = 0;
+        m_meanInterval = 0.0f;
+        m_variance = 0.0f;
+        m_windowPlayouts = 0;
+        m_windowExtrapolations = 0;
+        m_extrapolationRate = 0.0f;
+        m_safetyFactor = m_config.initialSafetyFactor;
+        m_delay = std::clamp(0.1f, m_config.minDelay, m_config.maxDelay);
+    }
+
+    float JitterBuffer::GetJitter() const
+    {
+        return std::sqrt(std::max(0.0f, m_variance));
+    }
+
+    void JitterBuffer::UpdateDelay()
+    {
+        if (m_arrivals < 2)
+        {
+            return;
+        }
+
+        float delay = m_meanInterval + m_safetyFactor * GetJitter();
+        m_delay = std::clamp(delay, m_config.minDelay, m_config.maxDelay);
+    }
+}
@@ -258,6 +258,9 @@ namespace Optimization
         m_lastRateReset = m_lastUpdateTime;
         
         LOG_INFO("Network traffic manager created");
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("traffic",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     NetworkTrafficManager::~NetworkTrafficManager()
@@ -330,10 +333,14 @@ namespace Optimization
         }
 
         std::vector<PrioritizedMessage> messages = m_priorityQueue.PopMessages(maxCount);
+        auto now = std::chrono::high_resolution_clock::now();
         
         // Update statistics
         for (const auto& message : messages)
         {
+            auto queued = std::chrono::duration_cast<std::chrono::microseconds>(now - message.timestamp).count();
+            m_queueTime.Record(static_cast<uint64_t>(std::max<int64_t>(0, queued)));
+
             m_stats.messagesSent++;
             m_stats.bytesSent += message.data.size();
             m_bytesSentThisSecond += message.data.size();
@@ -400,12 +407,19 @@ namespace Optimization
 
     NetworkTrafficManager::TrafficStats NetworkTrafficManager::GetStats() const
     {
-        return m_stats;
+        TrafficStats stats = m_stats;
+        stats.averageLatency = static_cast<float>(m_queueTime.GetMean()) / 1000.0f;
+        stats.maxLatency = static_cast<float>(m_queueTime.GetMax()) / 1000.0f;
+        stats.p50Latency = static_cast<float>(m_queueTime.GetPercentile(50.0)) / 1000.0f;
+        stats.p99Latency = static_cast<float>(m_queueTime.GetPercentile(99.0)) / 1000.0f;
+        stats.p999Latency = static_cast<float>(m_queueTime.GetPercentile(99.9)) / 1000.0f;
+        return stats;
     }
 
     void NetworkTrafficManager::ResetStats()
     {
         m_stats.Reset();
+        m_queueTime.Reset();
     }
 
     void NetworkTrafficManager::PrintStats() const
@@ -417,13 +431,41 @@ namespace Optimization
         LOG_INFO("Messages retried: " + std::to_string(m_stats.messagesRetried));
         LOG_INFO("Bytes sent: " + std::to_string(m_stats.bytesSent));
         LOG_INFO("Bytes dropped: " + std::to_string(m_stats.bytesDropped));
-        LOG_INFO("Average latency: " + std::to_string(m_stats.averageLatency) + "ms");
-        LOG_INFO("Max latency: " + std::to_string(m_stats.maxLatency) + "ms");
+        TrafficStats stats = GetStats();
+        LOG_INFO("Average latency: " + std::to_string(stats.averageLatency) + "ms");
+        LOG_INFO("Max latency: " + std::to_string(stats.maxLatency) + "ms");
+        LOG_INFO("Latency p50/p99/p999: " + std::to_string(stats.p50Latency) + "/" +
+                 std::to_string(stats.p99Latency) + "/" + std::to_string(stats.p999Latency) + "ms");
         LOG_INFO("Bandwidth utilization: " + std::to_string(m_stats.bandwidthUtilization * 100.0f) + "%");
         LOG_INFO("Congestion level: " + std::to_string(m_stats.congestionLevel * 100.0f) + "%");
         LOG_INFO("=================================");
     }
 
+    void NetworkTrafficManager::CollectMetrics(MetricsWriter& out) const
+    {
+        static const char* const PriorityNames[] = { "critical", "high", "medium", "low", "background" };
+
+        out.Counter("tw3_traffic_messages_processed_total", "Messages taken from the priority queue",
+                    static_cast<double>(m_stats.totalMessagesProcessed));
+        out.Counter("tw3_traffic_messages_sent_total", "Messages sent", static_cast<double>(m_stats.messagesSent));
+        out.Counter("tw3_traffic_messages_dropped_total", "Messages dropped under congestion", static_cast<double>(m_stats.messagesDropped));
+        out.Counter("tw3_traffic_messages_retried_total", "Messages retried", static_cast<double>(m_stats.messagesRetried));
+        out.Counter("tw3_traffic_sent_bytes_total", "Bytes sent", static_cast<double>(m_stats.bytesSent));
+        out.Counter("tw3_traffic_dropped_bytes_total", "Bytes dropped under congestion", static_cast<double>(m_stats.bytesDropped));
+        out.Gauge("tw3_traffic_bandwidth_utilization", "Share of the bandwidth limit used (0-1)", m_stats.bandwidthUtilization);
+        out.Gauge("tw3_traffic_congestion_level", "Congestion estimate (0-1)", m_stats.congestionLevel);
+        out.Summary("tw3_traffic_queue_time_seconds", "Enqueue to send time", m_queueTime, 1e-6);
+
+        MessagePriorityQueue::QueueStats queueStats = m_priorityQueue.GetStats();
+        for (size_t i = 0; i < 5; ++i)
+        {
+            out.Counter("tw3_priority_queue_messages_total", "Messages queued by priority",
+                        static_cast<double>(queueStats.messagesByPriority[i]), { { "priority", PriorityNames[i] } });
+        }
+        out.Counter("tw3_priority_queue_expired_total", "Messages that expired in the queue", static_cast<double>(queueStats.expiredMessages));
+        out.Counter("tw3_priority_queue_dropped_total", "Messages dropped from the queue", static_cast<double>(queueStats.droppedMessages));
+    }
+
     void NetworkTrafficManager::SetConfig(const std::map<Networking::MessageTypes, MessageClassification>& classifications)
     {
         for (const auto& pair : classifications)
@@ -1,4 +1,5 @@
 #include "optimization/MovementPrediction.h"
+#include "optimization/DeterministicMovement.h"
 #include "utils/Logger.h"
 #include <algorithm>
 #include <cmath>
@@ -6,12 +7,14 @@
 namespace Optimization
 {
     MovementPrediction::MovementPrediction()
-        : m_initialized(false), m_nextInputId(1), m_accumulatedTime(0.0f)
+        : m_initialized(false), m_nextInputId(1), m_newestInputId(0), m_lastProcessedInputId(0),
+          m_lastAckedInputId(0), m_hasPendingReconciliation(false), m_accumulatedTime(0.0f)
     {
         m_currentPosition = Vector4F{0.0f, 0.0f, 0.0f, 1.0f};
         m_currentVelocity = Vector4F{0.0f, 0.0f, 0.0f, 0.0f};
         m_currentAcceleration = Vector4F{0.0f, 0.0f, 0.0f, 0.0f};
         m_currentRotation = 0.0f;
+        m_correctionError = Vector4F{0.0f, 0.0f, 0.0f, 0.0f};
         
         m_lastUpdateTime = std::chrono::high_resolution_clock::now();
     }
@@ -21,6 +24,45 @@ namespace Optimization
         Shutdown();
     }
 
+    MovementPrediction::MovementPrediction(MovementPrediction&& other) noexcept
+        : m_initialized(false)
+    {
+        *this = std::move(other);
+    }
+
+    MovementPrediction& MovementPrediction::operator=(MovementPrediction&& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        m_initialized = other.m_initialized;
+        m_config = other.m_config;
+        m_stats = other.m_stats;
+        m_currentPosition = other.m_currentPosition;
+        m_currentVelocity = other.m_currentVelocity;
+        m_currentAcceleration = other.m_currentAcceleration;
+        m_currentRotation = other.m_currentRotation;
+        m_inputRing = std::move(other.m_inputRing);
+        m_stateRing = std::move(other.m_stateRing);
+        m_nextInputId = other.m_nextInputId;
+        m_newestInputId = other.m_newestInputId;
+        m_lastProcessedInputId = other.m_lastProcessedInputId;
+        m_lastAckedInputId = other.m_lastAckedInputId;
+        m_pendingReconciliation = other.m_pendingReconciliation;
+        m_hasPendingReconciliation = other.m_hasPendingReconciliation;
+        m_correctionError = other.m_correctionError;
+        m_positionUpdateCallback = std::move(other.m_positionUpdateCallback);
+        m_reconciliationCallback = std::move(other.m_reconciliationCallback);
+        m_lastUpdateTime = other.m_lastUpdateTime;
+        m_accumulatedTime = other.m_accumulatedTime;
+
+        // The moved-from object owns nothing and must not shut down on destruction
+        other.m_initialized = false;
+        return *this;
+    }
+
     bool MovementPrediction::Initialize(const PredictionConfig& config)
     {
         if (m_initialized)
@@ -31,9 +73,11 @@ namespace Optimization
         LOG_INFO("Initializing movement prediction system...");
 
         m_config = config;
+        ResetBuffers();
         m_initialized = true;
         
-        LOG_INFO("Movement prediction system initialized");
+        LOG_INFO("Movement prediction system initialized (history: " + 
+                std::to_string(m_inputRing.Capacity()) + " inputs)");
         return true;
     }
 
@@ -48,12 +92,6 @@ namespace Optimization
         
         // Clear all data
         ClearInputs();
-        m_predictedStates.clear();
-        m_reconciliationData.clear();
-        
-        // Clear queues
-        while (!m_predictionQueue.empty()) m_predictionQueue.pop();
-        while (!m_reconciliationQueue.empty()) m_reconciliationQueue.pop();
         
         m_initialized = false;
         LOG_INFO("Movement prediction system shutdown complete");
@@ -72,21 +110,25 @@ namespace Optimization
             return;
         }
 
-        // Assign input ID if not set
-        MovementInput inputCopy = input;
-        if (inputCopy.inputId == 0)
+        uint32_t inputId = input.inputId != 0 ? input.inputId : m_nextInputId;
+        if (inputId <= m_lastProcessedInputId)
         {
-            inputCopy.inputId = m_nextInputId++;
+            // Duplicate or late input, already simulated
+            return;
         }
 
-        // Add to input history
-        m_inputHistory.push(inputCopy);
-        m_inputMap[inputCopy.inputId] = inputCopy;
+        // Writing over a slot that still holds an unacked input loses it
+        if (m_lastAckedInputId != 0 && inputId - m_lastAckedInputId > m_inputRing.Capacity())
+        {
+            m_stats.overwrittenInputs++;
+        }
 
-        // Clean up old inputs
-        CleanupOldInputs();
+        MovementInput* slot = m_inputRing.Insert(inputId);
+        *slot = input;
+        slot->inputId = inputId;
 
-        LOG_DEBUG("Added movement input ID: " + std::to_string(inputCopy.inputId));
+        m_newestInputId = std::max(m_newestInputId, inputId);
+        m_nextInputId = std::max(m_nextInputId, inputId + 1);
     }
 
     void MovementPrediction::ProcessInputs(float deltaTime)
@@ -98,41 +140,51 @@ namespace Optimization
 
         m_accumulatedTime += deltaTime;
 
-        // Process all inputs in the queue
-        while (!m_inputHistory.empty())
+        // Simulate every input received since the last tick, oldest first
+        bool processedInput = false;
+        uint32_t capacity = static_cast<uint32_t>(m_inputRing.Capacity());
+        uint32_t firstInputId = m_lastProcessedInputId + 1;
+        if (m_newestInputId >= capacity && firstInputId <= m_newestInputId - capacity)
         {
-            MovementInput input = m_inputHistory.front();
-            m_inputHistory.pop();
-
-            ProcessMovementInput(input, deltaTime);
+            firstInputId = m_newestInputId - capacity + 1;
         }
 
-        // Update current state
-        UpdateCurrentState(deltaTime);
-
-        // Process reconciliation queue
-        while (!m_reconciliationQueue.empty())
+        for (uint32_t inputId = firstInputId; inputId <= m_newestInputId && inputId != 0; ++inputId)
         {
-            uint32_t inputId = m_reconciliationQueue.front();
-            m_reconciliationQueue.pop();
-
-            auto it = m_reconciliationData.find(inputId);
-            if (it != m_reconciliationData.end())
+            const MovementInput* input = m_inputRing.Find(inputId);
+            if (input)
             {
-                PerformReconciliation(inputId, it->second.serverPosition);
+                ProcessMovementInput(*input, deltaTime);
+                processedInput = true;
             }
         }
+        m_lastProcessedInputId = std::max(m_lastProcessedInputId, m_newestInputId);
+
+        // Dead-reckon when no input arrived this tick
+        if (!processedInput)
+        {
+            UpdateCurrentState(deltaTime);
+        }
+
+        // Apply the newest authoritative state
+        if (m_hasPendingReconciliation)
+        {
+            m_hasPendingReconciliation = false;
+            PerformReconciliation(m_pendingReconciliation);
+        }
+
+        SmoothCorrection(deltaTime);
     }
 
     void MovementPrediction::ClearInputs()
     {
-        while (!m_inputHistory.empty()) m_inputHistory.pop();
-        m_inputMap.clear();
-        m_predictedStates.clear();
-        m_reconciliationData.clear();
-        
-        while (!m_predictionQueue.empty()) m_predictionQueue.pop();
-        while (!m_reconciliationQueue.empty()) m_reconciliationQueue.pop();
+        m_inputRing.Clear();
+        m_stateRing.Clear();
+        m_newestInputId = 0;
+        m_lastProcessedInputId = 0;
+        m_lastAckedInputId = 0;
+        m_hasPendingReconciliation = false;
+        m_correctionError = Vector4F{0.0f, 0.0f, 0.0f, 0.0f};
     }
 
     PredictedState MovementPrediction::PredictMovement(const MovementInput& input, float deltaTime)
@@ -147,12 +199,31 @@ namespace Optimization
         PredictedState predictedState;
         predictedState.inputId = input.inputId;
         predictedState.timestamp = input.timestamp;
+        predictedState.deltaTime = deltaTime;
         
-        // Predict position
-        predictedState.position = PredictPosition(m_currentPosition, input.velocity, input.acceleration, deltaTime);
-        
-        // Predict velocity
-        predictedState.velocity = PredictVelocity(input.velocity, input.acceleration, deltaTime);
+        if (m_config.useDeterministicSimulation)
+        {
+            // Bit-identical on client and server, so agreeing inputs never trigger a reconciliation
+            DeterministicMovement::State state;
+            state.position = DeterministicMovement::Quantize(m_currentPosition);
+            DeterministicMovement::Input fixedInput;
+            fixedInput.velocity = DeterministicMovement::Quantize(input.velocity);
+            fixedInput.acceleration = DeterministicMovement::Quantize(input.acceleration);
+            
+            DeterministicMovement::State next = DeterministicMovement::Step(
+                state, fixedInput, DeterministicMovement::Fixed::FromFloat(deltaTime));
+            predictedState.position = DeterministicMovement::ToVector(next.position, m_currentPosition.w);
+            predictedState.velocity = DeterministicMovement::ToVector(next.velocity);
+        }
+        else
+        {
+            // Predict position
+            predictedState.position = PredictPosition(m_currentPosition, input.velocity, input.acceleration, deltaTime);
+            
+            // Predict velocity
+            predictedState.velocity = PredictVelocity(input.velocity, input.acceleration, deltaTime);
+        }
+        predictedState.acceleration = input.acceleration;
         
         // Predict rotation
         predictedState.rotation = PredictRotation(input.rotation, deltaTime);
@@ -160,8 +231,10 @@ namespace Optimization
         predictedState.isValid = true;
 
         // Store predicted state
-        m_predictedStates[input.inputId] = predictedState;
-        m_predictionQueue.push(input.inputId);
+        if (PredictedState* slot = m_stateRing.Insert(input.inputId))
+        {
+            *slot = predictedState;
+        }
 
         auto endTime = std::chrono::high_resolution_clock::now();
         float predictionTime = std::chrono::duration<float>(endTime - startTime).count();
@@ -169,8 +242,6 @@ namespace Optimization
         m_stats.totalPredictionTime += predictionTime;
         m_stats.totalPredictions++;
 
-        LOG_DEBUG("Predicted movement for input ID: " + std::to_string(input.inputId));
-
         return predictedState;
     }
 
@@ -199,11 +270,11 @@ namespace Optimization
         reconciliationData.timestamp = timestamp;
         reconciliationData.serverPosition = serverPosition;
         
-        auto it = m_predictedStates.find(inputId);
-        if (it != m_predictedStates.end())
+        const PredictedState* predicted = m_stateRing.Find(inputId);
+        if (predicted)
         {
-            reconciliationData.clientPosition = it->second.position;
-            reconciliationData.positionError = CalculatePositionError(it->second.position, serverPosition);
+            reconciliationData.clientPosition = predicted->position;
+            reconciliationData.positionError = CalculatePositionError(predicted->position, serverPosition);
             reconciliationData.needsCorrection = reconciliationData.positionError > m_config.reconciliationThreshold;
         }
 
@@ -217,19 +288,22 @@ namespace Optimization
             return;
         }
 
-        m_reconciliationData[reconciliationData.inputId] = reconciliationData;
-        m_reconciliationQueue.push(reconciliationData.inputId);
+        // Older acknowledgements are superseded by newer ones
+        if (m_hasPendingReconciliation && reconciliationData.inputId <= m_pendingReconciliation.inputId)
+        {
+            return;
+        }
+
+        m_pendingReconciliation = reconciliationData;
+        m_hasPendingReconciliation = true;
         
         m_stats.totalReconciliations++;
-
-        LOG_DEBUG("Reconciliation queued for input ID: " + std::to_string(reconciliationData.inputId) + 
-                 " (error: " + std::to_string(reconciliationData.positionError) + ")");
     }
 
     bool MovementPrediction::NeedsReconciliation(uint32_t inputId) const
     {
-        auto it = m_reconciliationData.find(inputId);
-        return it != m_reconciliationData.end() && it->second.needsCorrection;
+        return m_hasPendingReconciliation && m_pendingReconciliation.inputId == inputId && 
+               m_pendingReconciliation.needsCorrection;
     }
 
     void MovementPrediction::SetCurrentState(const Vector4F& position, const Vector4F& velocity, float rotation)
@@ -244,6 +318,15 @@ namespace Optimization
         return m_currentPosition;
     }
 
+    Vector4F MovementPrediction::GetSmoothedPosition() const
+    {
+        Vector4F smoothed = m_currentPosition;
+        smoothed.x += m_correctionError.x;
+        smoothed.y += m_correctionError.y;
+        smoothed.z += m_correctionError.z;
+        return smoothed;
+    }
+
     Vector4F MovementPrediction::GetCurrentVelocity() const
     {
         return m_currentVelocity;
@@ -266,22 +349,28 @@ namespace Optimization
 
     Vector4F MovementPrediction::GetPredictedPosition(uint32_t inputId) const
     {
-        auto it = m_predictedStates.find(inputId);
-        if (it != m_predictedStates.end())
+        const PredictedState* predicted = m_stateRing.Find(inputId);
+        if (predicted)
         {
-            return it->second.position;
+            return predicted->position;
         }
         return m_currentPosition;
     }
 
     bool MovementPrediction::IsStatePredicted(uint32_t inputId) const
     {
-        return m_predictedStates.find(inputId) != m_predictedStates.end();
+        return m_stateRing.Contains(inputId);
     }
 
     void MovementPrediction::SetConfig(const PredictionConfig& config)
     {
+        bool resize = config.inputBufferSize != m_config.inputBufferSize;
         m_config = config;
+        
+        if (resize && m_initialized)
+        {
+            ResetBuffers();
+        }
     }
 
     PredictionConfig MovementPrediction::GetConfig() const
@@ -309,6 +398,12 @@ namespace Optimization
         LOG_INFO("Average prediction error: " + std::to_string(m_stats.averagePredictionError));
         LOG_INFO("Max prediction error: " + std::to_string(m_stats.maxPredictionError));
         LOG_INFO("Total prediction time: " + std::to_string(m_stats.totalPredictionTime) + "s");
+        LOG_INFO("Replays: " + std::to_string(m_stats.replays) + 
+                " (inputs replayed: " + std::to_string(m_stats.totalReplayedInputs) + 
+                ", max depth: " + std::to_string(m_stats.maxReplayDepth) + ")");
+        LOG_INFO("Average correction magnitude: " + std::to_string(m_stats.averageCorrectionMagnitude));
+        LOG_INFO("Max correction magnitude: " + std::to_string(m_stats.maxCorrectionMagnitude));
+        LOG_INFO("Overwritten inputs: " + std::to_string(m_stats.overwrittenInputs));
         LOG_INFO("=====================================");
     }
 
@@ -368,6 +463,17 @@ namespace Optimization
     }
 
     void MovementPrediction::ProcessMovementInput(const MovementInput& input, float deltaTime)
+    {
+        SimulateInput(input, deltaTime);
+        
+        // Call position update callback
+        if (m_positionUpdateCallback)
+        {
+            m_positionUpdateCallback(m_currentPosition, input.timestamp);
+        }
+    }
+
+    PredictedState MovementPrediction::SimulateInput(const MovementInput& input, float deltaTime)
     {
         // Update current state based on input
         if (input.isMoving)
@@ -378,17 +484,13 @@ namespace Optimization
         
         m_currentRotation = input.rotation;
         
-        // Predict movement
+        // Predict movement and record it against the input
         PredictedState predictedState = PredictMovement(input, deltaTime);
         
         // Update current position
         m_currentPosition = predictedState.position;
         
-        // Call position update callback
-        if (m_positionUpdateCallback)
-        {
-            m_positionUpdateCallback(m_currentPosition, input.timestamp);
-        }
+        return predictedState;
     }
 
     void MovementPrediction::UpdateCurrentState(float deltaTime)
@@ -404,56 +506,90 @@ namespace Optimization
         m_currentVelocity.z += m_currentAcceleration.z * deltaTime;
     }
 
-    void MovementPrediction::PerformReconciliation(uint32_t inputId, const Vector4F& serverPosition)
+    void MovementPrediction::PerformReconciliation(const ReconciliationData& reconciliationData)
     {
-        auto it = m_predictedStates.find(inputId);
-        if (it == m_predictedStates.end())
+        const PredictedState* predicted = m_stateRing.Find(reconciliationData.inputId);
+        if (!predicted || reconciliationData.inputId <= m_lastAckedInputId)
         {
             return;
         }
 
-        Vector4F predictedPosition = it->second.position;
-        float positionError = CalculatePositionError(predictedPosition, serverPosition);
+        m_lastAckedInputId = reconciliationData.inputId;
 
-        if (positionError > m_config.reconciliationThreshold)
+        Vector4F predictedPosition = predicted->position;
+        float positionError = CalculatePositionError(predictedPosition, reconciliationData.serverPosition);
+
+        if (!m_config.enableReconciliation || positionError <= m_config.reconciliationThreshold)
         {
-            // Perform correction
-            if (m_config.enableSmoothing)
-            {
-                SmoothCorrection(serverPosition, 0.016f); // 60 FPS
-            }
-            else
-            {
-                m_currentPosition = serverPosition;
-            }
+            m_stats.successfulPredictions++;
+            return;
+        }
 
-            // Update statistics
-            m_stats.averagePredictionError = (m_stats.averagePredictionError + positionError) / 2.0f;
-            m_stats.maxPredictionError = std::max(m_stats.maxPredictionError, positionError);
+        m_stats.failedPredictions++;
+        Vector4F positionBefore = GetSmoothedPosition();
 
-            // Call reconciliation callback
-            if (m_reconciliationCallback)
-            {
-                m_reconciliationCallback(inputId, predictedPosition, serverPosition);
-            }
+        // Rewind to the authoritative state and re-simulate only the unacked inputs
+        m_currentPosition = reconciliationData.serverPosition;
+        m_currentVelocity = predicted->velocity;
+        m_currentAcceleration = predicted->acceleration;
+        uint32_t replayDepth = ReplayUnackedInputs(reconciliationData.inputId);
 
-            LOG_DEBUG("Reconciled position for input ID: " + std::to_string(inputId) + 
-                     " (error: " + std::to_string(positionError) + ")");
+        // Hide the snap behind a decaying visual offset when smoothing is enabled
+        if (m_config.enableSmoothing)
+        {
+            m_correctionError.x = positionBefore.x - m_currentPosition.x;
+            m_correctionError.y = positionBefore.y - m_currentPosition.y;
+            m_correctionError.z = positionBefore.z - m_currentPosition.z;
         }
         else
         {
-            m_stats.successfulPredictions++;
+            m_correctionError = Vector4F{0.0f, 0.0f, 0.0f, 0.0f};
+        }
+
+        // Update statistics
+        float correctionMagnitude = CalculatePositionError(positionBefore, m_currentPosition);
+        m_stats.averagePredictionError = (m_stats.averagePredictionError + positionError) / 2.0f;
+        m_stats.maxPredictionError = std::max(m_stats.maxPredictionError, positionError);
+        m_stats.replays++;
+        m_stats.totalReplayedInputs += replayDepth;
+        m_stats.maxReplayDepth = std::max(m_stats.maxReplayDepth, replayDepth);
+        m_stats.averageCorrectionMagnitude = (m_stats.averageCorrectionMagnitude + correctionMagnitude) / 2.0f;
+        m_stats.maxCorrectionMagnitude = std::max(m_stats.maxCorrectionMagnitude, correctionMagnitude);
+
+        // Call reconciliation callback
+        if (m_reconciliationCallback)
+        {
+            m_reconciliationCallback(reconciliationData.inputId, predictedPosition, reconciliationData.serverPosition);
+        }
+    }
+
+    uint32_t MovementPrediction::ReplayUnackedInputs(uint32_t fromInputId)
+    {
+        uint32_t replayDepth = 0;
+
+        for (uint32_t inputId = fromInputId + 1; inputId <= m_lastProcessedInputId && inputId != 0; ++inputId)
+        {
+            const MovementInput* input = m_inputRing.Find(inputId);
+            const PredictedState* state = m_stateRing.Find(inputId);
+            if (!input || !state)
+            {
+                continue;
+            }
+
+            // Replay with the original step length so the result matches the first pass
+            SimulateInput(*input, state->deltaTime);
+            replayDepth++;
         }
 
-        // Remove from predicted states
-        m_predictedStates.erase(it);
+        return replayDepth;
     }
 
-    void MovementPrediction::SmoothCorrection(const Vector4F& targetPosition, float deltaTime)
+    void MovementPrediction::SmoothCorrection(float deltaTime)
     {
-        Vector4F currentPos = m_currentPosition;
-        Vector4F smoothedPos = InterpolatePosition(currentPos, targetPosition, m_config.smoothingFactor * deltaTime);
-        m_currentPosition = smoothedPos;
+        float decay = std::max(0.0f, 1.0f - m_config.interpolationSpeed * deltaTime);
+        m_correctionError.x *= decay;
+        m_correctionError.y *= decay;
+        m_correctionError.z *= decay;
     }
 
     float MovementPrediction::CalculatePositionError(const Vector4F& predicted, const Vector4F& actual) const
@@ -469,37 +605,13 @@ namespace Optimization
         return MovementUtils::ValidateMovementInput(input);
     }
 
-    void MovementPrediction::CleanupOldInputs()
+    void MovementPrediction::ResetBuffers()
     {
-        float currentTime = static_cast<float>(std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::high_resolution_clock::now().time_since_epoch()).count()) / 1000.0f;
-
-        // Remove old inputs from map
-        auto it = m_inputMap.begin();
-        while (it != m_inputMap.end())
-        {
-            if (currentTime - it->second.timestamp > m_config.maxInputHistory)
-            {
-                it = m_inputMap.erase(it);
-            }
-            else
-            {
-                ++it;
-            }
-        }
-    }
-
-    void MovementPrediction::CleanupOldStates()
-    {
-        // Remove old predicted states
-        if (m_predictedStates.size() > m_config.maxPredictedStates)
-        {
-            auto it = m_predictedStates.begin();
-            for (size_t i = 0; i < m_predictedStates.size() - m_config.maxPredictedStates; ++i)
-            {
-                it = m_predictedStates.erase(it);
-            }
-        }
+        // Allocate once up front so steady-state input handling never allocates
+        size_t capacity = std::max<size_t>(m_config.inputBufferSize, 1);
+        m_inputRing.Reset(capacity);
+        m_stateRing.Reset(capacity);
+        ClearInputs();
     }
 
     // Movement prediction utilities
@@ -602,6 +714,7 @@ namespace Optimization
 
     // Movement prediction manager implementation
     MovementPredictionManager::MovementPredictionManager()
+        : m_parallelThreshold(64), m_playersPerTask(32)
     {
         LOG_INFO("Movement prediction manager created");
     }
@@ -620,52 +733,79 @@ namespace Optimization
             return;
         }
 
-        auto prediction = std::make_unique<MovementPrediction>();
-        prediction->Initialize(config);
-        m_playerPredictions[playerId] = std::move(prediction);
+        m_predictions.emplace_back();
+        m_predictions.back().Initialize(config);
+        m_playerIds.push_back(playerId);
+        m_playerIndex[playerId] = m_predictions.size() - 1;
 
         LOG_INFO("Added player " + std::to_string(playerId) + " to prediction manager");
     }
 
     void MovementPredictionManager::RemovePlayer(uint32_t playerId)
     {
-        auto it = m_playerPredictions.find(playerId);
-        if (it != m_playerPredictions.end())
+        auto it = m_playerIndex.find(playerId);
+        if (it == m_playerIndex.end())
         {
-            m_playerPredictions.erase(it);
-            LOG_INFO("Removed player " + std::to_string(playerId) + " from prediction manager");
+            return;
         }
+
+        // Swap with the last player to keep storage dense
+        size_t index = it->second;
+        size_t last = m_predictions.size() - 1;
+        if (index != last)
+        {
+            m_predictions[index] = std::move(m_predictions[last]);
+            m_playerIds[index] = m_playerIds[last];
+            m_playerIndex[m_playerIds[index]] = index;
+        }
+        m_predictions.pop_back();
+        m_playerIds.pop_back();
+        m_playerIndex.erase(playerId);
+
+        LOG_INFO("Removed player " + std::to_string(playerId) + " from prediction manager");
     }
 
     bool MovementPredictionManager::HasPlayer(uint32_t playerId) const
     {
-        return m_playerPredictions.find(playerId) != m_playerPredictions.end();
+        return m_playerIndex.find(playerId) != m_playerIndex.end();
     }
 
     void MovementPredictionManager::AddPlayerInput(uint32_t playerId, const MovementInput& input)
     {
-        auto it = m_playerPredictions.find(playerId);
-        if (it != m_playerPredictions.end())
+        if (MovementPrediction* prediction = FindPlayer(playerId))
         {
-            it->second->AddInput(input);
+            prediction->AddInput(input);
         }
     }
 
     void MovementPredictionManager::ProcessAllInputs(float deltaTime)
     {
-        for (auto& pair : m_playerPredictions)
+        if (!m_threadPool || m_predictions.size() < m_parallelThreshold)
         {
-            pair.second->ProcessInputs(deltaTime);
+            for (auto& prediction : m_predictions)
+            {
+                prediction.ProcessInputs(deltaTime);
+            }
+            return;
         }
+
+        // Each prediction only touches its own state, so chunks need no locking
+        m_threadPool->ParallelFor(m_predictions.size(), m_playersPerTask,
+            [this, deltaTime](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    m_predictions[i].ProcessInputs(deltaTime);
+                }
+            });
     }
 
     PredictedState MovementPredictionManager::GetPlayerPrediction(uint32_t playerId, float timeAhead) const
     {
-        auto it = m_playerPredictions.find(playerId);
-        if (it != m_playerPredictions.end())
+        if (const MovementPrediction* prediction = FindPlayer(playerId))
         {
             PredictedState state;
-            state.position = it->second->GetPredictedPosition(timeAhead);
+            state.position = prediction->GetPredictedPosition(timeAhead);
             state.isValid = true;
             return state;
         }
@@ -675,19 +815,22 @@ namespace Optimization
     std::vector<PredictedState> MovementPredictionManager::GetAllPlayerPredictions(float timeAhead) const
     {
         std::vector<PredictedState> predictions;
-        for (const auto& pair : m_playerPredictions)
+        predictions.reserve(m_predictions.size());
+        for (const auto& prediction : m_predictions)
         {
-            predictions.push_back(GetPlayerPrediction(pair.first, timeAhead));
+            PredictedState state;
+            state.position = prediction.GetPredictedPosition(timeAhead);
+            state.isValid = true;
+            predictions.push_back(state);
         }
         return predictions;
     }
 
     void MovementPredictionManager::ReconcilePlayer(uint32_t playerId, uint32_t inputId, const Vector4F& serverPosition)
     {
-        auto it = m_playerPredictions.find(playerId);
-        if (it != m_playerPredictions.end())
+        if (MovementPrediction* prediction = FindPlayer(playerId))
         {
-            it->second->ReconcileWithServer(inputId, serverPosition, 0.0f);
+            prediction->ReconcileWithServer(inputId, serverPosition, 0.0f);
         }
     }
 
@@ -701,52 +844,88 @@ namespace Optimization
 
     void MovementPredictionManager::SetPlayerConfig(uint32_t playerId, const PredictionConfig& config)
     {
-        auto it = m_playerPredictions.find(playerId);
-        if (it != m_playerPredictions.end())
+        if (MovementPrediction* prediction = FindPlayer(playerId))
         {
-            it->second->SetConfig(config);
+            prediction->SetConfig(config);
         }
     }
 
     void MovementPredictionManager::SetGlobalConfig(const PredictionConfig& config)
     {
         m_globalConfig = config;
-        for (auto& pair : m_playerPredictions)
+        for (auto& prediction : m_predictions)
         {
-            pair.second->SetConfig(config);
+            prediction.SetConfig(config);
         }
     }
 
     std::map<uint32_t, MovementPrediction::PredictionStats> MovementPredictionManager::GetAllStats() const
     {
         std::map<uint32_t, MovementPrediction::PredictionStats> stats;
-        for (const auto& pair : m_playerPredictions)
+        for (size_t i = 0; i < m_predictions.size(); ++i)
         {
-            stats[pair.first] = pair.second->GetStats();
+            stats[m_playerIds[i]] = m_predictions[i].GetStats();
         }
         return stats;
     }
 
     MovementPrediction::PredictionStats MovementPredictionManager::GetPlayerStats(uint32_t playerId) const
     {
-        auto it = m_playerPredictions.find(playerId);
-        if (it != m_playerPredictions.end())
+        if (const MovementPrediction* prediction = FindPlayer(playerId))
         {
-            return it->second->GetStats();
+            return prediction->GetStats();
         }
         return MovementPrediction::PredictionStats();
     }
 
     void MovementPredictionManager::Cleanup()
     {
-        m_playerPredictions.clear();
+        m_predictions.clear();
+        m_playerIds.clear();
+        m_playerIndex.clear();
     }
 
     void MovementPredictionManager::ResetAllStats()
     {
-        for (auto& pair : m_playerPredictions)
+        for (auto& prediction : m_predictions)
+        {
+            prediction.ResetStats();
+        }
+    }
+
+    void MovementPredictionManager::SetWorkerThreads(size_t threadCount)
+    {
+        if (threadCount == 0)
         {
-            pair.second->ResetStats();
+            m_threadPool.reset();
         }
+        else
+        {
+            m_threadPool = std::make_unique<ThreadPool>(threadCount);
+        }
+
+        LOG_INFO("Movement prediction manager using " + std::to_string(threadCount) + " worker threads");
+    }
+
+    void MovementPredictionManager::SetParallelThreshold(size_t playerCount)
+    {
+        m_parallelThreshold = playerCount;
+    }
+
+    size_t MovementPredictionManager::GetPlayerCount() const
+    {
+        return m_predictions.size();
+    }
+
+    MovementPrediction* MovementPredictionManager::FindPlayer(uint32_t playerId)
+    {
+        auto it = m_playerIndex.find(playerId);
+        return it != m_playerIndex.end() ? &m_predictions[it->second] : nullptr;
+    }
+
+    const MovementPrediction* MovementPredictionManager::FindPlayer(uint32_t playerId) const
+    {
+        auto it = m_playerIndex.find(playerId);
+        return it != m_playerIndex.end() ? &m_predictions[it->second] : nullptr;
     }
 }
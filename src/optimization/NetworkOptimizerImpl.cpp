@@ -41,7 +41,8 @@ namespace Optimization
             // Log compression stats
             float compressionRatio = static_cast<float>(compressedData.size()) / static_cast<float>(messageData.size());
             LOG_DEBUG_CAT(LogCategory::NETWORK, "Message compressed: " + std::to_string(messageData.size()) + " -> " + 
-                         std::to_string(compressedData.size()) + " bytes (ratio: " + std::to_string(compressionRatio) + ")");
+                         std::to_string(compressedData.size()) + " bytes (ratio: " + std::to_string(compressionRatio) + ") in " +
+                         std::to_string(duration) + "μs");
 
             // Create compressed message
             Networking::message<MessageType> compressedMessage;
@@ -69,7 +70,7 @@ namespace Optimization
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
 
             LOG_DEBUG_CAT(LogCategory::NETWORK, "Message decompressed: " + std::to_string(compressedMessage.body.size()) + " -> " + 
-                         std::to_string(decompressedData.size()) + " bytes");
+                         std::to_string(decompressedData.size()) + " bytes in " + std::to_string(duration) + "μs");
 
             // Create decompressed message
             Networking::message<MessageType> decompressedMessage;
@@ -16,6 +16,9 @@ namespace Optimization
         m_lastStatsUpdate = m_lastUpdateTime;
         
         LOG_INFO("Optimized network protocol created");
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("protocol",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     OptimizedNetworkProtocol::~OptimizedNetworkProtocol()
@@ -98,8 +101,7 @@ namespace Optimization
         // Process message through traffic manager
         m_trafficManager->ProcessMessage(message);
 
-        LOG_DEBUG("Message queued for sending (ID: " + std::to_string(message.messageId) + 
-                 ", type: " + std::to_string(static_cast<int>(message.type)) + ")");
+        LOG_DEBUGF("Message queued for sending (ID: {}, type: {})", message.messageId, static_cast<int>(message.type));
     }
 
     void OptimizedNetworkProtocol::SendMessages(const std::vector<PrioritizedMessage>& messages)
@@ -114,7 +116,7 @@ namespace Optimization
             SendMessage(message);
         }
 
-        LOG_DEBUG("Queued " + std::to_string(messages.size()) + " messages for sending");
+        LOG_DEBUGF("Queued {} messages for sending", messages.size());
     }
 
     std::vector<PrioritizedMessage> OptimizedNetworkProtocol::ProcessReceivedPacket(const NetworkPacket& packet)
@@ -389,6 +391,19 @@ namespace Optimization
         LOG_INFO("=============================================");
     }
 
+    void OptimizedNetworkProtocol::CollectMetrics(MetricsWriter& out) const
+    {
+        out.Counter("tw3_protocol_packets_total", "Packets by direction", static_cast<double>(m_stats.packetsSent), { { "direction", "sent" } });
+        out.Counter("tw3_protocol_packets_total", "Packets by direction", static_cast<double>(m_stats.packetsReceived), { { "direction", "received" } });
+        out.Counter("tw3_protocol_bytes_total", "Bytes by direction", static_cast<double>(m_stats.bytesSent), { { "direction", "sent" } });
+        out.Counter("tw3_protocol_bytes_total", "Bytes by direction", static_cast<double>(m_stats.bytesReceived), { { "direction", "received" } });
+        out.Counter("tw3_protocol_packets_lost_total", "Packets detected as lost", static_cast<double>(m_stats.packetsLost));
+        out.Counter("tw3_protocol_packets_retransmitted_total", "Packets retransmitted", static_cast<double>(m_stats.packetsRetransmitted));
+        out.Gauge("tw3_protocol_latency_seconds", "Average round trip latency", m_stats.averageLatency / 1000.0);
+        out.Gauge("tw3_protocol_packet_loss_ratio", "Lost over sent packets", m_stats.packetLossRate);
+        out.Gauge("tw3_protocol_throughput_bits_per_second", "Measured throughput", m_stats.throughput);
+    }
+
     void OptimizedNetworkProtocol::SetMessageReceivedCallback(MessageReceivedCallback callback)
     {
         m_messageReceivedCallback = callback;
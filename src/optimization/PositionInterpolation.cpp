@@ -13,6 +13,9 @@ namespace Optimization
         m_lastCleanupTime = m_lastUpdateTime;
         
         LOG_INFO("Position interpolation system created");
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("interpolation",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     PositionInterpolation::~PositionInterpolation()
@@ -51,6 +54,7 @@ namespace Optimization
         // Clear all data
         m_playerSnapshots.clear();
         m_currentPositions.clear();
+        m_jitterBuffers.clear();
         
         m_initialized = false;
         LOG_INFO("Position interpolation system shutdown complete");
@@ -73,6 +77,21 @@ namespace Optimization
                      return a.timestamp < b.timestamp;
                  });
 
+        // Feed arrival timing into the player's playout buffer
+        if (m_config.enableAdaptivePlayout)
+        {
+            auto bufferIt = m_jitterBuffers.find(snapshot.playerId);
+            if (bufferIt == m_jitterBuffers.end())
+            {
+                JitterBufferConfig bufferConfig;
+                bufferConfig.minDelay = m_config.minInterpolationDelay;
+                bufferConfig.maxDelay = m_config.maxInterpolationDelay;
+                bufferConfig.targetExtrapolationRate = m_config.targetExtrapolationRate;
+                bufferIt = m_jitterBuffers.emplace(snapshot.playerId, JitterBuffer(bufferConfig)).first;
+            }
+            bufferIt->second.OnArrival(ClockSync::NowMicros(), snapshot.serverTime);
+        }
+
         // Clean up old snapshots
         CleanupOldSnapshots();
 
@@ -112,10 +131,18 @@ namespace Optimization
             return InterpolatedPosition();
         }
 
-        // Calculate target time
-        auto now = std::chrono::high_resolution_clock::now();
-        float currentTime = std::chrono::duration<float>(now.time_since_epoch()).count();
-        float targetTime = currentTime - timeOffset;
+        // Without an explicit offset, play out behind the newest data by the adaptive delay
+        auto bufferIt = m_jitterBuffers.find(playerId);
+        bool adaptivePlayout = m_config.enableAdaptivePlayout && timeOffset <= 0.0f && bufferIt != m_jitterBuffers.end();
+        if (adaptivePlayout)
+        {
+            timeOffset = bufferIt->second.GetDelay();
+        }
+
+        // Play out the snapshots as they stood timeOffset ago
+        TimePoint targetTime = std::chrono::high_resolution_clock::now() -
+            std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<float>(timeOffset));
+        bool starved = targetTime > snapshots.back().timestamp;
 
         InterpolatedPosition result;
         
@@ -151,12 +178,29 @@ namespace Optimization
             }
         }
 
+        // Running past the newest snapshot means the playout buffer was too shallow
+        if (starved)
+        {
+            result.isExtrapolated = true;
+            m_stats.extrapolations++;
+        }
+
+        if (adaptivePlayout)
+        {
+            bufferIt->second.RecordPlayout(starved);
+            m_stats.averagePlayoutDelay = (m_stats.averagePlayoutDelay + timeOffset * 1000.0f) / 2.0f;
+            m_playoutDelays.Record(static_cast<uint64_t>(timeOffset * 1000000.0f));
+            m_stats.averageArrivalJitter = (m_stats.averageArrivalJitter + bufferIt->second.GetJitter() * 1000.0f) / 2.0f;
+        }
+
         // Update current position
         m_currentPositions[playerId] = result;
 
         // Update statistics
         auto endTime = std::chrono::high_resolution_clock::now();
         float interpolationTime = std::chrono::duration<float>(endTime - startTime).count() * 1000.0f; // Convert to ms
+        m_interpolationTimes.Record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count()));
         
         m_stats.totalInterpolations++;
         m_stats.averageInterpolationTime = (m_stats.averageInterpolationTime + interpolationTime) / 2.0f;
@@ -298,10 +342,40 @@ namespace Optimization
         }
     }
 
+    void PositionInterpolation::UpdateNetworkConditions(const ClockSync& clockSync, float packetLoss)
+    {
+        // Latency from the synchronized round trip, jitter from measured snapshot arrivals
+        float latency = static_cast<float>(clockSync.GetRoundTrip()) / 1000.0f;
+        float jitter = clockSync.GetRoundTripJitter() / 1000000.0f;
+        
+        if (!m_jitterBuffers.empty())
+        {
+            float totalJitter = 0.0f;
+            for (const auto& pair : m_jitterBuffers)
+            {
+                totalJitter += pair.second.GetJitter();
+            }
+            jitter = totalJitter / static_cast<float>(m_jitterBuffers.size());
+        }
+        
+        UpdateNetworkConditions(latency, packetLoss, jitter);
+    }
+
     void PositionInterpolation::AdaptToNetworkConditions()
     {
+        if (m_config.enableAdaptivePlayout && !m_jitterBuffers.empty())
+        {
+            // Keep enough history for the deepest playout buffer
+            float maxDelay = 0.0f;
+            for (const auto& pair : m_jitterBuffers)
+            {
+                maxDelay = std::max(maxDelay, pair.second.GetDelay());
+            }
+            m_config.duration = maxDelay;
+            m_config.lagCompensationTime = m_currentLatency / 2000.0f; // One-way latency in seconds
+        }
         // Adapt interpolation based on network conditions
-        if (m_currentLatency > 100.0f) // High latency
+        else if (m_currentLatency > 100.0f) // High latency
         {
             // Increase interpolation duration for smoother movement
             m_config.duration = std::min(0.2f, m_config.duration * 1.1f);
@@ -327,14 +401,50 @@ namespace Optimization
                  "s, Smoothing: " + std::to_string(m_config.smoothing));
     }
 
+    float PositionInterpolation::GetInterpolationDelay(uint32_t playerId) const
+    {
+        auto it = m_jitterBuffers.find(playerId);
+        if (it != m_jitterBuffers.end())
+        {
+            return it->second.GetDelay();
+        }
+        return m_config.duration;
+    }
+
+    float PositionInterpolation::GetMeasuredJitter(uint32_t playerId) const
+    {
+        auto it = m_jitterBuffers.find(playerId);
+        if (it != m_jitterBuffers.end())
+        {
+            return it->second.GetJitter();
+        }
+        return 0.0f;
+    }
+
+    float PositionInterpolation::GetExtrapolationRate(uint32_t playerId) const
+    {
+        auto it = m_jitterBuffers.find(playerId);
+        if (it != m_jitterBuffers.end())
+        {
+            return it->second.GetExtrapolationRate();
+        }
+        return 0.0f;
+    }
+
     InterpolationStats PositionInterpolation::GetStats() const
     {
-        return m_stats;
+        InterpolationStats stats = m_stats;
+        stats.p99InterpolationTime = static_cast<float>(m_interpolationTimes.GetPercentile(99.0)) / 1000.0f;
+        stats.p50PlayoutDelay = static_cast<float>(m_playoutDelays.GetPercentile(50.0)) / 1000.0f;
+        stats.p99PlayoutDelay = static_cast<float>(m_playoutDelays.GetPercentile(99.0)) / 1000.0f;
+        return stats;
     }
 
     void PositionInterpolation::ResetStats()
     {
         m_stats.Reset();
+        m_interpolationTimes.Reset();
+        m_playoutDelays.Reset();
     }
 
     void PositionInterpolation::PrintStats() const
@@ -350,9 +460,30 @@ namespace Optimization
         LOG_INFO("Max jitter: " + std::to_string(m_stats.maxJitter));
         LOG_INFO("Average lag: " + std::to_string(m_stats.averageLag) + "ms");
         LOG_INFO("Max lag: " + std::to_string(m_stats.maxLag) + "ms");
+        InterpolationStats stats = GetStats();
+        LOG_INFO("p99 interpolation time: " + std::to_string(stats.p99InterpolationTime) + "ms");
+        LOG_INFO("Average playout delay: " + std::to_string(m_stats.averagePlayoutDelay) + "ms");
+        LOG_INFO("Playout delay p50/p99: " + std::to_string(stats.p50PlayoutDelay) + "/" +
+                 std::to_string(stats.p99PlayoutDelay) + "ms");
+        LOG_INFO("Average arrival jitter: " + std::to_string(m_stats.averageArrivalJitter) + "ms");
         LOG_INFO("========================================");
     }
 
+    void PositionInterpolation::CollectMetrics(MetricsWriter& out) const
+    {
+        out.Counter("tw3_interpolation_updates_total", "Position updates by method",
+                    static_cast<double>(m_stats.totalInterpolations), { { "method", "interpolate" } });
+        out.Counter("tw3_interpolation_updates_total", "Position updates by method",
+                    static_cast<double>(m_stats.extrapolations), { { "method", "extrapolate" } });
+        out.Counter("tw3_interpolation_jitter_corrections_total", "Jitter corrections applied", static_cast<double>(m_stats.jitterCorrections));
+        out.Counter("tw3_interpolation_lag_compensations_total", "Lag compensations applied", static_cast<double>(m_stats.lagCompensations));
+        out.Gauge("tw3_interpolation_lag_seconds", "Average measured lag", m_stats.averageLag / 1000.0);
+        out.Gauge("tw3_interpolation_max_lag_seconds", "Largest measured lag", m_stats.maxLag / 1000.0);
+        out.Gauge("tw3_interpolation_arrival_jitter_seconds", "Smoothed inter-arrival jitter", m_stats.averageArrivalJitter / 1000.0);
+        out.Summary("tw3_interpolation_time_seconds", "Time spent per interpolation", m_interpolationTimes, 1e-6);
+        out.Summary("tw3_interpolation_playout_delay_seconds", "Adaptive playout delay", m_playoutDelays, 1e-6);
+    }
+
     void PositionInterpolation::SetPositionUpdatedCallback(PositionUpdatedCallback callback)
     {
         m_positionUpdatedCallback = callback;
@@ -364,21 +495,27 @@ namespace Optimization
     }
 
     // Internal interpolation methods
-    InterpolatedPosition PositionInterpolation::InterpolateLinear(const std::vector<PositionSnapshot>& snapshots, float time)
+    InterpolatedPosition PositionInterpolation::InterpolateLinear(const std::vector<PositionSnapshot>& snapshots, TimePoint time)
     {
         if (snapshots.size() < 2)
         {
             return InterpolatedPosition();
         }
 
-        // Find the two snapshots to interpolate between
-        PositionSnapshot before = FindSnapshotAtTime(snapshots, time);
-        PositionSnapshot after = FindNearestSnapshot(snapshots, time);
-        
-        if (!before.isValid || !after.isValid)
+        // The snapshots either side of the target; before the first or past
+        // the last, the nearest pair, clamped to its end
+        auto next = std::upper_bound(snapshots.begin(), snapshots.end(), time,
+            [](TimePoint target, const PositionSnapshot& snapshot) { return target < snapshot.timestamp; });
+        if (next == snapshots.begin())
         {
-            return InterpolatedPosition();
+            ++next;
         }
+        else if (next == snapshots.end())
+        {
+            --next;
+        }
+        const PositionSnapshot& before = *(next - 1);
+        const PositionSnapshot& after = *next;
 
         float timeDiff = std::chrono::duration<float>(after.timestamp - before.timestamp).count();
         if (timeDiff <= 0.0f)
@@ -386,7 +523,7 @@ namespace Optimization
             return InterpolatedPosition();
         }
 
-        float t = (time - std::chrono::duration<float>(before.timestamp.time_since_epoch()).count()) / timeDiff;
+        float t = std::chrono::duration<float>(time - before.timestamp).count() / timeDiff;
         t = InterpolationUtils::Clamp(t, 0.0f, 1.0f);
 
         InterpolatedPosition result;
@@ -398,7 +535,7 @@ namespace Optimization
         return result;
     }
 
-    InterpolatedPosition PositionInterpolation::InterpolateCubic(const std::vector<PositionSnapshot>& snapshots, float time)
+    InterpolatedPosition PositionInterpolation::InterpolateCubic(const std::vector<PositionSnapshot>& snapshots, TimePoint time)
     {
         if (snapshots.size() < 4)
         {
@@ -418,7 +555,7 @@ namespace Optimization
         return result;
     }
 
-    InterpolatedPosition PositionInterpolation::InterpolateHermite(const std::vector<PositionSnapshot>& snapshots, float time)
+    InterpolatedPosition PositionInterpolation::InterpolateHermite(const std::vector<PositionSnapshot>& snapshots, TimePoint time)
     {
         if (snapshots.size() < 2)
         {
@@ -438,7 +575,7 @@ namespace Optimization
         return result;
     }
 
-    InterpolatedPosition PositionInterpolation::InterpolateCatmullRom(const std::vector<PositionSnapshot>& snapshots, float time)
+    InterpolatedPosition PositionInterpolation::InterpolateCatmullRom(const std::vector<PositionSnapshot>& snapshots, TimePoint time)
     {
         if (snapshots.size() < 4)
         {
@@ -460,7 +597,7 @@ namespace Optimization
         return result;
     }
 
-    InterpolatedPosition PositionInterpolation::InterpolateBezier(const std::vector<PositionSnapshot>& snapshots, float time)
+    InterpolatedPosition PositionInterpolation::InterpolateBezier(const std::vector<PositionSnapshot>& snapshots, TimePoint time)
     {
         if (snapshots.size() < 4)
         {
@@ -492,20 +629,20 @@ namespace Optimization
         return std::vector<PositionSnapshot>();
     }
 
-    PositionSnapshot PositionInterpolation::FindSnapshotAtTime(const std::vector<PositionSnapshot>& snapshots, float time) const
+    PositionSnapshot PositionInterpolation::FindSnapshotAtTime(const std::vector<PositionSnapshot>& snapshots, TimePoint time) const
     {
-        for (const auto& snapshot : snapshots)
+        // Newest snapshot at or before the time; snapshots are kept in time order
+        for (auto it = snapshots.rbegin(); it != snapshots.rend(); ++it)
         {
-            float snapshotTime = std::chrono::duration<float>(snapshot.timestamp.time_since_epoch()).count();
-            if (snapshotTime <= time)
+            if (it->timestamp <= time)
             {
-                return snapshot;
+                return *it;
             }
         }
         return PositionSnapshot();
     }
 
-    PositionSnapshot PositionInterpolation::FindNearestSnapshot(const std::vector<PositionSnapshot>& snapshots, float time) const
+    PositionSnapshot PositionInterpolation::FindNearestSnapshot(const std::vector<PositionSnapshot>& snapshots, TimePoint time) const
     {
         if (snapshots.empty())
         {
@@ -513,12 +650,11 @@ namespace Optimization
         }
 
         PositionSnapshot nearest = snapshots[0];
-        float minDiff = std::abs(std::chrono::duration<float>(snapshots[0].timestamp.time_since_epoch()).count() - time);
+        float minDiff = std::abs(std::chrono::duration<float>(snapshots[0].timestamp - time).count());
 
         for (const auto& snapshot : snapshots)
         {
-            float snapshotTime = std::chrono::duration<float>(snapshot.timestamp.time_since_epoch()).count();
-            float diff = std::abs(snapshotTime - time);
+            float diff = std::abs(std::chrono::duration<float>(snapshot.timestamp - time).count());
             if (diff < minDiff)
             {
                 minDiff = diff;
@@ -577,7 +713,7 @@ namespace Optimization
         return compensated;
     }
 
-    PositionSnapshot PositionInterpolation::ExtrapolateFromSnapshots(const std::vector<PositionSnapshot>& snapshots, float time) const
+    PositionSnapshot PositionInterpolation::ExtrapolateFromSnapshots(const std::vector<PositionSnapshot>& snapshots, TimePoint time) const
     {
         if (snapshots.size() < 2)
         {
@@ -588,7 +724,7 @@ namespace Optimization
         const PositionSnapshot& secondLast = snapshots[snapshots.size() - 2];
         
         float timeDiff = std::chrono::duration<float>(last.timestamp - secondLast.timestamp).count();
-        float extrapolationTime = time - std::chrono::duration<float>(last.timestamp.time_since_epoch()).count();
+        float extrapolationTime = std::chrono::duration<float>(time - last.timestamp).count();
         float extrapolationFactor = extrapolationTime / timeDiff;
         
         PositionSnapshot extrapolated = last;
@@ -600,9 +736,9 @@ namespace Optimization
 
     void PositionInterpolation::CleanupOldSnapshots()
     {
-        auto now = std::chrono::high_resolution_clock::now();
-        float currentTime = std::chrono::duration<float>(now.time_since_epoch()).count();
-        float cutoffTime = currentTime - m_config.duration * 2.0f; // Keep snapshots for 2x duration
+        float history = m_config.enableAdaptivePlayout ? std::max(m_config.duration, m_config.maxInterpolationDelay) : m_config.duration;
+        TimePoint cutoffTime = std::chrono::high_resolution_clock::now() - // Keep snapshots for 2x duration
+            std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<float>(history * 2.0f));
         
         for (auto& pair : m_playerSnapshots)
         {
@@ -610,8 +746,7 @@ namespace Optimization
             snapshots.erase(
                 std::remove_if(snapshots.begin(), snapshots.end(),
                     [cutoffTime](const PositionSnapshot& snapshot) {
-                        float snapshotTime = std::chrono::duration<float>(snapshot.timestamp.time_since_epoch()).count();
-                        return snapshotTime < cutoffTime;
+                        return snapshot.timestamp < cutoffTime;
                     }),
                 snapshots.end()
             );
@@ -622,6 +757,7 @@ namespace Optimization
     {
         m_playerSnapshots.erase(playerId);
         m_currentPositions.erase(playerId);
+        m_jitterBuffers.erase(playerId);
     }
 
     // Interpolation utilities implementation
@@ -16,6 +16,9 @@ namespace Optimization
         m_lastAdaptationTime = m_lastBatchTime;
         
         LOG_INFO("Smart batching system created");
+
+        m_metricsRegistration = MetricsRegistry::GetInstance().AddCollector("batching",
+            [this](MetricsWriter& out) { CollectMetrics(out); });
     }
 
     SmartBatching::~SmartBatching()
@@ -78,8 +81,7 @@ namespace Optimization
             ProcessBatches(0.0f);
         }
 
-        LOG_DEBUG("Added message to batching queue (ID: " + std::to_string(message.messageId) + 
-                 ", pending: " + std::to_string(m_pendingMessages.size()) + ")");
+        LOG_DEBUGF("Added message to batching queue (ID: {}, pending: {})", message.messageId, m_pendingMessages.size());
     }
 
     std::vector<BatchedMessage> SmartBatching::GetReadyBatches()
@@ -231,12 +233,18 @@ namespace Optimization
 
     BatchStats SmartBatching::GetStats() const
     {
-        return m_stats;
+        BatchStats stats = m_stats;
+        stats.averageLatency = static_cast<float>(m_batchLatency.GetMean()) / 1000.0f;
+        stats.p50Latency = static_cast<float>(m_batchLatency.GetPercentile(50.0)) / 1000.0f;
+        stats.p99Latency = static_cast<float>(m_batchLatency.GetPercentile(99.0)) / 1000.0f;
+        stats.p999Latency = static_cast<float>(m_batchLatency.GetPercentile(99.9)) / 1000.0f;
+        return stats;
     }
 
     void SmartBatching::ResetStats()
     {
         m_stats.Reset();
+        m_batchLatency.Reset();
     }
 
     void SmartBatching::PrintStats() const
@@ -251,10 +259,25 @@ namespace Optimization
         LOG_INFO("Average batch size: " + std::to_string(m_stats.averageBatchSize) + " bytes");
         LOG_INFO("Average batch time: " + std::to_string(m_stats.averageBatchTime) + "ms");
         LOG_INFO("Compression ratio: " + std::to_string(m_stats.compressionRatio * 100.0f) + "%");
-        LOG_INFO("Average latency: " + std::to_string(m_stats.averageLatency) + "ms");
+        BatchStats stats = GetStats();
+        LOG_INFO("Average latency: " + std::to_string(stats.averageLatency) + "ms");
+        LOG_INFO("Latency p50/p99/p999: " + std::to_string(stats.p50Latency) + "/" +
+                 std::to_string(stats.p99Latency) + "/" + std::to_string(stats.p999Latency) + "ms");
         LOG_INFO("================================");
     }
 
+    void SmartBatching::CollectMetrics(MetricsWriter& out) const
+    {
+        out.Counter("tw3_batching_batches_total", "Batches created", static_cast<double>(m_stats.totalBatches));
+        out.Counter("tw3_batching_compressed_batches_total", "Batches that were compressed", static_cast<double>(m_stats.compressedBatches));
+        out.Counter("tw3_batching_dropped_batches_total", "Batches dropped", static_cast<double>(m_stats.droppedBatches));
+        out.Counter("tw3_batching_messages_total", "Messages added to batches", static_cast<double>(m_stats.totalMessages));
+        out.Counter("tw3_batching_bytes_total", "Batch payload bytes before compression", static_cast<double>(m_stats.totalBytes));
+        out.Counter("tw3_batching_compressed_bytes_total", "Batch payload bytes after compression", static_cast<double>(m_stats.compressedBytes));
+        out.Gauge("tw3_batching_average_batch_size", "Average messages per batch", m_stats.averageBatchSize);
+        out.Summary("tw3_batching_wait_seconds", "Per-message wait before batching", m_batchLatency, 1e-6);
+    }
+
     void SmartBatching::SetBatchReadyCallback(BatchReadyCallback callback)
     {
         m_batchReadyCallback = callback;
@@ -368,6 +391,13 @@ namespace Optimization
         batch.messages = messages;
         batch.timestamp = std::chrono::high_resolution_clock::now();
         
+        // Time each message waited for its batch
+        for (const auto& message : messages)
+        {
+            auto waited = std::chrono::duration_cast<std::chrono::microseconds>(batch.timestamp - message.timestamp).count();
+            m_batchLatency.Record(static_cast<uint64_t>(std::max<int64_t>(0, waited)));
+        }
+        
         // Calculate total size
         batch.totalSize = 0;
         for (const auto& message : messages)
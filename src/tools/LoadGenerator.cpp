@@ -0,0 +1,449 @@
+#include "tools/LoadGenerator.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Tools
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        using Networking::MessageTypes;
+
+        constexpr size_t PathWaypoints = 8;
+        constexpr float PathRadius = 20.0f;
+        constexpr float SpawnArea = 200.0f;
+        constexpr std::chrono::milliseconds DriverTick{ 5 };
+
+        const char* const ChatLines[] =
+        {
+            "Anyone up for a contract in Velen?",
+            "Heading to the Novigrad docks",
+            "Need help with the griffin",
+            "Gwent at the Kingfisher later?"
+        };
+
+        double MicrosToMs(uint64_t micros)
+        {
+            return static_cast<double>(micros) / 1000.0;
+        }
+
+        uint64_t WireSize(const BotClient::Message& msg)
+        {
+            return sizeof(Networking::message_header<MessageTypes>) + msg.body.size();
+        }
+    }
+
+    BotClient::BotClient(uint32_t index, asio::io_context& context, const LoadGeneratorConfig& config)
+        : m_index(index), m_context(context), m_config(config), m_random(config.seed * 2654435761u + index)
+    {
+        std::uniform_real_distribution<float> spawn(-SpawnArea / 2.0f, SpawnArea / 2.0f);
+        Vector4F centre(spawn(m_random), spawn(m_random), 0.0f);
+
+        for (size_t i = 0; i < PathWaypoints; ++i)
+        {
+            float angle = 2.0f * 3.14159265f * static_cast<float>(i) / PathWaypoints;
+            m_path.emplace_back(centre.x + PathRadius * std::cos(angle), centre.y + PathRadius * std::sin(angle), centre.z);
+        }
+        m_position = m_path[0];
+        m_nextWaypoint = 1;
+    }
+
+    void BotClient::Connect(const asio::ip::tcp::resolver::results_type& endpoints, Clock::time_point now)
+    {
+        m_connection = std::make_unique<Networking::connection<MessageTypes>>(
+            Networking::connection<MessageTypes>::owner::client,
+            m_context,
+            asio::ip::tcp::socket(m_context), m_qMessagesIn);
+
+        m_connectStarted = now;
+        m_state = State::Connecting;
+        m_connection->ConnectToServer(endpoints);
+    }
+
+    void BotClient::Disconnect()
+    {
+        if (m_connection)
+            m_connection->Disconnect();
+    }
+
+    void BotClient::Tick(Clock::time_point now, BotTrafficStats& stats, HdrHistogram& rttMicros)
+    {
+        if (m_state != State::Connecting && m_state != State::Joined)
+            return;
+
+        while (!m_qMessagesIn.empty())
+        {
+            auto incoming = m_qMessagesIn.pop_front();
+            stats.messagesReceived++;
+            stats.bytesReceived += WireSize(incoming.msg);
+
+            if (incoming.msg.header.id == MessageTypes::TC_REQUEST_PLAYERDATA && m_state == State::Connecting)
+                Join(now, stats);
+            else
+                HandleMessage(incoming, rttMicros);
+        }
+
+        if (!m_connection->IsConnected())
+        {
+            // A failed async_connect closes the socket, so this also catches refused connects
+            if (m_state == State::Joined)
+            {
+                m_state = State::Disconnected;
+                stats.disconnects++;
+            }
+            else
+            {
+                m_state = State::Failed;
+                stats.connectFailures++;
+            }
+            return;
+        }
+
+        if (m_state == State::Connecting)
+        {
+            if (now - m_connectStarted > m_config.joinTimeout)
+            {
+                m_state = State::Failed;
+                stats.connectFailures++;
+                m_connection->Disconnect();
+            }
+            return;
+        }
+
+        RunBehaviours(now, stats);
+    }
+
+    void BotClient::Join(Clock::time_point now, BotTrafficStats& stats)
+    {
+        uint8_t characterId = static_cast<uint8_t>(m_index % 2);
+        Send(BuildPlayerData(characterId, m_position), stats);
+
+        m_state = State::Joined;
+        m_lastTick = now;
+        m_nextMove = Jittered(now, m_config.moveInterval);
+        m_nextPing = Jittered(now, m_config.pingInterval);
+        m_nextHit = Jittered(now, m_config.hitInterval);
+        m_nextChat = Jittered(now, m_config.chatInterval);
+    }
+
+    void BotClient::HandleMessage(Networking::owned_message<MessageTypes>& incoming, HdrHistogram& rttMicros)
+    {
+        Message& msg = incoming.msg;
+        switch (msg.header.id)
+        {
+            case MessageTypes::ServerPong:
+            {
+                Clock::time_point sent;
+                if (!ReadPongSentTime(msg, sent))
+                    break;
+
+                // Measured against the time the connection queued the reply, not the
+                // driver tick that drained it
+                auto rtt = std::chrono::duration_cast<std::chrono::microseconds>(incoming.received - sent).count();
+                rttMicros.Record(rtt > 0 ? static_cast<uint64_t>(rtt) : 0);
+                break;
+            }
+            case MessageTypes::TC_CREATE_NPC:
+            {
+                // The NPC ID is the first field the server pushed
+                if (msg.size() < sizeof(uint32_t))
+                    break;
+
+                uint32_t npcId = 0;
+                std::memcpy(&npcId, msg.body.data(), sizeof(npcId));
+                m_knownNpcs.push_back(npcId);
+                break;
+            }
+            case MessageTypes::TC_NPC_DEAD:
+            {
+                if (msg.size() < sizeof(uint32_t))
+                    break;
+
+                uint32_t npcId = 0;
+                msg >> npcId;
+                m_knownNpcs.erase(std::remove(m_knownNpcs.begin(), m_knownNpcs.end(), npcId), m_knownNpcs.end());
+                break;
+            }
+            default:
+                // Position, health and chat broadcasts only count towards throughput
+                break;
+        }
+    }
+
+    void BotClient::RunBehaviours(Clock::time_point now, BotTrafficStats& stats)
+    {
+        float elapsed = std::chrono::duration<float>(now - m_lastTick).count();
+        m_lastTick = now;
+        Advance(elapsed * m_config.walkSpeed);
+
+        if (now >= m_nextMove)
+        {
+            Send(BuildMove(1, m_position), stats);
+            m_nextMove = Jittered(now, m_config.moveInterval);
+        }
+
+        if (now >= m_nextPing)
+        {
+            Send(BuildPing(Clock::now()), stats);
+            m_nextPing = Jittered(now, m_config.pingInterval);
+        }
+
+        if (now >= m_nextHit)
+        {
+            if (!m_knownNpcs.empty())
+            {
+                std::uniform_int_distribution<size_t> pick(0, m_knownNpcs.size() - 1);
+                Send(BuildHitNpc(m_knownNpcs[pick(m_random)]), stats);
+            }
+            m_nextHit = Jittered(now, m_config.hitInterval);
+        }
+
+        if (now >= m_nextChat)
+        {
+            std::uniform_int_distribution<size_t> pick(0, std::size(ChatLines) - 1);
+            Send(BuildChat(ChatLines[pick(m_random)]), stats);
+            m_nextChat = Jittered(now, m_config.chatInterval);
+        }
+    }
+
+    void BotClient::Send(const Message& msg, BotTrafficStats& stats)
+    {
+        m_connection->Send(msg);
+        stats.messagesSent++;
+        stats.bytesSent += WireSize(msg);
+    }
+
+    void BotClient::Advance(float distance)
+    {
+        while (distance > 0.0f)
+        {
+            const Vector4F& target = m_path[m_nextWaypoint];
+            float dx = target.x - m_position.x;
+            float dy = target.y - m_position.y;
+            float remaining = std::sqrt(dx * dx + dy * dy);
+
+            if (remaining > distance)
+            {
+                m_position.x += dx / remaining * distance;
+                m_position.y += dy / remaining * distance;
+                return;
+            }
+
+            m_position = target;
+            m_nextWaypoint = (m_nextWaypoint + 1) % m_path.size();
+            distance -= remaining;
+        }
+    }
+
+    Clock::time_point BotClient::Jittered(Clock::time_point now, std::chrono::milliseconds interval)
+    {
+        // +-25% so bots that joined together drift apart
+        std::uniform_real_distribution<double> jitter(0.75, 1.25);
+        auto delay = std::chrono::duration_cast<Clock::duration>(interval * jitter(m_random));
+        return now + delay;
+    }
+
+    BotClient::Message BotClient::BuildPlayerData(uint8_t characterId, const Vector4F& position)
+    {
+        Message msg;
+        msg.header.id = MessageTypes::TS_SEND_PLAYERDATA;
+        msg << position << characterId;
+        return msg;
+    }
+
+    BotClient::Message BotClient::BuildMove(uint8_t moveType, const Vector4F& position)
+    {
+        Message msg;
+        msg.header.id = MessageTypes::TS_NOTIFY_PLAYER_POS_CHANGE;
+        msg << position << moveType;
+        return msg;
+    }
+
+    BotClient::Message BotClient::BuildChat(const std::string& text)
+    {
+        Message msg;
+        msg.header.id = MessageTypes::TS_CHAT_MESSAGE;
+        for (char ch : text)
+            msg << ch;
+        return msg;
+    }
+
+    BotClient::Message BotClient::BuildHitNpc(uint32_t npcId)
+    {
+        Message msg;
+        msg.header.id = MessageTypes::TS_HIT_NPC;
+        msg << npcId;
+        return msg;
+    }
+
+    BotClient::Message BotClient::BuildPing(Clock::time_point sent)
+    {
+        Message msg;
+        msg.header.id = MessageTypes::ClientPing;
+        int64_t sentNs = std::chrono::duration_cast<std::chrono::nanoseconds>(sent.time_since_epoch()).count();
+        msg << sentNs;
+        return msg;
+    }
+
+    bool BotClient::ReadPongSentTime(const Message& pong, Clock::time_point& sent)
+    {
+        // The server echoes t0 and pushes its receive and reply times on top
+        if (pong.size() < 3 * sizeof(int64_t))
+            return false;
+
+        int64_t sentNs = 0;
+        std::memcpy(&sentNs, pong.body.data(), sizeof(sentNs));
+        sent = Clock::time_point(std::chrono::nanoseconds(sentNs));
+        return true;
+    }
+
+    LoadGenerator::LoadGenerator(const LoadGeneratorConfig& config)
+        : m_config(config)
+    {
+        m_config.ioThreads = std::max<size_t>(1, m_config.ioThreads);
+        for (size_t i = 0; i < m_config.ioThreads; ++i)
+        {
+            m_contexts.push_back(std::make_unique<asio::io_context>());
+            m_workGuards.push_back(asio::make_work_guard(*m_contexts.back()));
+        }
+    }
+
+    LoadGenerator::~LoadGenerator()
+    {
+        Shutdown();
+    }
+
+    std::vector<LoadStepReport> LoadGenerator::Run(const std::function<void(const LoadStepReport&)>& onStep)
+    {
+        std::vector<LoadStepReport> reports;
+
+        asio::ip::tcp::resolver::results_type endpoints;
+        try
+        {
+            asio::ip::tcp::resolver resolver(*m_contexts[0]);
+            endpoints = resolver.resolve(m_config.host, std::to_string(m_config.port));
+        }
+        catch (std::exception& e)
+        {
+            LOG_ERROR("Load generator could not resolve " + m_config.host + ": " + e.what());
+            return reports;
+        }
+
+        for (auto& context : m_contexts)
+        {
+            asio::io_context* ctx = context.get();
+            m_ioThreads.emplace_back([ctx]() { ctx->run(); });
+        }
+
+        uint32_t target = std::min(m_config.initialBots, m_config.maxBots);
+        for (uint32_t step = 0; !m_stopRequested.load(std::memory_order_relaxed); ++step)
+        {
+            LoadStepReport report = RunStep(step, target, endpoints);
+            reports.push_back(report);
+            if (onStep)
+                onStep(report);
+
+            if (m_config.maxP99RttMs > 0.0 && report.rttP99Ms > m_config.maxP99RttMs)
+            {
+                LOG_INFO("Load generator stopping: p99 RTT " + std::to_string(report.rttP99Ms) +
+                    " ms exceeds " + std::to_string(m_config.maxP99RttMs) + " ms at " + std::to_string(report.joinedBots) + " bots");
+                break;
+            }
+
+            if (target >= m_config.maxBots || m_config.botStep == 0)
+                break;
+            target = std::min(target + m_config.botStep, m_config.maxBots);
+        }
+
+        Shutdown();
+        return reports;
+    }
+
+    LoadStepReport LoadGenerator::RunStep(uint32_t step, uint32_t targetBots, const asio::ip::tcp::resolver::results_type& endpoints)
+    {
+        m_stats.Reset();
+        m_rttMicros.Reset();
+
+        size_t firstNew = m_bots.size();
+        size_t newBots = targetBots > firstNew ? targetBots - firstNew : 0;
+        for (size_t i = 0; i < newBots; ++i)
+        {
+            uint32_t index = static_cast<uint32_t>(firstNew + i);
+            m_bots.push_back(std::make_unique<BotClient>(index, *m_contexts[index % m_contexts.size()], m_config));
+        }
+
+        auto stepStart = Clock::now();
+        auto stepEnd = stepStart + m_config.stepDuration;
+        size_t nextToConnect = firstNew;
+
+        while (!m_stopRequested.load(std::memory_order_relaxed))
+        {
+            auto now = Clock::now();
+            if (now >= stepEnd)
+                break;
+
+            // Spread this step's connects evenly across connectSpread
+            while (nextToConnect < m_bots.size())
+            {
+                auto offset = m_config.connectSpread * static_cast<int64_t>(nextToConnect - firstNew) / static_cast<int64_t>(newBots);
+                if (now < stepStart + offset)
+                    break;
+                m_bots[nextToConnect++]->Connect(endpoints, now);
+            }
+
+            for (auto& bot : m_bots)
+                bot->Tick(now, m_stats, m_rttMicros);
+
+            std::this_thread::sleep_until(now + DriverTick);
+        }
+
+        LoadStepReport report;
+        report.step = step;
+        report.targetBots = targetBots;
+        report.seconds = std::chrono::duration<double>(Clock::now() - stepStart).count();
+        report.messagesSent = m_stats.messagesSent;
+        report.messagesReceived = m_stats.messagesReceived;
+        report.bytesSent = m_stats.bytesSent;
+        report.bytesReceived = m_stats.bytesReceived;
+        report.disconnects = m_stats.disconnects;
+
+        for (const auto& bot : m_bots)
+        {
+            if (bot->GetState() == BotClient::State::Joined)
+                report.joinedBots++;
+            else if (bot->GetState() == BotClient::State::Failed)
+                report.connectFailures++;
+        }
+
+        report.rttSamples = m_rttMicros.GetCount();
+        report.rttP50Ms = MicrosToMs(m_rttMicros.GetPercentile(50.0));
+        report.rttP99Ms = MicrosToMs(m_rttMicros.GetPercentile(99.0));
+        report.rttP999Ms = MicrosToMs(m_rttMicros.GetPercentile(99.9));
+        report.rttMaxMs = MicrosToMs(m_rttMicros.GetMax());
+
+        LOG_INFO("Load step " + std::to_string(step) + ": " + std::to_string(report.joinedBots) + "/" +
+            std::to_string(targetBots) + " bots joined, p99 RTT " + std::to_string(report.rttP99Ms) + " ms, " +
+            std::to_string(report.disconnects) + " disconnects");
+        return report;
+    }
+
+    void LoadGenerator::Shutdown()
+    {
+        for (auto& bot : m_bots)
+            bot->Disconnect();
+
+        // Once the closes have run and pending handlers have failed out, run() returns
+        m_workGuards.clear();
+        for (auto& thread : m_ioThreads)
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+        m_ioThreads.clear();
+
+        // Connections must not outlive the contexts their handlers were queued on
+        m_bots.clear();
+    }
+}
@@ -0,0 +1,59 @@
+// Renders a BinaryLog file (logs/*.blog) as text, in the same layout as the
+// text logger. Usage: Witcher3-MP-LogDecoder <input.blog> [output.txt]
+#include "utils/BinaryLog.h"
+#include "utils/Logger.h"
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <input.blog> [output.txt]" << std::endl;
+        return 2;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input.is_open())
+    {
+        std::cerr << "Failed to open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::ofstream outputFile;
+    if (argc == 3)
+    {
+        outputFile.open(argv[2]);
+        if (!outputFile.is_open())
+        {
+            std::cerr << "Failed to open " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& output = argc == 3 ? static_cast<std::ostream&>(outputFile) : std::cout;
+
+    std::vector<BinaryLogRecord> records;
+    uint64_t droppedRecords = 0;
+    std::string error;
+    bool ok = BinaryLogReader::Read(input, records, droppedRecords, error);
+
+    for (const auto& record : records)
+    {
+        output << BinaryLogReader::FormatRecord(record) << '\n';
+    }
+    output.flush();
+
+    std::cerr << records.size() << " records decoded";
+    if (droppedRecords > 0)
+    {
+        std::cerr << ", " << droppedRecords << " dropped by the writer";
+    }
+    std::cerr << std::endl;
+
+    if (!ok)
+    {
+        std::cerr << "Decoding stopped early: " << error << std::endl;
+        return 1;
+    }
+    return 0;
+}
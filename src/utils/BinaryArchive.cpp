@@ -0,0 +1,244 @@
+#include "utils/BinaryArchive.h"
+#include <cstring>
+
+namespace
+{
+    constexpr size_t MaxVarIntBytes = 10;
+
+    size_t EncodeVarUInt(uint64_t value, uint8_t* out)
+    {
+        size_t length = 0;
+        while (value >= 0x80)
+        {
+            out[length++] = static_cast<uint8_t>(value) | 0x80;
+            value >>= 7;
+        }
+        out[length++] = static_cast<uint8_t>(value);
+        return length;
+    }
+}
+
+// BinaryWriter implementation
+BinaryWriter::BinaryWriter(size_t reserveBytes)
+{
+    m_buffer.reserve(reserveBytes);
+}
+
+void BinaryWriter::WriteVarUInt(uint64_t value)
+{
+    uint8_t bytes[MaxVarIntBytes];
+    size_t length = EncodeVarUInt(value, bytes);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + length);
+}
+
+void BinaryWriter::WriteVarInt(int64_t value)
+{
+    // Zigzag keeps small negative values short
+    uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    WriteVarUInt(zigzag);
+}
+
+void BinaryWriter::WriteBool(bool value)
+{
+    m_buffer.push_back(value ? 1 : 0);
+}
+
+void BinaryWriter::WriteFloat(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint8_t bytes[4] = {
+        static_cast<uint8_t>(bits), static_cast<uint8_t>(bits >> 8),
+        static_cast<uint8_t>(bits >> 16), static_cast<uint8_t>(bits >> 24)
+    };
+    m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(bytes));
+}
+
+void BinaryWriter::WriteString(const std::string& value)
+{
+    WriteVarUInt(value.size());
+    m_buffer.insert(m_buffer.end(), value.begin(), value.end());
+}
+
+void BinaryWriter::WriteBytes(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+}
+
+size_t BinaryWriter::BeginSection(uint32_t tag, uint32_t version)
+{
+    WriteVarUInt(tag);
+    WriteVarUInt(version);
+    return BeginRecord();
+}
+
+void BinaryWriter::EndSection(size_t marker)
+{
+    EndRecord(marker);
+}
+
+size_t BinaryWriter::BeginRecord()
+{
+    // One byte is reserved for the length; EndRecord widens it if needed
+    size_t marker = m_buffer.size();
+    m_buffer.push_back(0);
+    return marker;
+}
+
+void BinaryWriter::EndRecord(size_t marker)
+{
+    uint64_t bodySize = m_buffer.size() - marker - 1;
+    uint8_t bytes[MaxVarIntBytes];
+    size_t length = EncodeVarUInt(bodySize, bytes);
+    if (length > 1)
+    {
+        m_buffer.insert(m_buffer.begin() + marker + 1, length - 1, 0);
+    }
+    std::memcpy(m_buffer.data() + marker, bytes, length);
+}
+
+// BinaryReader implementation
+BinaryReader::BinaryReader(const uint8_t* data, size_t size)
+    : m_data(data), m_size(size)
+{
+}
+
+BinaryReader::BinaryReader(const std::vector<uint8_t>& data)
+    : m_data(data.data()), m_size(data.size())
+{
+}
+
+bool BinaryReader::Take(size_t size, const uint8_t*& out)
+{
+    if (m_failed || size > m_size - m_position)
+    {
+        m_failed = true;
+        return false;
+    }
+    out = m_data + m_position;
+    m_position += size;
+    return true;
+}
+
+uint64_t BinaryReader::ReadVarUInt()
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < MaxVarIntBytes; ++i)
+    {
+        const uint8_t* byte;
+        if (!Take(1, byte))
+        {
+            return 0;
+        }
+
+        // The tenth byte may only contribute the top bit
+        if (i == MaxVarIntBytes - 1 && *byte > 1)
+        {
+            break;
+        }
+
+        value |= static_cast<uint64_t>(*byte & 0x7F) << (7 * i);
+        if ((*byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+
+    m_failed = true;
+    return 0;
+}
+
+int64_t BinaryReader::ReadVarInt()
+{
+    uint64_t zigzag = ReadVarUInt();
+    return static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+}
+
+uint32_t BinaryReader::ReadVarUInt32()
+{
+    uint64_t value = ReadVarUInt();
+    if (value > UINT32_MAX)
+    {
+        m_failed = true;
+        return 0;
+    }
+    return static_cast<uint32_t>(value);
+}
+
+bool BinaryReader::ReadBool()
+{
+    const uint8_t* byte;
+    return Take(1, byte) && *byte != 0;
+}
+
+float BinaryReader::ReadFloat()
+{
+    const uint8_t* bytes;
+    if (!Take(4, bytes))
+    {
+        return 0.0f;
+    }
+
+    uint32_t bits = static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                    (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string BinaryReader::ReadString()
+{
+    uint64_t length = ReadVarUInt();
+    const uint8_t* bytes;
+    if (m_failed || length > GetRemaining() || !Take(static_cast<size_t>(length), bytes))
+    {
+        m_failed = true;
+        return std::string();
+    }
+    return std::string(reinterpret_cast<const char*>(bytes), static_cast<size_t>(length));
+}
+
+const uint8_t* BinaryReader::ReadBytes(size_t size)
+{
+    const uint8_t* bytes;
+    return Take(size, bytes) ? bytes : nullptr;
+}
+
+uint32_t BinaryReader::ReadCount()
+{
+    uint32_t count = ReadVarUInt32();
+    if (count > GetRemaining())
+    {
+        m_failed = true;
+        return 0;
+    }
+    return count;
+}
+
+BinaryReader BinaryReader::ReadRecord()
+{
+    uint64_t length = ReadVarUInt();
+    const uint8_t* body;
+    if (m_failed || length > GetRemaining() || !Take(static_cast<size_t>(length), body))
+    {
+        m_failed = true;
+        BinaryReader invalid;
+        invalid.m_failed = true;
+        return invalid;
+    }
+    return BinaryReader(body, static_cast<size_t>(length));
+}
+
+bool BinaryReader::NextSection(uint32_t& tag, uint32_t& version, BinaryReader& body)
+{
+    if (m_failed || AtEnd())
+    {
+        return false;
+    }
+
+    tag = ReadVarUInt32();
+    version = ReadVarUInt32();
+    body = ReadRecord();
+    return !m_failed;
+}
@@ -0,0 +1,604 @@
+#include "utils/BinaryLog.h"
+#include "utils/Logger.h"
+#include <filesystem>
+#include <unordered_map>
+
+namespace
+{
+    const char FileMagic[8] = { 'T', 'W', '3', 'B', 'L', 'O', 'G', '\0' };
+
+    // File layout: header, then tagged records in write order
+    enum RecordTag : uint8_t
+    {
+        TagSite = 1,       // id, level, category, argc, arg types, format, source
+        TagChunk = 2,      // thread index, byte count, packed entries
+        TagDropped = 3     // thread index, records lost to a full buffer
+    };
+
+    struct ThreadBufferHolder
+    {
+        std::shared_ptr<BinaryLogBuffer> buffer;
+
+        ~ThreadBufferHolder()
+        {
+            if (buffer)
+            {
+                buffer->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local ThreadBufferHolder t_buffer;
+
+    void AppendBytes(std::vector<uint8_t>& out, const void* bytes, size_t size)
+    {
+        const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+        out.insert(out.end(), begin, begin + size);
+    }
+
+    template <typename T>
+    void AppendValue(std::vector<uint8_t>& out, T value)
+    {
+        AppendBytes(out, &value, sizeof(value));
+    }
+
+    void AppendString(std::vector<uint8_t>& out, const std::string& text)
+    {
+        AppendValue(out, static_cast<uint32_t>(text.size()));
+        AppendBytes(out, text.data(), text.size());
+    }
+
+    size_t RoundUpPowerOfTwo(size_t value)
+    {
+        size_t result = 64;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    // Bounds-checked reader over an in-memory chunk
+    class ByteReader
+    {
+    public:
+        ByteReader(const uint8_t* data, size_t size) : m_data(data), m_size(size), m_offset(0) {}
+
+        bool Read(void* out, size_t size)
+        {
+            if (m_size - m_offset < size)
+            {
+                return false;
+            }
+            std::memcpy(out, m_data + m_offset, size);
+            m_offset += size;
+            return true;
+        }
+
+        bool ReadString(std::string& out, size_t size)
+        {
+            if (m_size - m_offset < size)
+            {
+                return false;
+            }
+            out.assign(reinterpret_cast<const char*>(m_data + m_offset), size);
+            m_offset += size;
+            return true;
+        }
+
+        bool AtEnd() const { return m_offset == m_size; }
+
+    private:
+        const uint8_t* m_data;
+        size_t m_size;
+        size_t m_offset;
+    };
+
+    template <typename T>
+    bool ReadValue(std::istream& input, T& value)
+    {
+        return static_cast<bool>(input.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    bool ReadString(std::istream& input, std::string& text)
+    {
+        uint32_t length = 0;
+        if (!ReadValue(input, length) || length > (1u << 20))
+        {
+            return false;
+        }
+        text.resize(length);
+        return static_cast<bool>(input.read(text.data(), length));
+    }
+
+    struct DecodedSite
+    {
+        LogLevel level;
+        LogCategory category;
+        std::string format;
+        std::string source;
+        std::vector<BinaryLogArgType> types;
+    };
+
+    bool DecodeArgument(ByteReader& reader, BinaryLogArgType type, std::string& out)
+    {
+        switch (type)
+        {
+            case BinaryLogArgType::Int64:
+            {
+                int64_t value;
+                if (!reader.Read(&value, sizeof(value))) return false;
+                out = std::to_string(value);
+                return true;
+            }
+            case BinaryLogArgType::UInt64:
+            {
+                uint64_t value;
+                if (!reader.Read(&value, sizeof(value))) return false;
+                out = std::to_string(value);
+                return true;
+            }
+            case BinaryLogArgType::Double:
+            {
+                double value;
+                if (!reader.Read(&value, sizeof(value))) return false;
+                out = std::to_string(value);
+                return true;
+            }
+            case BinaryLogArgType::Bool:
+            {
+                uint8_t value;
+                if (!reader.Read(&value, 1)) return false;
+                out = value ? "true" : "false";
+                return true;
+            }
+            case BinaryLogArgType::Char:
+            {
+                uint8_t value;
+                if (!reader.Read(&value, 1)) return false;
+                out.assign(1, static_cast<char>(value));
+                return true;
+            }
+            case BinaryLogArgType::String:
+            {
+                uint16_t length;
+                return reader.Read(&length, sizeof(length)) && reader.ReadString(out, length);
+            }
+            default:
+                return false;
+        }
+    }
+}
+
+// Static member initialization
+std::atomic<bool> BinaryLog::s_active{false};
+
+BinaryLogBuffer::BinaryLogBuffer(size_t bufferCapacity, uint32_t index, uint32_t startGeneration)
+    : data(new uint8_t[bufferCapacity]), capacity(bufferCapacity), mask(bufferCapacity - 1), threadIndex(index),
+      generation(startGeneration), writePos(0), readPos(0), dropped(0), retired(false)
+{
+}
+
+BinaryLog& BinaryLog::GetInstance()
+{
+    static BinaryLog instance;
+    return instance;
+}
+
+BinaryLog::~BinaryLog()
+{
+    Stop();
+}
+
+bool BinaryLog::Start(const std::string& filename, size_t threadBufferSize, std::chrono::milliseconds flushInterval)
+{
+    Stop();
+
+    {
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+
+        std::filesystem::path filePath(filename);
+        if (filePath.has_parent_path())
+        {
+            std::filesystem::create_directories(filePath.parent_path());
+        }
+
+        m_file.open(filename, std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open())
+        {
+            LOG_ERROR_CAT(LogCategory::SYSTEM, "Failed to open binary log file: " + filename);
+            return false;
+        }
+
+        // Anchor steady_clock timestamps to wall time for the decoder
+        int64_t wallAnchor = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        int64_t steadyAnchor = std::chrono::steady_clock::now().time_since_epoch().count();
+
+        m_scratch.clear();
+        AppendBytes(m_scratch, FileMagic, sizeof(FileMagic));
+        AppendValue(m_scratch, FileVersion);
+        AppendValue(m_scratch, uint32_t(0));
+        AppendValue(m_scratch, wallAnchor);
+        AppendValue(m_scratch, steadyAnchor);
+        m_file.write(reinterpret_cast<const char*>(m_scratch.data()), m_scratch.size());
+
+        m_bytesWritten = m_scratch.size();
+        m_droppedRecords = 0;
+        m_flushInterval = flushInterval;
+    }
+
+    {
+        // Every site is described again in the new file
+        std::lock_guard<std::mutex> lock(m_siteMutex);
+        m_sitesWritten = 0;
+    }
+
+    {
+        // Stop drained the old buffers; threads allocate new ones of this size
+        // on their next call
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        m_buffers.clear();
+        m_nextThreadIndex = 0;
+        m_threadBufferSize = RoundUpPowerOfTwo(threadBufferSize);
+        m_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    m_stopRequested = false;
+    m_writerThread = std::thread(&BinaryLog::WriterThread, this);
+    s_active = true;
+
+    LOG_INFO_CAT(LogCategory::SYSTEM, "Binary logging started: " + filename);
+    return true;
+}
+
+void BinaryLog::Stop()
+{
+    if (!m_writerThread.joinable())
+    {
+        return;
+    }
+
+    s_active = false;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopRequested = true;
+    }
+    m_wakeCondition.notify_one();
+    m_writerThread.join();
+
+    uint64_t bytesWritten;
+    {
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+        DrainBuffers();
+        m_file.close();
+        bytesWritten = m_bytesWritten;
+    }
+
+    LOG_INFO_CAT(LogCategory::SYSTEM, "Binary logging stopped (" + std::to_string(bytesWritten) + " bytes, " +
+                 std::to_string(GetDroppedRecords()) + " dropped)");
+}
+
+void BinaryLog::Flush()
+{
+    std::lock_guard<std::mutex> lock(m_fileMutex);
+    if (m_file.is_open())
+    {
+        DrainBuffers();
+    }
+}
+
+size_t BinaryLog::GetSiteCount() const
+{
+    std::lock_guard<std::mutex> lock(m_siteMutex);
+    return m_sites.size();
+}
+
+uint32_t BinaryLog::RegisterSite(LogLevel level, LogCategory category, const char* format, const char* source,
+                                 const BinaryLogArgType* types, size_t argCount)
+{
+    std::lock_guard<std::mutex> lock(m_siteMutex);
+    m_sites.push_back(Site{ level, category, format, source ? source : "",
+                            std::vector<BinaryLogArgType>(types, types + argCount) });
+    return static_cast<uint32_t>(m_sites.size());
+}
+
+BinaryLogBuffer* BinaryLog::GetThreadBuffer()
+{
+    BinaryLogBuffer* buffer = t_buffer.buffer.get();
+    if (buffer != nullptr && buffer->generation == m_generation.load(std::memory_order_relaxed))
+    {
+        return buffer;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        t_buffer.buffer = std::make_shared<BinaryLogBuffer>(m_threadBufferSize, m_nextThreadIndex++,
+                                                            m_generation.load(std::memory_order_relaxed));
+        m_buffers.push_back(t_buffer.buffer);
+    }
+    return t_buffer.buffer.get();
+}
+
+void BinaryLog::WriterThread()
+{
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    while (!m_stopRequested)
+    {
+        m_wakeCondition.wait_for(lock, m_flushInterval, [this]() { return m_stopRequested; });
+        lock.unlock();
+        Flush();
+        lock.lock();
+    }
+}
+
+// Caller holds m_fileMutex
+void BinaryLog::DrainBuffers()
+{
+    struct Chunk
+    {
+        uint32_t threadIndex;
+        size_t offset;
+        size_t size;
+        uint64_t dropped;
+    };
+
+    std::vector<std::shared_ptr<BinaryLogBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        buffers = m_buffers;
+    }
+
+    // Copy out the rings first so every site they reference is registered by
+    // the time the site table is written below
+    std::vector<uint8_t> entries;
+    std::vector<Chunk> chunks;
+    std::vector<BinaryLogBuffer*> finished;
+    for (const auto& buffer : buffers)
+    {
+        bool retired = buffer->retired.load(std::memory_order_acquire);
+        uint64_t write = buffer->writePos.load(std::memory_order_acquire);
+        uint64_t read = buffer->readPos.load(std::memory_order_relaxed);
+        size_t size = static_cast<size_t>(write - read);
+
+        size_t offset = entries.size();
+        if (size > 0)
+        {
+            size_t start = static_cast<size_t>(read) & buffer->mask;
+            size_t first = std::min(size, buffer->capacity - start);
+            entries.insert(entries.end(), buffer->data.get() + start, buffer->data.get() + start + first);
+            entries.insert(entries.end(), buffer->data.get(), buffer->data.get() + (size - first));
+            buffer->readPos.store(write, std::memory_order_release);
+        }
+
+        uint64_t dropped = buffer->dropped.exchange(0, std::memory_order_relaxed);
+        if (size > 0 || dropped > 0)
+        {
+            chunks.push_back(Chunk{ buffer->threadIndex, offset, size, dropped });
+        }
+
+        // Retired before we read writePos, so nothing more will arrive
+        if (retired)
+        {
+            finished.push_back(buffer.get());
+        }
+    }
+
+    m_scratch.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_siteMutex);
+        for (; m_sitesWritten < m_sites.size(); ++m_sitesWritten)
+        {
+            const Site& site = m_sites[m_sitesWritten];
+            AppendValue(m_scratch, uint8_t(TagSite));
+            AppendValue(m_scratch, static_cast<uint32_t>(m_sitesWritten + 1));
+            AppendValue(m_scratch, static_cast<uint8_t>(site.level));
+            AppendValue(m_scratch, static_cast<uint8_t>(site.category));
+            AppendValue(m_scratch, static_cast<uint8_t>(site.types.size()));
+            AppendBytes(m_scratch, site.types.data(), site.types.size());
+            AppendString(m_scratch, site.format);
+            AppendString(m_scratch, site.source);
+        }
+    }
+
+    for (const Chunk& chunk : chunks)
+    {
+        if (chunk.size > 0)
+        {
+            AppendValue(m_scratch, uint8_t(TagChunk));
+            AppendValue(m_scratch, chunk.threadIndex);
+            AppendValue(m_scratch, static_cast<uint32_t>(chunk.size));
+            AppendBytes(m_scratch, entries.data() + chunk.offset, chunk.size);
+        }
+        if (chunk.dropped > 0)
+        {
+            AppendValue(m_scratch, uint8_t(TagDropped));
+            AppendValue(m_scratch, chunk.threadIndex);
+            AppendValue(m_scratch, chunk.dropped);
+            m_droppedRecords += chunk.dropped;
+        }
+    }
+
+    if (!m_scratch.empty())
+    {
+        m_file.write(reinterpret_cast<const char*>(m_scratch.data()), m_scratch.size());
+        m_file.flush();
+        m_bytesWritten += m_scratch.size();
+    }
+
+    if (!finished.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+            [&finished](const std::shared_ptr<BinaryLogBuffer>& buffer)
+            {
+                return std::find(finished.begin(), finished.end(), buffer.get()) != finished.end();
+            }), m_buffers.end());
+    }
+}
+
+// BinaryLogReader implementation
+bool BinaryLogReader::Read(std::istream& input, std::vector<BinaryLogRecord>& records,
+                           uint64_t& droppedRecords, std::string& error)
+{
+    droppedRecords = 0;
+
+    char magic[sizeof(FileMagic)];
+    uint32_t version = 0;
+    uint32_t reserved = 0;
+    int64_t wallAnchor = 0;
+    int64_t steadyAnchor = 0;
+    if (!input.read(magic, sizeof(magic)) || std::memcmp(magic, FileMagic, sizeof(magic)) != 0)
+    {
+        error = "Not a binary log file";
+        return false;
+    }
+    if (!ReadValue(input, version) || version != BinaryLog::FileVersion || !ReadValue(input, reserved) ||
+        !ReadValue(input, wallAnchor) || !ReadValue(input, steadyAnchor))
+    {
+        error = "Unsupported binary log version";
+        return false;
+    }
+
+    std::unordered_map<uint32_t, DecodedSite> sites;
+    std::vector<uint8_t> chunk;
+    std::vector<std::string> arguments;
+    bool ok = true;
+
+    uint8_t tag;
+    while (ok && ReadValue(input, tag))
+    {
+        if (tag == TagSite)
+        {
+            uint32_t id;
+            uint8_t level, category, argCount;
+            DecodedSite site;
+            ok = ReadValue(input, id) && ReadValue(input, level) && ReadValue(input, category) &&
+                 ReadValue(input, argCount);
+            if (ok)
+            {
+                site.level = static_cast<LogLevel>(level);
+                site.category = static_cast<LogCategory>(category);
+                site.types.resize(argCount);
+                ok = static_cast<bool>(input.read(reinterpret_cast<char*>(site.types.data()), argCount)) &&
+                     ReadString(input, site.format) && ReadString(input, site.source);
+            }
+            if (ok)
+            {
+                sites[id] = std::move(site);
+            }
+            else
+            {
+                error = "Truncated site record";
+            }
+        }
+        else if (tag == TagChunk)
+        {
+            uint32_t threadIndex, size;
+            ok = ReadValue(input, threadIndex) && ReadValue(input, size);
+            if (ok)
+            {
+                chunk.resize(size);
+                ok = static_cast<bool>(input.read(reinterpret_cast<char*>(chunk.data()), size));
+            }
+            if (!ok)
+            {
+                error = "Truncated entry chunk";
+                break;
+            }
+
+            ByteReader reader(chunk.data(), chunk.size());
+            while (ok && !reader.AtEnd())
+            {
+                uint32_t id;
+                uint64_t timestamp;
+                if (!reader.Read(&id, sizeof(id)) || !reader.Read(&timestamp, sizeof(timestamp)))
+                {
+                    error = "Truncated entry";
+                    ok = false;
+                    break;
+                }
+
+                auto it = sites.find(id);
+                if (it == sites.end())
+                {
+                    error = "Entry references unknown site " + std::to_string(id);
+                    ok = false;
+                    break;
+                }
+                const DecodedSite& site = it->second;
+
+                arguments.resize(site.types.size());
+                for (size_t i = 0; i < site.types.size() && ok; ++i)
+                {
+                    ok = DecodeArgument(reader, site.types[i], arguments[i]);
+                }
+                if (!ok)
+                {
+                    error = "Truncated entry arguments";
+                    break;
+                }
+
+                BinaryLogRecord record;
+                record.wallTimeNs = wallAnchor + (static_cast<int64_t>(timestamp) - steadyAnchor);
+                record.threadIndex = threadIndex;
+                record.level = site.level;
+                record.category = site.category;
+                record.source = site.source;
+
+                size_t pos = 0;
+                for (const std::string& argument : arguments)
+                {
+                    pos = LogFormat::AppendUntilPlaceholder(record.message, site.format, pos);
+                    if (pos == std::string_view::npos)
+                    {
+                        break;
+                    }
+                    record.message += argument;
+                }
+                LogFormat::FormatTo(record.message, site.format, pos);
+
+                records.push_back(std::move(record));
+            }
+        }
+        else if (tag == TagDropped)
+        {
+            uint32_t threadIndex;
+            uint64_t count;
+            ok = ReadValue(input, threadIndex) && ReadValue(input, count);
+            if (ok)
+            {
+                droppedRecords += count;
+            }
+            else
+            {
+                error = "Truncated dropped-record marker";
+            }
+        }
+        else
+        {
+            error = "Unknown record tag " + std::to_string(tag);
+            ok = false;
+        }
+    }
+
+    // Each thread's entries are already in order; merge them by time
+    std::stable_sort(records.begin(), records.end(),
+        [](const BinaryLogRecord& a, const BinaryLogRecord& b) { return a.wallTimeNs < b.wallTimeNs; });
+    return ok;
+}
+
+std::string BinaryLogReader::FormatRecord(const BinaryLogRecord& record)
+{
+    auto time = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(record.wallTimeNs)));
+
+    std::string text = "[" + Logger::GetTimeString(time) + "] [" + Logger::GetLevelString(record.level) + "] [" +
+                       Logger::GetCategoryString(record.category) + "] ";
+    if (!record.source.empty())
+    {
+        text += "[" + record.source + "] ";
+    }
+    text += record.message;
+    return text;
+}
@@ -0,0 +1,141 @@
+#include "utils/BlockPool.h"
+#include <cstring>
+
+// PooledBuffer implementation
+PooledBuffer::~PooledBuffer()
+{
+    Release();
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept
+    : m_pool(other.m_pool), m_data(other.m_data), m_size(other.m_size), m_block(other.m_block)
+{
+    other.m_pool = nullptr;
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_block = InvalidBlock;
+}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        m_pool = other.m_pool;
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_block = other.m_block;
+
+        other.m_pool = nullptr;
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_block = InvalidBlock;
+    }
+    return *this;
+}
+
+void PooledBuffer::Release()
+{
+    if (m_block != InvalidBlock)
+    {
+        m_pool->PushBlock(m_block);
+    }
+    else
+    {
+        delete[] m_data;
+    }
+
+    m_pool = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_block = InvalidBlock;
+}
+
+// BlockPool implementation
+BlockPool::BlockPool(size_t blockSize, size_t blockCount)
+    : m_blockSize(0), m_blockCount(0), m_head(EmptyList), m_freeBlocks(0), m_heapFallbacks(0)
+{
+    Reset(blockSize, blockCount);
+}
+
+void BlockPool::Reset(size_t blockSize, size_t blockCount)
+{
+    m_blockSize = blockSize;
+    m_blockCount = blockSize > 0 ? blockCount : 0;
+    m_storage.reset(m_blockCount > 0 ? new uint8_t[m_blockSize * m_blockCount] : nullptr);
+    m_next.reset(m_blockCount > 0 ? new std::atomic<uint32_t>[m_blockCount] : nullptr);
+
+    // Chain every block into the free list in index order
+    for (size_t i = 0; i < m_blockCount; ++i)
+    {
+        uint32_t next = i + 1 < m_blockCount ? static_cast<uint32_t>(i + 1) : EmptyList;
+        m_next[i].store(next, std::memory_order_relaxed);
+    }
+
+    m_head.store(m_blockCount > 0 ? 0 : EmptyList, std::memory_order_relaxed);
+    m_freeBlocks.store(m_blockCount, std::memory_order_relaxed);
+    m_heapFallbacks.store(0, std::memory_order_relaxed);
+}
+
+PooledBuffer BlockPool::Allocate(size_t size)
+{
+    PooledBuffer buffer;
+    if (size == 0)
+    {
+        return buffer;
+    }
+
+    uint32_t block = size <= m_blockSize ? PopBlock() : EmptyList;
+    if (block != EmptyList)
+    {
+        buffer.m_pool = this;
+        buffer.m_block = block;
+        buffer.m_data = m_storage.get() + static_cast<size_t>(block) * m_blockSize;
+    }
+    else
+    {
+        m_heapFallbacks.fetch_add(1, std::memory_order_relaxed);
+        buffer.m_data = new uint8_t[size];
+    }
+
+    buffer.m_size = static_cast<uint32_t>(size);
+    std::memset(buffer.m_data, 0, size);
+    return buffer;
+}
+
+uint32_t BlockPool::PopBlock()
+{
+    uint64_t head = m_head.load(std::memory_order_acquire);
+    for (;;)
+    {
+        uint32_t block = static_cast<uint32_t>(head);
+        if (block == EmptyList)
+        {
+            return EmptyList;
+        }
+
+        // The tag makes the CAS fail if the block was popped and pushed back meanwhile
+        uint64_t next = m_next[block].load(std::memory_order_relaxed);
+        uint64_t newHead = ((head >> 32) + 1) << 32 | next;
+        if (m_head.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            m_freeBlocks.fetch_sub(1, std::memory_order_relaxed);
+            return block;
+        }
+    }
+}
+
+void BlockPool::PushBlock(uint32_t block)
+{
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        m_next[block].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        uint64_t newHead = ((head >> 32) + 1) << 32 | block;
+        if (m_head.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+        {
+            m_freeBlocks.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
@@ -0,0 +1,451 @@
+#include "utils/ChunkStore.h"
+#include "utils/DurableFile.h"
+#include "utils/Lz4Block.h"
+#include "utils/MappedFile.h"
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+    uint64_t Rotl(uint64_t value, int shift)
+    {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    uint64_t FinalMix(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return key;
+    }
+
+    uint64_t ReadLittleEndian64(const uint8_t* bytes)
+    {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i)
+        {
+            value = (value << 8) | bytes[i];
+        }
+        return value;
+    }
+
+    // Per-byte values for the rolling hash. Boundaries depend on these, so
+    // the seed is part of the chunk format and must not change.
+    const std::array<uint64_t, 256>& GearTable()
+    {
+        static const std::array<uint64_t, 256> table = []()
+        {
+            std::array<uint64_t, 256> values{};
+            uint64_t state = 0x5457334d50534156ULL;
+            for (auto& value : values)
+            {
+                // splitmix64
+                uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                value = z ^ (z >> 31);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    bool ParseHexDigit(char c, uint64_t& out)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            out = c - '0';
+            return true;
+        }
+        if (c >= 'a' && c <= 'f')
+        {
+            out = c - 'a' + 10;
+            return true;
+        }
+        return false;
+    }
+}
+
+// ChunkHash implementation
+std::string ChunkHash::ToHex() const
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(32, '0');
+    for (int i = 0; i < 16; ++i)
+    {
+        hex[15 - i] = digits[(high >> (i * 4)) & 0xF];
+        hex[31 - i] = digits[(low >> (i * 4)) & 0xF];
+    }
+    return hex;
+}
+
+bool ChunkHash::FromHex(const std::string& hex, ChunkHash& out)
+{
+    if (hex.size() != 32)
+    {
+        return false;
+    }
+
+    ChunkHash hash;
+    for (int i = 0; i < 32; ++i)
+    {
+        uint64_t digit;
+        if (!ParseHexDigit(hex[i], digit))
+        {
+            return false;
+        }
+        uint64_t& half = i < 16 ? hash.high : hash.low;
+        half = (half << 4) | digit;
+    }
+    out = hash;
+    return true;
+}
+
+// ChunkStore implementation
+bool ChunkStore::Open(const std::string& directory)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directory = directory;
+    m_known.clear();
+
+    // Temp files left by an interrupted write do not parse as hashes
+    for (auto it = std::filesystem::recursive_directory_iterator(directory, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+    {
+        ChunkHash hash;
+        if (it->is_regular_file(ec) && ChunkHash::FromHex(it->path().filename().string(), hash))
+        {
+            m_known.insert(hash);
+        }
+    }
+    return !ec;
+}
+
+bool ChunkStore::Store(const std::vector<uint8_t>& data, std::vector<ChunkRef>& refs, bool compress)
+{
+    std::vector<size_t> boundaries = FindBoundaries(data.data(), data.size());
+    refs.assign(boundaries.size(), ChunkRef());
+
+    std::atomic<bool> failed{ false };
+    ForEach(boundaries.size(), [&](size_t i)
+    {
+        size_t start = i == 0 ? 0 : boundaries[i - 1];
+        ChunkRef& ref = refs[i];
+        ref.size = static_cast<uint32_t>(boundaries[i] - start);
+        ref.hash = Hash(data.data() + start, ref.size);
+
+        // Claimed before writing so a chunk repeated within data is written once
+        bool claimed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            claimed = m_known.insert(ref.hash).second;
+        }
+
+        if (!claimed)
+        {
+            m_chunksReused.fetch_add(1, std::memory_order_relaxed);
+            m_bytesReused.fetch_add(ref.size, std::memory_order_relaxed);
+            return;
+        }
+
+        size_t stored = 0;
+        if (!WriteChunk(ref.hash, data.data() + start, ref.size, compress, stored))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_known.erase(ref.hash);
+            failed = true;
+            return;
+        }
+
+        m_chunksWritten.fetch_add(1, std::memory_order_relaxed);
+        m_bytesWritten.fetch_add(ref.size, std::memory_order_relaxed);
+        m_bytesStored.fetch_add(stored, std::memory_order_relaxed);
+    });
+
+    if (failed)
+    {
+        refs.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ChunkStore::Load(const std::vector<ChunkRef>& refs, std::vector<uint8_t>& data) const
+{
+    std::vector<size_t> offsets(refs.size());
+    size_t total = 0;
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+        offsets[i] = total;
+        total += refs[i].size;
+    }
+
+    // Each chunk decodes straight into its place in data
+    data.resize(total);
+    std::atomic<bool> failed{ false };
+    ForEach(refs.size(), [&](size_t i)
+    {
+        if (!ReadChunk(refs[i], data.data() + offsets[i]))
+        {
+            failed = true;
+        }
+    });
+
+    if (failed)
+    {
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ChunkStore::Recode(const std::vector<ChunkRef>& refs, bool compress)
+{
+    std::vector<ChunkRef> unique;
+    ChunkHashSet seen;
+    for (const auto& ref : refs)
+    {
+        if (seen.insert(ref.hash).second)
+        {
+            unique.push_back(ref);
+        }
+    }
+
+    std::atomic<bool> failed{ false };
+    ForEach(unique.size(), [&](size_t i)
+    {
+        std::vector<uint8_t> chunk(unique[i].size);
+        size_t stored = 0;
+        if (!ReadChunk(unique[i], chunk.data()) ||
+            !WriteChunk(unique[i].hash, chunk.data(), chunk.size(), compress, stored))
+        {
+            failed = true;
+        }
+    });
+    return !failed;
+}
+
+size_t ChunkStore::RemoveUnreferenced(const ChunkHashSet& live)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t removed = 0;
+    for (auto it = m_known.begin(); it != m_known.end();)
+    {
+        if (live.count(*it) != 0)
+        {
+            ++it;
+            continue;
+        }
+
+        std::error_code ec;
+        std::filesystem::remove(GetChunkPath(*it), ec);
+        if (ec)
+        {
+            ++it;
+            continue;
+        }
+        it = m_known.erase(it);
+        removed++;
+    }
+
+    m_chunksCollected.fetch_add(removed, std::memory_order_relaxed);
+    return removed;
+}
+
+size_t ChunkStore::GetChunkCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_known.size();
+}
+
+ChunkStoreStats ChunkStore::GetStats() const
+{
+    ChunkStoreStats stats;
+    stats.chunksWritten = m_chunksWritten.load(std::memory_order_relaxed);
+    stats.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    stats.bytesStored = m_bytesStored.load(std::memory_order_relaxed);
+    stats.chunksReused = m_chunksReused.load(std::memory_order_relaxed);
+    stats.bytesReused = m_bytesReused.load(std::memory_order_relaxed);
+    stats.chunksCollected = m_chunksCollected.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::vector<size_t> ChunkStore::FindBoundaries(const uint8_t* data, size_t size)
+{
+    const auto& gear = GearTable();
+    std::vector<size_t> boundaries;
+
+    size_t start = 0;
+    while (start < size)
+    {
+        size_t remaining = size - start;
+        if (remaining <= MinChunkSize)
+        {
+            boundaries.push_back(size);
+            break;
+        }
+
+        // Cut where the top bits of the rolling hash are zero; the hash covers
+        // the last 64 bytes, so cuts realign shortly after an insertion
+        size_t end = start + std::min(remaining, MaxChunkSize);
+        size_t cut = end;
+        uint64_t hash = 0;
+        for (size_t i = start + MinChunkSize; i < end; ++i)
+        {
+            hash = (hash << 1) + gear[data[i]];
+            if ((hash >> (64 - BoundaryBits)) == 0)
+            {
+                cut = i + 1;
+                break;
+            }
+        }
+
+        boundaries.push_back(cut);
+        start = cut;
+    }
+    return boundaries;
+}
+
+ChunkHash ChunkStore::Hash(const uint8_t* data, size_t size)
+{
+    // MurmurHash3 x64 128-bit
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+    uint64_t h1 = 0;
+    uint64_t h2 = 0;
+
+    size_t blocks = size / 16;
+    for (size_t i = 0; i < blocks; ++i)
+    {
+        uint64_t k1 = ReadLittleEndian64(data + i * 16);
+        uint64_t k2 = ReadLittleEndian64(data + i * 16 + 8);
+
+        k1 *= c1; k1 = Rotl(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = Rotl(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = Rotl(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = Rotl(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const uint8_t* tail = data + blocks * 16;
+    size_t tailSize = size & 15;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (size_t i = tailSize; i > 8; --i)
+    {
+        k2 ^= static_cast<uint64_t>(tail[i - 1]) << ((i - 9) * 8);
+    }
+    if (tailSize > 8)
+    {
+        k2 *= c2; k2 = Rotl(k2, 33); k2 *= c1; h2 ^= k2;
+    }
+    for (size_t i = std::min<size_t>(tailSize, 8); i > 0; --i)
+    {
+        k1 ^= static_cast<uint64_t>(tail[i - 1]) << ((i - 1) * 8);
+    }
+    if (tailSize > 0)
+    {
+        k1 *= c1; k1 = Rotl(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    h1 ^= size;
+    h2 ^= size;
+    h1 += h2;
+    h2 += h1;
+    h1 = FinalMix(h1);
+    h2 = FinalMix(h2);
+    h1 += h2;
+    h2 += h1;
+
+    ChunkHash hash;
+    hash.high = h1;
+    hash.low = h2;
+    return hash;
+}
+
+std::string ChunkStore::GetChunkPath(const ChunkHash& hash) const
+{
+    std::string hex = hash.ToHex();
+    return m_directory + "/" + hex.substr(0, 2) + "/" + hex;
+}
+
+bool ChunkStore::WriteChunk(const ChunkHash& hash, const uint8_t* data, size_t size, bool compress, size_t& stored)
+{
+    std::string path = GetChunkPath(hash);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    if (compress)
+    {
+        std::vector<uint8_t> compressed(Lz4CompressBound(size));
+        size_t compressedSize = Lz4Compress(data, size, compressed.data(), compressed.size());
+
+        // Only strictly smaller output is kept, so the file size says how to read it
+        if (compressedSize > 0 && compressedSize < size)
+        {
+            stored = compressedSize;
+            return WriteFileDurably(path, compressed.data(), compressedSize);
+        }
+    }
+
+    stored = size;
+    return WriteFileDurably(path, data, size);
+}
+
+bool ChunkStore::ReadChunk(const ChunkRef& ref, uint8_t* out) const
+{
+    MappedFile chunk;
+    if (!chunk.Open(GetChunkPath(ref.hash)))
+    {
+        return false;
+    }
+
+    if (chunk.GetSize() == ref.size)
+    {
+        if (ref.size > 0)
+        {
+            std::memcpy(out, chunk.GetData(), ref.size);
+        }
+    }
+    else if (chunk.GetSize() > ref.size || !Lz4Decompress(chunk.GetData(), chunk.GetSize(), out, ref.size))
+    {
+        return false;
+    }
+
+    return Hash(out, ref.size) == ref.hash;
+}
+
+void ChunkStore::ForEach(size_t count, const std::function<void(size_t)>& body) const
+{
+    if (!m_pool)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            body(i);
+        }
+        return;
+    }
+
+    // A few chunks per task keeps the queue traffic small next to the work
+    m_pool->ParallelFor(count, 4, [&body](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            body(i);
+        }
+    });
+}
@@ -39,6 +39,9 @@ void ConfigManager::SetDefaultValues()
     m_config["log_level"] = "INFO";
     m_config["auto_save"] = "true";
     m_config["save_interval"] = "300"; // 5 minutes
+    m_config["metrics_port"] = "0"; // Prometheus /metrics on localhost, 0 disables it
+    m_config["trace_enabled"] = "false";
+    m_config["trace_slow_tick_ms"] = "50"; // Dump a trace window when a tick runs longer, 0 disables it
 }
 
 bool ConfigManager::LoadConfig(const std::string& filename)
@@ -0,0 +1,65 @@
+#include "utils/DurableFile.h"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+bool WriteFileDurably(const std::string& path, const void* data, size_t size)
+{
+    // Unique temp names let two writers race on one path; the last rename wins
+    static std::atomic<uint64_t> s_tempCounter{ 0 };
+    std::string tempPath = path + ".tmp" + std::to_string(s_tempCounter.fetch_add(1, std::memory_order_relaxed));
+
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file)
+    {
+        return false;
+    }
+
+    bool written = size == 0 || std::fwrite(data, 1, size, file) == size;
+    written = written && std::fflush(file) == 0;
+#ifdef _WIN32
+    written = written && _commit(_fileno(file)) == 0;
+#else
+    written = written && fsync(fileno(file)) == 0;
+#endif
+    written = (std::fclose(file) == 0) && written;
+
+    std::error_code ec;
+    if (written)
+    {
+        std::filesystem::rename(tempPath, path, ec);
+    }
+    if (!written || ec)
+    {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& data)
+{
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    data.clear();
+    uint8_t buffer[64 * 1024];
+    size_t length;
+    while ((length = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        data.insert(data.end(), buffer, buffer + length);
+    }
+
+    bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    return ok;
+}
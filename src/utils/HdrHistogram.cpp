@@ -0,0 +1,248 @@
+#include "utils/HdrHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+namespace
+{
+    // Threads are assigned shards round-robin on their first record
+    std::atomic<size_t> s_nextThreadShard{0};
+}
+
+HdrHistogram::HdrHistogram()
+{
+    Reset();
+}
+
+size_t HdrHistogram::BucketIndex(uint64_t value)
+{
+    const uint64_t maxValue = (uint64_t(1) << (HighestBit + 1)) - 1;
+    value = std::min(value, maxValue);
+
+    if (value < 2 * SubBucketCount)
+    {
+        return static_cast<size_t>(value);
+    }
+
+    uint32_t msb = 63;
+    while ((value >> msb) == 0)
+    {
+        --msb;
+    }
+
+    // The top SubBucketBits + 1 bits select the bucket within this power of two
+    uint32_t shift = msb - SubBucketBits;
+    uint64_t subBucket = value >> shift;
+    return static_cast<size_t>((shift + 1) * SubBucketCount + (subBucket - SubBucketCount));
+}
+
+uint64_t HdrHistogram::BucketUpperBound(size_t index)
+{
+    if (index < 2 * SubBucketCount)
+    {
+        return index;
+    }
+
+    uint32_t shift = static_cast<uint32_t>(index / SubBucketCount) - 1;
+    uint64_t subBucket = index % SubBucketCount + SubBucketCount;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void HdrHistogram::Record(uint64_t value)
+{
+    m_buckets[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+
+    current = m_max.load(std::memory_order_relaxed);
+    while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void HdrHistogram::Reset()
+{
+    for (auto& bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+void HdrHistogram::Merge(const HdrHistogram& other)
+{
+    for (size_t i = 0; i < BucketCount; ++i)
+    {
+        uint64_t count = other.m_buckets[i].load(std::memory_order_relaxed);
+        if (count > 0)
+        {
+            m_buckets[i].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t otherCount = other.GetCount();
+    if (otherCount == 0)
+    {
+        return;
+    }
+
+    m_count.fetch_add(otherCount, std::memory_order_relaxed);
+    m_sum.fetch_add(other.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    uint64_t otherMin = other.m_min.load(std::memory_order_relaxed);
+    uint64_t current = m_min.load(std::memory_order_relaxed);
+    while (otherMin < current && !m_min.compare_exchange_weak(current, otherMin, std::memory_order_relaxed))
+    {
+    }
+
+    uint64_t otherMax = other.GetMax();
+    current = m_max.load(std::memory_order_relaxed);
+    while (otherMax > current && !m_max.compare_exchange_weak(current, otherMax, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint64_t HdrHistogram::GetMin() const
+{
+    return GetCount() > 0 ? m_min.load(std::memory_order_relaxed) : 0;
+}
+
+double HdrHistogram::GetMean() const
+{
+    uint64_t count = GetCount();
+    return count > 0 ? static_cast<double>(m_sum.load(std::memory_order_relaxed)) / count : 0.0;
+}
+
+uint64_t HdrHistogram::GetPercentile(double percentile) const
+{
+    uint64_t count = GetCount();
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * count)));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BucketCount; ++i)
+    {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target)
+        {
+            return std::min(BucketUpperBound(i), GetMax());
+        }
+    }
+    return GetMax();
+}
+
+// PerThreadHdrHistogram implementation
+PerThreadHdrHistogram::PerThreadHdrHistogram()
+{
+    for (auto& shard : m_shards)
+    {
+        shard.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+PerThreadHdrHistogram::~PerThreadHdrHistogram()
+{
+    for (auto& shard : m_shards)
+    {
+        delete shard.load(std::memory_order_relaxed);
+    }
+}
+
+HdrHistogram& PerThreadHdrHistogram::GetShard()
+{
+    thread_local size_t shardIndex = s_nextThreadShard.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+
+    HdrHistogram* shard = m_shards[shardIndex].load(std::memory_order_acquire);
+    if (!shard)
+    {
+        // First record from this shard: publish a new histogram, or adopt the
+        // one another thread raced us to
+        auto created = std::make_unique<HdrHistogram>();
+        if (m_shards[shardIndex].compare_exchange_strong(shard, created.get(), std::memory_order_acq_rel))
+        {
+            shard = created.release();
+        }
+    }
+    return *shard;
+}
+
+void PerThreadHdrHistogram::Record(uint64_t value)
+{
+    GetShard().Record(value);
+}
+
+void PerThreadHdrHistogram::Reset()
+{
+    for (auto& shard : m_shards)
+    {
+        if (HdrHistogram* histogram = shard.load(std::memory_order_acquire))
+        {
+            histogram->Reset();
+        }
+    }
+}
+
+void PerThreadHdrHistogram::MergeInto(HdrHistogram& out) const
+{
+    for (const auto& shard : m_shards)
+    {
+        if (const HdrHistogram* histogram = shard.load(std::memory_order_acquire))
+        {
+            out.Merge(*histogram);
+        }
+    }
+}
+
+uint64_t PerThreadHdrHistogram::GetCount() const
+{
+    uint64_t count = 0;
+    for (const auto& shard : m_shards)
+    {
+        if (const HdrHistogram* histogram = shard.load(std::memory_order_acquire))
+        {
+            count += histogram->GetCount();
+        }
+    }
+    return count;
+}
+
+uint64_t PerThreadHdrHistogram::GetMax() const
+{
+    uint64_t max = 0;
+    for (const auto& shard : m_shards)
+    {
+        if (const HdrHistogram* histogram = shard.load(std::memory_order_acquire))
+        {
+            max = std::max(max, histogram->GetMax());
+        }
+    }
+    return max;
+}
+
+double PerThreadHdrHistogram::GetMean() const
+{
+    HdrHistogram merged;
+    MergeInto(merged);
+    return merged.GetMean();
+}
+
+uint64_t PerThreadHdrHistogram::GetPercentile(double percentile) const
+{
+    HdrHistogram merged;
+    MergeInto(merged);
+    return merged.GetPercentile(percentile);
+}
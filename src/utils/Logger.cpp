@@ -1,4 +1,5 @@
 #include "utils/Logger.h"
+#include "utils/TraceRecorder.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
@@ -6,11 +7,34 @@
 #include <filesystem>
 #include <algorithm>
 
+size_t LogFormat::AppendUntilPlaceholder(std::string& out, std::string_view fmt, size_t pos)
+{
+    while (pos < fmt.size())
+    {
+        char c = fmt[pos];
+        bool doubled = pos + 1 < fmt.size() && fmt[pos + 1] == c;
+        if (c == '{' && pos + 1 < fmt.size() && fmt[pos + 1] == '}')
+        {
+            return pos + 2;
+        }
+        if ((c == '{' || c == '}') && doubled)
+        {
+            out.push_back(c); // Escaped brace
+            pos += 2;
+            continue;
+        }
+        out.push_back(c);
+        ++pos;
+    }
+    return std::string_view::npos;
+}
+
 // Static member initialization
 Logger* Logger::s_instance = nullptr;
+std::atomic<int> Logger::s_level{static_cast<int>(LogLevel::INFO)};
+std::atomic<uint32_t> Logger::s_categoryMask{0xFFu}; // All categories enabled
 
 Logger::Logger()
-    : m_enabledCategories(8, true) // Initialize all categories as enabled
 {
     // Start the worker thread
     m_workerThread = std::thread(&Logger::LogWorkerThread, this);
@@ -19,11 +43,14 @@ Logger::Logger()
     // Create logs directory if it doesn't exist
     std::filesystem::create_directories(m_logDirectory);
     
-    LOG_INFO_CAT(LogCategory::SYSTEM, "Logger initialized with buffered logging enabled");
+    // Called directly: the macros would re-enter GetInstance() before s_instance is set
+    Log(LogLevel::INFO, LogCategory::SYSTEM, "Logger initialized with buffered logging enabled", __FUNCTION__);
 }
 
 Logger::~Logger()
 {
+    BinaryLog::GetInstance().Stop();
+    
     m_running = false;
     m_condition.notify_all();
     
@@ -32,8 +59,8 @@ Logger::~Logger()
         m_workerThread.join();
     }
     
-    // Flush any remaining logs
-    FlushBuffer();
+    // The worker drains the queue before exiting; catch anything logged since
+    DrainQueue();
     
     if (m_logFileStream.is_open())
     {
@@ -59,66 +86,72 @@ void Logger::DestroyInstance()
     }
 }
 
+// Setters log only after releasing m_mutex: unbuffered logging writes under it
+
 void Logger::SetFileLogging(bool enable, const std::string& filename)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_fileLogging = enable;
-    m_logFile = filename;
-    
-    if (m_fileLogging)
+    bool opened = false;
     {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_fileLogging = enable;
+        m_logFile = filename;
+        
         if (m_logFileStream.is_open())
         {
             m_logFileStream.close();
         }
         
-        // Create directory if it doesn't exist
-        std::filesystem::path filePath(filename);
-        std::filesystem::create_directories(filePath.parent_path());
-        
-        m_logFileStream.open(filename, std::ios::app);
-        if (m_logFileStream.is_open())
+        if (m_fileLogging)
         {
-            LOG_INFO_CAT(LogCategory::SYSTEM, "File logging enabled: " + filename);
-        }
-        else
-        {
-            LOG_ERROR_CAT(LogCategory::SYSTEM, "Failed to open log file: " + filename);
+            // Create directory if it doesn't exist
+            std::filesystem::path filePath(filename);
+            std::filesystem::create_directories(filePath.parent_path());
+            
+            m_logFileStream.open(filename, std::ios::app);
+            opened = m_logFileStream.is_open();
         }
     }
-    else
+    
+    if (!enable)
     {
-        if (m_logFileStream.is_open())
-        {
-            m_logFileStream.close();
-        }
         LOG_INFO_CAT(LogCategory::SYSTEM, "File logging disabled");
     }
+    else if (opened)
+    {
+        LOG_INFO_CAT(LogCategory::SYSTEM, "File logging enabled: " + filename);
+    }
+    else
+    {
+        LOG_ERROR_CAT(LogCategory::SYSTEM, "Failed to open log file: " + filename);
+    }
 }
 
 void Logger::SetConsoleLogging(bool enable)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_consoleLogging = enable;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_consoleLogging = enable;
+    }
     LOG_INFO_CAT(LogCategory::SYSTEM, enable ? "Console logging enabled" : "Console logging disabled");
 }
 
 void Logger::SetLogLevel(LogLevel level)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_level = level;
+    s_level.store(static_cast<int>(level), std::memory_order_relaxed);
     LOG_INFO_CAT(LogCategory::SYSTEM, "Log level set to: " + GetLevelString(level));
 }
 
 void Logger::SetBufferedLogging(bool enable, size_t bufferSize)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_bufferedLogging = enable;
-    m_bufferSize = bufferSize;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bufferedLogging = enable;
+        m_bufferSize = bufferSize;
+    }
     
     if (!enable)
     {
-        FlushBuffer();
+        DrainQueue();
     }
     
     LOG_INFO_CAT(LogCategory::SYSTEM, 
@@ -128,29 +161,54 @@ void Logger::SetBufferedLogging(bool enable, size_t bufferSize)
 
 void Logger::SetLogDirectory(const std::string& directory)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_logDirectory = directory;
-    std::filesystem::create_directories(directory);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_logDirectory = directory;
+        std::filesystem::create_directories(directory);
+    }
     LOG_INFO_CAT(LogCategory::SYSTEM, "Log directory set to: " + directory);
 }
 
+bool Logger::SetBinaryLogging(bool enable, const std::string& filename)
+{
+    if (!enable)
+    {
+        BinaryLog::GetInstance().Stop();
+        return true;
+    }
+    return BinaryLog::GetInstance().Start(filename);
+}
+
 void Logger::Log(LogLevel level, LogCategory category, const std::string& message, const std::string& source)
 {
-    if (level < m_level || !m_enabledCategories[static_cast<int>(category)])
+    if (!IsEnabled(level, category))
         return;
 
-    std::string timestamp = GetCurrentTimeString();
-    LogEntry entry(timestamp, level, category, message, source);
-    
+    Submit(LogEntry(level, category, message, source));
+}
+
+void Logger::Submit(LogEntry&& entry)
+{
     if (m_bufferedLogging)
     {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        m_logQueue.push(entry);
-        m_condition.notify_one();
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_logQueue.push(std::move(entry));
+            wake = m_logQueue.size() == 1 || m_logQueue.size() >= m_bufferSize;
+        }
+        // The worker drains everything per wakeup, so only the first entry of
+        // a batch (or a full buffer) needs to signal it
+        if (wake)
+        {
+            m_condition.notify_one();
+        }
     }
     else
     {
+        std::lock_guard<std::mutex> lock(m_mutex);
         WriteLog(entry);
+        FlushStreams();
     }
 }
 
@@ -237,8 +295,7 @@ void Logger::LogCombatEvent(const std::string& event, const std::string& playerI
 
 void Logger::FlushLogs()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    FlushBuffer();
+    DrainQueue();
     LOG_INFO_CAT(LogCategory::SYSTEM, "Logs flushed to file");
 }
 
@@ -263,8 +320,15 @@ void Logger::SetLogLevelFromString(const std::string& level)
 
 void Logger::EnableCategory(LogCategory category, bool enable)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_enabledCategories[static_cast<int>(category)] = enable;
+    uint32_t bit = 1u << static_cast<int>(category);
+    if (enable)
+    {
+        s_categoryMask.fetch_or(bit, std::memory_order_relaxed);
+    }
+    else
+    {
+        s_categoryMask.fetch_and(~bit, std::memory_order_relaxed);
+    }
     LOG_INFO_CAT(LogCategory::SYSTEM, 
         "Category " + GetCategoryString(category) + " " + (enable ? "enabled" : "disabled"));
 }
@@ -276,23 +340,29 @@ void Logger::DisableCategory(LogCategory category)
 
 void Logger::StartPerformanceLogging()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_performanceLogging = true;
-    m_performanceStart = std::chrono::steady_clock::now();
-    m_performanceData.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_performanceLogging = true;
+        m_performanceStart = std::chrono::steady_clock::now();
+        m_performanceData.clear();
+    }
     LOG_INFO_CAT(LogCategory::SYSTEM, "Performance logging started");
 }
 
 void Logger::StopPerformanceLogging()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_performanceLogging = false;
+    std::vector<std::pair<std::string, double>> performanceData;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_performanceLogging = false;
+        performanceData.swap(m_performanceData);
+    }
     
     // Log performance summary
-    if (!m_performanceData.empty())
+    if (!performanceData.empty())
     {
         LOG_INFO_CAT(LogCategory::SYSTEM, "Performance logging stopped. Summary:");
-        for (const auto& perf : m_performanceData)
+        for (const auto& perf : performanceData)
         {
             LOG_INFO_CAT(LogCategory::SYSTEM, 
                 "  " + perf.first + ": " + std::to_string(perf.second) + "ms");
@@ -304,8 +374,10 @@ void Logger::LogPerformance(const std::string& operation, double duration)
 {
     if (m_performanceLogging)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_performanceData.push_back({operation, duration});
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_performanceData.push_back({operation, duration});
+        }
         LOG_DEBUG_CAT(LogCategory::SYSTEM, "Performance: " + operation + " took " + std::to_string(duration) + "ms");
     }
 }
@@ -339,9 +411,8 @@ std::string Logger::GetCategoryString(LogCategory category)
     }
 }
 
-std::string Logger::GetCurrentTimeString()
+std::string Logger::GetTimeString(std::chrono::system_clock::time_point now)
 {
-    auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()) % 1000;
@@ -355,58 +426,83 @@ std::string Logger::GetCurrentTimeString()
     return ss.str();
 }
 
-void Logger::WriteLog(const LogEntry& entry)
+// Caller holds m_mutex. Deferred messages are formatted here, on the writing thread.
+void Logger::WriteLog(LogEntry& entry)
 {
+    if (entry.formatter)
+    {
+        entry.message = entry.formatter();
+        entry.formatter = nullptr;
+    }
+    
     std::string formattedEntry = FormatLogEntry(entry);
     
     if (m_consoleLogging)
     {
-        std::cout << formattedEntry << std::endl;
+        std::cout << formattedEntry << '\n';
+    }
+    
+    if (m_fileLogging && m_logFileStream.is_open())
+    {
+        m_logFileStream << formattedEntry << '\n';
+    }
+}
+
+// Caller holds m_mutex
+void Logger::FlushStreams()
+{
+    if (m_consoleLogging)
+    {
+        std::cout.flush();
     }
     
     if (m_fileLogging && m_logFileStream.is_open())
     {
-        m_logFileStream << formattedEntry << std::endl;
         m_logFileStream.flush();
     }
 }
 
 void Logger::ProcessLogQueue()
 {
-    while (m_running)
+    for (;;)
     {
-        std::unique_lock<std::mutex> lock(m_queueMutex);
-        m_condition.wait(lock, [this] { return !m_logQueue.empty() || !m_running; });
-        
-        if (!m_running) break;
-        
-        // Process all available logs
-        while (!m_logQueue.empty())
         {
-            LogEntry entry = m_logQueue.front();
-            m_logQueue.pop();
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_condition.wait(lock, [this] { return !m_logQueue.empty() || !m_running; });
             
-            // Add to buffer
-            m_logBuffer.push_back(entry);
-            
-            // Flush buffer if it's full
-            if (m_logBuffer.size() >= m_bufferSize)
-            {
-                FlushBuffer();
-            }
+            // Drain what is left before exiting
+            if (m_logQueue.empty() && !m_running) break;
         }
         
-        lock.unlock();
+        DrainQueue();
     }
 }
 
-void Logger::FlushBuffer()
+void Logger::DrainQueue()
 {
-    for (const auto& entry : m_logBuffer)
+    std::lock_guard<std::mutex> outputLock(m_mutex);
+    
+    // Take the whole queue so producers only contend for the swap
+    std::queue<LogEntry> batch;
     {
-        WriteLog(entry);
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        batch.swap(m_logQueue);
+    }
+    
+    if (batch.empty())
+    {
+        return;
+    }
+    
+    TRACE_SCOPE_ARG("Logger::DrainQueue", "log", "entries", batch.size());
+    while (!batch.empty())
+    {
+        WriteLog(batch.front());
+        batch.pop();
     }
-    m_logBuffer.clear();
+    
+    // One flush per batch rather than per line
+    FlushStreams();
 }
 
 void Logger::RotateLogFile()
@@ -439,7 +535,7 @@ void Logger::RotateLogFile()
 std::string Logger::FormatLogEntry(const LogEntry& entry)
 {
     std::stringstream ss;
-    ss << "[" << entry.timestamp << "] "
+    ss << "[" << GetTimeString(entry.time) << "] "
        << "[" << GetLevelString(entry.level) << "] "
        << "[" << GetCategoryString(entry.category) << "] ";
     
@@ -454,6 +550,7 @@ std::string Logger::FormatLogEntry(const LogEntry& entry)
 
 void Logger::LogWorkerThread()
 {
+    TraceRecorder::GetInstance().SetThreadName("logger");
     m_workerRunning = true;
     ProcessLogQueue();
     m_workerRunning = false;
@@ -0,0 +1,217 @@
+#include "utils/Lz4Block.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    constexpr size_t MinMatch = 4;
+    constexpr size_t LastLiterals = 5;      // The block always ends in literals
+    constexpr size_t MatchSearchLimit = 12; // No match starts this close to the end
+    constexpr size_t MaxOffset = 65535;
+    constexpr uint32_t HashLog = 12;
+
+    uint32_t Read32(const uint8_t* bytes)
+    {
+        uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint32_t HashSequence(uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - HashLog);
+    }
+
+    // Lengths of 15 or more spill into 255-valued continuation bytes
+    uint8_t* WriteLength(uint8_t* out, size_t length)
+    {
+        while (length >= 255)
+        {
+            *out++ = 255;
+            length -= 255;
+        }
+        *out++ = static_cast<uint8_t>(length);
+        return out;
+    }
+
+    bool ReadLength(const uint8_t* source, size_t sourceSize, size_t& position, size_t& length)
+    {
+        uint8_t byte;
+        do
+        {
+            if (position >= sourceSize)
+            {
+                return false;
+            }
+            byte = source[position++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    uint8_t* WriteSequence(uint8_t* out, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+    {
+        uint8_t* token = out++;
+        *token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+        if (literalLength >= 15)
+        {
+            out = WriteLength(out, literalLength - 15);
+        }
+        std::memcpy(out, literals, literalLength);
+        out += literalLength;
+
+        if (matchLength == 0)
+        {
+            return out;
+        }
+
+        *out++ = static_cast<uint8_t>(offset);
+        *out++ = static_cast<uint8_t>(offset >> 8);
+        size_t extra = matchLength - MinMatch;
+        *token |= static_cast<uint8_t>(std::min<size_t>(extra, 15));
+        if (extra >= 15)
+        {
+            out = WriteLength(out, extra - 15);
+        }
+        return out;
+    }
+}
+
+size_t Lz4CompressBound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+size_t Lz4Compress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t capacity)
+{
+    if (capacity < Lz4CompressBound(sourceSize))
+    {
+        return 0;
+    }
+
+    uint8_t* out = destination;
+    size_t anchor = 0;
+
+    if (sourceSize > MatchSearchLimit)
+    {
+        // Positions + 1, so zero means empty
+        std::vector<uint32_t> table(size_t(1) << HashLog, 0);
+        const size_t searchEnd = sourceSize - MatchSearchLimit;
+        const size_t matchEnd = sourceSize - LastLiterals;
+
+        size_t position = 0;
+        size_t misses = 0;
+        while (position < searchEnd)
+        {
+            uint32_t sequence = Read32(source + position);
+            uint32_t hash = HashSequence(sequence);
+            size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > MaxOffset || Read32(source + candidate - 1) != sequence)
+            {
+                // Skip faster through data that does not compress
+                position += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            size_t match = candidate - 1;
+            while (position > anchor && match > 0 && source[position - 1] == source[match - 1])
+            {
+                position--;
+                match--;
+            }
+
+            size_t length = MinMatch;
+            while (position + length < matchEnd && source[match + length] == source[position + length])
+            {
+                length++;
+            }
+
+            out = WriteSequence(out, source + anchor, position - anchor, position - match, length);
+            position += length;
+            anchor = position;
+
+            if (position < searchEnd)
+            {
+                table[HashSequence(Read32(source + position - 2))] = static_cast<uint32_t>(position - 1);
+            }
+        }
+    }
+
+    out = WriteSequence(out, source + anchor, sourceSize - anchor, 0, 0);
+    return static_cast<size_t>(out - destination);
+}
+
+bool Lz4Decompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize)
+{
+    size_t in = 0;
+    size_t out = 0;
+    while (true)
+    {
+        if (in >= sourceSize)
+        {
+            return false;
+        }
+        uint8_t token = source[in++];
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(source, sourceSize, in, literalLength))
+        {
+            return false;
+        }
+        if (literalLength > sourceSize - in || literalLength > destinationSize - out)
+        {
+            return false;
+        }
+        std::memcpy(destination + out, source + in, literalLength);
+        in += literalLength;
+        out += literalLength;
+
+        // The last sequence has literals only
+        if (in == sourceSize)
+        {
+            return out == destinationSize;
+        }
+
+        if (sourceSize - in < 2)
+        {
+            return false;
+        }
+        size_t offset = source[in] | (static_cast<size_t>(source[in + 1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > out)
+        {
+            return false;
+        }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(source, sourceSize, in, matchLength))
+        {
+            return false;
+        }
+        matchLength += MinMatch;
+        if (matchLength > destinationSize - out)
+        {
+            return false;
+        }
+
+        uint8_t* target = destination + out;
+        const uint8_t* from = target - offset;
+        if (offset >= matchLength)
+        {
+            std::memcpy(target, from, matchLength);
+        }
+        else
+        {
+            // Overlapping copy repeats the last offset bytes
+            for (size_t i = 0; i < matchLength; ++i)
+            {
+                target[i] = from[i];
+            }
+        }
+        out += matchLength;
+    }
+}
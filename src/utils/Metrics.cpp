@@ -0,0 +1,328 @@
+#include "utils/Metrics.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    const double SummaryQuantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+    void AppendEscaped(std::string& out, const std::string& text, bool escapeQuotes)
+    {
+        for (char ch : text)
+        {
+            switch (ch)
+            {
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '"':
+                    out += escapeQuotes ? "\\\"" : "\"";
+                    break;
+                default: out += ch; break;
+            }
+        }
+    }
+
+    void AppendValue(std::string& out, double value)
+    {
+        if (std::isnan(value))
+        {
+            out += "NaN";
+            return;
+        }
+        if (std::isinf(value))
+        {
+            out += value > 0 ? "+Inf" : "-Inf";
+            return;
+        }
+
+        // Short form unless it loses precision, so 0.1 doesn't print as 0.10000000000000001
+        char buffer[32];
+        int length = std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+        if (std::strtod(buffer, nullptr) != value)
+        {
+            length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        }
+        out.append(buffer, static_cast<size_t>(length));
+    }
+
+    template<typename TEntry>
+    TEntry* FindEntry(std::deque<TEntry>& entries, const std::string& name, const MetricLabels& labels)
+    {
+        for (auto& entry : entries)
+        {
+            if (entry.name == name && entry.labels == labels)
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+}
+
+void MetricGauge::Add(double delta)
+{
+    double current = m_value.load(std::memory_order_relaxed);
+    while (!m_value.compare_exchange_weak(current, current + delta, std::memory_order_relaxed))
+    {
+    }
+}
+
+// MetricsWriter
+
+MetricsWriter::Family& MetricsWriter::GetFamily(const std::string& name, const std::string& help, const char* type)
+{
+    Family& family = m_families[name];
+    if (family.samples.empty())
+    {
+        family.help = help;
+        family.type = type;
+    }
+    return family;
+}
+
+void MetricsWriter::AppendSample(std::string& out, const std::string& name, const MetricLabels& labels, double value,
+                                 const char* extraLabel, const char* extraValue) const
+{
+    out += name;
+
+    bool hasLabels = !m_baseLabels.empty() || !labels.empty() || extraLabel != nullptr;
+    if (hasLabels)
+    {
+        out += '{';
+        bool first = true;
+        auto appendLabel = [&](const std::string& key, const std::string& labelValue)
+        {
+            if (!first)
+            {
+                out += ',';
+            }
+            first = false;
+            out += key;
+            out += "=\"";
+            AppendEscaped(out, labelValue, true);
+            out += '"';
+        };
+
+        for (const auto& label : m_baseLabels)
+        {
+            appendLabel(label.first, label.second);
+        }
+        for (const auto& label : labels)
+        {
+            appendLabel(label.first, label.second);
+        }
+        if (extraLabel != nullptr)
+        {
+            appendLabel(extraLabel, extraValue);
+        }
+        out += '}';
+    }
+
+    out += ' ';
+    AppendValue(out, value);
+    out += '\n';
+}
+
+void MetricsWriter::Counter(const std::string& name, const std::string& help, double value, const MetricLabels& labels)
+{
+    Family& family = GetFamily(name, help, "counter");
+    AppendSample(family.samples, name, labels, value);
+}
+
+void MetricsWriter::Gauge(const std::string& name, const std::string& help, double value, const MetricLabels& labels)
+{
+    Family& family = GetFamily(name, help, "gauge");
+    AppendSample(family.samples, name, labels, value);
+}
+
+void MetricsWriter::Summary(const std::string& name, const std::string& help, const HdrHistogram& values, double scale,
+                            const MetricLabels& labels)
+{
+    Family& family = GetFamily(name, help, "summary");
+
+    for (double quantile : SummaryQuantiles)
+    {
+        char quantileText[16];
+        std::snprintf(quantileText, sizeof(quantileText), "%g", quantile);
+        AppendSample(family.samples, name, labels, values.GetPercentile(quantile * 100.0) * scale, "quantile", quantileText);
+    }
+
+    uint64_t count = values.GetCount();
+    AppendSample(family.samples, name + "_sum", labels, values.GetMean() * static_cast<double>(count) * scale);
+    AppendSample(family.samples, name + "_count", labels, static_cast<double>(count));
+}
+
+void MetricsWriter::Summary(const std::string& name, const std::string& help, const PerThreadHdrHistogram& values, double scale,
+                            const MetricLabels& labels)
+{
+    // Merge once instead of once per quantile
+    HdrHistogram merged;
+    values.MergeInto(merged);
+    Summary(name, help, merged, scale, labels);
+}
+
+std::string MetricsWriter::Render() const
+{
+    std::string out;
+    size_t estimate = 0;
+    for (const auto& [name, family] : m_families)
+    {
+        estimate += family.samples.size() + family.help.size() + 2 * name.size() + 32;
+    }
+    out.reserve(estimate);
+
+    for (const auto& [name, family] : m_families)
+    {
+        out += "# HELP ";
+        out += name;
+        out += ' ';
+        AppendEscaped(out, family.help, false);
+        out += "\n# TYPE ";
+        out += name;
+        out += ' ';
+        out += family.type;
+        out += '\n';
+        out += family.samples;
+    }
+    return out;
+}
+
+// MetricsRegistration
+
+MetricsRegistration& MetricsRegistration::operator=(MetricsRegistration&& other) noexcept
+{
+    if (this != &other)
+    {
+        Reset();
+        m_id = std::exchange(other.m_id, 0);
+    }
+    return *this;
+}
+
+void MetricsRegistration::Reset()
+{
+    if (m_id != 0)
+    {
+        MetricsRegistry::GetInstance().RemoveCollector(m_id);
+        m_id = 0;
+    }
+}
+
+// MetricsRegistry
+
+MetricsRegistry& MetricsRegistry::GetInstance()
+{
+    // Never destroyed, so subsystems torn down during static destruction can
+    // still unregister safely
+    static MetricsRegistry* instance = new MetricsRegistry();
+    return *instance;
+}
+
+MetricCounter& MetricsRegistry::Counter(const std::string& name, const std::string& help, const MetricLabels& labels)
+{
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    if (auto* entry = FindEntry(m_counters, name, labels))
+    {
+        return entry->metric;
+    }
+
+    return m_counters.emplace_back(name, help, labels).metric;
+}
+
+MetricGauge& MetricsRegistry::Gauge(const std::string& name, const std::string& help, const MetricLabels& labels)
+{
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    if (auto* entry = FindEntry(m_gauges, name, labels))
+    {
+        return entry->metric;
+    }
+
+    return m_gauges.emplace_back(name, help, labels).metric;
+}
+
+MetricHistogram& MetricsRegistry::Histogram(const std::string& name, const std::string& help, double exportScale,
+                                            const MetricLabels& labels)
+{
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
+    if (auto* entry = FindEntry(m_histograms, name, labels))
+    {
+        return entry->metric;
+    }
+
+    return m_histograms.emplace_back(name, help, labels, exportScale).metric;
+}
+
+MetricsRegistration MetricsRegistry::AddCollector(const std::string& scope, Collector collector)
+{
+    std::lock_guard<std::mutex> lock(m_collectorsMutex);
+    uint64_t id = m_nextCollectorId++;
+    m_collectors.push_back({ id, scope, std::move(collector) });
+    return MetricsRegistration(id);
+}
+
+void MetricsRegistry::RemoveCollector(uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(m_collectorsMutex);
+    for (auto it = m_collectors.begin(); it != m_collectors.end(); ++it)
+    {
+        if (it->id == id)
+        {
+            m_collectors.erase(it);
+            return;
+        }
+    }
+}
+
+size_t MetricsRegistry::GetCollectorCount() const
+{
+    std::lock_guard<std::mutex> lock(m_collectorsMutex);
+    return m_collectors.size();
+}
+
+std::string MetricsRegistry::Render()
+{
+    MetricsWriter writer;
+
+    {
+        std::lock_guard<std::mutex> lock(m_metricsMutex);
+        for (const auto& entry : m_counters)
+        {
+            writer.Counter(entry.name, entry.help, static_cast<double>(entry.metric.Get()), entry.labels);
+        }
+        for (const auto& entry : m_gauges)
+        {
+            writer.Gauge(entry.name, entry.help, entry.metric.Get(), entry.labels);
+        }
+        for (const auto& entry : m_histograms)
+        {
+            writer.Summary(entry.name, entry.help, entry.metric.GetValues(), entry.metric.GetExportScale(), entry.labels);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_collectorsMutex);
+
+        std::map<std::string, size_t> scopeCounts;
+        for (const auto& collector : m_collectors)
+        {
+            scopeCounts[collector.scope]++;
+        }
+
+        std::map<std::string, size_t> scopeSeen;
+        for (const auto& collector : m_collectors)
+        {
+            if (scopeCounts[collector.scope] > 1)
+            {
+                writer.SetBaseLabels({ { "instance_id", std::to_string(scopeSeen[collector.scope]++) } });
+            }
+            else
+            {
+                writer.SetBaseLabels({});
+            }
+            collector.collect(writer);
+        }
+    }
+
+    return writer.Render();
+}
@@ -0,0 +1,183 @@
+#include "utils/MetricsServer.h"
+#include "utils/Metrics.h"
+#include "utils/Logger.h"
+#include <asio.hpp>
+
+namespace
+{
+    constexpr size_t MaxRequestSize = 8 * 1024;
+    constexpr std::chrono::seconds RequestTimeout{ 5 };
+
+    // One request per connection; the response closes it
+    class MetricsSession : public std::enable_shared_from_this<MetricsSession>
+    {
+    public:
+        MetricsSession(asio::ip::tcp::socket socket, std::atomic<uint64_t>& scrapes)
+            : m_socket(std::move(socket)), m_deadline(m_socket.get_executor()), m_request(MaxRequestSize), m_scrapes(scrapes)
+        {
+        }
+
+        void Start()
+        {
+            auto self = shared_from_this();
+
+            // Drop clients that stall instead of sending a request
+            m_deadline.expires_after(RequestTimeout);
+            m_deadline.async_wait([self](std::error_code ec)
+            {
+                if (!ec)
+                {
+                    std::error_code ignored;
+                    self->m_socket.close(ignored);
+                }
+            });
+
+            asio::async_read_until(m_socket, m_request, "\r\n\r\n",
+                [self](std::error_code ec, std::size_t)
+                {
+                    if (!ec)
+                    {
+                        self->Respond();
+                    }
+                    else
+                    {
+                        self->m_deadline.cancel();
+                    }
+                });
+        }
+
+    private:
+        void Respond()
+        {
+            std::istream stream(&m_request);
+            std::string method;
+            std::string target;
+            stream >> method >> target;
+
+            std::string status = "200 OK";
+            std::string contentType = "text/plain; version=0.0.4; charset=utf-8";
+            if (method != "GET")
+            {
+                status = "405 Method Not Allowed";
+                m_body = "Only GET is supported\n";
+                contentType = "text/plain";
+            }
+            else if (target == "/metrics" || target.rfind("/metrics?", 0) == 0)
+            {
+                m_body = MetricsRegistry::GetInstance().Render();
+                m_scrapes.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                status = "404 Not Found";
+                m_body = "Metrics are served at /metrics\n";
+                contentType = "text/plain";
+            }
+
+            m_header = "HTTP/1.1 " + status + "\r\n"
+                "Content-Type: " + contentType + "\r\n"
+                "Content-Length: " + std::to_string(m_body.size()) + "\r\n"
+                "Connection: close\r\n\r\n";
+
+            auto self = shared_from_this();
+            std::array<asio::const_buffer, 2> buffers = { asio::buffer(m_header), asio::buffer(m_body) };
+            asio::async_write(m_socket, buffers,
+                [self](std::error_code, std::size_t)
+                {
+                    std::error_code ignored;
+                    self->m_socket.shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+                    self->m_socket.close(ignored);
+                    self->m_deadline.cancel();
+                });
+        }
+
+        asio::ip::tcp::socket m_socket;
+        asio::steady_timer m_deadline;
+        asio::streambuf m_request;
+        std::string m_header;
+        std::string m_body;
+        std::atomic<uint64_t>& m_scrapes;
+    };
+}
+
+struct MetricsServer::Impl
+{
+    asio::io_context context;
+    asio::ip::tcp::acceptor acceptor{ context };
+};
+
+MetricsServer::MetricsServer()
+{
+}
+
+MetricsServer::~MetricsServer()
+{
+    Stop();
+}
+
+bool MetricsServer::Start(uint16_t port, const std::string& address)
+{
+    if (IsRunning())
+    {
+        return true;
+    }
+
+    m_impl = std::make_unique<Impl>();
+    try
+    {
+        asio::ip::tcp::endpoint endpoint(asio::ip::make_address(address), port);
+        m_impl->acceptor.open(endpoint.protocol());
+        m_impl->acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+        m_impl->acceptor.bind(endpoint);
+        m_impl->acceptor.listen();
+        m_port = m_impl->acceptor.local_endpoint().port();
+    }
+    catch (std::exception& e)
+    {
+        LOG_ERROR("Metrics endpoint failed to listen on " + address + ":" + std::to_string(port) + ": " + e.what());
+        m_impl.reset();
+        return false;
+    }
+
+    Accept();
+    m_running.store(true, std::memory_order_relaxed);
+    m_thread = std::thread([this]() { m_impl->context.run(); });
+
+    LOG_INFO("Metrics endpoint listening on http://" + address + ":" + std::to_string(m_port) + "/metrics");
+    return true;
+}
+
+void MetricsServer::Stop()
+{
+    if (!m_impl)
+    {
+        return;
+    }
+
+    m_impl->context.stop();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    // Sessions still queued on the context are released with it
+    m_impl.reset();
+    m_running.store(false, std::memory_order_relaxed);
+}
+
+void MetricsServer::Accept()
+{
+    m_impl->acceptor.async_accept(
+        [this](std::error_code ec, asio::ip::tcp::socket socket)
+        {
+            if (!ec)
+            {
+                std::make_shared<MetricsSession>(std::move(socket), m_scrapes)->Start();
+            }
+
+            if (m_impl->acceptor.is_open())
+            {
+                Accept();
+            }
+        });
+}
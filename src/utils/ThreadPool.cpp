@@ -0,0 +1,123 @@
+#include "utils/ThreadPool.h"
+#include <algorithm>
+#include <memory>
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : m_running(true)
+{
+    if (threadCount == 0)
+    {
+        size_t hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    m_workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        m_workers.emplace_back(&ThreadPool::WorkerThread, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPool::Enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    if (m_workers.empty() || chunkCount == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    // Shared so a helper that wakes after the loop has drained can still touch it safely
+    struct Job
+    {
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<size_t> completedChunks{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto job = std::make_shared<Job>();
+
+    auto runChunks = [job, chunkCount, grainSize, count, &body]()
+    {
+        size_t chunk;
+        while ((chunk = job->nextChunk.fetch_add(1)) < chunkCount)
+        {
+            size_t begin = chunk * grainSize;
+            size_t end = std::min(count, begin + grainSize);
+            body(begin, end);
+
+            if (job->completedChunks.fetch_add(1) + 1 == chunkCount)
+            {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                job->finished.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(m_workers.size(), chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        Enqueue(runChunks);
+    }
+
+    // The caller works too instead of just waiting
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock, [&job, chunkCount]() { return job->completedChunks.load() == chunkCount; });
+}
+
+void ThreadPool::WorkerThread()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return !m_running || !m_tasks.empty(); });
+
+            if (!m_running && m_tasks.empty())
+            {
+                return;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+
+        task();
+    }
+}
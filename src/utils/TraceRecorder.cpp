@@ -0,0 +1,396 @@
+#include "utils/TraceRecorder.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    struct ThreadBufferHolder
+    {
+        std::shared_ptr<TraceThreadBuffer> buffer;
+
+        ~ThreadBufferHolder()
+        {
+            if (buffer)
+            {
+                buffer->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local ThreadBufferHolder t_buffer;
+
+    size_t RoundUpPowerOfTwo(size_t value)
+    {
+        size_t result = 64;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    void AppendJsonString(std::string& out, const char* text)
+    {
+        out += '"';
+        for (const char* ch = text; *ch != '\0'; ++ch)
+        {
+            switch (*ch)
+            {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(*ch) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*ch));
+                        out += escaped;
+                    }
+                    else
+                    {
+                        out += *ch;
+                    }
+                    break;
+            }
+        }
+        out += '"';
+    }
+
+    // Chrome expects microseconds; keep nanosecond precision as decimals
+    void AppendMicros(std::string& out, int64_t nanoseconds)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(nanoseconds) / 1000.0);
+        out += buffer;
+    }
+}
+
+std::atomic<bool> TraceRecorder::s_enabled{ false };
+
+TraceThreadBuffer::TraceThreadBuffer(size_t bufferCapacity, uint32_t index)
+    : events(new TraceEvent[bufferCapacity]), capacity(bufferCapacity), mask(bufferCapacity - 1), threadIndex(index),
+      writePos(0), retired(false)
+{
+}
+
+TraceRecorder& TraceRecorder::GetInstance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    WaitForCapture();
+}
+
+void TraceRecorder::SetEnabled(bool enabled)
+{
+    if (enabled && !IsEnabled())
+    {
+        // New session: forget threads that have exited and everything recorded before now
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+            [](const std::shared_ptr<TraceThreadBuffer>& buffer) { return buffer->retired.load(std::memory_order_acquire); }),
+            m_buffers.end());
+        m_sessionStartNs.store(NowNs(), std::memory_order_relaxed);
+    }
+
+    if (s_enabled.exchange(enabled, std::memory_order_relaxed) != enabled)
+    {
+        LOG_INFO(std::string("Tracing ") + (enabled ? "enabled" : "disabled"));
+    }
+}
+
+void TraceRecorder::SetThreadName(const std::string& name)
+{
+    TraceThreadBuffer* buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    buffer->threadName = name;
+}
+
+void TraceRecorder::SetThreadBufferSize(size_t events)
+{
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    m_threadBufferSize = RoundUpPowerOfTwo(events);
+}
+
+void TraceRecorder::Record(const TraceEvent& event)
+{
+    TraceThreadBuffer* buffer = GetThreadBuffer();
+    uint64_t write = buffer->writePos.load(std::memory_order_relaxed);
+    buffer->events[static_cast<size_t>(write) & buffer->mask] = event;
+    buffer->writePos.store(write + 1, std::memory_order_release);
+}
+
+TraceThreadBuffer* TraceRecorder::GetThreadBuffer()
+{
+    TraceThreadBuffer* buffer = t_buffer.buffer.get();
+    if (buffer != nullptr)
+    {
+        return buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    t_buffer.buffer = std::make_shared<TraceThreadBuffer>(m_threadBufferSize, m_nextThreadIndex++);
+    m_buffers.push_back(t_buffer.buffer);
+    return t_buffer.buffer.get();
+}
+
+std::vector<TraceRecorder::ThreadSnapshot> TraceRecorder::Snapshot(int64_t fromNs, int64_t toNs)
+{
+    fromNs = std::max(fromNs, m_sessionStartNs.load(std::memory_order_relaxed));
+
+    std::vector<std::shared_ptr<TraceThreadBuffer>> buffers;
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(m_bufferMutex);
+        buffers = m_buffers;
+        for (const auto& buffer : buffers)
+        {
+            names.push_back(buffer->threadName);
+        }
+    }
+
+    std::vector<ThreadSnapshot> threads;
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        const TraceThreadBuffer& buffer = *buffers[i];
+        bool retired = buffer.retired.load(std::memory_order_acquire);
+        uint64_t end = buffer.writePos.load(std::memory_order_acquire);
+        uint64_t begin = end > buffer.capacity ? end - buffer.capacity : 0;
+
+        std::vector<TraceEvent> copied;
+        copied.reserve(static_cast<size_t>(end - begin));
+        for (uint64_t pos = begin; pos < end; ++pos)
+        {
+            copied.push_back(buffer.events[static_cast<size_t>(pos) & buffer.mask]);
+        }
+
+        // A live owner kept writing while we copied; anything it may have lapped
+        // (including the slot it is writing now) is unreliable
+        uint64_t firstValid = begin;
+        if (!retired)
+        {
+            uint64_t after = buffer.writePos.load(std::memory_order_acquire);
+            firstValid = after >= buffer.capacity ? after - buffer.capacity + 1 : 0;
+        }
+
+        ThreadSnapshot snapshot{ buffer.threadIndex, names[i], {} };
+        for (uint64_t pos = begin; pos < end; ++pos)
+        {
+            const TraceEvent& event = copied[static_cast<size_t>(pos - begin)];
+            if (pos >= firstValid && event.startNs <= toNs && event.startNs + event.durationNs >= fromNs)
+            {
+                snapshot.events.push_back(event);
+            }
+        }
+
+        if (!snapshot.events.empty() || !snapshot.threadName.empty())
+        {
+            threads.push_back(std::move(snapshot));
+        }
+    }
+    return threads;
+}
+
+std::string TraceRecorder::FormatJson(const std::vector<ThreadSnapshot>& threads)
+{
+    // Timestamps are relative to the earliest span so the viewer opens at zero
+    int64_t originNs = std::numeric_limits<int64_t>::max();
+    size_t eventCount = 0;
+    for (const auto& thread : threads)
+    {
+        for (const auto& event : thread.events)
+        {
+            originNs = std::min(originNs, event.startNs);
+        }
+        eventCount += thread.events.size();
+    }
+    if (eventCount == 0)
+    {
+        originNs = 0;
+    }
+
+    std::string out;
+    out.reserve(128 + eventCount * 128);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Witcher3-MP\"}}";
+
+    for (const auto& thread : threads)
+    {
+        std::string tid = std::to_string(thread.threadIndex);
+        std::string name = thread.threadName.empty() ? "thread " + tid : thread.threadName;
+
+        out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":";
+        AppendJsonString(out, name.c_str());
+        out += "}}";
+
+        for (const auto& event : thread.events)
+        {
+            out += ",\n{\"name\":";
+            AppendJsonString(out, event.name);
+            out += ",\"cat\":";
+            AppendJsonString(out, event.category != nullptr ? event.category : "");
+            out += ",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":";
+            AppendMicros(out, event.startNs - originNs);
+            out += ",\"dur\":";
+            AppendMicros(out, event.durationNs);
+            if (event.argName != nullptr)
+            {
+                out += ",\"args\":{";
+                AppendJsonString(out, event.argName);
+                out += ':' + std::to_string(event.argValue) + '}';
+            }
+            out += '}';
+        }
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+std::string TraceRecorder::ToJson(int64_t fromNs, int64_t toNs)
+{
+    return FormatJson(Snapshot(fromNs, toNs));
+}
+
+bool TraceRecorder::WriteFile(const std::string& filename, const std::string& contents)
+{
+    std::filesystem::path filePath(filename);
+    std::error_code ec;
+    if (filePath.has_parent_path())
+    {
+        std::filesystem::create_directories(filePath.parent_path(), ec);
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        LOG_ERROR("Failed to open trace file: " + filename);
+        return false;
+    }
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    return file.good();
+}
+
+bool TraceRecorder::DumpToFile(const std::string& filename)
+{
+    if (!WriteFile(filename, ToJson()))
+    {
+        return false;
+    }
+    LOG_INFO("Trace written to " + filename);
+    return true;
+}
+
+void TraceRecorder::SetSlowTickCapture(std::chrono::microseconds threshold, const std::string& directory,
+                                       std::chrono::milliseconds preWindow, std::chrono::milliseconds postWindow,
+                                       std::chrono::milliseconds cooldown)
+{
+    std::lock_guard<std::mutex> lock(m_captureMutex);
+    m_slowTickThreshold = threshold;
+    m_captureDirectory = directory;
+    m_preWindow = preWindow;
+    m_postWindow = postWindow;
+    m_cooldown = cooldown;
+    m_capturePending = false;
+}
+
+std::chrono::microseconds TraceRecorder::GetSlowTickThreshold() const
+{
+    std::lock_guard<std::mutex> lock(m_captureMutex);
+    return m_slowTickThreshold;
+}
+
+void TraceRecorder::OnTick(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+    int64_t endNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end.time_since_epoch()).count();
+
+    std::unique_lock<std::mutex> lock(m_captureMutex);
+    if (m_slowTickThreshold.count() <= 0)
+    {
+        return;
+    }
+
+    if (m_capturePending)
+    {
+        if (endNs < m_pendingUntilNs)
+        {
+            return;
+        }
+
+        // Post-window has elapsed: copy the spans here, format and write elsewhere
+        m_capturePending = false;
+        int64_t fromNs = m_pendingFromNs;
+        int64_t untilNs = m_pendingUntilNs;
+        int64_t tickNs = m_pendingTickNs;
+        std::string directory = m_captureDirectory;
+        lock.unlock();
+
+        std::vector<ThreadSnapshot> threads = Snapshot(fromNs, untilNs);
+
+        auto now = std::chrono::system_clock::now();
+        auto time_t = std::chrono::system_clock::to_time_t(now);
+        std::tm timeinfo;
+        localtime_s(&timeinfo, &time_t);
+        std::stringstream ss;
+        ss << directory << "/slow_tick_" << std::put_time(&timeinfo, "%Y%m%d_%H%M%S") << "_"
+           << (tickNs / 1000000) << "ms.json";
+        std::string path = ss.str();
+
+        WaitForCapture();
+        m_captureThread = std::thread([this, threads = std::move(threads), path, tickNs]()
+        {
+            if (WriteFile(path, FormatJson(threads)))
+            {
+                {
+                    std::lock_guard<std::mutex> captureLock(m_captureMutex);
+                    m_lastCapturePath = path;
+                }
+                m_captureCount.fetch_add(1, std::memory_order_relaxed);
+                LOG_WARNING("Slow tick (" + std::to_string(tickNs / 1000) + "us) trace written to " + path);
+            }
+        });
+        return;
+    }
+
+    int64_t tickNs = endNs - startNs;
+    int64_t thresholdNs = std::chrono::duration_cast<std::chrono::nanoseconds>(m_slowTickThreshold).count();
+    int64_t cooldownNs = std::chrono::duration_cast<std::chrono::nanoseconds>(m_cooldown).count();
+    if (tickNs > thresholdNs && (m_lastCaptureNs == std::numeric_limits<int64_t>::min() || endNs - m_lastCaptureNs >= cooldownNs))
+    {
+        m_capturePending = true;
+        m_pendingFromNs = startNs - std::chrono::duration_cast<std::chrono::nanoseconds>(m_preWindow).count();
+        m_pendingUntilNs = endNs + std::chrono::duration_cast<std::chrono::nanoseconds>(m_postWindow).count();
+        m_pendingTickNs = tickNs;
+        m_lastCaptureNs = endNs;
+    }
+}
+
+std::string TraceRecorder::GetLastCapturePath() const
+{
+    std::lock_guard<std::mutex> lock(m_captureMutex);
+    return m_lastCapturePath;
+}
+
+void TraceRecorder::WaitForCapture()
+{
+    if (m_captureThread.joinable())
+    {
+        m_captureThread.join();
+    }
+}
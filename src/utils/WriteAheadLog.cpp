@@ -0,0 +1,455 @@
+#include "utils/WriteAheadLog.h"
+#include "utils/DurableFile.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // File: magic, version, sequence of the last truncated record.
+    // Frame: payload size, CRC-32 of sequence + payload, sequence, payload.
+    constexpr uint8_t FileMagic[4] = { 'T', 'W', '3', 'J' };
+    constexpr uint32_t FileVersion = 1;
+    constexpr size_t HeaderSize = 16;
+    constexpr size_t FrameHeaderSize = 16;
+
+    void Put32(uint8_t* out, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    void Put64(uint8_t* out, uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    uint32_t Get32(const uint8_t* in)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            value |= static_cast<uint32_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t Get64(const uint8_t* in)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            value |= static_cast<uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    uint32_t Crc32(uint32_t crc, const uint8_t* data, size_t size)
+    {
+        static const std::array<uint32_t, 256> table = []
+        {
+            std::array<uint32_t, 256> entries{};
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                }
+                entries[i] = value;
+            }
+            return entries;
+        }();
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+        {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    uint32_t FrameChecksum(const uint8_t* sequenceBytes, const uint8_t* payload, size_t size)
+    {
+        return Crc32(Crc32(0, sequenceBytes, 8), payload, size);
+    }
+
+    // Checks the frame at position; false at the end of the intact records
+    bool ParseFrame(const std::vector<uint8_t>& file, size_t position, uint64_t expectedSequence,
+                    const uint8_t*& payload, size_t& payloadSize)
+    {
+        if (file.size() - position < FrameHeaderSize)
+        {
+            return false;
+        }
+
+        const uint8_t* frame = file.data() + position;
+        payloadSize = Get32(frame);
+        if (file.size() - position - FrameHeaderSize < payloadSize || Get64(frame + 8) != expectedSequence)
+        {
+            return false;
+        }
+
+        payload = frame + FrameHeaderSize;
+        return Get32(frame + 4) == FrameChecksum(frame + 8, payload, payloadSize);
+    }
+
+    bool WriteHeader(FILE* file, uint64_t baseSequence)
+    {
+        uint8_t header[HeaderSize];
+        std::memcpy(header, FileMagic, sizeof(FileMagic));
+        Put32(header + 4, FileVersion);
+        Put64(header + 8, baseSequence);
+        return std::fwrite(header, 1, sizeof(header), file) == sizeof(header) && std::fflush(file) == 0;
+    }
+
+    bool SyncFile(FILE* file)
+    {
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    Close();
+}
+
+bool WriteAheadLog::Open(const std::string& path, const WriteAheadLogOptions& options, const ReplayCallback& replay)
+{
+    Close();
+
+    std::vector<uint8_t> contents;
+    uint64_t baseSequence = 0;
+    size_t validSize = HeaderSize;
+    uint64_t lastSequence = 0;
+    uint64_t replayed = 0;
+
+    if (ReadWholeFile(path, contents) && contents.size() >= HeaderSize)
+    {
+        if (std::memcmp(contents.data(), FileMagic, sizeof(FileMagic)) != 0 || Get32(contents.data() + 4) != FileVersion)
+        {
+            return false;
+        }
+
+        baseSequence = Get64(contents.data() + 8);
+        lastSequence = baseSequence;
+
+        const uint8_t* payload = nullptr;
+        size_t payloadSize = 0;
+        while (ParseFrame(contents, validSize, lastSequence + 1, payload, payloadSize))
+        {
+            ++lastSequence;
+            ++replayed;
+            if (replay)
+            {
+                replay(lastSequence, payload, payloadSize);
+            }
+            validSize += FrameHeaderSize + payloadSize;
+        }
+    }
+    else
+    {
+        // Missing, or cut off before its header was complete
+        contents.clear();
+        FILE* created = std::fopen(path.c_str(), "wb");
+        bool written = created && WriteHeader(created, 0) && SyncFile(created);
+        if (created)
+        {
+            written = (std::fclose(created) == 0) && written;
+        }
+        if (!written)
+        {
+            return false;
+        }
+    }
+
+    // Everything after the last intact frame is a write the crash interrupted
+    std::error_code ec;
+    if (contents.size() > validSize)
+    {
+        std::filesystem::resize_file(path, validSize, ec);
+        if (ec)
+        {
+            return false;
+        }
+    }
+
+    FILE* file = std::fopen(path.c_str(), "ab");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_path = path;
+    m_options = options;
+    m_file = file;
+    m_fileSize = validSize;
+    m_lastSequence = lastSequence;
+    m_durableSequence = lastSequence;
+    m_pendingRecords = 0;
+    m_commitRequested = false;
+    m_stopRequested = false;
+    m_committing = false;
+    m_failed = false;
+    m_stats = WriteAheadLogStats();
+    m_stats.recordsReplayed = replayed;
+    m_stats.tailBytesDiscarded = contents.size() > validSize ? contents.size() - validSize : 0;
+    m_commitThread = std::thread(&WriteAheadLog::CommitThread, this);
+    return true;
+}
+
+void WriteAheadLog::Close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_file)
+        {
+            return;
+        }
+        m_stopRequested = true;
+    }
+    m_commitCondition.notify_all();
+
+    // The commit thread makes the last batch durable before it exits
+    if (m_commitThread.joinable())
+    {
+        m_commitThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::fclose(m_file);
+    m_file = nullptr;
+    m_durableCondition.notify_all();
+}
+
+bool WriteAheadLog::IsOpen() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_file != nullptr;
+}
+
+uint64_t WriteAheadLog::Append(const void* data, size_t size)
+{
+    if (size > UINT32_MAX)
+    {
+        return 0;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_file || m_failed || m_stopRequested)
+    {
+        return 0;
+    }
+
+    uint64_t sequence = m_lastSequence + 1;
+    const uint8_t* payload = static_cast<const uint8_t*>(data);
+    uint8_t frame[FrameHeaderSize];
+    Put32(frame, static_cast<uint32_t>(size));
+    Put64(frame + 8, sequence);
+    Put32(frame + 4, FrameChecksum(frame + 8, payload, size));
+
+    if (std::fwrite(frame, 1, sizeof(frame), m_file) != sizeof(frame) ||
+        (size > 0 && std::fwrite(payload, 1, size, m_file) != size))
+    {
+        // A partial frame on disk is dropped as a torn tail on the next Open
+        m_failed = true;
+        m_durableCondition.notify_all();
+        return 0;
+    }
+
+    m_lastSequence = sequence;
+    m_fileSize += sizeof(frame) + size;
+    m_stats.recordsAppended++;
+    m_stats.bytesAppended += sizeof(frame) + size;
+    if (++m_pendingRecords >= m_options.commitRecords)
+    {
+        m_commitRequested = true;
+        lock.unlock();
+        m_commitCondition.notify_one();
+    }
+    return sequence;
+}
+
+bool WriteAheadLog::WaitDurable(uint64_t sequence)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (sequence > m_durableSequence && !m_commitRequested)
+    {
+        // Waiters that arrive while a commit runs share the next one
+        m_commitRequested = true;
+        m_commitCondition.notify_one();
+    }
+    m_durableCondition.wait(lock, [&]
+    {
+        return m_durableSequence >= sequence || m_failed || !m_file;
+    });
+    return m_durableSequence >= sequence;
+}
+
+bool WriteAheadLog::Sync()
+{
+    uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_file)
+        {
+            return false;
+        }
+        sequence = m_lastSequence;
+    }
+    return WaitDurable(sequence);
+}
+
+bool WriteAheadLog::Truncate(uint64_t throughSequence)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_durableCondition.wait(lock, [&] { return !m_committing; });
+    if (!m_file || m_failed)
+    {
+        return false;
+    }
+
+    std::fflush(m_file);
+    std::vector<uint8_t> contents;
+    if (!ReadWholeFile(m_path, contents) || contents.size() < HeaderSize)
+    {
+        return false;
+    }
+
+    uint64_t baseSequence = Get64(contents.data() + 8);
+    throughSequence = std::min(throughSequence, m_lastSequence);
+    if (throughSequence <= baseSequence)
+    {
+        return true;
+    }
+
+    // Keep the frames after throughSequence under a new base
+    std::vector<uint8_t> kept(HeaderSize);
+    std::memcpy(kept.data(), FileMagic, sizeof(FileMagic));
+    Put32(kept.data() + 4, FileVersion);
+    Put64(kept.data() + 8, throughSequence);
+
+    size_t position = HeaderSize;
+    uint64_t sequence = baseSequence;
+    const uint8_t* payload = nullptr;
+    size_t payloadSize = 0;
+    while (ParseFrame(contents, position, sequence + 1, payload, payloadSize))
+    {
+        ++sequence;
+        size_t frameSize = FrameHeaderSize + payloadSize;
+        if (sequence > throughSequence)
+        {
+            kept.insert(kept.end(), contents.begin() + position, contents.begin() + position + frameSize);
+        }
+        position += frameSize;
+    }
+
+    // Windows cannot rename over a file that is still open
+    std::fclose(m_file);
+    m_file = nullptr;
+    bool rewritten = WriteFileDurably(m_path, kept);
+
+    m_file = std::fopen(m_path.c_str(), "ab");
+    if (!m_file)
+    {
+        m_failed = true;
+        m_durableCondition.notify_all();
+        return false;
+    }
+
+    if (rewritten)
+    {
+        // The new file was synced whole, so the kept records are durable too
+        m_fileSize = kept.size();
+        m_durableSequence = m_lastSequence;
+        m_pendingRecords = 0;
+        m_durableCondition.notify_all();
+    }
+    return rewritten;
+}
+
+uint64_t WriteAheadLog::GetLastSequence() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastSequence;
+}
+
+uint64_t WriteAheadLog::GetDurableSequence() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_durableSequence;
+}
+
+size_t WriteAheadLog::GetFileSize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fileSize;
+}
+
+WriteAheadLogStats WriteAheadLog::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void WriteAheadLog::CommitThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_commitCondition.wait_for(lock, m_options.commitInterval, [&]
+        {
+            return m_commitRequested || m_stopRequested;
+        });
+        m_commitRequested = false;
+
+        if (m_pendingRecords > 0 && !m_failed)
+        {
+            uint64_t target = m_lastSequence;
+            m_pendingRecords = 0;
+            m_committing = true;
+
+            // Appends carry on into the stdio buffer while this batch syncs
+            bool synced = std::fflush(m_file) == 0;
+            FILE* file = m_file;
+            lock.unlock();
+            synced = synced && SyncFile(file);
+            lock.lock();
+
+            m_committing = false;
+            if (synced)
+            {
+                m_durableSequence = std::max(m_durableSequence, target);
+                m_stats.commits++;
+            }
+            else
+            {
+                m_failed = true;
+            }
+            m_durableCondition.notify_all();
+        }
+
+        if (m_stopRequested && (m_pendingRecords == 0 || m_failed))
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "utils/BinaryLog.h"
+#include "utils/Logger.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::string TestLogPath(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::vector<BinaryLogRecord> ReadLog(const std::string& path, uint64_t& dropped)
+    {
+        std::ifstream input(path, std::ios::binary);
+        std::vector<BinaryLogRecord> records;
+        std::string error;
+        REQUIRE(BinaryLogReader::Read(input, records, dropped, error));
+        return records;
+    }
+}
+
+TEST_CASE("BinaryLog - Round Trip", "[utils][logging][binarylog]")
+{
+    Logger::GetInstance().SetLogLevel(LogLevel::DEBUG);
+    std::string path = TestLogPath("tw3_binary_log_roundtrip.blog");
+    REQUIRE(Logger::GetInstance().SetBinaryLogging(true, path));
+    REQUIRE(BinaryLog::IsActive());
+
+    std::string peer = "peer-7";
+    LOG_INFOF("Sent {} bytes to {} (ok={}, ratio {})", size_t(1200), peer, true, 0.5f);
+    LOG_WARNINGF_CAT(LogCategory::NETWORK, "Escaped {{braces}} and {} {}", -3, 'x');
+    LOG_DEBUGF("Long {}", std::string(BinaryLog::MaxStringLength + 100, 'a'));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t)
+    {
+        threads.emplace_back([t]()
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                LOG_INFOF_CAT(LogCategory::COMBAT, "thread {} entry {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(Logger::GetInstance().SetBinaryLogging(false));
+    REQUIRE_FALSE(BinaryLog::IsActive());
+    Logger::GetInstance().SetLogLevel(LogLevel::INFO);
+
+    uint64_t dropped = 0;
+    std::vector<BinaryLogRecord> records = ReadLog(path, dropped);
+    REQUIRE(dropped == 0);
+    REQUIRE(records.size() == 303);
+
+    REQUIRE(records[0].message == "Sent 1200 bytes to peer-7 (ok=true, ratio " + std::to_string(0.5) + ")");
+    REQUIRE(records[0].level == LogLevel::INFO);
+    REQUIRE(records[0].category == LogCategory::GENERAL);
+    REQUIRE(records[1].message == "Escaped {braces} and -3 x");
+    REQUIRE(records[1].category == LogCategory::NETWORK);
+    REQUIRE(records[2].message == "Long " + std::string(BinaryLog::MaxStringLength, 'a'));
+
+    // Records are merged by timestamp; each thread keeps its own order
+    std::vector<int> next(3, 0);
+    for (size_t i = 3; i < records.size(); ++i)
+    {
+        REQUIRE(records[i - 1].wallTimeNs <= records[i].wallTimeNs);
+        int thread = records[i].message[7] - '0';
+        REQUIRE(records[i].message == "thread " + std::to_string(thread) + " entry " + std::to_string(next[thread]));
+        next[thread]++;
+    }
+
+    std::string text = BinaryLogReader::FormatRecord(records[1]);
+    REQUIRE(text.find("[WARNING] [NETWORK] [") != std::string::npos);
+    REQUIRE(text.find("Escaped {braces} and -3 x") != std::string::npos);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("BinaryLog - Full Buffer Drops", "[utils][logging][binarylog]")
+{
+    std::string path = TestLogPath("tw3_binary_log_drops.blog");
+
+    // Tiny per-thread ring and no periodic drain, so a burst must overflow
+    REQUIRE(BinaryLog::GetInstance().Start(path, 64, std::chrono::milliseconds(10000)));
+    std::thread producer([]()
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            LOG_INFOF("burst {}", i);
+        }
+    });
+    producer.join();
+    BinaryLog::GetInstance().Stop();
+    REQUIRE(BinaryLog::GetInstance().GetDroppedRecords() > 0);
+
+    uint64_t dropped = 0;
+    std::vector<BinaryLogRecord> records = ReadLog(path, dropped);
+    REQUIRE(dropped == BinaryLog::GetInstance().GetDroppedRecords());
+    REQUIRE(records.size() + dropped == 100);
+    REQUIRE(records[0].message == "burst 0");
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("BinaryLog - Rejects Other Files", "[utils][logging][binarylog]")
+{
+    std::istringstream input("not a log");
+    std::vector<BinaryLogRecord> records;
+    uint64_t dropped = 0;
+    std::string error;
+    REQUIRE_FALSE(BinaryLogReader::Read(input, records, dropped, error));
+    REQUIRE_FALSE(error.empty());
+}
+
+TEST_CASE("BinaryLog - Call Cost", "[utils][logging][binarylog][!benchmark]")
+{
+    std::string path = TestLogPath("tw3_binary_log_bench.blog");
+    REQUIRE(BinaryLog::GetInstance().Start(path, 1 << 22, std::chrono::milliseconds(1)));
+
+    uint64_t counter = 0;
+    BENCHMARK("binary LOG_INFOF, three arguments")
+    {
+        ++counter;
+        LOG_INFOF("Message {} queued ({} bytes, type {})", counter, 64, 3);
+    };
+
+    BinaryLog::GetInstance().Stop();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,354 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "utils/ChunkStore.h"
+#include "utils/Lz4Block.h"
+#include "utils/ThreadPool.h"
+#include "game/SharedSaveSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+
+using namespace Game;
+
+namespace
+{
+    std::vector<uint8_t> RandomBytes(size_t size, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> bytes(size);
+        for (auto& byte : bytes)
+        {
+            byte = static_cast<uint8_t>(rng());
+        }
+        return bytes;
+    }
+
+    // Text-like records with random numbers; LZ4 gets them to about 60%
+    std::vector<uint8_t> RecordLikeBytes(size_t size, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> bytes;
+        bytes.reserve(size + 64);
+        while (bytes.size() < size)
+        {
+            std::string record = "npc_" + std::to_string(rng() % 100000) + ":hp=" + std::to_string(rng() % 1000) +
+                                 ",x=" + std::to_string(rng() % 4096) + ";";
+            bytes.insert(bytes.end(), record.begin(), record.end());
+        }
+        bytes.resize(size);
+        return bytes;
+    }
+
+    ChunkHashSet HashesOf(const std::vector<ChunkRef>& refs)
+    {
+        ChunkHashSet hashes;
+        for (const auto& ref : refs)
+        {
+            hashes.insert(ref.hash);
+        }
+        return hashes;
+    }
+
+    WorldSaveData MakeWorld(uint32_t monsterCount)
+    {
+        WorldSaveData world;
+        world.worldId = 5;
+        world.worldName = "Skellige";
+        for (uint32_t i = 1; i <= monsterCount; ++i)
+        {
+            MonsterAIData monster;
+            monster.monsterId = i;
+            monster.monsterName = "Siren " + std::to_string(i);
+            monster.position = Vector4F(i * 2.0f, i * 0.5f, 3.0f, 1.0f);
+            monster.health = 50.0f + (i % 30);
+            world.monsters[i] = monster;
+        }
+        return world;
+    }
+}
+
+TEST_CASE("Chunk Store - Boundaries", "[utils][saves]")
+{
+    std::vector<uint8_t> data = RandomBytes(512 * 1024, 1);
+    std::vector<size_t> boundaries = ChunkStore::FindBoundaries(data.data(), data.size());
+
+    SECTION("Chunks cover the data within the size limits")
+    {
+        REQUIRE(boundaries.back() == data.size());
+        size_t start = 0;
+        for (size_t i = 0; i < boundaries.size(); ++i)
+        {
+            size_t size = boundaries[i] - start;
+            REQUIRE(size <= ChunkStore::MaxChunkSize);
+            if (i + 1 < boundaries.size())
+            {
+                REQUIRE(size > ChunkStore::MinChunkSize);
+            }
+            start = boundaries[i];
+        }
+        REQUIRE(boundaries == ChunkStore::FindBoundaries(data.data(), data.size()));
+    }
+
+    SECTION("An insertion only changes the chunks around it")
+    {
+        std::vector<uint8_t> edited = data;
+        edited.insert(edited.begin() + data.size() / 2, { 1, 2, 3, 4, 5, 6, 7 });
+
+        std::vector<size_t> editedBoundaries = ChunkStore::FindBoundaries(edited.data(), edited.size());
+        size_t shared = 0;
+        for (size_t end : editedBoundaries)
+        {
+            bool before = std::find(boundaries.begin(), boundaries.end(), end) != boundaries.end();
+            bool after = end > data.size() / 2 &&
+                std::find(boundaries.begin(), boundaries.end(), end - 7) != boundaries.end();
+            shared += (before || after) ? 1 : 0;
+        }
+        REQUIRE(shared + 2 >= editedBoundaries.size());
+    }
+}
+
+TEST_CASE("Chunk Store - Storage", "[utils][saves]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_chunk_test";
+    std::filesystem::remove_all(directory);
+
+    ChunkStore store;
+    REQUIRE(store.Open(directory.string()));
+
+    std::vector<uint8_t> data = RandomBytes(256 * 1024, 2);
+    std::vector<ChunkRef> refs;
+    REQUIRE(store.Store(data, refs));
+    REQUIRE(store.GetStats().chunksWritten == refs.size());
+
+    SECTION("Storing the same data again writes nothing")
+    {
+        std::vector<ChunkRef> again;
+        REQUIRE(store.Store(data, again));
+        REQUIRE(store.GetStats().chunksWritten == refs.size());
+        REQUIRE(store.GetStats().chunksReused == refs.size());
+
+        std::vector<uint8_t> loaded;
+        REQUIRE(store.Load(again, loaded));
+        REQUIRE(loaded == data);
+    }
+
+    SECTION("Reopening indexes the chunks on disk")
+    {
+        ChunkStore reopened;
+        REQUIRE(reopened.Open(directory.string()));
+        REQUIRE(reopened.GetChunkCount() == store.GetChunkCount());
+    }
+
+    SECTION("Damaged chunks fail to load")
+    {
+        std::string hex = refs[0].hash.ToHex();
+        std::filesystem::path chunkPath = directory / hex.substr(0, 2) / hex;
+        std::filesystem::resize_file(chunkPath, refs[0].size - 1);
+
+        std::vector<uint8_t> loaded;
+        REQUIRE_FALSE(store.Load(refs, loaded));
+    }
+
+    SECTION("Only unreferenced chunks are removed")
+    {
+        std::vector<uint8_t> other = RandomBytes(64 * 1024, 3);
+        std::vector<ChunkRef> otherRefs;
+        REQUIRE(store.Store(other, otherRefs));
+
+        size_t removed = store.RemoveUnreferenced(HashesOf(refs));
+        REQUIRE(removed == HashesOf(otherRefs).size());
+        REQUIRE(store.GetChunkCount() == HashesOf(refs).size());
+
+        std::vector<uint8_t> loaded;
+        REQUIRE(store.Load(refs, loaded));
+        REQUIRE_FALSE(store.Load(otherRefs, loaded));
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Chunk Store - Compression", "[utils][saves]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_chunk_compression_test";
+    std::filesystem::remove_all(directory);
+
+    ThreadPool pool(3);
+    ChunkStore store;
+    REQUIRE(store.Open(directory.string()));
+    store.SetThreadPool(&pool);
+
+    std::vector<uint8_t> data = RecordLikeBytes(2 * 1024 * 1024, 4);
+    std::vector<ChunkRef> refs;
+    REQUIRE(store.Store(data, refs, true));
+
+    ChunkStoreStats stats = store.GetStats();
+    REQUIRE(stats.bytesWritten == data.size());
+    REQUIRE(stats.bytesStored < data.size() * 3 / 4);
+
+    SECTION("Compressed chunks load in parallel")
+    {
+        std::vector<uint8_t> loaded;
+        REQUIRE(store.Load(refs, loaded));
+        REQUIRE(loaded == data);
+    }
+
+    SECTION("Recoding keeps the chunks readable under the same hashes")
+    {
+        REQUIRE(store.Recode(refs, false));
+        std::string hex = refs[0].hash.ToHex();
+        REQUIRE(std::filesystem::file_size(directory / hex.substr(0, 2) / hex) == refs[0].size);
+
+        std::vector<uint8_t> loaded;
+        REQUIRE(store.Load(refs, loaded));
+        REQUIRE(loaded == data);
+
+        REQUIRE(store.Recode(refs, true));
+        REQUIRE(store.Load(refs, loaded));
+        REQUIRE(loaded == data);
+    }
+
+    SECTION("Damaged compressed chunks fail to load")
+    {
+        std::string hex = refs[1].hash.ToHex();
+        std::filesystem::path chunkPath = directory / hex.substr(0, 2) / hex;
+        std::filesystem::resize_file(chunkPath, std::filesystem::file_size(chunkPath) - 3);
+
+        std::vector<uint8_t> loaded;
+        REQUIRE_FALSE(store.Load(refs, loaded));
+    }
+
+    store.SetThreadPool(nullptr);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Shared Save System - Chunked Saves", "[game][saves]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_chunked_save_test";
+    std::filesystem::remove_all(directory);
+
+    SharedSaveSystem saves;
+    REQUIRE(saves.Initialize(directory.string()));
+    saves.SetMaxBackups(2);
+
+    WorldSaveData world = MakeWorld(5000);
+    REQUIRE(saves.SaveWorldData(5, world));
+    uint64_t firstChunks = saves.GetStats().chunksWritten;
+    REQUIRE(firstChunks > 4);
+
+    // One monster moving rewrites only the chunks holding it
+    world.monsters[2500].position = Vector4F(-1.0f, -1.0f, -1.0f, 1.0f);
+    REQUIRE(saves.SaveWorldData(5, world));
+    SaveStats stats = saves.GetStats();
+    REQUIRE(stats.chunksWritten - firstChunks <= 2);
+    REQUIRE(stats.chunksReused >= firstChunks - 2);
+
+    std::vector<SaveMetadata> available = saves.GetAvailableSaves();
+    REQUIRE(available.size() == 2);
+    uint32_t firstSave = available[0].saveId;
+
+    SECTION("Backups share the save's chunks and are pruned past the limit")
+    {
+        uint64_t written = saves.GetStats().chunksWritten;
+        REQUIRE(saves.CreateBackup(firstSave));
+        REQUIRE(saves.CreateBackup(firstSave));
+        REQUIRE(saves.CreateBackup(firstSave));
+        REQUIRE(saves.GetStats().chunksWritten == written);
+
+        std::vector<SaveMetadata> backups = saves.GetBackups(firstSave);
+        REQUIRE(backups.size() == 2);
+
+        // Restoring reads the chunks through the backup's manifest
+        REQUIRE(saves.RestoreFromBackup(firstSave, backups.back().saveId));
+        WorldSaveData loaded;
+        REQUIRE(saves.LoadWorldData(5, loaded));
+        REQUIRE(loaded.monsters.size() == 5000);
+        REQUIRE(loaded.monsters[2500].position.x == 5000.0f);
+    }
+
+    SECTION("Existing saves can be recompressed in place")
+    {
+        REQUIRE(saves.DecompressSaveData(firstSave));
+        REQUIRE(saves.CompressSaveData(firstSave));
+
+        WorldSaveData loaded;
+        REQUIRE(saves.LoadWorldData(5, loaded));
+        REQUIRE(loaded.monsters.size() == 5000);
+    }
+
+    SECTION("Chunks no save references any more are collected")
+    {
+        REQUIRE(saves.DeleteSave(firstSave));
+        saves.FlushPendingSaves();
+        REQUIRE(saves.GetStats().chunksCollected >= 1);
+
+        WorldSaveData loaded;
+        REQUIRE(saves.LoadWorldData(5, loaded));
+        REQUIRE(loaded.monsters[2500].position.x == -1.0f);
+    }
+
+    saves.Shutdown();
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Chunk Store - Parallel Throughput", "[utils][saves][!benchmark]")
+{
+    // A multi-hundred-MB world state, stored compressed into an empty store
+    // with growing worker counts; each pass writes every chunk
+    std::vector<uint8_t> data = RecordLikeBytes(256 * 1024 * 1024, 5);
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_chunk_throughput_test";
+
+    std::vector<size_t> workerCounts = { 0, 1, 3 };
+    size_t hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads > 4)
+    {
+        workerCounts.push_back(hardwareThreads - 1);
+    }
+
+    for (size_t workers : workerCounts)
+    {
+        std::filesystem::remove_all(directory);
+        std::unique_ptr<ThreadPool> pool = workers > 0 ? std::make_unique<ThreadPool>(workers) : nullptr;
+        ChunkStore store;
+        REQUIRE(store.Open(directory.string()));
+        store.SetThreadPool(pool.get());
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<ChunkRef> refs;
+        REQUIRE(store.Store(data, refs, true));
+        std::chrono::duration<double> storeTime = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        std::vector<uint8_t> loaded;
+        REQUIRE(store.Load(refs, loaded));
+        std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() - start;
+        REQUIRE(loaded.size() == data.size());
+
+        double megabytes = data.size() / (1024.0 * 1024.0);
+        std::cout << "256 MB save, " << workers << " workers + caller: store " << megabytes / storeTime.count()
+                  << " MB/s, load " << megabytes / loadTime.count() << " MB/s, ratio "
+                  << static_cast<double>(store.GetStats().bytesStored) / data.size() << std::endl;
+    }
+
+    std::vector<uint8_t> sample = RecordLikeBytes(ChunkStore::MaxChunkSize, 6);
+    std::vector<uint8_t> compressed(Lz4CompressBound(sample.size()));
+    size_t compressedSize = Lz4Compress(sample.data(), sample.size(), compressed.data(), compressed.size());
+
+    BENCHMARK("LZ4 compress, 64 KiB chunk")
+    {
+        return Lz4Compress(sample.data(), sample.size(), compressed.data(), compressed.size());
+    };
+
+    BENCHMARK("LZ4 decompress, 64 KiB chunk")
+    {
+        return Lz4Decompress(compressed.data(), compressedSize, sample.data(), sample.size());
+    };
+
+    BENCHMARK("chunk hash, 64 KiB")
+    {
+        return ChunkStore::Hash(sample.data(), sample.size()).low;
+    };
+
+    std::filesystem::remove_all(directory);
+}
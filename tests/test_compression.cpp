@@ -2,6 +2,8 @@
 #include <vector>
 #include <string>
 #include "optimization/DataCompression.h"
+#include "utils/Lz4Block.h"
+#include <random>
 
 TEST_CASE("DataCompression - Basic Functionality", "[compression]")
 {
@@ -130,3 +132,67 @@ TEST_CASE("DataCompression - Performance", "[compression][performance]")
         REQUIRE(duration.count() < 1000); // Less than 1 second
     }
 }
+
+TEST_CASE("Lz4Block - Round Trips", "[compression]")
+{
+    auto roundTrip = [](const std::vector<uint8_t>& data)
+    {
+        std::vector<uint8_t> compressed(Lz4CompressBound(data.size()));
+        size_t compressedSize = Lz4Compress(data.data(), data.size(), compressed.data(), compressed.size());
+        REQUIRE(compressedSize > 0);
+
+        std::vector<uint8_t> restored(data.size());
+        REQUIRE(Lz4Decompress(compressed.data(), compressedSize, restored.data(), restored.size()));
+        REQUIRE(restored == data);
+        return compressedSize;
+    };
+
+    std::mt19937 rng(7);
+
+    SECTION("Empty, tiny and incompressible inputs")
+    {
+        roundTrip({});
+        roundTrip({ 42 });
+        roundTrip(std::vector<uint8_t>(13, 9));
+
+        std::vector<uint8_t> noise(100000);
+        for (auto& byte : noise)
+        {
+            byte = static_cast<uint8_t>(rng());
+        }
+        REQUIRE(roundTrip(noise) <= Lz4CompressBound(noise.size()));
+    }
+
+    SECTION("Repetitive data shrinks, including long runs and overlapping matches")
+    {
+        std::vector<uint8_t> runs(70000, 0xAB);
+        REQUIRE(roundTrip(runs) < 1000);
+
+        std::string text;
+        while (text.size() < 200000)
+        {
+            text += "monster_" + std::to_string(rng() % 500) + " health=" + std::to_string(rng() % 100) + ";";
+        }
+        std::vector<uint8_t> records(text.begin(), text.end());
+        REQUIRE(roundTrip(records) < records.size() / 2);
+    }
+
+    SECTION("Malformed input is rejected without overrunning buffers")
+    {
+        std::vector<uint8_t> data(5000);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            data[i] = static_cast<uint8_t>(i % 97);
+        }
+        std::vector<uint8_t> compressed(Lz4CompressBound(data.size()));
+        size_t compressedSize = Lz4Compress(data.data(), data.size(), compressed.data(), compressed.size());
+
+        std::vector<uint8_t> restored(data.size());
+        REQUIRE_FALSE(Lz4Decompress(compressed.data(), compressedSize / 2, restored.data(), restored.size()));
+        REQUIRE_FALSE(Lz4Decompress(compressed.data(), compressedSize, restored.data(), restored.size() - 1));
+
+        // Offset pointing before the start of the output
+        std::vector<uint8_t> badOffset = { 0x10, 'x', 0xFF, 0x00, 0x00 };
+        REQUIRE_FALSE(Lz4Decompress(badOffset.data(), badOffset.size(), restored.data(), 10));
+    }
+}
@@ -0,0 +1,164 @@
+#include <catch2/catch_test_macros.hpp>
+#include "networking/net_server.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Networking;
+
+namespace
+{
+    enum class TestMessage : uint32_t
+    {
+        Ping = 1,
+        Move = 2
+    };
+
+    class FramingTestServer : public server_interface<TestMessage>
+    {
+    public:
+        FramingTestServer() : server_interface<TestMessage>(0) {}
+
+        uint16_t GetPort() const { return m_asioAcceptor.local_endpoint().port(); }
+
+        bool WaitForMessages(size_t count)
+        {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (received.size() < count && std::chrono::steady_clock::now() < deadline)
+            {
+                Update(-1, false);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return received.size() == count;
+        }
+
+        std::vector<message<TestMessage>> received;
+
+    protected:
+        bool OnClientConnect(std::shared_ptr<connection<TestMessage>> client) override
+        {
+            return true;
+        }
+
+        void OnMessageReceived(std::shared_ptr<connection<TestMessage>> client, message<TestMessage>& msg) override
+        {
+            received.push_back(msg);
+        }
+    };
+
+    // Client connection that can look at its own socket
+    class ProbeConnection : public connection<TestMessage>
+    {
+    public:
+        using connection<TestMessage>::connection;
+
+        bool HasNoDelay()
+        {
+            asio::ip::tcp::no_delay option;
+            std::error_code ec;
+            m_socket.get_option(option, ec);
+            return !ec && option.value();
+        }
+    };
+
+    // Writes a message the way connection::Send does, header then body
+    void WriteMessage(asio::ip::tcp::socket& socket, const message<TestMessage>& msg)
+    {
+        asio::write(socket, asio::buffer(&msg.header, sizeof(msg.header)));
+        if (!msg.body.empty())
+            asio::write(socket, asio::buffer(msg.body));
+    }
+}
+
+TEST_CASE("Connection Framing", "[networking]")
+{
+    FramingTestServer server;
+    REQUIRE(server.Start());
+
+    asio::io_context context;
+    asio::ip::tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), server.GetPort());
+
+    SECTION("Every message on a connection arrives whole")
+    {
+        asio::ip::tcp::socket socket(context);
+        socket.connect(endpoint);
+
+        // header.size is the body size; reads are re-armed after each message
+        for (uint32_t value = 1; value <= 3; ++value)
+        {
+            message<TestMessage> msg;
+            msg.header.id = TestMessage::Move;
+            msg << value << value * 10;
+            WriteMessage(socket, msg);
+        }
+        message<TestMessage> empty;
+        empty.header.id = TestMessage::Ping;
+        WriteMessage(socket, empty);
+
+        REQUIRE(server.WaitForMessages(4));
+        for (uint32_t value = 1; value <= 3; ++value)
+        {
+            message<TestMessage>& msg = server.received[value - 1];
+            REQUIRE(msg.header.id == TestMessage::Move);
+            REQUIRE(msg.body.size() == 2 * sizeof(uint32_t));
+
+            uint32_t first = 0;
+            uint32_t second = 0;
+            msg >> second >> first;
+            REQUIRE(first == value);
+            REQUIRE(second == value * 10);
+        }
+        REQUIRE(server.received[3].header.id == TestMessage::Ping);
+        REQUIRE(server.received[3].body.empty());
+    }
+
+    SECTION("An oversized message drops the connection")
+    {
+        asio::ip::tcp::socket socket(context);
+        socket.connect(endpoint);
+
+        message<TestMessage> huge;
+        huge.header.id = TestMessage::Move;
+        huge.header.size = max_message_body_size + 1;
+        asio::write(socket, asio::buffer(&huge.header, sizeof(huge.header)));
+
+        // The server closes without waiting for a body it will not read
+        uint8_t byte = 0;
+        std::error_code ec;
+        asio::read(socket, asio::buffer(&byte, 1), ec);
+        REQUIRE(ec == asio::error::eof);
+
+        server.Update(-1, false);
+        REQUIRE(server.received.empty());
+    }
+
+    SECTION("A message at the limit is read")
+    {
+        asio::ip::tcp::socket socket(context);
+        socket.connect(endpoint);
+
+        message<TestMessage> largest;
+        largest.header.id = TestMessage::Move;
+        largest.body.assign(max_message_body_size, 0x5a);
+        largest.header.size = max_message_body_size;
+        WriteMessage(socket, largest);
+
+        REQUIRE(server.WaitForMessages(1));
+        REQUIRE(server.received[0].body == largest.body);
+    }
+
+    SECTION("Connections disable Nagle")
+    {
+        tsqueue<owned_message<TestMessage>> incoming;
+        ProbeConnection client(connection<TestMessage>::owner::client, context, asio::ip::tcp::socket(context), incoming);
+        asio::ip::tcp::resolver resolver(context);
+        client.ConnectToServer(resolver.resolve(endpoint));
+
+        // The option is set when the connect completes
+        for (int i = 0; i < 500 && !client.HasNoDelay(); ++i)
+            context.run_one_for(std::chrono::milliseconds(10));
+        REQUIRE(client.HasNoDelay());
+    }
+
+    server.Stop();
+}
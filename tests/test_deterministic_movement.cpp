@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+#include "optimization/DeterministicMovement.h"
+#include "optimization/MovementPrediction.h"
+#include <vector>
+
+using namespace Optimization;
+using namespace Optimization::DeterministicMovement;
+
+namespace
+{
+    // Recorded input stream: a fixed LCG so every build replays the same raw values
+    std::vector<Input> RecordInputStream(size_t count)
+    {
+        std::vector<Input> inputs;
+        inputs.reserve(count);
+
+        uint32_t seed = 0x5EED1234u;
+        auto next = [&seed]() {
+            seed = seed * 1664525u + 1013904223u;
+            return static_cast<int64_t>(seed >> 12) - (int64_t(1) << 19); // about +/-8.0 in Q16
+        };
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Input input;
+            input.velocity = FixedVector{Fixed::FromRaw(next()), Fixed::FromRaw(next() / 8), Fixed::FromRaw(next())};
+            input.acceleration = FixedVector{Fixed::FromRaw(next() / 4), Fixed::FromRaw(next() / 4), Fixed::FromRaw(next() / 4)};
+            inputs.push_back(input);
+        }
+        return inputs;
+    }
+
+    uint64_t ReplayStream(const std::vector<Input>& inputs, Fixed deltaTime)
+    {
+        State state;
+        uint64_t hash = HashState(state);
+        for (const auto& input : inputs)
+        {
+            state = Step(state, input, deltaTime);
+            hash = HashState(state, hash);
+        }
+        return hash;
+    }
+}
+
+TEST_CASE("DeterministicMovement - Fixed-Point Arithmetic", "[movement][determinism]")
+{
+    REQUIRE(Fixed::FromFloat(1.5f).raw == 98304);
+    REQUIRE(Fixed::FromFloat(-0.25f).raw == -16384);
+    REQUIRE((Fixed::FromInt(3) * Fixed::FromFloat(0.5f)) == Fixed::FromFloat(1.5f));
+    REQUIRE((Fixed::FromInt(3) / Fixed::FromInt(2)) == Fixed::FromFloat(1.5f));
+    REQUIRE(Fixed::FromFloat(2.75f).ToFloat() == 2.75f);
+
+    // p + v*dt + a*dt^2/2 with exact binary fractions
+    FixedVector moved = CalculateMovement(FixedVector{Fixed::FromInt(1), Fixed(), Fixed()},
+                                          FixedVector{Fixed::FromInt(2), Fixed(), Fixed()},
+                                          FixedVector{Fixed::FromInt(4), Fixed(), Fixed()},
+                                          Fixed::FromFloat(0.5f));
+    REQUIRE(moved.x == Fixed::FromFloat(2.5f));
+}
+
+TEST_CASE("DeterministicMovement - Cross-Build Replay Hash", "[movement][determinism]")
+{
+    // Golden hash recorded from a reference build. Any compiler, optimisation
+    // level or platform must reproduce it bit for bit.
+    const uint64_t goldenHash = 0x44abd5ee9ffbc8c9ull;
+
+    std::vector<Input> inputs = RecordInputStream(10000);
+    uint64_t hash = ReplayStream(inputs, Fixed::FromRaw(Fixed::One / 60));
+
+    REQUIRE(hash == goldenHash);
+    REQUIRE(ReplayStream(inputs, Fixed::FromRaw(Fixed::One / 60)) == hash);
+}
+
+TEST_CASE("DeterministicMovement - Client And Server Predictions Agree", "[movement][determinism]")
+{
+    PredictionConfig config;
+    config.useDeterministicSimulation = true;
+
+    MovementPrediction client;
+    MovementPrediction server;
+    REQUIRE(client.Initialize(config));
+    REQUIRE(server.Initialize(config));
+
+    std::vector<Input> inputs = RecordInputStream(500);
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        MovementInput input;
+        input.inputId = static_cast<uint32_t>(i + 1);
+        input.velocity = ToVector(inputs[i].velocity);
+        input.acceleration = ToVector(inputs[i].acceleration);
+        input.isMoving = true;
+
+        client.AddInput(input);
+        server.AddInput(input);
+        client.ProcessInputs(1.0f / 60.0f);
+        server.ProcessInputs(1.0f / 60.0f);
+    }
+
+    Vector4F clientPosition = client.GetCurrentPosition();
+    Vector4F serverPosition = server.GetCurrentPosition();
+    REQUIRE(clientPosition.x == serverPosition.x);
+    REQUIRE(clientPosition.y == serverPosition.y);
+    REQUIRE(clientPosition.z == serverPosition.z);
+
+    // Reconciling against an identical server state is never a correction
+    client.ReconcileWithServer(500, serverPosition, 0.0f);
+    client.ProcessInputs(1.0f / 60.0f);
+    REQUIRE(client.GetStats().replays == 0);
+}
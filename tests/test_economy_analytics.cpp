@@ -0,0 +1,277 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utils/IndexedHeap.h"
+#include "utils/Logger.h"
+#include "game/GlobalEconomy.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace Game;
+
+namespace
+{
+    // Default catalog items and merchants
+    constexpr uint32_t Sword = 1;
+    constexpr uint32_t Potion = 3;
+    constexpr uint32_t Ore = 4;
+    constexpr uint32_t Blacksmith = 1;
+    constexpr uint32_t Trader = 3;
+
+    // Wealth computed the slow way, from the full state
+    uint64_t ScanWealth(GlobalEconomy& economy, uint32_t playerId)
+    {
+        const PlayerEconomyData* player = economy.GetPlayerEconomy(playerId);
+        uint64_t wealth = 0;
+        for (const auto& pair : player->currencies)
+        {
+            wealth += pair.second;
+        }
+        for (const auto& pair : player->inventory)
+        {
+            wealth += static_cast<uint64_t>(economy.GetItem(pair.first)->value) * pair.second;
+        }
+        return wealth;
+    }
+
+    std::vector<std::pair<uint32_t, uint64_t>> ScanTopWealth(GlobalEconomy& economy, uint32_t players, size_t count)
+    {
+        std::vector<std::pair<uint32_t, uint64_t>> all;
+        for (uint32_t playerId = 1; playerId <= players; ++playerId)
+        {
+            all.emplace_back(playerId, ScanWealth(economy, playerId));
+        }
+        std::sort(all.begin(), all.end(), [](const auto& a, const auto& b)
+        {
+            return a.second > b.second || (a.second == b.second && a.first < b.first);
+        });
+        all.resize(std::min(count, all.size()));
+        return all;
+    }
+
+    uint32_t ScanGold(GlobalEconomy& economy, uint32_t players)
+    {
+        uint32_t gold = 0;
+        for (uint32_t playerId = 1; playerId <= players; ++playerId)
+        {
+            gold += economy.GetCurrency(playerId, CurrencyType::Gold);
+        }
+        for (const auto& merchant : economy.GetAllMerchants())
+        {
+            gold += merchant.goldAmount;
+        }
+        return gold;
+    }
+}
+
+TEST_CASE("Indexed Heap", "[utils]")
+{
+    IndexedHeap<uint32_t, uint64_t> heap;
+    REQUIRE(heap.Empty());
+    REQUIRE(heap.Top(3).empty());
+
+    heap.Set(1, 50);
+    heap.Set(2, 10);
+    heap.Set(3, 70);
+    heap.Set(4, 30);
+    heap.Set(5, 70);
+    REQUIRE(heap.Size() == 5);
+    REQUIRE(heap.TopKey() == 3); // Ties go to the smaller key
+    REQUIRE(*heap.Find(4) == 30);
+    REQUIRE(heap.Find(9) == nullptr);
+
+    SECTION("Top walks the heap in order")
+    {
+        auto top = heap.Top(3);
+        REQUIRE(top.size() == 3);
+        REQUIRE(top[0] == std::make_pair(3u, uint64_t(70)));
+        REQUIRE(top[1] == std::make_pair(5u, uint64_t(70)));
+        REQUIRE(top[2] == std::make_pair(1u, uint64_t(50)));
+        REQUIRE(heap.Top(10).size() == 5);
+    }
+
+    SECTION("Updates move keys both ways")
+    {
+        heap.Set(2, 100);
+        REQUIRE(heap.TopKey() == 2);
+        heap.Set(2, 0);
+        REQUIRE(heap.TopKey() == 3);
+        REQUIRE(heap.Top(5).back().first == 2);
+    }
+
+    SECTION("Removal keeps the heap ordered")
+    {
+        REQUIRE(heap.Remove(3));
+        REQUIRE_FALSE(heap.Remove(3));
+        REQUIRE(heap.TopKey() == 5);
+        REQUIRE(heap.Remove(5));
+        REQUIRE(heap.TopKey() == 1);
+        REQUIRE_FALSE(heap.Contains(5));
+    }
+
+    SECTION("Random operations agree with sorting")
+    {
+        std::mt19937 random(7);
+        std::map<uint32_t, uint64_t> reference;
+        heap.Clear();
+        for (int i = 0; i < 5000; ++i)
+        {
+            uint32_t key = random() % 200;
+            if (random() % 4 == 0)
+            {
+                REQUIRE(heap.Remove(key) == (reference.erase(key) > 0));
+            }
+            else
+            {
+                uint64_t value = random() % 1000;
+                heap.Set(key, value);
+                reference[key] = value;
+            }
+        }
+
+        std::vector<std::pair<uint32_t, uint64_t>> expected(reference.begin(), reference.end());
+        std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+        expected.resize(20);
+        REQUIRE(heap.Size() == reference.size());
+        REQUIRE(heap.Top(20) == expected);
+    }
+}
+
+TEST_CASE("Global Economy - Incremental Statistics", "[game][economy]")
+{
+    constexpr uint32_t Players = 40;
+
+    GlobalEconomy economy;
+    REQUIRE(economy.Initialize());
+    economy.GetMerchant(Blacksmith)->inventory[Sword] = 50;
+    economy.GetMerchant(Trader)->inventory[Potion] = 500;
+    economy.RecalculateStats();
+
+    for (uint32_t playerId = 1; playerId <= Players; ++playerId)
+    {
+        economy.AddPlayer(playerId);
+        economy.AddCurrency(playerId, CurrencyType::Gold, playerId * 10);
+        economy.AddItemToInventory(playerId, Ore, playerId % 7);
+    }
+
+    // Purchases and sales count towards the averages; gifts and trades do not
+    uint64_t tradedValue = 0;
+    auto trade = [&](uint32_t playerId, bool succeeded, uint32_t before)
+    {
+        uint32_t after = economy.GetCurrency(playerId, CurrencyType::Gold);
+        tradedValue += after > before ? after - before : before - after;
+        return succeeded;
+    };
+    uint32_t before = economy.GetCurrency(5, CurrencyType::Gold);
+    REQUIRE(trade(5, economy.BuyItem(5, Trader, Potion, 2), before));
+    before = economy.GetCurrency(5, CurrencyType::Gold);
+    REQUIRE(trade(5, economy.BuyItem(5, Trader, Potion, 1), before));
+    before = economy.GetCurrency(5, CurrencyType::Gold);
+    REQUIRE(trade(5, economy.SellItem(5, Trader, Potion, 1), before));
+    before = economy.GetCurrency(40, CurrencyType::Gold);
+    REQUIRE(trade(40, economy.BuyItem(40, Blacksmith, Sword, 1), before));
+    REQUIRE(economy.GiftItem(40, 3, Sword, 1));
+    REQUIRE(economy.TradeItems(5, 8, { { Potion, 1 } }, { { Ore, 1 } }));
+    REQUIRE(economy.RemoveCurrency(39, CurrencyType::Gold, 100));
+
+    EconomyStats stats = economy.GetStats();
+    REQUIRE(stats.totalTransactions == 4);
+    REQUIRE(stats.mostTradedItem == Potion);
+    REQUIRE(stats.totalGoldCirculation == ScanGold(economy, Players));
+
+    auto expected = ScanTopWealth(economy, Players, 5);
+    REQUIRE(stats.richestPlayer == expected[0].first);
+    REQUIRE(economy.GetTopWealthyPlayers(5) == expected);
+    for (uint32_t playerId = 1; playerId <= Players; ++playerId)
+    {
+        REQUIRE(economy.GetPlayerWealth(playerId) == ScanWealth(economy, playerId));
+    }
+
+    SECTION("Price changes revalue every inventory")
+    {
+        economy.ApplyInflation(0.5f);
+        REQUIRE(economy.GetTopWealthyPlayers(5) == ScanTopWealth(economy, Players, 5));
+        REQUIRE(economy.GetPlayerWealth(3) == ScanWealth(economy, 3));
+    }
+
+    SECTION("Removed players leave the totals")
+    {
+        economy.RemovePlayer(expected[0].first);
+        REQUIRE(economy.GetStats().richestPlayer == expected[1].first);
+        REQUIRE(economy.GetStats().totalGoldCirculation ==
+                stats.totalGoldCirculation - (expected[0].first * 10 + 100));
+    }
+
+    SECTION("Direct edits count after a recalculation")
+    {
+        economy.GetPlayerEconomy(1)->currencies[CurrencyType::Gold] = 100000;
+        REQUIRE(economy.GetStats().richestPlayer != 1);
+        economy.RecalculateStats();
+        REQUIRE(economy.GetStats().richestPlayer == 1);
+        REQUIRE(economy.GetStats().totalGoldCirculation == ScanGold(economy, Players));
+    }
+
+    SECTION("Resetting statistics keeps the gauges")
+    {
+        economy.ResetStats();
+        EconomyStats reset = economy.GetStats();
+        REQUIRE(reset.totalTransactions == 0);
+        REQUIRE(reset.mostTradedItem == 0);
+        REQUIRE(reset.totalItems == stats.totalItems);
+        REQUIRE(reset.totalGoldCirculation == stats.totalGoldCirculation);
+
+        before = economy.GetCurrency(7, CurrencyType::Gold);
+        REQUIRE(economy.BuyItem(7, Blacksmith, Sword, 1));
+        REQUIRE(economy.GetStats().mostTradedItem == Sword);
+        REQUIRE(economy.GetStats().averageTransactionValue ==
+                static_cast<float>(before - economy.GetCurrency(7, CurrencyType::Gold)));
+    }
+}
+
+TEST_CASE("Global Economy - Statistics Query Cost", "[game][economy][!benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int Queries = 2000;
+
+    Logger::GetInstance().SetLogLevel(LogLevel::WARNING);
+    for (uint32_t players : { 1000u, 10000u, 100000u })
+    {
+        GlobalEconomy economy;
+        REQUIRE(economy.Initialize());
+        for (uint32_t playerId = 1; playerId <= players; ++playerId)
+        {
+            economy.AddPlayer(playerId);
+            economy.AddCurrency(playerId, CurrencyType::Gold, playerId % 997);
+        }
+
+        auto start = Clock::now();
+        uint64_t checksum = 0;
+        for (int i = 0; i < Queries; ++i)
+        {
+            checksum += economy.GetStats().richestPlayer;
+            checksum += economy.GetTopWealthyPlayers(10).front().first;
+        }
+        std::chrono::duration<double, std::micro> incremental = Clock::now() - start;
+
+        // What the scan-and-sort approach costs for the same answer
+        std::map<uint32_t, PlayerEconomyData> snapshot;
+        for (uint32_t playerId = 1; playerId <= players; ++playerId)
+        {
+            snapshot[playerId] = *economy.GetPlayerEconomy(playerId);
+        }
+        int scans = std::max(1, Queries / static_cast<int>(players / 100));
+        start = Clock::now();
+        for (int i = 0; i < scans; ++i)
+        {
+            checksum += EconomyUtils::GetTopWealthyPlayers(snapshot).front();
+        }
+        std::chrono::duration<double, std::micro> scanned = Clock::now() - start;
+
+        std::cout << players << " players: stats + top 10 in " << incremental.count() / Queries
+                  << " us, full scan and sort in " << scanned.count() / scans << " us (checksum "
+                  << checksum << ")" << std::endl;
+    }
+    Logger::GetInstance().SetLogLevel(LogLevel::INFO);
+}
@@ -0,0 +1,204 @@
+#include <catch2/catch_test_macros.hpp>
+#include "game/GlobalEconomy.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Game;
+
+namespace
+{
+    // Default catalog items and merchant used below
+    constexpr uint32_t Potion = 3;
+    constexpr uint32_t Ore = 4;
+    constexpr uint32_t Trader = 3;
+
+    void AddTraders(GlobalEconomy& economy, uint32_t players, uint32_t ore)
+    {
+        for (uint32_t playerId = 1; playerId <= players; ++playerId)
+        {
+            economy.AddPlayer(playerId);
+            economy.AddCurrency(playerId, CurrencyType::Gold, 10000);
+            economy.AddItemToInventory(playerId, Ore, ore);
+        }
+        economy.GetMerchant(Trader)->inventory[Potion] = 100000;
+        economy.GetMerchant(Trader)->goldAmount = 1000000;
+    }
+
+    // One random operation: mostly trades and gifts between players, some
+    // buying and selling at the trader. Returns true if it went through.
+    bool RandomOperation(GlobalEconomy& economy, std::mt19937& random, uint32_t players, bool& withTrader)
+    {
+        uint32_t first = random() % players + 1;
+        uint32_t second = random() % players + 1;
+        uint32_t kind = random() % 5;
+        withTrader = kind >= 3;
+        switch (kind)
+        {
+            case 0:
+            case 1:
+                return economy.TradeItems(first, second, { { Ore, 1 } }, { { Ore, 1 } });
+            case 2:
+                return economy.GiftItem(first, second, Ore, 1);
+            case 3:
+                return economy.BuyItem(first, Trader, Potion, 1);
+            default:
+                return economy.SellItem(first, Trader, Potion, 1);
+        }
+    }
+}
+
+TEST_CASE("Global Economy - Concurrent Trading", "[game][economy]")
+{
+    constexpr uint32_t Players = 64;
+    constexpr int Threads = 8;
+    constexpr int OperationsPerThread = 2000;
+
+    GlobalEconomy economy;
+    REQUIRE(economy.Initialize());
+    AddTraders(economy, Players, 50);
+
+    auto totalGold = [&]
+    {
+        uint32_t gold = economy.GetMerchant(Trader)->goldAmount;
+        for (uint32_t playerId = 1; playerId <= Players; ++playerId)
+        {
+            gold += economy.GetCurrency(playerId, CurrencyType::Gold);
+        }
+        return gold;
+    };
+    auto totalItems = [&](uint32_t itemId)
+    {
+        uint32_t quantity = economy.GetMerchant(Trader)->inventory[itemId];
+        for (uint32_t playerId = 1; playerId <= Players; ++playerId)
+        {
+            quantity += economy.GetItemQuantity(playerId, itemId);
+        }
+        return quantity;
+    };
+
+    uint32_t goldBefore = totalGold();
+    uint32_t oreBefore = totalItems(Ore);
+    uint32_t potionsBefore = totalItems(Potion);
+    uint32_t transactionsBefore = economy.GetStats().totalTransactions;
+
+    // Readers poll balances while the writers trade
+    std::atomic<bool> trading{ true };
+    std::atomic<int> failures{ 0 };
+    std::thread reader([&]
+    {
+        while (trading)
+        {
+            for (uint32_t playerId = 1; playerId <= Players; ++playerId)
+            {
+                if (economy.GetItemQuantity(playerId, Ore) > oreBefore ||
+                    economy.GetCurrency(playerId, CurrencyType::Gold) > goldBefore)
+                {
+                    failures++;
+                }
+            }
+        }
+    });
+
+    std::atomic<uint32_t> purchasesAndSales{ 0 };
+    std::vector<std::thread> writers;
+    for (int t = 0; t < Threads; ++t)
+    {
+        writers.emplace_back([&, t]
+        {
+            std::mt19937 random(t + 1);
+            for (int i = 0; i < OperationsPerThread; ++i)
+            {
+                bool withTrader;
+                if (RandomOperation(economy, random, Players, withTrader) && withTrader)
+                {
+                    purchasesAndSales++;
+                }
+            }
+        });
+    }
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+    trading = false;
+    reader.join();
+
+    REQUIRE(failures == 0);
+    REQUIRE(purchasesAndSales > 0);
+    REQUIRE(totalGold() == goldBefore);
+    REQUIRE(totalItems(Ore) == oreBefore);
+    REQUIRE(totalItems(Potion) == potionsBefore);
+    REQUIRE(economy.GetStats().totalTransactions == transactionsBefore + purchasesAndSales);
+
+    // Carried weight still matches every inventory
+    for (uint32_t playerId = 1; playerId <= Players; ++playerId)
+    {
+        const PlayerEconomyData* player = economy.GetPlayerEconomy(playerId);
+        uint32_t weight = 0;
+        for (const auto& pair : player->inventory)
+        {
+            weight += economy.GetItem(pair.first)->weight * pair.second;
+        }
+        REQUIRE(player->totalWeight == weight);
+    }
+}
+
+TEST_CASE("Global Economy - Trade Storm", "[game][economy][!benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t Players = 1024;
+    constexpr int Operations = 400000;
+
+    // Per-trade log lines would measure the logger instead
+    Logger::GetInstance().SetLogLevel(LogLevel::WARNING);
+
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<int> threadCounts = { 1, 2, 4, 8 };
+    if (hardwareThreads > 8)
+    {
+        threadCounts.push_back(static_cast<int>(hardwareThreads));
+    }
+
+    for (int threads : threadCounts)
+    {
+        GlobalEconomy economy;
+        REQUIRE(economy.Initialize());
+        AddTraders(economy, Players, 100);
+
+        int perThread = Operations / threads;
+        std::atomic<int> completed{ 0 };
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]
+            {
+                std::mt19937 random(t + 1);
+                int done = 0;
+                bool withTrader;
+                for (int i = 0; i < perThread; ++i)
+                {
+                    done += RandomOperation(economy, random, Players, withTrader) ? 1 : 0;
+                }
+                completed += done;
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        std::cout << "Trade storm, " << threads << " threads: " << perThread * threads / elapsed.count()
+                  << " operations/s (" << completed << " went through)" << std::endl;
+    }
+
+    std::cout << "  " << hardwareThreads << " hardware threads available" << std::endl;
+    Logger::GetInstance().SetLogLevel(LogLevel::INFO);
+}
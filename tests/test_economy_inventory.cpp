@@ -0,0 +1,230 @@
+#include <catch2/catch_test_macros.hpp>
+#include "game/GlobalEconomy.h"
+#include "utils/Logger.h"
+#include "utils/SmallFlatMap.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+
+using namespace Game;
+
+namespace
+{
+    // Default catalog items: weights 10, 15, 1 and 2
+    constexpr uint32_t Sword = 1;
+    constexpr uint32_t Armor = 2;
+    constexpr uint32_t Potion = 3;
+    constexpr uint32_t Ore = 4;
+
+    template <typename Map>
+    std::vector<std::pair<uint32_t, uint32_t>> Entries(const Map& map)
+    {
+        return std::vector<std::pair<uint32_t, uint32_t>>(map.begin(), map.end());
+    }
+
+    uint32_t CarriedWeight(const GlobalEconomy& economy, uint32_t playerId)
+    {
+        uint32_t weight = 0;
+        for (const auto& pair : economy.GetPlayerEconomy(playerId)->inventory)
+        {
+            weight += economy.GetItem(pair.first)->weight * pair.second;
+        }
+        return weight;
+    }
+}
+
+TEST_CASE("Small Flat Map", "[utils]")
+{
+    using Map = SmallFlatMap<uint32_t, uint32_t, 4>;
+    Map map;
+    map[30] = 3;
+    map[10] = 1;
+    map[20] = 2;
+    map[10] += 5;
+
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.IsInline());
+    REQUIRE(Entries(map) == std::vector<std::pair<uint32_t, uint32_t>>{ { 10, 6 }, { 20, 2 }, { 30, 3 } });
+    REQUIRE(map.find(15) == map.end());
+    REQUIRE(map.count(20) == 1);
+
+    SECTION("Outgrowing the inline slots moves to the heap")
+    {
+        for (uint32_t key = 1; key <= 9; ++key)
+        {
+            map[key] = key;
+        }
+        REQUIRE(map.size() == 12);
+        REQUIRE_FALSE(map.IsInline());
+        REQUIRE(map.begin()->first == 1);
+        REQUIRE(map[30] == 3);
+
+        Map copy = map;
+        Map moved = std::move(map);
+        REQUIRE(copy == moved);
+        REQUIRE(map.empty());
+        map[5] = 5;
+        REQUIRE(map.IsInline());
+        REQUIRE(map.size() == 1);
+    }
+
+    SECTION("Erasing keeps the order")
+    {
+        REQUIRE(map.erase(20) == 1);
+        REQUIRE(map.erase(20) == 0);
+        map.erase(map.find(10));
+        REQUIRE(Entries(map) == std::vector<std::pair<uint32_t, uint32_t>>{ { 30, 3 } });
+    }
+
+    SECTION("Sorted ranges merge in one pass")
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> drop = { { 5, 1 }, { 10, 1 }, { 25, 2 }, { 25, 3 }, { 40, 4 } };
+        map.AddSorted(drop.begin(), drop.end());
+        REQUIRE(Entries(map) == std::vector<std::pair<uint32_t, uint32_t>>{
+            { 5, 1 }, { 10, 7 }, { 20, 2 }, { 25, 5 }, { 30, 3 }, { 40, 4 } });
+        REQUIRE_FALSE(map.IsInline());
+
+        REQUIRE(map.EraseIf([](const auto& entry) { return entry.second < 4; }) == 3);
+        REQUIRE(Entries(map) == std::vector<std::pair<uint32_t, uint32_t>>{ { 10, 7 }, { 25, 5 }, { 40, 4 } });
+    }
+}
+
+TEST_CASE("Global Economy - Inventory Weight", "[game][economy]")
+{
+    GlobalEconomy economy;
+    REQUIRE(economy.Initialize());
+    economy.AddPlayer(1);
+    economy.AddPlayer(2);
+
+    SECTION("Loot drops are granted whole or not at all")
+    {
+        REQUIRE(economy.AddItemsToInventory(1, { { Sword, 2 }, { Potion, 10 }, { Ore, 5 } }));
+        REQUIRE(economy.GetItemQuantity(1, Potion) == 10);
+        REQUIRE(economy.GetPlayerEconomy(1)->totalWeight == 40);
+
+        // 99 is not in the catalog; 100 armor is far over the limit
+        REQUIRE_FALSE(economy.AddItemsToInventory(1, { { Potion, 1 }, { 99, 1 } }));
+        REQUIRE_FALSE(economy.AddItemsToInventory(1, { { Potion, 1 }, { Armor, 100 } }));
+        REQUIRE(economy.GetItemQuantity(1, Potion) == 10);
+        REQUIRE(economy.GetPlayerEconomy(1)->totalWeight == CarriedWeight(economy, 1));
+    }
+
+    SECTION("Trades move weight and respect the receiver's limit")
+    {
+        REQUIRE(economy.AddItemsToInventory(1, { { Sword, 3 }, { Potion, 4 } }));
+        REQUIRE(economy.AddItemsToInventory(2, { { Ore, 10 } }));
+        REQUIRE(economy.TradeItems(1, 2, { { Sword, 2 }, { Potion, 4 } }, { { Ore, 10 } }));
+        REQUIRE(economy.GetItemQuantity(1, Potion) == 0);
+        REQUIRE(economy.GetPlayerEconomy(1)->inventory.size() == 2);
+        REQUIRE(economy.GetPlayerEconomy(1)->totalWeight == 30);
+        REQUIRE(economy.GetPlayerEconomy(2)->totalWeight == 24);
+
+        economy.GetPlayerEconomy(2)->maxWeight = 30;
+        REQUIRE_FALSE(economy.TradeItems(1, 2, { { Sword, 1 } }, {}));
+        REQUIRE(economy.TradeItems(2, 1, { { Sword, 1 } }, {}));
+        REQUIRE(economy.GetPlayerEconomy(2)->totalWeight == CarriedWeight(economy, 2));
+    }
+
+    SECTION("Catalog weight changes reach what players carry")
+    {
+        REQUIRE(economy.AddItemsToInventory(1, { { Sword, 2 }, { Ore, 5 } }));
+        ItemData sword = *economy.GetItem(Sword);
+        sword.weight = 25;
+        economy.AddItem(sword);
+        REQUIRE(economy.GetPlayerEconomy(1)->totalWeight == 60);
+
+        economy.RemoveItem(Ore);
+        REQUIRE(economy.GetPlayerEconomy(1)->totalWeight == 50);
+        REQUIRE(economy.RemoveItemFromInventory(1, Sword, 2));
+        REQUIRE(economy.GetPlayerEconomy(1)->totalWeight == 0);
+    }
+}
+
+TEST_CASE("Inventory - Flat Map vs Tree", "[game][economy][!benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int Rounds = 200000;
+    constexpr uint32_t ItemIds = 2000;
+
+    for (size_t slots : { 50, 150, 300 })
+    {
+        std::mt19937 random(7);
+        std::uniform_int_distribution<uint32_t> anyItem(1, ItemIds);
+        std::map<uint32_t, uint32_t> tree;
+        Inventory flat;
+        while (tree.size() < slots)
+        {
+            uint32_t itemId = anyItem(random);
+            tree[itemId] = 1;
+            flat[itemId] = 1;
+        }
+
+        // A buy and a sell per round, then a valuation walk as wealth does
+        auto churn = [&](auto& inventory)
+        {
+            std::mt19937 ops(11);
+            uint64_t checksum = 0;
+            auto start = Clock::now();
+            for (int i = 0; i < Rounds; ++i)
+            {
+                uint32_t itemId = anyItem(ops);
+                inventory[itemId] += 1;
+                auto it = inventory.find(anyItem(ops));
+                if (it != inventory.end() && --it->second == 0)
+                {
+                    inventory.erase(it);
+                }
+                if (i % 16 == 0)
+                {
+                    for (const auto& pair : inventory)
+                    {
+                        checksum += pair.first * pair.second;
+                    }
+                }
+            }
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            return std::make_pair(Rounds / elapsed.count(), checksum);
+        };
+
+        // Loot drops of 12 items, one insert apiece vs one merge
+        std::vector<std::pair<uint32_t, uint32_t>> drop;
+        for (int i = 0; i < 12; ++i)
+        {
+            drop.emplace_back(anyItem(random), 1);
+        }
+        std::sort(drop.begin(), drop.end());
+        auto loot = [&](auto&& grant)
+        {
+            auto start = Clock::now();
+            for (int i = 0; i < Rounds / 10; ++i)
+            {
+                grant();
+            }
+            std::chrono::duration<double> elapsed = Clock::now() - start;
+            return (Rounds / 10) / elapsed.count();
+        };
+        std::map<uint32_t, uint32_t> lootTree = tree;
+        Inventory lootFlat = flat;
+        double treeDrops = loot([&]
+        {
+            std::map<uint32_t, uint32_t> inventory = lootTree;
+            for (const auto& pair : drop)
+            {
+                inventory[pair.first] += pair.second;
+            }
+        });
+        double flatDrops = loot([&]
+        {
+            Inventory inventory = lootFlat;
+            inventory.AddSorted(drop.begin(), drop.end());
+        });
+
+        auto treeChurn = churn(tree);
+        auto flatChurn = churn(flat);
+        REQUIRE(treeChurn.second == flatChurn.second);
+        std::cout << slots << " slots: buy/sell " << treeChurn.first << " ops/s tree, " << flatChurn.first
+                  << " ops/s flat; loot drop (with copy) " << treeDrops << "/s tree, " << flatDrops
+                  << "/s flat" << std::endl;
+    }
+}
@@ -0,0 +1,500 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utils/WriteAheadLog.h"
+#include "game/GlobalEconomy.h"
+#include "game/SaveSerialization.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Game;
+
+namespace
+{
+    struct ReplayedRecord
+    {
+        uint64_t sequence;
+        std::string text;
+    };
+
+    bool OpenAndCollect(WriteAheadLog& log, const std::filesystem::path& path, std::vector<ReplayedRecord>& records,
+                        const WriteAheadLogOptions& options = WriteAheadLogOptions())
+    {
+        records.clear();
+        return log.Open(path.string(), options, [&](uint64_t sequence, const uint8_t* data, size_t size)
+        {
+            records.push_back({ sequence, std::string(reinterpret_cast<const char*>(data), size) });
+        });
+    }
+
+    uint64_t AppendText(WriteAheadLog& log, const std::string& text)
+    {
+        return log.Append(text.data(), text.size());
+    }
+
+    // Economy on its state directory with stock to trade; the defaults are
+    // items 1-4 and merchants 1-3
+    void StartEconomy(GlobalEconomy& economy, const std::filesystem::path& directory)
+    {
+        economy.SetStateDirectory(directory.string());
+        REQUIRE(economy.Initialize());
+    }
+
+    // Files as they were on disk at this moment, as if the process died here
+    void CopyStateAsIfCrashed(const std::filesystem::path& from, const std::filesystem::path& to)
+    {
+        std::filesystem::remove_all(to);
+        std::filesystem::copy(from, to);
+    }
+}
+
+TEST_CASE("Write-Ahead Log - Replay", "[utils][economy]")
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "tw3mp_wal_test.journal";
+    std::filesystem::remove(path);
+    std::vector<ReplayedRecord> records;
+
+    {
+        WriteAheadLog log;
+        REQUIRE(OpenAndCollect(log, path, records));
+        REQUIRE(records.empty());
+        REQUIRE(AppendText(log, "first") == 1);
+        REQUIRE(AppendText(log, "") == 2);
+        REQUIRE(AppendText(log, "third") == 3);
+        REQUIRE(log.Sync());
+        REQUIRE(log.GetDurableSequence() == 3);
+    }
+
+    SECTION("Reopening replays every record in order")
+    {
+        WriteAheadLog log;
+        REQUIRE(OpenAndCollect(log, path, records));
+        REQUIRE(records.size() == 3);
+        REQUIRE(records[0].sequence == 1);
+        REQUIRE(records[0].text == "first");
+        REQUIRE(records[1].text.empty());
+        REQUIRE(records[2].sequence == 3);
+        REQUIRE(records[2].text == "third");
+        REQUIRE(AppendText(log, "fourth") == 4);
+    }
+
+    SECTION("A torn last record is cut off and the log carries on")
+    {
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 2);
+        {
+            WriteAheadLog log;
+            REQUIRE(OpenAndCollect(log, path, records));
+            REQUIRE(records.size() == 2);
+            REQUIRE(log.GetStats().tailBytesDiscarded > 0);
+            REQUIRE(AppendText(log, "replacement") == 3);
+        }
+
+        WriteAheadLog log;
+        REQUIRE(OpenAndCollect(log, path, records));
+        REQUIRE(records.size() == 3);
+        REQUIRE(records[2].text == "replacement");
+    }
+
+    SECTION("A damaged record ends the replay")
+    {
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(-1, std::ios::end);
+            file.put('X');
+        }
+
+        WriteAheadLog log;
+        REQUIRE(OpenAndCollect(log, path, records));
+        REQUIRE(records.size() == 2);
+    }
+
+    SECTION("Truncation drops covered records but keeps the numbering")
+    {
+        {
+            WriteAheadLog log;
+            REQUIRE(OpenAndCollect(log, path, records));
+            size_t before = log.GetFileSize();
+            REQUIRE(log.Truncate(2));
+            REQUIRE(log.GetFileSize() < before);
+        }
+        {
+            WriteAheadLog log;
+            REQUIRE(OpenAndCollect(log, path, records));
+            REQUIRE(records.size() == 1);
+            REQUIRE(records[0].sequence == 3);
+            REQUIRE(log.Truncate(3));
+        }
+
+        WriteAheadLog log;
+        REQUIRE(OpenAndCollect(log, path, records));
+        REQUIRE(records.empty());
+        REQUIRE(AppendText(log, "after") == 4);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Write-Ahead Log - Group Commit", "[utils][economy]")
+{
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "tw3mp_wal_group_test.journal";
+    std::filesystem::remove(path);
+
+    WriteAheadLogOptions options;
+    options.commitInterval = std::chrono::milliseconds(20);
+    options.commitRecords = 1000;
+    std::vector<ReplayedRecord> records;
+    WriteAheadLog log;
+    REQUIRE(OpenAndCollect(log, path, records, options));
+
+    SECTION("Records become durable within the commit interval without waiting")
+    {
+        uint64_t sequence = AppendText(log, "unwaited");
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (log.GetDurableSequence() < sequence && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        REQUIRE(log.GetDurableSequence() >= sequence);
+    }
+
+    SECTION("Concurrent waiters share commits")
+    {
+        constexpr int Threads = 8;
+        constexpr int RecordsPerThread = 50;
+        std::atomic<int> failures{ 0 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < Threads; ++t)
+        {
+            threads.emplace_back([&log, &failures, t]
+            {
+                for (int i = 0; i < RecordsPerThread; ++i)
+                {
+                    uint64_t sequence = AppendText(log, "thread " + std::to_string(t) + " record " + std::to_string(i));
+                    if (sequence == 0 || !log.WaitDurable(sequence))
+                    {
+                        failures++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(failures == 0);
+        WriteAheadLogStats stats = log.GetStats();
+        REQUIRE(stats.recordsAppended == Threads * RecordsPerThread);
+        REQUIRE(stats.commits < stats.recordsAppended);
+        REQUIRE(log.GetDurableSequence() == stats.recordsAppended);
+    }
+
+    log.Close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Global Economy - Crash Recovery", "[game][economy]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_economy_state";
+    std::filesystem::path crashed = std::filesystem::temp_directory_path() / "tw3mp_economy_crashed";
+    std::filesystem::remove_all(directory);
+
+    GlobalEconomy economy;
+    StartEconomy(economy, directory);
+    REQUIRE(economy.IsJournaling());
+
+    // Stock set up outside transactions reaches disk through a snapshot
+    economy.GetMerchant(1)->inventory[1] = 10;
+    economy.GetMerchant(1)->inventory[3] = 20;
+    REQUIRE(economy.SaveEconomyState());
+
+    economy.AddPlayer(100);
+    economy.AddPlayer(200);
+    REQUIRE(economy.AddCurrency(100, CurrencyType::Gold, 400));
+    REQUIRE(economy.BuyItem(100, 1, 1, 2));
+    REQUIRE(economy.BuyItem(100, 1, 3, 5));
+    REQUIRE(economy.SellItem(100, 1, 3, 1));
+    REQUIRE(economy.GiftItem(100, 200, 3, 2));
+    REQUIRE(economy.TradeItems(100, 200, { { 1, 1 } }, { { 3, 1 } }));
+    REQUIRE(economy.RemoveCurrency(200, CurrencyType::Gold, 30));
+    REQUIRE(economy.FlushJournal());
+
+    uint32_t gold100 = economy.GetCurrency(100, CurrencyType::Gold);
+    uint32_t gold200 = economy.GetCurrency(200, CurrencyType::Gold);
+    uint32_t merchantGold = economy.GetMerchant(1)->goldAmount;
+    uint32_t weight100 = economy.GetPlayerEconomy(100)->totalWeight;
+
+    SECTION("Journal replay restores every change since the snapshot")
+    {
+        CopyStateAsIfCrashed(directory, crashed);
+
+        GlobalEconomy recovered;
+        StartEconomy(recovered, crashed);
+        REQUIRE(recovered.GetJournalStats().recordsReplayed > 0);
+        REQUIRE(recovered.GetCurrency(100, CurrencyType::Gold) == gold100);
+        REQUIRE(recovered.GetCurrency(200, CurrencyType::Gold) == gold200);
+        REQUIRE(recovered.GetItemQuantity(100, 1) == 1);
+        REQUIRE(recovered.GetItemQuantity(100, 3) == 3);
+        REQUIRE(recovered.GetItemQuantity(200, 1) == 1);
+        REQUIRE(recovered.GetItemQuantity(200, 3) == 1);
+        REQUIRE(recovered.GetPlayerEconomy(100)->totalWeight == weight100);
+        REQUIRE(recovered.GetMerchant(1)->goldAmount == merchantGold);
+        REQUIRE(recovered.GetMerchant(1)->inventory[1] == 8);
+        REQUIRE(recovered.GetMerchant(1)->inventory[3] == 16);
+        REQUIRE(recovered.GetStats().totalTransactions == economy.GetStats().totalTransactions);
+
+        // New transaction ids continue past the replayed ones
+        REQUIRE(recovered.BuyItem(200, 1, 1, 1));
+    }
+
+    SECTION("Catalog, merchant and player changes replay too")
+    {
+        MerchantData merchant = EconomyUtils::CreateGeneralMerchant("Fence", "Oxenfurt");
+        merchant.merchantId = 99;
+        economy.AddMerchant(merchant);
+        economy.RemoveMerchant(2);
+        economy.RemovePlayer(200);
+        ItemData relic = EconomyUtils::CreateMaterial("Elder Relic", ItemRarity::Rare, 400, 3);
+        relic.itemId = 50;
+        economy.AddItem(relic);
+        economy.RemoveItem(4);
+        economy.ApplyInflation(0.1f);
+        REQUIRE(economy.FlushJournal());
+        CopyStateAsIfCrashed(directory, crashed);
+
+        GlobalEconomy recovered;
+        StartEconomy(recovered, crashed);
+        REQUIRE(recovered.GetMerchant(99) != nullptr);
+        REQUIRE(recovered.GetMerchant(99)->goldAmount == economy.GetMerchant(99)->goldAmount);
+        REQUIRE(recovered.GetMerchant(2) == nullptr);
+        REQUIRE(recovered.GetPlayerEconomy(200) == nullptr);
+        REQUIRE(recovered.GetCurrency(100, CurrencyType::Gold) == gold100);
+        REQUIRE(recovered.GetItem(50).has_value());
+        REQUIRE_FALSE(recovered.GetItem(4).has_value());
+        REQUIRE(recovered.CalculateItemValue(50) == economy.CalculateItemValue(50));
+        REQUIRE(recovered.CalculateItemValue(1) == economy.CalculateItemValue(1));
+        REQUIRE(recovered.GetPlayerWealth(100) == economy.GetPlayerWealth(100));
+        REQUIRE(recovered.GetStats().activeMerchants == economy.GetAllMerchants().size());
+
+        // Ids continue past the replayed ones
+        ItemData ore = EconomyUtils::CreateMaterial("Dimeritium Ore", ItemRarity::Uncommon, 20, 2);
+        recovered.AddItem(ore);
+        REQUIRE(recovered.GetItemsByType(ItemType::Material).size() == 2);
+        recovered.AddMerchant(EconomyUtils::CreateGeneralMerchant("Peddler", "Velen"));
+        REQUIRE(recovered.GetMerchant(100) != nullptr);
+    }
+
+    SECTION("A trade with an unknown merchant stops recovery")
+    {
+        CopyStateAsIfCrashed(directory, crashed);
+
+        // Only the player half could be applied, creating gold
+        TransactionData purchase;
+        purchase.transactionId = 9000;
+        purchase.playerId = 100;
+        purchase.merchantId = 77;
+        purchase.type = TransactionType::Buy;
+        purchase.itemId = 1;
+        purchase.quantity = 1;
+        purchase.price = 50;
+        BinaryWriter record;
+        SaveSerialization::WriteTransactions(record, { purchase });
+        {
+            WriteAheadLog journal;
+            REQUIRE(journal.Open((crashed / "economy.journal").string(), WriteAheadLogOptions(), nullptr));
+            REQUIRE(journal.Append(record.GetBuffer().data(), record.GetSize()) != 0);
+            REQUIRE(journal.Sync());
+        }
+
+        GlobalEconomy recovered;
+        recovered.SetStateDirectory(crashed.string());
+        REQUIRE_FALSE(recovered.Initialize());
+    }
+
+    SECTION("A snapshot absorbs the journal")
+    {
+        size_t journalBefore = economy.GetJournalStats().bytesAppended;
+        REQUIRE(journalBefore > 0);
+        REQUIRE(economy.SaveEconomyState());
+        REQUIRE(economy.AddCurrency(200, CurrencyType::Gold, 5));
+        REQUIRE(economy.FlushJournal());
+        CopyStateAsIfCrashed(directory, crashed);
+
+        GlobalEconomy recovered;
+        StartEconomy(recovered, crashed);
+        REQUIRE(recovered.GetJournalStats().recordsReplayed == 1);
+        REQUIRE(recovered.GetCurrency(100, CurrencyType::Gold) == gold100);
+        REQUIRE(recovered.GetCurrency(200, CurrencyType::Gold) == gold200 + 5);
+    }
+
+    SECTION("Returning players keep their recovered balance")
+    {
+        economy.Shutdown();
+
+        GlobalEconomy restarted;
+        StartEconomy(restarted, directory);
+        REQUIRE(restarted.GetJournalStats().recordsReplayed == 0);
+        restarted.AddPlayer(100);
+        REQUIRE(restarted.GetCurrency(100, CurrencyType::Gold) == gold100);
+    }
+
+    std::filesystem::remove_all(crashed);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Global Economy - Acknowledged Changes Are Durable", "[game][economy]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_economy_acknowledged";
+    std::filesystem::path crashed = std::filesystem::temp_directory_path() / "tw3mp_economy_acknowledged_crashed";
+    std::filesystem::remove_all(directory);
+
+    // No timed commits, so only the economy waiting for its records gets
+    // them to disk before the crash
+    WriteAheadLogOptions options;
+    options.commitInterval = std::chrono::hours(1);
+    options.commitRecords = 1000000;
+
+    GlobalEconomy economy;
+    economy.SetJournalOptions(options);
+    StartEconomy(economy, directory);
+    economy.GetMerchant(1)->inventory[1] = 10;
+
+    std::vector<TransactionData> completed;
+    economy.SetTransactionCompletedCallback([&](const TransactionData& transaction)
+    {
+        // The purchase is on disk by the time anyone hears of it
+        CopyStateAsIfCrashed(directory, crashed);
+        completed.push_back(transaction);
+    });
+
+    economy.AddPlayer(100);
+    REQUIRE(economy.AddCurrency(100, CurrencyType::Gold, 400));
+    REQUIRE(economy.BuyItem(100, 1, 1, 1));
+    REQUIRE(completed.size() == 1);
+    uint32_t gold = economy.GetCurrency(100, CurrencyType::Gold);
+
+    {
+        GlobalEconomy recovered;
+        StartEconomy(recovered, crashed);
+        REQUIRE(recovered.GetCurrency(100, CurrencyType::Gold) == gold);
+        REQUIRE(recovered.GetItemQuantity(100, 1) == 1);
+    }
+
+    REQUIRE(economy.RemoveCurrency(100, CurrencyType::Gold, 50));
+    CopyStateAsIfCrashed(directory, crashed);
+    {
+        GlobalEconomy recovered;
+        StartEconomy(recovered, crashed);
+        REQUIRE(recovered.GetCurrency(100, CurrencyType::Gold) == gold - 50);
+    }
+
+    economy.Shutdown();
+    std::filesystem::remove_all(crashed);
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Global Economy - Durable Transaction Throughput", "[game][economy][!benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_economy_throughput";
+    constexpr int Trades = 4000;
+
+    // Each trader buys and sells the same potion back and forth so stock and
+    // gold never run out. Every trade waits for its journal record, so
+    // concurrent traders are what lets commits group.
+    auto runTrades = [&](bool durable, int traders) -> double
+    {
+        std::filesystem::remove_all(directory);
+        GlobalEconomy economy;
+        if (durable)
+        {
+            economy.SetStateDirectory(directory.string());
+        }
+        REQUIRE(economy.Initialize());
+        economy.GetMerchant(3)->inventory[3] = 1000;
+        for (int t = 1; t <= traders; ++t)
+        {
+            economy.AddPlayer(t);
+            economy.AddCurrency(t, CurrencyType::Gold, 1000000);
+        }
+
+        std::atomic<int> failures{ 0 };
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 1; t <= traders; ++t)
+        {
+            workers.emplace_back([&, t]
+            {
+                for (int i = 0; i < Trades / 2 / traders; ++i)
+                {
+                    if (!economy.BuyItem(t, 3, 3, 1) || !economy.SellItem(t, 3, 3, 1))
+                    {
+                        failures++;
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+        REQUIRE(failures == 0);
+
+        if (durable)
+        {
+            WriteAheadLogStats stats = economy.GetJournalStats();
+            std::cout << "  " << stats.recordsAppended << " journal records in " << stats.commits << " commits" << std::endl;
+        }
+        return Trades / elapsed.count();
+    };
+
+    std::cout << "Economy, in memory: " << runTrades(false, 1) << " transactions/s" << std::endl;
+    for (int traders : { 1, 8, 32 })
+    {
+        std::cout << "Economy, journaled, " << traders << " traders: " << runTrades(true, traders)
+                  << " durable transactions/s" << std::endl;
+    }
+
+    // Raw journal: an fsync per record against waiters sharing commits
+    std::filesystem::create_directories(directory);
+    std::filesystem::path path = directory / "throughput.journal";
+    std::string record(64, 'r');
+
+    for (int threads : { 1, 8, 32 })
+    {
+        std::filesystem::remove(path);
+        WriteAheadLog log;
+        REQUIRE(log.Open(path.string(), WriteAheadLogOptions(), nullptr));
+
+        int perThread = 4000 / threads;
+        auto start = Clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&]
+            {
+                for (int i = 0; i < perThread; ++i)
+                {
+                    log.WaitDurable(log.Append(record.data(), record.size()));
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        WriteAheadLogStats stats = log.GetStats();
+        std::cout << "Journal, " << threads << " waiting writers: " << stats.recordsAppended / elapsed.count()
+                  << " durable records/s, " << static_cast<double>(stats.recordsAppended) / stats.commits
+                  << " records per fsync" << std::endl;
+    }
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include "game/GlobalEconomy.h"
+#include "utils/Logger.h"
+#include <chrono>
+#include <iostream>
+
+using namespace Game;
+
+namespace
+{
+    // Default catalog items and merchants
+    constexpr uint32_t Sword = 1;
+    constexpr uint32_t Potion = 3;
+    constexpr uint32_t Blacksmith = 1;
+    constexpr uint32_t Trader = 3;
+}
+
+TEST_CASE("Global Economy - Price Table", "[game][economy]")
+{
+    GlobalEconomy economy;
+    REQUIRE(economy.Initialize());
+    economy.GetMerchant(Blacksmith)->inventory[Sword] = 10;
+    economy.GetMerchant(Trader)->inventory[Potion] = 100;
+    economy.AddPlayer(1);
+    economy.AddCurrency(1, CurrencyType::Gold, 10000);
+
+    REQUIRE(economy.CalculateBuyPrice(Sword, Blacksmith) == 50);
+    REQUIRE(economy.CalculateSellPrice(Sword, Blacksmith) == 25);
+    REQUIRE(economy.CalculateBuyPrice(Potion, Trader) == 10);
+    REQUIRE(economy.CalculateBuyPrice(99, Trader) == 0);
+    REQUIRE(economy.CalculateBuyPrice(Sword, 99) == 0);
+
+    SECTION("Trades charge the table price")
+    {
+        uint32_t gold = economy.GetCurrency(1, CurrencyType::Gold);
+        REQUIRE(economy.BuyItem(1, Trader, Potion, 3));
+        REQUIRE(economy.GetCurrency(1, CurrencyType::Gold) == gold - 30);
+        REQUIRE(economy.SellItem(1, Trader, Potion, 2));
+        REQUIRE(economy.GetCurrency(1, CurrencyType::Gold) == gold - 30 + 10);
+    }
+
+    SECTION("Every inflation step reaches the merchants")
+    {
+        economy.ApplyInflation(0.5f);
+        REQUIRE(economy.CalculateBuyPrice(Sword, Blacksmith) == 75);
+        REQUIRE(economy.GetMerchant(Blacksmith)->buyPrices[Sword] == 75);
+
+        economy.ApplyInflation(0.2f);
+        REQUIRE(economy.CalculateBuyPrice(Sword, Blacksmith) == 90);
+        REQUIRE(economy.CalculateSellPrice(Sword, Blacksmith) == 45);
+        REQUIRE(economy.GetMerchant(Blacksmith)->buyPrices[Sword] == 90);
+
+        uint32_t gold = economy.GetCurrency(1, CurrencyType::Gold);
+        REQUIRE(economy.BuyItem(1, Blacksmith, Sword, 1));
+        REQUIRE(economy.GetCurrency(1, CurrencyType::Gold) == gold - 90);
+    }
+
+    SECTION("Catalog changes invalidate the table")
+    {
+        REQUIRE(economy.BuyItem(1, Trader, Potion, 1));
+
+        ItemData elixir = EconomyUtils::CreateConsumable("Elixir", ItemRarity::Rare, 40, 1);
+        economy.AddItem(elixir);
+        uint32_t elixirId = economy.GetAllItems().back().itemId;
+        economy.GetMerchant(Trader)->inventory[elixirId] = 5;
+        REQUIRE(economy.CalculateBuyPrice(elixirId, Trader) == 40);
+
+        uint32_t gold = economy.GetCurrency(1, CurrencyType::Gold);
+        REQUIRE(economy.BuyItem(1, Trader, elixirId, 2));
+        REQUIRE(economy.GetCurrency(1, CurrencyType::Gold) == gold - 80);
+
+        economy.RemoveItem(elixirId);
+        REQUIRE(economy.CalculateBuyPrice(elixirId, Trader) == 0);
+    }
+
+    SECTION("Items with very large ids are priced from the catalog")
+    {
+        ItemData relic = EconomyUtils::CreateWeapon("Relic", ItemRarity::Legendary, 500, 5);
+        relic.itemId = 5000000;
+        economy.AddItem(relic);
+        economy.GetMerchant(Blacksmith)->inventory[relic.itemId] = 1;
+
+        REQUIRE(economy.CalculateBuyPrice(relic.itemId, Blacksmith) == 500);
+        uint32_t gold = economy.GetCurrency(1, CurrencyType::Gold);
+        REQUIRE(economy.BuyItem(1, Blacksmith, relic.itemId, 1));
+        REQUIRE(economy.GetCurrency(1, CurrencyType::Gold) == gold - 500);
+    }
+
+    SECTION("Replacing an item reprices it")
+    {
+        REQUIRE(economy.BuyItem(1, Blacksmith, Sword, 1));
+        ItemData sword = *economy.GetItem(Sword);
+        sword.value = 70;
+        economy.AddItem(sword);
+        REQUIRE(economy.CalculateBuyPrice(Sword, Blacksmith) == 70);
+    }
+
+    SECTION("Removed merchants quote nothing")
+    {
+        REQUIRE(economy.BuyItem(1, Trader, Potion, 1));
+        economy.RemoveMerchant(Trader);
+        REQUIRE(economy.CalculateBuyPrice(Potion, Trader) == 0);
+        REQUIRE_FALSE(economy.BuyItem(1, Trader, Potion, 1));
+    }
+}
+
+TEST_CASE("Global Economy - Price Quotes", "[game][economy][!benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int Rounds = 200000;
+
+    Logger::GetInstance().SetLogLevel(LogLevel::WARNING);
+    GlobalEconomy economy;
+    REQUIRE(economy.Initialize());
+    for (uint32_t i = 0; i < 60; ++i)
+    {
+        economy.AddItem(EconomyUtils::CreateMaterial("Material " + std::to_string(i), ItemRarity::Common, 5 + i, 1));
+    }
+    economy.GetMerchant(Trader)->inventory[Potion] = 1000000;
+    economy.GetMerchant(Trader)->goldAmount = 100000000;
+    economy.AddPlayer(1);
+    economy.AddCurrency(1, CurrencyType::Gold, 100000000);
+    economy.ApplyInflation(0.1f);
+
+    uint32_t itemCount = static_cast<uint32_t>(economy.GetAllItems().size());
+    uint64_t checksum = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < Rounds; ++i)
+    {
+        uint32_t itemId = i % itemCount + 1;
+        checksum += economy.CalculateBuyPrice(itemId, Trader) + economy.CalculateSellPrice(itemId, Trader);
+    }
+    std::chrono::duration<double> quotes = Clock::now() - start;
+
+    start = Clock::now();
+    for (int i = 0; i < Rounds / 2; ++i)
+    {
+        checksum += economy.BuyItem(1, Trader, Potion, 1) ? 1 : 0;
+        checksum += economy.SellItem(1, Trader, Potion, 1) ? 1 : 0;
+    }
+    std::chrono::duration<double> trades = Clock::now() - start;
+
+    std::cout << "Price quotes: " << 2 * Rounds / quotes.count() << " quotes/s, "
+              << Rounds / trades.count() << " buys and sells/s (checksum " << checksum << ")" << std::endl;
+    Logger::GetInstance().SetLogLevel(LogLevel::INFO);
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include "game/GlobalEconomy.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using namespace Game;
+
+namespace
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    MerchantData OverdueMerchant(uint32_t merchantId, std::chrono::minutes overdue)
+    {
+        MerchantData merchant;
+        merchant.merchantId = merchantId;
+        merchant.name = "Merchant " + std::to_string(merchantId);
+        merchant.location = "Novigrad";
+        merchant.lastRestock = Clock::now() - std::chrono::hours(1) - overdue;
+        return merchant;
+    }
+}
+
+TEST_CASE("Global Economy - Restock Schedule", "[game][economy]")
+{
+    GlobalEconomy economy;
+    REQUIRE(economy.Initialize());
+    std::vector<uint32_t> restocked;
+    economy.SetMerchantRestockedCallback([&](uint32_t merchantId) { restocked.push_back(merchantId); });
+
+    // The default merchants just joined and are not due for an hour
+    economy.ProcessEconomyUpdate(0.1f);
+    REQUIRE(restocked.empty());
+    REQUIRE(economy.GetNextRestockTime(1) > Clock::now() + std::chrono::minutes(59));
+
+    SECTION("Due merchants restock oldest first, within the budget")
+    {
+        for (uint32_t i = 0; i < 5; ++i)
+        {
+            economy.AddMerchant(OverdueMerchant(10 + i, std::chrono::minutes(5 + i)));
+        }
+        economy.SetRestockBudget(2);
+
+        economy.ProcessEconomyUpdate(0.1f);
+        REQUIRE(restocked == std::vector<uint32_t>{ 14, 13 });
+        economy.ProcessEconomyUpdate(0.1f);
+        economy.ProcessEconomyUpdate(0.1f);
+        economy.ProcessEconomyUpdate(0.1f);
+        REQUIRE(restocked == std::vector<uint32_t>{ 14, 13, 12, 11, 10 });
+
+        for (uint32_t merchantId : restocked)
+        {
+            REQUIRE(economy.GetNextRestockTime(merchantId) > Clock::now() + std::chrono::minutes(59));
+
+            // New stock is listed with prices
+            const MerchantData* merchant = economy.GetMerchant(merchantId);
+            for (const auto& pair : merchant->inventory)
+            {
+                REQUIRE(merchant->buyPrices.count(pair.first) == 1);
+            }
+        }
+    }
+
+    SECTION("Inactive merchants wait a full interval")
+    {
+        MerchantData closed = OverdueMerchant(20, std::chrono::minutes(1));
+        closed.isActive = false;
+        economy.AddMerchant(closed);
+        economy.ProcessEconomyUpdate(0.1f);
+        REQUIRE(restocked.empty());
+        REQUIRE(economy.GetNextRestockTime(20) > Clock::now() + std::chrono::minutes(59));
+    }
+
+    SECTION("The schedule follows the interval and the merchant list")
+    {
+        economy.SetMerchantRestockInterval(120.0f);
+        REQUIRE(economy.GetNextRestockTime(2) < Clock::now() + std::chrono::minutes(3));
+
+        economy.RemoveMerchant(2);
+        REQUIRE_FALSE(economy.GetNextRestockTime(2));
+    }
+}
+
+TEST_CASE("Global Economy - Restock Ticks", "[game][economy][!benchmark]")
+{
+    constexpr uint32_t Merchants = 4000;
+
+    Logger::GetInstance().SetLogLevel(LogLevel::WARNING);
+    for (uint32_t budget : { Merchants, 64u })
+    {
+        GlobalEconomy economy;
+        REQUIRE(economy.Initialize());
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            economy.AddItem(EconomyUtils::CreateMaterial("Material " + std::to_string(i), ItemRarity::Common, 5 + i, 1));
+        }
+        for (uint32_t i = 0; i < Merchants; ++i)
+        {
+            economy.AddMerchant(OverdueMerchant(100 + i, std::chrono::minutes(i % 60)));
+        }
+        economy.SetRestockBudget(budget);
+
+        // Every merchant is overdue at once, as after a long outage
+        uint32_t restocked = 0;
+        economy.SetMerchantRestockedCallback([&](uint32_t) { ++restocked; });
+        double worst = 0;
+        double idle = 0;
+        int ticks = 0;
+        while (true)
+        {
+            uint32_t before = restocked;
+            auto start = Clock::now();
+            economy.ProcessEconomyUpdate(0.05f);
+            double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (restocked == before)
+            {
+                idle = elapsed;
+                break;
+            }
+            worst = std::max(worst, elapsed);
+            ++ticks;
+        }
+
+        REQUIRE(restocked == Merchants);
+        std::cout << Merchants << " overdue merchants, budget " << budget << ": " << ticks
+                  << " ticks, worst " << worst << " ms, idle tick " << idle << " ms" << std::endl;
+    }
+    Logger::GetInstance().SetLogLevel(LogLevel::INFO);
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utils/HdrHistogram.h"
+#include <thread>
+#include <vector>
+
+TEST_CASE("HdrHistogram - Bucketing", "[utils][histogram]")
+{
+    SECTION("Small values are exact")
+    {
+        for (uint64_t v = 0; v < 2 * HdrHistogram::SubBucketCount; ++v)
+        {
+            REQUIRE(HdrHistogram::BucketIndex(v) == v);
+            REQUIRE(HdrHistogram::BucketUpperBound(v) == v);
+        }
+    }
+
+    SECTION("Buckets are contiguous and bound the relative error")
+    {
+        size_t previous = HdrHistogram::BucketIndex(63);
+        for (uint64_t v = 64; v < 1000000; ++v)
+        {
+            size_t index = HdrHistogram::BucketIndex(v);
+            REQUIRE((index == previous || index == previous + 1));
+            REQUIRE(HdrHistogram::BucketUpperBound(index) >= v);
+            REQUIRE(HdrHistogram::BucketUpperBound(index) - v <= v / HdrHistogram::SubBucketCount);
+            previous = index;
+        }
+    }
+
+    SECTION("Huge values are clamped into the last bucket")
+    {
+        REQUIRE(HdrHistogram::BucketIndex(UINT64_MAX) == HdrHistogram::BucketCount - 1);
+    }
+}
+
+TEST_CASE("HdrHistogram - Percentiles", "[utils][histogram]")
+{
+    HdrHistogram histogram;
+    REQUIRE(histogram.GetPercentile(50.0) == 0);
+
+    // 1..1000 us uniformly, plus one 50 ms outlier
+    for (uint64_t v = 1; v <= 1000; ++v)
+    {
+        histogram.Record(v);
+    }
+    histogram.Record(50000);
+
+    REQUIRE(histogram.GetCount() == 1001);
+    REQUIRE(histogram.GetMin() == 1);
+    REQUIRE(histogram.GetMax() == 50000);
+
+    uint64_t p50 = histogram.GetPercentile(50.0);
+    uint64_t p99 = histogram.GetPercentile(99.0);
+    REQUIRE(p50 >= 501);
+    REQUIRE(p50 <= 520);
+    REQUIRE(p99 >= 991);
+    REQUIRE(p99 <= 1023);
+    REQUIRE(histogram.GetPercentile(100.0) == 50000);
+
+    histogram.Reset();
+    REQUIRE(histogram.GetCount() == 0);
+    REQUIRE(histogram.GetMin() == 0);
+}
+
+TEST_CASE("HdrHistogram - Concurrent Recording", "[utils][histogram]")
+{
+    HdrHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&histogram, t]()
+        {
+            for (uint64_t i = 0; i < 10000; ++i)
+            {
+                histogram.Record(t * 100 + i % 100);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(histogram.GetCount() == 40000);
+    REQUIRE(histogram.GetMin() == 0);
+    REQUIRE(histogram.GetMax() == 399);
+}
+
+TEST_CASE("HdrHistogram - Merge", "[utils][histogram]")
+{
+    HdrHistogram low;
+    HdrHistogram high;
+    for (uint64_t v = 1; v <= 100; ++v)
+    {
+        low.Record(v);
+        high.Record(v + 1000);
+    }
+
+    HdrHistogram merged;
+    merged.Merge(low);
+    merged.Merge(high);
+    merged.Merge(HdrHistogram());
+
+    REQUIRE(merged.GetCount() == 200);
+    REQUIRE(merged.GetMin() == 1);
+    REQUIRE(merged.GetMax() == 1100);
+    REQUIRE(merged.GetMean() == (low.GetMean() + high.GetMean()) / 2.0);
+    REQUIRE(merged.GetPercentile(50.0) >= 100);
+    REQUIRE(merged.GetPercentile(50.0) <= 101);
+    REQUIRE(merged.GetPercentile(51.0) >= 1001);
+}
+
+TEST_CASE("PerThreadHdrHistogram - Sharded Recording", "[utils][histogram]")
+{
+    PerThreadHdrHistogram histogram;
+    REQUIRE(histogram.GetCount() == 0);
+    REQUIRE(histogram.GetPercentile(99.0) == 0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 12; ++t)
+    {
+        threads.emplace_back([&histogram, t]()
+        {
+            for (uint64_t i = 1; i <= 1000; ++i)
+            {
+                histogram.Record(i + t);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    HdrHistogram merged;
+    histogram.MergeInto(merged);
+    REQUIRE(merged.GetCount() == 12000);
+    REQUIRE(histogram.GetCount() == 12000);
+    REQUIRE(histogram.GetMax() == 1011);
+    REQUIRE(histogram.GetPercentile(50.0) == merged.GetPercentile(50.0));
+
+    histogram.Reset();
+    REQUIRE(histogram.GetCount() == 0);
+}
@@ -0,0 +1,263 @@
+#include <catch2/catch_test_macros.hpp>
+#include "game/GlobalEconomy.h"
+#include "game/ItemCatalog.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace Game;
+
+namespace
+{
+    ItemData MakeItem(uint32_t itemId, ItemType type, ItemRarity rarity, const std::string& description)
+    {
+        ItemData item;
+        item.itemId = itemId;
+        item.name = "Item " + std::to_string(itemId);
+        item.description = description;
+        item.type = type;
+        item.rarity = rarity;
+        item.value = itemId * 3;
+        item.weight = itemId % 17;
+        item.stackSize = 1 + itemId % 50;
+        item.isSellable = itemId % 5 != 0;
+        item.prices[static_cast<size_t>(CurrencyType::Gold)] = item.value;
+        item.prices[static_cast<size_t>(CurrencyType::Crowns)] = item.value * 2;
+        return item;
+    }
+
+    // Counts heap bytes, to size the map-of-structs layout the catalog replaced
+    size_t g_legacyBytes = 0;
+
+    template<typename T>
+    struct CountingAllocator
+    {
+        using value_type = T;
+        CountingAllocator() = default;
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+
+        T* allocate(size_t count)
+        {
+            g_legacyBytes += count * sizeof(T);
+            return std::allocator<T>().allocate(count);
+        }
+
+        void deallocate(T* pointer, size_t count)
+        {
+            g_legacyBytes -= count * sizeof(T);
+            std::allocator<T>().deallocate(pointer, count);
+        }
+
+        template<typename U>
+        bool operator==(const CountingAllocator<U>&) const { return true; }
+    };
+
+    using LegacyString = std::basic_string<char, std::char_traits<char>, CountingAllocator<char>>;
+
+    struct LegacyItem
+    {
+        uint32_t itemId;
+        LegacyString name;
+        LegacyString description;
+        ItemType type;
+        ItemRarity rarity;
+        uint32_t value;
+        uint32_t weight;
+        uint32_t stackSize;
+        bool isTradeable;
+        bool isSellable;
+        std::map<CurrencyType, uint32_t, std::less<CurrencyType>,
+                 CountingAllocator<std::pair<const CurrencyType, uint32_t>>> prices;
+    };
+
+    using LegacyCatalog = std::map<uint32_t, LegacyItem, std::less<uint32_t>,
+                                   CountingAllocator<std::pair<const uint32_t, LegacyItem>>>;
+}
+
+TEST_CASE("Item Catalog", "[game][economy]")
+{
+    ItemCatalog catalog;
+    const std::string shared = "Forged in the Skellige isles from meteorite steel";
+    REQUIRE_FALSE(catalog.Set(MakeItem(10, ItemType::Weapon, ItemRarity::Rare, shared)));
+    REQUIRE_FALSE(catalog.Set(MakeItem(4, ItemType::Armor, ItemRarity::Rare, shared)));
+    REQUIRE_FALSE(catalog.Set(MakeItem(7, ItemType::Weapon, ItemRarity::Common, "")));
+    REQUIRE_FALSE(catalog.Set(MakeItem(2, ItemType::Weapon, ItemRarity::Epic, shared)));
+    REQUIRE(catalog.Size() == 4);
+
+    SECTION("Items come back as they went in")
+    {
+        ItemData expected = MakeItem(10, ItemType::Weapon, ItemRarity::Rare, shared);
+        std::optional<ItemData> item = catalog.Get(10);
+        REQUIRE(item);
+        REQUIRE(item->name == expected.name);
+        REQUIRE(item->description == shared);
+        REQUIRE(item->type == expected.type);
+        REQUIRE(item->rarity == expected.rarity);
+        REQUIRE(item->value == expected.value);
+        REQUIRE(item->weight == expected.weight);
+        REQUIRE(item->stackSize == expected.stackSize);
+        REQUIRE(item->isSellable == expected.isSellable);
+        REQUIRE(item->prices == expected.prices);
+        REQUIRE_FALSE(catalog.Get(11));
+        REQUIRE(catalog.GetName(11).empty());
+        REQUIRE(catalog.GetWeight(11) == 0);
+    }
+
+    SECTION("Indexes list ids in order")
+    {
+        REQUIRE(catalog.GetIds() == std::vector<uint32_t>{ 2, 4, 7, 10 });
+        REQUIRE(catalog.GetIdsByType(ItemType::Weapon) == std::vector<uint32_t>{ 2, 7, 10 });
+        REQUIRE(catalog.GetIdsByRarity(ItemRarity::Rare) == std::vector<uint32_t>{ 4, 10 });
+        REQUIRE(catalog.GetIdsByType(ItemType::Quest).empty());
+        REQUIRE(catalog.GetIdsByType(static_cast<ItemType>(42)).empty());
+    }
+
+    SECTION("Replacing an item moves it between indexes")
+    {
+        REQUIRE(catalog.Set(MakeItem(7, ItemType::Quest, ItemRarity::Rare, "")));
+        REQUIRE(catalog.Size() == 4);
+        REQUIRE(catalog.GetIdsByType(ItemType::Weapon) == std::vector<uint32_t>{ 2, 10 });
+        REQUIRE(catalog.GetIdsByType(ItemType::Quest) == std::vector<uint32_t>{ 7 });
+        REQUIRE(catalog.GetIdsByRarity(ItemRarity::Rare) == std::vector<uint32_t>{ 4, 7, 10 });
+    }
+
+    SECTION("Removal keeps the other items intact")
+    {
+        REQUIRE(catalog.Remove(4));
+        REQUIRE_FALSE(catalog.Remove(4));
+        REQUIRE_FALSE(catalog.Contains(4));
+        REQUIRE(catalog.GetIds() == std::vector<uint32_t>{ 2, 7, 10 });
+        REQUIRE(catalog.GetIdsByRarity(ItemRarity::Rare) == std::vector<uint32_t>{ 10 });
+
+        // The last slot moved into the hole
+        REQUIRE(catalog.Get(2)->rarity == ItemRarity::Epic);
+        REQUIRE(catalog.Get(2)->description == shared);
+        REQUIRE(catalog.GetValue(7) == 21);
+    }
+
+    SECTION("Scaling values scales every price")
+    {
+        catalog.ScaleValues(1.5f);
+        REQUIRE(catalog.GetValue(10) == 45);
+        REQUIRE(catalog.Get(10)->prices[static_cast<size_t>(CurrencyType::Crowns)] == 90);
+    }
+}
+
+TEST_CASE("Global Economy - Catalog Queries", "[game][economy]")
+{
+    GlobalEconomy economy;
+    REQUIRE(economy.Initialize());
+
+    ItemData relic = EconomyUtils::CreateWeapon("Relic", ItemRarity::Legendary, 500, 5);
+    economy.AddItem(relic);
+
+    std::vector<ItemData> weapons = economy.GetItemsByType(ItemType::Weapon);
+    REQUIRE(weapons.size() == 2);
+    REQUIRE(weapons[0].name == "Iron Sword");
+    REQUIRE(weapons[1].name == "Relic");
+    REQUIRE(economy.GetItemIdsByType(ItemType::Weapon) == std::vector<uint32_t>{ 1, 5 });
+    REQUIRE(economy.GetItemIdsByRarity(ItemRarity::Legendary) == std::vector<uint32_t>{ 5 });
+    REQUIRE(economy.GetItemsByRarity(ItemRarity::Common).size() == 4);
+
+    // Default currency prices still follow the value
+    std::optional<ItemData> added = economy.GetItem(5);
+    REQUIRE(added);
+    REQUIRE(added->prices[static_cast<size_t>(CurrencyType::Silver)] == 5000);
+    REQUIRE(economy.GetStats().totalItems == 5);
+
+    // Replacing an item does not count it twice
+    economy.AddItem(*added);
+    REQUIRE(economy.GetStats().totalItems == 5);
+
+    economy.RemoveItem(1);
+    REQUIRE(economy.GetItemsByType(ItemType::Weapon).size() == 1);
+    REQUIRE_FALSE(economy.GetItem(1));
+}
+
+TEST_CASE("Item Catalog - 100k Items", "[game][economy][!benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t Items = 100000;
+    constexpr int Queries = 20;
+
+    // Names are unique, descriptions come from a small set as in real item tables
+    std::vector<std::string> descriptions;
+    for (int i = 0; i < 40; ++i)
+    {
+        descriptions.push_back("Common description number " + std::to_string(i) + " for crafting and trade goods");
+    }
+
+    ItemCatalog catalog;
+    LegacyCatalog legacy;
+    g_legacyBytes = 0;
+    for (uint32_t itemId = 1; itemId <= Items; ++itemId)
+    {
+        ItemData item = MakeItem(itemId, static_cast<ItemType>(itemId % ItemTypeCount),
+                                 static_cast<ItemRarity>(itemId % 7 % ItemRarityCount), descriptions[itemId % 40]);
+        catalog.Set(item);
+
+        LegacyItem& old = legacy[itemId];
+        old.itemId = itemId;
+        old.name = LegacyString(item.name.begin(), item.name.end());
+        old.description = LegacyString(item.description.begin(), item.description.end());
+        old.type = item.type;
+        old.rarity = item.rarity;
+        old.value = item.value;
+        old.weight = item.weight;
+        old.stackSize = item.stackSize;
+        old.isTradeable = item.isTradeable;
+        old.isSellable = item.isSellable;
+        for (size_t currency = 0; currency < CurrencyTypeCount; ++currency)
+        {
+            if (item.prices[currency] != 0)
+            {
+                old.prices[static_cast<CurrencyType>(currency)] = item.prices[currency];
+            }
+        }
+    }
+
+    // The old GetItemsByType: scan everything, copy the matches
+    size_t checksum = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < Queries; ++i)
+    {
+        std::vector<LegacyItem> matches;
+        for (const auto& pair : legacy)
+        {
+            if (pair.second.type == ItemType::Quest)
+            {
+                matches.push_back(pair.second);
+            }
+        }
+        checksum += matches.size();
+    }
+    std::chrono::duration<double, std::micro> scanned = Clock::now() - start;
+
+    start = Clock::now();
+    for (int i = 0; i < Queries; ++i)
+    {
+        std::vector<ItemData> matches;
+        for (uint32_t itemId : catalog.GetIdsByType(ItemType::Quest))
+        {
+            matches.push_back(*catalog.Get(itemId));
+        }
+        checksum += matches.size();
+    }
+    std::chrono::duration<double, std::micro> materialized = Clock::now() - start;
+
+    start = Clock::now();
+    for (int i = 0; i < Queries; ++i)
+    {
+        std::vector<uint32_t> ids = catalog.GetIdsByType(ItemType::Quest);
+        checksum += ids.size();
+    }
+    std::chrono::duration<double, std::micro> idsOnly = Clock::now() - start;
+
+    std::cout << Items << " items: map of structs " << g_legacyBytes / 1024 << " KiB, columns "
+              << catalog.MemoryUsage() / 1024 << " KiB" << std::endl;
+    std::cout << "  items of one type: scan and copy " << scanned.count() / Queries << " us, index and copy "
+              << materialized.count() / Queries << " us, ids only " << idsOnly.count() / Queries
+              << " us (checksum " << checksum << ")" << std::endl;
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include "optimization/JitterBuffer.h"
+#include <random>
+
+using namespace Optimization;
+
+TEST_CASE("ClockSync - Offset Estimation", "[network][clocksync]")
+{
+    ClockSync clockSync;
+    REQUIRE_FALSE(clockSync.IsSynchronized());
+
+    SECTION("Symmetric path recovers exact offset")
+    {
+        // Server clock runs 5 s ahead, 20 ms each way, 1 ms processing
+        const int64_t offset = 5000000;
+        for (int64_t i = 0; i < 4; ++i)
+        {
+            int64_t t0 = 1000000 * i;
+            int64_t t1 = t0 + 20000 + offset;
+            int64_t t2 = t1 + 1000;
+            int64_t t3 = t2 - offset + 20000;
+            clockSync.AddSample(t0, t1, t2, t3);
+        }
+
+        REQUIRE(clockSync.IsSynchronized());
+        REQUIRE(clockSync.GetOffset() == offset);
+        REQUIRE(clockSync.GetRoundTrip() == 40000);
+        REQUIRE(clockSync.ToLocalTime(clockSync.ToServerTime(123456)) == 123456);
+    }
+
+    SECTION("Lowest round trip sample wins")
+    {
+        // Queued sample: asymmetric 80 ms / 20 ms path skews its offset
+        clockSync.AddSample(0, 80000, 80000, 100000);
+        // Clean sample with a 10 ms round trip
+        clockSync.AddSample(1000000, 1005000, 1005000, 1010000);
+
+        REQUIRE(clockSync.GetRoundTrip() == 10000);
+        REQUIRE(clockSync.GetOffset() == 0);
+    }
+}
+
+TEST_CASE("JitterBuffer - Adaptive Delay", "[network][jitterbuffer]")
+{
+    JitterBufferConfig config;
+    config.minDelay = 0.01f;
+    config.maxDelay = 0.5f;
+
+    SECTION("Steady arrivals converge near the send interval")
+    {
+        JitterBuffer buffer(config);
+        for (int64_t i = 0; i < 200; ++i)
+        {
+            buffer.OnArrival(i * 50000, i * 50000);
+        }
+
+        REQUIRE(buffer.GetJitter() < 0.001f);
+        REQUIRE(buffer.GetDelay() > 0.045f);
+        REQUIRE(buffer.GetDelay() < 0.06f);
+    }
+
+    SECTION("Jittery arrivals increase the delay")
+    {
+        JitterBuffer steady(config);
+        JitterBuffer jittery(config);
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int64_t> noise(0, 30000);
+
+        for (int64_t i = 0; i < 200; ++i)
+        {
+            steady.OnArrival(i * 50000, i * 50000);
+            jittery.OnArrival(i * 50000 + noise(rng), i * 50000);
+        }
+
+        REQUIRE(jittery.GetJitter() > steady.GetJitter());
+        REQUIRE(jittery.GetDelay() > steady.GetDelay());
+    }
+
+    SECTION("Extrapolation above target widens the safety margin")
+    {
+        JitterBuffer buffer(config);
+        float initialSafety = buffer.GetSafetyFactor();
+
+        for (uint32_t i = 0; i < config.adaptationWindow; ++i)
+        {
+            buffer.RecordPlayout(i % 10 == 0);
+        }
+        REQUIRE(buffer.GetSafetyFactor() > initialSafety);
+
+        float raisedSafety = buffer.GetSafetyFactor();
+        for (uint32_t i = 0; i < config.adaptationWindow; ++i)
+        {
+            buffer.RecordPlayout(false);
+        }
+        REQUIRE(buffer.GetSafetyFactor() < raisedSafety);
+    }
+}
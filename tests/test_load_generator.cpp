@@ -0,0 +1,204 @@
+#include <catch2/catch_test_macros.hpp>
+#include "tools/LoadGenerator.h"
+#include "networking/net_server.h"
+#include <atomic>
+#include <thread>
+
+using namespace Networking;
+using namespace Tools;
+
+namespace
+{
+    // Minimal stand-in for Witcher3MPServer: the join handshake and ping echo
+    class LoopbackServer : public server_interface<MessageTypes>
+    {
+    public:
+        LoopbackServer() : server_interface<MessageTypes>(0) {}
+
+        uint16_t GetPort() const { return m_asioAcceptor.local_endpoint().port(); }
+
+        std::atomic<uint32_t> joins{ 0 };
+        std::atomic<uint32_t> moves{ 0 };
+        std::atomic<uint32_t> chats{ 0 };
+
+    protected:
+        bool OnClientConnect(std::shared_ptr<connection<MessageTypes>> client) override
+        {
+            message<MessageTypes> msg;
+            msg.header.id = MessageTypes::TC_REQUEST_PLAYERDATA;
+            MessageClient(client, msg);
+            return true;
+        }
+
+        void OnMessageReceived(std::shared_ptr<connection<MessageTypes>> client, message<MessageTypes>& msg) override
+        {
+            switch (msg.header.id)
+            {
+                case MessageTypes::ClientPing:
+                {
+                    // Same layout as the live server: t0 echoed under t1 and t2
+                    int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count();
+                    msg.header.id = MessageTypes::ServerPong;
+                    msg << now << now;
+                    MessageClient(client, msg);
+                    break;
+                }
+                case MessageTypes::TS_SEND_PLAYERDATA:
+                    joins++;
+                    break;
+                case MessageTypes::TS_NOTIFY_PLAYER_POS_CHANGE:
+                    moves++;
+                    break;
+                case MessageTypes::TS_CHAT_MESSAGE:
+                    chats++;
+                    break;
+                default:
+                    break;
+            }
+        }
+    };
+
+    LoadGeneratorConfig FastConfig(uint16_t port)
+    {
+        LoadGeneratorConfig config;
+        config.port = port;
+        config.initialBots = 4;
+        config.botStep = 4;
+        config.maxBots = 8;
+        config.stepDuration = std::chrono::milliseconds(600);
+        config.connectSpread = std::chrono::milliseconds(100);
+        config.joinTimeout = std::chrono::milliseconds(300);
+        config.moveInterval = std::chrono::milliseconds(50);
+        config.pingInterval = std::chrono::milliseconds(50);
+        config.chatInterval = std::chrono::milliseconds(200);
+        return config;
+    }
+}
+
+TEST_CASE("Load Generator - Bot Messages Match Server Decoding", "[tools][loadgen]")
+{
+    SECTION("Position change pops move type, then position")
+    {
+        auto msg = BotClient::BuildMove(1, Vector4F(10.0f, -4.0f, 2.0f));
+        REQUIRE(msg.header.id == MessageTypes::TS_NOTIFY_PLAYER_POS_CHANGE);
+        REQUIRE(msg.header.size == msg.body.size());
+
+        uint8_t moveType = 0;
+        Vector4F position;
+        msg >> moveType >> position;
+        REQUIRE(moveType == 1);
+        REQUIRE(position.x == 10.0f);
+        REQUIRE(position.y == -4.0f);
+        REQUIRE(msg.size() == 0);
+    }
+
+    SECTION("Player data pops character, then position")
+    {
+        auto msg = BotClient::BuildPlayerData(1, Vector4F(3.0f, 4.0f, 5.0f));
+        uint8_t characterId = 0;
+        Vector4F position;
+        msg >> characterId >> position;
+        REQUIRE(characterId == 1);
+        REQUIRE(position.z == 5.0f);
+    }
+
+    SECTION("Chat text survives the server's pop-and-reverse")
+    {
+        auto msg = BotClient::BuildChat("hello");
+        std::string text;
+        while (msg.size())
+        {
+            char ch;
+            msg >> ch;
+            text += ch;
+        }
+        REQUIRE(std::string(text.rbegin(), text.rend()) == "hello");
+    }
+
+    SECTION("Pong keeps the ping time under the server times")
+    {
+        auto sent = std::chrono::steady_clock::now();
+        auto msg = BotClient::BuildPing(sent);
+        REQUIRE(msg.header.id == MessageTypes::ClientPing);
+
+        std::chrono::steady_clock::time_point echoed;
+        REQUIRE_FALSE(BotClient::ReadPongSentTime(msg, echoed));
+
+        int64_t received = 1000;
+        int64_t replied = 1002;
+        msg << received << replied;
+        REQUIRE(BotClient::ReadPongSentTime(msg, echoed));
+        REQUIRE(echoed == sent);
+    }
+
+    SECTION("NPC hit carries the NPC ID")
+    {
+        auto msg = BotClient::BuildHitNpc(42);
+        uint32_t id = 0;
+        msg >> id;
+        REQUIRE(id == 42);
+    }
+}
+
+TEST_CASE("Load Generator - Loopback Ramp", "[tools][loadgen]")
+{
+    LoopbackServer server;
+    REQUIRE(server.Start());
+
+    std::atomic<bool> running{ true };
+    std::thread updater([&]()
+    {
+        while (running)
+        {
+            server.Update(-1, false);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    LoadGenerator generator(FastConfig(server.GetPort()));
+    uint32_t callbacks = 0;
+    auto reports = generator.Run([&](const LoadStepReport&) { callbacks++; });
+
+    running = false;
+    updater.join();
+    server.Stop();
+
+    REQUIRE(reports.size() == 2);
+    REQUIRE(callbacks == 2);
+    REQUIRE(reports[0].targetBots == 4);
+    REQUIRE(reports[1].targetBots == 8);
+    REQUIRE(reports[1].joinedBots == 8);
+    REQUIRE(reports[1].connectFailures == 0);
+    REQUIRE(reports[1].disconnects == 0);
+    REQUIRE(reports[1].rttSamples > 0);
+    REQUIRE(reports[1].rttMaxMs >= reports[1].rttP50Ms);
+    REQUIRE(reports[1].messagesReceived >= reports[1].rttSamples);
+    REQUIRE(reports[1].SentPerSecond() > 0.0);
+
+    REQUIRE(server.joins == 8);
+    REQUIRE(server.moves > 0);
+    REQUIRE(server.chats > 0);
+}
+
+TEST_CASE("Load Generator - Unreachable Server", "[tools][loadgen]")
+{
+    // Grab a free port, then release it so nothing is listening there
+    uint16_t port = 0;
+    {
+        asio::io_context context;
+        asio::ip::tcp::acceptor acceptor(context, asio::ip::tcp::endpoint(asio::ip::tcp::v4(), 0));
+        port = acceptor.local_endpoint().port();
+    }
+
+    LoadGeneratorConfig config = FastConfig(port);
+    config.maxBots = 4;
+
+    LoadGenerator generator(config);
+    auto reports = generator.Run();
+
+    REQUIRE(reports.size() == 1);
+    REQUIRE(reports[0].joinedBots == 0);
+    REQUIRE(reports[0].connectFailures == 4);
+    REQUIRE(reports[0].rttSamples == 0);
+}
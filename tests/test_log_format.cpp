@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utils/Logger.h"
+#include <string>
+#include <string_view>
+
+TEST_CASE("LogFormat - Placeholders", "[utils][logging]")
+{
+    SECTION("Arguments replace placeholders in order")
+    {
+        REQUIRE(LogFormat::Format("Sent {} bytes to {}", 42, "peer") == "Sent 42 bytes to peer");
+        REQUIRE(LogFormat::Format("{}{}", std::string("a"), std::string_view("b")) == "ab");
+        REQUIRE(LogFormat::Format("ok={} c={}", true, 'x') == "ok=true c=x");
+        REQUIRE(LogFormat::Format("ratio {}", 0.5f) == "ratio " + std::to_string(0.5f));
+    }
+
+    SECTION("Escaped braces and mismatched counts")
+    {
+        REQUIRE(LogFormat::Format("{{literal}} {}", 1) == "{literal} 1");
+        REQUIRE(LogFormat::Format("missing {} and {}", 1) == "missing 1 and {}");
+        REQUIRE(LogFormat::Format("surplus {}", 1, 2) == "surplus 1");
+        REQUIRE(LogFormat::Format("no placeholders") == "no placeholders");
+    }
+
+    SECTION("Captured strings outlive their source")
+    {
+        std::string text = "original";
+        auto captured = LogFormat::Capture(std::string_view(text));
+        text = "changed";
+        REQUIRE(captured == "original");
+    }
+}
+
+TEST_CASE("Logger - Filtering Before Evaluation", "[utils][logging]")
+{
+    Logger& logger = Logger::GetInstance();
+    int evaluations = 0;
+    auto expensive = [&evaluations]()
+    {
+        evaluations++;
+        return std::string("value");
+    };
+
+    SECTION("Disabled level skips argument evaluation")
+    {
+        logger.SetLogLevel(LogLevel::ERROR_LEVEL);
+        LOG_WARNING("Message " + expensive());
+        LOG_WARNINGF("Message {}", expensive());
+        REQUIRE(evaluations == 0);
+
+        LOG_ERRORF("Message {}", expensive());
+        REQUIRE(evaluations == 1);
+    }
+
+    SECTION("Disabled category skips argument evaluation")
+    {
+        logger.SetLogLevel(LogLevel::INFO);
+        logger.DisableCategory(LogCategory::NETWORK);
+        REQUIRE_FALSE(Logger::IsEnabled(LogLevel::CRITICAL, LogCategory::NETWORK));
+
+        LOG_CRITICAL_CAT(LogCategory::NETWORK, "Message " + expensive());
+        REQUIRE(evaluations == 0);
+
+        logger.EnableCategory(LogCategory::NETWORK, true);
+        REQUIRE(Logger::IsEnabled(LogLevel::INFO, LogCategory::NETWORK));
+    }
+
+    logger.SetLogLevel(LogLevel::INFO);
+    logger.FlushLogs();
+}
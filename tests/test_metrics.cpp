@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utils/Metrics.h"
+#include "utils/MetricsServer.h"
+#include <asio.hpp>
+#include <thread>
+
+namespace
+{
+    bool Contains(const std::string& text, const std::string& part)
+    {
+        return text.find(part) != std::string::npos;
+    }
+
+    // Plain HTTP/1.1 request; the server closes the connection after replying
+    std::string HttpGet(uint16_t port, const std::string& request)
+    {
+        asio::io_context context;
+        asio::ip::tcp::socket socket(context);
+        socket.connect(asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), port));
+        asio::write(socket, asio::buffer(request));
+
+        std::string response;
+        std::error_code ec;
+        char buffer[4096];
+        while (!ec)
+        {
+            size_t length = socket.read_some(asio::buffer(buffer), ec);
+            response.append(buffer, length);
+        }
+        return response;
+    }
+}
+
+TEST_CASE("Metrics - Exposition Format", "[utils][metrics]")
+{
+    SECTION("Samples of one name share a single HELP/TYPE block")
+    {
+        MetricsWriter writer;
+        writer.Counter("test_requests_total", "Requests", 3, { { "method", "get" } });
+        writer.Gauge("test_temperature", "Temperature", 21.5);
+        writer.Counter("test_requests_total", "Requests", 4, { { "method", "put" } });
+
+        std::string text = writer.Render();
+        REQUIRE(text ==
+            "# HELP test_requests_total Requests\n"
+            "# TYPE test_requests_total counter\n"
+            "test_requests_total{method=\"get\"} 3\n"
+            "test_requests_total{method=\"put\"} 4\n"
+            "# HELP test_temperature Temperature\n"
+            "# TYPE test_temperature gauge\n"
+            "test_temperature 21.5\n");
+    }
+
+    SECTION("Label values and help text are escaped")
+    {
+        MetricsWriter writer;
+        writer.Gauge("test_escaped", "Line\\one\nline two", 1, { { "path", "C:\\saves\n\"main\"" } });
+
+        std::string text = writer.Render();
+        REQUIRE(Contains(text, "# HELP test_escaped Line\\\\one\\nline two\n"));
+        REQUIRE(Contains(text, "test_escaped{path=\"C:\\\\saves\\n\\\"main\\\"\"} 1\n"));
+    }
+
+    SECTION("Summary exports scaled quantiles, sum and count")
+    {
+        HdrHistogram values;
+        for (uint64_t i = 1; i <= 100; ++i)
+        {
+            values.Record(1000);
+        }
+
+        MetricsWriter writer;
+        writer.Summary("test_latency_ms", "Latency", values, 0.5);
+
+        std::string text = writer.Render();
+        REQUIRE(Contains(text, "# TYPE test_latency_ms summary\n"));
+        REQUIRE(Contains(text, "test_latency_ms{quantile=\"0.5\"} 500\n"));
+        REQUIRE(Contains(text, "test_latency_ms{quantile=\"0.999\"} 500\n"));
+        REQUIRE(Contains(text, "test_latency_ms_sum 50000\n"));
+        REQUIRE(Contains(text, "test_latency_ms_count 100\n"));
+    }
+}
+
+TEST_CASE("Metrics - Registry", "[utils][metrics]")
+{
+    auto& registry = MetricsRegistry::GetInstance();
+
+    SECTION("Same name and labels return the same metric")
+    {
+        MetricCounter& first = registry.Counter("test_registry_hits_total", "Hits", { { "shard", "0" } });
+        MetricCounter& second = registry.Counter("test_registry_hits_total", "Hits", { { "shard", "0" } });
+        MetricCounter& other = registry.Counter("test_registry_hits_total", "Hits", { { "shard", "1" } });
+        REQUIRE(&first == &second);
+        REQUIRE(&first != &other);
+
+        first.Increment(5);
+        other.Increment();
+        std::string text = registry.Render();
+        REQUIRE(Contains(text, "test_registry_hits_total{shard=\"0\"} 5\n"));
+        REQUIRE(Contains(text, "test_registry_hits_total{shard=\"1\"} 1\n"));
+    }
+
+    SECTION("Concurrent increments are not lost")
+    {
+        MetricCounter& counter = registry.Counter("test_registry_concurrent_total", "Concurrent");
+        MetricGauge& gauge = registry.Gauge("test_registry_concurrent_gauge", "Concurrent");
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&]()
+            {
+                for (int i = 0; i < 10000; ++i)
+                {
+                    counter.Increment();
+                    gauge.Add(1.0);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(counter.Get() == 40000);
+        REQUIRE(gauge.Get() == 40000.0);
+    }
+
+    SECTION("Collectors run per scrape and stop when the registration goes")
+    {
+        size_t before = registry.GetCollectorCount();
+        int value = 7;
+        {
+            MetricsRegistration registration = registry.AddCollector("test_scope",
+                [&value](MetricsWriter& out) { out.Gauge("test_collected", "Collected", value); });
+            REQUIRE(registration.IsRegistered());
+            REQUIRE(registry.GetCollectorCount() == before + 1);
+            REQUIRE(Contains(registry.Render(), "test_collected 7\n"));
+
+            value = 9;
+            REQUIRE(Contains(registry.Render(), "test_collected 9\n"));
+        }
+
+        REQUIRE(registry.GetCollectorCount() == before);
+        REQUIRE_FALSE(Contains(registry.Render(), "test_collected"));
+    }
+
+    SECTION("Collectors sharing a scope are told apart by instance_id")
+    {
+        auto collect = [](MetricsWriter& out) { out.Gauge("test_shared_scope", "Shared", 1); };
+        MetricsRegistration first = registry.AddCollector("test_shared", collect);
+        MetricsRegistration second = registry.AddCollector("test_shared", collect);
+
+        std::string text = registry.Render();
+        REQUIRE(Contains(text, "test_shared_scope{instance_id=\"0\"} 1\n"));
+        REQUIRE(Contains(text, "test_shared_scope{instance_id=\"1\"} 1\n"));
+
+        second.Reset();
+        REQUIRE(Contains(registry.Render(), "test_shared_scope 1\n"));
+    }
+
+    SECTION("Histograms export in their configured unit")
+    {
+        MetricHistogram& histogram = registry.Histogram("test_registry_wait_seconds", "Wait", 1e-3);
+        histogram.Record(250);
+        REQUIRE(Contains(registry.Render(), "test_registry_wait_seconds_count 1\n"));
+        REQUIRE(Contains(registry.Render(), "test_registry_wait_seconds{quantile=\"0.5\"} 0.25"));
+    }
+}
+
+TEST_CASE("Metrics - HTTP Endpoint", "[utils][metrics]")
+{
+    MetricsRegistry::GetInstance().Counter("test_http_scraped_total", "Scrape marker").Increment(42);
+
+    MetricsServer server;
+    REQUIRE(server.Start(0));
+    REQUIRE(server.IsRunning());
+    REQUIRE(server.GetPort() != 0);
+
+    SECTION("GET /metrics returns the exposition")
+    {
+        std::string response = HttpGet(server.GetPort(), "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+        REQUIRE(response.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+        REQUIRE(Contains(response, "Content-Type: text/plain; version=0.0.4"));
+        REQUIRE(Contains(response, "test_http_scraped_total 42\n"));
+        REQUIRE(server.GetScrapeCount() == 1);
+    }
+
+    SECTION("Unknown paths and methods are rejected")
+    {
+        REQUIRE(HttpGet(server.GetPort(), "GET / HTTP/1.1\r\n\r\n").rfind("HTTP/1.1 404", 0) == 0);
+        REQUIRE(HttpGet(server.GetPort(), "POST /metrics HTTP/1.1\r\n\r\n").rfind("HTTP/1.1 405", 0) == 0);
+        REQUIRE(server.GetScrapeCount() == 0);
+    }
+
+    server.Stop();
+    REQUIRE_FALSE(server.IsRunning());
+}
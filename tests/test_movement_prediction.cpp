@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "optimization/MovementPrediction.h"
+#include <cmath>
+#include <string>
+
+using namespace Optimization;
+
+namespace
+{
+    MovementInput MakeInput(uint32_t inputId, float velocityX)
+    {
+        MovementInput input;
+        input.inputId = inputId;
+        input.velocity = Vector4F{velocityX, 0.0f, 0.0f, 0.0f};
+        input.isMoving = true;
+        return input;
+    }
+}
+
+TEST_CASE("MovementPrediction - Ring Buffer History", "[prediction]")
+{
+    PredictionConfig config;
+    config.inputBufferSize = 8;
+
+    MovementPrediction prediction;
+    REQUIRE(prediction.Initialize(config));
+
+    for (uint32_t i = 1; i <= 20; ++i)
+    {
+        prediction.AddInput(MakeInput(i, 1.0f));
+        prediction.ProcessInputs(0.1f);
+    }
+
+    // Only the last capacity inputs remain addressable
+    REQUIRE_FALSE(prediction.IsStatePredicted(1));
+    REQUIRE_FALSE(prediction.IsStatePredicted(12));
+    REQUIRE(prediction.IsStatePredicted(13));
+    REQUIRE(prediction.IsStatePredicted(20));
+    REQUIRE(std::abs(prediction.GetCurrentPosition().x - 2.0f) < 0.001f);
+}
+
+TEST_CASE("MovementPrediction - Rewind And Replay Reconciliation", "[prediction][reconciliation]")
+{
+    PredictionConfig config;
+    config.enableSmoothing = false;
+    config.reconciliationThreshold = 0.1f;
+
+    MovementPrediction prediction;
+    REQUIRE(prediction.Initialize(config));
+    prediction.SetCurrentState(Vector4F{0.0f, 0.0f, 0.0f, 1.0f}, Vector4F(), 0.0f);
+
+    for (uint32_t i = 1; i <= 10; ++i)
+    {
+        prediction.AddInput(MakeInput(i, 1.0f));
+        prediction.ProcessInputs(0.1f);
+    }
+    REQUIRE(std::abs(prediction.GetCurrentPosition().x - 1.0f) < 0.001f);
+
+    SECTION("Matching server state needs no replay")
+    {
+        prediction.ReconcileWithServer(5, prediction.GetPredictedPosition(5u), 0.0f);
+        prediction.AddInput(MakeInput(11, 1.0f));
+        prediction.ProcessInputs(0.1f);
+
+        auto stats = prediction.GetStats();
+        REQUIRE(stats.successfulPredictions == 1);
+        REQUIRE(stats.replays == 0);
+    }
+
+    SECTION("Diverged server state replays only unacked inputs")
+    {
+        // Server ended input 5 one unit further along
+        prediction.ReconcileWithServer(5, Vector4F{1.5f, 0.0f, 0.0f, 1.0f}, 0.0f);
+        prediction.AddInput(MakeInput(11, 1.0f));
+        prediction.ProcessInputs(0.1f);
+
+        auto stats = prediction.GetStats();
+        REQUIRE(stats.replays == 1);
+        REQUIRE(stats.maxReplayDepth == 6);
+        REQUIRE(stats.maxCorrectionMagnitude > 0.9f);
+        REQUIRE(std::abs(prediction.GetCurrentPosition().x - 2.1f) < 0.001f);
+    }
+
+    SECTION("Older acknowledgements are ignored")
+    {
+        prediction.ReconcileWithServer(8, prediction.GetPredictedPosition(8u), 0.0f);
+        prediction.ReconcileWithServer(3, Vector4F{100.0f, 0.0f, 0.0f, 1.0f}, 0.0f);
+        prediction.ProcessInputs(0.1f);
+
+        REQUIRE(prediction.GetStats().replays == 0);
+    }
+}
+
+TEST_CASE("MovementPredictionManager - Parallel Matches Serial", "[prediction][manager]")
+{
+    MovementPredictionManager serial;
+    MovementPredictionManager parallel;
+    parallel.SetWorkerThreads(4);
+    parallel.SetParallelThreshold(1);
+
+    for (uint32_t playerId = 1; playerId <= 300; ++playerId)
+    {
+        serial.AddPlayer(playerId);
+        parallel.AddPlayer(playerId);
+    }
+
+    // Removal keeps storage dense and lookups valid
+    serial.RemovePlayer(7);
+    parallel.RemovePlayer(7);
+    REQUIRE(parallel.GetPlayerCount() == 299);
+    REQUIRE_FALSE(parallel.HasPlayer(7));
+    REQUIRE(parallel.HasPlayer(300));
+
+    for (uint32_t tick = 1; tick <= 30; ++tick)
+    {
+        for (uint32_t playerId = 1; playerId <= 300; ++playerId)
+        {
+            MovementInput input = MakeInput(tick, static_cast<float>(playerId % 13));
+            serial.AddPlayerInput(playerId, input);
+            parallel.AddPlayerInput(playerId, input);
+        }
+        serial.ProcessAllInputs(1.0f / 60.0f);
+        parallel.ProcessAllInputs(1.0f / 60.0f);
+    }
+
+    for (uint32_t playerId = 1; playerId <= 300; ++playerId)
+    {
+        REQUIRE(serial.GetPlayerPrediction(playerId, 0.0f).position.x == 
+                parallel.GetPlayerPrediction(playerId, 0.0f).position.x);
+    }
+}
+
+TEST_CASE("MovementPredictionManager - Per-Tick Cost", "[prediction][manager][!benchmark]")
+{
+    for (uint32_t playerCount : {100u, 250u, 500u, 1000u})
+    {
+        for (size_t threads : {size_t(0), size_t(4)})
+        {
+            MovementPredictionManager manager;
+            manager.SetWorkerThreads(threads);
+            for (uint32_t playerId = 1; playerId <= playerCount; ++playerId)
+            {
+                manager.AddPlayer(playerId);
+            }
+
+            uint32_t inputId = 0;
+            BENCHMARK(std::to_string(playerCount) + " players, " + std::to_string(threads) + " workers")
+            {
+                ++inputId;
+                for (uint32_t playerId = 1; playerId <= playerCount; ++playerId)
+                {
+                    manager.AddPlayerInput(playerId, MakeInput(inputId, 1.0f));
+                }
+                manager.ProcessAllInputs(1.0f / 60.0f);
+            };
+        }
+    }
+}
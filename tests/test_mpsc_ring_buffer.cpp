@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utils/BlockPool.h"
+#include "utils/MpscRingBuffer.h"
+#include <thread>
+#include <vector>
+
+TEST_CASE("MpscRingBuffer - Single Thread", "[utils][mpsc]")
+{
+    MpscRingBuffer<int> ring(5);
+    REQUIRE(ring.Capacity() == 8);
+    REQUIRE(ring.EmptyApprox());
+
+    SECTION("FIFO order and full detection")
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(ring.TryEnqueue(int(i)));
+        }
+        REQUIRE_FALSE(ring.TryEnqueue(99));
+        REQUIRE(ring.SizeApprox() == 8);
+
+        int value = -1;
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(ring.TryDequeue(value));
+            REQUIRE(value == i);
+        }
+        REQUIRE_FALSE(ring.TryDequeue(value));
+    }
+
+    SECTION("Bulk dequeue respects the limit and wraps")
+    {
+        std::vector<int> out;
+        for (int round = 0; round < 3; ++round)
+        {
+            for (int i = 0; i < 6; ++i)
+            {
+                REQUIRE(ring.TryEnqueue(round * 10 + i));
+            }
+
+            out.clear();
+            REQUIRE(ring.DequeueBulk([&out](int&& v) { out.push_back(v); }, 4) == 4);
+            REQUIRE(ring.DequeueBulk([&out](int&& v) { out.push_back(v); }, 4) == 2);
+            REQUIRE(out == std::vector<int>{ round * 10, round * 10 + 1, round * 10 + 2,
+                                             round * 10 + 3, round * 10 + 4, round * 10 + 5 });
+        }
+        REQUIRE(ring.EmptyApprox());
+    }
+}
+
+TEST_CASE("MpscRingBuffer - Concurrent Producers", "[utils][mpsc]")
+{
+    const int producers = 4;
+    const int perProducer = 20000;
+    MpscRingBuffer<int> ring(256);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&ring, p]()
+        {
+            for (int i = 0; i < perProducer; ++i)
+            {
+                while (!ring.TryEnqueue(p * perProducer + i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Every value arrives exactly once and in order per producer
+    std::vector<int> next(producers, 0);
+    int received = 0;
+    while (received < producers * perProducer)
+    {
+        received += static_cast<int>(ring.DequeueBulk([&next](int&& v)
+        {
+            int producer = v / perProducer;
+            REQUIRE(v % perProducer == next[producer]);
+            next[producer]++;
+        }, 64));
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(ring.EmptyApprox());
+}
+
+TEST_CASE("BlockPool - Pooled Buffers", "[utils][pool]")
+{
+    BlockPool pool(32, 4);
+    REQUIRE(pool.GetFreeBlocks() == 4);
+
+    SECTION("Blocks are reused and released on destruction")
+    {
+        {
+            PooledBuffer a = pool.Allocate(16);
+            PooledBuffer b = pool.Allocate(32);
+            REQUIRE(a.IsPooled());
+            REQUIRE(b.IsPooled());
+            REQUIRE(a.size() == 16);
+            REQUIRE(a.data()[0] == 0);
+            REQUIRE(pool.GetFreeBlocks() == 2);
+
+            PooledBuffer moved = std::move(a);
+            REQUIRE(a.empty());
+            REQUIRE(moved.size() == 16);
+            REQUIRE(pool.GetFreeBlocks() == 2);
+        }
+        REQUIRE(pool.GetFreeBlocks() == 4);
+    }
+
+    SECTION("Oversized and exhausted requests fall back to the heap")
+    {
+        PooledBuffer big = pool.Allocate(64);
+        REQUIRE_FALSE(big.IsPooled());
+        REQUIRE(big.size() == 64);
+
+        std::vector<PooledBuffer> held;
+        for (int i = 0; i < 5; ++i)
+        {
+            held.push_back(pool.Allocate(8));
+        }
+        REQUIRE_FALSE(held.back().IsPooled());
+        REQUIRE(pool.GetFreeBlocks() == 0);
+        REQUIRE(pool.GetHeapFallbacks() == 2);
+
+        held.clear();
+        REQUIRE(pool.GetFreeBlocks() == 4);
+    }
+
+    SECTION("Concurrent allocate and release keeps the free list intact")
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&pool]()
+            {
+                for (int i = 0; i < 20000; ++i)
+                {
+                    PooledBuffer buffer = pool.Allocate(8);
+                    buffer.data()[0] = 1;
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        REQUIRE(pool.GetFreeBlocks() == 4);
+    }
+}
@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+#include "optimization/PositionInterpolation.h"
+
+using namespace Optimization;
+
+namespace
+{
+    // Snapshots every 100 ms ending now, moving one unit along x each time
+    void AddTrack(PositionInterpolation& interpolation, uint32_t playerId)
+    {
+        auto now = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 4; ++i)
+        {
+            PositionSnapshot snapshot;
+            snapshot.playerId = playerId;
+            snapshot.position = Vector4F(static_cast<float>(i), 0.0f, 0.0f);
+            snapshot.timestamp = now - std::chrono::milliseconds(100 * (3 - i));
+            snapshot.sequenceNumber = i;
+            snapshot.isValid = true;
+            interpolation.AddPositionSnapshot(snapshot);
+        }
+    }
+}
+
+TEST_CASE("PositionInterpolation - Playout Offset", "[network][interpolation]")
+{
+    InterpolationConfig config;
+    config.type = InterpolationType::Linear;
+    config.duration = 1.0f;
+    config.smoothing = 0.0f;
+    config.enableAdaptivePlayout = false;
+
+    PositionInterpolation interpolation;
+    REQUIRE(interpolation.Initialize(config));
+    AddTrack(interpolation, 1);
+
+    SECTION("The offset picks the point in the track")
+    {
+        // Half way between the second and third snapshots, give or take the
+        // time this test takes to get here
+        InterpolatedPosition delayed = interpolation.InterpolatePosition(1, 0.15f);
+        REQUIRE(delayed.position.x > 1.4f);
+        REQUIRE(delayed.position.x < 1.8f);
+        REQUIRE_FALSE(delayed.isExtrapolated);
+
+        InterpolatedPosition older = interpolation.InterpolatePosition(1, 0.25f);
+        REQUIRE(older.position.x > 0.4f);
+        REQUIRE(older.position.x < 0.8f);
+    }
+
+    SECTION("Without an offset playout runs past the newest snapshot")
+    {
+        InterpolatedPosition current = interpolation.InterpolatePosition(1, 0.0f);
+        REQUIRE(current.position.x == 3.0f);
+        REQUIRE(current.isExtrapolated);
+    }
+}
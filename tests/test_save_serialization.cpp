@@ -0,0 +1,730 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "game/SaveSerialization.h"
+#include "utils/CopyOnWrite.h"
+#include <atomic>
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+using namespace Game;
+
+namespace
+{
+    MonsterAIData MakeMonster(uint32_t id)
+    {
+        MonsterAIData monster;
+        monster.monsterId = id;
+        monster.monsterName = "Drowner " + std::to_string(id);
+        monster.type = MonsterType::Hybrid;
+        monster.pattern = BehaviorPattern::Pack;
+        monster.currentState = MonsterAIState::Patrolling;
+        monster.position = Vector4F(id * 1.5f, -id * 0.25f, 12.0f, 1.0f);
+        monster.velocity = Vector4F(0.5f, 0.0f, -0.5f);
+        monster.rotation = 1.25f;
+        monster.health = 80.0f + (id % 20);
+        monster.targetPlayerId = id % 7;
+        monster.threatList = { id % 7, (id + 3) % 7 };
+        monster.lastStateChange = std::chrono::high_resolution_clock::time_point(std::chrono::seconds(1700000000 + id));
+        monster.needsSync = (id % 2) == 0;
+        return monster;
+    }
+
+    // 10k monsters plus merchants and quests, as a large world would have
+    WorldSaveData MakeWorld(uint32_t monsterCount)
+    {
+        WorldSaveData world;
+        world.worldId = 3;
+        world.worldName = "Velen";
+        world.lastUpdate = std::chrono::high_resolution_clock::time_point(std::chrono::seconds(1700000000));
+        for (uint32_t i = 1; i <= monsterCount; ++i)
+        {
+            world.monsters[i] = MakeMonster(i);
+        }
+        for (uint32_t i = 1; i <= 50; ++i)
+        {
+            MerchantData merchant;
+            merchant.merchantId = i;
+            merchant.name = "Merchant " + std::to_string(i);
+            merchant.location = "Novigrad";
+            for (uint32_t item = 1; item <= 40; ++item)
+            {
+                merchant.inventory[item] = item * 2;
+                merchant.buyPrices[item] = item * 10;
+                merchant.sellPrices[item] = item * 8;
+            }
+            world.merchants[i] = merchant;
+        }
+        for (uint32_t i = 1; i <= 200; ++i)
+        {
+            QuestData quest;
+            quest.questId = i;
+            quest.name = "Contract " + std::to_string(i);
+            quest.description = "A monster plagues the village.";
+            quest.state = QuestState::InProgress;
+            QuestObjective objective;
+            objective.objectiveId = 1;
+            objective.description = "Slay the beast";
+            objective.type = "kill";
+            objective.target = "monster_" + std::to_string(i);
+            quest.objectives.push_back(objective);
+            quest.participants = { 1, 2 };
+            world.quests.push_back(quest);
+        }
+        world.worldStates["bridge_repaired"] = true;
+        world.worldStates["ferry_running"] = false;
+        return world;
+    }
+
+    // Baseline for the benchmark: the same monster data as hand-written JSON
+    void AppendNumber(std::string& out, double value)
+    {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        out.append(buffer, result.ptr);
+    }
+
+    std::string MonstersToJson(const std::map<uint32_t, MonsterAIData>& monsters)
+    {
+        std::string out = "{\"monsters\":[";
+        for (const auto& pair : monsters)
+        {
+            const MonsterAIData& m = pair.second;
+            out += "{\"id\":";
+            AppendNumber(out, m.monsterId);
+            out += ",\"name\":\"" + m.monsterName + "\",\"type\":";
+            AppendNumber(out, static_cast<int>(m.type));
+            out += ",\"position\":[";
+            AppendNumber(out, m.position.x);
+            out += ",";
+            AppendNumber(out, m.position.y);
+            out += ",";
+            AppendNumber(out, m.position.z);
+            out += "],\"health\":";
+            AppendNumber(out, m.health);
+            out += ",\"maxHealth\":";
+            AppendNumber(out, m.maxHealth);
+            out += ",\"stamina\":";
+            AppendNumber(out, m.stamina);
+            out += ",\"rotation\":";
+            AppendNumber(out, m.rotation);
+            out += ",\"target\":";
+            AppendNumber(out, m.targetPlayerId);
+            out += ",\"threats\":[";
+            for (size_t i = 0; i < m.threatList.size(); ++i)
+            {
+                out += i == 0 ? "" : ",";
+                AppendNumber(out, m.threatList[i]);
+            }
+            out += "],\"lastStateChange\":";
+            AppendNumber(out, static_cast<double>(m.lastStateChange.time_since_epoch().count()));
+            out += m.needsSync ? ",\"needsSync\":true}," : ",\"needsSync\":false},";
+        }
+        out.back() = ']';
+        out += "}";
+        return out;
+    }
+}
+
+TEST_CASE("Binary Archive - Encoding", "[utils][serialization]")
+{
+    SECTION("Varints, zigzag, floats and strings round-trip")
+    {
+        BinaryWriter writer;
+        writer.WriteVarUInt(0);
+        writer.WriteVarUInt(127);
+        writer.WriteVarUInt(128);
+        writer.WriteVarUInt(UINT64_MAX);
+        writer.WriteVarInt(-1);
+        writer.WriteVarInt(INT64_MIN);
+        writer.WriteFloat(-2.5f);
+        writer.WriteString("Kaer Morhen");
+        writer.WriteBool(true);
+
+        // 1 + 1 + 2 + 10 bytes of unsigned varints; -1 zigzags to a single byte
+        REQUIRE(writer.GetBuffer()[4] == 0xFF);
+        REQUIRE(writer.GetBuffer()[14] == 0x01);
+
+        BinaryReader reader(writer.GetBuffer());
+        REQUIRE(reader.ReadVarUInt() == 0);
+        REQUIRE(reader.ReadVarUInt() == 127);
+        REQUIRE(reader.ReadVarUInt() == 128);
+        REQUIRE(reader.ReadVarUInt() == UINT64_MAX);
+        REQUIRE(reader.ReadVarInt() == -1);
+        REQUIRE(reader.ReadVarInt() == INT64_MIN);
+        REQUIRE(reader.ReadFloat() == -2.5f);
+        REQUIRE(reader.ReadString() == "Kaer Morhen");
+        REQUIRE(reader.ReadBool());
+        REQUIRE(reader.AtEnd());
+        REQUIRE(reader.IsValid());
+    }
+
+    SECTION("Truncated input fails instead of reading past the end")
+    {
+        BinaryWriter writer;
+        writer.WriteString("Novigrad");
+        std::vector<uint8_t> data = writer.TakeBuffer();
+        data.resize(data.size() - 1);
+
+        BinaryReader reader(data);
+        REQUIRE(reader.ReadString().empty());
+        REQUIRE_FALSE(reader.IsValid());
+        REQUIRE(reader.ReadVarUInt() == 0);
+    }
+
+    SECTION("Long records widen their length prefix")
+    {
+        BinaryWriter writer;
+        size_t record = writer.BeginRecord();
+        writer.WriteString(std::string(300, 'x'));
+        writer.EndRecord(record);
+        writer.WriteVarUInt(42);
+
+        BinaryReader reader(writer.GetBuffer());
+        BinaryReader body = reader.ReadRecord();
+        REQUIRE(body.ReadString().size() == 300);
+        REQUIRE(body.AtEnd());
+        REQUIRE(reader.ReadVarUInt() == 42);
+    }
+}
+
+TEST_CASE("Save Serialization - Round Trips", "[game][serialization]")
+{
+    SECTION("Player")
+    {
+        PlayerSaveData player;
+        player.playerId = 7;
+        player.playerName = "Geralt";
+        player.position = Vector4F(1.0f, 2.0f, 3.0f, 0.5f);
+        player.level = 34;
+        player.experience = 12345;
+        player.inventory[101] = 3;
+        player.currencies[CurrencyType::Crowns] = 900;
+        player.completedQuests = { 1, 2, 3 };
+
+        BinaryWriter writer;
+        SaveSerialization::WritePlayer(writer, player);
+        BinaryReader reader(writer.GetBuffer());
+        PlayerSaveData loaded;
+        REQUIRE(SaveSerialization::ReadPlayer(reader, loaded));
+        REQUIRE(loaded.playerName == "Geralt");
+        REQUIRE(loaded.position.w == 0.5f);
+        REQUIRE(loaded.inventory == player.inventory);
+        REQUIRE(loaded.currencies == player.currencies);
+        REQUIRE(loaded.completedQuests == player.completedQuests);
+    }
+
+    SECTION("Item catalog keeps per-currency prices")
+    {
+        std::map<uint32_t, ItemData> items;
+        ItemData& sword = items[1];
+        sword.itemId = 1;
+        sword.name = "Iron Sword";
+        sword.type = ItemType::Weapon;
+        sword.value = 50;
+        sword.prices[static_cast<size_t>(CurrencyType::Gold)] = 50;
+        sword.prices[static_cast<size_t>(CurrencyType::Crowns)] = 120;
+
+        BinaryWriter writer;
+        SaveSerialization::WriteItems(writer, items);
+        BinaryReader reader(writer.GetBuffer());
+        std::map<uint32_t, ItemData> loaded;
+        REQUIRE(SaveSerialization::ReadItems(reader, loaded));
+        REQUIRE(loaded.size() == 1);
+        REQUIRE(loaded[1].name == "Iron Sword");
+        REQUIRE(loaded[1].type == ItemType::Weapon);
+        REQUIRE(loaded[1].prices == sword.prices);
+    }
+
+    SECTION("World with nested monsters, merchants and quests")
+    {
+        WorldSaveData world = MakeWorld(100);
+        BinaryWriter writer;
+        SaveSerialization::WriteWorld(writer, world);
+
+        BinaryReader reader(writer.GetBuffer());
+        WorldSaveData loaded;
+        REQUIRE(SaveSerialization::ReadWorld(reader, loaded));
+        REQUIRE(loaded.worldName == "Velen");
+        REQUIRE(loaded.monsters.size() == 100);
+        REQUIRE(loaded.monsters[42].monsterName == "Drowner 42");
+        REQUIRE(loaded.monsters[42].threatList == world.monsters[42].threatList);
+        REQUIRE(loaded.monsters[42].lastStateChange == world.monsters[42].lastStateChange);
+        REQUIRE(loaded.merchants[5].sellPrices == world.merchants[5].sellPrices);
+        REQUIRE(loaded.quests.size() == 200);
+        REQUIRE(loaded.quests[9].objectives[0].target == "monster_10");
+        REQUIRE(loaded.worldStates == world.worldStates);
+    }
+
+    SECTION("Economy, progression and groups")
+    {
+        std::map<uint32_t, PlayerEconomyData> economies;
+        economies[1].playerId = 1;
+        economies[1].currencies[CurrencyType::Gold] = 50;
+        economies[1].transactionHistory = { 9, 10 };
+
+        std::map<uint32_t, PlayerProgressionData> progressions;
+        progressions[1].playerId = 1;
+        progressions[1].skills[4].name = "Whirl";
+        progressions[1].skills[4].prerequisites = { 2 };
+
+        std::map<uint32_t, QuestGroup> groups;
+        groups[2].name = "Wolves";
+        groups[2].questStates[11] = QuestState::Completed;
+
+        // All three in one archive; each reader finds its own section
+        BinaryWriter writer;
+        SaveSerialization::WriteEconomy(writer, economies);
+        SaveSerialization::WriteProgression(writer, progressions);
+        SaveSerialization::WriteGroups(writer, groups);
+
+        std::map<uint32_t, PlayerEconomyData> loadedEconomies;
+        std::map<uint32_t, PlayerProgressionData> loadedProgressions;
+        std::map<uint32_t, QuestGroup> loadedGroups;
+        BinaryReader economyReader(writer.GetBuffer());
+        BinaryReader progressionReader(writer.GetBuffer());
+        BinaryReader groupReader(writer.GetBuffer());
+        REQUIRE(SaveSerialization::ReadEconomy(economyReader, loadedEconomies));
+        REQUIRE(SaveSerialization::ReadProgression(progressionReader, loadedProgressions));
+        REQUIRE(SaveSerialization::ReadGroups(groupReader, loadedGroups));
+        REQUIRE(loadedEconomies[1].currencies == economies[1].currencies);
+        REQUIRE(loadedEconomies[1].transactionHistory == economies[1].transactionHistory);
+        REQUIRE(loadedProgressions[1].skills[4].name == "Whirl");
+        REQUIRE(loadedProgressions[1].skills[4].prerequisites == std::vector<uint32_t>{ 2 });
+        REQUIRE(loadedGroups[2].questStates[11] == QuestState::Completed);
+
+        BinaryReader missing(writer.GetBuffer());
+        std::vector<QuestData> quests;
+        REQUIRE_FALSE(SaveSerialization::ReadQuests(missing, quests));
+    }
+}
+
+TEST_CASE("Save Serialization - Forward Compatibility", "[game][serialization]")
+{
+    // Take the version-1 monster record out of a normal archive
+    BinaryWriter current;
+    SaveSerialization::WriteMonsters(current, { { 5, MakeMonster(5) } });
+    BinaryReader parse(current.GetBuffer());
+    uint32_t tag = 0;
+    uint32_t version = 0;
+    BinaryReader body;
+    REQUIRE(parse.NextSection(tag, version, body));
+    REQUIRE(body.ReadCount() == 1);
+    REQUIRE(body.ReadVarUInt32() == 5);
+    BinaryReader fields = body.ReadRecord();
+    size_t fieldSize = fields.GetRemaining();
+    const uint8_t* fieldBytes = fields.ReadBytes(fieldSize);
+    REQUIRE(fieldBytes != nullptr);
+
+    // What a newer writer would produce: an unknown section first, then a
+    // version-2 monster record with a field appended
+    BinaryWriter future;
+    size_t unknown = future.BeginSection(999, 1);
+    future.WriteString("from the future");
+    future.EndSection(unknown);
+    size_t section = future.BeginSection(static_cast<uint32_t>(SaveSection::Monsters), 2);
+    future.WriteVarUInt(1);
+    future.WriteVarUInt(5);
+    size_t record = future.BeginRecord();
+    future.WriteBytes(fieldBytes, fieldSize);
+    future.WriteString("appended field");
+    future.EndRecord(record);
+    future.EndSection(section);
+
+    SECTION("Unknown sections and appended fields are skipped")
+    {
+        BinaryReader reader(future.GetBuffer());
+        std::map<uint32_t, MonsterAIData> monsters;
+        REQUIRE(SaveSerialization::ReadMonsters(reader, monsters));
+        REQUIRE(monsters.size() == 1);
+        REQUIRE(monsters[5].monsterName == "Drowner 5");
+        REQUIRE(monsters[5].lastStateChange == MakeMonster(5).lastStateChange);
+    }
+
+    SECTION("Truncated archives are rejected")
+    {
+        std::vector<uint8_t> truncated = future.GetBuffer();
+        truncated.resize(truncated.size() - 20);
+        BinaryReader reader(truncated);
+        std::map<uint32_t, MonsterAIData> monsters;
+        REQUIRE_FALSE(SaveSerialization::ReadMonsters(reader, monsters));
+    }
+}
+
+TEST_CASE("Save Serialization - World View", "[game][serialization]")
+{
+    WorldSaveData world = MakeWorld(500);
+    BinaryWriter writer;
+    SaveSerialization::WriteWorld(writer, world);
+
+    SECTION("Records are found through the index without decoding the parts")
+    {
+        WorldSaveView view;
+        REQUIRE(view.Open(writer.TakeBuffer()));
+        REQUIRE(view.GetWorldName() == "Velen");
+        REQUIRE(view.GetMonsterCount() == 500);
+        REQUIRE(view.GetMerchantCount() == 50);
+
+        MonsterAIData monster;
+        REQUIRE(view.FindMonster(321, monster));
+        REQUIRE(monster.monsterName == "Drowner 321");
+        REQUIRE(monster.threatList == world.monsters[321].threatList);
+        REQUIRE_FALSE(view.FindMonster(501, monster));
+
+        MerchantData merchant;
+        REQUIRE(view.FindMerchant(17, merchant));
+        REQUIRE(merchant.buyPrices == world.merchants[17].buyPrices);
+        REQUIRE_FALSE(view.IsDecoded(SaveSection::Monsters));
+        REQUIRE_FALSE(view.IsDecoded(SaveSection::Quests));
+
+        // Parts decode on first use, independently of each other
+        REQUIRE(view.GetQuests()->size() == 200);
+        REQUIRE(view.IsDecoded(SaveSection::Quests));
+        REQUIRE_FALSE(view.IsDecoded(SaveSection::Monsters));
+
+        WorldSaveData loaded;
+        REQUIRE(view.Materialize(loaded));
+        REQUIRE(loaded.monsters.size() == 500);
+        REQUIRE(loaded.monsters[42].lastStateChange == world.monsters[42].lastStateChange);
+        REQUIRE(loaded.merchants[5].sellPrices == world.merchants[5].sellPrices);
+        REQUIRE(loaded.worldStates == world.worldStates);
+    }
+
+    SECTION("Worlds saved without an index are indexed by scanning")
+    {
+        BinaryWriter legacy;
+        size_t section = legacy.BeginSection(static_cast<uint32_t>(SaveSection::World), 1);
+        legacy.WriteVarUInt(world.worldId);
+        legacy.WriteString(world.worldName);
+        legacy.WriteVarInt(0);
+        SaveSerialization::WriteMonsters(legacy, world.monsters);
+        legacy.EndSection(section);
+
+        WorldSaveView view;
+        REQUIRE(view.Open(legacy.TakeBuffer()));
+        MonsterAIData monster;
+        REQUIRE(view.FindMonster(77, monster));
+        REQUIRE(monster.monsterName == "Drowner 77");
+        REQUIRE(view.GetMerchants()->empty());
+    }
+
+    SECTION("Damaged payloads are rejected")
+    {
+        std::vector<uint8_t> truncated = writer.GetBuffer();
+        truncated.resize(truncated.size() / 2);
+        WorldSaveView view;
+        REQUIRE_FALSE(view.Open(std::move(truncated)));
+    }
+}
+
+TEST_CASE("Copy On Write", "[utils][saves]")
+{
+    CopyOnWrite<std::vector<int>> value(std::vector<int>{ 1, 2, 3 });
+
+    SECTION("Writes without a live snapshot stay in place")
+    {
+        value.Write().push_back(4);
+        {
+            auto snapshot = value.Snapshot();
+            REQUIRE(snapshot->size() == 4);
+        }
+        value.Write().push_back(5);
+        REQUIRE(value.GetCloneCount() == 0);
+        REQUIRE(value.Read().size() == 5);
+    }
+
+    SECTION("A live snapshot keeps its version")
+    {
+        auto snapshot = value.Snapshot();
+        auto second = value.Snapshot();
+        value.Write().push_back(4);
+        value.Write().push_back(5);
+        REQUIRE(value.GetCloneCount() == 1);
+        REQUIRE(*snapshot == std::vector<int>{ 1, 2, 3 });
+        REQUIRE(second.get() == snapshot.get());
+        REQUIRE(value.Read().size() == 5);
+    }
+
+    SECTION("A snapshot released on another thread is written in place")
+    {
+        // The flag is relaxed on purpose: only the snapshot release may order
+        // the reader's last access before the owner's write
+        std::atomic<bool> released{ false };
+        bool stable = true;
+        std::thread reader([&released, &stable, snapshot = value.Snapshot()]() mutable
+        {
+            for (int pass = 0; pass < 1000; ++pass)
+            {
+                stable = stable && *snapshot == std::vector<int>{ 1, 2, 3 };
+            }
+            snapshot.reset();
+            released.store(true, std::memory_order_relaxed);
+        });
+        while (!released.load(std::memory_order_relaxed))
+        {
+            std::this_thread::yield();
+        }
+        value.Write().push_back(4);
+        reader.join();
+
+        REQUIRE(stable);
+        REQUIRE(value.GetCloneCount() == 0);
+        REQUIRE(value.Read().size() == 4);
+    }
+}
+
+TEST_CASE("World Save State", "[game][saves]")
+{
+    WorldSaveState world(MakeWorld(2000));
+    WorldSaveSnapshot snapshot = world.Snapshot();
+
+    SECTION("A write clones only the part it changes")
+    {
+        world.monsters.Write().erase(1);
+        REQUIRE(world.monsters.GetCloneCount() == 1);
+        REQUIRE(world.merchants.GetCloneCount() == 0);
+        REQUIRE(world.quests.GetCloneCount() == 0);
+        REQUIRE(world.worldStates.GetCloneCount() == 0);
+
+        WorldSaveSnapshot next = world.Snapshot();
+        REQUIRE(snapshot.monsters->size() == 2000);
+        REQUIRE(next.monsters->size() == 1999);
+        REQUIRE(next.monsters.get() != snapshot.monsters.get());
+        REQUIRE(next.merchants.get() == snapshot.merchants.get());
+        REQUIRE(next.quests.get() == snapshot.quests.get());
+        REQUIRE(next.worldStates.get() == snapshot.worldStates.get());
+    }
+
+    SECTION("Clone time is handed out once")
+    {
+        world.worldStates.Write()["bloody_baron_found"] = false;
+        REQUIRE(world.TakeCloneTime() > std::chrono::steady_clock::duration::zero());
+        REQUIRE(world.TakeCloneTime() == std::chrono::steady_clock::duration::zero());
+    }
+
+    SECTION("A snapshot serializes like the data it came from")
+    {
+        BinaryWriter fromData;
+        SaveSerialization::WriteWorld(fromData, MakeWorld(2000));
+        BinaryWriter fromSnapshot;
+        SaveSerialization::WriteWorld(fromSnapshot, snapshot);
+        REQUIRE(fromSnapshot.TakeBuffer() == fromData.TakeBuffer());
+    }
+}
+
+TEST_CASE("Shared Save System - Clones Count As Stall", "[game][saves]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_stall_test";
+    std::filesystem::remove_all(directory);
+
+    SharedSaveSystem saves;
+    REQUIRE(saves.Initialize(directory.string()));
+
+    // A save still holding the monsters makes the next write copy them
+    WorldSaveState world(MakeWorld(10000));
+    WorldSaveSnapshot inFlight = world.Snapshot();
+    auto start = std::chrono::steady_clock::now();
+    world.monsters.Write().erase(1);
+    auto writeMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    REQUIRE(world.monsters.GetCloneCount() == 1);
+
+    // The copy dominates that write, and the next save is charged for it
+    REQUIRE(saves.SaveWorldDataAsync(3, world) != 0);
+    REQUIRE(world.TakeCloneTime() == std::chrono::steady_clock::duration::zero());
+    REQUIRE(saves.GetStats().maxStallTime * 1000.0f >= writeMicros / 2);
+
+    saves.FlushPendingSaves();
+    saves.Shutdown();
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Shared Save System - Async Saves", "[game][saves]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_save_test";
+    std::filesystem::remove_all(directory);
+
+    SharedSaveSystem saves;
+    REQUIRE(saves.Initialize(directory.string()));
+
+    std::vector<std::pair<uint32_t, bool>> completed;
+    saves.SetSaveCompletedCallback([&completed](uint32_t saveId, bool success)
+    {
+        completed.emplace_back(saveId, success);
+    });
+
+    // A large world keeps the worker busy while the player saves queue up
+    WorldSaveState world(MakeWorld(2000));
+    uint32_t worldSave = saves.SaveWorldDataAsync(3, world);
+
+    // The tick thread keeps changing the world while the worker writes the snapshot
+    world.monsters.Write().erase(1);
+    PlayerSaveData player;
+    player.playerId = 7;
+    player.playerName = "Ciri";
+    player.level = 10;
+    uint32_t firstSave = saves.SavePlayerDataAsync(7, player);
+    player.level = 11;
+    uint32_t secondSave = saves.SavePlayerDataAsync(7, player);
+    REQUIRE(worldSave != 0);
+    REQUIRE(firstSave != 0);
+    REQUIRE(secondSave != 0);
+
+    // Nothing is reported until the owning thread asks
+    saves.FlushPendingSaves();
+    REQUIRE(saves.GetPendingSaveCount() == 0);
+
+    SaveStats stats = saves.GetStats();
+    REQUIRE(stats.asyncSaves == 3);
+    REQUIRE(completed.size() == 3 - stats.coalescedSaves);
+    for (const auto& result : completed)
+    {
+        REQUIRE(result.second);
+    }
+
+    // The newest snapshot is the one on disk, coalesced or not
+    PlayerSaveData loaded;
+    if (stats.coalescedSaves == 1)
+    {
+        REQUIRE(firstSave == secondSave);
+        REQUIRE(saves.LoadPlayerData(7, loaded));
+        REQUIRE(loaded.level == 11);
+    }
+
+    WorldSaveData loadedWorld;
+    REQUIRE(saves.LoadWorldData(3, loadedWorld));
+    REQUIRE(loadedWorld.monsters.size() == 2000);
+    REQUIRE(world.monsters->size() == 1999);
+
+    // Once the worker let go of the snapshot, writes no longer copy the world
+    REQUIRE(world.monsters.GetCloneCount() <= 1);
+    uint64_t clones = world.monsters.GetCloneCount();
+    world.monsters.Write().erase(2);
+    REQUIRE(world.monsters.GetCloneCount() == clones);
+
+    saves.Shutdown();
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Save Serialization - Throughput", "[game][serialization][!benchmark]")
+{
+    WorldSaveData world = MakeWorld(10000);
+
+    BinaryWriter writer;
+    SaveSerialization::WriteWorld(writer, world);
+    std::vector<uint8_t> encoded = writer.TakeBuffer();
+    std::string json = MonstersToJson(world.monsters);
+
+    // MB/s over a fixed number of passes, alongside Catch's per-call timings
+    auto throughput = [](size_t bytes, auto&& pass)
+    {
+        constexpr int Passes = 10;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < Passes; ++i)
+        {
+            pass();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return bytes * Passes / elapsed.count() / (1024.0 * 1024.0);
+    };
+
+    double encodeRate = throughput(encoded.size(), [&]()
+    {
+        BinaryWriter out(encoded.size());
+        SaveSerialization::WriteWorld(out, world);
+    });
+    double decodeRate = throughput(encoded.size(), [&]()
+    {
+        BinaryReader in(encoded);
+        WorldSaveData loaded;
+        SaveSerialization::ReadWorld(in, loaded);
+    });
+    double jsonRate = throughput(json.size(), [&]()
+    {
+        MonstersToJson(world.monsters);
+    });
+
+    std::cout << "10k-monster world: binary " << encoded.size() << " bytes, encode " << encodeRate
+              << " MB/s, decode " << decodeRate << " MB/s; JSON (monsters only) " << json.size()
+              << " bytes, encode " << jsonRate << " MB/s" << std::endl;
+
+    BENCHMARK("binary encode, 10k-monster world")
+    {
+        BinaryWriter out(encoded.size());
+        SaveSerialization::WriteWorld(out, world);
+        return out.GetSize();
+    };
+
+    BENCHMARK("binary decode, 10k-monster world")
+    {
+        BinaryReader in(encoded);
+        WorldSaveData loaded;
+        SaveSerialization::ReadWorld(in, loaded);
+        return loaded.monsters.size();
+    };
+
+    BENCHMARK("JSON encode baseline, 10k monsters")
+    {
+        return MonstersToJson(world.monsters).size();
+    };
+}
+
+TEST_CASE("Shared Save System - World Startup", "[game][saves][!benchmark]")
+{
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_world_startup_test";
+    std::filesystem::remove_all(directory);
+
+    SharedSaveSystem saves;
+    REQUIRE(saves.Initialize(directory.string()));
+    REQUIRE(saves.SaveWorldData(3, MakeWorld(10000)));
+
+    // Time until the server can answer its first query about the world:
+    // eager decodes everything into maps, the view decodes one record
+    auto timeToFirstQuery = [](auto&& pass)
+    {
+        constexpr int Passes = 10;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < Passes; ++i)
+        {
+            pass();
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / Passes;
+    };
+
+    double eagerMs = timeToFirstQuery([&]()
+    {
+        WorldSaveData world;
+        REQUIRE(saves.LoadWorldData(3, world));
+        REQUIRE(world.monsters.count(5000) == 1);
+    });
+    double lazyMs = timeToFirstQuery([&]()
+    {
+        std::shared_ptr<const WorldSaveView> view;
+        MonsterAIData monster;
+        REQUIRE(saves.OpenWorldSave(3, view));
+        REQUIRE(view->FindMonster(5000, monster));
+    });
+
+    std::cout << "10k-monster world startup: eager load " << eagerMs << " ms, lazy view " << lazyMs
+              << " ms to first monster lookup" << std::endl;
+
+    BENCHMARK("eager LoadWorldData, 10k-monster world")
+    {
+        WorldSaveData world;
+        saves.LoadWorldData(3, world);
+        return world.monsters.size();
+    };
+
+    BENCHMARK("OpenWorldSave + FindMonster, 10k-monster world")
+    {
+        std::shared_ptr<const WorldSaveView> view;
+        MonsterAIData monster;
+        saves.OpenWorldSave(3, view);
+        return view->FindMonster(5000, monster);
+    };
+
+    saves.Shutdown();
+    std::filesystem::remove_all(directory);
+}
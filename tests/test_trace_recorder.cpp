@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+#include "utils/TraceRecorder.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    size_t CountOccurrences(const std::string& text, const std::string& part)
+    {
+        size_t count = 0;
+        for (size_t pos = text.find(part); pos != std::string::npos; pos = text.find(part, pos + part.size()))
+        {
+            count++;
+        }
+        return count;
+    }
+
+    // Each case starts a fresh session so earlier spans are not exported
+    void RestartTracing()
+    {
+        auto& tracer = TraceRecorder::GetInstance();
+        tracer.SetEnabled(false);
+        tracer.SetEnabled(true);
+    }
+}
+
+TEST_CASE("Trace Recorder - Spans", "[utils][trace]")
+{
+    auto& tracer = TraceRecorder::GetInstance();
+
+    SECTION("Nothing is recorded while disabled")
+    {
+        RestartTracing();
+        tracer.SetEnabled(false);
+        {
+            TRACE_SCOPE("disabled_span", "test");
+        }
+        REQUIRE(CountOccurrences(tracer.ToJson(), "disabled_span") == 0);
+    }
+
+    SECTION("Spans from several threads carry their thread names")
+    {
+        RestartTracing();
+        tracer.SetThreadName("test-main");
+        {
+            TRACE_SCOPE("outer_span", "test");
+            TRACE_SCOPE_ARG("inner_span", "test", "items", 3);
+        }
+
+        std::thread worker([&]()
+        {
+            tracer.SetThreadName("test-worker");
+            TRACE_SCOPE("worker_span", "test");
+        });
+        worker.join();
+
+        std::string json = tracer.ToJson();
+        tracer.SetEnabled(false);
+
+        REQUIRE(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+        REQUIRE(CountOccurrences(json, "\"args\":{\"name\":\"test-main\"}") == 1);
+        REQUIRE(CountOccurrences(json, "\"args\":{\"name\":\"test-worker\"}") == 1);
+        REQUIRE(CountOccurrences(json, "\"name\":\"outer_span\",\"cat\":\"test\",\"ph\":\"X\"") == 1);
+        REQUIRE(CountOccurrences(json, "\"name\":\"worker_span\"") == 1);
+        REQUIRE(CountOccurrences(json, "\"args\":{\"items\":3}") == 1);
+    }
+
+    SECTION("Only the newest spans survive a full ring")
+    {
+        RestartTracing();
+        tracer.SetThreadBufferSize(64);
+        std::thread worker([]()
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                TRACE_SCOPE_ARG("ring_span", "test", "index", i);
+            }
+        });
+        worker.join();
+        tracer.SetThreadBufferSize(8192);
+
+        std::string json = tracer.ToJson();
+        tracer.SetEnabled(false);
+
+        REQUIRE(CountOccurrences(json, "\"name\":\"ring_span\"") == 64);
+        REQUIRE(CountOccurrences(json, "\"args\":{\"index\":199}") == 1);
+        REQUIRE(CountOccurrences(json, "\"args\":{\"index\":135}") == 0);
+    }
+}
+
+TEST_CASE("Trace Recorder - Slow Tick Capture", "[utils][trace]")
+{
+    auto& tracer = TraceRecorder::GetInstance();
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "tw3mp_trace_test";
+    std::filesystem::remove_all(directory);
+
+    RestartTracing();
+    tracer.SetSlowTickCapture(std::chrono::milliseconds(2), directory.string(), std::chrono::milliseconds(50),
+                              std::chrono::milliseconds(0), std::chrono::milliseconds(0));
+    uint64_t capturesBefore = tracer.GetCaptureCount();
+
+    // A fast tick is ignored
+    auto start = std::chrono::steady_clock::now();
+    tracer.OnTick(start, start + std::chrono::microseconds(500));
+
+    // A slow one is captured on the following tick, once its post-window has passed
+    start = std::chrono::steady_clock::now();
+    {
+        TRACE_SCOPE("slow_work", "test");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    auto end = std::chrono::steady_clock::now();
+    tracer.OnTick(start, end);
+    tracer.OnTick(end, std::chrono::steady_clock::now());
+    tracer.WaitForCapture();
+
+    tracer.SetSlowTickCapture(std::chrono::microseconds(0));
+    tracer.SetEnabled(false);
+
+    REQUIRE(tracer.GetCaptureCount() == capturesBefore + 1);
+    std::string path = tracer.GetLastCapturePath();
+    REQUIRE(std::filesystem::exists(path));
+
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    REQUIRE(CountOccurrences(contents.str(), "\"name\":\"slow_work\"") == 1);
+
+    std::filesystem::remove_all(directory);
+}
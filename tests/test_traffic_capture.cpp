@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+#include "networking/net_server.h"
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Networking;
+
+namespace
+{
+    enum class TestMessage : uint32_t
+    {
+        Ping = 1,
+        Move = 2
+    };
+
+    std::string TestCapturePath(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    message<TestMessage> MakeMessage(TestMessage id, uint32_t value)
+    {
+        message<TestMessage> msg;
+        msg.header.id = id;
+        msg << value;
+        return msg;
+    }
+
+    class ReplayTestServer : public server_interface<TestMessage>
+    {
+    public:
+        ReplayTestServer() {}
+        explicit ReplayTestServer(uint16_t port) : server_interface<TestMessage>(port) {}
+
+        std::vector<uint32_t> connected;
+        std::vector<uint32_t> disconnected;
+        std::vector<std::pair<uint32_t, uint32_t>> received;
+
+    protected:
+        bool OnClientConnect(std::shared_ptr<connection<TestMessage>> client) override
+        {
+            connected.push_back(client->GetID());
+            return true;
+        }
+
+        void OnClientDisconnect(std::shared_ptr<connection<TestMessage>> client) override
+        {
+            disconnected.push_back(client->GetID());
+        }
+
+        void OnMessageReceived(std::shared_ptr<connection<TestMessage>> client, message<TestMessage>& msg) override
+        {
+            uint32_t value = 0;
+            msg >> value;
+            received.push_back({ client->GetID(), value });
+
+            // Replies to stand-ins must be discarded without disconnecting them
+            MessageClient(client, MakeMessage(TestMessage::Ping, value));
+        }
+    };
+
+    void WriteSession(const std::string& path)
+    {
+        capture_writer<TestMessage> writer;
+        REQUIRE(writer.Open(path));
+
+        auto start = std::chrono::steady_clock::now();
+        writer.RecordConnection(capture_event_kind::connect, 10000, start);
+        writer.RecordConnection(capture_event_kind::connect, 10001, start + std::chrono::milliseconds(1));
+        writer.RecordMessage(10000, start + std::chrono::milliseconds(5), MakeMessage(TestMessage::Move, 7));
+        writer.RecordMessage(10001, start + std::chrono::milliseconds(10), MakeMessage(TestMessage::Move, 8));
+        writer.RecordMessage(10000, start + std::chrono::milliseconds(20), MakeMessage(TestMessage::Ping, 9));
+        writer.RecordConnection(capture_event_kind::disconnect, 10001, start + std::chrono::milliseconds(25));
+        REQUIRE(writer.GetEventsWritten() == 6);
+        writer.Close();
+    }
+}
+
+TEST_CASE("Traffic Capture - File Round Trip", "[networking][capture]")
+{
+    std::string path = TestCapturePath("tw3_capture_roundtrip.tw3cap");
+    WriteSession(path);
+
+    SECTION("Events read back in order")
+    {
+        capture_reader<TestMessage> reader;
+        REQUIRE(reader.Open(path));
+
+        std::vector<captured_event<TestMessage>> events;
+        captured_event<TestMessage> event;
+        while (reader.Next(event))
+        {
+            events.push_back(event);
+        }
+        REQUIRE(reader.ReachedEnd());
+        REQUIRE(events.size() == 6);
+
+        REQUIRE(events[0].kind == capture_event_kind::connect);
+        REQUIRE(events[0].connectionId == 10000);
+        REQUIRE(events[2].kind == capture_event_kind::message);
+        REQUIRE(events[2].msg.header.id == TestMessage::Move);
+        REQUIRE(events[2].msg.body.size() == sizeof(uint32_t));
+        REQUIRE(events[2].timestampNs >= 5000000);
+        REQUIRE(events[5].kind == capture_event_kind::disconnect);
+        REQUIRE(events[5].connectionId == 10001);
+
+        uint32_t value = 0;
+        events[4].msg >> value;
+        REQUIRE(value == 9);
+    }
+
+    SECTION("Truncated files are reported")
+    {
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 2);
+
+        capture_reader<TestMessage> reader;
+        REQUIRE(reader.Open(path));
+        captured_event<TestMessage> event;
+        size_t count = 0;
+        while (reader.Next(event))
+        {
+            count++;
+        }
+        REQUIRE(count == 5);
+        REQUIRE_FALSE(reader.ReachedEnd());
+    }
+
+    SECTION("Captures of another message type are rejected")
+    {
+        capture_reader<uint64_t> reader;
+        REQUIRE_FALSE(reader.Open(path));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Traffic Capture - Server Replay", "[networking][capture]")
+{
+    std::string path = TestCapturePath("tw3_capture_replay.tw3cap");
+    WriteSession(path);
+
+    ReplayTestServer server;
+
+    SECTION("Accelerated replay drives the server handlers")
+    {
+        replay_stats stats = server.Replay(path, 0.0);
+        REQUIRE(stats.complete);
+        REQUIRE(stats.connects == 2);
+        REQUIRE(stats.messages == 3);
+        REQUIRE(stats.disconnects == 1);
+
+        REQUIRE(server.connected == std::vector<uint32_t>{ 10000, 10001 });
+        REQUIRE(server.received == std::vector<std::pair<uint32_t, uint32_t>>{ { 10000, 7 }, { 10001, 8 }, { 10000, 9 } });
+        // 10000 was still connected when the capture ended
+        REQUIRE(server.disconnected == std::vector<uint32_t>{ 10001, 10000 });
+    }
+
+    SECTION("Recorded speed keeps the original timing")
+    {
+        replay_stats stats = server.Replay(path, 1.0);
+        REQUIRE(stats.complete);
+        REQUIRE(stats.recordedDuration >= std::chrono::milliseconds(25));
+        REQUIRE(stats.replayDuration >= stats.recordedDuration);
+    }
+
+    SECTION("Missing files replay nothing")
+    {
+        replay_stats stats = server.Replay(TestCapturePath("tw3_capture_missing.tw3cap"), 0.0);
+        REQUIRE_FALSE(stats.complete);
+        REQUIRE(stats.messages == 0);
+    }
+
+    SECTION("A listening server refuses to replay")
+    {
+        ReplayTestServer live(0);
+        replay_stats stats = live.Replay(path, 0.0);
+        REQUIRE_FALSE(stats.complete);
+        REQUIRE(stats.connects == 0);
+        REQUIRE(live.connected.empty());
+    }
+
+    std::filesystem::remove(path);
+}